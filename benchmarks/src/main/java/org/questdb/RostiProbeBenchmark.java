@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+
+package org.questdb;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.ColumnType;
+import io.questdb.std.*;
+import org.openjdk.jmh.annotations.*;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Lookups of existing LONG keys in rosti filled close to its 7/8 growth limit, reported per key.
+ * The map never grows during the benchmark, so time goes to hashing and probing control byte groups.
+ * <p>
+ * This is the benchmark behind keeping control byte groups 16 wide on AVX2 and AVX-512 CPUs,
+ * see GroupSse2Impl in rosti.h. 32 and 64-byte groups were measured with it and were slower
+ * at every load factor here, so they were not adopted.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@OperationsPerInvocation(RostiProbeBenchmark.BATCH_SIZE)
+public class RostiProbeBenchmark {
+    static final int BATCH_SIZE = 4096;
+    @Param({"65536", "1048576", "16777216"})
+    public long capacity;
+    // growth limit is 7/8 of capacity
+    @Param({"0.5", "0.75", "0.85", "0.87"})
+    public double loadFactor;
+    private int keyCount;
+    private long lookupOffset;
+    private long pKeys;
+    private long pLookups;
+    private long pRosti;
+
+    public static void main(String[] args) throws RunnerException {
+        Options opt = new OptionsBuilder()
+                .include(RostiProbeBenchmark.class.getSimpleName())
+                .warmupIterations(3)
+                .measurementIterations(3)
+                .forks(1)
+                .build();
+
+        new Runner(opt).run();
+    }
+
+    @Benchmark
+    public boolean testLookup() {
+        final boolean ok = Rosti.keyedLongCount(pRosti, pLookups + lookupOffset * Long.BYTES, BATCH_SIZE, 1);
+        lookupOffset += BATCH_SIZE;
+        if (lookupOffset + BATCH_SIZE > keyCount) {
+            lookupOffset = 0;
+        }
+        return ok;
+    }
+
+    @Setup(Level.Trial)
+    public void setup() {
+        Os.init();
+        pRosti = Rosti.alloc(new ArrayColumnTypes().add(ColumnType.LONG).add(ColumnType.LONG), capacity);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 0), Numbers.LONG_NaN);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 1), 0);
+
+        final long mapCapacity = Rosti.getCapacity(pRosti);
+        keyCount = (int) (mapCapacity * loadFactor);
+        pKeys = Unsafe.malloc((long) keyCount * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        pLookups = Unsafe.malloc((long) keyCount * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final Rnd rnd = new Rnd();
+        for (int i = 0; i < keyCount; i++) {
+            long key;
+            do {
+                key = rnd.nextLong();
+            } while (key == Numbers.LONG_NaN);
+            Unsafe.getUnsafe().putLong(pKeys + (long) i * Long.BYTES, key);
+        }
+        // random duplicates are rare, they only lower the load factor slightly
+        if (!Rosti.keyedLongCount(pRosti, pKeys, keyCount, 1) || Rosti.getCapacity(pRosti) != mapCapacity) {
+            throw new IllegalStateException("map must not grow [capacity=" + mapCapacity + ", keyCount=" + keyCount + ']');
+        }
+
+        // existing keys in random order, so that lookups don't follow insertion order
+        for (int i = 0; i < keyCount; i++) {
+            final long j = (rnd.nextLong() & Long.MAX_VALUE) % keyCount;
+            Unsafe.getUnsafe().putLong(pLookups + (long) i * Long.BYTES, Unsafe.getUnsafe().getLong(pKeys + j * Long.BYTES));
+        }
+        lookupOffset = 0;
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        Rosti.free(pRosti);
+        Unsafe.free(pKeys, (long) keyCount * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        Unsafe.free(pLookups, (long) keyCount * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+    }
+}
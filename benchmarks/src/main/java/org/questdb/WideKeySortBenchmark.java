@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package org.questdb;
+
+import io.questdb.std.*;
+import org.openjdk.jmh.annotations.*;
+import org.openjdk.jmh.runner.Runner;
+import org.openjdk.jmh.runner.RunnerException;
+import org.openjdk.jmh.runner.options.Options;
+import org.openjdk.jmh.runner.options.OptionsBuilder;
+
+import java.util.concurrent.TimeUnit;
+
+// Sorts of 128-bit and 3x64-bit keys on random and adversarial inputs. Each invocation sorts a fresh copy of the
+// input, the copy is included in the measurement.
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+public class WideKeySortBenchmark {
+    @Param({"RANDOM", "SORTED", "REVERSE", "EQUAL"})
+    public String shape;
+    @Param({"1000", "100000"})
+    public int size;
+    private long input128;
+    private long input3x;
+    private long work128;
+    private long work3x;
+
+    public static void main(String[] args) throws RunnerException {
+        Options opt = new OptionsBuilder()
+                .include(WideKeySortBenchmark.class.getSimpleName())
+                .warmupIterations(3)
+                .measurementIterations(5)
+                .forks(1)
+                .build();
+
+        new Runner(opt).run();
+    }
+
+    @Setup(Level.Trial)
+    public void setup() {
+        Os.init();
+        input128 = Unsafe.malloc(size * 16L, MemoryTag.NATIVE_DEFAULT);
+        work128 = Unsafe.malloc(size * 16L, MemoryTag.NATIVE_DEFAULT);
+        input3x = Unsafe.malloc(size * 24L, MemoryTag.NATIVE_DEFAULT);
+        work3x = Unsafe.malloc(size * 24L, MemoryTag.NATIVE_DEFAULT);
+        final Rnd rnd = new Rnd();
+        for (int i = 0; i < size; i++) {
+            final long hi;
+            final long lo;
+            switch (shape) {
+                case "RANDOM":
+                    hi = rnd.nextLong();
+                    lo = rnd.nextLong();
+                    break;
+                case "SORTED":
+                    hi = i;
+                    lo = 0;
+                    break;
+                case "REVERSE":
+                    hi = size - i;
+                    lo = 0;
+                    break;
+                default:
+                    hi = 42;
+                    lo = 0;
+                    break;
+            }
+            // 128-bit values are little-endian, the high word is the second one
+            Unsafe.getUnsafe().putLong(input128 + i * 16L, lo);
+            Unsafe.getUnsafe().putLong(input128 + i * 16L + 8, hi);
+            Unsafe.getUnsafe().putLong(input3x + i * 24L, hi);
+            Unsafe.getUnsafe().putLong(input3x + i * 24L + 8, lo);
+            Unsafe.getUnsafe().putLong(input3x + i * 24L + 16, lo);
+        }
+    }
+
+    @Benchmark
+    public void testSort128Bit() {
+        Vect.memcpy(work128, input128, size * 16L);
+        Vect.sort128BitAscInPlace(work128, size);
+    }
+
+    @Benchmark
+    public void testSort3Long() {
+        Vect.memcpy(work3x, input3x, size * 24L);
+        Vect.sort3LongAscInPlace(work3x, size);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        Unsafe.free(input128, size * 16L, MemoryTag.NATIVE_DEFAULT);
+        Unsafe.free(work128, size * 16L, MemoryTag.NATIVE_DEFAULT);
+        Unsafe.free(input3x, size * 24L, MemoryTag.NATIVE_DEFAULT);
+        Unsafe.free(work3x, size * 24L, MemoryTag.NATIVE_DEFAULT);
+    }
+}
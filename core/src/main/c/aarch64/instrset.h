@@ -0,0 +1,37 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef QUESTDB_AARCH64_INSTRSET_H
+#define QUESTDB_AARCH64_INSTRSET_H
+
+// Instruction set levels of aarch64, counterpart of vcl instrset_detect() on x86.
+// Kernels are built for Advanced SIMD, which ARMv8-A requires, SVE levels are reported only.
+constexpr int INSTRSET_VANILLA = 0;
+constexpr int INSTRSET_NEON = 1;
+constexpr int INSTRSET_SVE = 2;
+constexpr int INSTRSET_SVE2 = 3;
+
+int instrset_detect();
+
+#endif //QUESTDB_AARCH64_INSTRSET_H
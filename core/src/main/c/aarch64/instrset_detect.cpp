@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "instrset.h"
+
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+static int detect() {
+#if defined(__linux__)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    if ((hwcap & HWCAP_ASIMD) == 0) {
+        return INSTRSET_VANILLA;
+    }
+#ifdef HWCAP_SVE
+    if (hwcap & HWCAP_SVE) {
+#if defined(AT_HWCAP2) && defined(HWCAP2_SVE2)
+        if (getauxval(AT_HWCAP2) & HWCAP2_SVE2) {
+            return INSTRSET_SVE2;
+        }
+#endif
+        return INSTRSET_SVE;
+    }
+#endif
+    return INSTRSET_NEON;
+#elif defined(__APPLE__)
+    // Apple cores have no SVE
+    int value = 0;
+    size_t len = sizeof(value);
+    if (sysctlbyname("hw.optional.AdvSIMD", &value, &len, nullptr, 0) == 0 && value == 0) {
+        return INSTRSET_VANILLA;
+    }
+    return INSTRSET_NEON;
+#else
+    return INSTRSET_NEON;
+#endif
+}
+
+int instrset_detect() {
+    static int iset = -1;
+    if (iset < 0) {
+        iset = detect();
+    }
+    return iset;
+}
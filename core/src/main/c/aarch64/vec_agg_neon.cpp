@@ -0,0 +1,1134 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <arm_neon.h>
+#include <algorithm>
+#include <cmath>
+#include "../share/util.h"
+#include "vec_agg_neon.h"
+
+// Advanced SIMD counterparts of vec_agg.cpp kernels. Loops take two 128-bit registers per step,
+// which keeps both NEON pipes of Neoverse cores busy, and finish the remainder with scalar code.
+
+int64_t countDouble_Neon(double *d, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 4;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    int64x2_t cnt0 = vdupq_n_s64(0);
+    int64x2_t cnt1 = vdupq_n_s64(0);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        const float64x2_t v0 = vld1q_f64(d);
+        const float64x2_t v1 = vld1q_f64(d + 2);
+        // lanes that are not NaN compare equal to themselves, mask is -1
+        cnt0 = vsubq_s64(cnt0, vreinterpretq_s64_u64(vceqq_f64(v0, v0)));
+        cnt1 = vsubq_s64(cnt1, vreinterpretq_s64_u64(vceqq_f64(v1, v1)));
+    }
+    int64_t cnt = vaddvq_s64(vaddq_s64(cnt0, cnt1));
+    for (; d < lim; d++) {
+        const double v = *d;
+        cnt += (v == v);
+    }
+    return cnt;
+}
+
+double sumDouble_Neon(double *d, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 4;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    float64x2_t sum0 = vdupq_n_f64(0);
+    float64x2_t sum1 = vdupq_n_f64(0);
+    int64x2_t cnt = vdupq_n_s64(0);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        const float64x2_t v0 = vld1q_f64(d);
+        const float64x2_t v1 = vld1q_f64(d + 2);
+        const uint64x2_t m0 = vceqq_f64(v0, v0);
+        const uint64x2_t m1 = vceqq_f64(v1, v1);
+        sum0 = vaddq_f64(sum0, vreinterpretq_f64_u64(vandq_u64(m0, vreinterpretq_u64_f64(v0))));
+        sum1 = vaddq_f64(sum1, vreinterpretq_f64_u64(vandq_u64(m1, vreinterpretq_u64_f64(v1))));
+        cnt = vsubq_s64(cnt, vreinterpretq_s64_u64(vaddq_u64(m0, m1)));
+    }
+    double sum = vaddvq_f64(vaddq_f64(sum0, sum1));
+    bool hasData = vaddvq_s64(cnt) != 0;
+    for (; d < lim; d++) {
+        const double v = *d;
+        if (v == v) {
+            sum += v;
+            hasData = true;
+        }
+    }
+    return hasData ? sum : NAN;
+}
+
+double sumDoubleKahan_Neon(double *d, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 2;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    float64x2_t sumVec = vdupq_n_f64(0);
+    float64x2_t cVec = vdupq_n_f64(0);
+    int64x2_t cnt = vdupq_n_s64(0);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        const float64x2_t v = vld1q_f64(d);
+        const uint64x2_t m = vceqq_f64(v, v);
+        cnt = vsubq_s64(cnt, vreinterpretq_s64_u64(m));
+        const float64x2_t y = vreinterpretq_f64_u64(vandq_u64(m, vreinterpretq_u64_f64(vsubq_f64(v, cVec))));
+        const float64x2_t t = vaddq_f64(sumVec, y);
+        cVec = vsubq_f64(vsubq_f64(t, sumVec), y);
+        sumVec = t;
+    }
+    double sum = vaddvq_f64(sumVec);
+    double c = vaddvq_f64(cVec);
+    bool hasData = vaddvq_s64(cnt) != 0;
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (x == x) {
+            const double y = x - c;
+            const double t = sum + y;
+            c = (t - sum) - y;
+            sum = t;
+            hasData = true;
+        }
+    }
+    return hasData ? sum : NAN;
+}
+
+double sumDoubleNeumaier_Neon(double *d, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 2;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    float64x2_t sumVec = vdupq_n_f64(0);
+    float64x2_t cVec = vdupq_n_f64(0);
+    int64x2_t cnt = vdupq_n_s64(0);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        float64x2_t v = vld1q_f64(d);
+        const uint64x2_t m = vceqq_f64(v, v);
+        cnt = vsubq_s64(cnt, vreinterpretq_s64_u64(m));
+        v = vreinterpretq_f64_u64(vandq_u64(m, vreinterpretq_u64_f64(v)));
+        const float64x2_t t = vaddq_f64(sumVec, v);
+        const uint64x2_t b = vcgeq_f64(vabsq_f64(sumVec), vabsq_f64(v));
+        const float64x2_t big = vbslq_f64(b, sumVec, v);
+        const float64x2_t small = vbslq_f64(b, v, sumVec);
+        cVec = vaddq_f64(cVec, vaddq_f64(vsubq_f64(big, t), small));
+        sumVec = t;
+    }
+    double sum = vaddvq_f64(sumVec);
+    double c = vaddvq_f64(cVec);
+    bool hasData = vaddvq_s64(cnt) != 0;
+    for (; d < lim; d++) {
+        const double input = *d;
+        if (input == input) {
+            const double t = sum + input;
+            if (std::abs(sum) >= std::abs(input)) {
+                c += (sum - t) + input;
+            } else {
+                c += (input - t) + sum;
+            }
+            sum = t;
+            hasData = true;
+        }
+    }
+    return hasData ? sum + c : NAN;
+}
+
+double minDouble_Neon(double *d, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 4;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    float64x2_t min0 = vdupq_n_f64(D_MAX);
+    float64x2_t min1 = vdupq_n_f64(D_MAX);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        const float64x2_t v0 = vld1q_f64(d);
+        const float64x2_t v1 = vld1q_f64(d + 2);
+        min0 = vbslq_f64(vceqq_f64(v0, v0), vminq_f64(min0, v0), min0);
+        min1 = vbslq_f64(vceqq_f64(v1, v1), vminq_f64(min1, v1), min1);
+    }
+    double min = vminvq_f64(vminq_f64(min0, min1));
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (!std::isnan(x) && x < min) {
+            min = x;
+        }
+    }
+    if (min < D_MAX) {
+        return min;
+    }
+    return NAN;
+}
+
+double maxDouble_Neon(double *d, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 4;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    float64x2_t max0 = vdupq_n_f64(D_MIN);
+    float64x2_t max1 = vdupq_n_f64(D_MIN);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        const float64x2_t v0 = vld1q_f64(d);
+        const float64x2_t v1 = vld1q_f64(d + 2);
+        max0 = vbslq_f64(vceqq_f64(v0, v0), vmaxq_f64(max0, v0), max0);
+        max1 = vbslq_f64(vceqq_f64(v1, v1), vmaxq_f64(max1, v1), max1);
+    }
+    double max = vmaxvq_f64(vmaxq_f64(max0, max1));
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (!std::isnan(x) && x > max) {
+            max = x;
+        }
+    }
+    if (max > D_MIN) {
+        return max;
+    }
+    return NAN;
+}
+
+void statsDouble_Neon(double *d, int64_t count, column_stats_t<double> *stats) {
+    int64_t cnt = 0;
+    double sum = 0;
+    double min = D_MAX;
+    double max = D_MIN;
+    if (count > 0) {
+        const int step = 4;
+        const double *lim = d + count;
+        const double *lim_vec = lim - step + 1;
+        float64x2_t sum0 = vdupq_n_f64(0);
+        float64x2_t sum1 = vdupq_n_f64(0);
+        float64x2_t min0 = vdupq_n_f64(D_MAX);
+        float64x2_t min1 = vdupq_n_f64(D_MAX);
+        float64x2_t max0 = vdupq_n_f64(D_MIN);
+        float64x2_t max1 = vdupq_n_f64(D_MIN);
+        int64x2_t cntVec = vdupq_n_s64(0);
+        for (; d < lim_vec; d += step) {
+            MM_PREFETCH_T1(d + 63 * step);
+            const float64x2_t v0 = vld1q_f64(d);
+            const float64x2_t v1 = vld1q_f64(d + 2);
+            const uint64x2_t m0 = vceqq_f64(v0, v0);
+            const uint64x2_t m1 = vceqq_f64(v1, v1);
+            sum0 = vaddq_f64(sum0, vreinterpretq_f64_u64(vandq_u64(m0, vreinterpretq_u64_f64(v0))));
+            sum1 = vaddq_f64(sum1, vreinterpretq_f64_u64(vandq_u64(m1, vreinterpretq_u64_f64(v1))));
+            min0 = vbslq_f64(m0, vminq_f64(min0, v0), min0);
+            min1 = vbslq_f64(m1, vminq_f64(min1, v1), min1);
+            max0 = vbslq_f64(m0, vmaxq_f64(max0, v0), max0);
+            max1 = vbslq_f64(m1, vmaxq_f64(max1, v1), max1);
+            cntVec = vsubq_s64(cntVec, vreinterpretq_s64_u64(vaddq_u64(m0, m1)));
+        }
+        cnt = vaddvq_s64(cntVec);
+        sum = vaddvq_f64(vaddq_f64(sum0, sum1));
+        min = vminvq_f64(vminq_f64(min0, min1));
+        max = vmaxvq_f64(vmaxq_f64(max0, max1));
+        for (; d < lim; d++) {
+            const double x = *d;
+            if (x == x) {
+                cnt++;
+                sum += x;
+                if (x < min) {
+                    min = x;
+                }
+                if (x > max) {
+                    max = x;
+                }
+            }
+        }
+    }
+    stats->count = cnt;
+    stats->null_count = count - cnt;
+    stats->sum = cnt > 0 ? sum : NAN;
+    stats->min = min < D_MAX ? min : NAN;
+    stats->max = max > D_MIN ? max : NAN;
+}
+
+void varianceDouble_Neon(double *d, int64_t count, welford_t *state) {
+    if (count == 0) {
+        return;
+    }
+    const int step = 4;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    const float64x2_t inf = vdupq_n_f64(D_MAX);
+    const float64x2_t one = vdupq_n_f64(1.0);
+    float64x2_t mean0 = vdupq_n_f64(0);
+    float64x2_t mean1 = vdupq_n_f64(0);
+    float64x2_t m20 = vdupq_n_f64(0);
+    float64x2_t m21 = vdupq_n_f64(0);
+    float64x2_t count0 = vdupq_n_f64(0);
+    float64x2_t count1 = vdupq_n_f64(0);
+    for (; d < lim_vec; d += step) {
+        MM_PREFETCH_T1(d + 63 * step);
+        const float64x2_t v0 = vld1q_f64(d);
+        const float64x2_t v1 = vld1q_f64(d + 2);
+        // |x| < inf is false for both infinities and NaN
+        const uint64x2_t f0 = vcltq_f64(vabsq_f64(v0), inf);
+        const uint64x2_t f1 = vcltq_f64(vabsq_f64(v1), inf);
+        count0 = vbslq_f64(f0, vaddq_f64(count0, one), count0);
+        count1 = vbslq_f64(f1, vaddq_f64(count1, one), count1);
+        const float64x2_t delta0 = vsubq_f64(v0, mean0);
+        const float64x2_t delta1 = vsubq_f64(v1, mean1);
+        mean0 = vbslq_f64(f0, vaddq_f64(mean0, vdivq_f64(delta0, count0)), mean0);
+        mean1 = vbslq_f64(f1, vaddq_f64(mean1, vdivq_f64(delta1, count1)), mean1);
+        m20 = vbslq_f64(f0, vaddq_f64(m20, vmulq_f64(delta0, vsubq_f64(v0, mean0))), m20);
+        m21 = vbslq_f64(f1, vaddq_f64(m21, vmulq_f64(delta1, vsubq_f64(v1, mean1))), m21);
+    }
+
+    double mean = 0;
+    double m2 = 0;
+    int64_t n = 0;
+    welford_merge(mean, m2, n, vgetq_lane_f64(mean0, 0), vgetq_lane_f64(m20, 0), (int64_t) vgetq_lane_f64(count0, 0));
+    welford_merge(mean, m2, n, vgetq_lane_f64(mean0, 1), vgetq_lane_f64(m20, 1), (int64_t) vgetq_lane_f64(count0, 1));
+    welford_merge(mean, m2, n, vgetq_lane_f64(mean1, 0), vgetq_lane_f64(m21, 0), (int64_t) vgetq_lane_f64(count1, 0));
+    welford_merge(mean, m2, n, vgetq_lane_f64(mean1, 1), vgetq_lane_f64(m21, 1), (int64_t) vgetq_lane_f64(count1, 1));
+
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (std::isfinite(x)) {
+            welford_add(mean, m2, n, x);
+        }
+    }
+    welford_merge(state->mean, state->m2, state->count, mean, m2, n);
+}
+
+int64_t countFloat_Neon(float *pf, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 8;
+    const float *lim = pf + count;
+    const float *lim_vec = lim - step + 1;
+    uint64x2_t cnt = vdupq_n_u64(0);
+    for (; pf < lim_vec; pf += step) {
+        MM_PREFETCH_T1(pf + 63 * step);
+        const float32x4_t v0 = vld1q_f32(pf);
+        const float32x4_t v1 = vld1q_f32(pf + 4);
+        const uint32x4_t m0 = vshrq_n_u32(vceqq_f32(v0, v0), 31);
+        const uint32x4_t m1 = vshrq_n_u32(vceqq_f32(v1, v1), 31);
+        cnt = vpadalq_u32(cnt, vaddq_u32(m0, m1));
+    }
+    int64_t n = (int64_t) vaddvq_u64(cnt);
+    for (; pf < lim; pf++) {
+        const float v = *pf;
+        n += (v == v);
+    }
+    return n;
+}
+
+double sumFloat_Neon(float *pf, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 4;
+    const float *lim = pf + count;
+    const float *lim_vec = lim - step + 1;
+    const float32x4_t inf = vdupq_n_f32(F_MAX);
+    float64x2_t sum0 = vdupq_n_f64(0);
+    float64x2_t sum1 = vdupq_n_f64(0);
+    uint32x4_t seen = vdupq_n_u32(0);
+    for (; pf < lim_vec; pf += step) {
+        MM_PREFETCH_T1(pf + 63 * step);
+        const float32x4_t v = vld1q_f32(pf);
+        // NaN fails the comparison too, so the mask selects finite lanes
+        const uint32x4_t m = vcltq_f32(vabsq_f32(v), inf);
+        const float32x4_t f = vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(v)));
+        sum0 = vaddq_f64(sum0, vcvt_f64_f32(vget_low_f32(f)));
+        sum1 = vaddq_f64(sum1, vcvt_high_f64_f32(f));
+        seen = vorrq_u32(seen, m);
+    }
+    double sum = vaddvq_f64(vaddq_f64(sum0, sum1));
+    bool hasData = vmaxvq_u32(seen) != 0;
+    for (; pf < lim; pf++) {
+        const float v = *pf;
+        if (std::isfinite(v)) {
+            sum += v;
+            hasData = true;
+        }
+    }
+    return hasData ? sum : NAN;
+}
+
+float minFloat_Neon(float *pf, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 8;
+    const float *lim = pf + count;
+    const float *lim_vec = lim - step + 1;
+    float32x4_t min0 = vdupq_n_f32(F_MAX);
+    float32x4_t min1 = vdupq_n_f32(F_MAX);
+    uint32x4_t seen = vdupq_n_u32(0);
+    for (; pf < lim_vec; pf += step) {
+        MM_PREFETCH_T1(pf + 63 * step);
+        const float32x4_t v0 = vld1q_f32(pf);
+        const float32x4_t v1 = vld1q_f32(pf + 4);
+        const uint32x4_t m0 = vceqq_f32(v0, v0);
+        const uint32x4_t m1 = vceqq_f32(v1, v1);
+        min0 = vbslq_f32(m0, vminq_f32(min0, v0), min0);
+        min1 = vbslq_f32(m1, vminq_f32(min1, v1), min1);
+        seen = vorrq_u32(seen, vorrq_u32(m0, m1));
+    }
+    float min = vminvq_f32(vminq_f32(min0, min1));
+    bool hasData = vmaxvq_u32(seen) != 0;
+    for (; pf < lim; pf++) {
+        const float v = *pf;
+        if (v == v) {
+            min = std::min(min, v);
+            hasData = true;
+        }
+    }
+    return hasData ? min : NAN;
+}
+
+float maxFloat_Neon(float *pf, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+    const int step = 8;
+    const float *lim = pf + count;
+    const float *lim_vec = lim - step + 1;
+    float32x4_t max0 = vdupq_n_f32(F_MIN);
+    float32x4_t max1 = vdupq_n_f32(F_MIN);
+    uint32x4_t seen = vdupq_n_u32(0);
+    for (; pf < lim_vec; pf += step) {
+        MM_PREFETCH_T1(pf + 63 * step);
+        const float32x4_t v0 = vld1q_f32(pf);
+        const float32x4_t v1 = vld1q_f32(pf + 4);
+        const uint32x4_t m0 = vceqq_f32(v0, v0);
+        const uint32x4_t m1 = vceqq_f32(v1, v1);
+        max0 = vbslq_f32(m0, vmaxq_f32(max0, v0), max0);
+        max1 = vbslq_f32(m1, vmaxq_f32(max1, v1), max1);
+        seen = vorrq_u32(seen, vorrq_u32(m0, m1));
+    }
+    float max = vmaxvq_f32(vmaxq_f32(max0, max1));
+    bool hasData = vmaxvq_u32(seen) != 0;
+    for (; pf < lim; pf++) {
+        const float v = *pf;
+        if (v == v) {
+            max = std::max(max, v);
+            hasData = true;
+        }
+    }
+    return hasData ? max : NAN;
+}
+
+int64_t countInt_Neon(int32_t *pi, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 8;
+    const int32_t *lim = pi + count;
+    const int32_t *lim_vec = lim - step + 1;
+    const int32x4_t nullVec = vdupq_n_s32(I_MIN);
+    uint64x2_t nulls = vdupq_n_u64(0);
+    for (; pi < lim_vec; pi += step) {
+        MM_PREFETCH_T1(pi + 63 * step);
+        const uint32x4_t m0 = vshrq_n_u32(vceqq_s32(vld1q_s32(pi), nullVec), 31);
+        const uint32x4_t m1 = vshrq_n_u32(vceqq_s32(vld1q_s32(pi + 4), nullVec), 31);
+        nulls = vpadalq_u32(nulls, vaddq_u32(m0, m1));
+    }
+    // rows left for the scalar loop are counted there
+    int64_t cnt = count - (lim - pi) - (int64_t) vaddvq_u64(nulls);
+    for (; pi < lim; pi++) {
+        cnt += (*pi != I_MIN);
+    }
+    return cnt;
+}
+
+int64_t sumInt_Neon(int32_t *pi, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int step = 8;
+    const int32_t *lim = pi + count;
+    const int32_t *lim_vec = lim - step + 1;
+    const int32x4_t nullVec = vdupq_n_s32(I_MIN);
+    int64x2_t sum = vdupq_n_s64(0);
+    uint32x4_t hasDataVec = vdupq_n_u32(0);
+    for (; pi < lim_vec; pi += step) {
+        MM_PREFETCH_T1(pi + 63 * step);
+        const int32x4_t v0 = vld1q_s32(pi);
+        const int32x4_t v1 = vld1q_s32(pi + 4);
+        const uint32x4_t m0 = vceqq_s32(v0, nullVec);
+        const uint32x4_t m1 = vceqq_s32(v1, nullVec);
+        // widening pairwise add keeps 64-bit lanes, so the sum does not overflow
+        sum = vpadalq_s32(sum, vbicq_s32(v0, vreinterpretq_s32_u32(m0)));
+        sum = vpadalq_s32(sum, vbicq_s32(v1, vreinterpretq_s32_u32(m1)));
+        hasDataVec = vornq_u32(hasDataVec, vandq_u32(m0, m1));
+    }
+    int64_t s = vaddvq_s64(sum);
+    bool hasData = vmaxvq_u32(hasDataVec) != 0;
+    for (; pi < lim; pi++) {
+        const int32_t i = *pi;
+        if (i != I_MIN) {
+            s += i;
+            hasData = true;
+        }
+    }
+    return hasData ? s : L_MIN;
+}
+
+int32_t minInt_Neon(int32_t *pi, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int step = 8;
+    const int32_t *lim = pi + count;
+    const int32_t *lim_vec = lim - step + 1;
+    const int32x4_t nullVec = vdupq_n_s32(I_MIN);
+    const int32x4_t maxVec = vdupq_n_s32(I_MAX);
+    // nulls are replaced with I_MAX, dataVec tells whether any lane saw a value
+    int32x4_t min0 = maxVec;
+    int32x4_t min1 = maxVec;
+    uint32x4_t dataVec = vdupq_n_u32(0);
+    for (; pi < lim_vec; pi += step) {
+        MM_PREFETCH_T1(pi + 63 * step);
+        const int32x4_t v0 = vld1q_s32(pi);
+        const int32x4_t v1 = vld1q_s32(pi + 4);
+        const uint32x4_t m0 = vceqq_s32(v0, nullVec);
+        const uint32x4_t m1 = vceqq_s32(v1, nullVec);
+        min0 = vminq_s32(min0, vbslq_s32(m0, maxVec, v0));
+        min1 = vminq_s32(min1, vbslq_s32(m1, maxVec, v1));
+        dataVec = vornq_u32(dataVec, vandq_u32(m0, m1));
+    }
+    int32_t min = I_MIN;
+    if (vmaxvq_u32(dataVec) != 0) {
+        min = vminvq_s32(vminq_s32(min0, min1));
+    }
+    for (; pi < lim; pi++) {
+        const int32_t i = *pi;
+        if (i != I_MIN && (i < min || min == I_MIN)) {
+            min = i;
+        }
+    }
+    return min;
+}
+
+int32_t maxInt_Neon(int32_t *pi, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int step = 8;
+    const int32_t *lim = pi + count;
+    const int32_t *lim_vec = lim - step + 1;
+    // null is the smallest int, plain max skips it
+    int32x4_t max0 = vdupq_n_s32(I_MIN);
+    int32x4_t max1 = vdupq_n_s32(I_MIN);
+    for (; pi < lim_vec; pi += step) {
+        MM_PREFETCH_T1(pi + 63 * step);
+        max0 = vmaxq_s32(max0, vld1q_s32(pi));
+        max1 = vmaxq_s32(max1, vld1q_s32(pi + 4));
+    }
+    int32_t max = vmaxvq_s32(vmaxq_s32(max0, max1));
+    for (; pi < lim; pi++) {
+        if (*pi > max) {
+            max = *pi;
+        }
+    }
+    return max;
+}
+
+void statsInt_Neon(int32_t *pi, int64_t count, column_stats_t<int64_t> *stats) {
+    int64_t nulls = 0;
+    int64_t sum = 0;
+    int32_t min = I_MIN;
+    int32_t max = I_MIN;
+    if (count > 0) {
+        const int step = 8;
+        const int32_t *lim = pi + count;
+        const int32_t *lim_vec = lim - step + 1;
+        const int32x4_t nullVec = vdupq_n_s32(I_MIN);
+        const int32x4_t maxVec = vdupq_n_s32(I_MAX);
+        int64x2_t sumVec = vdupq_n_s64(0);
+        uint64x2_t nullsVec = vdupq_n_u64(0);
+        // nulls are replaced with I_MAX for min, null is the smallest int, plain max skips it
+        int32x4_t min0 = maxVec;
+        int32x4_t min1 = maxVec;
+        int32x4_t max0 = nullVec;
+        int32x4_t max1 = nullVec;
+        for (; pi < lim_vec; pi += step) {
+            MM_PREFETCH_T1(pi + 63 * step);
+            const int32x4_t v0 = vld1q_s32(pi);
+            const int32x4_t v1 = vld1q_s32(pi + 4);
+            const uint32x4_t m0 = vceqq_s32(v0, nullVec);
+            const uint32x4_t m1 = vceqq_s32(v1, nullVec);
+            nullsVec = vpadalq_u32(nullsVec, vaddq_u32(vshrq_n_u32(m0, 31), vshrq_n_u32(m1, 31)));
+            sumVec = vpadalq_s32(sumVec, vbicq_s32(v0, vreinterpretq_s32_u32(m0)));
+            sumVec = vpadalq_s32(sumVec, vbicq_s32(v1, vreinterpretq_s32_u32(m1)));
+            min0 = vminq_s32(min0, vbslq_s32(m0, maxVec, v0));
+            min1 = vminq_s32(min1, vbslq_s32(m1, maxVec, v1));
+            max0 = vmaxq_s32(max0, v0);
+            max1 = vmaxq_s32(max1, v1);
+        }
+        nulls = (int64_t) vaddvq_u64(nullsVec);
+        sum = vaddvq_s64(sumVec);
+        max = vmaxvq_s32(vmaxq_s32(max0, max1));
+        // min lanes hold I_MAX unless they saw a value
+        if (count - (lim - pi) > nulls) {
+            min = vminvq_s32(vminq_s32(min0, min1));
+        }
+        for (; pi < lim; pi++) {
+            const int32_t i = *pi;
+            if (i != I_MIN) {
+                sum += i;
+                if (i < min || min == I_MIN) {
+                    min = i;
+                }
+                if (i > max) {
+                    max = i;
+                }
+            } else {
+                nulls++;
+            }
+        }
+    }
+    stats->count = count - nulls;
+    stats->null_count = nulls;
+    stats->sum = nulls < count ? sum : L_MIN;
+    stats->min = min;
+    stats->max = max;
+}
+
+int64_t countLong_Neon(int64_t *pl, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 4;
+    const int64_t *lim = pl + count;
+    const int64_t *lim_vec = lim - step + 1;
+    const int64x2_t nullVec = vdupq_n_s64(L_MIN);
+    int64x2_t nulls = vdupq_n_s64(0);
+    for (; pl < lim_vec; pl += step) {
+        MM_PREFETCH_T1(pl + 63 * step);
+        const uint64x2_t m0 = vceqq_s64(vld1q_s64(pl), nullVec);
+        const uint64x2_t m1 = vceqq_s64(vld1q_s64(pl + 2), nullVec);
+        nulls = vsubq_s64(nulls, vreinterpretq_s64_u64(vaddq_u64(m0, m1)));
+    }
+    // rows left for the scalar loop are counted there
+    int64_t cnt = count - (lim - pl) - vaddvq_s64(nulls);
+    for (; pl < lim; pl++) {
+        cnt += (*pl != L_MIN);
+    }
+    return cnt;
+}
+
+int64_t sumLong_Neon(int64_t *pl, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int step = 4;
+    const int64_t *lim = pl + count;
+    const int64_t *lim_vec = lim - step + 1;
+    const int64x2_t nullVec = vdupq_n_s64(L_MIN);
+    int64x2_t sum0 = vdupq_n_s64(0);
+    int64x2_t sum1 = vdupq_n_s64(0);
+    uint64x2_t hasDataVec = vdupq_n_u64(0);
+    for (; pl < lim_vec; pl += step) {
+        MM_PREFETCH_T1(pl + 63 * step);
+        const int64x2_t v0 = vld1q_s64(pl);
+        const int64x2_t v1 = vld1q_s64(pl + 2);
+        const uint64x2_t m0 = vceqq_s64(v0, nullVec);
+        const uint64x2_t m1 = vceqq_s64(v1, nullVec);
+        sum0 = vaddq_s64(sum0, vbicq_s64(v0, vreinterpretq_s64_u64(m0)));
+        sum1 = vaddq_s64(sum1, vbicq_s64(v1, vreinterpretq_s64_u64(m1)));
+        hasDataVec = vornq_u64(hasDataVec, vandq_u64(m0, m1));
+    }
+    int64_t sum = vaddvq_s64(vaddq_s64(sum0, sum1));
+    bool hasData = vaddvq_u64(hasDataVec) != 0;
+    for (; pl < lim; pl++) {
+        const int64_t l = *pl;
+        if (l != L_MIN) {
+            sum += l;
+            hasData = true;
+        }
+    }
+    return hasData ? sum : L_MIN;
+}
+
+int64_t minLong_Neon(int64_t *pl, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int step = 2;
+    const int64_t *lim = pl + count;
+    const int64_t *lim_vec = lim - step + 1;
+    const int64x2_t nullVec = vdupq_n_s64(L_MIN);
+    int64x2_t vecMin = nullVec;
+    for (; pl < lim_vec; pl += step) {
+        MM_PREFETCH_T1(pl + 63 * step);
+        int64x2_t v = vld1q_s64(pl);
+        vecMin = vbslq_s64(vceqq_s64(vecMin, nullVec), v, vecMin);
+        v = vbslq_s64(vceqq_s64(v, nullVec), vecMin, v);
+        // at this point v and vecMin lanes are either both == L_MIN or != L_MIN,
+        // so we can safely apply the min function, there is no 64-bit vminq
+        vecMin = vbslq_s64(vcgtq_s64(vecMin, v), v, vecMin);
+    }
+    int64_t min = L_MIN;
+    const int64_t lanes[] = {vgetq_lane_s64(vecMin, 0), vgetq_lane_s64(vecMin, 1)};
+    for (int64_t n: lanes) {
+        if (n != L_MIN && (n < min || min == L_MIN)) {
+            min = n;
+        }
+    }
+    for (; pl < lim; pl++) {
+        const int64_t x = *pl;
+        if (x != L_MIN && (x < min || min == L_MIN)) {
+            min = x;
+        }
+    }
+    return min;
+}
+
+int64_t maxLong_Neon(int64_t *pl, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int step = 4;
+    const int64_t *lim = pl + count;
+    const int64_t *lim_vec = lim - step + 1;
+    int64x2_t max0 = vdupq_n_s64(L_MIN);
+    int64x2_t max1 = vdupq_n_s64(L_MIN);
+    for (; pl < lim_vec; pl += step) {
+        MM_PREFETCH_T1(pl + 63 * step);
+        const int64x2_t v0 = vld1q_s64(pl);
+        const int64x2_t v1 = vld1q_s64(pl + 2);
+        max0 = vbslq_s64(vcgtq_s64(v0, max0), v0, max0);
+        max1 = vbslq_s64(vcgtq_s64(v1, max1), v1, max1);
+    }
+    max0 = vbslq_s64(vcgtq_s64(max1, max0), max1, max0);
+    int64_t max = std::max(vgetq_lane_s64(max0, 0), vgetq_lane_s64(max0, 1));
+    for (; pl < lim; pl++) {
+        if (*pl > max) {
+            max = *pl;
+        }
+    }
+    return max;
+}
+
+void statsLong_Neon(int64_t *pl, int64_t count, column_stats_t<int64_t> *stats) {
+    int64_t nulls = 0;
+    int64_t sum = 0;
+    int64_t min = L_MIN;
+    int64_t max = L_MIN;
+    if (count > 0) {
+        const int step = 4;
+        const int64_t *lim = pl + count;
+        const int64_t *lim_vec = lim - step + 1;
+        const int64x2_t nullVec = vdupq_n_s64(L_MIN);
+        int64x2_t sum0 = vdupq_n_s64(0);
+        int64x2_t sum1 = vdupq_n_s64(0);
+        int64x2_t nullsVec = vdupq_n_s64(0);
+        int64x2_t min0 = nullVec;
+        int64x2_t min1 = nullVec;
+        int64x2_t max0 = nullVec;
+        int64x2_t max1 = nullVec;
+        for (; pl < lim_vec; pl += step) {
+            MM_PREFETCH_T1(pl + 63 * step);
+            int64x2_t v0 = vld1q_s64(pl);
+            int64x2_t v1 = vld1q_s64(pl + 2);
+            const uint64x2_t m0 = vceqq_s64(v0, nullVec);
+            const uint64x2_t m1 = vceqq_s64(v1, nullVec);
+            nullsVec = vsubq_s64(nullsVec, vreinterpretq_s64_u64(vaddq_u64(m0, m1)));
+            sum0 = vaddq_s64(sum0, vbicq_s64(v0, vreinterpretq_s64_u64(m0)));
+            sum1 = vaddq_s64(sum1, vbicq_s64(v1, vreinterpretq_s64_u64(m1)));
+            max0 = vbslq_s64(vcgtq_s64(v0, max0), v0, max0);
+            max1 = vbslq_s64(vcgtq_s64(v1, max1), v1, max1);
+            // same as in minLong_Neon, lanes of v and min are either both null or both not null
+            min0 = vbslq_s64(vceqq_s64(min0, nullVec), v0, min0);
+            min1 = vbslq_s64(vceqq_s64(min1, nullVec), v1, min1);
+            v0 = vbslq_s64(m0, min0, v0);
+            v1 = vbslq_s64(m1, min1, v1);
+            min0 = vbslq_s64(vcgtq_s64(min0, v0), v0, min0);
+            min1 = vbslq_s64(vcgtq_s64(min1, v1), v1, min1);
+        }
+        nulls = vaddvq_s64(nullsVec);
+        sum = vaddvq_s64(vaddq_s64(sum0, sum1));
+        max0 = vbslq_s64(vcgtq_s64(max1, max0), max1, max0);
+        max = std::max(vgetq_lane_s64(max0, 0), vgetq_lane_s64(max0, 1));
+        const int64_t lanes[] = {
+                vgetq_lane_s64(min0, 0), vgetq_lane_s64(min0, 1),
+                vgetq_lane_s64(min1, 0), vgetq_lane_s64(min1, 1)
+        };
+        for (int64_t n: lanes) {
+            if (n != L_MIN && (n < min || min == L_MIN)) {
+                min = n;
+            }
+        }
+        for (; pl < lim; pl++) {
+            const int64_t l = *pl;
+            if (l != L_MIN) {
+                sum += l;
+                if (l < min || min == L_MIN) {
+                    min = l;
+                }
+                if (l > max) {
+                    max = l;
+                }
+            } else {
+                nulls++;
+            }
+        }
+    }
+    stats->count = count - nulls;
+    stats->null_count = nulls;
+    stats->sum = nulls < count ? sum : L_MIN;
+    stats->min = min;
+    stats->max = max;
+}
+
+int64_t countLong128_Neon(int64_t *pl, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 4;
+    const int64_t *lim = pl + 2 * count;
+    const int64_t *lim_vec = lim - 2 * step + 1;
+    const uint64x2_t nullVec = vdupq_n_u64((uint64_t) L_MIN);
+    int64x2_t nulls = vdupq_n_s64(0);
+    for (; pl < lim_vec; pl += 2 * step) {
+        MM_PREFETCH_T1(pl + 63 * 2 * step);
+        // de-interleave lo and hi halves of two values per load
+        const uint64x2x2_t v0 = vld2q_u64((const uint64_t *) pl);
+        const uint64x2x2_t v1 = vld2q_u64((const uint64_t *) (pl + 4));
+        const uint64x2_t m0 = vandq_u64(vceqq_u64(v0.val[0], nullVec), vceqq_u64(v0.val[1], nullVec));
+        const uint64x2_t m1 = vandq_u64(vceqq_u64(v1.val[0], nullVec), vceqq_u64(v1.val[1], nullVec));
+        nulls = vsubq_s64(nulls, vreinterpretq_s64_u64(vaddq_u64(m0, m1)));
+    }
+    // values left for the scalar loop are counted there
+    int64_t cnt = count - (lim - pl) / 2 - vaddvq_s64(nulls);
+    for (; pl < lim; pl += 2) {
+        cnt += (pl[0] != L_MIN || pl[1] != L_MIN);
+    }
+    return cnt;
+}
+
+int64_t sumShort_Neon(int16_t *ps, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int step = 16;
+    const int16_t *lim = ps + count;
+    const int16_t *lim_vec = lim - step + 1;
+    int64x2_t sum = vdupq_n_s64(0);
+    for (; ps < lim_vec; ps += step) {
+        MM_PREFETCH_T1(ps + 63 * step);
+        const int32x4_t s0 = vpaddlq_s16(vld1q_s16(ps));
+        const int32x4_t s1 = vpaddlq_s16(vld1q_s16(ps + 8));
+        sum = vpadalq_s32(sum, vaddq_s32(s0, s1));
+    }
+    int64_t s = vaddvq_s64(sum);
+    for (; ps < lim; ps++) {
+        s += *ps;
+    }
+    return s;
+}
+
+int32_t minShort_Neon(int16_t *ps, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int step = 16;
+    const int16_t *lim = ps + count;
+    const int16_t *lim_vec = lim - step + 1;
+    int16x8_t min0 = vdupq_n_s16(INT16_MAX);
+    int16x8_t min1 = vdupq_n_s16(INT16_MAX);
+    for (; ps < lim_vec; ps += step) {
+        MM_PREFETCH_T1(ps + 63 * step);
+        min0 = vminq_s16(min0, vld1q_s16(ps));
+        min1 = vminq_s16(min1, vld1q_s16(ps + 8));
+    }
+    int32_t min = vminvq_s16(vminq_s16(min0, min1));
+    for (; ps < lim; ps++) {
+        if (*ps < min) {
+            min = *ps;
+        }
+    }
+    return min;
+}
+
+int32_t maxShort_Neon(int16_t *ps, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int step = 16;
+    const int16_t *lim = ps + count;
+    const int16_t *lim_vec = lim - step + 1;
+    int16x8_t max0 = vdupq_n_s16(INT16_MIN);
+    int16x8_t max1 = vdupq_n_s16(INT16_MIN);
+    for (; ps < lim_vec; ps += step) {
+        MM_PREFETCH_T1(ps + 63 * step);
+        max0 = vmaxq_s16(max0, vld1q_s16(ps));
+        max1 = vmaxq_s16(max1, vld1q_s16(ps + 8));
+    }
+    int32_t max = vmaxvq_s16(vmaxq_s16(max0, max1));
+    for (; ps < lim; ps++) {
+        if (*ps > max) {
+            max = *ps;
+        }
+    }
+    return max;
+}
+
+int64_t sumByte_Neon(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int step = 32;
+    const int8_t *lim = pb + count;
+    const int8_t *lim_vec = lim - step + 1;
+    int64x2_t sum = vdupq_n_s64(0);
+    for (; pb < lim_vec; pb += step) {
+        MM_PREFETCH_T1(pb + 63 * step);
+        const int16x8_t s0 = vpaddlq_s8(vld1q_s8(pb));
+        const int16x8_t s1 = vpaddlq_s8(vld1q_s8(pb + 16));
+        sum = vpadalq_s32(sum, vpaddlq_s16(vaddq_s16(s0, s1)));
+    }
+    int64_t s = vaddvq_s64(sum);
+    for (; pb < lim; pb++) {
+        s += *pb;
+    }
+    return s;
+}
+
+int32_t minByte_Neon(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int step = 32;
+    const int8_t *lim = pb + count;
+    const int8_t *lim_vec = lim - step + 1;
+    int8x16_t min0 = vdupq_n_s8(INT8_MAX);
+    int8x16_t min1 = vdupq_n_s8(INT8_MAX);
+    for (; pb < lim_vec; pb += step) {
+        MM_PREFETCH_T1(pb + 63 * step);
+        min0 = vminq_s8(min0, vld1q_s8(pb));
+        min1 = vminq_s8(min1, vld1q_s8(pb + 16));
+    }
+    int32_t min = vminvq_s8(vminq_s8(min0, min1));
+    for (; pb < lim; pb++) {
+        min = std::min(min, (int32_t) *pb);
+    }
+    return min;
+}
+
+int32_t maxByte_Neon(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int step = 32;
+    const int8_t *lim = pb + count;
+    const int8_t *lim_vec = lim - step + 1;
+    int8x16_t max0 = vdupq_n_s8(INT8_MIN);
+    int8x16_t max1 = vdupq_n_s8(INT8_MIN);
+    for (; pb < lim_vec; pb += step) {
+        MM_PREFETCH_T1(pb + 63 * step);
+        max0 = vmaxq_s8(max0, vld1q_s8(pb));
+        max1 = vmaxq_s8(max1, vld1q_s8(pb + 16));
+    }
+    int32_t max = vmaxvq_s8(vmaxq_s8(max0, max1));
+    for (; pb < lim; pb++) {
+        max = std::max(max, (int32_t) *pb);
+    }
+    return max;
+}
+
+// see MIN_CHAR in vec_agg.cpp, 0 is null and wraps around to the largest value
+int32_t minChar_Neon(uint16_t *pc, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 16;
+    const uint16_t *lim = pc + count;
+    const uint16_t *lim_vec = lim - step + 1;
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t min0 = vdupq_n_u16(UINT16_MAX);
+    uint16x8_t min1 = vdupq_n_u16(UINT16_MAX);
+    for (; pc < lim_vec; pc += step) {
+        MM_PREFETCH_T1(pc + 63 * step);
+        min0 = vminq_u16(min0, vsubq_u16(vld1q_u16(pc), one));
+        min1 = vminq_u16(min1, vsubq_u16(vld1q_u16(pc + 8), one));
+    }
+    uint16_t min = vminvq_u16(vminq_u16(min0, min1));
+    for (; pc < lim; pc++) {
+        min = std::min(min, (uint16_t) (*pc - 1));
+    }
+    return (uint16_t) (min + 1);
+}
+
+int32_t maxChar_Neon(uint16_t *pc, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const int step = 16;
+    const uint16_t *lim = pc + count;
+    const uint16_t *lim_vec = lim - step + 1;
+    uint16x8_t max0 = vdupq_n_u16(0);
+    uint16x8_t max1 = vdupq_n_u16(0);
+    for (; pc < lim_vec; pc += step) {
+        MM_PREFETCH_T1(pc + 63 * step);
+        max0 = vmaxq_u16(max0, vld1q_u16(pc));
+        max1 = vmaxq_u16(max1, vld1q_u16(pc + 8));
+    }
+    uint16_t max = vmaxvq_u16(vmaxq_u16(max0, max1));
+    for (; pc < lim; pc++) {
+        max = std::max(max, *pc);
+    }
+    return max;
+}
+
+// SAMPLE BY, see vec_ts_agg.cpp
+
+int64_t sampleByBuckets_Neon(
+        const int64_t *ts,
+        int64_t count,
+        int64_t start,
+        int64_t stride,
+        int64_t bucket_ts,
+        int64_t *buckets,
+        int64_t max_buckets
+) {
+    const int step = 4;
+    int64_t bucket_count = 0;
+    int64_t i = 0;
+    while (i < count && bucket_count < max_buckets) {
+        // wraps around as in Java
+        const int64_t hi = (int64_t) ((uint64_t) bucket_ts + (uint64_t) stride);
+        const int64x2_t hiVec = vdupq_n_s64(hi);
+        // timestamps are sorted, rows of the bucket are the leading lanes below hi
+        for (; i < count - step + 1; i += step) {
+            MM_PREFETCH_T1(ts + i + 63 * step);
+            const uint64x2_t m0 = vcltq_s64(vld1q_s64(ts + i), hiVec);
+            const uint64x2_t m1 = vcltq_s64(vld1q_s64(ts + i + 2), hiVec);
+            const int64_t n = -vaddvq_s64(vaddq_s64(vreinterpretq_s64_u64(m0), vreinterpretq_s64_u64(m1)));
+            if (n < step) {
+                i += n;
+                goto bucket_end;
+            }
+        }
+        while (i < count && ts[i] < hi) {
+            i++;
+        }
+
+        bucket_end:
+        buckets[2 * bucket_count] = bucket_ts;
+        buckets[2 * bucket_count + 1] = i;
+        bucket_count++;
+        if (i < count) {
+            bucket_ts = start + ((ts[i] - start) / stride) * stride;
+        }
+    }
+    return bucket_count;
+}
+
+void bucketStatsDouble_Neon(const double *d, int64_t count, bucket_stats_t<double> *stats) {
+    int64_t cnt = 0;
+    int64_t sumCnt = 0;
+    double sum = 0;
+    double min = D_MAX;
+    double max = D_MIN;
+    const int step = 4;
+    const double *lim = d + count;
+    const double *lim_vec = lim - step + 1;
+    if (count >= step) {
+        const float64x2_t inf = vdupq_n_f64(D_MAX);
+        float64x2_t sum0 = vdupq_n_f64(0);
+        float64x2_t sum1 = vdupq_n_f64(0);
+        float64x2_t min0 = inf;
+        float64x2_t min1 = inf;
+        float64x2_t max0 = vdupq_n_f64(D_MIN);
+        float64x2_t max1 = vdupq_n_f64(D_MIN);
+        int64x2_t cntVec = vdupq_n_s64(0);
+        int64x2_t sumCntVec = vdupq_n_s64(0);
+        for (; d < lim_vec; d += step) {
+            MM_PREFETCH_T1(d + 63 * step);
+            const float64x2_t v0 = vld1q_f64(d);
+            const float64x2_t v1 = vld1q_f64(d + 2);
+            const uint64x2_t m0 = vceqq_f64(v0, v0);
+            const uint64x2_t m1 = vceqq_f64(v1, v1);
+            // infinities are counted, but not summed
+            const uint64x2_t f0 = vcltq_f64(vabsq_f64(v0), inf);
+            const uint64x2_t f1 = vcltq_f64(vabsq_f64(v1), inf);
+            sum0 = vaddq_f64(sum0, vreinterpretq_f64_u64(vandq_u64(f0, vreinterpretq_u64_f64(v0))));
+            sum1 = vaddq_f64(sum1, vreinterpretq_f64_u64(vandq_u64(f1, vreinterpretq_u64_f64(v1))));
+            min0 = vbslq_f64(m0, vminq_f64(min0, v0), min0);
+            min1 = vbslq_f64(m1, vminq_f64(min1, v1), min1);
+            max0 = vbslq_f64(m0, vmaxq_f64(max0, v0), max0);
+            max1 = vbslq_f64(m1, vmaxq_f64(max1, v1), max1);
+            cntVec = vsubq_s64(cntVec, vreinterpretq_s64_u64(vaddq_u64(m0, m1)));
+            sumCntVec = vsubq_s64(sumCntVec, vreinterpretq_s64_u64(vaddq_u64(f0, f1)));
+        }
+        cnt = vaddvq_s64(cntVec);
+        sumCnt = vaddvq_s64(sumCntVec);
+        sum = vaddvq_f64(vaddq_f64(sum0, sum1));
+        min = vminvq_f64(vminq_f64(min0, min1));
+        max = vmaxvq_f64(vmaxq_f64(max0, max1));
+    }
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (x == x) {
+            cnt++;
+            if (std::isfinite(x)) {
+                sum += x;
+                sumCnt++;
+            }
+            min = std::min(min, x);
+            max = std::max(max, x);
+        }
+    }
+    stats->count = cnt;
+    stats->sum_count = sumCnt;
+    stats->sum = sum;
+    stats->min = cnt > 0 ? min : NAN;
+    stats->max = cnt > 0 ? max : NAN;
+}
+
+// bucket stats of INT and LONG pages are page stats of the bucket rows with an empty sum of 0
+
+void bucketStatsInt_Neon(const int32_t *pi, int64_t count, bucket_stats_t<int64_t> *stats) {
+    column_stats_t<int64_t> page_stats;
+    statsInt_Neon(const_cast<int32_t *>(pi), count, &page_stats);
+    *stats = {page_stats.count, page_stats.count, page_stats.count > 0 ? page_stats.sum : 0, page_stats.min, page_stats.max};
+}
+
+void bucketStatsLong_Neon(const int64_t *pl, int64_t count, bucket_stats_t<int64_t> *stats) {
+    column_stats_t<int64_t> page_stats;
+    statsLong_Neon(const_cast<int64_t *>(pl), count, &page_stats);
+    *stats = {page_stats.count, page_stats.count, page_stats.count > 0 ? page_stats.sum : 0, page_stats.min, page_stats.max};
+}
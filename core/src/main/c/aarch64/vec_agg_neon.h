@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef VEC_AGG_NEON_H
+#define VEC_AGG_NEON_H
+
+#include <cstdint>
+#include "../share/util.h"
+
+int64_t countDouble_Neon(double *d, int64_t count);
+
+double sumDouble_Neon(double *d, int64_t count);
+
+double sumDoubleKahan_Neon(double *d, int64_t count);
+
+double sumDoubleNeumaier_Neon(double *d, int64_t count);
+
+double minDouble_Neon(double *d, int64_t count);
+
+double maxDouble_Neon(double *d, int64_t count);
+
+void varianceDouble_Neon(double *d, int64_t count, welford_t *state);
+
+void statsDouble_Neon(double *d, int64_t count, column_stats_t<double> *stats);
+
+int64_t countFloat_Neon(float *pf, int64_t count);
+
+double sumFloat_Neon(float *pf, int64_t count);
+
+float minFloat_Neon(float *pf, int64_t count);
+
+float maxFloat_Neon(float *pf, int64_t count);
+
+int64_t countInt_Neon(int32_t *pi, int64_t count);
+
+int64_t sumInt_Neon(int32_t *pi, int64_t count);
+
+int32_t minInt_Neon(int32_t *pi, int64_t count);
+
+int32_t maxInt_Neon(int32_t *pi, int64_t count);
+
+void statsInt_Neon(int32_t *pi, int64_t count, column_stats_t<int64_t> *stats);
+
+int64_t countLong_Neon(int64_t *pl, int64_t count);
+
+int64_t sumLong_Neon(int64_t *pl, int64_t count);
+
+int64_t minLong_Neon(int64_t *pl, int64_t count);
+
+int64_t maxLong_Neon(int64_t *pl, int64_t count);
+
+void statsLong_Neon(int64_t *pl, int64_t count, column_stats_t<int64_t> *stats);
+
+int64_t countLong128_Neon(int64_t *pl, int64_t count);
+
+int64_t sumShort_Neon(int16_t *ps, int64_t count);
+
+int32_t minShort_Neon(int16_t *ps, int64_t count);
+
+int32_t maxShort_Neon(int16_t *ps, int64_t count);
+
+int64_t sumByte_Neon(int8_t *pb, int64_t count);
+
+int32_t minByte_Neon(int8_t *pb, int64_t count);
+
+int32_t maxByte_Neon(int8_t *pb, int64_t count);
+
+int32_t minChar_Neon(uint16_t *pc, int64_t count);
+
+int32_t maxChar_Neon(uint16_t *pc, int64_t count);
+
+int64_t sampleByBuckets_Neon(const int64_t *ts, int64_t count, int64_t start, int64_t stride, int64_t bucket_ts, int64_t *buckets, int64_t max_buckets);
+
+void bucketStatsDouble_Neon(const double *d, int64_t count, bucket_stats_t<double> *stats);
+
+void bucketStatsInt_Neon(const int32_t *pi, int64_t count, bucket_stats_t<int64_t> *stats);
+
+void bucketStatsLong_Neon(const int64_t *pl, int64_t count, bucket_stats_t<int64_t> *stats);
+
+#endif //VEC_AGG_NEON_H
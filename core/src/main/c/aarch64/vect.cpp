@@ -25,88 +25,260 @@
 #include <cstdio>
 #include <jni.h>
 #include <cstdint>
-#include "../share/vec_agg_vanilla.h"
+#include "vec_agg_neon.h"
+#include "../share/perf_counters.h"
+#include "instrset.h"
 
 
 extern "C" {
 
 // DOUBLE
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_countDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong count) {
-    return countDouble_Vanilla((double*) pDouble, count);
+    return measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        return countDouble_Neon((double*) pDouble, count);
+    });
 }
 
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_sumDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong count) {
-    return sumDouble_Vanilla((double*) pDouble, count);
+    return measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        return sumDouble_Neon((double*) pDouble, count);
+    });
 }
 
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_sumDoubleKahan(JNIEnv *env, jclass cl, jlong pDouble, jlong count) {
-    return sumDoubleKahan_Vanilla((double*) pDouble, count);
+    return measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        return sumDoubleKahan_Neon((double*) pDouble, count);
+    });
 }
 
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_sumDoubleNeumaier(JNIEnv *env, jclass cl, jlong pDouble, jlong count) {
-    return sumDoubleNeumaier_Vanilla((double*) pDouble, count);
+    return measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        return sumDoubleNeumaier_Neon((double*) pDouble, count);
+    });
 }
 
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_minDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong count) {
-    return minDouble_Vanilla((double*) pDouble, count);
+    return measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        return minDouble_Neon((double*) pDouble, count);
+    });
 }
 
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_maxDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong count) {
-    return maxDouble_Vanilla((double*) pDouble, count);
+    return measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        return maxDouble_Neon((double*) pDouble, count);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_varianceDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong count, jlong pState) {
+    measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        varianceDouble_Neon((double*) pDouble, count, (welford_t*) pState);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_statsDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong count, jlong pStats) {
+    measure_time(PERF_VEC_AGG_DOUBLE, count * (int64_t) sizeof(double), [=]() {
+        statsDouble_Neon((double*) pDouble, count, (column_stats_t<double>*) pStats);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_zoneMapDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong blockCount, jint blockRowsShift, jlong pZoneMap) {
+    zone_map((double *) pDouble, blockCount, blockRowsShift, (column_stats_t<double> *) pZoneMap, statsDouble_Neon);
+}
+
+// FLOAT
+
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_countFloat(JNIEnv *env, jclass cl, jlong pFloat, jlong count) {
+    return measure_time(PERF_VEC_AGG_FLOAT, count * (int64_t) sizeof(float), [=]() {
+        return countFloat_Neon((float *) pFloat, count);
+    });
+}
+
+JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_sumFloat(JNIEnv *env, jclass cl, jlong pFloat, jlong count) {
+    return measure_time(PERF_VEC_AGG_FLOAT, count * (int64_t) sizeof(float), [=]() {
+        return sumFloat_Neon((float *) pFloat, count);
+    });
+}
+
+JNIEXPORT jfloat JNICALL Java_io_questdb_std_Vect_minFloat(JNIEnv *env, jclass cl, jlong pFloat, jlong count) {
+    return measure_time(PERF_VEC_AGG_FLOAT, count * (int64_t) sizeof(float), [=]() {
+        return minFloat_Neon((float *) pFloat, count);
+    });
+}
+
+JNIEXPORT jfloat JNICALL Java_io_questdb_std_Vect_maxFloat(JNIEnv *env, jclass cl, jlong pFloat, jlong count) {
+    return measure_time(PERF_VEC_AGG_FLOAT, count * (int64_t) sizeof(float), [=]() {
+        return maxFloat_Neon((float *) pFloat, count);
+    });
 }
 
 // INT
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_countInt(JNIEnv *env, jclass cl, jlong pInt, jlong count) {
-    return countInt_Vanilla((int*) pInt, count);
+    return measure_time(PERF_VEC_AGG_INT, count * (int64_t) sizeof(int32_t), [=]() {
+        return countInt_Neon((int*) pInt, count);
+    });
 }
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_sumInt(JNIEnv *env, jclass cl, jlong pInt, jlong count) {
-    return sumInt_Vanilla((int*) pInt, count);
+    return measure_time(PERF_VEC_AGG_INT, count * (int64_t) sizeof(int32_t), [=]() {
+        return sumInt_Neon((int*) pInt, count);
+    });
 }
 
 JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_minInt(JNIEnv *env, jclass cl, jlong pInt, jlong count) {
-    return minInt_Vanilla((int*) pInt, count);
+    return measure_time(PERF_VEC_AGG_INT, count * (int64_t) sizeof(int32_t), [=]() {
+        return minInt_Neon((int*) pInt, count);
+    });
 }
 
 JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_maxInt(JNIEnv *env, jclass cl, jlong pInt, jlong count) {
-    return maxInt_Vanilla((int*) pInt, count);
+    return measure_time(PERF_VEC_AGG_INT, count * (int64_t) sizeof(int32_t), [=]() {
+        return maxInt_Neon((int*) pInt, count);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_statsInt(JNIEnv *env, jclass cl, jlong pInt, jlong count, jlong pStats) {
+    measure_time(PERF_VEC_AGG_INT, count * (int64_t) sizeof(int32_t), [=]() {
+        statsInt_Neon((int*) pInt, count, (column_stats_t<int64_t>*) pStats);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_zoneMapInt(JNIEnv *env, jclass cl, jlong pInt, jlong blockCount, jint blockRowsShift, jlong pZoneMap) {
+    zone_map((int32_t *) pInt, blockCount, blockRowsShift, (column_stats_t<int64_t> *) pZoneMap, statsInt_Neon);
 }
 
 // LONG
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_countLong(JNIEnv *env, jclass cl, jlong pLong, jlong count) {
-    return countLong_Vanilla((int64_t *) pLong, count);
+    return measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() {
+        return countLong_Neon((int64_t *) pLong, count);
+    });
 }
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_sumLong(JNIEnv *env, jclass cl, jlong pLong, jlong count) {
-    return sumLong_Vanilla((int64_t *) pLong, count);
+    return measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() {
+        return sumLong_Neon((int64_t *) pLong, count);
+    });
 }
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_minLong(JNIEnv *env, jclass cl, jlong pLong, jlong count) {
-    return minLong_Vanilla((int64_t *) pLong, count);
+    return measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() {
+        return minLong_Neon((int64_t *) pLong, count);
+    });
 }
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_maxLong(JNIEnv *env, jclass cl, jlong pLong, jlong count) {
-    return maxLong_Vanilla((int64_t *) pLong, count);
+    return measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() {
+        return maxLong_Neon((int64_t *) pLong, count);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_statsLong(JNIEnv *env, jclass cl, jlong pLong, jlong count, jlong pStats) {
+    measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() {
+        statsLong_Neon((int64_t *) pLong, count, (column_stats_t<int64_t>*) pStats);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_zoneMapLong(JNIEnv *env, jclass cl, jlong pLong, jlong blockCount, jint blockRowsShift, jlong pZoneMap) {
+    zone_map((int64_t *) pLong, blockCount, blockRowsShift, (column_stats_t<int64_t> *) pZoneMap, statsLong_Neon);
+}
+
+// LONG128
+
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_countLong128(JNIEnv *env, jclass cl, jlong pLong, jlong count) {
+    return measure_time(PERF_VEC_AGG_LONG128, count * 2 * (int64_t) sizeof(int64_t), [=]() {
+        return countLong128_Neon((int64_t *) pLong, count);
+    });
 }
 
 // SHORT
 
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_sumShort(JNIEnv *env, jclass cl, jlong pShort, jlong count) {
-    return sumShort_Vanilla((int16_t *) pShort, count);
+    return measure_time(PERF_VEC_AGG_SHORT, count * (int64_t) sizeof(int16_t), [=]() {
+        return sumShort_Neon((int16_t *) pShort, count);
+    });
 }
 
 JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_minShort(JNIEnv *env, jclass cl, jlong pShort, jlong count) {
-    return minShort_Vanilla((int16_t *) pShort, count);
+    return measure_time(PERF_VEC_AGG_SHORT, count * (int64_t) sizeof(int16_t), [=]() {
+        return minShort_Neon((int16_t *) pShort, count);
+    });
 }
 
 JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_maxShort(JNIEnv *env, jclass cl, jlong pShort, jlong count) {
-    return maxShort_Vanilla((int16_t *) pShort, count);
+    return measure_time(PERF_VEC_AGG_SHORT, count * (int64_t) sizeof(int16_t), [=]() {
+        return maxShort_Neon((int16_t *) pShort, count);
+    });
+}
+
+// BYTE
+
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_sumByte(JNIEnv *env, jclass cl, jlong pByte, jlong count) {
+    return measure_time(PERF_VEC_AGG_BYTE, count * (int64_t) sizeof(int8_t), [=]() {
+        return sumByte_Neon((int8_t *) pByte, count);
+    });
+}
+
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_minByte(JNIEnv *env, jclass cl, jlong pByte, jlong count) {
+    return measure_time(PERF_VEC_AGG_BYTE, count * (int64_t) sizeof(int8_t), [=]() {
+        return minByte_Neon((int8_t *) pByte, count);
+    });
+}
+
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_maxByte(JNIEnv *env, jclass cl, jlong pByte, jlong count) {
+    return measure_time(PERF_VEC_AGG_BYTE, count * (int64_t) sizeof(int8_t), [=]() {
+        return maxByte_Neon((int8_t *) pByte, count);
+    });
+}
+
+// CHAR
+
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_minChar(JNIEnv *env, jclass cl, jlong pChar, jlong count) {
+    return measure_time(PERF_VEC_AGG_CHAR, count * (int64_t) sizeof(uint16_t), [=]() {
+        return minChar_Neon((uint16_t *) pChar, count);
+    });
+}
+
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_maxChar(JNIEnv *env, jclass cl, jlong pChar, jlong count) {
+    return measure_time(PERF_VEC_AGG_CHAR, count * (int64_t) sizeof(uint16_t), [=]() {
+        return maxChar_Neon((uint16_t *) pChar, count);
+    });
+}
+
+// SAMPLE BY
+
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_sampleByBuckets(JNIEnv *env, jclass cl, jlong pTimestamps, jlong count, jlong start, jlong stride, jlong bucketTimestamp, jlong pBuckets, jlong maxBuckets) {
+    return measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() {
+        return sampleByBuckets_Neon((const int64_t *) pTimestamps, count, start, stride, bucketTimestamp, (int64_t *) pBuckets, maxBuckets);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_sampleByStatsDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong pBuckets, jlong bucketCount, jlong pStats) {
+    const auto *buckets = (const int64_t *) pBuckets;
+    const int64_t rows = bucketCount > 0 ? buckets[2 * bucketCount - 1] : 0;
+    measure_time(PERF_VEC_AGG_DOUBLE, rows * (int64_t) sizeof(double), [=]() {
+        sample_by_stats((const double *) pDouble, buckets, bucketCount, (bucket_stats_t<double> *) pStats, D_NAN, bucketStatsDouble_Neon);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_sampleByStatsInt(JNIEnv *env, jclass cl, jlong pInt, jlong pBuckets, jlong bucketCount, jlong pStats) {
+    const auto *buckets = (const int64_t *) pBuckets;
+    const int64_t rows = bucketCount > 0 ? buckets[2 * bucketCount - 1] : 0;
+    measure_time(PERF_VEC_AGG_INT, rows * (int64_t) sizeof(int32_t), [=]() {
+        sample_by_stats((const int32_t *) pInt, buckets, bucketCount, (bucket_stats_t<int64_t> *) pStats, (int64_t) I_MIN, bucketStatsInt_Neon);
+    });
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_sampleByStatsLong(JNIEnv *env, jclass cl, jlong pLong, jlong pBuckets, jlong bucketCount, jlong pStats) {
+    const auto *buckets = (const int64_t *) pBuckets;
+    const int64_t rows = bucketCount > 0 ? buckets[2 * bucketCount - 1] : 0;
+    measure_time(PERF_VEC_AGG_LONG, rows * (int64_t) sizeof(int64_t), [=]() {
+        sample_by_stats((const int64_t *) pLong, buckets, bucketCount, (bucket_stats_t<int64_t> *) pStats, (int64_t) L_MIN, bucketStatsLong_Neon);
+    });
 }
 
-JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_getSupportedInstructionSet(JNIEnv *env, jclass cl) {
-    return 0.0;
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_getSupportedInstructionSet(JNIEnv *env, jclass cl) {
+    return instrset_detect();
 }
 
 }
@@ -27,6 +27,7 @@
 #include "simd.h"
 #include "ooo_dispatch.h"
 #include "bit_vector.h"
+#include "perf_counters.h"
 #include <algorithm>
 #include <cassert>
 
@@ -357,6 +358,10 @@ Java_io_questdb_std_Vect_mergeDedupTimestampWithLongIndexAsc(
         jlong indexHiInclusive,
         jlong pDestIndex
 ) {
+    perf_counter_scope scope(
+            PERF_DEDUP_MERGE_TIMESTAMP,
+            (srcHiInclusive - srcLo + indexHiInclusive - indexLo + 2) * (int64_t) sizeof(index_t)
+    );
     const uint64_t *src = reinterpret_cast<uint64_t *> (pSrc);
     const index_t *index = reinterpret_cast<index_t *> (pIndex);
 
@@ -420,6 +425,10 @@ Java_io_questdb_std_Vect_mergeDedupTimestampWithLongIndexIntKeys(
         jint dedupKeyCount,
         jlong dedupColBuffs
 ) {
+    perf_counter_scope scope(
+            PERF_DEDUP_MERGE_TIMESTAMP_KEYS,
+            (mergeDataHi - mergeDataLo + mergeOOOHi - mergeOOOLo + 2) * (int64_t) sizeof(index_t)
+    );
     auto *src = reinterpret_cast<uint64_t *> (srcTimestampAddr);
     auto data_lo = __JLONG_REINTERPRET_CAST__(int64_t, mergeDataLo);
     auto data_hi = __JLONG_REINTERPRET_CAST__(int64_t, mergeDataHi);
@@ -544,6 +553,7 @@ Java_io_questdb_std_Vect_dedupSortedTimestampIndex(
         const jint dedupKeyCount,
         jlong dedupColBuffs
 ) {
+    perf_counter_scope scope(PERF_DEDUP_SORTED_TIMESTAMP_INDEX, count * (int64_t) sizeof(index_t));
     const auto *index_in = reinterpret_cast<const index_t *> (pIndexIn);
     const auto index_count = __JLONG_REINTERPRET_CAST__(int64_t, count);
     auto *index_out = reinterpret_cast<index_t *> (pIndexOut);
@@ -650,6 +660,7 @@ Java_io_questdb_std_Vect_dedupMergeVarColumnLen(JNIEnv *env, jclass cl,
                                                jlong merge_index_size,
                                                jlong src_data_fix_addr,
                                                jlong src_ooo_fix_addr) {
+    perf_counter_scope scope(PERF_DEDUP_MERGE_VAR_COLUMN_LEN, merge_index_size * (int64_t) sizeof(index_t));
     auto merge_index = reinterpret_cast<index_t *>(merge_index_addr);
     auto src_ooo_fix = reinterpret_cast<int64_t *>(src_ooo_fix_addr);
     auto src_data_fix = reinterpret_cast<int64_t *>(src_data_fix_addr);
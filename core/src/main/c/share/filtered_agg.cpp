@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include <jni.h>
+#include "filtered_agg_dispatch.h"
+
+extern "C" {
+
+DECLARE_DISPATCHER(count_double_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_countDoubleFiltered(JNIEnv *env, jclass cl, jlong pDouble, jlong pRows, jlong rowCount) {
+    int64_t count;
+    count_double_filtered(reinterpret_cast<double *>(pDouble), reinterpret_cast<int64_t *>(pRows), rowCount, &count);
+    return count;
+}
+
+DECLARE_DISPATCHER(sum_double_filtered);
+
+JNIEXPORT jdouble JNICALL
+Java_io_questdb_std_Vect_sumDoubleFiltered(JNIEnv *env, jclass cl, jlong pDouble, jlong pRows, jlong rowCount, jlong pCount) {
+    double sum;
+    sum_double_filtered(reinterpret_cast<double *>(pDouble), reinterpret_cast<int64_t *>(pRows), rowCount, &sum, reinterpret_cast<int64_t *>(pCount));
+    return sum;
+}
+
+DECLARE_DISPATCHER(min_double_filtered);
+
+JNIEXPORT jdouble JNICALL
+Java_io_questdb_std_Vect_minDoubleFiltered(JNIEnv *env, jclass cl, jlong pDouble, jlong pRows, jlong rowCount) {
+    double min;
+    min_double_filtered(reinterpret_cast<double *>(pDouble), reinterpret_cast<int64_t *>(pRows), rowCount, &min);
+    return min;
+}
+
+DECLARE_DISPATCHER(max_double_filtered);
+
+JNIEXPORT jdouble JNICALL
+Java_io_questdb_std_Vect_maxDoubleFiltered(JNIEnv *env, jclass cl, jlong pDouble, jlong pRows, jlong rowCount) {
+    double max;
+    max_double_filtered(reinterpret_cast<double *>(pDouble), reinterpret_cast<int64_t *>(pRows), rowCount, &max);
+    return max;
+}
+
+DECLARE_DISPATCHER(count_int_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_countIntFiltered(JNIEnv *env, jclass cl, jlong pInt, jlong pRows, jlong rowCount) {
+    int64_t count;
+    count_int_filtered(reinterpret_cast<int32_t *>(pInt), reinterpret_cast<int64_t *>(pRows), rowCount, &count);
+    return count;
+}
+
+DECLARE_DISPATCHER(sum_int_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_sumIntFiltered(JNIEnv *env, jclass cl, jlong pInt, jlong pRows, jlong rowCount, jlong pCount) {
+    int64_t sum;
+    sum_int_filtered(reinterpret_cast<int32_t *>(pInt), reinterpret_cast<int64_t *>(pRows), rowCount, &sum, reinterpret_cast<int64_t *>(pCount));
+    return sum;
+}
+
+DECLARE_DISPATCHER(min_int_filtered);
+
+JNIEXPORT jint JNICALL
+Java_io_questdb_std_Vect_minIntFiltered(JNIEnv *env, jclass cl, jlong pInt, jlong pRows, jlong rowCount) {
+    int32_t min;
+    min_int_filtered(reinterpret_cast<int32_t *>(pInt), reinterpret_cast<int64_t *>(pRows), rowCount, &min);
+    return min;
+}
+
+DECLARE_DISPATCHER(max_int_filtered);
+
+JNIEXPORT jint JNICALL
+Java_io_questdb_std_Vect_maxIntFiltered(JNIEnv *env, jclass cl, jlong pInt, jlong pRows, jlong rowCount) {
+    int32_t max;
+    max_int_filtered(reinterpret_cast<int32_t *>(pInt), reinterpret_cast<int64_t *>(pRows), rowCount, &max);
+    return max;
+}
+
+DECLARE_DISPATCHER(count_long_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_countLongFiltered(JNIEnv *env, jclass cl, jlong pLong, jlong pRows, jlong rowCount) {
+    int64_t count;
+    count_long_filtered(reinterpret_cast<int64_t *>(pLong), reinterpret_cast<int64_t *>(pRows), rowCount, &count);
+    return count;
+}
+
+DECLARE_DISPATCHER(sum_long_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_sumLongFiltered(JNIEnv *env, jclass cl, jlong pLong, jlong pRows, jlong rowCount, jlong pCount) {
+    int64_t sum;
+    sum_long_filtered(reinterpret_cast<int64_t *>(pLong), reinterpret_cast<int64_t *>(pRows), rowCount, &sum, reinterpret_cast<int64_t *>(pCount));
+    return sum;
+}
+
+DECLARE_DISPATCHER(min_long_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_minLongFiltered(JNIEnv *env, jclass cl, jlong pLong, jlong pRows, jlong rowCount) {
+    int64_t min;
+    min_long_filtered(reinterpret_cast<int64_t *>(pLong), reinterpret_cast<int64_t *>(pRows), rowCount, &min);
+    return min;
+}
+
+DECLARE_DISPATCHER(max_long_filtered);
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_maxLongFiltered(JNIEnv *env, jclass cl, jlong pLong, jlong pRows, jlong rowCount) {
+    int64_t max;
+    max_long_filtered(reinterpret_cast<int64_t *>(pLong), reinterpret_cast<int64_t *>(pRows), rowCount, &max);
+    return max;
+}
+
+}
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "filtered_agg_dispatch.h"
+
+// Hardware gathers take 64-bit row ids as they are, VCL lookup() would clamp them to int range.
+static inline Vec8d gather_rows(const double *data, const int64_t *rows) {
+#if INSTRSET >= 10
+    return _mm512_i64gather_pd(Vec8q().load(rows), data, 8);
+#elif INSTRSET >= 8
+    return Vec8d(
+            _mm256_i64gather_pd(data, Vec4q().load(rows), 8),
+            _mm256_i64gather_pd(data, Vec4q().load(rows + 4), 8)
+    );
+#else
+    return Vec8d(
+            data[rows[0]], data[rows[1]], data[rows[2]], data[rows[3]],
+            data[rows[4]], data[rows[5]], data[rows[6]], data[rows[7]]
+    );
+#endif
+}
+
+static inline Vec8q gather_rows(const int64_t *data, const int64_t *rows) {
+#if INSTRSET >= 10
+    return _mm512_i64gather_epi64(Vec8q().load(rows), data, 8);
+#elif INSTRSET >= 8
+    const auto *base = reinterpret_cast<const long long *>(data);
+    return Vec8q(
+            _mm256_i64gather_epi64(base, Vec4q().load(rows), 8),
+            _mm256_i64gather_epi64(base, Vec4q().load(rows + 4), 8)
+    );
+#else
+    return Vec8q(
+            data[rows[0]], data[rows[1]], data[rows[2]], data[rows[3]],
+            data[rows[4]], data[rows[5]], data[rows[6]], data[rows[7]]
+    );
+#endif
+}
+
+// ints are sign extended to 64-bit lanes, so that null stays the smallest value and sums do not overflow
+static inline Vec8q gather_rows(const int32_t *data, const int64_t *rows) {
+#if INSTRSET >= 10
+    return _mm512_cvtepi32_epi64(_mm512_i64gather_epi32(Vec8q().load(rows), data, 4));
+#elif INSTRSET >= 8
+    return Vec8q(
+            _mm256_cvtepi32_epi64(_mm256_i64gather_epi32(data, Vec4q().load(rows), 4)),
+            _mm256_cvtepi32_epi64(_mm256_i64gather_epi32(data, Vec4q().load(rows + 4), 4))
+    );
+#else
+    return Vec8q(
+            data[rows[0]], data[rows[1]], data[rows[2]], data[rows[3]],
+            data[rows[4]], data[rows[5]], data[rows[6]], data[rows[7]]
+    );
+#endif
+}
+
+// Lanes are reduced with scalar code, generic VCL horizontal_add(), horizontal_min(), horizontal_max() and
+// horizontal_or() are emitted out of line and may resolve to the instance compiled for another instruction set.
+static inline int64_t lane_sum(const Vec8q &v) {
+    int64_t sum = 0;
+    for (int j = 0; j < 8; j++) {
+        sum += v[j];
+    }
+    return sum;
+}
+
+static inline double lane_sum(const Vec8d &v) {
+    double sum = 0.;
+    for (int j = 0; j < 8; j++) {
+        sum += v[j];
+    }
+    return sum;
+}
+
+template<typename V, typename VB, typename T>
+static inline bool lane_min(const V &v, const VB &hasData, T *out_min) {
+    bool found = false;
+    T min = 0;
+    for (int j = 0; j < 8; j++) {
+        if (hasData[j] && (!found || v[j] < min)) {
+            min = static_cast<T>(v[j]);
+            found = true;
+        }
+    }
+    *out_min = min;
+    return found;
+}
+
+template<typename V, typename VB, typename T>
+static inline bool lane_max(const V &v, const VB &hasData, T *out_max) {
+    bool found = false;
+    T max = 0;
+    for (int j = 0; j < 8; j++) {
+        if (hasData[j] && (!found || v[j] > max)) {
+            max = static_cast<T>(v[j]);
+            found = true;
+        }
+    }
+    *out_max = max;
+    return found;
+}
+
+template<typename T>
+inline void count_filtered_q(const T *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    const int step = 8;
+    const Vec8q nullVec(null_value<T>());
+    Vec8q countVec = 0;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        countVec = if_add(gather_rows(data, rows + i) != nullVec, countVec, 1);
+    }
+    count_filtered_vanilla(data, rows + i, rows_count - i, out_count);
+    *out_count += lane_sum(countVec);
+}
+
+template<typename T>
+inline void sum_filtered_q(const T *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count) {
+    const int step = 8;
+    const Vec8q nullVec(null_value<T>());
+    Vec8q sumVec = 0;
+    Vec8q countVec = 0;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        const Vec8q v = gather_rows(data, rows + i);
+        const Vec8qb b = v != nullVec;
+        sumVec = if_add(b, sumVec, v);
+        countVec = if_add(b, countVec, 1);
+    }
+    sum_filtered_vanilla(data, rows + i, rows_count - i, out_sum, out_count);
+    *out_sum += lane_sum(sumVec);
+    *out_count += lane_sum(countVec);
+}
+
+template<typename T>
+inline void min_filtered_q(const T *data, const int64_t *rows, int64_t rows_count, T *out_min) {
+    const int step = 8;
+    const Vec8q nullVec(null_value<T>());
+    Vec8q minVec = std::numeric_limits<int64_t>::max();
+    Vec8qb hasData = false;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        const Vec8q v = gather_rows(data, rows + i);
+        const Vec8qb b = v != nullVec;
+        minVec = select(b, min(minVec, v), minVec);
+        hasData |= b;
+    }
+    min_filtered_vanilla(data, rows + i, rows_count - i, out_min);
+    T laneMin;
+    if (lane_min(minVec, hasData, &laneMin)) {
+        *out_min = merge_min(laneMin, *out_min);
+    }
+}
+
+template<typename T>
+inline void max_filtered_q(const T *data, const int64_t *rows, int64_t rows_count, T *out_max) {
+    const int step = 8;
+    // null is the smallest value, plain max skips it
+    Vec8q maxVec(null_value<T>());
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        maxVec = max(maxVec, gather_rows(data, rows + i));
+    }
+    max_filtered_vanilla(data, rows + i, rows_count - i, out_max);
+    for (int j = 0; j < step; j++) {
+        *out_max = merge_max(static_cast<T>(maxVec[j]), *out_max);
+    }
+}
+
+void MULTI_VERSION_NAME (count_double_filtered)(const double *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    const int step = 8;
+    Vec8q countVec = 0;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        countVec = if_add(!is_nan(gather_rows(data, rows + i)), countVec, 1);
+    }
+    count_filtered_vanilla(data, rows + i, rows_count - i, out_count);
+    *out_count += lane_sum(countVec);
+}
+
+void MULTI_VERSION_NAME (sum_double_filtered)(const double *data, const int64_t *rows, int64_t rows_count, double *out_sum, int64_t *out_count) {
+    const int step = 8;
+    Vec8d sumVec = 0.;
+    Vec8q countVec = 0;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        const Vec8d v = gather_rows(data, rows + i);
+        const Vec8db b = is_finite(v);
+        sumVec = if_add(b, sumVec, v);
+        countVec = if_add(b, countVec, 1);
+    }
+    sum_filtered_vanilla(data, rows + i, rows_count - i, out_sum, out_count);
+    *out_sum += lane_sum(sumVec);
+    *out_count += lane_sum(countVec);
+}
+
+void MULTI_VERSION_NAME (min_double_filtered)(const double *data, const int64_t *rows, int64_t rows_count, double *out_min) {
+    const int step = 8;
+    Vec8d minVec = D_MAX;
+    Vec8db hasData = false;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        const Vec8d v = gather_rows(data, rows + i);
+        const Vec8db b = !is_nan(v);
+        minVec = select(b, min(minVec, v), minVec);
+        hasData |= b;
+    }
+    min_filtered_vanilla(data, rows + i, rows_count - i, out_min);
+    double laneMin;
+    if (lane_min(minVec, hasData, &laneMin)) {
+        *out_min = merge_min(laneMin, *out_min);
+    }
+}
+
+void MULTI_VERSION_NAME (max_double_filtered)(const double *data, const int64_t *rows, int64_t rows_count, double *out_max) {
+    const int step = 8;
+    Vec8d maxVec = D_MIN;
+    Vec8db hasData = false;
+    int64_t i = 0;
+    for (; i < rows_count - step + 1; i += step) {
+        MM_PREFETCH_T0(rows + i + 64);
+        const Vec8d v = gather_rows(data, rows + i);
+        const Vec8db b = !is_nan(v);
+        maxVec = select(b, max(maxVec, v), maxVec);
+        hasData |= b;
+    }
+    max_filtered_vanilla(data, rows + i, rows_count - i, out_max);
+    double laneMax;
+    if (lane_max(maxVec, hasData, &laneMax)) {
+        *out_max = merge_max(laneMax, *out_max);
+    }
+}
+
+void MULTI_VERSION_NAME (count_int_filtered)(const int32_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    count_filtered_q(data, rows, rows_count, out_count);
+}
+
+void MULTI_VERSION_NAME (sum_int_filtered)(const int32_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count) {
+    sum_filtered_q(data, rows, rows_count, out_sum, out_count);
+}
+
+void MULTI_VERSION_NAME (min_int_filtered)(const int32_t *data, const int64_t *rows, int64_t rows_count, int32_t *out_min) {
+    min_filtered_q(data, rows, rows_count, out_min);
+}
+
+void MULTI_VERSION_NAME (max_int_filtered)(const int32_t *data, const int64_t *rows, int64_t rows_count, int32_t *out_max) {
+    max_filtered_q(data, rows, rows_count, out_max);
+}
+
+void MULTI_VERSION_NAME (count_long_filtered)(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    count_filtered_q(data, rows, rows_count, out_count);
+}
+
+void MULTI_VERSION_NAME (sum_long_filtered)(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count) {
+    sum_filtered_q(data, rows, rows_count, out_sum, out_count);
+}
+
+void MULTI_VERSION_NAME (min_long_filtered)(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_min) {
+    min_filtered_q(data, rows, rows_count, out_min);
+}
+
+void MULTI_VERSION_NAME (max_long_filtered)(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_max) {
+    max_filtered_q(data, rows, rows_count, out_max);
+}
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef QUESTDB_FILTERED_AGG_DISPATCH_H
+#define QUESTDB_FILTERED_AGG_DISPATCH_H
+
+#include <algorithm>
+#include "util.h"
+#include "dispatcher.h"
+
+// Aggregates over rows picked by a filter. Rows are frame-local indexes, as written by
+// compiled filters, values at those rows are gathered and aggregated with null handling
+// of the matching group-by functions: sum() skips non-finite doubles, count(), min() and max()
+// skip nulls.
+
+inline bool is_null_value(double v) { return std::isnan(v); }
+
+inline bool is_null_value(int32_t v) { return v == I_MIN; }
+
+inline bool is_null_value(int64_t v) { return v == L_MIN; }
+
+inline bool is_summable(double v) { return std::isfinite(v); }
+
+inline bool is_summable(int32_t v) { return v != I_MIN; }
+
+inline bool is_summable(int64_t v) { return v != L_MIN; }
+
+template<typename T>
+constexpr T null_value();
+
+template<>
+constexpr double null_value<double>() { return D_NAN; }
+
+template<>
+constexpr int32_t null_value<int32_t>() { return I_MIN; }
+
+template<>
+constexpr int64_t null_value<int64_t>() { return L_MIN; }
+
+template<typename T>
+inline T merge_min(T a, T b) {
+    if (is_null_value(a)) {
+        return b;
+    }
+    return is_null_value(b) || a < b ? a : b;
+}
+
+template<typename T>
+inline T merge_max(T a, T b) {
+    if (is_null_value(a)) {
+        return b;
+    }
+    return is_null_value(b) || a > b ? a : b;
+}
+
+template<typename T>
+inline void count_filtered_vanilla(const T *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    int64_t count = 0;
+    for (int64_t i = 0; i < rows_count; i++) {
+        count += !is_null_value(data[rows[i]]);
+    }
+    *out_count = count;
+}
+
+template<typename T, typename TSum>
+inline void sum_filtered_vanilla(const T *data, const int64_t *rows, int64_t rows_count, TSum *out_sum, int64_t *out_count) {
+    TSum sum = 0;
+    int64_t count = 0;
+    for (int64_t i = 0; i < rows_count; i++) {
+        const T v = data[rows[i]];
+        if (is_summable(v)) {
+            sum += v;
+            count++;
+        }
+    }
+    *out_sum = sum;
+    *out_count = count;
+}
+
+template<typename T>
+inline void min_filtered_vanilla(const T *data, const int64_t *rows, int64_t rows_count, T *out_min) {
+    T min = null_value<T>();
+    for (int64_t i = 0; i < rows_count; i++) {
+        min = merge_min(data[rows[i]], min);
+    }
+    *out_min = min;
+}
+
+template<typename T>
+inline void max_filtered_vanilla(const T *data, const int64_t *rows, int64_t rows_count, T *out_max) {
+    T max = null_value<T>();
+    for (int64_t i = 0; i < rows_count; i++) {
+        max = merge_max(data[rows[i]], max);
+    }
+    *out_max = max;
+}
+
+DECLARE_DISPATCHER_TYPE(count_double_filtered, const double *data, const int64_t *rows, int64_t rows_count, int64_t *out_count);
+
+DECLARE_DISPATCHER_TYPE(sum_double_filtered, const double *data, const int64_t *rows, int64_t rows_count, double *out_sum, int64_t *out_count);
+
+DECLARE_DISPATCHER_TYPE(min_double_filtered, const double *data, const int64_t *rows, int64_t rows_count, double *out_min);
+
+DECLARE_DISPATCHER_TYPE(max_double_filtered, const double *data, const int64_t *rows, int64_t rows_count, double *out_max);
+
+DECLARE_DISPATCHER_TYPE(count_int_filtered, const int32_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_count);
+
+DECLARE_DISPATCHER_TYPE(sum_int_filtered, const int32_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count);
+
+DECLARE_DISPATCHER_TYPE(min_int_filtered, const int32_t *data, const int64_t *rows, int64_t rows_count, int32_t *out_min);
+
+DECLARE_DISPATCHER_TYPE(max_int_filtered, const int32_t *data, const int64_t *rows, int64_t rows_count, int32_t *out_max);
+
+DECLARE_DISPATCHER_TYPE(count_long_filtered, const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_count);
+
+DECLARE_DISPATCHER_TYPE(sum_long_filtered, const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count);
+
+DECLARE_DISPATCHER_TYPE(min_long_filtered, const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_min);
+
+DECLARE_DISPATCHER_TYPE(max_long_filtered, const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_max);
+
+#endif //QUESTDB_FILTERED_AGG_DISPATCH_H
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#include "filtered_agg_dispatch.h"
+
+// Advanced SIMD has no gather, rows are loaded one at a time and scalar loops are as fast.
+
+void count_double_filtered(const double *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    count_filtered_vanilla(data, rows, rows_count, out_count);
+}
+
+void sum_double_filtered(const double *data, const int64_t *rows, int64_t rows_count, double *out_sum, int64_t *out_count) {
+    sum_filtered_vanilla(data, rows, rows_count, out_sum, out_count);
+}
+
+void min_double_filtered(const double *data, const int64_t *rows, int64_t rows_count, double *out_min) {
+    min_filtered_vanilla(data, rows, rows_count, out_min);
+}
+
+void max_double_filtered(const double *data, const int64_t *rows, int64_t rows_count, double *out_max) {
+    max_filtered_vanilla(data, rows, rows_count, out_max);
+}
+
+void count_int_filtered(const int32_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    count_filtered_vanilla(data, rows, rows_count, out_count);
+}
+
+void sum_int_filtered(const int32_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count) {
+    sum_filtered_vanilla(data, rows, rows_count, out_sum, out_count);
+}
+
+void min_int_filtered(const int32_t *data, const int64_t *rows, int64_t rows_count, int32_t *out_min) {
+    min_filtered_vanilla(data, rows, rows_count, out_min);
+}
+
+void max_int_filtered(const int32_t *data, const int64_t *rows, int64_t rows_count, int32_t *out_max) {
+    max_filtered_vanilla(data, rows, rows_count, out_max);
+}
+
+void count_long_filtered(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_count) {
+    count_filtered_vanilla(data, rows, rows_count, out_count);
+}
+
+void sum_long_filtered(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_sum, int64_t *out_count) {
+    sum_filtered_vanilla(data, rows, rows_count, out_sum, out_count);
+}
+
+void min_long_filtered(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_min) {
+    min_filtered_vanilla(data, rows, rows_count, out_min);
+}
+
+void max_long_filtered(const int64_t *data, const int64_t *rows, int64_t rows_count, int64_t *out_max) {
+    max_filtered_vanilla(data, rows, rows_count, out_max);
+}
@@ -1,9 +1,80 @@
 #include "util.h"
 #include "geohash_dispatch.h"
 
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+
+// Hashes of all widths are sign extended to 64 bits, (hash & mask) == prefix holds
+// for the extended values exactly when it holds for T, so one kernel serves every width.
+template<typename T>
+void filter_with_prefix_neon(
+        const T *hashes,
+        int64_t *rows,
+        int64_t rows_count,
+        const int64_t *prefixes,
+        int64_t prefixes_count,
+        int64_t *out_filtered_count
+) {
+    int64_t i = 0; // input index
+    int64_t o = 0; // output index
+    for (; i + 3 < rows_count; i += 4) {
+        MM_PREFETCH_T0(rows + i + 64);
+        const int64_t current_hashes[] = {
+                hashes[to_local_row_id(rows[i] - 1)],
+                hashes[to_local_row_id(rows[i + 1] - 1)],
+                hashes[to_local_row_id(rows[i + 2] - 1)],
+                hashes[to_local_row_id(rows[i + 3] - 1)]
+        };
+        const int64x2_t hashes0 = vld1q_s64(current_hashes);
+        const int64x2_t hashes1 = vld1q_s64(current_hashes + 2);
+        uint64x2_t hit0 = vdupq_n_u64(0);
+        uint64x2_t hit1 = vdupq_n_u64(0);
+        for (size_t j = 0, size = prefixes_count / 2; j < size; ++j) {
+            const int64x2_t target_hash = vdupq_n_s64(static_cast<T>(prefixes[2 * j]));
+            const int64x2_t target_mask = vdupq_n_s64(static_cast<T>(prefixes[2 * j + 1]));
+            hit0 = vorrq_u64(hit0, vceqq_s64(vandq_s64(hashes0, target_mask), target_hash));
+            hit1 = vorrq_u64(hit1, vceqq_s64(vandq_s64(hashes1, target_mask), target_hash));
+        }
+        const uint64_t hits[] = {
+                vgetq_lane_u64(hit0, 0),
+                vgetq_lane_u64(hit0, 1),
+                vgetq_lane_u64(hit1, 0),
+                vgetq_lane_u64(hit1, 1)
+        };
+        // o never overtakes i + j, rows still to be read are not overwritten
+        for (int j = 0; j < 4; ++j) {
+            if (hits[j]) {
+                rows[o++] = rows[i + j];
+            }
+        }
+    }
+
+    int64_t tail_count = 0;
+    filter_with_prefix_generic_vanilla<T>(hashes, rows + i, rows_count - i, prefixes, prefixes_count, &tail_count);
+    for (int64_t j = 0; j < tail_count; ++j) {
+        rows[o++] = rows[i + j];
+    }
+    *out_filtered_count = o;
+}
+
+#define FILTER_WITH_PREFIX filter_with_prefix_neon
+#else
+#define FILTER_WITH_PREFIX filter_with_prefix_generic_vanilla
+#endif
+
 void simd_iota(int64_t *array, int64_t array_size, int64_t start) {
-    int64_t next = start;
-    for (int64_t i = 0; i < array_size; ++i) {
+    int64_t i = 0;
+#ifdef __ARM_NEON
+    const int64_t first[] = {start, start + 1};
+    int64x2_t vec = vld1q_s64(first);
+    const int64x2_t two = vdupq_n_s64(2);
+    for (; i + 1 < array_size; i += 2) {
+        vst1q_s64(array + i, vec);
+        vec = vaddq_s64(vec, two);
+    }
+#endif
+    int64_t next = start + i;
+    for (; i < array_size; ++i) {
         array[i] = next++;
     }
 }
@@ -19,7 +90,7 @@ void filter_with_prefix(
 ) {
     switch (hashes_type_size) {
         case 1:
-            filter_with_prefix_generic_vanilla<int8_t>(
+            FILTER_WITH_PREFIX<int8_t>(
                     static_cast<const int8_t *>(hashes),
                     rows,
                     rows_count,
@@ -29,7 +100,7 @@ void filter_with_prefix(
             );
             break;
         case 2:
-            filter_with_prefix_generic_vanilla<int16_t>(
+            FILTER_WITH_PREFIX<int16_t>(
                     static_cast<const int16_t *>(hashes),
                     rows,
                     rows_count,
@@ -39,7 +110,7 @@ void filter_with_prefix(
             );
             break;
         case 4:
-            filter_with_prefix_generic_vanilla<int32_t>(
+            FILTER_WITH_PREFIX<int32_t>(
                     static_cast<const int32_t *>(hashes),
                     rows,
                     rows_count,
@@ -49,7 +120,7 @@ void filter_with_prefix(
             );
             break;
         case 8:
-            filter_with_prefix_generic_vanilla<int64_t>(
+            FILTER_WITH_PREFIX<int64_t>(
                     static_cast<const int64_t *>(hashes),
                     rows,
                     rows_count,
@@ -25,6 +25,7 @@
 #include "compiler.h"
 #include "x86.h"
 #include "avx2.h"
+#include "../perf_counters.h"
 
 using namespace asmjit;
 
@@ -277,6 +278,7 @@ Java_io_questdb_jit_FiltersCompiler_compileFunction(JNIEnv *e,
                                                     jint options,
                                                     jobject error) {
 #ifndef __aarch64__
+    perf_counter_scope scope(PERF_JIT_COMPILE, filterSize);
 
     auto size = static_cast<size_t>(filterSize) / sizeof(instruction_t);
     if (filterAddress <= 0 || size <= 0) {
@@ -351,6 +353,8 @@ JNIEXPORT jlong JNICALL Java_io_questdb_jit_FiltersCompiler_callFunction(JNIEnv
                                                                          jlong rowsSize,
                                                                          jlong rowsStartOffset) {
 #ifndef __aarch64__
+    // bytes are the row ids the filter is given space for
+    perf_counter_scope scope(PERF_JIT_CALL, rowsSize * (int64_t) sizeof(int64_t));
     auto fn = reinterpret_cast<CompiledFn>(fnAddress);
     return fn(reinterpret_cast<int64_t *>(colsAddress),
               colsSize,
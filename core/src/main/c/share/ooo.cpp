@@ -23,27 +23,17 @@
  ******************************************************************************/
 #include "jni.h"
 #include <cstring>
+#include <algorithm>
 #include "util.h"
 #include "simd.h"
 #include "ooo_dispatch.h"
+#include "perf_counters.h"
 
-#ifdef OOO_CPP_PROFILE_TIMING
-#include <atomic>
-#include <time.h>
+#if !defined(__aarch64__)
+#include <chrono>
 #endif
 
 
-typedef struct {
-    uint64_t c8[256];
-    uint64_t c7[256];
-    uint64_t c6[256];
-    uint64_t c5[256];
-    uint64_t c4[256];
-    uint64_t c3[256];
-    uint64_t c2[256];
-    uint64_t c1[256];
-} rscounts_t;
-
 struct long_3x {
     uint64_t l1;
     uint64_t l2;
@@ -65,24 +55,55 @@ struct long_3x {
 
 #if RADIX_SHUFFLE == 0
 
-template<uint16_t sh, typename T>
-inline void radix_shuffle(uint64_t *counts, const T *src, T *dest, const uint64_t size) {
+inline uint64_t radix_key(const uint64_t value) {
+    return value;
+}
+
+inline uint64_t radix_key(const index_t &value) {
+    return value.ts;
+}
+
+// key of the values sorted by the radix sort
+struct radix_value_key {
+    template<typename T>
+    inline uint64_t operator()(const T &value) const {
+        return radix_key(value);
+    }
+};
+
+// 64-bit word of a wide key, word 0 is the most significant. The sign bit of 128-bit values is flipped,
+// so that their words compare as unsigned.
+struct radix_word_key {
+    uint32_t word;
+
+    inline uint64_t operator()(const __int128 &value) const {
+        return word == 0 ? (uint64_t) (value >> 64) ^ (1ull << 63) : (uint64_t) value;
+    }
+
+    inline uint64_t operator()(const long_3x &value) const {
+        return word == 0 ? value.l1 : word == 1 ? value.l2 : value.l3;
+    }
+};
+
+// stable scatter of the values by the digit of the key, keys are rebased to the minimum key of the sorted data
+template<typename T, typename K = radix_value_key>
+inline void radix_shuffle(uint64_t *counts, const T *src, T *dest, const uint64_t size, const uint64_t min,
+                          const uint32_t sh, const uint64_t mask, const K key = K()) {
     MM_PREFETCH_T0(counts);
     for (uint64_t x = 0; x < size; x++) {
-        const auto digit = (src[x] >> sh) & 0xffu;
+        const auto digit = ((key(src[x]) - min) >> sh) & mask;
         dest[counts[digit]] = src[x];
         counts[digit]++;
         MM_PREFETCH_T2(src + x + 64);
     }
 }
 
-
-template<uint16_t sh>
 inline void radix_shuffle_ab(uint64_t *counts, const uint64_t *srcA, const uint64_t sizeA, const index_t *srcB,
-                             const uint64_t sizeB, index_t *dest) {
+                             const uint64_t sizeB, index_t *dest, const uint64_t min, const uint32_t sh,
+                             const uint64_t mask) {
     MM_PREFETCH_T0(counts);
     for (uint64_t x = 0; x < sizeA; x++) {
-        const auto digit = (srcA[x] >> sh) & 0xffu;
+        const auto digit = ((srcA[x] - min) >> sh) & mask;
         dest[counts[digit]].ts = srcA[x];
         dest[counts[digit]].i = x | (1ull << 63);
         counts[digit]++;
@@ -90,7 +111,7 @@ inline void radix_shuffle_ab(uint64_t *counts, const uint64_t *srcA, const uint6
     }
 
     for (uint64_t x = 0; x < sizeB; x++) {
-        const auto digit = (srcB[x] >> sh) & 0xffu;
+        const auto digit = ((srcB[x].ts - min) >> sh) & mask;
         dest[counts[digit]] = srcB[x];
         counts[digit]++;
         MM_PREFETCH_T2(srcB + x + 64);
@@ -171,167 +192,396 @@ inline void radix_shuffle(uint64_t* counts, int64_t* src, int64_t* dest, uint64_
 }
 #endif
 
-template<typename T>
-void radix_sort_long_index_asc_in_place(T *array, uint64_t size, T *cpy) {
-    rscounts_t counts;
-    memset(&counts, 0, 256 * 8 * sizeof(uint64_t));
-    uint64_t o8 = 0, o7 = 0, o6 = 0, o5 = 0, o4 = 0, o3 = 0, o2 = 0, o1 = 0;
-    uint64_t t8, t7, t6, t5, t4, t3, t2, t1;
-    uint64_t x;
-
-    // calculate counts
-    MM_PREFETCH_NTA(counts.c8);
-    for (x = 0; x < size; x++) {
-        t8 = array[x] & 0xffu;
-        t7 = (array[x] >> 8u) & 0xffu;
-        t6 = (array[x] >> 16u) & 0xffu;
-        t5 = (array[x] >> 24u) & 0xffu;
-        t4 = (array[x] >> 32u) & 0xffu;
-        t3 = (array[x] >> 40u) & 0xffu;
-        t2 = (array[x] >> 48u) & 0xffu;
-        t1 = (array[x] >> 56u) & 0xffu;
-        counts.c8[t8]++;
-        counts.c7[t7]++;
-        counts.c6[t6]++;
-        counts.c5[t5]++;
-        counts.c4[t4]++;
-        counts.c3[t3]++;
-        counts.c2[t2]++;
-        counts.c1[t1]++;
+constexpr uint32_t RADIX_MAX_DIGITS = 8;
+// histograms of 8-bit digits of a full 64-bit key fit on stack
+constexpr uint32_t RADIX_STACK_COUNTS = RADIX_MAX_DIGITS * 256;
+
+// Sort plan of the key range: keys are rebased to the minimum key, so that only digits of the key range are sorted.
+// Digits with a single non-empty bucket do not change the order and are not shuffled.
+typedef struct {
+    uint64_t min;
+    uint64_t mask;
+    uint32_t digit_bits;
+    uint32_t digit_count;
+    uint32_t pass_count;
+    uint32_t pass_digits[RADIX_MAX_DIGITS];
+    uint64_t *counts;
+} radix_plan_t;
+
+template<typename T, typename K = radix_value_key>
+inline void radix_key_range(const T *array, const uint64_t size, uint64_t &min, uint64_t &max, const K key_of = K()) {
+    for (uint64_t x = 0; x < size; x++) {
+        const uint64_t key = key_of(array[x]);
+        min = key < min ? key : min;
+        max = key > max ? key : max;
+    }
+}
+
+// Wider digits need fewer passes over the data, but their histograms have to stay small compared to the data,
+// so 11-bit and 16-bit digits are used only when they save passes on large inputs.
+inline uint32_t radix_digit_bits(const uint32_t key_bits, const uint64_t size) {
+    const uint32_t passes8 = (key_bits + 7) / 8;
+    const uint32_t passes11 = (key_bits + 10) / 11;
+    const uint32_t passes16 = (key_bits + 15) / 16;
+    if (key_bits <= 32 && passes16 < passes11 && size >= (1ull << 20)) {
+        return 16;
+    }
+    if (passes11 < passes8 && size >= (1ull << 15)) {
+        return 11;
+    }
+    return 8;
+}
+
+inline void radix_plan_digits(radix_plan_t &plan, const uint32_t key_bits, const uint32_t digit_bits) {
+    plan.digit_bits = digit_bits;
+    plan.digit_count = (key_bits + digit_bits - 1) / digit_bits;
+    plan.mask = (1ull << digit_bits) - 1;
+}
+
+inline void radix_plan_of(radix_plan_t &plan, const uint64_t min, const uint64_t max, const uint64_t size,
+                          uint64_t *stack_counts) {
+    const uint64_t range = max - min;
+    const uint32_t key_bits = range == 0 ? 0 : 64 - __builtin_clzll(range);
+    plan.min = min;
+    plan.pass_count = 0;
+    radix_plan_digits(plan, key_bits, radix_digit_bits(key_bits, size));
+    uint64_t counts_size = (uint64_t) plan.digit_count << plan.digit_bits;
+    if (counts_size <= RADIX_STACK_COUNTS) {
+        plan.counts = stack_counts;
+    } else {
+        plan.counts = (uint64_t *) malloc(counts_size * sizeof(uint64_t));
+        if (plan.counts == nullptr) {
+            // histograms of 8-bit digits always fit on stack, the sort takes more passes
+            radix_plan_digits(plan, key_bits, 8);
+            counts_size = (uint64_t) plan.digit_count << plan.digit_bits;
+            plan.counts = stack_counts;
+        }
+    }
+    memset(plan.counts, 0, counts_size * sizeof(uint64_t));
+}
+
+inline void radix_plan_free(radix_plan_t &plan, uint64_t *stack_counts) {
+    if (plan.counts != stack_counts) {
+        free(plan.counts);
+    }
+}
+
+template<typename T, typename K = radix_value_key>
+inline void radix_count(radix_plan_t &plan, const T *array, const uint64_t size, const K key_of = K()) {
+    MM_PREFETCH_NTA(plan.counts);
+    for (uint64_t x = 0; x < size; x++) {
+        const uint64_t key = key_of(array[x]) - plan.min;
+        for (uint32_t d = 0; d < plan.digit_count; d++) {
+            plan.counts[((uint64_t) d << plan.digit_bits) + ((key >> (d * plan.digit_bits)) & plan.mask)]++;
+        }
         MM_PREFETCH_T2(array + x + 64);
     }
+}
+
+// converts counts to offsets and picks the digits to shuffle
+inline void radix_offsets(radix_plan_t &plan, const uint64_t first_key, const uint64_t size) {
+    const uint64_t bucket_count = 1ull << plan.digit_bits;
+    const uint64_t key = first_key - plan.min;
+    for (uint32_t d = 0; d < plan.digit_count; d++) {
+        uint64_t *counts = plan.counts + ((uint64_t) d << plan.digit_bits);
+        if (counts[(key >> (d * plan.digit_bits)) & plan.mask] == size) {
+            // all keys share the digit
+            continue;
+        }
+        plan.pass_digits[plan.pass_count++] = d;
+        uint64_t o = 0;
+        for (uint64_t x = 0; x < bucket_count; x++) {
+            const uint64_t t = o + counts[x];
+            counts[x] = o;
+            o = t;
+        }
+    }
+}
+
+// sorts the array using cpy as the other buffer of the passes, returns the buffer with the sorted data
+template<typename T>
+T *radix_sort_long_index_asc(T *array, uint64_t size, T *cpy) {
+    if (size < 2) {
+        return array;
+    }
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    radix_key_range(array, size, min, max);
+
+    uint64_t stack_counts[RADIX_STACK_COUNTS];
+    radix_plan_t plan;
+    radix_plan_of(plan, min, max, size, stack_counts);
+    radix_count(plan, array, size);
+    radix_offsets(plan, radix_key(array[0]), size);
+
+    T *src = array;
+    T *dest = cpy;
+    for (uint32_t p = 0; p < plan.pass_count; p++) {
+        const uint32_t d = plan.pass_digits[p];
+        radix_shuffle(plan.counts + ((uint64_t) d << plan.digit_bits), src, dest, size, plan.min, d * plan.digit_bits, plan.mask);
+        T *t = src;
+        src = dest;
+        dest = t;
+    }
+    radix_plan_free(plan, stack_counts);
+    return src;
+}
 
-    // convert counts to offsets
-    MM_PREFETCH_T0(&counts);
-    for (x = 0; x < 256; x++) {
-        t8 = o8 + counts.c8[x];
-        t7 = o7 + counts.c7[x];
-        t6 = o6 + counts.c6[x];
-        t5 = o5 + counts.c5[x];
-        t4 = o4 + counts.c4[x];
-        t3 = o3 + counts.c3[x];
-        t2 = o2 + counts.c2[x];
-        t1 = o1 + counts.c1[x];
-        counts.c8[x] = o8;
-        counts.c7[x] = o7;
-        counts.c6[x] = o6;
-        counts.c5[x] = o5;
-        counts.c4[x] = o4;
-        counts.c3[x] = o3;
-        counts.c2[x] = o2;
-        counts.c1[x] = o1;
-        o8 = t8;
-        o7 = t7;
-        o6 = t6;
-        o5 = t5;
-        o4 = t4;
-        o3 = t3;
-        o2 = t2;
-        o1 = t1;
+template<typename T>
+void radix_sort_long_index_asc_in_place(T *array, uint64_t size, T *cpy) {
+    const T *sorted = radix_sort_long_index_asc(array, size, cpy);
+    if (sorted != array) {
+        memcpy(array, sorted, size * sizeof(T));
     }
+}
 
-    // radix
-    radix_shuffle<0u>(counts.c8, array, cpy, size);
-    radix_shuffle<8u>(counts.c7, cpy, array, size);
-    radix_shuffle<16u>(counts.c6, array, cpy, size);
-    radix_shuffle<24u>(counts.c5, cpy, array, size);
-    radix_shuffle<32u>(counts.c4, array, cpy, size);
-    radix_shuffle<40u>(counts.c3, cpy, array, size);
-    radix_shuffle<48u>(counts.c2, array, cpy, size);
-    radix_shuffle<56u>(counts.c1, cpy, array, size);
+inline bool radix_overlaps(const void *p, const uint64_t p_size, const void *q, const uint64_t q_size) {
+    const auto p_lo = (uintptr_t) p;
+    const auto q_lo = (uintptr_t) q;
+    return p_lo < q_lo + q_size && q_lo < p_lo + p_size;
 }
 
 void
 radix_sort_ab_long_index_asc(const uint64_t *arrayA, const uint64_t sizeA, const index_t *arrayB, const uint64_t sizeB,
                              index_t *out, index_t *cpy) {
-    rscounts_t counts;
-    memset(&counts, 0, 256 * 8 * sizeof(uint64_t));
-    uint64_t o8 = 0, o7 = 0, o6 = 0, o5 = 0, o4 = 0, o3 = 0, o2 = 0, o1 = 0;
-    uint64_t t8, t7, t6, t5, t4, t3, t2, t1;
-    uint64_t x;
-
-    // calculate counts
-    MM_PREFETCH_NTA(counts.c8);
-    for (x = 0; x < sizeA; x++) {
-        t8 = arrayA[x] & 0xffu;
-        t7 = (arrayA[x] >> 8u) & 0xffu;
-        t6 = (arrayA[x] >> 16u) & 0xffu;
-        t5 = (arrayA[x] >> 24u) & 0xffu;
-        t4 = (arrayA[x] >> 32u) & 0xffu;
-        t3 = (arrayA[x] >> 40u) & 0xffu;
-        t2 = (arrayA[x] >> 48u) & 0xffu;
-        t1 = (arrayA[x] >> 56u) & 0xffu;
-        counts.c8[t8]++;
-        counts.c7[t7]++;
-        counts.c6[t6]++;
-        counts.c5[t5]++;
-        counts.c4[t4]++;
-        counts.c3[t3]++;
-        counts.c2[t2]++;
-        counts.c1[t1]++;
-        MM_PREFETCH_T2(arrayA + x + 64);
+    const uint64_t size = sizeA + sizeB;
+    if (size == 0) {
+        return;
     }
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    radix_key_range(arrayA, sizeA, min, max);
+    radix_key_range(arrayB, sizeB, min, max);
+
+    uint64_t stack_counts[RADIX_STACK_COUNTS];
+    radix_plan_t plan;
+    radix_plan_of(plan, min, max, size, stack_counts);
+    radix_count(plan, arrayA, sizeA);
+    radix_count(plan, arrayB, sizeB);
+    radix_offsets(plan, sizeA > 0 ? arrayA[0] : arrayB[0].ts, size);
+
+    // The output may be one of the inputs, then the first pass goes to the copy buffer and the result is copied
+    // back when an odd number of passes leaves it there. Otherwise the first destination is picked so that the last
+    // pass writes to the output.
+    const bool out_is_input = radix_overlaps(out, size * sizeof(index_t), arrayA, sizeA * sizeof(uint64_t))
+                              || radix_overlaps(out, size * sizeof(index_t), arrayB, sizeB * sizeof(index_t));
+    index_t *src = !out_is_input && (plan.pass_count == 0 || plan.pass_count % 2 == 1) ? out : cpy;
+    index_t *dest = src == out ? cpy : out;
+    if (plan.pass_count == 0) {
+        // all keys are equal, a single zero offset places A rows before B rows
+        uint64_t offset = 0;
+        radix_shuffle_ab(&offset, arrayA, sizeA, arrayB, sizeB, src, plan.min, 0, 0);
+    } else {
+        uint32_t d = plan.pass_digits[0];
+        radix_shuffle_ab(plan.counts + ((uint64_t) d << plan.digit_bits), arrayA, sizeA, arrayB, sizeB, src, plan.min,
+                         d * plan.digit_bits, plan.mask);
+        for (uint32_t p = 1; p < plan.pass_count; p++) {
+            d = plan.pass_digits[p];
+            radix_shuffle(plan.counts + ((uint64_t) d << plan.digit_bits), src, dest, size, plan.min, d * plan.digit_bits, plan.mask);
+            index_t *t = src;
+            src = dest;
+            dest = t;
+        }
+    }
+    if (src != out) {
+        memcpy(out, src, size * sizeof(index_t));
+    }
+    radix_plan_free(plan, stack_counts);
+}
+
+// Parallel radix sort of the timestamp index, its phases run on threads of the caller. Chunks of the input are
+// scattered into buckets by splitters picked at the quantiles of a sample of the keys, then buckets are sorted
+// independently by the LSD sort. Splitters keep buckets of equal size when a few outliers stretch the key range.
+// Equal keys keep their input order, A rows before B rows, so the result is the same as of
+// radix_sort_ab_long_index_asc().
+constexpr uint32_t RADIX_MSD_BITS = 8;
+constexpr uint64_t RADIX_MSD_BUCKETS = 1ull << RADIX_MSD_BITS;
+// number of keys sampled across all chunks to pick the splitters
+constexpr uint64_t RADIX_MSD_SAMPLES = RADIX_MSD_BUCKETS * 64;
 
-    for (x = 0; x < sizeB; x++) {
-        t8 = arrayB[x] & 0xffu;
-        t7 = (arrayB[x] >> 8u) & 0xffu;
-        t6 = (arrayB[x] >> 16u) & 0xffu;
-        t5 = (arrayB[x] >> 24u) & 0xffu;
-        t4 = (arrayB[x] >> 32u) & 0xffu;
-        t3 = (arrayB[x] >> 40u) & 0xffu;
-        t2 = (arrayB[x] >> 48u) & 0xffu;
-        t1 = (arrayB[x] >> 56u) & 0xffu;
-        counts.c8[t8]++;
-        counts.c7[t7]++;
-        counts.c6[t6]++;
-        counts.c5[t5]++;
-        counts.c4[t4]++;
-        counts.c3[t3]++;
-        counts.c2[t2]++;
-        counts.c1[t1]++;
-        MM_PREFETCH_T2(arrayB + x + 64);
+typedef struct {
+    const uint64_t *array_a;
+    uint64_t size_a;
+    const index_t *array_b;
+    uint64_t size_b;
+    index_t *out;
+    index_t *cpy;
+    uint64_t chunk_size;
+    uint32_t chunk_count;
+    // number of sample slots of each chunk
+    uint64_t chunk_samples;
+    // sampled keys of each chunk, sorted by the plan
+    uint64_t *samples;
+    // bucket counts of each chunk, converted to the chunk offsets in the buckets
+    uint64_t *chunk_counts;
+    // bucket b holds keys k of splitters[b - 1] <= k < splitters[b]
+    uint64_t splitters[RADIX_MSD_BUCKETS - 1];
+    uint64_t bucket_offsets[RADIX_MSD_BUCKETS + 1];
+} radix_sort_parallel_t;
+
+// number of splitters not greater than the key, branchless binary search
+inline uint64_t radix_msd_digit(const radix_sort_parallel_t *state, const uint64_t key) {
+    uint64_t b = 0;
+    for (uint64_t step = RADIX_MSD_BUCKETS / 2; step > 0; step >>= 1) {
+        b += key >= state->splitters[b + step - 1] ? step : 0;
     }
+    return b;
+}
 
-    // convert counts to offsets
-    MM_PREFETCH_T0(&counts);
-    for (x = 0; x < 256; x++) {
-        t8 = o8 + counts.c8[x];
-        t7 = o7 + counts.c7[x];
-        t6 = o6 + counts.c6[x];
-        t5 = o5 + counts.c5[x];
-        t4 = o4 + counts.c4[x];
-        t3 = o3 + counts.c3[x];
-        t2 = o2 + counts.c2[x];
-        t1 = o1 + counts.c1[x];
-        counts.c8[x] = o8;
-        counts.c7[x] = o7;
-        counts.c6[x] = o6;
-        counts.c5[x] = o5;
-        counts.c4[x] = o4;
-        counts.c3[x] = o3;
-        counts.c2[x] = o2;
-        counts.c1[x] = o1;
-        o8 = t8;
-        o7 = t7;
-        o6 = t6;
-        o5 = t5;
-        o4 = t4;
-        o3 = t3;
-        o2 = t2;
-        o1 = t1;
+void radix_sort_parallel_free(radix_sort_parallel_t *state) {
+    free(state->samples);
+    free(state->chunk_counts);
+    free(state);
+}
+
+radix_sort_parallel_t *radix_sort_parallel_create(
+        const uint64_t *arrayA,
+        const uint64_t sizeA,
+        const index_t *arrayB,
+        const uint64_t sizeB,
+        index_t *out,
+        index_t *cpy,
+        uint32_t chunk_count
+) {
+    auto *state = (radix_sort_parallel_t *) malloc(sizeof(radix_sort_parallel_t));
+    if (state == nullptr) {
+        return nullptr;
+    }
+    const uint64_t size = sizeA + sizeB;
+    chunk_count = chunk_count < 1 ? 1 : chunk_count;
+    state->array_a = arrayA;
+    state->size_a = sizeA;
+    state->array_b = arrayB;
+    state->size_b = sizeB;
+    state->out = out;
+    state->cpy = cpy;
+    state->chunk_size = (size + chunk_count - 1) / chunk_count;
+    state->chunk_size = state->chunk_size < 1 ? 1 : state->chunk_size;
+    state->chunk_count = (uint32_t) ((size + state->chunk_size - 1) / state->chunk_size);
+    state->chunk_samples = state->chunk_count > 0 ? (RADIX_MSD_SAMPLES + state->chunk_count - 1) / state->chunk_count : 0;
+    state->chunk_samples = state->chunk_samples < state->chunk_size ? state->chunk_samples : state->chunk_size;
+    state->samples = (uint64_t *) malloc(state->chunk_samples * sizeof(uint64_t) * state->chunk_count);
+    state->chunk_counts = (uint64_t *) malloc(RADIX_MSD_BUCKETS * sizeof(uint64_t) * state->chunk_count);
+    if (state->samples == nullptr || state->chunk_counts == nullptr) {
+        radix_sort_parallel_free(state);
+        return nullptr;
+    }
+    return state;
+}
+
+inline uint64_t radix_sort_parallel_chunk_hi(const radix_sort_parallel_t *state, const uint32_t chunk) {
+    const uint64_t lo = chunk * state->chunk_size;
+    const uint64_t size = state->size_a + state->size_b;
+    return lo + state->chunk_size < size ? lo + state->chunk_size : size;
+}
+
+// calls func(key, row) for A rows and func(index_t, row) for B rows of the chunk
+template<typename FA, typename FB>
+inline void radix_sort_parallel_chunk(const radix_sort_parallel_t *state, const uint32_t chunk, FA func_a, FB func_b) {
+    const uint64_t lo = chunk * state->chunk_size;
+    const uint64_t hi = radix_sort_parallel_chunk_hi(state, chunk);
+    const uint64_t hi_a = hi < state->size_a ? hi : state->size_a;
+    for (uint64_t x = lo; x < hi_a; x++) {
+        func_a(state->array_a[x], x);
+    }
+    for (uint64_t x = (lo > state->size_a ? lo : state->size_a); x < hi; x++) {
+        func_b(state->array_b[x - state->size_a]);
+    }
+}
+
+// number of keys sampled from the chunk, the last chunk can be shorter than the others
+inline uint64_t radix_sort_parallel_sample_count(const radix_sort_parallel_t *state, const uint32_t chunk) {
+    const uint64_t size = radix_sort_parallel_chunk_hi(state, chunk) - chunk * state->chunk_size;
+    return size < state->chunk_samples ? size : state->chunk_samples;
+}
+
+// samples keys evenly spaced in the chunk
+void radix_sort_parallel_sample(radix_sort_parallel_t *state, const uint32_t chunk) {
+    const uint64_t lo = chunk * state->chunk_size;
+    const uint64_t size = radix_sort_parallel_chunk_hi(state, chunk) - lo;
+    const uint64_t n = radix_sort_parallel_sample_count(state, chunk);
+    uint64_t *samples = state->samples + chunk * state->chunk_samples;
+    for (uint64_t j = 0; j < n; j++) {
+        const uint64_t x = lo + j * size / n;
+        samples[j] = x < state->size_a ? state->array_a[x] : state->array_b[x - state->size_a].ts;
+    }
+}
+
+// picks the splitters at the quantiles of the sampled keys
+void radix_sort_parallel_plan(radix_sort_parallel_t *state) {
+    uint64_t n = 0;
+    for (uint32_t c = 0; c < state->chunk_count; c++) {
+        const uint64_t count = radix_sort_parallel_sample_count(state, c);
+        memmove(state->samples + n, state->samples + c * state->chunk_samples, count * sizeof(uint64_t));
+        n += count;
     }
+    std::sort(state->samples, state->samples + n);
+    for (uint64_t b = 0; b < RADIX_MSD_BUCKETS - 1; b++) {
+        state->splitters[b] = n > 0 ? state->samples[(b + 1) * n / RADIX_MSD_BUCKETS] : UINT64_MAX;
+    }
+}
+
+void radix_sort_parallel_count(radix_sort_parallel_t *state, const uint32_t chunk) {
+    uint64_t *counts = state->chunk_counts + chunk * RADIX_MSD_BUCKETS;
+    memset(counts, 0, RADIX_MSD_BUCKETS * sizeof(uint64_t));
+    radix_sort_parallel_chunk(
+            state,
+            chunk,
+            [&](const uint64_t key, const uint64_t) {
+                counts[radix_msd_digit(state, key)]++;
+            },
+            [&](const index_t &value) {
+                counts[radix_msd_digit(state, value.ts)]++;
+            }
+    );
+}
 
-    // radix
-    radix_shuffle_ab<0u>(counts.c8, arrayA, sizeA, arrayB, sizeB, cpy);
+// converts chunk counts to offsets, chunks of a bucket follow the input order
+void radix_sort_parallel_offsets(radix_sort_parallel_t *state) {
+    uint64_t o = 0;
+    for (uint64_t b = 0; b < RADIX_MSD_BUCKETS; b++) {
+        state->bucket_offsets[b] = o;
+        for (uint32_t c = 0; c < state->chunk_count; c++) {
+            uint64_t *count = state->chunk_counts + c * RADIX_MSD_BUCKETS + b;
+            const uint64_t t = o + *count;
+            *count = o;
+            o = t;
+        }
+    }
+    state->bucket_offsets[RADIX_MSD_BUCKETS] = o;
+}
 
-    auto size = sizeA + sizeB;
-    radix_shuffle<8u>(counts.c7, cpy, out, size);
-    radix_shuffle<16u>(counts.c6, out, cpy, size);
-    radix_shuffle<24u>(counts.c5, cpy, out, size);
-    radix_shuffle<32u>(counts.c4, out, cpy, size);
-    radix_shuffle<40u>(counts.c3, cpy, out, size);
-    radix_shuffle<48u>(counts.c2, out, cpy, size);
-    radix_shuffle<56u>(counts.c1, cpy, out, size);
+void radix_sort_parallel_scatter(radix_sort_parallel_t *state, const uint32_t chunk) {
+    uint64_t *offsets = state->chunk_counts + chunk * RADIX_MSD_BUCKETS;
+    index_t *dest = state->cpy;
+    MM_PREFETCH_T0(offsets);
+    radix_sort_parallel_chunk(
+            state,
+            chunk,
+            [&](const uint64_t key, const uint64_t row) {
+                const auto digit = radix_msd_digit(state, key);
+                dest[offsets[digit]].ts = key;
+                dest[offsets[digit]].i = row | (1ull << 63);
+                offsets[digit]++;
+            },
+            [&](const index_t &value) {
+                const auto digit = radix_msd_digit(state, value.ts);
+                dest[offsets[digit]] = value;
+                offsets[digit]++;
+            }
+    );
+}
+
+// sorts the bucket scattered to the copy buffer into the output
+void radix_sort_parallel_bucket(radix_sort_parallel_t *state, const uint32_t bucket) {
+    const uint64_t lo = state->bucket_offsets[bucket];
+    const uint64_t size = state->bucket_offsets[bucket + 1] - lo;
+    if (size > 0) {
+        const index_t *sorted = radix_sort_long_index_asc(state->cpy + lo, size, state->out + lo);
+        if (sorted != state->out + lo) {
+            memcpy(state->out + lo, sorted, size * sizeof(index_t));
+        }
+    }
 }
 
 template<typename T>
@@ -341,6 +591,81 @@ inline void radix_sort_long_index_asc_in_place(T *array, uint64_t size) {
     free(cpy);
 }
 
+// runs of wide keys this short are insertion sorted
+constexpr uint64_t RADIX_WIDE_MIN_SIZE = 32;
+
+// Sorts values of wide keys, __int128 or long_3x, that are equal in the words before the given one. The values are
+// radix sorted by the word with the adaptive plan of radix_sort_long_index_asc(), then runs of equal words are
+// sorted by the next word. Random keys are done after the most significant word, equal words are skipped by
+// the plan.
+template<typename T>
+void radix_sort_wide_asc_in_place(T *array, const uint64_t size, const uint32_t word, T *cpy) {
+    if (size < RADIX_WIDE_MIN_SIZE) {
+        for (uint64_t i = 1; i < size; i++) {
+            const T value = array[i];
+            uint64_t j = i;
+            for (; j > 0 && !(array[j - 1] <= value); j--) {
+                array[j] = array[j - 1];
+            }
+            array[j] = value;
+        }
+        return;
+    }
+
+    const radix_word_key key{word};
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    radix_key_range(array, size, min, max, key);
+
+    uint64_t stack_counts[RADIX_STACK_COUNTS];
+    radix_plan_t plan;
+    radix_plan_of(plan, min, max, size, stack_counts);
+    radix_count(plan, array, size, key);
+    radix_offsets(plan, key(array[0]), size);
+    T *src = array;
+    T *dest = cpy;
+    for (uint32_t p = 0; p < plan.pass_count; p++) {
+        const uint32_t d = plan.pass_digits[p];
+        radix_shuffle(plan.counts + ((uint64_t) d << plan.digit_bits), src, dest, size, plan.min,
+                      d * plan.digit_bits, plan.mask, key);
+        T *t = src;
+        src = dest;
+        dest = t;
+    }
+    radix_plan_free(plan, stack_counts);
+    if (src != array) {
+        memcpy(array, src, size * sizeof(T));
+    }
+
+    if (word + 1 < sizeof(T) / sizeof(uint64_t)) {
+        uint64_t lo = 0;
+        for (uint64_t x = 1; x <= size; x++) {
+            if (x == size || key(array[x]) != key(array[lo])) {
+                if (x - lo > 1) {
+                    radix_sort_wide_asc_in_place(array + lo, x - lo, word + 1, cpy + lo);
+                }
+                lo = x;
+            }
+        }
+    }
+}
+
+template<typename T>
+void radix_sort_wide_asc_in_place(T *array, const uint64_t size) {
+    if (size < RADIX_WIDE_MIN_SIZE) {
+        radix_sort_wide_asc_in_place(array, size, 0, (T *) nullptr);
+        return;
+    }
+    auto *cpy = (T *) malloc(size * sizeof(T));
+    if (cpy == nullptr) {
+        // the copy buffer does not fit in memory, sort in place
+        std::sort(array, array + size, [](const T &a, const T &b) { return !(b <= a); });
+        return;
+    }
+    radix_sort_wide_asc_in_place(array, size, 0, cpy);
+    free(cpy);
+}
+
 template<typename T>
 inline void swap(T *a, T *b) {
     const auto t = *a;
@@ -402,97 +727,111 @@ inline void sort(T *index, int64_t size) {
     }
 }
 
-typedef struct {
-    uint64_t value;
-    uint32_t index_index;
-} loser_node_t;
+// Key of a run in the k-way merge: timestamp of the current entry in the high 64 bits and rank of the run
+// in the low ones, so that keys compare without branches. Ranks keep the merge stable and put exhausted
+// runs, ranked from the tree width up, after any timestamp.
+typedef unsigned __int128 merge_key_t;
 
 typedef struct {
-    index_t *index;
-    uint64_t pos;
-    uint64_t size;
-} index_entry_t;
+    const index_t *pos;
+    const index_t *end;
+    // position of the run in the merged array
+    uint32_t id;
+} merge_run_t;
 
 typedef struct {
     index_t *index;
     int64_t size;
 } java_index_entry_t;
 
-void k_way_merge_long_index(
-        index_entry_t *indexes,
-        const uint32_t entries_count,
-        uint32_t sentinels_at_start,
-        index_t *dest
-) {
-
-    // calculate size of the tree
-    const uint32_t tree_size = entries_count * 2;
-    uint64_t merged_index_pos = 0;
-    uint32_t sentinels_left = entries_count - sentinels_at_start;
-
-    loser_node_t tree[tree_size];
+inline merge_key_t merge_key(uint64_t ts, uint64_t rank) {
+    return (static_cast<merge_key_t>(ts) << 64) | rank;
+}
 
-    // seed the bottom of the tree with index values
-    for (uint32_t i = 0; i < entries_count; i++) {
-        if (indexes[i].index != nullptr) {
-            tree[entries_count + i].value = indexes[i].index->ts;
-        } else {
-            tree[entries_count + i].value = L_MAX;
-        }
-        tree[entries_count + i].index_index = entries_count + i;
+// Returns the end of the batch of entries of run "rank" from "lo" that are merged before the runner-up.
+// The first entry is checked on its own and the batch is then grown exponentially, so runs which
+// take turns cost one comparison and long stretches of one run a logarithmic number of them.
+inline const index_t *merge_batch_end(const index_t *lo, const index_t *end, uint64_t rank, merge_key_t runner_up) {
+    const int64_t size = end - lo;
+    if (size == 0 || merge_key(lo[0].ts, rank) >= runner_up) {
+        return lo;
     }
-
-    // seed the entire tree from bottom up
-    for (uint32_t i = tree_size - 1; i > 1; i -= 2) {
-        uint32_t winner;
-        if (tree[i].value < tree[i - 1].value) {
-            winner = i;
+    int64_t good = 0;
+    int64_t step = 1;
+    while (good + step < size && merge_key(lo[good + step].ts, rank) < runner_up) {
+        good += step;
+        step <<= 1;
+    }
+    int64_t bad = std::min(good + step, size);
+    while (bad - good > 1) {
+        const int64_t mid = good + (bad - good) / 2;
+        if (merge_key(lo[mid].ts, rank) < runner_up) {
+            good = mid;
         } else {
-            winner = i - 1;
+            bad = mid;
         }
-        tree[i / 2] = tree[winner];
     }
+    return lo + bad;
+}
 
-    // take the first winner
-    auto winner_index = tree[1].index_index;
-    index_entry_t *winner = indexes + winner_index - entries_count;
-    if (winner->pos < winner->size) {
-        dest[merged_index_pos++] = winner->index[winner->pos];
-    } else {
-        sentinels_left--;
+// Merges non-empty runs ordered by id with a loser tree. Node n of the tree keeps the loser of the match
+// played at n, so replaying the winner reads only its own path. When the winner of a replay is the run
+// that was replayed, its runner-up is the least loser on its path and the entries of the winner that
+// precede the runner-up are copied in one go. "tree" must have room for 3 * ceil_pow_2(run_count) keys.
+index_t *k_way_merge_long_index(merge_run_t *runs, const uint32_t run_count, merge_key_t *tree, index_t *dest) {
+    const uint32_t width = ceil_pow_2(run_count);
+    const merge_key_t no_runner_up = ~static_cast<merge_key_t>(0);
+    merge_key_t *winners = tree + width;
+
+    for (uint32_t r = 0; r < width; r++) {
+        winners[width + r] = r < run_count ? merge_key(runs[r].pos->ts, r) : merge_key(UL_MAX, width + r);
+    }
+    for (uint32_t n = width - 1; n > 0; n--) {
+        const merge_key_t left = winners[2 * n];
+        const merge_key_t right = winners[2 * n + 1];
+        winners[n] = std::min(left, right);
+        tree[n] = std::max(left, right);
     }
 
-    // full run
-    while (sentinels_left > 0) {
+    merge_key_t winner = winners[1];
+    auto rank = static_cast<uint32_t>(winner);
+    merge_key_t runner_up = no_runner_up;
+    for (uint32_t n = (width + rank) / 2; n > 0; n /= 2) {
+        runner_up = std::min(runner_up, tree[n]);
+    }
 
-        // back fill the winning index
-        if (PREDICT_TRUE(++winner->pos < winner->size)) {
-            tree[winner_index].value = winner->index[winner->pos].ts;
+    while (rank < width) {
+        merge_run_t &run = runs[rank];
+        const index_t *batch_end = merge_batch_end(run.pos + 1, run.end, rank, runner_up);
+        const int64_t batch_size = batch_end - run.pos;
+        if (batch_size == 1) {
+            *dest = *run.pos;
         } else {
-            tree[winner_index].value = L_MAX;
-            sentinels_left--;
+            memcpy(dest, run.pos, batch_size * sizeof(index_t));
         }
-
-        if (sentinels_left == 0) {
-            break;
+        dest += batch_size;
+        run.pos = batch_end;
+
+        merge_key_t key = run.pos < run.end ? merge_key(run.pos->ts, rank) : merge_key(UL_MAX, width + rank);
+        for (uint32_t n = (width + rank) / 2; n > 0; n /= 2) {
+            const merge_key_t node = tree[n];
+            tree[n] = std::max(node, key);
+            key = std::min(node, key);
         }
-
-        MM_PREFETCH_NTA(tree);
-        while (PREDICT_TRUE(winner_index > 1)) {
-            const auto right_child = winner_index % 2 == 1 ? winner_index - 1 : winner_index + 1;
-            const auto target = winner_index / 2;
-            if (tree[winner_index].value < tree[right_child].value) {
-                tree[target] = tree[winner_index];
-            } else {
-                tree[target] = tree[right_child];
+        winner = key;
+        if (static_cast<uint32_t>(winner) == rank) {
+            // the path of the winner is in cache after the replay
+            runner_up = no_runner_up;
+            for (uint32_t n = (width + rank) / 2; n > 0; n /= 2) {
+                runner_up = std::min(runner_up, tree[n]);
             }
-            winner_index = target;
+        } else {
+            // the batch of the new winner is its current entry
+            rank = static_cast<uint32_t>(winner);
+            runner_up = winner;
         }
-        winner_index = tree[1].index_index;
-        winner = indexes + winner_index - entries_count;
-        MM_PREFETCH_NTA(winner);
-        dest[merged_index_pos++] = winner->index[winner->pos];
     }
+    return dest;
 }
 
 DECLARE_DISPATCHER(make_timestamp_index);
@@ -529,26 +868,45 @@ void binary_merge_ts_long_index(
 }
 
 
-#ifdef OOO_CPP_PROFILE_TIMING
-const int perf_counter_length = 32;
-std::atomic_ulong perf_counters[perf_counter_length];
-
-uint64_t currentTimeNanos() {
-    struct timespec timespec;
-    clock_gettime(CLOCK_REALTIME, &timespec);
-    return timespec.tv_sec * 1000000000L + timespec.tv_nsec;
+// Fixed size column of the fused merge shuffle, 4 longs per column on the Java side
+typedef struct {
+    const void *src1;
+    const void *src2;
+    void *dest;
+    // log2 of the value size
+    int64_t shl;
+} merge_shuffle_column_t;
+
+// 1024 merge index entries take 16KB
+constexpr int64_t MERGE_SHUFFLE_TILE_ROWS = 1024;
+
+std::atomic<bool> perf_counters_enabled(false);
+perf_counter_t perf_counters[PERF_COUNTER_COUNT];
+
+#if !defined(__aarch64__)
+static int64_t perf_clock_nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
 }
+
+// TSC frequency is not reported on x86, it is measured against the steady clock
+// from the time the library is loaded
+static const int64_t perf_origin_nanos = perf_clock_nanos();
+static const uint64_t perf_origin_ticks = perf_ticks();
 #endif
 
-template<typename T>
-inline void measure_time(int index, T func) {
-#ifdef OOO_CPP_PROFILE_TIMING
-    auto start = currentTimeNanos();
-    func();
-    auto end = currentTimeNanos();
-    perf_counters[index].fetch_add(end - start);
+static int64_t perf_ticks_per_second() {
+#if defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return (int64_t) frequency;
 #else
-    func();
+    const int64_t nanos = perf_clock_nanos() - perf_origin_nanos;
+    if (nanos <= 0) {
+        return 0;
+    }
+    return (int64_t) ((double) (perf_ticks() - perf_origin_ticks) * 1e9 / (double) nanos);
 #endif
 }
 
@@ -609,7 +967,7 @@ Java_io_questdb_std_Vect_oooMergeCopyStrColumn(JNIEnv *env, jclass cl,
                                                jlong dst_fix,
                                                jlong dst_var,
                                                jlong dst_var_offset) {
-    measure_time(0, [=]() {
+    measure_time(0, merge_index_size * sizeof(index_t), [=]() {
         merge_copy_var_column_int32(
                 reinterpret_cast<index_t *>(merge_index),
                 __JLONG_REINTERPRET_CAST__(int64_t, merge_index_size),
@@ -624,8 +982,10 @@ Java_io_questdb_std_Vect_oooMergeCopyStrColumn(JNIEnv *env, jclass cl,
     });
 }
 
-// 1 oooMergeCopyStrColumnWithTop removed and now executed as Merge Copy without Top
-// 2 oooMergeCopyBinColumnWithTop removed and now executed as Merge Copy without Top
+// 1 oooMergeCopyStrColumnWithTop removed and now executed as Merge Copy without Top,
+//   the counter times the offsets pass of sortVarColumn
+// 2 oooMergeCopyBinColumnWithTop removed and now executed as Merge Copy without Top,
+//   the counter times the data pass of sortVarColumn
 
 DECLARE_DISPATCHER(merge_copy_var_column_int64) ;
 JNIEXPORT void JNICALL
@@ -639,7 +999,7 @@ Java_io_questdb_std_Vect_oooMergeCopyBinColumn(JNIEnv *env, jclass cl,
                                                jlong dst_fix,
                                                jlong dst_var,
                                                jlong dst_var_offset) {
-    measure_time(3, [=]() {
+    measure_time(3, merge_index_size * sizeof(index_t), [=]() {
         merge_copy_var_column_int64(
                 reinterpret_cast<index_t *>(merge_index),
                 __JLONG_REINTERPRET_CAST__(int64_t, merge_index_size),
@@ -656,7 +1016,7 @@ Java_io_questdb_std_Vect_oooMergeCopyBinColumn(JNIEnv *env, jclass cl,
 
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_sortLongIndexAscInPlace(JNIEnv *env, jclass cl, jlong pLong, jlong len) {
-    measure_time(4, [=]() {
+    measure_time(4, len * sizeof(index_t), [=]() {
         sort<index_t>(reinterpret_cast<index_t *>(pLong), len);
     });
 }
@@ -680,6 +1040,66 @@ Java_io_questdb_std_Vect_radixSortABLongIndexAsc(JNIEnv *env, jclass cl, jlong p
                                  reinterpret_cast<index_t *>(pDataCpy));
 }
 
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_radixSortParallelCreate(JNIEnv *env, jclass cl, jlong pDataA, jlong countA, jlong pDataB,
+                                                 jlong countB, jlong pDataOut, jlong pDataCpy, jint chunkCount) {
+    return reinterpret_cast<jlong>(radix_sort_parallel_create(
+            reinterpret_cast<uint64_t *>(pDataA),
+            countA,
+            reinterpret_cast<index_t *>(pDataB),
+            countB,
+            reinterpret_cast<index_t *>(pDataOut),
+            reinterpret_cast<index_t *>(pDataCpy),
+            chunkCount
+    ));
+}
+
+JNIEXPORT jint JNICALL
+Java_io_questdb_std_Vect_radixSortParallelChunkCount(JNIEnv *env, jclass cl, jlong pState) {
+    return reinterpret_cast<radix_sort_parallel_t *>(pState)->chunk_count;
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelSample(JNIEnv *env, jclass cl, jlong pState, jint chunk) {
+    radix_sort_parallel_sample(reinterpret_cast<radix_sort_parallel_t *>(pState), chunk);
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelPlan(JNIEnv *env, jclass cl, jlong pState) {
+    radix_sort_parallel_plan(reinterpret_cast<radix_sort_parallel_t *>(pState));
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelCount(JNIEnv *env, jclass cl, jlong pState, jint chunk) {
+    radix_sort_parallel_count(reinterpret_cast<radix_sort_parallel_t *>(pState), chunk);
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelOffsets(JNIEnv *env, jclass cl, jlong pState) {
+    radix_sort_parallel_offsets(reinterpret_cast<radix_sort_parallel_t *>(pState));
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelScatter(JNIEnv *env, jclass cl, jlong pState, jint chunk) {
+    radix_sort_parallel_scatter(reinterpret_cast<radix_sort_parallel_t *>(pState), chunk);
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelBucket(JNIEnv *env, jclass cl, jlong pState, jint bucket) {
+    radix_sort_parallel_bucket(reinterpret_cast<radix_sort_parallel_t *>(pState), bucket);
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_radixSortParallelBucketSize(JNIEnv *env, jclass cl, jlong pState, jint bucket) {
+    const auto *state = reinterpret_cast<radix_sort_parallel_t *>(pState);
+    return (jlong) (state->bucket_offsets[bucket + 1] - state->bucket_offsets[bucket]);
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_radixSortParallelFree(JNIEnv *env, jclass cl, jlong pState) {
+    radix_sort_parallel_free(reinterpret_cast<radix_sort_parallel_t *>(pState));
+}
+
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_sortULongAscInPlace(JNIEnv *env, jclass cl, jlong pLong, jlong len) {
     sort<uint64_t>(reinterpret_cast<uint64_t *>(pLong), len);
@@ -687,45 +1107,73 @@ Java_io_questdb_std_Vect_sortULongAscInPlace(JNIEnv *env, jclass cl, jlong pLong
 
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_sort128BitAscInPlace(JNIEnv *env, jclass cl, jlong pLong, jlong len) {
-    quick_sort_long_index_asc_in_place<__int128>(reinterpret_cast<__int128 *>(pLong), 0, len - 1);
+    radix_sort_wide_asc_in_place<__int128>(reinterpret_cast<__int128 *>(pLong), len);
 }
 
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_sort3LongAscInPlace(JNIEnv *env, jclass cl, jlong pLong, jlong count) {
-    quick_sort_long_index_asc_in_place<long_3x>(reinterpret_cast<long_3x *>(pLong), 0, count - 1);
+    radix_sort_wide_asc_in_place<long_3x>(reinterpret_cast<long_3x *>(pLong), count);
 }
 
-JNIEXPORT void JNICALL
+// Runs are grouped by overlapping timestamp ranges. Groups follow each other, a group of one run is
+// copied as is and the others are merged with a k-way merge. Returns false when the merge state
+// cannot be allocated, nothing is written to the merged index then.
+JNIEXPORT jboolean JNICALL
 Java_io_questdb_std_Vect_mergeLongIndexesAscInner(JAVA_STATIC, jlong pIndexStructArray, jint cnt,
                                                   jlong mergedIndex) {
-    // prepare merge entries
-    // they need to have mutable current position "pos" in index
-
     if (cnt < 2) {
-        return;
+        return true;
     }
 
-    auto count = static_cast<uint32_t>(cnt);
-    const java_index_entry_t *java_entries = reinterpret_cast<java_index_entry_t *>(pIndexStructArray);
-    auto *merged_index = reinterpret_cast<index_t *>(mergedIndex);
+    const auto count = static_cast<uint32_t>(cnt);
+    const auto *java_entries = reinterpret_cast<java_index_entry_t *>(pIndexStructArray);
+    auto *dest = reinterpret_cast<index_t *>(mergedIndex);
 
-    uint32_t size = ceil_pow_2(count);
-    index_entry_t entries[size];
+    auto *runs = reinterpret_cast<merge_run_t *>(malloc(count * sizeof(merge_run_t)));
+    if (runs == nullptr) {
+        return false;
+    }
+    uint32_t run_count = 0;
     for (uint32_t i = 0; i < count; i++) {
-        entries[i].index = java_entries[i].index;
-        entries[i].pos = 0;
-        entries[i].size = java_entries[i].size;
+        if (java_entries[i].size > 0) {
+            runs[run_count++] = {java_entries[i].index, java_entries[i].index + java_entries[i].size, i};
+        }
     }
+    std::sort(runs, runs + run_count, [](const merge_run_t &a, const merge_run_t &b) {
+        return a.pos->ts < b.pos->ts || (a.pos->ts == b.pos->ts && a.id < b.id);
+    });
 
-    if (count < size) {
-        for (uint32_t i = count; i < size; i++) {
-            entries[i].index = nullptr;
-            entries[i].pos = 0;
-            entries[i].size = -1;
-        }
+    auto *tree = reinterpret_cast<merge_key_t *>(malloc(3 * ceil_pow_2(std::max(run_count, 1u)) * sizeof(merge_key_t)));
+    if (tree == nullptr) {
+        free(runs);
+        return false;
     }
+    uint32_t group_lo = 0;
+    while (group_lo < run_count) {
+        // runs overlap when one starts at or before the last timestamp of another
+        uint64_t group_max_ts = (runs[group_lo].end - 1)->ts;
+        uint32_t group_hi = group_lo + 1;
+        while (group_hi < run_count && runs[group_hi].pos->ts <= group_max_ts) {
+            group_max_ts = std::max(group_max_ts, (runs[group_hi].end - 1)->ts);
+            group_hi++;
+        }
 
-    k_way_merge_long_index(entries, size, size - count, merged_index);
+        if (group_hi - group_lo == 1) {
+            const merge_run_t &run = runs[group_lo];
+            memcpy(dest, run.pos, (run.end - run.pos) * sizeof(index_t));
+            dest += run.end - run.pos;
+        } else {
+            // ties are merged in the order of the runs in the array
+            std::sort(runs + group_lo, runs + group_hi, [](const merge_run_t &a, const merge_run_t &b) {
+                return a.id < b.id;
+            });
+            dest = k_way_merge_long_index(runs + group_lo, group_hi - group_lo, tree, dest);
+        }
+        group_lo = group_hi;
+    }
+    free(tree);
+    free(runs);
+    return true;
 }
 
 JNIEXPORT void JNICALL
@@ -745,7 +1193,7 @@ DECLARE_DISPATCHER(re_shuffle_int32) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_indexReshuffle32Bit(JNIEnv *env, jclass cl, jlong pSrc, jlong pDest, jlong pIndex,
                                              jlong count) {
-    measure_time(5, [=]() {
+    measure_time(5, count * sizeof(int32_t), [=]() {
         re_shuffle_int32(
                 reinterpret_cast<int32_t *>(pSrc),
                 reinterpret_cast<int32_t *>(pDest),
@@ -759,7 +1207,7 @@ DECLARE_DISPATCHER(re_shuffle_int64) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_indexReshuffle64Bit(JNIEnv *env, jclass cl, jlong pSrc, jlong pDest, jlong pIndex,
                                              jlong count) {
-    measure_time(6, [=]() {
+    measure_time(6, count * sizeof(int64_t), [=]() {
         re_shuffle_int64(
                 reinterpret_cast<int64_t *>(pSrc),
                 reinterpret_cast<int64_t *>(pDest),
@@ -773,7 +1221,7 @@ DECLARE_DISPATCHER(re_shuffle_128bit) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_indexReshuffle128Bit(JNIEnv *env, jclass cl, jlong pSrc, jlong pDest, jlong pIndex,
                                               jlong count) {
-    measure_time(32, [=]() {
+    measure_time(14, count * sizeof(__int128), [=]() {
         re_shuffle_128bit(
                 reinterpret_cast<__int128 *>(pSrc),
                 reinterpret_cast<__int128 *>(pDest),
@@ -787,7 +1235,7 @@ DECLARE_DISPATCHER(re_shuffle_256bit) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_indexReshuffle256Bit(JNIEnv *env, jclass cl, jlong pSrc, jlong pDest, jlong pIndex,
                                               jlong count) {
-    measure_time(30, [=]() {
+    measure_time(30, count * sizeof(long_256bit), [=]() {
         re_shuffle_256bit(
                 reinterpret_cast<long_256bit *>(pSrc),
                 reinterpret_cast<long_256bit *>(pDest),
@@ -801,7 +1249,7 @@ JNIEXPORT void JNICALL
 // Leave vanilla
 Java_io_questdb_std_Vect_indexReshuffle16Bit(JNIEnv *env, jclass cl, jlong pSrc, jlong pDest, jlong pIndex,
                                              jlong count) {
-    measure_time(7, [=]() {
+    measure_time(7, count * sizeof(int16_t), [=]() {
         re_shuffle_vanilla<int16_t>(
                 reinterpret_cast<int16_t *>(pSrc),
                 reinterpret_cast<int16_t *>(pDest),
@@ -814,7 +1262,7 @@ Java_io_questdb_std_Vect_indexReshuffle16Bit(JNIEnv *env, jclass cl, jlong pSrc,
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_indexReshuffle8Bit(JNIEnv *env, jclass cl, jlong pSrc, jlong pDest, jlong pIndex,
                                             jlong count) {
-    measure_time(8, [=]() {
+    measure_time(8, count * sizeof(int8_t), [=]() {
         re_shuffle_vanilla<int8_t>(
                 reinterpret_cast<int8_t *>(pSrc),
                 reinterpret_cast<int8_t *>(pDest),
@@ -824,11 +1272,12 @@ Java_io_questdb_std_Vect_indexReshuffle8Bit(JNIEnv *env, jclass cl, jlong pSrc,
     });
 }
 
+DECLARE_DISPATCHER(merge_shuffle_int8) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_mergeShuffle8Bit(JNIEnv *env, jclass cl, jlong src1, jlong src2, jlong dest, jlong index,
                                           jlong count) {
-    measure_time(9, [=]() {
-        merge_shuffle_vanilla<int8_t>(
+    measure_time(9, count * sizeof(int8_t), [=]() {
+        merge_shuffle_int8(
                 reinterpret_cast<int8_t *>(src1),
                 reinterpret_cast<int8_t *>(src2),
                 reinterpret_cast<int8_t *>(dest),
@@ -838,11 +1287,12 @@ Java_io_questdb_std_Vect_mergeShuffle8Bit(JNIEnv *env, jclass cl, jlong src1, jl
     });
 }
 
+DECLARE_DISPATCHER(merge_shuffle_int16) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_mergeShuffle16Bit(JNIEnv *env, jclass cl, jlong src1, jlong src2, jlong dest, jlong index,
                                            jlong count) {
-    measure_time(10, [=]() {
-        merge_shuffle_vanilla<int16_t>(
+    measure_time(10, count * sizeof(int16_t), [=]() {
+        merge_shuffle_int16(
                 reinterpret_cast<int16_t *>(src1),
                 reinterpret_cast<int16_t *>(src2),
                 reinterpret_cast<int16_t *>(dest),
@@ -852,11 +1302,12 @@ Java_io_questdb_std_Vect_mergeShuffle16Bit(JNIEnv *env, jclass cl, jlong src1, j
     });
 }
 
+DECLARE_DISPATCHER(merge_shuffle_int32) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_mergeShuffle32Bit(JNIEnv *env, jclass cl, jlong src1, jlong src2, jlong dest, jlong index,
                                            jlong count) {
-    measure_time(11, [=]() {
-        merge_shuffle_vanilla<int32_t>(
+    measure_time(11, count * sizeof(int32_t), [=]() {
+        merge_shuffle_int32(
                 reinterpret_cast<int32_t *>(src1),
                 reinterpret_cast<int32_t *>(src2),
                 reinterpret_cast<int32_t *>(dest),
@@ -870,7 +1321,7 @@ DECLARE_DISPATCHER(merge_shuffle_int64) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_mergeShuffle64Bit(JNIEnv *env, jclass cl, jlong src1, jlong src2, jlong dest, jlong index,
                                            jlong count) {
-    measure_time(12, [=]() {
+    measure_time(12, count * sizeof(int64_t), [=]() {
         merge_shuffle_int64(
                 reinterpret_cast<int64_t *>(src1),
                 reinterpret_cast<int64_t *>(src2),
@@ -885,7 +1336,7 @@ Java_io_questdb_std_Vect_mergeShuffle64Bit(JNIEnv *env, jclass cl, jlong src1, j
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_mergeShuffle128Bit(JNIEnv *env, jclass cl, jlong src1, jlong src2, jlong dest, jlong index,
                                             jlong count) {
-    measure_time(29, [=]() {
+    measure_time(29, count * sizeof(__int128), [=]() {
         merge_shuffle_vanilla<__int128>(
                 reinterpret_cast<__int128 *>(src1),
                 reinterpret_cast<__int128 *>(src2),
@@ -899,7 +1350,7 @@ Java_io_questdb_std_Vect_mergeShuffle128Bit(JNIEnv *env, jclass cl, jlong src1,
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_mergeShuffle256Bit(JNIEnv *env, jclass cl, jlong src1, jlong src2, jlong dest, jlong index,
                                             jlong count) {
-    measure_time(29, [=]() {
+    measure_time(15, count * sizeof(long_256bit), [=]() {
         merge_shuffle_vanilla<long_256bit>(
                 reinterpret_cast<long_256bit *>(src1),
                 reinterpret_cast<long_256bit *>(src2),
@@ -910,13 +1361,98 @@ Java_io_questdb_std_Vect_mergeShuffle256Bit(JNIEnv *env, jclass cl, jlong src1,
     });
 }
 
-// Methods 13-16 were mergeShuffleWithTop(s) and replaced with calls to simple mergeShuffle(s)
+// Shuffles rows [lo, lo + count) of the merge index into one column
+static inline void merge_shuffle_tile(const merge_shuffle_column_t &column, const index_t *index, int64_t lo, int64_t count) {
+    switch (column.shl) {
+        case 0:
+            merge_shuffle_int8(
+                    reinterpret_cast<const int8_t *>(column.src1),
+                    reinterpret_cast<const int8_t *>(column.src2),
+                    reinterpret_cast<int8_t *>(column.dest) + lo,
+                    index + lo,
+                    count
+            );
+            break;
+        case 1:
+            merge_shuffle_int16(
+                    reinterpret_cast<const int16_t *>(column.src1),
+                    reinterpret_cast<const int16_t *>(column.src2),
+                    reinterpret_cast<int16_t *>(column.dest) + lo,
+                    index + lo,
+                    count
+            );
+            break;
+        case 2:
+            merge_shuffle_int32(
+                    reinterpret_cast<const int32_t *>(column.src1),
+                    reinterpret_cast<const int32_t *>(column.src2),
+                    reinterpret_cast<int32_t *>(column.dest) + lo,
+                    index + lo,
+                    count
+            );
+            break;
+        case 3:
+            merge_shuffle_int64(
+                    reinterpret_cast<const int64_t *>(column.src1),
+                    reinterpret_cast<const int64_t *>(column.src2),
+                    reinterpret_cast<int64_t *>(column.dest) + lo,
+                    index + lo,
+                    count
+            );
+            break;
+        case 4:
+            merge_shuffle_vanilla<__int128>(
+                    reinterpret_cast<const __int128 *>(column.src1),
+                    reinterpret_cast<const __int128 *>(column.src2),
+                    reinterpret_cast<__int128 *>(column.dest) + lo,
+                    index + lo,
+                    count
+            );
+            break;
+        default:
+            merge_shuffle_vanilla<long_256bit>(
+                    reinterpret_cast<const long_256bit *>(column.src1),
+                    reinterpret_cast<const long_256bit *>(column.src2),
+                    reinterpret_cast<long_256bit *>(column.dest) + lo,
+                    index + lo,
+                    count
+            );
+            break;
+    }
+}
+
+// Method 13 was mergeShuffleWithTop and is reused by the fused shuffle of fixed size columns.
+// The merge index is read once, tile by tile, and each tile is shuffled into all the columns
+// while it is still in L1.
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_mergeShuffleFixedColumns(JNIEnv *env, jclass cl, jlong pColumns, jlong columnCount,
+                                                  jlong pIndex, jlong indexLo, jlong indexHi) {
+    const auto *columns = reinterpret_cast<const merge_shuffle_column_t *>(pColumns);
+    const auto column_count = __JLONG_REINTERPRET_CAST__(int64_t, columnCount);
+    int64_t row_size = 0;
+    for (int64_t c = 0; c < column_count; c++) {
+        row_size += 1ll << columns[c].shl;
+    }
+    measure_time(13, (indexHi - indexLo) * row_size, [=]() {
+        const auto *index = reinterpret_cast<const index_t *>(pIndex);
+        const auto hi = __JLONG_REINTERPRET_CAST__(int64_t, indexHi);
+        for (int64_t lo = __JLONG_REINTERPRET_CAST__(int64_t, indexLo); lo < hi; lo += MERGE_SHUFFLE_TILE_ROWS) {
+            const int64_t count = std::min(MERGE_SHUFFLE_TILE_ROWS, hi - lo);
+            for (int64_t c = 0; c < column_count; c++) {
+                merge_shuffle_tile(columns[c], index, lo, count);
+            }
+        }
+    });
+}
+
+// Methods 14-16 were mergeShuffleWithTop(s) and replaced with calls to simple mergeShuffle(s),
+// 14 and 15 are reused by indexReshuffle128Bit and mergeShuffle256Bit.
 
 DECLARE_DISPATCHER(flatten_index) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_flattenIndex(JNIEnv *env, jclass cl, jlong pIndex,
                                       jlong count) {
-    measure_time(17, [=]() {
+    measure_time(17, count * sizeof(index_t), [=]() {
         flatten_index(
                 reinterpret_cast<index_t *>(pIndex),
                 __JLONG_REINTERPRET_CAST__(int64_t, count)
@@ -939,7 +1475,7 @@ Java_io_questdb_std_Vect_binarySearchIndexT(JNIEnv *env, jclass cl, jlong pData,
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_makeTimestampIndex(JNIEnv *env, jclass cl, jlong pData, jlong low,
                                             jlong high, jlong pIndex) {
-    measure_time(18, [=]() {
+    measure_time(18, (high - low + 1) * sizeof(index_t), [=]() {
         make_timestamp_index(
                 reinterpret_cast<int64_t *>(pData),
                 low,
@@ -952,7 +1488,7 @@ Java_io_questdb_std_Vect_makeTimestampIndex(JNIEnv *env, jclass cl, jlong pData,
 DECLARE_DISPATCHER(shift_timestamp_index) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_shiftTimestampIndex(JNIEnv *env, jclass cl, jlong pSrc, jlong count, jlong pDest) {
-    measure_time(31, [=]() {
+    measure_time(31, count * sizeof(index_t), [=]() {
         shift_timestamp_index(
                 reinterpret_cast<index_t *>(pSrc),
                 __JLONG_REINTERPRET_CAST__(int64_t, count),
@@ -965,7 +1501,7 @@ DECLARE_DISPATCHER(set_memory_vanilla_int64) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setMemoryLong(JNIEnv *env, jclass cl, jlong pData, jlong value,
                                        jlong count) {
-    measure_time(19, [=]() {
+    measure_time(19, count * sizeof(int64_t), [=]() {
         set_memory_vanilla_int64(
                 reinterpret_cast<int64_t *>(pData),
                 __JLONG_REINTERPRET_CAST__(int64_t, value),
@@ -978,7 +1514,7 @@ DECLARE_DISPATCHER(set_memory_vanilla_int32) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setMemoryInt(JNIEnv *env, jclass cl, jlong pData, jint value,
                                       jlong count) {
-    measure_time(20, [=]() {
+    measure_time(20, count * sizeof(int32_t), [=]() {
         set_memory_vanilla_int32(
                 reinterpret_cast<int32_t *>(pData),
                 value,
@@ -991,7 +1527,7 @@ DECLARE_DISPATCHER(set_memory_vanilla_double) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setMemoryDouble(JNIEnv *env, jclass cl, jlong pData, jdouble value,
                                          jlong count) {
-    measure_time(21, [=]() {
+    measure_time(21, count * sizeof(double), [=]() {
         set_memory_vanilla_double(
                 reinterpret_cast<jdouble *>(pData),
                 value,
@@ -1004,7 +1540,7 @@ DECLARE_DISPATCHER(set_memory_vanilla_float) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setMemoryFloat(JNIEnv *env, jclass cl, jlong pData, jfloat value,
                                         jlong count) {
-    measure_time(22, [=]() {
+    measure_time(22, count * sizeof(float), [=]() {
         set_memory_vanilla_float(
                 reinterpret_cast<jfloat *>(pData),
                 value,
@@ -1017,7 +1553,7 @@ DECLARE_DISPATCHER(set_memory_vanilla_short) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setMemoryShort(JNIEnv *env, jclass cl, jlong pData, jshort value,
                                         jlong count) {
-    measure_time(23, [=]() {
+    measure_time(23, count * sizeof(int16_t), [=]() {
         set_memory_vanilla_short(
                 reinterpret_cast<jshort *>(pData),
                 value,
@@ -1031,7 +1567,7 @@ DECLARE_DISPATCHER(set_var_refs_32_bit) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setVarColumnRefs32Bit(JNIEnv *env, jclass cl, jlong pData, jlong offset,
                                                jlong count) {
-    measure_time(24, [=]() {
+    measure_time(24, count * sizeof(int64_t), [=]() {
         set_var_refs_32_bit(
                 reinterpret_cast<int64_t *>(pData),
                 __JLONG_REINTERPRET_CAST__(int64_t, offset),
@@ -1044,7 +1580,7 @@ DECLARE_DISPATCHER(set_var_refs_64_bit) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_setVarColumnRefs64Bit(JNIEnv *env, jclass cl, jlong pData, jlong offset,
                                                jlong count) {
-    measure_time(25, [=]() {
+    measure_time(25, count * sizeof(int64_t), [=]() {
         set_var_refs_64_bit(
                 reinterpret_cast<int64_t *>(pData),
                 __JLONG_REINTERPRET_CAST__(int64_t, offset),
@@ -1057,7 +1593,7 @@ DECLARE_DISPATCHER(copy_index) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_oooCopyIndex(JNIEnv *env, jclass cl, jlong pIndex, jlong index_size,
                                       jlong pDest) {
-    measure_time(26, [=]() {
+    measure_time(26, index_size * sizeof(int64_t), [=]() {
         copy_index(
                 reinterpret_cast<index_t *>(pIndex),
                 __JLONG_REINTERPRET_CAST__(int64_t, index_size),
@@ -1070,7 +1606,7 @@ DECLARE_DISPATCHER(shift_copy) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_shiftCopyFixedSizeColumnData(JNIEnv *env, jclass cl, jlong shift, jlong src, jlong srcLo,
                                                       jlong srcHi, jlong dst) {
-    measure_time(27, [=]() {
+    measure_time(27, (srcHi - srcLo + 1) * sizeof(int64_t), [=]() {
         shift_copy(
                 __JLONG_REINTERPRET_CAST__(int64_t, shift),
                 reinterpret_cast<int64_t *>(src),
@@ -1085,7 +1621,7 @@ DECLARE_DISPATCHER(copy_index_timestamp) ;
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_copyFromTimestampIndex(JNIEnv *env, jclass cl, jlong pIndex, jlong indexLo, jlong indexHi,
                                                 jlong pTs) {
-    measure_time(28, [=]() {
+    measure_time(28, (indexHi - indexLo + 1) * sizeof(int64_t), [=]() {
         copy_index_timestamp(
                 reinterpret_cast<index_t *>(pIndex),
                 __JLONG_REINTERPRET_CAST__(int64_t, indexLo),
@@ -1095,31 +1631,108 @@ Java_io_questdb_std_Vect_copyFromTimestampIndex(JNIEnv *env, jclass cl, jlong pI
     });
 }
 
+// nanoseconds spent in the counted calls
 JNIEXPORT jlong JNICALL
 Java_io_questdb_std_Vect_getPerformanceCounter(JNIEnv *env, jclass cl, jint counterIndex) {
-#ifdef OOO_CPP_PROFILE_TIMING
-    return perf_counters[counterIndex].load();
-#else
-    return 0;
-#endif
+    const int64_t ticks_per_second = perf_ticks_per_second();
+    if (ticks_per_second <= 0) {
+        return 0;
+    }
+    const uint64_t ticks = perf_counters[counterIndex].ticks.load(std::memory_order_relaxed);
+    return (jlong) ((double) ticks * 1e9 / (double) ticks_per_second);
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_getPerformanceCounterBucket(JNIEnv *env, jclass cl, jint counterIndex, jint bucket) {
+    return perf_counters[counterIndex].buckets[bucket].load(std::memory_order_relaxed);
+}
+
+JNIEXPORT jint JNICALL
+Java_io_questdb_std_Vect_getPerformanceCounterBucketCount(JNIEnv *env, jclass cl) {
+    return PERF_COUNTER_BUCKET_COUNT;
 }
 
 JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_getPerformanceCounterBytes(JNIEnv *env, jclass cl, jint counterIndex) {
+    return perf_counters[counterIndex].bytes.load(std::memory_order_relaxed);
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_getPerformanceCounterCalls(JNIEnv *env, jclass cl, jint counterIndex) {
+    return perf_counters[counterIndex].calls.load(std::memory_order_relaxed);
+}
+
+JNIEXPORT jint JNICALL
 Java_io_questdb_std_Vect_getPerformanceCountersCount(JNIEnv *env, jclass cl) {
-#ifdef OOO_CPP_PROFILE_TIMING
-    return perf_counter_length;
-#else
-    return 0;
-#endif
+    return perf_counters_enabled.load(std::memory_order_relaxed) ? PERF_COUNTER_COUNT : 0;
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_getPerformanceTicksPerSecond(JNIEnv *env, jclass cl) {
+    return perf_ticks_per_second();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Vect_isPerformanceCountersEnabled(JNIEnv *env, jclass cl) {
+    return perf_counters_enabled.load(std::memory_order_relaxed);
 }
 
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Vect_resetPerformanceCounters(JNIEnv *env, jclass cl) {
-#ifdef OOO_CPP_PROFILE_TIMING
-    for (int i = 0; i < perf_counter_length; i++) {
-        perf_counters[i].store(0);
+    for (auto &counter: perf_counters) {
+        counter.calls.store(0, std::memory_order_relaxed);
+        counter.ticks.store(0, std::memory_order_relaxed);
+        counter.bytes.store(0, std::memory_order_relaxed);
+        for (auto &bucket: counter.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_setPerformanceCountersEnabled(JNIEnv *env, jclass cl, jboolean enabled) {
+    perf_counters_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Second pass of sortVarColumn, copies values of rows [lo, hi) of the index to the offsets computed by
+// the first pass. Rows do not depend on each other, so disjoint row ranges can be copied concurrently.
+// Consecutive source rows are adjacent in both source and destination data and are copied as one run.
+static inline void sort_var_column_data(const index_t *index, const int64_t lo, const int64_t hi,
+                                        const char *src_data, const int64_t *src_index,
+                                        char *tgt_data, const int64_t *tgt_index) {
+    int64_t l = lo;
+    while (l < hi) {
+        MM_PREFETCH_T0(index + l + 64);
+        // source offsets of rows ahead, then their values, both miss the cache when rows are shuffled
+        if (l + 16 < hi) {
+            MM_PREFETCH_T0(src_index + index[l + 16].i);
+            MM_PREFETCH_T0(src_data + src_index[index[l + 8].i]);
+        }
+        uint64_t row = index[l].i;
+        const int64_t o1 = src_index[row];
+        const int64_t offset = tgt_index[l];
+        int64_t next = l + 1;
+        row++;
+        while (next < hi && index[next].i == row) {
+            next++;
+            row++;
+        }
+        platform_memcpy(reinterpret_cast<void *>(tgt_data + offset), reinterpret_cast<const void *>(src_data + o1),
+                        src_index[row] - o1);
+        l = next;
     }
-#endif
+}
+
+// returns size of the sorted var data
+DECLARE_DISPATCHER(sort_var_column_offsets) ;
+static inline int64_t sort_var_column_offsets_and_size(const index_t *index, const int64_t count,
+                                                       const int64_t *src_index, int64_t *tgt_index) {
+    if (count < 1) {
+        return 0;
+    }
+    sort_var_column_offsets(index, count, src_index, tgt_index);
+    const uint64_t last_row = index[count - 1].i;
+    return tgt_index[count - 1] + src_index[last_row + 1] - src_index[last_row];
 }
 
 JNIEXPORT jlong JNICALL
@@ -1133,19 +1746,47 @@ Java_io_questdb_std_Vect_sortVarColumn(JNIEnv *env, jclass cl, jlong mergedTimes
     char *tgt_data = reinterpret_cast<char *>(tgtDataAddr);
     int64_t *tgt_index = reinterpret_cast<int64_t *>(tgtIndxAddr);
 
-    int64_t offset = 0;
-    for (int64_t i = 0; i < count; ++i) {
-        MM_PREFETCH_T0(index + i + 64);
-        const int64_t row = index[i].i;
-        const int64_t o1 = src_index[row];
-        const int64_t o2 = src_index[row + 1];
-        const int64_t len = o2 - o1;
-        platform_memcpy(reinterpret_cast<void *>(tgt_data + offset), reinterpret_cast<const void *>(src_data + o1),
-                        len);
-        tgt_index[i] = offset;
-        offset += len;
-    }
-    return __JLONG_REINTERPRET_CAST__(jlong, offset);
+    const int64_t size = measure_time(1, count * sizeof(index_t), [=]() {
+        return sort_var_column_offsets_and_size(index, count, src_index, tgt_index);
+    });
+    measure_time(2, count * sizeof(index_t), [=]() {
+        sort_var_column_data(index, 0, count, src_data, src_index, tgt_data, tgt_index);
+    });
+    return __JLONG_REINTERPRET_CAST__(jlong, size);
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Vect_sortVarColumnOffsets(JNIEnv *env, jclass cl, jlong mergedTimestampsAddr, jlong valueCount,
+                                              jlong srcIndxAddr, jlong tgtIndxAddr) {
+    const int64_t count = __JLONG_REINTERPRET_CAST__(int64_t, valueCount);
+    const int64_t size = measure_time(1, count * sizeof(index_t), [=]() {
+        return sort_var_column_offsets_and_size(
+                reinterpret_cast<const index_t *>(mergedTimestampsAddr),
+                count,
+                reinterpret_cast<const int64_t *>(srcIndxAddr),
+                reinterpret_cast<int64_t *>(tgtIndxAddr)
+        );
+    });
+    return __JLONG_REINTERPRET_CAST__(jlong, size);
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Vect_sortVarColumnData(JNIEnv *env, jclass cl, jlong mergedTimestampsAddr, jlong rowLo,
+                                           jlong rowHi, jlong srcDataAddr, jlong srcIndxAddr, jlong tgtDataAddr,
+                                           jlong tgtIndxAddr) {
+    const int64_t lo = __JLONG_REINTERPRET_CAST__(int64_t, rowLo);
+    const int64_t hi = __JLONG_REINTERPRET_CAST__(int64_t, rowHi);
+    measure_time(2, (hi - lo) * sizeof(index_t), [=]() {
+        sort_var_column_data(
+                reinterpret_cast<const index_t *>(mergedTimestampsAddr),
+                lo,
+                hi,
+                reinterpret_cast<const char *>(srcDataAddr),
+                reinterpret_cast<const int64_t *>(srcIndxAddr),
+                reinterpret_cast<char *>(tgtDataAddr),
+                reinterpret_cast<const int64_t *>(tgtIndxAddr)
+        );
+    });
 }
 
 }
@@ -200,6 +200,79 @@ inline void re_shuffle(const T *src, T *dest, const index_t *index, const int64_
     );
 }
 
+// Merged var data larger than this is written with non-temporal stores, it would not stay in the LLC anyway
+constexpr int64_t MERGE_COPY_VAR_NT_THRESHOLD = 32 * 1024 * 1024;
+
+// Writes merged var values bypassing the cache. Values are staged in a small buffer and written out
+// in whole destination cache lines with non-temporal stores, short values included.
+class var_stream_writer {
+public:
+    explicit var_stream_writer(char *dst) : dst(dst), len(0) {}
+
+    inline void put(const char *src, int64_t size) {
+        while (size > 0) {
+            const int64_t n = std::min(size, BUFFER_SIZE - len);
+            __MEMCPY(buffer + len, src, n);
+            len += n;
+            src += n;
+            size -= n;
+            if (len == BUFFER_SIZE) {
+                flush();
+            }
+        }
+    }
+
+    inline void finish() {
+        flush();
+        __MEMCPY(dst, buffer, len);
+        _mm_sfence();
+    }
+
+private:
+    static constexpr int64_t BUFFER_SIZE = 4096;
+    alignas(64) char buffer[BUFFER_SIZE];
+    char *dst;
+    int64_t len;
+
+    // streams buffered whole cache lines and keeps the partial last line in the buffer
+    inline void flush() {
+        const auto head = std::min<int64_t>(len, (64 - ((uintptr_t) dst & 63u)) & 63u);
+        __MEMCPY(dst, buffer, head);
+        int64_t i = head;
+        for (; i + 64 <= len; i += 64) {
+            const auto *src = reinterpret_cast<const __m128i *>(buffer + i);
+            auto *line = reinterpret_cast<__m128i *>(dst + i);
+            _mm_stream_si128(line, _mm_loadu_si128(src));
+            _mm_stream_si128(line + 1, _mm_loadu_si128(src + 1));
+            _mm_stream_si128(line + 2, _mm_loadu_si128(src + 2));
+            _mm_stream_si128(line + 3, _mm_loadu_si128(src + 3));
+        }
+        __MEMMOVE(buffer, buffer + i, len - i);
+        dst += i;
+        len -= i;
+    }
+};
+
+// in-place inclusive prefix sum
+inline void prefix_sum(int64_t *data, const int64_t count) {
+    int64_t i = 0;
+    Vec4q carry(0);
+    for (; i + 4 <= count; i += 4) {
+        Vec4q v;
+        v.load(data + i);
+        v += permute4<-1, 0, 1, 2>(v);
+        v += permute4<-1, -1, 0, 1>(v);
+        v += carry;
+        v.store(data + i);
+        carry = permute4<3, 3, 3, 3>(v);
+    }
+    int64_t sum = carry[0];
+    for (; i < count; i++) {
+        sum += data[i];
+        data[i] = sum;
+    }
+}
+
 // 0, 3
 template<typename T>
 inline void merge_copy_var_column(
@@ -214,26 +287,49 @@ inline void merge_copy_var_column(
         int64_t dst_var_offset,
         T mult
 ) {
+    if (merge_index_size < 1) {
+        return;
+    }
     int64_t *src_fix[] = {src_ooo_fix, src_data_fix};
     char *src_var[] = {src_ooo_var, src_data_var};
 
-    for (int64_t l = 0; l < merge_index_size; l++) {
-        MM_PREFETCH_T0(merge_index + l + 64);
-        dst_fix[l] = dst_var_offset;
-        const uint64_t row = merge_index[l].i;
-        const uint32_t bit = (row >> 63);
-        const uint64_t rr = row & ~(1ull << 63);
-        const int64_t offset = src_fix[bit][rr];
-        char *src_var_ptr = src_var[bit] + offset;
-        auto len = *reinterpret_cast<T *>(src_var_ptr);
-        auto char_count = len > 0 ? len * mult : 0;
-        reinterpret_cast<T *>(dst_var + dst_var_offset)[0] = len;
-        __MEMCPY(dst_var + dst_var_offset + sizeof(T), src_var_ptr + sizeof(T), char_count);
-        dst_var_offset += char_count + sizeof(T);
+    dst_fix[0] = dst_var_offset;
+    merge_var_sizes<T>(merge_index, merge_index_size, src_fix, src_var, dst_fix, mult);
+    prefix_sum(dst_fix, merge_index_size + 1);
+
+    if (dst_fix[merge_index_size] - dst_var_offset > MERGE_COPY_VAR_NT_THRESHOLD) {
+        var_stream_writer writer(dst_var + dst_var_offset);
+        merge_var_runs(merge_index, merge_index_size, src_fix, src_var, dst_fix, writer);
+    } else {
+        var_copy_writer writer(dst_var + dst_var_offset);
+        merge_var_runs(merge_index, merge_index_size, src_fix, src_var, dst_fix, writer);
+    }
+}
+
+// 1
+// First pass of sortVarColumn, dst_fix[l] is the destination offset of the value of row index[l].i.
+// Sizes of all values but the last one are gathered into dst_fix[1..count-1] and summed up in place.
+void MULTI_VERSION_NAME (sort_var_column_offsets)(const index_t *index, const int64_t count, const int64_t *src_fix,
+                                                  int64_t *dst_fix) {
+    if (count < 1) {
+        return;
     }
-    if (merge_index_size > 0) {
-        dst_fix[merge_index_size] = dst_var_offset;
+    dst_fix[0] = 0;
+    int64_t *sizes = dst_fix + 1;
+    const int64_t size_count = count - 1;
+    int64_t l = 0;
+    for (; l + 8 <= size_count; l += 8) {
+        MM_PREFETCH_T0(index + l + 64);
+        const Vec8uq rows = gather8q<1, 3, 5, 7, 9, 11, 13, 15>(index + l);
+        const Vec8q lo = lookup_idx8<Vec8q>(rows, src_fix);
+        const Vec8q hi = lookup_idx8<Vec8q>(rows + 1, src_fix);
+        (hi - lo).store(sizes + l);
     }
+    for (; l < size_count; l++) {
+        const uint64_t row = index[l].i;
+        sizes[l] = src_fix[row + 1] - src_fix[row];
+    }
+    prefix_sum(dst_fix, count);
 }
 
 void MULTI_VERSION_NAME (platform_memcpy)(void *dst, const void *src, const size_t len) {
@@ -355,6 +451,109 @@ MULTI_VERSION_NAME (merge_shuffle_int64)(const int64_t *src1, const int64_t *src
 #endif
 }
 
+#if INSTRSET >= 8
+// Gathers 8 values of the merge, each taken from src1 or src2 by the high bit of its index row.
+// A single gather of absolute addresses serves both sources. Values narrower than 4 bytes are
+// gathered as the aligned dword holding them and shifted down, such a dword never crosses a page boundary.
+template<typename T>
+inline Vec8i merge_gather8(const T *src1, const T *src2, const index_t *index) {
+    constexpr int shl = sizeof(T) == 4 ? 2 : sizeof(T) == 2 ? 1 : 0;
+    const Vec8uq r = gather8q<1, 3, 5, 7, 9, 11, 13, 15>(index);
+    const Vec8uq rows = r & ~(1LLu << 63u);
+    const Vec8uq base = select(Vec8q(r) < 0, Vec8uq((uint64_t) src1), Vec8uq((uint64_t) src2));
+    const Vec8uq address = base + (rows << shl);
+    const Vec8uq aligned = address & ~3LLu;
+#if INSTRSET >= 10
+    Vec8i v = _mm512_i64gather_epi32(aligned, nullptr, 1);
+#else
+    Vec8i v = Vec8i(
+            Vec4i(_mm256_i64gather_epi32(nullptr, aligned.get_low(), 1)),
+            Vec4i(_mm256_i64gather_epi32(nullptr, aligned.get_high(), 1))
+    );
+#endif
+    if constexpr (sizeof(T) < 4) {
+        const Vec8i shift = compress(Vec8q(address & 3LLu)) << 3;
+        v = _mm256_srlv_epi32(v, shift);
+    }
+    return v;
+}
+
+template<typename T, typename TVec>
+inline void merge_shuffle_gather(const T *src1, const T *src2, T *dest, const index_t *index, const int64_t count) {
+    static_assert(TVec::size() == 8 || TVec::size() == 16 || TVec::size() == 32);
+    const T *sources[] = {src2, src1};
+
+    const auto merge = [dest, index, &sources](int64_t i) {
+        const auto r = reinterpret_cast<uint64_t>(index[i].i);
+        const uint64_t pick = r >> 63u;
+        const auto row = r & ~(1LLu << 63u);
+        dest[i] = sources[pick][row];
+    };
+
+    const auto bulk_merge = [dest, index, src1, src2](const int64_t i) {
+        MM_PREFETCH_T0(index + i + 64);
+        if constexpr (TVec::size() == 8) {
+            merge_gather8<T>(src1, src2, index + i).store_a(dest + i);
+        } else if constexpr (TVec::size() == 16) {
+            compress(
+                    merge_gather8<T>(src1, src2, index + i),
+                    merge_gather8<T>(src1, src2, index + i + 8)
+            ).store_a(dest + i);
+        } else {
+            compress(
+                    compress(merge_gather8<T>(src1, src2, index + i), merge_gather8<T>(src1, src2, index + i + 8)),
+                    compress(merge_gather8<T>(src1, src2, index + i + 16), merge_gather8<T>(src1, src2, index + i + 24))
+            ).store_a(dest + i);
+        }
+    };
+
+    // values of a source misaligned to their size could span two gathered dwords
+    if ((((uintptr_t) src1 | (uintptr_t) src2) & (sizeof(T) - 1)) == 0) {
+        run_vec_bulk<T, TVec>(
+                dest,
+                count,
+                merge,
+                bulk_merge
+        );
+    } else {
+        merge_shuffle_vanilla<T>(src1, src2, dest, index, count);
+    }
+}
+#endif
+
+// 9
+void
+MULTI_VERSION_NAME (merge_shuffle_int8)(const int8_t *src1, const int8_t *src2, int8_t *dest, const index_t *index,
+                                        const int64_t count) {
+#if INSTRSET >= 8
+    merge_shuffle_gather<int8_t, Vec32c>(src1, src2, dest, index, count);
+#else
+    merge_shuffle_vanilla<int8_t>(src1, src2, dest, index, count);
+#endif
+}
+
+// 10
+void
+MULTI_VERSION_NAME (merge_shuffle_int16)(const int16_t *src1, const int16_t *src2, int16_t *dest, const index_t *index,
+                                         const int64_t count) {
+#if INSTRSET >= 8
+    merge_shuffle_gather<int16_t, Vec16s>(src1, src2, dest, index, count);
+#else
+    merge_shuffle_vanilla<int16_t>(src1, src2, dest, index, count);
+#endif
+}
+
+// 11
+void
+MULTI_VERSION_NAME (merge_shuffle_int32)(const int32_t *src1, const int32_t *src2, int32_t *dest, const index_t *index,
+                                         const int64_t count) {
+#if INSTRSET >= 8
+    merge_shuffle_gather<int32_t, Vec8i>(src1, src2, dest, index, count);
+#else
+    merge_shuffle_vanilla<int32_t>(src1, src2, dest, index, count);
+#endif
+}
+
 //17
 void MULTI_VERSION_NAME (flatten_index)(index_t *index, int64_t count) {
     Vec8q v_i = Vec8q(0, 1, 2, 3, 4, 5, 6, 7);
@@ -102,6 +102,15 @@ DECLARE_DISPATCHER_TYPE(shift_timestamp_index, const index_t *data, int64_t coun
 
 DECLARE_DISPATCHER_TYPE(flatten_index, index_t *index, int64_t count);
 
+DECLARE_DISPATCHER_TYPE(merge_shuffle_int8, const int8_t *src1, const int8_t *src2, int8_t *dest,
+                        const index_t *index, const int64_t count);
+
+DECLARE_DISPATCHER_TYPE(merge_shuffle_int16, const int16_t *src1, const int16_t *src2, int16_t *dest,
+                        const index_t *index, const int64_t count);
+
+DECLARE_DISPATCHER_TYPE(merge_shuffle_int32, const int32_t *src1, const int32_t *src2, int32_t *dest,
+                        const index_t *index, const int64_t count);
+
 DECLARE_DISPATCHER_TYPE(merge_shuffle_int64, const int64_t *src1, const int64_t *src2, int64_t *dest,
                         const index_t *index, const int64_t count);
 
@@ -121,6 +130,9 @@ DECLARE_DISPATCHER_TYPE (merge_copy_var_column_int64, index_t *merge_index, int6
                          int64_t *src_data_fix, char *src_data_var, int64_t *src_ooo_fix, char *src_ooo_var,
                          int64_t *dst_fix, char *dst_var, int64_t dst_var_offset);
 
+DECLARE_DISPATCHER_TYPE(sort_var_column_offsets, const index_t *index, const int64_t count, const int64_t *src_fix,
+                        int64_t *dst_fix);
+
 DECLARE_DISPATCHER_TYPE(platform_memcpy, void *dst, const void *src, const size_t len);
 
 DECLARE_DISPATCHER_TYPE(platform_memcmp, const void *a, const void *b, const size_t len, int *res);
@@ -154,4 +166,73 @@ inline void re_shuffle_vanilla(const T *src, T *dest, const index_t *index, cons
     };
 }
 
+// 0, 3
+// First pass of the var column merge copy, sizes of merged values go to dst_fix[1..merge_index_size].
+// A prefix sum of dst_fix then turns them into destination offsets.
+template<typename T>
+inline void merge_var_sizes(
+        const index_t *merge_index,
+        const int64_t merge_index_size,
+        int64_t *const *src_fix,
+        char *const *src_var,
+        int64_t *dst_fix,
+        const T mult
+) {
+    for (int64_t l = 0; l < merge_index_size; l++) {
+        MM_PREFETCH_T0(merge_index + l + 64);
+        const uint64_t row = merge_index[l].i;
+        const uint32_t bit = (row >> 63);
+        const uint64_t rr = row & ~(1ull << 63);
+        const auto len = *reinterpret_cast<const T *>(src_var[bit] + src_fix[bit][rr]);
+        dst_fix[l + 1] = (int64_t) sizeof(T) + (len > 0 ? len * mult : 0);
+    }
+}
+
+// Second pass of the var column merge copy. Consecutive rows of the same source, which are adjacent
+// in its var data, are copied as one run. The writer receives runs in destination order.
+template<typename W>
+inline void merge_var_runs(
+        const index_t *merge_index,
+        const int64_t merge_index_size,
+        int64_t *const *src_fix,
+        char *const *src_var,
+        const int64_t *dst_fix,
+        W &writer
+) {
+    int64_t l = 0;
+    while (l < merge_index_size) {
+        const uint64_t row = merge_index[l].i;
+        const uint32_t bit = (row >> 63);
+        const int64_t *fix = src_fix[bit];
+        const int64_t lo = fix[row & ~(1ull << 63)];
+        int64_t hi = lo + dst_fix[l + 1] - dst_fix[l];
+        uint64_t next_row = row + 1;
+        int64_t next = l + 1;
+        while (next < merge_index_size && merge_index[next].i == next_row && fix[next_row & ~(1ull << 63)] == hi) {
+            hi += dst_fix[next + 1] - dst_fix[next];
+            next_row++;
+            next++;
+        }
+        writer.put(src_var[bit] + lo, hi - lo);
+        l = next;
+    }
+    writer.finish();
+}
+
+// Writes merged var values in place with regular stores
+class var_copy_writer {
+public:
+    explicit var_copy_writer(char *dst) : dst(dst) {}
+
+    inline void put(const char *src, const int64_t size) {
+        __MEMCPY(dst, src, size);
+        dst += size;
+    }
+
+    inline void finish() {}
+
+private:
+    char *dst;
+};
+
 #endif //QUESTDB_OOO_DISPATCH_H
@@ -28,6 +28,12 @@
 #include "ooo_dispatch.h"
 #include <algorithm>
 
+// This file is built for aarch64 only, where Advanced SIMD is part of the base ISA.
+// Kernels with an __ARM_NEON block use it for the bulk of the rows and finish with scalar code.
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+
 // 24, 25
 template<int size>
 inline void set_var_refs(int64_t *addr, const int64_t offset, const int64_t count) {
@@ -39,7 +45,23 @@ inline void set_var_refs(int64_t *addr, const int64_t offset, const int64_t coun
 // 19-23
 template<typename T>
 inline void set_memory_vanilla(T *addr, const T value, const int64_t count) {
-    for (int64_t i = 0; i < count; i++) {
+    int64_t i = 0;
+#ifdef __ARM_NEON
+    constexpr int64_t lanes = 16 / sizeof(T);
+    T pattern[lanes];
+    for (int64_t j = 0; j < lanes; j++) {
+        pattern[j] = value;
+    }
+    const uint8x16_t vec = vld1q_u8(reinterpret_cast<const uint8_t *>(pattern));
+    for (; i + 4 * lanes <= count; i += 4 * lanes) {
+        auto *p = reinterpret_cast<uint8_t *>(addr + i);
+        vst1q_u8(p, vec);
+        vst1q_u8(p + 16, vec);
+        vst1q_u8(p + 32, vec);
+        vst1q_u8(p + 48, vec);
+    }
+#endif
+    for (; i < count; i++) {
         addr[i] = value;
     }
 }
@@ -65,25 +87,30 @@ inline void merge_copy_var_column(
         int64_t dst_var_offset,
         T mult
 ) {
+    if (merge_index_size < 1) {
+        return;
+    }
     int64_t *src_fix[] = {src_ooo_fix, src_data_fix};
     char *src_var[] = {src_ooo_var, src_data_var};
 
-    for (int64_t l = 0; l < merge_index_size; l++) {
-        MM_PREFETCH_T0(merge_index + l + 64);
-        dst_fix[l] = dst_var_offset;
-        const uint64_t row = merge_index[l].i;
-        const uint32_t bit = (row >> 63);
-        const uint64_t rr = row & ~(1ull << 63);
-        const int64_t offset = src_fix[bit][rr];
-        char *src_var_ptr = src_var[bit] + offset;
-        auto len = *reinterpret_cast<T *>(src_var_ptr);
-        auto char_count = len > 0 ? len * mult : 0;
-        reinterpret_cast<T *>(dst_var + dst_var_offset)[0] = len;
-        __MEMCPY(dst_var + dst_var_offset + sizeof(T), src_var_ptr + sizeof(T), char_count);
-        dst_var_offset += char_count + sizeof(T);
+    dst_fix[0] = dst_var_offset;
+    merge_var_sizes<T>(merge_index, merge_index_size, src_fix, src_var, dst_fix, mult);
+    for (int64_t l = 1; l <= merge_index_size; l++) {
+        dst_fix[l] += dst_fix[l - 1];
     }
-    if (merge_index_size > 0) {
-        dst_fix[merge_index_size] = dst_var_offset;
+
+    var_copy_writer writer(dst_var + dst_var_offset);
+    merge_var_runs(merge_index, merge_index_size, src_fix, src_var, dst_fix, writer);
+}
+
+// 1
+void sort_var_column_offsets(const index_t *index, const int64_t count, const int64_t *src_fix, int64_t *dst_fix) {
+    int64_t offset = 0;
+    for (int64_t l = 0; l < count; l++) {
+        MM_PREFETCH_T0(index + l + 64);
+        const uint64_t row = index[l].i;
+        dst_fix[l] = offset;
+        offset += src_fix[row + 1] - src_fix[row];
     }
 }
 
@@ -137,12 +164,36 @@ void merge_copy_var_column_int64(
 
 // 5
 void re_shuffle_int32(const int32_t *src, int32_t *dest, const index_t *index, const int64_t count) {
-    re_shuffle_vanilla(src, dest, index, count);
+    int64_t i = 0;
+#ifdef __ARM_NEON
+    // there is no gather, vld2q splits index pairs into timestamps and rows and values are loaded lane by lane
+    for (; i + 3 < count; i += 4) {
+        MM_PREFETCH_T0(index + i + 64);
+        const uint64x2_t rows0 = vld2q_u64(reinterpret_cast<const uint64_t *>(index + i)).val[1];
+        const uint64x2_t rows1 = vld2q_u64(reinterpret_cast<const uint64_t *>(index + i + 2)).val[1];
+        int32x4_t vec = vld1q_dup_s32(src + vgetq_lane_u64(rows0, 0));
+        vec = vld1q_lane_s32(src + vgetq_lane_u64(rows0, 1), vec, 1);
+        vec = vld1q_lane_s32(src + vgetq_lane_u64(rows1, 0), vec, 2);
+        vec = vld1q_lane_s32(src + vgetq_lane_u64(rows1, 1), vec, 3);
+        vst1q_s32(dest + i, vec);
+    }
+#endif
+    re_shuffle_vanilla(src, dest + i, index + i, count - i);
 }
 
 // 6
 void re_shuffle_int64(const int64_t *src, int64_t *dest, const index_t *index, const int64_t count) {
-    re_shuffle_vanilla(src, dest, index, count);
+    int64_t i = 0;
+#ifdef __ARM_NEON
+    for (; i + 1 < count; i += 2) {
+        MM_PREFETCH_T0(index + i + 64);
+        const uint64x2_t rows = vld2q_u64(reinterpret_cast<const uint64_t *>(index + i)).val[1];
+        int64x2_t vec = vld1q_dup_s64(src + vgetq_lane_u64(rows, 0));
+        vec = vld1q_lane_s64(src + vgetq_lane_u64(rows, 1), vec, 1);
+        vst1q_s64(dest + i, vec);
+    }
+#endif
+    re_shuffle_vanilla(src, dest + i, index + i, count - i);
 }
 
 // 30
@@ -155,10 +206,42 @@ void re_shuffle_128bit(const __int128 *src, __int128 *dest, const index_t *index
     re_shuffle_vanilla(src, dest, index, count);
 }
 
+// 9
+void merge_shuffle_int8(const int8_t *src1, const int8_t *src2, int8_t *dest, const index_t *index,
+                        const int64_t count) {
+    merge_shuffle_vanilla<int8_t>(src1, src2, dest, index, count);
+}
+
+// 10
+void merge_shuffle_int16(const int16_t *src1, const int16_t *src2, int16_t *dest, const index_t *index,
+                         const int64_t count) {
+    merge_shuffle_vanilla<int16_t>(src1, src2, dest, index, count);
+}
+
+// 11
+void merge_shuffle_int32(const int32_t *src1, const int32_t *src2, int32_t *dest, const index_t *index,
+                         const int64_t count) {
+    merge_shuffle_vanilla<int32_t>(src1, src2, dest, index, count);
+}
+
 // 12
 void merge_shuffle_int64(const int64_t *src1, const int64_t *src2, int64_t *dest, const index_t *index,
                                 const int64_t count) {
-    merge_shuffle_vanilla<int64_t>(src1, src2, dest, index, count);
+    int64_t i = 0;
+#ifdef __ARM_NEON
+    const int64_t *sources[] = {src2, src1};
+    const uint64x2_t rowMask = vdupq_n_u64(~(1ull << 63));
+    for (; i + 1 < count; i += 2) {
+        MM_PREFETCH_T0(index + i + 64);
+        const uint64x2_t r = vld2q_u64(reinterpret_cast<const uint64_t *>(index + i)).val[1];
+        const uint64x2_t pick = vshrq_n_u64(r, 63);
+        const uint64x2_t row = vandq_u64(r, rowMask);
+        int64x2_t vec = vld1q_dup_s64(sources[vgetq_lane_u64(pick, 0)] + vgetq_lane_u64(row, 0));
+        vec = vld1q_lane_s64(sources[vgetq_lane_u64(pick, 1)] + vgetq_lane_u64(row, 1), vec, 1);
+        vst1q_s64(dest + i, vec);
+    }
+#endif
+    merge_shuffle_vanilla<int64_t>(src1, src2, dest + i, index + i, count - i);
 }
 
 //17
@@ -170,7 +253,20 @@ void flatten_index(index_t *index, int64_t count) {
 
 // 18
 void make_timestamp_index(const int64_t *data, int64_t low, int64_t high, index_t *dest) {
-    for (int64_t l = low; l <= high; l++) {
+    int64_t l = low;
+#ifdef __ARM_NEON
+    // vst2q interleaves timestamps and row ids into index_t pairs
+    const uint64_t rows[] = {static_cast<uint64_t>(l) | (1ull << 63), static_cast<uint64_t>(l + 1) | (1ull << 63)};
+    uint64x2x2_t vec;
+    vec.val[1] = vld1q_u64(rows);
+    const uint64x2_t two = vdupq_n_u64(2);
+    for (; l < high; l += 2) {
+        vec.val[0] = vld1q_u64(reinterpret_cast<const uint64_t *>(data + l));
+        vst2q_u64(reinterpret_cast<uint64_t *>(dest + (l - low)), vec);
+        vec.val[1] = vaddq_u64(vec.val[1], two);
+    }
+#endif
+    for (; l <= high; l++) {
         dest[l - low].ts = data[l];
         dest[l - low].i = l | (1ull << 63);
     }
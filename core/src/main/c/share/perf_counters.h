@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <atomic>
+#include <cstdint>
+
+#if !defined(__aarch64__)
+#include <x86intrin.h>
+#endif
+
+// Counters of the native kernels are compiled in and cost a relaxed load and a branch
+// per call while disabled. Once enabled, they record calls, bytes and latency of each
+// call in CPU ticks (TSC on x86, virtual counter on ARM64).
+
+// 0-31 are O3 methods of ooo.cpp, numbered by call site
+constexpr int32_t PERF_DEDUP_MERGE_TIMESTAMP = 32;
+constexpr int32_t PERF_DEDUP_MERGE_TIMESTAMP_KEYS = 33;
+constexpr int32_t PERF_DEDUP_SORTED_TIMESTAMP_INDEX = 34;
+constexpr int32_t PERF_DEDUP_MERGE_VAR_COLUMN_LEN = 35;
+constexpr int32_t PERF_ROSTI_KEYED_COUNT = 36;
+constexpr int32_t PERF_ROSTI_KEYED_MULTI_AGG = 37;
+constexpr int32_t PERF_ROSTI_KEYED_DENSE_MULTI_AGG = 38;
+constexpr int32_t PERF_ROSTI_COMPLETE_RESIZE = 39;
+constexpr int32_t PERF_VEC_AGG_DOUBLE = 40;
+constexpr int32_t PERF_VEC_AGG_FLOAT = 41;
+constexpr int32_t PERF_VEC_AGG_SHORT = 42;
+constexpr int32_t PERF_VEC_AGG_BYTE = 43;
+constexpr int32_t PERF_VEC_AGG_CHAR = 44;
+constexpr int32_t PERF_VEC_AGG_INT = 45;
+constexpr int32_t PERF_VEC_AGG_LONG = 46;
+constexpr int32_t PERF_JIT_COMPILE = 47;
+constexpr int32_t PERF_JIT_CALL = 48;
+constexpr int32_t PERF_VEC_AGG_LONG128 = 49;
+constexpr int32_t PERF_ROSTI_KEYED_AGG = 50;
+constexpr int32_t PERF_ROSTI_KEYED_DENSE_AGG = 51;
+constexpr int32_t PERF_ROSTI_KEYED_MERGE = 52;
+constexpr int32_t PERF_ROSTI_KEYED_WRAP_UP = 53;
+constexpr int32_t PERF_COUNTER_COUNT = 64;
+
+// bucket b counts calls shorter than 2^(12 + 2b) ticks, the last one counts the rest
+constexpr int32_t PERF_COUNTER_BUCKET_COUNT = 16;
+
+typedef struct alignas(64) {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> ticks;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> buckets[PERF_COUNTER_BUCKET_COUNT];
+} perf_counter_t;
+
+extern std::atomic<bool> perf_counters_enabled;
+extern perf_counter_t perf_counters[PERF_COUNTER_COUNT];
+
+inline uint64_t perf_ticks() {
+#if defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return __rdtsc();
+#endif
+}
+
+inline int32_t perf_counter_bucket(uint64_t ticks) {
+    const int32_t log2 = 63 - __builtin_clzll(ticks | 1);
+    if (log2 < 12) {
+        return 0;
+    }
+    const int32_t bucket = (log2 - 10) >> 1;
+    return bucket < PERF_COUNTER_BUCKET_COUNT ? bucket : PERF_COUNTER_BUCKET_COUNT - 1;
+}
+
+inline void perf_counter_record(int32_t index, uint64_t ticks, int64_t bytes) {
+    auto &counter = perf_counters[index];
+    counter.calls.fetch_add(1, std::memory_order_relaxed);
+    counter.ticks.fetch_add(ticks, std::memory_order_relaxed);
+    counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    counter.buckets[perf_counter_bucket(ticks)].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Records the call the scope spans when the counters are enabled at the start of the call
+class perf_counter_scope {
+public:
+    perf_counter_scope(int32_t index, int64_t bytes)
+            : index_(index), bytes_(bytes),
+              start_(perf_counters_enabled.load(std::memory_order_relaxed) ? perf_ticks() : 0) {
+    }
+
+    ~perf_counter_scope() {
+        if (start_ != 0) {
+            perf_counter_record(index_, perf_ticks() - start_, bytes_);
+        }
+    }
+
+    perf_counter_scope(const perf_counter_scope &) = delete;
+
+    perf_counter_scope &operator=(const perf_counter_scope &) = delete;
+
+private:
+    const int32_t index_;
+    const int64_t bytes_;
+    const uint64_t start_;
+};
+
+template<typename T>
+inline decltype(auto) measure_time(int32_t index, int64_t bytes, T func) {
+    perf_counter_scope scope(index, bytes);
+    return func();
+}
+
+#endif //PERF_COUNTERS_H
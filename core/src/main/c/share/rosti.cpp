@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "rosti.h"
+#include "perf_counters.h"
 #include <jni.h>
 
 //following variable and functions were added to make rosti OOM-testable
@@ -59,15 +60,20 @@ rosti_t *alloc_rosti(const int32_t *column_types, const int32_t column_count, co
             case 5: // INT
             case 9: // FLOAT
             case 12: // SYMBOL - store as INT
+            case 25: // IPv4
                 slot_key_size += 4;
                 break;
             case 6: // LONG (64 bit)
             case 7: // DATE
             case 8: // TIMESTAMP
             case 10: // DOUBLE
-            case 11: // STRING - store reference only
                 slot_key_size += 8;
                 break;
+            case 11: // STRING - hash, length and offset of chars in the key heap, see str_slot_t
+            case 19: // UUID
+            case 24: // LONG128
+                slot_key_size += 16;
+                break;
             case 13: // LONG256
                 slot_key_size += 32;
                 break;
@@ -85,8 +91,26 @@ rosti_t *alloc_rosti(const int32_t *column_types, const int32_t column_count, co
     map->capacity_ = map_capacity;
     map->size_ = 0;
     map->value_offsets_ = value_offsets;
+    map->old_arena_ = nullptr;
+    map->old_ctrl_ = nullptr;
+    map->old_slots_ = nullptr;
+    map->old_capacity_ = 0;
+    map->migrated_ = 0;
+    map->hash_m_ = nullptr;
+    map->key_heap_ = nullptr;
+    map->key_heap_size_ = 0;
+    map->key_heap_capacity_ = 0;
+    map->str_keys_ = column_count > 0 && column_types[0] == 11;
+    map->run_ = false;
 
     if (initialize_slots(&map)) {
+        if (column_count > 0 && column_types[0] == 11) {
+            // null STRING key, wrap-up functions look it up by the key of initial values
+            auto null_key = reinterpret_cast<str_slot_t *>(map->slot_initial_values_);
+            null_key->hash = STR_NULL_HASH;
+            null_key->len = -1;
+            null_key->offset = 0;
+        }
         return map;
     }
 
@@ -94,6 +118,93 @@ rosti_t *alloc_rosti(const int32_t *column_types, const int32_t column_count, co
     return nullptr;
 }
 
+// Keys are partitioned by a hash of the bytes of the key column rather than by the hash of the map,
+// which depends on the map arena. Slots of the same key land in the same partition for every map of
+// the same structure. Null key is the key of the initial values slot. Partition of a spill run is
+// split further by the hash bits above those that picked the run, "shift" skips them. Maps of STRING
+// keys are neither split nor spilled, their slots refer to the key heap of the map.
+
+static uint64_t partition_hash(const rosti_t *map, const unsigned char *slot) {
+    const auto key_size = static_cast<uint64_t>(map->value_offsets_[1]);
+    uint64_t h = key_size;
+    for (uint64_t i = 0; i < key_size; i += sizeof(uint64_t)) {
+        uint64_t v = 0;
+        memcpy(&v, slot + i, std::min<uint64_t>(sizeof(uint64_t), key_size - i));
+        h = hashLong(h ^ v);
+    }
+    return h;
+}
+
+static inline uint64_t partition_of(const rosti_t *map, const unsigned char *slot, uint64_t mask, uint32_t shift) {
+    return (partition_hash(map, slot) >> (32u + shift)) & mask;
+}
+
+static inline bool is_null_key(const rosti_t *map, const unsigned char *slot) {
+    return memcmp(slot, map->slot_initial_values_, map->value_offsets_[1]) == 0;
+}
+
+// copies full slots to the maps of their partitions, keys are unique in the source map
+template<typename K>
+static bool split(rosti_t *map, rosti_t **partitions, uint64_t mask) {
+    assert(!map->str_keys_ && "map cannot be split");
+    complete_resize(map);
+    for (uint64_t i = 0; i < map->capacity_; i++) {
+        if (IsFull(map->ctrl_[i])) {
+            const auto slot = map->slots_ + (i << map->slot_size_shift_);
+            auto dest_map = partitions[partition_of(map, slot, mask, 0)];
+            auto res = find(dest_map, *reinterpret_cast<const K *>(slot));
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return false;
+            }
+            memcpy(dest_map->slots_ + res.first, slot, map->slot_size_);
+        }
+    }
+    return true;
+}
+
+// View over slots spilled to disk, shaped as a map for merge functions and cursors to iterate.
+// It is not a hash table: capacity is the slot count and every slot is full, so the run is flagged
+// and probe(), clear() and reset() reject it. Initial values are copied, the map may be merged into
+// and grow, which moves its arena along with its initial values, while the run is still open.
+static rosti_t *alloc_run(const rosti_t *map, unsigned char *slots, uint64_t count) {
+    assert(!map->run_ && !map->str_keys_);
+    auto run = reinterpret_cast<rosti_t *>(rosti_malloc(sizeof(rosti_t)));
+    if (run == nullptr) {
+        return nullptr;
+    }
+    // initial values, followed by control bytes, every slot is full and control bytes are never probed
+    auto mem = reinterpret_cast<unsigned char *>(rosti_malloc(map->slot_size_ + count + 1));
+    if (mem == nullptr) {
+        free(run);
+        return nullptr;
+    }
+    memcpy(mem, map->slot_initial_values_, map->slot_size_);
+    auto ctrl = reinterpret_cast<ctrl_t *>(mem + map->slot_size_);
+    memset(ctrl, 0, count);
+    ctrl[count] = kSentinel;
+    run->ctrl_ = ctrl;
+    run->slots_ = slots;
+    run->size_ = count;
+    run->capacity_ = count;
+    run->slot_size_ = map->slot_size_;
+    run->slot_size_shift_ = map->slot_size_shift_;
+    run->growth_left_ = 0;
+    run->value_offsets_ = map->value_offsets_;
+    run->slot_initial_values_ = mem;
+    run->old_arena_ = nullptr;
+    run->old_ctrl_ = nullptr;
+    run->old_slots_ = nullptr;
+    run->old_capacity_ = 0;
+    run->migrated_ = 0;
+    run->hash_m_ = nullptr;
+    run->key_heap_ = nullptr;
+    run->key_heap_size_ = 0;
+    run->key_heap_capacity_ = 0;
+    run->str_keys_ = false;
+    run->run_ = true;
+    return run;
+}
+
 extern "C" {
 
 JNIEXPORT jlong JNICALL
@@ -104,6 +215,8 @@ Java_io_questdb_std_Rosti_alloc(JNIEnv *env, jclass cl, jlong pKeyTypes, jint ke
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Rosti_free0(JNIEnv *env, jclass cl, jlong pRosti) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
+    free_old_arena(map);
+    free_key_heap(map);
     // initial values contains main arena pointer
     free(map->slot_initial_values_);
     free(map->value_offsets_);
@@ -111,10 +224,21 @@ Java_io_questdb_std_Rosti_free0(JNIEnv *env, jclass cl, jlong pRosti) {
 }
 
 JNIEXPORT void JNICALL
-Java_io_questdb_std_Rosti_clear(JNIEnv *env, jclass cl, jlong pRosti) {
+Java_io_questdb_std_Rosti_clear0(JNIEnv *env, jclass cl, jlong pRosti) {
     clear(reinterpret_cast<rosti_t *>(pRosti));
 }
 
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Rosti_completeResize0(JNIEnv *env, jclass cl, jlong pRosti) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    if (map->old_arena_ != nullptr) {
+        // counted only when slots are left to migrate
+        measure_time(PERF_ROSTI_COMPLETE_RESIZE, (int64_t) (map->old_capacity_ << map->slot_size_shift_), [=]() {
+            complete_resize(map);
+        });
+    }
+}
+
 JNIEXPORT jboolean JNICALL
 Java_io_questdb_std_Rosti_reset0(JNIEnv *env, jclass cl, jlong pRosti, jint newCapacity) {
     return reset(reinterpret_cast<rosti_t *>(pRosti), (int)newCapacity);
@@ -125,6 +249,91 @@ Java_io_questdb_std_Rosti_getAllocMemory(JNIEnv *env, jclass cl, jlong pRosti) {
     return memorySize(reinterpret_cast<rosti_t *>(pRosti));
 }
 
+// address of chars of STRING keys, slot of the key holds their offset in 4-byte words
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Rosti_getKeyHeap(JNIEnv *env, jclass cl, jlong pRosti) {
+    return reinterpret_cast<jlong>(reinterpret_cast<rosti_t *>(pRosti)->key_heap_);
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Rosti_spillCounts(JNIEnv *env, jclass cl, jlong pRosti, jint partitionCount, jint partitionShift,
+                                      jlong pCounts, jboolean skipNullKey) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    auto counts = reinterpret_cast<jlong *>(pCounts);
+    const uint64_t mask = partitionCount - 1;
+    assert(!map->str_keys_ && "map cannot be spilled");
+    complete_resize(map);
+    memset(counts, 0, sizeof(jlong) * partitionCount);
+    jlong total = 0;
+    for (uint64_t i = 0; i < map->capacity_; i++) {
+        if (IsFull(map->ctrl_[i])) {
+            const auto slot = map->slots_ + (i << map->slot_size_shift_);
+            if (skipNullKey && is_null_key(map, slot)) {
+                continue;
+            }
+            counts[partition_of(map, slot, mask, partitionShift)]++;
+            total++;
+        }
+    }
+    return total;
+}
+
+// copies full slots to partition addresses, sized by spillCounts()
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Rosti_spillCopy(JNIEnv *env, jclass cl, jlong pRosti, jint partitionCount, jint partitionShift,
+                                    jlong pDests, jboolean skipNullKey) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    auto dests = reinterpret_cast<unsigned char **>(pDests);
+    const uint64_t mask = partitionCount - 1;
+    assert(!map->str_keys_ && "map cannot be spilled");
+    const uint64_t slot_size = map->slot_size_;
+    complete_resize(map);
+    for (uint64_t i = 0; i < map->capacity_; i++) {
+        if (IsFull(map->ctrl_[i])) {
+            const auto slot = map->slots_ + (i << map->slot_size_shift_);
+            if (skipNullKey && is_null_key(map, slot)) {
+                continue;
+            }
+            auto &dest = dests[partition_of(map, slot, mask, partitionShift)];
+            memcpy(dest, slot, slot_size);
+            dest += slot_size;
+        }
+    }
+}
+
+// STRING key maps cannot be spilled, runs are spilled again when their partition is split further
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_isSpillable(JNIEnv *env, jclass cl, jlong pRosti) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    return !map->str_keys_;
+}
+
+JNIEXPORT jint JNICALL
+Java_io_questdb_std_Rosti_spillNullKeyPartition(JNIEnv *env, jclass cl, jlong pRosti, jint partitionCount,
+                                                jint partitionShift) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    return (jint) partition_of(map, map->slot_initial_values_, partitionCount - 1, partitionShift);
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Rosti_allocRun0(JNIEnv *env, jclass cl, jlong pRosti, jlong pSlots, jlong count) {
+    return reinterpret_cast<jlong>(alloc_run(
+            reinterpret_cast<rosti_t *>(pRosti),
+            reinterpret_cast<unsigned char *>(pSlots),
+            count
+    ));
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Rosti_freeRun0(JNIEnv *env, jclass cl, jlong pRun) {
+    auto run = reinterpret_cast<rosti_t *>(pRun);
+    assert(run->run_);
+    // slots and value offsets belong to the file and the map the run was made for,
+    // control bytes share the allocation of initial values
+    free(run->slot_initial_values_);
+    free(run);
+}
+
 JNIEXPORT void JNICALL
 Java_io_questdb_std_Rosti_enableOOMOnMalloc(JNIEnv *env, jclass cl) {
     ROSTI_TRIGGER_OOM = 1;
@@ -140,5 +349,41 @@ Java_io_questdb_std_Rosti_isOOMOnMalloc(JNIEnv *env, jclass cl) {
     return ROSTI_TRIGGER_OOM == 1;
 }
 
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_split(JNIEnv *env, jclass cl, jlong pRosti, jlong pPartitions, jint partitionCount) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    auto partitions = reinterpret_cast<rosti_t **>(pPartitions);
+    const uint64_t mask = partitionCount - 1;
+    switch (map->value_offsets_[1]) {
+        case sizeof(int32_t):
+            return split<int32_t>(map, partitions, mask);
+        case sizeof(int64_t):
+            return split<int64_t>(map, partitions, mask);
+        default:
+            return split<key128_t>(map, partitions, mask);
+    }
+}
+
+JNIEXPORT jint JNICALL
+Java_io_questdb_std_Rosti_getNullKeyPartition(JNIEnv *env, jclass cl, jlong pRosti, jint partitionCount) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    return (jint) partition_of(map, map->slot_initial_values_, partitionCount - 1, 0);
+}
+
+// deletes slot of the null key, wrap up functions add it to every partition map while only one of them owns it
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_removeNullKey(JNIEnv *env, jclass cl, jlong pRosti) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    assert(!map->run_ && !map->str_keys_);
+    complete_resize(map);
+    for (uint64_t i = 0; i < map->capacity_; i++) {
+        if (IsFull(map->ctrl_[i]) && is_null_key(map, map->slots_ + (i << map->slot_size_shift_))) {
+            set_ctrl(map, i, kDeleted);
+            --map->size_;
+            return true;
+        }
+    }
+    return false;
 }
 
+}
@@ -26,6 +26,7 @@
 #define ROSTI_H
 
 #include <utility>
+#include <cassert>
 #include <cstring>
 #include <cstdint>
 #include <algorithm>
@@ -99,6 +100,22 @@ struct rosti_t {
     uint64_t growth_left_ = 0;
     int32_t *value_offsets_ = nullptr;
     unsigned char *slot_initial_values_ = nullptr; // contains pointer to memory arena
+    // fields below are not accessed from Java
+    // arena of incremental resize that is still being migrated, null when there is none
+    unsigned char *old_arena_ = nullptr;
+    ctrl_t *old_ctrl_ = nullptr;
+    unsigned char *old_slots_ = nullptr;
+    uint64_t old_capacity_ = 0;
+    uint64_t migrated_ = 0;              // old slots below this index have been migrated
+    uint64_t (*hash_m_)(void *) = nullptr; // slot hash of the migrating map
+    // chars of STRING keys, slots refer to their key by offset into the heap
+    unsigned char *key_heap_ = nullptr;
+    uint64_t key_heap_size_ = 0;
+    uint64_t key_heap_capacity_ = 0;
+    bool str_keys_ = false;              // slots of STRING keys refer to the key heap, map cannot be spilled
+    // slots spilled to disk, shaped as a map only to be iterated and merged from, see alloc_run(),
+    // capacity is the slot count and every slot is full, so a run must never be probed or inserted into
+    bool run_ = false;
 };
 
 // An abstraction over a bitmask. It provides an easy way to iterate through the
@@ -188,6 +205,13 @@ struct GroupPortableImpl {
 };
 using Group = GroupPortableImpl;
 #else
+// Groups are 16 bytes wide on AVX2 and AVX-512 CPUs too. Lookups over 32 and 64-byte groups,
+// picked at load time, were slower than 16-wide triangular probing even close to the 7/8 load
+// factor: wide groups need linear probing to agree with inserts on where keys go, and lose
+// more to clustering than they save in probes. Keys spread evenly enough for the first group
+// to resolve most lookups. Measured with RostiProbeBenchmark (benchmarks module): load time
+// dispatch was 20-100% slower, compile time 32-byte groups 15-40% slower up to 1M keys and
+// within noise above that. Wide groups are not pursued.
 struct GroupSse2Impl {
 
     explicit GroupSse2Impl(const ctrl_t *pos) {
@@ -282,19 +306,25 @@ private:
 };
 
 inline probe_seq<sizeof(Group)> probe(const rosti_t *map, uint64_t hash) {
+    assert(!map->run_ && "spill run cannot be probed");
     return probe_seq<sizeof(Group)>(H1(hash, map->ctrl_), map->capacity_);
 }
 
+// Control bytes of all slots, the sentinel and a copy of the first group for probes
+// that wrap around the end, rounded up to keep slots that follow cache line aligned.
+inline uint64_t ctrl_size(uint64_t capacity) {
+    return (capacity + 1 + sizeof(Group) + 63) & ~63ull;
+}
+
 // Reset all ctrl bytes back to kEmpty, except the sentinel.
 inline void reset_ctrl(rosti_t *map) {
-    const uint64_t ctrl_capacity = 2 * sizeof(Group) * (map->capacity_ + 1);
-    memset(map->ctrl_, kEmpty, ctrl_capacity);
+    memset(map->ctrl_, kEmpty, ctrl_size(map->capacity_));
     map->ctrl_[map->capacity_] = kSentinel;
 }
 
 bool initialize_slots(rosti_t **ppMap) {
     rosti_t *map = *ppMap;
-    const uint64_t ctrl_capacity = 2 * sizeof(Group) * (map->capacity_ + 1);
+    const uint64_t ctrl_capacity = ctrl_size(map->capacity_);
     auto *mem = reinterpret_cast<unsigned char *>(rosti_malloc(
             map->slot_size_ +
             ctrl_capacity +
@@ -310,20 +340,41 @@ bool initialize_slots(rosti_t **ppMap) {
     return true;
 }
 
+// Releases the arena left behind by incremental resize, the remaining slots are dropped.
+inline void free_old_arena(rosti_t *map) {
+    if (map->old_arena_) {
+        free(map->old_arena_);
+        map->old_arena_ = nullptr;
+        map->old_ctrl_ = nullptr;
+        map->old_slots_ = nullptr;
+        map->old_capacity_ = 0;
+        map->migrated_ = 0;
+    }
+}
+
 inline void clear(rosti_t *map) {
+    assert(!map->run_ && "spill run cannot be cleared");
+    free_old_arena(map);
     map->size_ = 0;
+    map->key_heap_size_ = 0;
     reset_ctrl(map);
     reset_growth_left(map);
     memset(map->slots_, 0, map->capacity_ << map->slot_size_shift_);
 }
 
-//returns amount of memory allocated to this rosti instance
+inline int64_t arenaSize(uint64_t slot_size, uint64_t capacity) {
+    return (int64_t) (slot_size +
+                      ctrl_size(capacity) +
+                      slot_size * (capacity + 1));
+}
+
+//returns amount of memory allocated to this rosti instance, including the arena being migrated
 inline int64_t memorySize(rosti_t *map) {
-    return (int64_t)(sizeof(rosti_t) +
-           sizeof(int32_t) * 1 + //inexact because we don't have count of columns
-           map->slot_size_ +
-           2 * sizeof(Group) * (map->capacity_ + 1) +
-           map->slot_size_ * (map->capacity_ + 1));
+    return (int64_t) (sizeof(rosti_t) +
+                      sizeof(int32_t) * 1) + //inexact because we don't have count of columns
+           arenaSize(map->slot_size_, map->capacity_) +
+           (map->old_arena_ ? arenaSize(map->slot_size_, map->old_capacity_) : 0) +
+           (int64_t) map->key_heap_capacity_;
 }
 
 inline bool IsEmpty(ctrl_t c) { return c == kEmpty; }
@@ -334,11 +385,15 @@ inline bool IsDeleted(ctrl_t c) { return c == kDeleted; }
 
 inline bool IsEmptyOrDeleted(ctrl_t c) { return c < kSentinel; }
 
-inline void set_ctrl(rosti_t *map, uint64_t i, ctrl_t h) {
+inline void set_ctrl(ctrl_t *ctrl, uint64_t capacity, uint64_t i, ctrl_t h) {
     constexpr uint32_t group_size = sizeof(Group);
-    const int32_t p = ((i - group_size) & map->capacity_) + 1 + ((group_size - 1) & map->capacity_);
-    map->ctrl_[i] = h;
-    map->ctrl_[p] = h;
+    const int32_t p = ((i - group_size) & capacity) + 1 + ((group_size - 1) & capacity);
+    ctrl[i] = h;
+    ctrl[p] = h;
+}
+
+inline void set_ctrl(rosti_t *map, uint64_t i, ctrl_t h) {
+    set_ctrl(map->ctrl_, map->capacity_, i, h);
 }
 
 // Probes the raw_hash_set with the probe sequence for hash and returns the
@@ -401,11 +456,84 @@ bool resize(rosti_t *map, uint64_t new_capacity, HASH_M hash_m, CPY cpy) {
     return false;
 }
 
+// Incremental resize. Large maps do not rehash all slots at once, that would stall the insert
+// for as long as it takes to walk the whole arena. Instead, the new arena takes over inserts and
+// the old one is kept around while its slots are migrated, ROSTI_MIGRATE_SLOTS per insert. A key
+// found in the old arena is migrated on the spot, so every key lives in exactly one of the arenas.
+// Growth of the new arena is reserved for all keys upfront, migration never triggers a resize.
+// Slots must not be iterated before complete_resize().
+constexpr uint64_t ROSTI_INCREMENTAL_RESIZE_MIN_CAPACITY = 1024 * 1024 - 1;
+constexpr uint64_t ROSTI_MIGRATE_SLOTS = 2 * sizeof(Group);
+
+// moves old slot "i" to the new arena, returns offset of the new slot
+inline uint64_t migrate_slot(rosti_t *map, uint64_t i) {
+    auto p = map->old_slots_ + (i << map->slot_size_shift_);
+    const uint64_t hash = map->hash_m_(p);
+    const uint64_t offset = find_first_non_full(map, hash).offset;
+    set_ctrl(map, offset, H2(hash));
+    set_ctrl(map->old_ctrl_, map->old_capacity_, i, kDeleted);
+    memcpy(map->slots_ + (offset << map->slot_size_shift_), p, map->slot_size_);
+    return offset << map->slot_size_shift_;
+}
+
+inline void migrate_slots(rosti_t *map, uint64_t n) {
+    const uint64_t hi = std::min(map->migrated_ + n, map->old_capacity_);
+    for (uint64_t i = map->migrated_; i < hi; i++) {
+        if (IsFull(map->old_ctrl_[i])) {
+            migrate_slot(map, i);
+        }
+    }
+    map->migrated_ = hi;
+    if (hi == map->old_capacity_) {
+        free_old_arena(map);
+    }
+}
+
+// migrates what is left of the old arena, must be called before map slots are iterated
+inline void complete_resize(rosti_t *map) {
+    if (PREDICT_FALSE(map->old_arena_ != nullptr)) {
+        migrate_slots(map, map->old_capacity_);
+    }
+}
+
+template<typename HASH_M>
+bool resize_incrementally(rosti_t *map, uint64_t new_capacity, HASH_M hash_m) {
+    auto *old_init = map->slot_initial_values_;
+    auto *old_ctrl = map->ctrl_;
+    auto *old_slots = map->slots_;
+    const uint64_t old_capacity = map->capacity_;
+    map->capacity_ = new_capacity;
+    if (initialize_slots(&map)) {
+        memcpy(map->slot_initial_values_, old_init, map->slot_size_);
+        map->old_arena_ = old_init;
+        map->old_ctrl_ = old_ctrl;
+        map->old_slots_ = old_slots;
+        map->old_capacity_ = old_capacity;
+        map->migrated_ = 0;
+        map->hash_m_ = hash_m;
+        return true;
+    }
+    map->capacity_ = old_capacity;
+    return false;
+}
+
+template<typename HASH_M_T, typename CPY_T>
+bool grow(rosti_t *map, HASH_M_T hash_f, CPY_T cpy_f) {
+    complete_resize(map);
+    if (map->capacity_ >= ROSTI_INCREMENTAL_RESIZE_MIN_CAPACITY) {
+        return resize_incrementally(map, map->capacity_ * 2 + 1, hash_f);
+    }
+    return resize(map, map->capacity_ * 2 + 1, hash_f, cpy_f);
+}
+
 template<typename HASH_M_T, typename CPY_T>
 ATTRIBUTE_NEVER_INLINE uint64_t prepare_insert(rosti_t *map, uint64_t hash, HASH_M_T hash_f, CPY_T cpy_f) {
+    if (PREDICT_FALSE(map->old_arena_ != nullptr)) {
+        migrate_slots(map, ROSTI_MIGRATE_SLOTS);
+    }
     auto target = find_first_non_full(map, hash);
     if (PREDICT_FALSE(map->growth_left_ == 0 && !IsDeleted(map->ctrl_[target.offset]))) {
-        if (!resize(map, map->capacity_ * 2 + 1, hash_f, cpy_f)) {
+        if (!grow(map, hash_f, cpy_f)) {
             return UL_MAX;
         }
         target = find_first_non_full(map, hash);
@@ -420,12 +548,38 @@ ATTRIBUTE_NEVER_INLINE uint64_t prepare_insert(rosti_t *map, uint64_t hash, HASH
     return offset;
 }
 
-template<typename T, typename HASH_T, typename EQ_T, typename HAS_M_T, typename CPY_T>
-inline std::pair<uint64_t, bool> find_or_prepare_insert(
-        rosti_t *map, const T key, HASH_T hash_f, EQ_T eq_f,
+// Lookup of the key missing from the new arena while incremental resize is in progress.
+template<typename T, typename EQ_T, typename HAS_M_T, typename CPY_T>
+ATTRIBUTE_NEVER_INLINE std::pair<uint64_t, bool> find_or_migrate(
+        rosti_t *map, const T key, const uint64_t hash, EQ_T eq_f,
+        HAS_M_T hash_m_f, CPY_T cpy_f
+) {
+    auto seq = probe_seq<sizeof(Group)>(H1(hash, map->old_ctrl_), map->old_capacity_);
+    while (true) {
+        Group g{map->old_ctrl_ + seq.offset()};
+        for (int i : g.Match(H2(hash))) {
+            const uint64_t index = seq.offset(i);
+            if (eq_f(map->old_slots_ + (index << map->slot_size_shift_), key)) {
+                const uint64_t offset = migrate_slot(map, index);
+                migrate_slots(map, ROSTI_MIGRATE_SLOTS);
+                return {offset, false};
+            }
+        }
+        if (g.MatchEmpty()) {
+            break;
+        }
+        seq.next();
+    }
+    return {prepare_insert(map, hash, hash_m_f, cpy_f), true};
+}
+
+// Lookup with the hash computed upfront, lets batched callers hash and prefetch
+// a block of keys before resolving them, see prefetch_probe().
+template<typename T, typename EQ_T, typename HAS_M_T, typename CPY_T>
+inline std::pair<uint64_t, bool> find_or_prepare_insert_hashed(
+        rosti_t *map, const T key, const uint64_t hash, EQ_T eq_f,
         HAS_M_T hash_m_f, CPY_T cpy_f
 ) {
-    auto hash = hash_f(key);
     auto seq = probe(map, hash);
     while (true) {
         Group g{map->ctrl_ + seq.offset()};
@@ -440,9 +594,29 @@ inline std::pair<uint64_t, bool> find_or_prepare_insert(
         }
         seq.next();
     }
+    if (PREDICT_FALSE(map->old_arena_ != nullptr)) {
+        return find_or_migrate(map, key, hash, eq_f, hash_m_f, cpy_f);
+    }
     return {prepare_insert(map, hash, hash_m_f, cpy_f), true};
 }
 
+template<typename T, typename HASH_T, typename EQ_T, typename HAS_M_T, typename CPY_T>
+inline std::pair<uint64_t, bool> find_or_prepare_insert(
+        rosti_t *map, const T key, HASH_T hash_f, EQ_T eq_f,
+        HAS_M_T hash_m_f, CPY_T cpy_f
+) {
+    return find_or_prepare_insert_hashed(map, key, hash_f(key), eq_f, hash_m_f, cpy_f);
+}
+
+// Brings in the first control group and slot the hash probes, so that the lookup
+// of the key some rows later does not stall on a cache miss. Maps larger than L2
+// spend most of their time waiting on these two lines.
+inline void prefetch_probe(const rosti_t *map, const uint64_t hash) {
+    const uint64_t offset = probe(map, hash).offset();
+    MM_PREFETCH_T0(map->ctrl_ + offset);
+    MM_PREFETCH_T0(map->slots_ + (offset << map->slot_size_shift_));
+}
+
 inline uint64_t hashInt(uint32_t v) {
     uint64_t h = v;
     h = (h << 5u) - h + ((unsigned char) (v >> 8u));
@@ -471,9 +645,220 @@ inline std::pair<uint64_t, bool> find(rosti_t *map, const int32_t key) {
     return find_or_prepare_insert<int32_t>(map, key, hashInt, eqInt, hashIntMem, cpySlot);
 }
 
+inline uint64_t hash_of(const int32_t key) {
+    return hashInt(key);
+}
+
+inline std::pair<uint64_t, bool> find(rosti_t *map, const int32_t key, const uint64_t hash) {
+    return find_or_prepare_insert_hashed<int32_t>(map, key, hash, eqInt, hashIntMem, cpySlot);
+}
+
+// 64-bit finalizer from MurmurHash3, both H1 and H2 need well mixed bits
+inline uint64_t hashLong(uint64_t v) {
+    v ^= v >> 33u;
+    v *= 0xff51afd7ed558ccdULL;
+    v ^= v >> 33u;
+    v *= 0xc4ceb9fe1a85ec53ULL;
+    v ^= v >> 33u;
+    return v;
+}
+
+// long equivalence
+inline bool eqLong(void *p, int64_t key) {
+    return *reinterpret_cast<int64_t *>(p) == key;
+}
+
+// long pointer hash
+inline uint64_t hashLongMem(void *p) {
+    return hashLong(*reinterpret_cast<uint64_t *>(p));
+}
+
+// long key lookup, also used for pairs of INT/SYMBOL keys packed into 64 bits
+inline std::pair<uint64_t, bool> find(rosti_t *map, const int64_t key) {
+    return find_or_prepare_insert<int64_t>(map, key, hashLong, eqLong, hashLongMem, cpySlot);
+}
+
+inline uint64_t hash_of(const int64_t key) {
+    return hashLong(key);
+}
+
+inline std::pair<uint64_t, bool> find(rosti_t *map, const int64_t key, const uint64_t hash) {
+    return find_or_prepare_insert_hashed<int64_t>(map, key, hash, eqLong, hashLongMem, cpySlot);
+}
+
+// 128-bit key, UUID, LONG128 or pair of LONG keys
+struct key128_t {
+    uint64_t lo;
+    uint64_t hi;
+};
+
+inline uint64_t hashLong128(key128_t key) {
+    return hashLong(key.lo ^ hashLong(key.hi));
+}
+
+inline bool eqLong128(void *p, key128_t key) {
+    const auto *k = reinterpret_cast<key128_t *>(p);
+    return k->lo == key.lo && k->hi == key.hi;
+}
+
+inline uint64_t hashLong128Mem(void *p) {
+    return hashLong128(*reinterpret_cast<key128_t *>(p));
+}
+
+// 128-bit key lookup
+inline std::pair<uint64_t, bool> find(rosti_t *map, const key128_t key) {
+    return find_or_prepare_insert<key128_t>(map, key, hashLong128, eqLong128, hashLong128Mem, cpySlot);
+}
+
+inline uint64_t hash_of(const key128_t key) {
+    return hashLong128(key);
+}
+
+inline std::pair<uint64_t, bool> find(rosti_t *map, const key128_t key, const uint64_t hash) {
+    return find_or_prepare_insert_hashed<key128_t>(map, key, hash, eqLong128, hashLong128Mem, cpySlot);
+}
+
+// STRING key as read from the column, "len" is in chars, -1 for null
+struct str_key_t {
+    uint64_t hash;
+    int32_t len;
+    const uint16_t *chars;
+};
+
+// Slot of STRING key. Chars are appended to the key heap of the map on insert, slot keeps
+// their offset next to the hash, so that probing compares chars only when hashes match.
+struct str_slot_t {
+    uint64_t hash;
+    int32_t len;
+    uint32_t offset; // in 4-byte words, heap of the map is limited to 16GB
+};
+
+constexpr uint64_t STR_NULL_HASH = 0x6a09e667f3bcc908ULL;
+constexpr uint64_t STR_KEY_HEAP_MIN_CAPACITY = 4096;
+constexpr uint64_t STR_KEY_HEAP_MAX_CAPACITY = (uint64_t) UINT32_MAX << 2u;
+
+inline uint64_t rotl64(uint64_t v, uint32_t r) {
+    return (v << r) | (v >> (64u - r));
+}
+
+inline uint64_t load64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Hashes UTF-16 chars 16 bytes at a time, in two independent lanes. Lanes keep multiplies
+// of one step apart from each other, long keys hash at the rate of two multiplies in flight.
+// 64-bit lane multiply is not there before AVX-512, wide registers would not make this faster.
+inline uint64_t hashStr(const uint16_t *chars, int32_t len) {
+    if (len < 0) {
+        return STR_NULL_HASH;
+    }
+    const auto *p = reinterpret_cast<const unsigned char *>(chars);
+    const auto size = static_cast<uint64_t>(len) * sizeof(uint16_t);
+    uint64_t h0 = size;
+    uint64_t h1 = 0x9e3779b97f4a7c15ULL;
+    uint64_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        h0 = rotl64((h0 ^ load64(p + i)) * 0xff51afd7ed558ccdULL, 31);
+        h1 = rotl64((h1 ^ load64(p + i + 8)) * 0xc4ceb9fe1a85ec53ULL, 29);
+    }
+    if (i < size) {
+        uint64_t tail[2] = {0, 0};
+        memcpy(tail, p + i, size - i);
+        h0 = rotl64((h0 ^ tail[0]) * 0xff51afd7ed558ccdULL, 31);
+        h1 = rotl64((h1 ^ tail[1]) * 0xc4ceb9fe1a85ec53ULL, 29);
+    }
+    return hashLong(h0 ^ rotl64(h1, 32));
+}
+
+// Grows the key heap to fit "size" more bytes. Heap is kept by clear(), keys of the next
+// round of aggregation reuse it.
+inline bool reserve_key_heap(rosti_t *map, uint64_t size) {
+    const uint64_t required = map->key_heap_size_ + size;
+    if (PREDICT_TRUE(required <= map->key_heap_capacity_)) {
+        return true;
+    }
+    if (required > STR_KEY_HEAP_MAX_CAPACITY) {
+        return false;
+    }
+    const uint64_t capacity = std::min(
+            std::max(std::max(required, map->key_heap_capacity_ * 2), STR_KEY_HEAP_MIN_CAPACITY),
+            STR_KEY_HEAP_MAX_CAPACITY
+    );
+    auto heap = reinterpret_cast<unsigned char *>(rosti_malloc(capacity));
+    if (heap == nullptr) {
+        return false;
+    }
+    if (map->key_heap_) {
+        memcpy(heap, map->key_heap_, map->key_heap_size_);
+        free(map->key_heap_);
+    }
+    map->key_heap_ = heap;
+    map->key_heap_capacity_ = capacity;
+    return true;
+}
+
+inline void free_key_heap(rosti_t *map) {
+    if (map->key_heap_) {
+        free(map->key_heap_);
+        map->key_heap_ = nullptr;
+    }
+    map->key_heap_size_ = 0;
+    map->key_heap_capacity_ = 0;
+}
+
+// key of STRING slot, chars stay in the heap of the map
+inline str_key_t str_key_of(const rosti_t *map, const void *p) {
+    const auto *s = reinterpret_cast<const str_slot_t *>(p);
+    return {s->hash, s->len, reinterpret_cast<const uint16_t *>(map->key_heap_ + ((uint64_t) s->offset << 2u))};
+}
+
+inline uint64_t hashStrMem(void *p) {
+    return reinterpret_cast<str_slot_t *>(p)->hash;
+}
+
+inline uint64_t hash_of(const str_key_t &key) {
+    return key.hash;
+}
+
+// STRING key lookup, inserted key is copied to the heap and set in the slot
+inline std::pair<uint64_t, bool> find(rosti_t *map, const str_key_t &key, const uint64_t hash) {
+    const uint64_t size = key.len > 0 ? (static_cast<uint64_t>(key.len) * sizeof(uint16_t) + 3u) & ~3ULL : 0;
+    // heap must not move after the lookup, room for the key is made before it is known to be new
+    if (PREDICT_FALSE(!reserve_key_heap(map, size))) {
+        return {UL_MAX, true};
+    }
+    const unsigned char *heap = map->key_heap_;
+    auto eq = [heap](void *p, const str_key_t &k) {
+        const auto *s = reinterpret_cast<str_slot_t *>(p);
+        return s->hash == k.hash && s->len == k.len &&
+               (k.len <= 0 || memcmp(heap + ((uint64_t) s->offset << 2u), k.chars, k.len * sizeof(uint16_t)) == 0);
+    };
+    auto res = find_or_prepare_insert_hashed<str_key_t>(map, key, hash, eq, hashStrMem, cpySlot);
+    if (res.second && PREDICT_TRUE(res.first != UL_MAX)) {
+        auto *s = reinterpret_cast<str_slot_t *>(map->slots_ + res.first);
+        s->hash = hash;
+        s->len = key.len;
+        s->offset = static_cast<uint32_t>(map->key_heap_size_ >> 2u);
+        if (size > 0) {
+            memcpy(map->key_heap_ + map->key_heap_size_, key.chars, key.len * sizeof(uint16_t));
+            map->key_heap_size_ += size;
+        }
+    }
+    return res;
+}
+
+inline std::pair<uint64_t, bool> find(rosti_t *map, const str_key_t &key) {
+    return find(map, key, key.hash);
+}
+
 
 inline bool reset(rosti_t *map, int newSize) {
-    if ( map->capacity_ > newSize ){
+    assert(!map->run_ && "spill run cannot be reset");
+    free_old_arena(map);
+    free_key_heap(map);
+    if ( map->capacity_ > static_cast<uint64_t>(newSize) ){
         auto *old_init = map->slot_initial_values_;
         const uint64_t old_capacity = map->capacity_;
         map->capacity_ = newSize;
@@ -76,6 +76,8 @@
 
 constexpr jdouble D_MAX = std::numeric_limits<jdouble>::infinity();
 constexpr jdouble D_MIN = -std::numeric_limits<jdouble>::infinity();
+constexpr jfloat F_MAX = std::numeric_limits<jfloat>::infinity();
+constexpr jfloat F_MIN = -std::numeric_limits<jfloat>::infinity();
 constexpr jint S_MIN = std::numeric_limits<jshort>::min();
 constexpr jint S_MAX = std::numeric_limits<jshort>::max();
 constexpr jint I_MIN = std::numeric_limits<jint>::min();
@@ -85,6 +87,89 @@ constexpr jlong L_MAX = std::numeric_limits<jlong>::max();
 constexpr uint64_t UL_MAX = std::numeric_limits<uint64_t>::max();
 constexpr jdouble D_NAN = std::numeric_limits<jdouble>::quiet_NaN();
 
+// Statistics of a column page computed in a single pass, see Vect.statsDouble(), Vect.statsInt()
+// and Vect.statsLong(). S is double for DOUBLE pages and int64_t for INT and LONG pages. Sum, min
+// and max follow null conventions of the matching sum, min and max kernels, so they are null when
+// the page has no values. The layout is shared with Java code reading the stats.
+template<typename S>
+struct column_stats_t {
+    int64_t count;
+    int64_t null_count;
+    S sum;
+    S min;
+    S max;
+};
+
+// Aggregates of the rows of one SAMPLE BY bucket with null handling of the matching group-by
+// functions: sum() skips non-finite doubles, count(), min() and max() skip nulls. The layout
+// is shared with Java code reading the stats, see GroupByFunction.BUCKET_STATS_* offsets.
+template<typename S>
+struct bucket_stats_t {
+    int64_t count;
+    int64_t sum_count;
+    S sum;
+    S min;
+    S max;
+};
+
+// Stats of the rows of each bucket written by a SAMPLE BY bucket kernel, null page stands for a column top.
+template<typename T, typename S, typename F>
+inline void sample_by_stats(const T *p, const int64_t *buckets, int64_t bucket_count, bucket_stats_t<S> *stats, S null, F bucket_stats) {
+    int64_t lo = 0;
+    for (int64_t i = 0; i < bucket_count; i++) {
+        const int64_t hi = buckets[2 * i + 1];
+        if (p != nullptr) {
+            bucket_stats(p + lo, hi - lo, stats + i);
+        } else {
+            stats[i] = {0, 0, 0, null, null};
+        }
+        lo = hi;
+    }
+}
+
+// Builds a zone map of a column: one column_stats_t entry per block of 1 << block_rows_shift values.
+// Only complete blocks are summarised, so entries of an append-only column never change.
+template<typename T, typename S, typename F>
+inline void zone_map(T *data, int64_t block_count, int32_t block_rows_shift, column_stats_t<S> *zone_map, F stats) {
+    const int64_t block_rows = 1LL << block_rows_shift;
+    for (int64_t i = 0; i < block_count; i++) {
+        stats(data + (i << block_rows_shift), block_rows, zone_map + i);
+    }
+}
+
+// Welford's running statistics of a double column: mean, sum of squared deviations from the mean
+// and the number of aggregated values. The layout is shared with Java code reading the state.
+struct welford_t {
+    double mean;
+    double m2;
+    int64_t count;
+};
+
+inline void welford_add(double &mean, double &m2, int64_t &count, double x) {
+    count++;
+    const double delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
+}
+
+// Chan et al. pairwise update, combines partial state "b" into "a".
+inline void welford_merge(double &mean, double &m2, int64_t &count, double mean_b, double m2_b, int64_t count_b) {
+    if (count_b == 0) {
+        return;
+    }
+    if (count == 0) {
+        mean = mean_b;
+        m2 = m2_b;
+        count = count_b;
+        return;
+    }
+    const int64_t n = count + count_b;
+    const double delta = mean_b - mean;
+    mean += delta * count_b / n;
+    m2 += m2_b + delta * delta * count * count_b / n;
+    count = n;
+}
+
 inline uint32_t ceil_pow_2(uint32_t v) {
     v--;
     v |= v >> 1u;
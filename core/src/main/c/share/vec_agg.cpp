@@ -35,20 +35,38 @@
 #define SUM_DOUBLE_NEUMAIER F_AVX512(sumDoubleNeumaier)
 #define MIN_DOUBLE F_AVX512(minDouble)
 #define MAX_DOUBLE F_AVX512(maxDouble)
+#define VARIANCE_DOUBLE F_AVX512(varianceDouble)
+#define STATS_DOUBLE F_AVX512(statsDouble)
+
+#define COUNT_FLOAT F_AVX512(countFloat)
+#define SUM_FLOAT F_AVX512(sumFloat)
+#define MIN_FLOAT F_AVX512(minFloat)
+#define MAX_FLOAT F_AVX512(maxFloat)
 
 #define SUM_SHORT F_AVX512(sumShort)
 #define MIN_SHORT F_AVX512(minShort)
 #define MAX_SHORT F_AVX512(maxShort)
 
+#define SUM_BYTE F_AVX512(sumByte)
+#define MIN_BYTE F_AVX512(minByte)
+#define MAX_BYTE F_AVX512(maxByte)
+
+#define MIN_CHAR F_AVX512(minChar)
+#define MAX_CHAR F_AVX512(maxChar)
+
 #define COUNT_INT F_AVX512(countInt)
 #define SUM_INT F_AVX512(sumInt)
 #define MIN_INT F_AVX512(minInt)
 #define MAX_INT F_AVX512(maxInt)
+#define STATS_INT F_AVX512(statsInt)
 
 #define COUNT_LONG F_AVX512(countLong)
 #define SUM_LONG F_AVX512(sumLong)
 #define MIN_LONG F_AVX512(minLong)
 #define MAX_LONG F_AVX512(maxLong)
+#define STATS_LONG F_AVX512(statsLong)
+
+#define COUNT_LONG128 F_AVX512(countLong128)
 
 #elif INSTRSET >= 8
 
@@ -58,20 +76,38 @@
 #define SUM_DOUBLE_NEUMAIER F_AVX2(sumDoubleNeumaier)
 #define MIN_DOUBLE F_AVX2(minDouble)
 #define MAX_DOUBLE F_AVX2(maxDouble)
+#define VARIANCE_DOUBLE F_AVX2(varianceDouble)
+#define STATS_DOUBLE F_AVX2(statsDouble)
+
+#define COUNT_FLOAT F_AVX2(countFloat)
+#define SUM_FLOAT F_AVX2(sumFloat)
+#define MIN_FLOAT F_AVX2(minFloat)
+#define MAX_FLOAT F_AVX2(maxFloat)
 
 #define SUM_SHORT F_AVX2(sumShort)
 #define MIN_SHORT F_AVX2(minShort)
 #define MAX_SHORT F_AVX2(maxShort)
 
+#define SUM_BYTE F_AVX2(sumByte)
+#define MIN_BYTE F_AVX2(minByte)
+#define MAX_BYTE F_AVX2(maxByte)
+
+#define MIN_CHAR F_AVX2(minChar)
+#define MAX_CHAR F_AVX2(maxChar)
+
 #define COUNT_INT F_AVX2(countInt)
 #define SUM_INT F_AVX2(sumInt)
 #define MIN_INT F_AVX2(minInt)
 #define MAX_INT F_AVX2(maxInt)
+#define STATS_INT F_AVX2(statsInt)
 
 #define COUNT_LONG F_AVX2(countLong)
 #define SUM_LONG F_AVX2(sumLong)
 #define MIN_LONG F_AVX2(minLong)
 #define MAX_LONG F_AVX2(maxLong)
+#define STATS_LONG F_AVX2(statsLong)
+
+#define COUNT_LONG128 F_AVX2(countLong128)
 
 #elif INSTRSET >= 5
 
@@ -81,20 +117,38 @@
 #define SUM_DOUBLE_NEUMAIER F_SSE41(sumDoubleNeumaier)
 #define MIN_DOUBLE F_SSE41(minDouble)
 #define MAX_DOUBLE F_SSE41(maxDouble)
+#define VARIANCE_DOUBLE F_SSE41(varianceDouble)
+#define STATS_DOUBLE F_SSE41(statsDouble)
+
+#define COUNT_FLOAT F_SSE41(countFloat)
+#define SUM_FLOAT F_SSE41(sumFloat)
+#define MIN_FLOAT F_SSE41(minFloat)
+#define MAX_FLOAT F_SSE41(maxFloat)
 
 #define SUM_SHORT F_SSE41(sumShort)
 #define MIN_SHORT F_SSE41(minShort)
 #define MAX_SHORT F_SSE41(maxShort)
 
+#define SUM_BYTE F_SSE41(sumByte)
+#define MIN_BYTE F_SSE41(minByte)
+#define MAX_BYTE F_SSE41(maxByte)
+
+#define MIN_CHAR F_SSE41(minChar)
+#define MAX_CHAR F_SSE41(maxChar)
+
 #define COUNT_INT F_SSE41(countInt)
 #define SUM_INT F_SSE41(sumInt)
 #define MIN_INT F_SSE41(minInt)
 #define MAX_INT F_SSE41(maxInt)
+#define STATS_INT F_SSE41(statsInt)
 
 #define COUNT_LONG F_SSE41(countLong)
 #define SUM_LONG F_SSE41(sumLong)
 #define MIN_LONG F_SSE41(minLong)
 #define MAX_LONG F_SSE41(maxLong)
+#define STATS_LONG F_SSE41(statsLong)
+
+#define COUNT_LONG128 F_SSE41(countLong128)
 
 #elif INSTRSET >= 2
 
@@ -104,20 +158,38 @@
 #define SUM_DOUBLE_NEUMAIER F_SSE2(sumDoubleNeumaier)
 #define MIN_DOUBLE F_SSE2(minDouble)
 #define MAX_DOUBLE F_SSE2(maxDouble)
+#define VARIANCE_DOUBLE F_SSE2(varianceDouble)
+#define STATS_DOUBLE F_SSE2(statsDouble)
+
+#define COUNT_FLOAT F_SSE2(countFloat)
+#define SUM_FLOAT F_SSE2(sumFloat)
+#define MIN_FLOAT F_SSE2(minFloat)
+#define MAX_FLOAT F_SSE2(maxFloat)
 
 #define SUM_SHORT F_SSE2(sumShort)
 #define MIN_SHORT F_SSE2(minShort)
 #define MAX_SHORT F_SSE2(maxShort)
 
+#define SUM_BYTE F_SSE2(sumByte)
+#define MIN_BYTE F_SSE2(minByte)
+#define MAX_BYTE F_SSE2(maxByte)
+
+#define MIN_CHAR F_SSE2(minChar)
+#define MAX_CHAR F_SSE2(maxChar)
+
 #define COUNT_INT F_SSE2(countInt)
 #define SUM_INT F_SSE2(sumInt)
 #define MIN_INT F_SSE2(minInt)
 #define MAX_INT F_SSE2(maxInt)
+#define STATS_INT F_SSE2(statsInt)
 
 #define COUNT_LONG F_SSE2(countLong)
 #define SUM_LONG F_SSE2(sumLong)
 #define MIN_LONG F_SSE2(minLong)
 #define MAX_LONG F_SSE2(maxLong)
+#define STATS_LONG F_SSE2(statsLong)
+
+#define COUNT_LONG128 F_SSE2(countLong128)
 
 #else
 
@@ -254,6 +326,93 @@ int64_t MAX_LONG(int64_t *pl, int64_t count) {
     return max;
 }
 
+// Fused COUNT_LONG, SUM_LONG, MIN_LONG and MAX_LONG, the page is read once.
+void STATS_LONG(int64_t *pl, int64_t count, column_stats_t<int64_t> *stats) {
+    Vec8q vec;
+    const int step = 8;
+    Vec8q vecSum = 0;
+    Vec8q vecMin = L_MIN;
+    Vec8q vecMax = L_MIN;
+    Vec8qb bVec;
+    Vec8q nullCount = 0;
+    int64_t i;
+    for (i = 0; i < count - 7; i += step) {
+        _mm_prefetch(pl + i + 63 * step, _MM_HINT_T1);
+        vec.load(pl + i);
+        bVec = vec == L_MIN;
+        vecSum = if_add(!bVec, vecSum, vec);
+        nullCount = if_add(bVec, nullCount, 1);
+        vecMax = max(vecMax, vec);
+        vecMin = select(vecMin == L_MIN, vec, vecMin);
+        vec = select(bVec, vecMin, vec);
+        vecMin = min(vec, vecMin);
+    }
+
+    int64_t sum = horizontal_add(vecSum);
+    int64_t nulls = horizontal_add(nullCount);
+    // lanes are reduced with scalar code, generic horizontal_min() and horizontal_max() templates
+    // would be emitted out of line and may resolve to the instance compiled for another instruction set
+    int64_t min = L_MIN;
+    int64_t max = L_MIN;
+    for (int j = 0; j < step; j++) {
+        const int64_t n = vecMin[j];
+        if (n != L_MIN && (n < min || min == L_MIN)) {
+            min = n;
+        }
+        max = std::max(max, (int64_t) vecMax[j]);
+    }
+
+    for (; i < count; i++) {
+        const int64_t x = pl[i];
+        if (PREDICT_TRUE(x != L_MIN)) {
+            sum += x;
+            if (x < min || min == L_MIN) {
+                min = x;
+            }
+            if (x > max) {
+                max = x;
+            }
+        } else {
+            nulls++;
+        }
+    }
+
+    stats->count = count - nulls;
+    stats->null_count = nulls;
+    stats->sum = nulls < count ? sum : L_MIN;
+    stats->min = min;
+    stats->max = max;
+}
+
+// count is the number of 128-bit values, a value is null when both of its longs are L_MIN
+int64_t COUNT_LONG128(int64_t *pl, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const int step = 4;
+    Vec8q vec;
+    Vec8qb bVec;
+    Vec8q nullCount = 0;
+
+    int64_t i;
+    for (i = 0; i < count - 3; i += step) {
+        _mm_prefetch(pl + 2 * i + 63 * 8, _MM_HINT_T1);
+        vec.load(pl + 2 * i);
+        // both lanes of a null pair are set, so the lane total is twice the null count
+        bVec = (vec == L_MIN) & (permute8<1, 0, 3, 2, 5, 4, 7, 6>(vec) == L_MIN);
+        nullCount = if_add(bVec, nullCount, 1);
+    }
+
+    int64_t nulls = horizontal_add(nullCount) / 2;
+    for (; i < count; i++) {
+        if (pl[2 * i] == L_MIN && pl[2 * i + 1] == L_MIN) {
+            nulls++;
+        }
+    }
+    return count - nulls;
+}
+
 #endif
 
 #ifdef SUM_INT
@@ -385,6 +544,65 @@ int32_t MAX_INT(int32_t *pi, int64_t count) {
     return max;
 }
 
+// Fused COUNT_INT, SUM_INT, MIN_INT and MAX_INT, the page is read once.
+void STATS_INT(int32_t *pi, int64_t count, column_stats_t<int64_t> *stats) {
+    Vec16i vec;
+    const int step = 16;
+    Vec8q vecSum = 0;
+    Vec16i vecMin = I_MIN;
+    Vec16i vecMax = I_MIN;
+    Vec16i nullCount = 0;
+    Vec16ib bVec;
+    int64_t i;
+    for (i = 0; i < count - 15; i += step) {
+        _mm_prefetch(pi + i + 63 * step, _MM_HINT_T1);
+        vec.load(pi + i);
+        bVec = vec == I_MIN;
+        nullCount = if_add(bVec, nullCount, 1);
+        // 64-bit lanes, so the sum does not overflow
+        const Vec16i values = select(bVec, 0, vec);
+        vecSum += extend_low(values) + extend_high(values);
+        vecMax = max(vecMax, vec);
+        vecMin = select(vecMin == I_MIN, vec, vecMin);
+        vec = select(bVec, vecMin, vec);
+        vecMin = min(vec, vecMin);
+    }
+
+    int64_t sum = horizontal_add(vecSum);
+    int64_t nulls = horizontal_add_x(nullCount);
+    // see STATS_LONG for why lanes are reduced with scalar code
+    int32_t min = I_MIN;
+    int32_t max = I_MIN;
+    for (int j = 0; j < step; j++) {
+        const int32_t n = vecMin[j];
+        if (n != I_MIN && (n < min || min == I_MIN)) {
+            min = n;
+        }
+        max = std::max(max, (int32_t) vecMax[j]);
+    }
+
+    for (; i < count; i++) {
+        const int32_t x = pi[i];
+        if (PREDICT_TRUE(x != I_MIN)) {
+            sum += x;
+            if (x < min || min == I_MIN) {
+                min = x;
+            }
+            if (x > max) {
+                max = x;
+            }
+        } else {
+            nulls++;
+        }
+    }
+
+    stats->count = count - nulls;
+    stats->null_count = nulls;
+    stats->sum = nulls < count ? sum : L_MIN;
+    stats->min = min;
+    stats->max = max;
+}
+
 #endif
 
 #ifdef SUM_SHORT
@@ -479,6 +697,154 @@ int32_t MAX_SHORT(int16_t *ps, int64_t count) {
 
 #endif
 
+#ifdef SUM_BYTE
+
+int64_t SUM_BYTE(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+
+    const int step = 64;
+    // every iteration adds at most 2 * 128 to a 16-bit lane, flush to 32-bit lanes before it can overflow
+    const int flush_step = 64 * step;
+    const auto *lim = pb + count;
+    const auto *vec_lim = lim - count % step;
+
+    Vec64c vec;
+    Vec16i acc0 = 0;
+    Vec16i acc1 = 0;
+    while (pb < vec_lim) {
+        const auto *flush_lim = vec_lim - pb > flush_step ? pb + flush_step : vec_lim;
+        Vec32s acc = 0;
+        for (; pb < flush_lim; pb += step) {
+            _mm_prefetch(pb + 63 * step, _MM_HINT_T1);
+            vec.load(pb);
+            acc += extend_low(vec) + extend_high(vec);
+        }
+        acc0 += extend_low(acc);
+        acc1 += extend_high(acc);
+    }
+
+    int64_t result = horizontal_add_x(acc0) + horizontal_add_x(acc1);
+    for (; pb < lim; pb++) {
+        result += *pb;
+    }
+    return result;
+}
+
+int32_t MIN_BYTE(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+
+    const int step = 64;
+    const auto *lim = pb + count;
+    const auto *vec_lim = lim - count % step;
+
+    Vec64c vec;
+    Vec64c vecMin = INT8_MAX;
+    for (; pb < vec_lim; pb += step) {
+        _mm_prefetch(pb + 63 * step, _MM_HINT_T1);
+        vec.load(pb);
+        vecMin = min(vecMin, vec);
+    }
+
+    // lanes are reduced with scalar code, see STATS_LONG
+    int32_t min = INT8_MAX;
+    for (int j = 0; j < step; j++) {
+        min = std::min(min, (int32_t) vecMin[j]);
+    }
+    for (; pb < lim; pb++) {
+        min = std::min(min, (int32_t) *pb);
+    }
+    return min;
+}
+
+int32_t MAX_BYTE(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+
+    const int step = 64;
+    const auto *lim = pb + count;
+    const auto *vec_lim = lim - count % step;
+
+    Vec64c vec;
+    Vec64c vecMax = INT8_MIN;
+    for (; pb < vec_lim; pb += step) {
+        _mm_prefetch(pb + 63 * step, _MM_HINT_T1);
+        vec.load(pb);
+        vecMax = max(vecMax, vec);
+    }
+
+    int32_t max = INT8_MIN;
+    for (int j = 0; j < step; j++) {
+        max = std::max(max, (int32_t) vecMax[j]);
+    }
+    for (; pb < lim; pb++) {
+        max = std::max(max, (int32_t) *pb);
+    }
+    return max;
+}
+
+// char 0 is null and does not take part in min(), 0 is returned when there is no other value.
+// Subtracting one wraps 0 around to the largest unsigned value, so it never wins the comparison.
+int32_t MIN_CHAR(uint16_t *pc, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const int step = 32;
+    const auto *lim = pc + count;
+    const auto *vec_lim = lim - count % step;
+
+    Vec32us vec;
+    Vec32us vecMin = UINT16_MAX;
+    for (; pc < vec_lim; pc += step) {
+        _mm_prefetch(pc + 63 * step, _MM_HINT_T1);
+        vec.load(pc);
+        vecMin = min(vecMin, vec - 1);
+    }
+
+    uint16_t min = UINT16_MAX;
+    for (int j = 0; j < step; j++) {
+        min = std::min(min, (uint16_t) vecMin[j]);
+    }
+    for (; pc < lim; pc++) {
+        min = std::min(min, (uint16_t) (*pc - 1));
+    }
+    return (uint16_t) (min + 1);
+}
+
+int32_t MAX_CHAR(uint16_t *pc, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const int step = 32;
+    const auto *lim = pc + count;
+    const auto *vec_lim = lim - count % step;
+
+    Vec32us vec;
+    Vec32us vecMax = 0;
+    for (; pc < vec_lim; pc += step) {
+        _mm_prefetch(pc + 63 * step, _MM_HINT_T1);
+        vec.load(pc);
+        vecMax = max(vecMax, vec);
+    }
+
+    uint16_t max = 0;
+    for (int j = 0; j < step; j++) {
+        max = std::max(max, (uint16_t) vecMax[j]);
+    }
+    for (; pc < lim; pc++) {
+        max = std::max(max, *pc);
+    }
+    return max;
+}
+
+#endif
+
 #ifdef SUM_DOUBLE
 
 int64_t COUNT_DOUBLE(double *d, int64_t count) {
@@ -710,6 +1076,228 @@ double MAX_DOUBLE(double *d, int64_t count) {
     return NAN;
 }
 
+// Fused COUNT_DOUBLE, SUM_DOUBLE, MIN_DOUBLE and MAX_DOUBLE, the page is read once. Lanes are
+// reduced in the same order as in the separate kernels, so the sum is the same to the last bit.
+void STATS_DOUBLE(double *d, int64_t count, column_stats_t<double> *stats) {
+    Vec8d vec;
+    const int step = 8;
+    Vec8d vecSum = 0.;
+    Vec8d vecMin = D_MAX;
+    Vec8d vecMax = D_MIN;
+    Vec8db bVec;
+    Vec8q nanCount = 0;
+    int64_t i;
+    for (i = 0; i < count - 7; i += step) {
+        _mm_prefetch(d + i + 63 * step, _MM_HINT_T1);
+        vec.load(d + i);
+        bVec = is_nan(vec);
+        vecSum += select(bVec, 0, vec);
+        nanCount = if_add(bVec, nanCount, 1);
+        vecMin = select(bVec, vecMin, min(vecMin, vec));
+        vecMax = select(bVec, vecMax, max(vecMax, vec));
+    }
+
+    double sum = horizontal_add(vecSum);
+    int64_t nans = horizontal_add(nanCount);
+    // see STATS_LONG for why lanes are reduced with scalar code, lanes hold no NaN
+    double min = D_MAX;
+    double max = D_MIN;
+    for (int j = 0; j < step; j++) {
+        min = std::min(min, (double) vecMin[j]);
+        max = std::max(max, (double) vecMax[j]);
+    }
+    for (; i < count; i++) {
+        const double x = d[i];
+        if (PREDICT_TRUE(!std::isnan(x))) {
+            sum += x;
+            if (x < min) {
+                min = x;
+            }
+            if (x > max) {
+                max = x;
+            }
+        } else {
+            nans++;
+        }
+    }
+
+    stats->count = count - nans;
+    stats->null_count = nans;
+    stats->sum = nans < count ? sum : NAN;
+    stats->min = min < D_MAX ? min : NAN;
+    stats->max = max > D_MIN ? max : NAN;
+}
+
+// Welford's algorithm with independent state per lane, lanes and the scalar tail are combined
+// pairwise and merged into the state passed by the caller. Non-finite values are skipped.
+void VARIANCE_DOUBLE(double *d, int64_t count, welford_t *state) {
+    Vec8d vec;
+    const int step = 8;
+    Vec8d meanVec = 0.;
+    Vec8d m2Vec = 0.;
+    Vec8d countVec = 0.;
+    Vec8d delta;
+    Vec8db bVec;
+    int64_t i;
+    for (i = 0; i < count - 7; i += step) {
+        _mm_prefetch(d + i + 63 * step, _MM_HINT_T1);
+        vec.load(d + i);
+        bVec = is_finite(vec);
+        countVec = if_add(bVec, countVec, 1.);
+        // lanes without a finite value yet divide by zero, select() discards them
+        delta = vec - meanVec;
+        meanVec = select(bVec, meanVec + delta / countVec, meanVec);
+        m2Vec = select(bVec, m2Vec + delta * (vec - meanVec), m2Vec);
+    }
+
+    double mean = 0;
+    double m2 = 0;
+    int64_t n = 0;
+    for (int j = 0; j < step; j++) {
+        welford_merge(mean, m2, n, meanVec[j], m2Vec[j], (int64_t) countVec[j]);
+    }
+
+    for (; i < count; i++) {
+        const double x = d[i];
+        if (PREDICT_TRUE(std::isfinite(x))) {
+            welford_add(mean, m2, n, x);
+        }
+    }
+    welford_merge(state->mean, state->m2, state->count, mean, m2, n);
+}
+
+#endif
+
+#ifdef SUM_FLOAT
+
+int64_t COUNT_FLOAT(float *pf, int64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const int step = 16;
+    Vec16f vec;
+    int64_t nans = 0;
+    int64_t i;
+    for (i = 0; i < count - 15; i += step) {
+        _mm_prefetch(pf + i + 63 * step, _MM_HINT_T1);
+        vec.load(pf + i);
+        nans += horizontal_count(is_nan(vec));
+    }
+
+    for (; i < count; i++) {
+        if (PREDICT_FALSE(std::isnan(pf[i]))) {
+            nans++;
+        }
+    }
+    return count - nans;
+}
+
+// Same as the row based sum(float), non-finite values are skipped and NaN is returned when
+// there is nothing to sum. The sum is accumulated in double, so it is exact for much longer
+// runs than the float accumulator of the row based function.
+double SUM_FLOAT(float *pf, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+
+    const int step = 16;
+    Vec16f vec;
+    Vec16fb bVec;
+    Vec8d sum0 = 0.;
+    Vec8d sum1 = 0.;
+    int64_t n = 0;
+    int64_t i;
+    for (i = 0; i < count - 15; i += step) {
+        _mm_prefetch(pf + i + 63 * step, _MM_HINT_T1);
+        vec.load(pf + i);
+        bVec = is_finite(vec);
+        vec = select(bVec, vec, 0.f);
+        sum0 += to_double(vec.get_low());
+        sum1 += to_double(vec.get_high());
+        n += horizontal_count(bVec);
+    }
+
+    double sum = horizontal_add(sum0 + sum1);
+    for (; i < count; i++) {
+        const float x = pf[i];
+        if (PREDICT_TRUE(std::isfinite(x))) {
+            sum += x;
+            n++;
+        }
+    }
+    return n > 0 ? sum : NAN;
+}
+
+// NaN is null and skipped, infinities take part in the comparison
+float MIN_FLOAT(float *pf, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+
+    const int step = 16;
+    Vec16f vec;
+    Vec16fb bVec;
+    Vec16fb seen = false;
+    Vec16f vecMin = F_MAX;
+    int64_t i;
+    for (i = 0; i < count - 15; i += step) {
+        _mm_prefetch(pf + i + 63 * step, _MM_HINT_T1);
+        vec.load(pf + i);
+        bVec = is_nan(vec);
+        vecMin = select(bVec, vecMin, min(vecMin, vec));
+        seen |= !bVec;
+    }
+
+    bool found = horizontal_or(seen);
+    float min = F_MAX;
+    for (int j = 0; j < step; j++) {
+        min = std::min(min, (float) vecMin[j]);
+    }
+    for (; i < count; i++) {
+        const float x = pf[i];
+        if (PREDICT_TRUE(!std::isnan(x))) {
+            min = std::min(min, x);
+            found = true;
+        }
+    }
+    return found ? min : NAN;
+}
+
+float MAX_FLOAT(float *pf, int64_t count) {
+    if (count == 0) {
+        return NAN;
+    }
+
+    const int step = 16;
+    Vec16f vec;
+    Vec16fb bVec;
+    Vec16fb seen = false;
+    Vec16f vecMax = F_MIN;
+    int64_t i;
+    for (i = 0; i < count - 15; i += step) {
+        _mm_prefetch(pf + i + 63 * step, _MM_HINT_T1);
+        vec.load(pf + i);
+        bVec = is_nan(vec);
+        vecMax = select(bVec, vecMax, max(vecMax, vec));
+        seen |= !bVec;
+    }
+
+    bool found = horizontal_or(seen);
+    float max = F_MIN;
+    for (int j = 0; j < step; j++) {
+        max = std::max(max, (float) vecMax[j]);
+    }
+    for (; i < count; i++) {
+        const float x = pf[i];
+        if (PREDICT_TRUE(!std::isnan(x))) {
+            max = std::max(max, x);
+            found = true;
+        }
+    }
+    return found ? max : NAN;
+}
+
 #endif
 
 #if INSTRSET < 5
@@ -721,26 +1309,55 @@ DOUBLE_DISPATCHER(sumDoubleKahan)
 DOUBLE_DISPATCHER(sumDoubleNeumaier)
 DOUBLE_DISPATCHER(minDouble)
 DOUBLE_DISPATCHER(maxDouble)
+DOUBLE_WELFORD_DISPATCHER(varianceDouble)
+STATS_DISPATCHER(statsDouble, double, double)
+
+FLOAT_LONG_DISPATCHER(countFloat)
+FLOAT_DOUBLE_DISPATCHER(sumFloat)
+FLOAT_FLOAT_DISPATCHER(minFloat)
+FLOAT_FLOAT_DISPATCHER(maxFloat)
 
 SHORT_LONG_DISPATCHER(sumShort)
 SHORT_INT_DISPATCHER(minShort)
 SHORT_INT_DISPATCHER(maxShort)
 
+BYTE_LONG_DISPATCHER(sumByte)
+BYTE_INT_DISPATCHER(minByte)
+BYTE_INT_DISPATCHER(maxByte)
+
+CHAR_INT_DISPATCHER(minChar)
+CHAR_INT_DISPATCHER(maxChar)
+
 INT_LONG_DISPATCHER(countInt)
 INT_LONG_DISPATCHER(sumInt)
 INT_INT_DISPATCHER(minInt)
 INT_INT_DISPATCHER(maxInt)
+STATS_DISPATCHER(statsInt, int32_t, int64_t)
 
 LONG_LONG_DISPATCHER(countLong)
 LONG_LONG_DISPATCHER(sumLong)
 LONG_LONG_DISPATCHER(minLong)
 LONG_LONG_DISPATCHER(maxLong)
+STATS_DISPATCHER(statsLong, int64_t, int64_t)
+LONG_LONG_COUNTED_DISPATCHER(countLong128, PERF_VEC_AGG_LONG128, 2 * sizeof(int64_t))
 
 extern "C" {
 
-JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_getSupportedInstructionSet(JNIEnv *env, jclass cl) {
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_getSupportedInstructionSet(JNIEnv *env, jclass cl) {
     return instrset_detect();
 }
 
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_zoneMapDouble(JNIEnv *env, jclass cl, jlong pDouble, jlong blockCount, jint blockRowsShift, jlong pZoneMap) {
+    zone_map((double *) pDouble, blockCount, blockRowsShift, (column_stats_t<double> *) pZoneMap, statsDouble);
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_zoneMapInt(JNIEnv *env, jclass cl, jlong pInt, jlong blockCount, jint blockRowsShift, jlong pZoneMap) {
+    zone_map((int32_t *) pInt, blockCount, blockRowsShift, (column_stats_t<int64_t> *) pZoneMap, statsInt);
+}
+
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_zoneMapLong(JNIEnv *env, jclass cl, jlong pLong, jlong blockCount, jint blockRowsShift, jlong pZoneMap) {
+    zone_map((int64_t *) pLong, blockCount, blockRowsShift, (column_stats_t<int64_t> *) pZoneMap, statsLong);
+}
+
 }
 #endif  // INSTRSET == 2
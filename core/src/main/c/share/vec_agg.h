@@ -29,6 +29,28 @@
 #include "vcl/vectorclass.h"
 #include "vec_agg_vanilla.h"
 #include "vec_dispatch.h"
+#include "perf_counters.h"
+#include <type_traits>
+
+// counters of the JNI entry points are per value type
+template<typename T>
+constexpr int32_t perf_vec_agg_counter() {
+    if constexpr (std::is_same_v<T, double>) {
+        return PERF_VEC_AGG_DOUBLE;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return PERF_VEC_AGG_FLOAT;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return PERF_VEC_AGG_SHORT;
+    } else if constexpr (std::is_same_v<T, int8_t>) {
+        return PERF_VEC_AGG_BYTE;
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+        return PERF_VEC_AGG_CHAR;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return PERF_VEC_AGG_INT;
+    } else {
+        return PERF_VEC_AGG_LONG;
+    }
+}
 
 typedef double DoubleVecFuncType(double *, int64_t);
 
@@ -60,7 +82,84 @@ inline double func(double *d, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pDouble, jlong size) { \
-    return func((double *) pDouble, size); \
+    return measure_time(perf_vec_agg_counter<double>(), size * (int64_t) sizeof(double), [=]() { \
+        return func((double *) pDouble, size); \
+    }); \
+}\
+\
+}
+
+typedef void DoubleWelfordVecFuncType(double *, int64_t, welford_t *);
+
+#define DOUBLE_WELFORD_DISPATCHER(func) \
+\
+DoubleWelfordVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+DoubleWelfordVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+void F_DISPATCH(func) (double *d, int64_t count, welford_t *state) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    (*POINTER_NAME(func))(d, count, state); \
+} \
+\
+inline void func(double *d, int64_t count, welford_t *state) { \
+    (*POINTER_NAME(func))(d, count, state); \
+}\
+\
+extern "C" { \
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pDouble, jlong count, jlong pState) { \
+    measure_time(perf_vec_agg_counter<double>(), count * (int64_t) sizeof(double), [=]() { \
+        func((double *) pDouble, count, (welford_t *) pState); \
+    }); \
+}\
+\
+}
+
+// T is the column value type, S is the type of sum, min and max in column_stats_t
+#define STATS_DISPATCHER(func, T, S) \
+\
+typedef void func ## _FuncType(T *, int64_t, column_stats_t<S> *); \
+\
+func ## _FuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+func ## _FuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+void F_DISPATCH(func) (T *p, int64_t count, column_stats_t<S> *stats) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    (*POINTER_NAME(func))(p, count, stats); \
+} \
+\
+inline void func(T *p, int64_t count, column_stats_t<S> *stats) { \
+    (*POINTER_NAME(func))(p, count, stats); \
+}\
+\
+extern "C" { \
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pData, jlong count, jlong pStats) { \
+    measure_time(perf_vec_agg_counter<T>(), count * (int64_t) sizeof(T), [=]() { \
+        func((T *) pData, count, (column_stats_t<S> *) pStats); \
+    }); \
 }\
 \
 }
@@ -95,7 +194,9 @@ inline int64_t func(double *d, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pDouble, jlong size) { \
-    return func((double *) pDouble, size); \
+    return measure_time(perf_vec_agg_counter<double>(), size * (int64_t) sizeof(double), [=]() { \
+        return func((double *) pDouble, size); \
+    }); \
 }\
 \
 }
@@ -130,7 +231,9 @@ inline int64_t func(int32_t *i, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pInt, jlong count) { \
-    return func((int32_t *) pInt, count); \
+    return measure_time(perf_vec_agg_counter<int32_t>(), count * (int64_t) sizeof(int32_t), [=]() { \
+        return func((int32_t *) pInt, count); \
+    }); \
 }\
 \
 }
@@ -165,7 +268,9 @@ inline double func(int32_t *i, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pInt, jlong count) { \
-    return func((int32_t *) pInt, count); \
+    return measure_time(perf_vec_agg_counter<int32_t>(), count * (int64_t) sizeof(int32_t), [=]() { \
+        return func((int32_t *) pInt, count); \
+    }); \
 }\
 \
 }
@@ -200,14 +305,19 @@ inline int32_t func(int32_t *i, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pInt, jlong count) { \
-    return func((int32_t *) pInt, count); \
+    return measure_time(perf_vec_agg_counter<int32_t>(), count * (int64_t) sizeof(int32_t), [=]() { \
+        return func((int32_t *) pInt, count); \
+    }); \
 }\
 \
 }
 
 typedef int64_t LongLongVecFuncType(int64_t *, int64_t);
 
-#define LONG_LONG_DISPATCHER(func) \
+#define LONG_LONG_DISPATCHER(func) LONG_LONG_COUNTED_DISPATCHER(func, PERF_VEC_AGG_LONG, sizeof(int64_t))
+
+// value_size is bytes per counted value, LONG128 functions count pairs of longs
+#define LONG_LONG_COUNTED_DISPATCHER(func, counter, value_size) \
 \
 LongLongVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
 \
@@ -235,7 +345,9 @@ inline int64_t func(int64_t *pl, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pLong, jlong count) { \
-    return func((int64_t *) pLong, count); \
+    return measure_time(counter, count * (int64_t) (value_size), [=]() { \
+        return func((int64_t *) pLong, count); \
+    }); \
 }\
 \
 }
@@ -270,7 +382,9 @@ inline int64_t func(int16_t *pl, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pLong, jlong count) { \
-    return func((int16_t *) pLong, count); \
+    return measure_time(perf_vec_agg_counter<int16_t>(), count * (int64_t) sizeof(int16_t), [=]() { \
+        return func((int16_t *) pLong, count); \
+    }); \
 }\
 \
 }
@@ -305,7 +419,9 @@ inline double func(int64_t *pl, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pLong, jlong count) { \
-    return func((int64_t *) pLong, count); \
+    return measure_time(perf_vec_agg_counter<int64_t>(), count * (int64_t) sizeof(int64_t), [=]() { \
+        return func((int64_t *) pLong, count); \
+    }); \
 }\
 \
 }
@@ -340,7 +456,9 @@ inline bool func(int32_t *i, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jboolean JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pInt, jlong count) { \
-    return func((int32_t *) pInt, count); \
+    return measure_time(perf_vec_agg_counter<int32_t>(), count * (int64_t) sizeof(int32_t), [=]() { \
+        return func((int32_t *) pInt, count); \
+    }); \
 }\
 \
 }
@@ -375,7 +493,9 @@ inline int64_t func(int16_t *ps, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pShort, jlong count) { \
-    return func((int16_t *) pShort, count); \
+    return measure_time(perf_vec_agg_counter<int16_t>(), count * (int64_t) sizeof(int16_t), [=]() { \
+        return func((int16_t *) pShort, count); \
+    }); \
 }\
 \
 }
@@ -410,7 +530,231 @@ inline int32_t func(int16_t *ps, int64_t count) { \
 \
 extern "C" { \
 JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pShort, jlong count) { \
-    return func((int16_t *) pShort, count); \
+    return measure_time(perf_vec_agg_counter<int16_t>(), count * (int64_t) sizeof(int16_t), [=]() { \
+        return func((int16_t *) pShort, count); \
+    }); \
+}\
+\
+}
+
+typedef int64_t FloatLongVecFuncType(float *, int64_t);
+
+#define FLOAT_LONG_DISPATCHER(func) \
+\
+FloatLongVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+FloatLongVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+int64_t F_DISPATCH(func) (float *pf, int64_t count) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    return (*POINTER_NAME(func))(pf, count); \
+} \
+\
+inline int64_t func(float *pf, int64_t count) { \
+    return (*POINTER_NAME(func))(pf, count); \
+}\
+\
+extern "C" { \
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pFloat, jlong count) { \
+    return measure_time(perf_vec_agg_counter<float>(), count * (int64_t) sizeof(float), [=]() { \
+        return func((float *) pFloat, count); \
+    }); \
+}\
+\
+}
+
+typedef double FloatDoubleVecFuncType(float *, int64_t);
+
+#define FLOAT_DOUBLE_DISPATCHER(func) \
+\
+FloatDoubleVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+FloatDoubleVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+double F_DISPATCH(func) (float *pf, int64_t count) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    return (*POINTER_NAME(func))(pf, count); \
+} \
+\
+inline double func(float *pf, int64_t count) { \
+    return (*POINTER_NAME(func))(pf, count); \
+}\
+\
+extern "C" { \
+JNIEXPORT jdouble JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pFloat, jlong count) { \
+    return measure_time(perf_vec_agg_counter<float>(), count * (int64_t) sizeof(float), [=]() { \
+        return func((float *) pFloat, count); \
+    }); \
+}\
+\
+}
+
+typedef float FloatFloatVecFuncType(float *, int64_t);
+
+#define FLOAT_FLOAT_DISPATCHER(func) \
+\
+FloatFloatVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+FloatFloatVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+float F_DISPATCH(func) (float *pf, int64_t count) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    return (*POINTER_NAME(func))(pf, count); \
+} \
+\
+inline float func(float *pf, int64_t count) { \
+    return (*POINTER_NAME(func))(pf, count); \
+}\
+\
+extern "C" { \
+JNIEXPORT jfloat JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pFloat, jlong count) { \
+    return measure_time(perf_vec_agg_counter<float>(), count * (int64_t) sizeof(float), [=]() { \
+        return func((float *) pFloat, count); \
+    }); \
+}\
+\
+}
+
+typedef int64_t ByteLongVecFuncType(int8_t *, int64_t);
+
+#define BYTE_LONG_DISPATCHER(func) \
+\
+ByteLongVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+ByteLongVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+int64_t F_DISPATCH(func) (int8_t *pb, int64_t count) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    return (*POINTER_NAME(func))(pb, count); \
+} \
+\
+inline int64_t func(int8_t *pb, int64_t count) { \
+    return (*POINTER_NAME(func))(pb, count); \
+}\
+\
+extern "C" { \
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pByte, jlong count) { \
+    return measure_time(perf_vec_agg_counter<int8_t>(), count * (int64_t) sizeof(int8_t), [=]() { \
+        return func((int8_t *) pByte, count); \
+    }); \
+}\
+\
+}
+
+typedef int32_t ByteIntVecFuncType(int8_t *, int64_t);
+
+#define BYTE_INT_DISPATCHER(func) \
+\
+ByteIntVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+ByteIntVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+int32_t F_DISPATCH(func) (int8_t *pb, int64_t count) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    return (*POINTER_NAME(func))(pb, count); \
+} \
+\
+inline int32_t func(int8_t *pb, int64_t count) { \
+    return (*POINTER_NAME(func))(pb, count); \
+}\
+\
+extern "C" { \
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pByte, jlong count) { \
+    return measure_time(perf_vec_agg_counter<int8_t>(), count * (int64_t) sizeof(int8_t), [=]() { \
+        return func((int8_t *) pByte, count); \
+    }); \
+}\
+\
+}
+
+typedef int32_t CharIntVecFuncType(uint16_t *, int64_t);
+
+#define CHAR_INT_DISPATCHER(func) \
+\
+CharIntVecFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+CharIntVecFuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+int32_t F_DISPATCH(func) (uint16_t *pc, int64_t count) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else if (iset >= 2) { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    } else { \
+        POINTER_NAME(func) = &F_VANILLA(func); \
+    }\
+    return (*POINTER_NAME(func))(pc, count); \
+} \
+\
+inline int32_t func(uint16_t *pc, int64_t count) { \
+    return (*POINTER_NAME(func))(pc, count); \
+}\
+\
+extern "C" { \
+JNIEXPORT jint JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pChar, jlong count) { \
+    return measure_time(perf_vec_agg_counter<uint16_t>(), count * (int64_t) sizeof(uint16_t), [=]() { \
+        return func((uint16_t *) pChar, count); \
+    }); \
 }\
 \
 }
@@ -91,6 +91,32 @@ int32_t maxInt_Vanilla(int32_t *pi, int64_t count) {
     return max;
 }
 
+void statsInt_Vanilla(int32_t *pi, int64_t count, column_stats_t<int64_t> *stats) {
+    const int32_t *lim = pi + count;
+    int64_t cnt = 0;
+    int64_t sum = 0;
+    int32_t min = I_MIN;
+    int32_t max = I_MIN;
+    for (; pi < lim; pi++) {
+        const int32_t i = *pi;
+        if (i != I_MIN) {
+            cnt++;
+            sum += i;
+            if (i < min || min == I_MIN) {
+                min = i;
+            }
+            if (i > max) {
+                max = i;
+            }
+        }
+    }
+    stats->count = cnt;
+    stats->null_count = count - cnt;
+    stats->sum = cnt > 0 ? sum : L_MIN;
+    stats->min = min;
+    stats->max = max;
+}
+
 int64_t countDouble_Vanilla(double *d, int64_t count) {
     if (count == 0) {
         return 0;
@@ -206,6 +232,99 @@ double maxDouble_Vanilla(double *d, int64_t count) {
     return NAN;
 }
 
+void varianceDouble_Vanilla(double *d, int64_t count, welford_t *state) {
+    const double *lim = d + count;
+    double mean = 0;
+    double m2 = 0;
+    int64_t n = 0;
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (std::isfinite(x)) {
+            welford_add(mean, m2, n, x);
+        }
+    }
+    welford_merge(state->mean, state->m2, state->count, mean, m2, n);
+}
+
+void statsDouble_Vanilla(double *d, int64_t count, column_stats_t<double> *stats) {
+    const double *lim = d + count;
+    int64_t cnt = 0;
+    double sum = 0;
+    double min = D_MAX;
+    double max = D_MIN;
+    for (; d < lim; d++) {
+        const double x = *d;
+        if (!std::isnan(x)) {
+            cnt++;
+            sum += x;
+            if (x < min) {
+                min = x;
+            }
+            if (x > max) {
+                max = x;
+            }
+        }
+    }
+    stats->count = cnt;
+    stats->null_count = count - cnt;
+    stats->sum = cnt > 0 ? sum : NAN;
+    stats->min = min < D_MAX ? min : NAN;
+    stats->max = max > D_MIN ? max : NAN;
+}
+
+int64_t countFloat_Vanilla(float *pf, int64_t count) {
+    const float *lim = pf + count;
+    int64_t n = 0;
+    for (; pf < lim; pf++) {
+        if (!std::isnan(*pf)) {
+            n++;
+        }
+    }
+    return n;
+}
+
+double sumFloat_Vanilla(float *pf, int64_t count) {
+    const float *lim = pf + count;
+    double sum = 0;
+    int64_t n = 0;
+    for (; pf < lim; pf++) {
+        const float f = *pf;
+        if (std::isfinite(f)) {
+            sum += f;
+            n++;
+        }
+    }
+    return n > 0 ? sum : NAN;
+}
+
+float minFloat_Vanilla(float *pf, int64_t count) {
+    const float *lim = pf + count;
+    float min = F_MAX;
+    bool found = false;
+    for (; pf < lim; pf++) {
+        const float f = *pf;
+        if (!std::isnan(f)) {
+            min = std::min(min, f);
+            found = true;
+        }
+    }
+    return found ? min : NAN;
+}
+
+float maxFloat_Vanilla(float *pf, int64_t count) {
+    const float *lim = pf + count;
+    float max = F_MIN;
+    bool found = false;
+    for (; pf < lim; pf++) {
+        const float f = *pf;
+        if (!std::isnan(f)) {
+            max = std::max(max, f);
+            found = true;
+        }
+    }
+    return found ? max : NAN;
+}
+
 int64_t countLong_Vanilla(int64_t *pl, int64_t count) {
     if (count == 0) {
         return 0;
@@ -266,6 +385,43 @@ int64_t maxLong_Vanilla(int64_t *pl, int64_t count) {
     return max;
 }
 
+void statsLong_Vanilla(int64_t *pl, int64_t count, column_stats_t<int64_t> *stats) {
+    const int64_t *lim = pl + count;
+    int64_t cnt = 0;
+    int64_t sum = 0;
+    int64_t min = L_MIN;
+    int64_t max = L_MIN;
+    for (; pl < lim; pl++) {
+        const int64_t l = *pl;
+        if (l != L_MIN) {
+            cnt++;
+            sum += l;
+            if (l < min || min == L_MIN) {
+                min = l;
+            }
+            if (l > max) {
+                max = l;
+            }
+        }
+    }
+    stats->count = cnt;
+    stats->null_count = count - cnt;
+    stats->sum = cnt > 0 ? sum : L_MIN;
+    stats->min = min;
+    stats->max = max;
+}
+
+int64_t countLong128_Vanilla(int64_t *pl, int64_t count) {
+    const int64_t *lim = pl + 2 * count;
+    int64_t n = 0;
+    for (; pl < lim; pl += 2) {
+        if (pl[0] != L_MIN || pl[1] != L_MIN) {
+            n++;
+        }
+    }
+    return n;
+}
+
 int64_t sumShort_Vanilla(int16_t *ps, int64_t count) {
     if (count == 0) {
         return L_MIN;
@@ -309,6 +465,64 @@ int32_t maxShort_Vanilla(int16_t *ps, int64_t count) {
     return max;
 }
 
+int64_t sumByte_Vanilla(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return L_MIN;
+    }
+    const int8_t *lim = pb + count;
+    int64_t sum = 0;
+    for (; pb < lim; pb++) {
+        sum += *pb;
+    }
+    return sum;
+}
+
+int32_t minByte_Vanilla(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int8_t *lim = pb + count;
+    int32_t min = I_MAX;
+    for (; pb < lim; pb++) {
+        min = std::min(min, (int32_t) *pb);
+    }
+    return min;
+}
+
+int32_t maxByte_Vanilla(int8_t *pb, int64_t count) {
+    if (count == 0) {
+        return I_MIN;
+    }
+    const int8_t *lim = pb + count;
+    int32_t max = I_MIN;
+    for (; pb < lim; pb++) {
+        max = std::max(max, (int32_t) *pb);
+    }
+    return max;
+}
+
+// char 0 is null, it is skipped by min() and returned when there is nothing else
+int32_t minChar_Vanilla(uint16_t *pc, int64_t count) {
+    const uint16_t *lim = pc + count;
+    int32_t min = 0;
+    for (; pc < lim; pc++) {
+        const uint16_t c = *pc;
+        if (c != 0 && (c < min || min == 0)) {
+            min = c;
+        }
+    }
+    return min;
+}
+
+int32_t maxChar_Vanilla(uint16_t *pc, int64_t count) {
+    const uint16_t *lim = pc + count;
+    int32_t max = 0;
+    for (; pc < lim; pc++) {
+        max = std::max(max, (int32_t) *pc);
+    }
+    return max;
+}
+
 extern "C" {
 
 JNIEXPORT jdouble JNICALL
@@ -25,6 +25,8 @@
 #ifndef VECT_VANILLA_H
 #define VECT_VANILLA_H
 
+#include "util.h"
+
 int64_t countDouble_Vanilla(double *d, int64_t count);
 
 double sumDouble_Vanilla(double *d, int64_t count);
@@ -37,6 +39,18 @@ double minDouble_Vanilla(double *d, int64_t count);
 
 double maxDouble_Vanilla(double *d, int64_t count);
 
+void varianceDouble_Vanilla(double *d, int64_t count, welford_t *state);
+
+void statsDouble_Vanilla(double *d, int64_t count, column_stats_t<double> *stats);
+
+int64_t countFloat_Vanilla(float *pf, int64_t count);
+
+double sumFloat_Vanilla(float *pf, int64_t count);
+
+float minFloat_Vanilla(float *pf, int64_t count);
+
+float maxFloat_Vanilla(float *pf, int64_t count);
+
 int64_t countInt_Vanilla(int32_t *pi, int64_t count);
 
 int64_t sumInt_Vanilla(int32_t *pi, int64_t count);
@@ -45,6 +59,8 @@ int32_t minInt_Vanilla(int32_t *pi, int64_t count);
 
 int32_t maxInt_Vanilla(int32_t *pi, int64_t count);
 
+void statsInt_Vanilla(int32_t *pi, int64_t count, column_stats_t<int64_t> *stats);
+
 int64_t countLong_Vanilla(int64_t *pl, int64_t count);
 
 int64_t sumLong_Vanilla(int64_t *pl, int64_t count);
@@ -53,10 +69,24 @@ int64_t minLong_Vanilla(int64_t *pl, int64_t count);
 
 int64_t maxLong_Vanilla(int64_t *pl, int64_t count);
 
+void statsLong_Vanilla(int64_t *pl, int64_t count, column_stats_t<int64_t> *stats);
+
+int64_t countLong128_Vanilla(int64_t *pl, int64_t count);
+
 int64_t sumShort_Vanilla(int16_t *ps, int64_t count);
 
 int32_t minShort_Vanilla(int16_t *ps, int64_t count);
 
 int32_t maxShort_Vanilla(int16_t *ps, int64_t count);
 
+int64_t sumByte_Vanilla(int8_t *pb, int64_t count);
+
+int32_t minByte_Vanilla(int8_t *pb, int64_t count);
+
+int32_t maxByte_Vanilla(int8_t *pb, int64_t count);
+
+int32_t minChar_Vanilla(uint16_t *pc, int64_t count);
+
+int32_t maxChar_Vanilla(uint16_t *pc, int64_t count);
+
 #endif //VECT_VANILLA_H
@@ -24,6 +24,7 @@
  ******************************************************************************/
 
 #include "rosti.h"
+#include "perf_counters.h"
 #include <functional>
 #include <cstdlib>
 
@@ -96,7 +97,8 @@ struct long256_t {
     }
 
     [[nodiscard]] bool is_null() const {
-        return l0 == L_MIN && l1 == L_MIN && l2 == L_MIN && l3 == L_MIN;
+        constexpr auto null = static_cast<uint64_t>(L_MIN);
+        return l0 == null && l1 == null && l2 == null && l3 == null;
     }
 
     void operator+=(const long256_t &rhs) {
@@ -132,8 +134,6 @@ struct long256_t {
 
 typedef long128_t accumulator_t;
 
-typedef int32_t (*to_int_fn)(jlong, int);
-
 inline int32_t int64_to_hour(jlong ptr, int i) {
     const auto p = reinterpret_cast<int64_t *>(ptr);
     MM_PREFETCH_T0(p + i + 64);
@@ -151,22 +151,147 @@ inline int32_t to_int(jlong ptr, int i) {
     return p[i];
 }
 
-static jboolean kIntMaxInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
+inline int64_t to_long(jlong ptr, int i) {
+    const auto p = reinterpret_cast<int64_t *>(ptr);
+    MM_PREFETCH_T0(p + i + 32);
+    return p[i];
+}
+
+inline key128_t to_long128(jlong ptr, int i) {
+    const auto p = reinterpret_cast<key128_t *>(ptr);
+    MM_PREFETCH_T0(p + i + 16);
+    return p[i];
+}
+
+// STRING keys, "ptr" is an address of data and index column addresses
+// index holds 64-bit offsets of the values in data, value is 32-bit length in chars followed by UTF-16 chars
+inline str_key_t to_str(jlong ptr, int i) {
+    const auto columns = reinterpret_cast<const unsigned char **>(ptr);
+    const auto index = reinterpret_cast<const int64_t *>(columns[1]);
+    MM_PREFETCH_T0(index + i + 32);
+    const auto value = columns[0] + index[i];
+    const auto len = *reinterpret_cast<const int32_t *>(value);
+    const auto chars = reinterpret_cast<const uint16_t *>(value + sizeof(int32_t));
+    return {hashStr(chars, len), len, chars};
+}
+
+// pair of INT or SYMBOL keys packed into one 64-bit key, first key in the high half, "ptr" is an address
+// of the two column addresses, column of zero address is a column top and its keys are null
+inline int64_t to_int_pair(jlong ptr, int i) {
+    const auto columns = reinterpret_cast<const int32_t **>(ptr);
+    const auto hi = columns[0];
+    const auto lo = columns[1];
+    MM_PREFETCH_T0(hi + i + 64);
+    MM_PREFETCH_T0(lo + i + 64);
+    const int32_t k0 = hi != nullptr ? hi[i] : I_MIN;
+    const int32_t k1 = lo != nullptr ? lo[i] : I_MIN;
+    return static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(k0)) << 32) | static_cast<uint32_t>(k1));
+}
+
+template<typename K>
+inline void set_key(unsigned char *dest, const K key) {
+    *reinterpret_cast<K *>(dest) = key;
+}
+
+// find() sets STRING key of the slot it inserts
+inline void set_key(unsigned char *dest, const str_key_t &key) {
+}
+
+// key of the slot, as it is looked up in another map
+template<typename K>
+inline K slot_key(const rosti_t *map, const unsigned char *p) {
+    return *reinterpret_cast<const K *>(p);
+}
+
+template<>
+inline str_key_t slot_key<str_key_t>(const rosti_t *map, const unsigned char *p) {
+    return str_key_of(map, p);
+}
+
+// Keys are hashed and their probes prefetched one block ahead of the rows being aggregated.
+// While a kernel works through one block of ROSTI_BATCH_SIZE rows, control bytes and slots
+// of the next block are on their way into cache. Prefetches made stale by a resize cost a
+// wasted cache line, the lookup itself only relies on the hash. Maps that fit in cache have
+// nothing to wait for, their keys are looked up as they are read.
+constexpr jlong ROSTI_BATCH_SIZE = 16;
+constexpr uint64_t ROSTI_PREFETCH_MIN_SIZE = 512 * 1024;
+
+template<typename TO_KEY>
+class key_batch {
+public:
+    using key_t = decltype(std::declval<TO_KEY>()(jlong{}, int{}));
+
+    key_batch(rosti_t *map, TO_KEY to_key, jlong pKeys, jlong count)
+            : map_(map), to_key_(to_key), p_keys_(pKeys), count_(count),
+              pipelined_(((map->capacity_ + 1) << map->slot_size_shift_) >= ROSTI_PREFETCH_MIN_SIZE) {
+        if (pipelined_) {
+            load(0);
+        }
+    }
+
+    // must be called for every row, in order, before the row key is looked up
+    inline void next(jlong i) {
+        if (pipelined_) {
+            if ((i & (ROSTI_BATCH_SIZE - 1)) == 0) {
+                load(i + ROSTI_BATCH_SIZE);
+            }
+        } else {
+            key_ = to_key_(p_keys_, static_cast<int>(i));
+        }
+    }
+
+    [[nodiscard]] inline key_t key(jlong i) const { return pipelined_ ? keys_[i & RING_MASK] : key_; }
+
+    inline std::pair<uint64_t, bool> find(jlong i) const {
+        if (pipelined_) {
+            const auto j = i & RING_MASK;
+            return ::find(map_, keys_[j], hashes_[j]);
+        }
+        return ::find(map_, key_);
+    }
+
+private:
+    static constexpr jlong RING_MASK = 2 * ROSTI_BATCH_SIZE - 1;
+
+    inline void load(jlong lo) {
+        const jlong hi = std::min(lo + ROSTI_BATCH_SIZE, count_);
+        for (jlong i = lo; i < hi; i++) {
+            const auto j = i & RING_MASK;
+            keys_[j] = to_key_(p_keys_, static_cast<int>(i));
+            hashes_[j] = hash_of(keys_[j]);
+            prefetch_probe(map_, hashes_[j]);
+        }
+    }
+
+    rosti_t *map_;
+    TO_KEY to_key_;
+    const jlong p_keys_;
+    const jlong count_;
+    const bool pipelined_;
+    key_t key_{};
+    key_t keys_[2 * ROSTI_BATCH_SIZE];
+    uint64_t hashes_[2 * ROSTI_BATCH_SIZE];
+};
+
+template<typename TO_KEY>
+static jboolean kIntMaxInt(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jint *>(pInt);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 16);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jint val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             *reinterpret_cast<jint *>(pVal) = val;
         } else {
             const jint old = *reinterpret_cast<jint *>(pVal);
@@ -176,22 +301,25 @@ static jboolean kIntMaxInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pI
     return JNI_TRUE;
 }
 
-static jboolean kIntMaxLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntMaxLong(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pl = reinterpret_cast<jlong *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pl + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jlong val = pl[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             *reinterpret_cast<jlong *>(pVal) = val;
         } else {
             const jlong old = *reinterpret_cast<jlong *>(pVal);
@@ -201,23 +329,26 @@ static jboolean kIntMaxLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong p
     return JNI_TRUE;
 }
 
+template<typename TO_KEY>
 static jboolean
-kIntMaxDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+kIntMaxDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pd = reinterpret_cast<jdouble *>(pDouble);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pd + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jdouble d = pd[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             *reinterpret_cast<jdouble *>(pVal) = std::isnan(d) ? D_MIN : d;
         } else {
             const jdouble old = *reinterpret_cast<jdouble *>(pVal);
@@ -227,22 +358,25 @@ kIntMaxDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong
     return JNI_TRUE;
 }
 
-static jboolean kIntMinInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntMinInt(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jint *>(pInt);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 16);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jint val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             if (val != I_MIN) {
                 *reinterpret_cast<jint *>(pVal) = val;
             }
@@ -258,22 +392,25 @@ static jboolean kIntMinInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pI
     return JNI_TRUE;
 }
 
-static jboolean kIntMinLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntMinLong(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jlong *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 16);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jlong val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             if (val != L_MIN) {
                 *reinterpret_cast<jlong *>(pVal) = val;
             }
@@ -289,22 +426,25 @@ static jboolean kIntMinLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong p
     return JNI_TRUE;
 }
 
-static jboolean kIntMinShort(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntMinShort(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jshort *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jshort val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             *reinterpret_cast<jlong *>(pVal) = val;
         } else {
             const jlong old = *reinterpret_cast<jlong *>(pVal);
@@ -318,22 +458,25 @@ static jboolean kIntMinShort(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong
     return JNI_TRUE;
 }
 
-static jboolean kIntMaxShort(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntMaxShort(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jshort *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jshort val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             *reinterpret_cast<jlong *>(pVal) = val;
         } else {
             const jlong old = *reinterpret_cast<jlong *>(pVal);
@@ -343,23 +486,209 @@ static jboolean kIntMaxShort(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong
     return JNI_TRUE;
 }
 
+template<typename TO_KEY>
+static jboolean
+kIntMinByte(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pByte, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pb = reinterpret_cast<jbyte *>(pByte);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pb + i + 16);
+        const auto key = batch.key(i);
+        const jbyte val = pb[i];
+        auto res = batch.find(i);
+        auto pKey = map->slots_ + res.first;
+        auto pVal = pKey + value_offset;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(pKey, key);
+            *reinterpret_cast<jlong *>(pVal) = val;
+        } else {
+            const jlong old = *reinterpret_cast<jlong *>(pVal);
+            if (old != L_MIN) {
+                *reinterpret_cast<jlong *>(pVal) = MIN(val, (jbyte) old);
+            } else {
+                *reinterpret_cast<jlong *>(pVal) = val;
+            }
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
+static jboolean
+kIntMaxByte(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pByte, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pb = reinterpret_cast<jbyte *>(pByte);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pb + i + 16);
+        const auto key = batch.key(i);
+        const jbyte val = pb[i];
+        auto res = batch.find(i);
+        auto pKey = map->slots_ + res.first;
+        auto pVal = pKey + value_offset;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(pKey, key);
+            *reinterpret_cast<jlong *>(pVal) = val;
+        } else {
+            // the slot is L_MIN when the key came from a column top frame, narrowing it would give 0
+            const jlong old = *reinterpret_cast<jlong *>(pVal);
+            *reinterpret_cast<jlong *>(pVal) = MAX((jlong) val, old);
+        }
+    }
+    return JNI_TRUE;
+}
+
+// char 0 is null, the slot stays L_MIN until the key sees a non-null char
+template<typename TO_KEY>
+static jboolean
+kIntMinChar(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pChar, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pc = reinterpret_cast<jchar *>(pChar);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pc + i + 8);
+        const auto key = batch.key(i);
+        const jchar val = pc[i];
+        auto res = batch.find(i);
+        auto pKey = map->slots_ + res.first;
+        auto pVal = pKey + value_offset;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(pKey, key);
+            *reinterpret_cast<jlong *>(pVal) = val != 0 ? val : L_MIN;
+        } else {
+            if (val != 0) {
+                const jlong old = *reinterpret_cast<jlong *>(pVal);
+                *reinterpret_cast<jlong *>(pVal) = old != L_MIN ? MIN((jlong) val, old) : val;
+            }
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
+static jboolean
+kIntMaxChar(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pChar, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pc = reinterpret_cast<jchar *>(pChar);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pc + i + 8);
+        const auto key = batch.key(i);
+        const jchar val = pc[i];
+        auto res = batch.find(i);
+        auto pKey = map->slots_ + res.first;
+        auto pVal = pKey + value_offset;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(pKey, key);
+            *reinterpret_cast<jlong *>(pVal) = val;
+        } else {
+            const jlong old = *reinterpret_cast<jlong *>(pVal);
+            *reinterpret_cast<jlong *>(pVal) = MAX((jlong) val, old);
+        }
+    }
+    return JNI_TRUE;
+}
+
+// float min and max are kept in double slots, so the double merge and wrap up functions apply
+template<typename TO_KEY>
+static jboolean
+kIntMinFloat(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pf = reinterpret_cast<jfloat *>(pFloat);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pf + i + 16);
+        const auto key = batch.key(i);
+        const jfloat val = pf[i];
+        auto res = batch.find(i);
+        auto pKey = map->slots_ + res.first;
+        auto pVal = pKey + value_offset;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(pKey, key);
+            *reinterpret_cast<jdouble *>(pVal) = std::isnan(val) ? D_MAX : val;
+        } else {
+            const jdouble old = *reinterpret_cast<jdouble *>(pVal);
+            *reinterpret_cast<jdouble *>(pVal) = MIN((std::isnan(val) ? D_MAX : val), old);
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
+static jboolean
+kIntMaxFloat(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pf = reinterpret_cast<jfloat *>(pFloat);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pf + i + 16);
+        const auto key = batch.key(i);
+        const jfloat val = pf[i];
+        auto res = batch.find(i);
+        auto pKey = map->slots_ + res.first;
+        auto pVal = pKey + value_offset;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(pKey, key);
+            *reinterpret_cast<jdouble *>(pVal) = std::isnan(val) ? D_MIN : val;
+        } else {
+            const jdouble old = *reinterpret_cast<jdouble *>(pVal);
+            *reinterpret_cast<jdouble *>(pVal) = MAX((std::isnan(val) ? D_MIN : val), old);
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
 static jboolean
-kIntMinDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+kIntMinDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pd = reinterpret_cast<jdouble *>(pDouble);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pd + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jdouble d = pd[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto pKey = map->slots_ + res.first;
         auto pVal = pKey + value_offset;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(pKey) = key;
+            set_key(pKey, key);
             *reinterpret_cast<jdouble *>(pVal) = std::isnan(d) ? D_MAX : d;
         } else {
             const jdouble old = *reinterpret_cast<jdouble *>(pVal);
@@ -369,20 +698,23 @@ kIntMinDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong
     return JNI_TRUE;
 }
 
-static jboolean kIntCountLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntCountLong(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pl = reinterpret_cast<jlong *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
-        const int32_t key = to_int(pKeys, i);
+        batch.next(i);
+        const auto key = batch.key(i);
         const jlong val = pl[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             if (PREDICT_FALSE(val == L_MIN)) {
                 *reinterpret_cast<jlong *>(dest + value_offset) = 0;
             } else {
@@ -397,19 +729,47 @@ static jboolean kIntCountLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong
     return JNI_TRUE;
 }
 
+// a 128-bit value is null when both of its longs are L_MIN
+template<typename TO_KEY>
+static jboolean
+kIntCountLong128(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong128, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pl = reinterpret_cast<jlong *>(pLong128);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        const auto key = batch.key(i);
+        const jlong notNull = pl[2 * i] != L_MIN || pl[2 * i + 1] != L_MIN ? 1 : 0;
+        auto res = batch.find(i);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(dest, key);
+            *reinterpret_cast<jlong *>(dest + value_offset) = notNull;
+        } else {
+            *reinterpret_cast<jlong *>(dest + value_offset) += notNull;
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename K>
 static jboolean kIntCountWrapUp(jlong pRosti, jint valueOffset, jlong valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
 
     if (valueAtNull > -1) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jlong *>(dest + value_offset) = valueAtNull;
         } else {
             *reinterpret_cast<jlong *>(dest + value_offset) += valueAtNull;
@@ -419,24 +779,26 @@ static jboolean kIntCountWrapUp(jlong pRosti, jint valueOffset, jlong valueAtNul
 }
 
 
-template<typename T>
-static jboolean kIntSumLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+template<typename T, typename TO_KEY>
+static jboolean kIntSumLong(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     constexpr auto count_idx = sizeof(T) == 8 ? 1 : 2;
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pl = reinterpret_cast<jlong *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + count_idx];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pl + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jlong val = pl[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             if (PREDICT_FALSE(val == L_MIN)) {
                 *reinterpret_cast<T *>(dest + value_offset) = 0;
                 *reinterpret_cast<jlong *>(dest + count_offset) = 0;
@@ -454,24 +816,26 @@ static jboolean kIntSumLong(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong p
     return JNI_TRUE;
 }
 
-template<typename T>
-static jboolean kIntSumShort(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pShort, jlong count, jint valueOffset) {
+template<typename T, typename TO_KEY>
+static jboolean kIntSumShort(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pShort, jlong count, jint valueOffset) {
     constexpr auto count_idx = sizeof(T) == 8 ? 1 : 2;
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *ps = reinterpret_cast<jshort *>(pShort);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + count_idx];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(ps + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jshort val = ps[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             *reinterpret_cast<T *>(dest + value_offset) = val;
             *reinterpret_cast<jlong *>(dest + count_offset) = 1;
         } else {
@@ -482,24 +846,56 @@ static jboolean kIntSumShort(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong
     return JNI_TRUE;
 }
 
+template<typename TO_KEY>
+static jboolean kIntSumByte(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pByte, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pb = reinterpret_cast<jbyte *>(pByte);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    const auto count_offset = map->value_offsets_[valueOffset + 1];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pb + i + 16);
+        const auto key = batch.key(i);
+        const jbyte val = pb[i];
+        auto res = batch.find(i);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(dest, key);
+            *reinterpret_cast<jlong *>(dest + value_offset) = val;
+            *reinterpret_cast<jlong *>(dest + count_offset) = 1;
+        } else {
+            *reinterpret_cast<jlong *>(dest + value_offset) += val;
+            *reinterpret_cast<jlong *>(dest + count_offset) += 1;
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
 static jboolean
-kIntSumLong256(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+kIntSumLong256(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
 
     const auto *pl = reinterpret_cast<long256_t *>(pLong);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + 1];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pl + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const long256_t &val = pl[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             long256_t &dst = *reinterpret_cast<long256_t *>(dest + value_offset);
             if (PREDICT_FALSE(val.is_null())) {
                 *reinterpret_cast<jlong *>(dest + count_offset) = 0;
@@ -519,11 +915,13 @@ kIntSumLong256(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pLong, jlong c
     return JNI_TRUE;
 }
 
+template<typename K>
 static jboolean kIntSumLong256Merge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
     const auto count_offset = map_b->value_offsets_[valueOffset + 1];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -533,7 +931,7 @@ static jboolean kIntSumLong256Merge(jlong pRostiA, jlong pRostiB, jint valueOffs
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto val = *reinterpret_cast<long256_t *>(src + value_offset);
             auto count = *reinterpret_cast<jlong *>(src + count_offset);
 
@@ -544,7 +942,7 @@ static jboolean kIntSumLong256Merge(jlong pRostiA, jlong pRostiB, jint valueOffs
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
             }
 
             // when maps have non-null values, their count is >0 and val is not MIN
@@ -563,11 +961,13 @@ static jboolean kIntSumLong256Merge(jlong pRostiA, jlong pRostiB, jint valueOffs
     return JNI_TRUE;
 }
 
+template<typename K>
 static jboolean
 kIntSumLong256WrapUp(jlong pRosti, jint valueOffset, jlong n0, jlong n1, jlong n2, jlong n3, jlong valueAtNullCount) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + 1];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -587,7 +987,7 @@ kIntSumLong256WrapUp(jlong pRosti, jint valueOffset, jlong n0, jlong n1, jlong n
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -596,7 +996,7 @@ kIntSumLong256WrapUp(jlong pRosti, jint valueOffset, jlong n0, jlong n1, jlong n
                 return JNI_FALSE;
             }
             long256_t &dst = *reinterpret_cast<long256_t *>(dest + value_offset);
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             dst = long256_t(n0, n1, n2, n3);
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
         } else {
@@ -609,25 +1009,28 @@ kIntSumLong256WrapUp(jlong pRosti, jint valueOffset, jlong n0, jlong n1, jlong n
     return JNI_TRUE;
 }
 
+template<typename TO_KEY>
 static jboolean
-kIntNSumDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+kIntNSumDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pd = reinterpret_cast<jdouble *>(pDouble);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto c_offset = map->value_offsets_[valueOffset + 1];
     const auto count_offset = map->value_offsets_[valueOffset + 2];
 
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pd + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jdouble d = pd[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             *reinterpret_cast<jdouble *>(dest + value_offset) = std::isnan(d) ? 0 : d;
             *reinterpret_cast<jdouble *>(dest + c_offset) = 0.;
             *reinterpret_cast<jlong *>(dest + count_offset) = std::isnan(d) ? 0 : 1;
@@ -647,21 +1050,24 @@ kIntNSumDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong
     return JNI_TRUE;
 }
 
-static jboolean kIntCountInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntCountInt(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jint *>(pInt);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 16);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jint val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             if (PREDICT_FALSE(val == I_MIN)) {
                 *reinterpret_cast<jlong *>(dest + value_offset) = 0;
             } else {
@@ -674,22 +1080,25 @@ static jboolean kIntCountInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong
     return JNI_TRUE;
 }
 
-static jboolean kIntSumInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntSumInt(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pi = reinterpret_cast<jint *>(pInt);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + 1];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pi + i + 16);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jint val = pi[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             if (PREDICT_FALSE(val == I_MIN)) {
                 *reinterpret_cast<jlong *>(dest + value_offset) = 0;
                 *reinterpret_cast<jlong *>(dest + count_offset) = 0;
@@ -705,38 +1114,44 @@ static jboolean kIntSumInt(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pI
     return JNI_TRUE;
 }
 
-static jboolean kIntDistinct(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong count) {
+template<typename TO_KEY>
+static jboolean kIntDistinct(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong count) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
-        const int32_t key = to_int(pKeys, i);
-        auto res = find(map, key);
+        batch.next(i);
+        const auto key = batch.key(i);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
         }
     }
     return JNI_TRUE;
 }
 
+template<typename TO_KEY>
 static jboolean
-kIntCountDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+kIntCountDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pd = reinterpret_cast<jdouble *>(pDouble);
     const auto count_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pd + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jdouble d = pd[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             *reinterpret_cast<jlong *>(dest + count_offset) = std::isnan(d) ? 0 : 1;
         } else {
             *reinterpret_cast<jlong *>(dest + count_offset) += std::isnan(d) ? 0 : 1;
@@ -746,23 +1161,26 @@ kIntCountDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlon
 }
 
 
+template<typename TO_KEY>
 static jboolean
-kIntSumDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+kIntSumDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pd = reinterpret_cast<jdouble *>(pDouble);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + 1];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pd + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jdouble d = pd[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             *reinterpret_cast<jdouble *>(dest + value_offset) = std::isnan(d) ? 0 : d;
             *reinterpret_cast<jlong *>(dest + count_offset) = std::isnan(d) ? 0 : 1;
         } else {
@@ -773,25 +1191,87 @@ kIntSumDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong
     return JNI_TRUE;
 }
 
+template<typename TO_KEY>
+static jboolean
+kIntCountFloat(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pf = reinterpret_cast<jfloat *>(pFloat);
+    const auto count_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pf + i + 16);
+        const auto key = batch.key(i);
+        const jfloat f = pf[i];
+        auto res = batch.find(i);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(dest, key);
+            *reinterpret_cast<jlong *>(dest + count_offset) = std::isnan(f) ? 0 : 1;
+        } else {
+            *reinterpret_cast<jlong *>(dest + count_offset) += std::isnan(f) ? 0 : 1;
+        }
+    }
+    return JNI_TRUE;
+}
+
+// sum(float) skips non-finite values, the sum is accumulated in a double slot
+template<typename TO_KEY>
+static jboolean
+kIntSumFloat(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pf = reinterpret_cast<jfloat *>(pFloat);
+    const auto value_offset = map->value_offsets_[valueOffset];
+    const auto count_offset = map->value_offsets_[valueOffset + 1];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pf + i + 16);
+        const auto key = batch.key(i);
+        const jfloat f = pf[i];
+        const bool finite = std::isfinite(f);
+        auto res = batch.find(i);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(dest, key);
+            *reinterpret_cast<jdouble *>(dest + value_offset) = finite ? f : 0;
+            *reinterpret_cast<jlong *>(dest + count_offset) = finite ? 1 : 0;
+        } else {
+            *reinterpret_cast<jdouble *>(dest + value_offset) += finite ? f : 0;
+            *reinterpret_cast<jlong *>(dest + count_offset) += finite ? 1 : 0;
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
 static jboolean
-kIntKSumDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+kIntKSumDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto *pd = reinterpret_cast<jdouble *>(pDouble);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto c_offset = map->value_offsets_[valueOffset + 1];
     const auto count_offset = map->value_offsets_[valueOffset + 2];
 
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
+        batch.next(i);
         MM_PREFETCH_T0(pd + i + 8);
-        const int32_t key = to_int(pKeys, i);
+        const auto key = batch.key(i);
         const jdouble d = pd[i];
-        auto res = find(map, key);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             *reinterpret_cast<jdouble *>(dest + value_offset) = std::isnan(d) ? 0 : d;
             *reinterpret_cast<jdouble *>(dest + c_offset) = 0.;
             *reinterpret_cast<jlong *>(dest + count_offset) = std::isnan(d) ? 0 : 1;
@@ -809,18 +1289,21 @@ kIntKSumDouble(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong pDouble, jlong
     return JNI_TRUE;
 }
 
-static jboolean kIntCount(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong count, jint valueOffset) {
+template<typename TO_KEY>
+static jboolean kIntCount(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong count, jint valueOffset) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
     for (int i = 0; i < count; i++) {
-        auto const key = to_int(pKeys, i);
-        auto res = find(map, key);
+        batch.next(i);
+        const auto key = batch.key(i);
+        auto res = batch.find(i);
         auto dest = map->slots_ + res.first;
         if (PREDICT_FALSE(res.second)) {
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = key;
+            set_key(dest, key);
             *reinterpret_cast<jlong *>(dest + value_offset) = 1;
         } else {
             (*reinterpret_cast<jlong *>(dest + value_offset))++;
@@ -829,57 +1312,706 @@ static jboolean kIntCount(to_int_fn to_int, jlong pRosti, jlong pKeys, jlong cou
     return JNI_TRUE;
 }
 
-template<typename T>
-static jboolean kIntSumLongMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
-    constexpr auto count_idx = sizeof(T) == 8 ? 1 : 2;
-    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
-    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
-    const auto value_offset = map_b->value_offsets_[valueOffset];
-    const auto count_offset = map_b->value_offsets_[valueOffset + count_idx];
-    const auto capacity = map_b->capacity_;
-    const auto ctrl = map_b->ctrl_;
-    const auto shift = map_b->slot_size_shift_;
-    const auto slots = map_b->slots_;
-
-    for (size_t i = 0; i < capacity; i++) {
-        ctrl_t c = ctrl[i];
-        if (c > -1) {
-            auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
-            auto val = *reinterpret_cast<T *>(src + value_offset);
-            auto count = *reinterpret_cast<jlong *>(src + count_offset);
+// Aggregate ops of the fused kernel, keep in sync with Rosti.AGG_* constants.
+// Slot layout of every op is the same as that of the matching single aggregate kernel.
+enum agg_op : int32_t {
+    AGG_COUNT = 0,
+    AGG_COUNT_DOUBLE = 1,
+    AGG_COUNT_INT = 2,
+    AGG_COUNT_LONG = 3,
+    AGG_SUM_DOUBLE = 4,
+    AGG_KSUM_DOUBLE = 5,
+    AGG_NSUM_DOUBLE = 6,
+    AGG_MIN_DOUBLE = 7,
+    AGG_MAX_DOUBLE = 8,
+    AGG_SUM_INT = 9,
+    AGG_MIN_INT = 10,
+    AGG_MAX_INT = 11,
+    AGG_SUM_LONG = 12,
+    AGG_SUM_LONG_LONG = 13,
+    AGG_MIN_LONG = 14,
+    AGG_MAX_LONG = 15,
+    AGG_SUM_LONG256 = 16,
+    AGG_SUM_SHORT = 17,
+    AGG_SUM_SHORT_LONG = 18,
+    AGG_MIN_SHORT = 19,
+    AGG_MAX_SHORT = 20
+};
 
-            auto res = find(map_a, key);
-            auto dest = map_a->slots_ + res.first;
+// Aggregate descriptor as written by Rosti.putAggDescriptor()
+struct agg_descriptor_t {
+    jlong values;
+    jint op;
+    jint value_index;
+};
 
-            if (PREDICT_FALSE(res.second)) {
-                if (PREDICT_FALSE(res.first == UL_MAX)) {
-                    return JNI_FALSE;
-                }
-                *reinterpret_cast<int32_t *>(dest) = key;
-            }
+// Descriptor resolved against map layout, offsets are in bytes
+struct agg_t {
+    const void *values;
+    int32_t op;
+    int32_t value_offset;
+    // compensation or count, depending on op
+    int32_t offset1;
+    int32_t offset2;
+};
 
-            // when maps have non-null values, their count is >0 and val is not MIN
-            // on other hand
-            const jlong old_count = *reinterpret_cast<jlong *>(dest + count_offset);
-            if (old_count > 0 && count > 0) {
-                *reinterpret_cast<accumulator_t *>(dest + value_offset) += val;
-                *reinterpret_cast<jlong *>(dest + count_offset) += count;
-            } else {
-                *reinterpret_cast<T *>(dest + value_offset) = val;
-                *reinterpret_cast<jlong *>(dest + count_offset) = count;
-            }
-        }
-    }
-    return JNI_TRUE;
+template<typename T>
+inline T &slot_value(unsigned char *dest, const int32_t offset) {
+    return *reinterpret_cast<T *>(dest + offset);
 }
 
 template<typename T>
-static jboolean kIntSumLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtNull, jlong valueAtNullCount) {
+inline T column_value(const agg_t &agg, const int i) {
+    return reinterpret_cast<const T *>(agg.values)[i];
+}
+
+static void resolve_agg(const rosti_t *map, const agg_descriptor_t &descriptor, agg_t &agg) {
+    const auto index = descriptor.value_index;
+    agg.values = reinterpret_cast<const void *>(descriptor.values);
+    agg.op = descriptor.op;
+    agg.value_offset = map->value_offsets_[index];
+    agg.offset1 = 0;
+    agg.offset2 = 0;
+    switch (descriptor.op) {
+        case AGG_SUM_DOUBLE:
+        case AGG_SUM_INT:
+        case AGG_SUM_LONG:
+        case AGG_SUM_LONG256:
+        case AGG_SUM_SHORT:
+            agg.offset1 = map->value_offsets_[index + 1];
+            break;
+        case AGG_SUM_LONG_LONG:
+        case AGG_SUM_SHORT_LONG:
+            // 128-bit accumulator takes two value columns
+            agg.offset1 = map->value_offsets_[index + 2];
+            break;
+        case AGG_KSUM_DOUBLE:
+        case AGG_NSUM_DOUBLE:
+            agg.offset1 = map->value_offsets_[index + 1];
+            agg.offset2 = map->value_offsets_[index + 2];
+            break;
+        default:
+            break;
+    }
+}
+
+// first value of the new key
+static void agg_init(const agg_t &agg, unsigned char *dest, const int i) {
+    switch (agg.op) {
+        case AGG_COUNT:
+            slot_value<jlong>(dest, agg.value_offset) = 1;
+            break;
+        case AGG_COUNT_DOUBLE:
+            slot_value<jlong>(dest, agg.value_offset) = std::isnan(column_value<jdouble>(agg, i)) ? 0 : 1;
+            break;
+        case AGG_COUNT_INT:
+            slot_value<jlong>(dest, agg.value_offset) = column_value<jint>(agg, i) == I_MIN ? 0 : 1;
+            break;
+        case AGG_COUNT_LONG:
+            slot_value<jlong>(dest, agg.value_offset) = column_value<jlong>(agg, i) == L_MIN ? 0 : 1;
+            break;
+        case AGG_SUM_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            slot_value<jdouble>(dest, agg.value_offset) = std::isnan(d) ? 0 : d;
+            slot_value<jlong>(dest, agg.offset1) = std::isnan(d) ? 0 : 1;
+            break;
+        }
+        case AGG_KSUM_DOUBLE:
+        case AGG_NSUM_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            slot_value<jdouble>(dest, agg.value_offset) = std::isnan(d) ? 0 : d;
+            slot_value<jdouble>(dest, agg.offset1) = 0.;
+            slot_value<jlong>(dest, agg.offset2) = std::isnan(d) ? 0 : 1;
+            break;
+        }
+        case AGG_MIN_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            slot_value<jdouble>(dest, agg.value_offset) = std::isnan(d) ? D_MAX : d;
+            break;
+        }
+        case AGG_MAX_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            slot_value<jdouble>(dest, agg.value_offset) = std::isnan(d) ? D_MIN : d;
+            break;
+        }
+        case AGG_SUM_INT: {
+            const jint val = column_value<jint>(agg, i);
+            slot_value<jlong>(dest, agg.value_offset) = val == I_MIN ? 0 : val;
+            slot_value<jlong>(dest, agg.offset1) = val == I_MIN ? 0 : 1;
+            break;
+        }
+        case AGG_MIN_INT: {
+            const jint val = column_value<jint>(agg, i);
+            if (val != I_MIN) {
+                slot_value<jint>(dest, agg.value_offset) = val;
+            }
+            break;
+        }
+        case AGG_MAX_INT:
+            slot_value<jint>(dest, agg.value_offset) = column_value<jint>(agg, i);
+            break;
+        case AGG_SUM_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            slot_value<jlong>(dest, agg.value_offset) = val == L_MIN ? 0 : val;
+            slot_value<jlong>(dest, agg.offset1) = val == L_MIN ? 0 : 1;
+            break;
+        }
+        case AGG_SUM_LONG_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            slot_value<accumulator_t>(dest, agg.value_offset) = val == L_MIN ? 0 : val;
+            slot_value<jlong>(dest, agg.offset1) = val == L_MIN ? 0 : 1;
+            break;
+        }
+        case AGG_MIN_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            if (val != L_MIN) {
+                slot_value<jlong>(dest, agg.value_offset) = val;
+            }
+            break;
+        }
+        case AGG_MAX_LONG:
+            slot_value<jlong>(dest, agg.value_offset) = column_value<jlong>(agg, i);
+            break;
+        case AGG_SUM_LONG256: {
+            const auto &val = column_value<long256_t>(agg, i);
+            if (PREDICT_FALSE(val.is_null())) {
+                slot_value<long256_t>(dest, agg.value_offset) = long256_t(0, 0, 0, 0);
+                slot_value<jlong>(dest, agg.offset1) = 0;
+            } else {
+                slot_value<long256_t>(dest, agg.value_offset) = val;
+                slot_value<jlong>(dest, agg.offset1) = 1;
+            }
+            break;
+        }
+        case AGG_SUM_SHORT:
+            slot_value<jlong>(dest, agg.value_offset) = column_value<jshort>(agg, i);
+            slot_value<jlong>(dest, agg.offset1) = 1;
+            break;
+        case AGG_SUM_SHORT_LONG:
+            slot_value<accumulator_t>(dest, agg.value_offset) = column_value<jshort>(agg, i);
+            slot_value<jlong>(dest, agg.offset1) = 1;
+            break;
+        case AGG_MIN_SHORT:
+        case AGG_MAX_SHORT:
+            slot_value<jlong>(dest, agg.value_offset) = column_value<jshort>(agg, i);
+            break;
+        default:
+            break;
+    }
+}
+
+// next value of the existing key
+static void agg_update(const agg_t &agg, unsigned char *dest, const int i) {
+    switch (agg.op) {
+        case AGG_COUNT:
+            slot_value<jlong>(dest, agg.value_offset)++;
+            break;
+        case AGG_COUNT_DOUBLE:
+            slot_value<jlong>(dest, agg.value_offset) += std::isnan(column_value<jdouble>(agg, i)) ? 0 : 1;
+            break;
+        case AGG_COUNT_INT:
+            slot_value<jlong>(dest, agg.value_offset) += column_value<jint>(agg, i) == I_MIN ? 0 : 1;
+            break;
+        case AGG_COUNT_LONG:
+            slot_value<jlong>(dest, agg.value_offset) += column_value<jlong>(agg, i) == L_MIN ? 0 : 1;
+            break;
+        case AGG_SUM_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            slot_value<jdouble>(dest, agg.value_offset) += std::isnan(d) ? 0 : d;
+            slot_value<jlong>(dest, agg.offset1) += std::isnan(d) ? 0 : 1;
+            break;
+        }
+        case AGG_KSUM_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            const jdouble c = slot_value<jdouble>(dest, agg.offset1);
+            const jdouble sum = slot_value<jdouble>(dest, agg.value_offset);
+            const jdouble y = std::isnan(d) ? 0 : d - c;
+            const jdouble t = sum + y;
+            slot_value<jdouble>(dest, agg.offset1) = t - sum - y;
+            slot_value<jdouble>(dest, agg.value_offset) = t;
+            slot_value<jlong>(dest, agg.offset2) += std::isnan(d) ? 0 : 1;
+            break;
+        }
+        case AGG_NSUM_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            const jdouble sum = slot_value<jdouble>(dest, agg.value_offset);
+            const jdouble x = std::isnan(d) ? 0 : d;
+            const jdouble t = sum + x;
+            if (std::abs(sum) >= x) {
+                slot_value<jdouble>(dest, agg.offset1) += (sum - t) + x;
+            } else {
+                slot_value<jdouble>(dest, agg.offset1) += (x - t) + sum;
+            }
+            slot_value<jdouble>(dest, agg.value_offset) = t;
+            slot_value<jlong>(dest, agg.offset2) += std::isnan(d) ? 0 : 1;
+            break;
+        }
+        case AGG_MIN_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            jdouble &old = slot_value<jdouble>(dest, agg.value_offset);
+            old = MIN((std::isnan(d) ? D_MAX : d), old);
+            break;
+        }
+        case AGG_MAX_DOUBLE: {
+            const jdouble d = column_value<jdouble>(agg, i);
+            jdouble &old = slot_value<jdouble>(dest, agg.value_offset);
+            old = MAX((std::isnan(d) ? D_MIN : d), old);
+            break;
+        }
+        case AGG_SUM_INT: {
+            const jint val = column_value<jint>(agg, i);
+            if (PREDICT_TRUE(val > I_MIN)) {
+                slot_value<jlong>(dest, agg.value_offset) += val;
+                slot_value<jlong>(dest, agg.offset1) += 1;
+            }
+            break;
+        }
+        case AGG_MIN_INT: {
+            const jint val = column_value<jint>(agg, i);
+            if (val != I_MIN) {
+                jint &old = slot_value<jint>(dest, agg.value_offset);
+                old = old != I_MIN ? MIN(val, old) : val;
+            }
+            break;
+        }
+        case AGG_MAX_INT: {
+            const jint val = column_value<jint>(agg, i);
+            jint &old = slot_value<jint>(dest, agg.value_offset);
+            old = MAX(val, old);
+            break;
+        }
+        case AGG_SUM_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            if (PREDICT_TRUE(val > L_MIN)) {
+                slot_value<jlong>(dest, agg.value_offset) += val;
+                slot_value<jlong>(dest, agg.offset1) += 1;
+            }
+            break;
+        }
+        case AGG_SUM_LONG_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            if (PREDICT_TRUE(val > L_MIN)) {
+                slot_value<accumulator_t>(dest, agg.value_offset) += val;
+                slot_value<jlong>(dest, agg.offset1) += 1;
+            }
+            break;
+        }
+        case AGG_MIN_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            if (val != L_MIN) {
+                jlong &old = slot_value<jlong>(dest, agg.value_offset);
+                old = old != L_MIN ? MIN(val, old) : val;
+            }
+            break;
+        }
+        case AGG_MAX_LONG: {
+            const jlong val = column_value<jlong>(agg, i);
+            jlong &old = slot_value<jlong>(dest, agg.value_offset);
+            old = MAX(val, old);
+            break;
+        }
+        case AGG_SUM_LONG256: {
+            const auto &val = column_value<long256_t>(agg, i);
+            if (PREDICT_TRUE(!val.is_null())) {
+                slot_value<long256_t>(dest, agg.value_offset) += val;
+                slot_value<jlong>(dest, agg.offset1) += 1;
+            }
+            break;
+        }
+        case AGG_SUM_SHORT:
+            slot_value<jlong>(dest, agg.value_offset) += column_value<jshort>(agg, i);
+            slot_value<jlong>(dest, agg.offset1) += 1;
+            break;
+        case AGG_SUM_SHORT_LONG:
+            slot_value<accumulator_t>(dest, agg.value_offset) += column_value<jshort>(agg, i);
+            slot_value<jlong>(dest, agg.offset1) += 1;
+            break;
+        case AGG_MIN_SHORT: {
+            const jshort val = column_value<jshort>(agg, i);
+            jlong &old = slot_value<jlong>(dest, agg.value_offset);
+            old = old != L_MIN ? MIN(val, (jshort) old) : val;
+            break;
+        }
+        case AGG_MAX_SHORT: {
+            const jshort val = column_value<jshort>(agg, i);
+            jlong &old = slot_value<jlong>(dest, agg.value_offset);
+            old = MAX(val, (jshort) old);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Fused kernel, probes the map once per row and updates all aggregates of the row.
+// "pAggs" is an array of "aggCount" descriptors, one per aggregate.
+template<typename TO_KEY>
+static jboolean
+kIntMultiAgg(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong count, jlong pAggs, jint aggCount) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *descriptors = reinterpret_cast<const agg_descriptor_t *>(pAggs);
+    auto *aggs = reinterpret_cast<agg_t *>(rosti_malloc(sizeof(agg_t) * aggCount));
+    if (aggs == nullptr) {
+        return JNI_FALSE;
+    }
+    for (int j = 0; j < aggCount; j++) {
+        resolve_agg(map, descriptors[j], aggs[j]);
+    }
+
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        const auto key = batch.key(i);
+        auto res = batch.find(i);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                free(aggs);
+                return JNI_FALSE;
+            }
+            set_key(dest, key);
+            for (int j = 0; j < aggCount; j++) {
+                agg_init(aggs[j], dest, i);
+            }
+        } else {
+            for (int j = 0; j < aggCount; j++) {
+                agg_update(aggs[j], dest, i);
+            }
+        }
+    }
+    free(aggs);
+    return JNI_TRUE;
+}
+
+// Dense accumulator for small key domains, such as hours of the day or symbol keys of a low
+// cardinality column. Keys in [key_min, key_min + key_count) index a flat array of slots, all other
+// keys, null included, fall back to the map. Dense slots have the layout of map slots and are
+// copied into the map by export_dense(), after that map merge and wrap-up functions apply as usual.
+struct dense_rosti_t {
+    rosti_t *map;
+    int64_t key_min;
+    int64_t key_count;
+    unsigned char *slots;
+    // one byte per key, non-zero once the key has been seen
+    uint8_t *seen;
+};
+
+// Sums and counts are accumulated in lane-private copies, so that runs of the same key
+// do not serialise on the same memory location, and folded into the slots after the frame.
+constexpr int DENSE_LANES = 4;
+constexpr int64_t DENSE_MAX_KEY_COUNT = 64 * 1024;
+
+static dense_rosti_t *alloc_dense(rosti_t *map, int64_t key_min, int64_t key_count) {
+    if (key_count < 1 || key_count > DENSE_MAX_KEY_COUNT) {
+        return nullptr;
+    }
+    auto dense = reinterpret_cast<dense_rosti_t *>(rosti_malloc(sizeof(dense_rosti_t)));
+    if (dense == nullptr) {
+        return nullptr;
+    }
+    auto mem = reinterpret_cast<unsigned char *>(rosti_malloc(key_count + (key_count << map->slot_size_shift_)));
+    if (mem == nullptr) {
+        free(dense);
+        return nullptr;
+    }
+    dense->map = map;
+    dense->key_min = key_min;
+    dense->key_count = key_count;
+    dense->seen = mem;
+    dense->slots = mem + key_count;
+    memset(dense->seen, 0, key_count);
+    return dense;
+}
+
+static void free_dense(dense_rosti_t *dense) {
+    free(dense->seen);
+    free(dense);
+}
+
+// Returns slot of the dense key, initialising it on first use
+inline unsigned char *dense_slot(dense_rosti_t *dense, const int64_t index, bool &first) {
+    const auto map = dense->map;
+    auto dest = dense->slots + (index << map->slot_size_shift_);
+    first = dense->seen[index] == 0;
+    if (PREDICT_FALSE(first)) {
+        dense->seen[index] = 1;
+        memcpy(dest, map->slot_initial_values_, map->slot_size_);
+        set_key(dest, static_cast<int32_t>(dense->key_min + index));
+    }
+    return dest;
+}
+
+static jboolean export_dense(dense_rosti_t *dense) {
+    const auto map = dense->map;
+    for (int64_t i = 0, n = dense->key_count; i < n; i++) {
+        if (dense->seen[i]) {
+            auto src = dense->slots + (i << map->slot_size_shift_);
+            auto res = find(map, *reinterpret_cast<int32_t *>(src));
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            // dense keys never reach the map, the slot is always new
+            memcpy(map->slots_ + res.first, src, map->slot_size_);
+        }
+    }
+    memset(dense->seen, 0, dense->key_count);
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
+static jboolean
+kIntDenseMultiAgg(TO_KEY to_key, jlong pDense, jlong pKeys, jlong count, jlong pAggs, jint aggCount) {
+    auto dense = reinterpret_cast<dense_rosti_t *>(pDense);
+    const auto map = dense->map;
+    const auto key_min = dense->key_min;
+    const auto key_count = static_cast<uint64_t>(dense->key_count);
+    const auto *descriptors = reinterpret_cast<const agg_descriptor_t *>(pAggs);
+    // no aggregates when value columns are all column tops, rows then only register their keys
+    agg_t *aggs = nullptr;
+    if (aggCount > 0) {
+        aggs = reinterpret_cast<agg_t *>(rosti_malloc(sizeof(agg_t) * aggCount));
+        if (aggs == nullptr) {
+            return JNI_FALSE;
+        }
+    }
+    for (int j = 0; j < aggCount; j++) {
+        resolve_agg(map, descriptors[j], aggs[j]);
+    }
+
+    for (int i = 0; i < count; i++) {
+        const auto key = to_key(pKeys, i);
+        const auto index = static_cast<uint64_t>(static_cast<int64_t>(key) - key_min);
+        bool first;
+        unsigned char *dest;
+        if (PREDICT_TRUE(index < key_count)) {
+            dest = dense_slot(dense, index, first);
+        } else {
+            auto res = find(map, key);
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                free(aggs);
+                return JNI_FALSE;
+            }
+            dest = map->slots_ + res.first;
+            first = res.second;
+            if (first) {
+                set_key(dest, key);
+            }
+        }
+        if (PREDICT_FALSE(first)) {
+            for (int j = 0; j < aggCount; j++) {
+                agg_init(aggs[j], dest, i);
+            }
+        } else {
+            for (int j = 0; j < aggCount; j++) {
+                agg_update(aggs[j], dest, i);
+            }
+        }
+    }
+    free(aggs);
+    return JNI_TRUE;
+}
+
+// Sum and non-null count of dense keys, accumulated in lane-private copies and folded into
+// the slots at the end of the frame. Rows of out of range keys are passed to "fallback".
+template<typename T, typename TO_KEY, typename IS_NULL, typename FALLBACK>
+static jboolean kIntDenseSum(
+        TO_KEY to_key,
+        dense_rosti_t *dense,
+        jlong pKeys,
+        const T *pv,
+        jlong count,
+        int32_t value_offset,
+        int32_t count_offset,
+        IS_NULL is_null,
+        FALLBACK fallback
+) {
+    const auto key_min = dense->key_min;
+    const auto key_count = static_cast<uint64_t>(dense->key_count);
+    const uint64_t lanes_size = DENSE_LANES * key_count;
+    auto mem = reinterpret_cast<unsigned char *>(rosti_malloc((sizeof(T) + sizeof(jlong)) * lanes_size + key_count));
+    if (mem == nullptr) {
+        return JNI_FALSE;
+    }
+    auto sums = reinterpret_cast<T *>(mem);
+    auto counts = reinterpret_cast<jlong *>(mem + sizeof(T) * lanes_size);
+    auto touched = mem + (sizeof(T) + sizeof(jlong)) * lanes_size;
+    memset(mem, 0, (sizeof(T) + sizeof(jlong)) * lanes_size + key_count);
+
+    for (int i = 0; i < count; i++) {
+        const auto key = to_key(pKeys, i);
+        const auto index = static_cast<uint64_t>(static_cast<int64_t>(key) - key_min);
+        if (PREDICT_TRUE(index < key_count)) {
+            const uint64_t lane = (i & (DENSE_LANES - 1)) * key_count + index;
+            const T v = pv[i];
+            const bool null = is_null(v);
+            sums[lane] += null ? 0 : v;
+            counts[lane] += null ? 0 : 1;
+            touched[index] = 1;
+        } else if (PREDICT_FALSE(!fallback(i))) {
+            free(mem);
+            return JNI_FALSE;
+        }
+    }
+
+    for (uint64_t k = 0; k < key_count; k++) {
+        if (touched[k]) {
+            T sum = 0;
+            jlong n = 0;
+            for (uint64_t lane = 0; lane < lanes_size; lane += key_count) {
+                sum += sums[lane + k];
+                n += counts[lane + k];
+            }
+            bool first;
+            auto dest = dense_slot(dense, k, first);
+            if (first) {
+                *reinterpret_cast<T *>(dest + value_offset) = sum;
+                *reinterpret_cast<jlong *>(dest + count_offset) = n;
+            } else {
+                *reinterpret_cast<T *>(dest + value_offset) += sum;
+                *reinterpret_cast<jlong *>(dest + count_offset) += n;
+            }
+        }
+    }
+    free(mem);
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
+static jboolean kIntDenseCount(TO_KEY to_key, jlong pDense, jlong pKeys, jlong count, jint valueOffset) {
+    auto dense = reinterpret_cast<dense_rosti_t *>(pDense);
+    const auto map = reinterpret_cast<jlong>(dense->map);
+    const auto key_min = dense->key_min;
+    const auto key_count = static_cast<uint64_t>(dense->key_count);
+    const auto value_offset = dense->map->value_offsets_[valueOffset];
+    auto counts = reinterpret_cast<jlong *>(rosti_malloc(sizeof(jlong) * DENSE_LANES * key_count));
+    if (counts == nullptr) {
+        return JNI_FALSE;
+    }
+    memset(counts, 0, sizeof(jlong) * DENSE_LANES * key_count);
+
+    for (int i = 0; i < count; i++) {
+        const auto key = to_key(pKeys, i);
+        const auto index = static_cast<uint64_t>(static_cast<int64_t>(key) - key_min);
+        if (PREDICT_TRUE(index < key_count)) {
+            counts[(i & (DENSE_LANES - 1)) * key_count + index]++;
+        } else {
+            const auto row_key = [&](jlong, int) { return key; };
+            if (PREDICT_FALSE(!kIntCount(row_key, map, pKeys, 1, valueOffset))) {
+                free(counts);
+                return JNI_FALSE;
+            }
+        }
+    }
+
+    for (uint64_t k = 0; k < key_count; k++) {
+        jlong n = 0;
+        for (int lane = 0; lane < DENSE_LANES; lane++) {
+            n += counts[lane * key_count + k];
+        }
+        if (n > 0) {
+            bool first;
+            auto dest = dense_slot(dense, k, first);
+            if (first) {
+                *reinterpret_cast<jlong *>(dest + value_offset) = n;
+            } else {
+                *reinterpret_cast<jlong *>(dest + value_offset) += n;
+            }
+        }
+    }
+    free(counts);
+    return JNI_TRUE;
+}
+
+template<typename TO_KEY>
+static jboolean
+kIntDenseSumDouble(TO_KEY to_key, jlong pDense, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+    auto dense = reinterpret_cast<dense_rosti_t *>(pDense);
+    const auto map = reinterpret_cast<jlong>(dense->map);
+    const auto *pd = reinterpret_cast<jdouble *>(pDouble);
+    return kIntDenseSum(
+            to_key, dense, pKeys, pd, count,
+            dense->map->value_offsets_[valueOffset],
+            dense->map->value_offsets_[valueOffset + 1],
+            [](jdouble d) { return std::isnan(d); },
+            [&](int i) {
+                const auto row_key = [&](jlong p, int) { return to_key(p, i); };
+                return kIntSumDouble(row_key, map, pKeys, reinterpret_cast<jlong>(pd + i), 1, valueOffset);
+            }
+    );
+}
+
+template<typename TO_KEY>
+static jboolean
+kIntDenseSumLong(TO_KEY to_key, jlong pDense, jlong pKeys, jlong pLong, jlong count, jint valueOffset) {
+    auto dense = reinterpret_cast<dense_rosti_t *>(pDense);
+    const auto map = reinterpret_cast<jlong>(dense->map);
+    const auto *pl = reinterpret_cast<jlong *>(pLong);
+    return kIntDenseSum(
+            to_key, dense, pKeys, pl, count,
+            dense->map->value_offsets_[valueOffset],
+            dense->map->value_offsets_[valueOffset + 1],
+            [](jlong v) { return v == L_MIN; },
+            [&](int i) {
+                const auto row_key = [&](jlong p, int) { return to_key(p, i); };
+                return kIntSumLong<jlong>(row_key, map, pKeys, reinterpret_cast<jlong>(pl + i), 1, valueOffset);
+            }
+    );
+}
+
+template<typename K, typename T>
+static jboolean kIntSumLongMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
+    constexpr auto count_idx = sizeof(T) == 8 ? 1 : 2;
+    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
+    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
+    const auto value_offset = map_b->value_offsets_[valueOffset];
+    const auto count_offset = map_b->value_offsets_[valueOffset + count_idx];
+    complete_resize(map_b);
+    const auto capacity = map_b->capacity_;
+    const auto ctrl = map_b->ctrl_;
+    const auto shift = map_b->slot_size_shift_;
+    const auto slots = map_b->slots_;
+
+    for (size_t i = 0; i < capacity; i++) {
+        ctrl_t c = ctrl[i];
+        if (c > -1) {
+            auto src = slots + (i << shift);
+            auto key = slot_key<K>(map_b, src);
+            auto val = *reinterpret_cast<T *>(src + value_offset);
+            auto count = *reinterpret_cast<jlong *>(src + count_offset);
+
+            auto res = find(map_a, key);
+            auto dest = map_a->slots_ + res.first;
+
+            if (PREDICT_FALSE(res.second)) {
+                if (PREDICT_FALSE(res.first == UL_MAX)) {
+                    return JNI_FALSE;
+                }
+                set_key(dest, key);
+            }
+
+            // when maps have non-null values, their count is >0 and val is not MIN
+            // on other hand
+            const jlong old_count = *reinterpret_cast<jlong *>(dest + count_offset);
+            if (old_count > 0 && count > 0) {
+                // add in the slot type, a 128-bit add into a long slot would carry into the count slot
+                *reinterpret_cast<T *>(dest + value_offset) += val;
+                *reinterpret_cast<jlong *>(dest + count_offset) += count;
+            } else {
+                *reinterpret_cast<T *>(dest + value_offset) = val;
+                *reinterpret_cast<jlong *>(dest + count_offset) = count;
+            }
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename K, typename T>
+static jboolean kIntSumLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtNull, jlong valueAtNullCount) {
     constexpr auto count_idx = sizeof(T) == 8 ? 1 : 2;
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + count_idx];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -898,7 +2030,7 @@ static jboolean kIntSumLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtN
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -906,7 +2038,7 @@ static jboolean kIntSumLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtN
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jlong *>(dest + value_offset) = valueAtNull;
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
         } else {
@@ -917,12 +2049,13 @@ static jboolean kIntSumLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtN
     return JNI_TRUE;
 }
 
-template<typename T>
+template<typename K, typename T>
 static jboolean kIntAvgLongWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) {
     constexpr auto count_idx = sizeof(T) == 8 ? 1 : 2;
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + count_idx];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -930,7 +2063,7 @@ static jboolean kIntAvgLongWrapUp(jlong pRosti, jint valueOffset, jdouble valueA
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -938,7 +2071,7 @@ static jboolean kIntAvgLongWrapUp(jlong pRosti, jint valueOffset, jdouble valueA
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
         } else {
@@ -961,43 +2094,13 @@ static jboolean kIntAvgLongWrapUp(jlong pRosti, jint valueOffset, jdouble valueA
     return JNI_TRUE;
 }
 
-extern "C" {
-
-//COUNT double
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntCountDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                              jlong count, jint valueOffset) {
-    return kIntCountDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourCountDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                               jlong count, jint valueOffset) {
-    return kIntCountDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-// SUM double
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                            jlong count, jint valueOffset) {
-    return kIntSumDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                             jlong count, jint valueOffset) {
-    return kIntSumDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                 jint valueOffset) {
+template<typename K>
+static jboolean kIntSumDoubleMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
     const auto count_offset = map_b->value_offsets_[valueOffset + 1];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1007,7 +2110,7 @@ Java_io_questdb_std_Rosti_keyedIntSumDoubleMerge(JNIEnv *env, jclass cl, jlong p
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto d = *reinterpret_cast<jdouble *>(src + value_offset);
             auto count = *reinterpret_cast<jlong *>(src + count_offset);
 
@@ -1018,7 +2121,7 @@ Java_io_questdb_std_Rosti_keyedIntSumDoubleMerge(JNIEnv *env, jclass cl, jlong p
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jdouble *>(dest + value_offset) = d;
                 *reinterpret_cast<jlong *>(dest + count_offset) = count;
             } else {
@@ -1030,12 +2133,12 @@ Java_io_questdb_std_Rosti_keyedIntSumDoubleMerge(JNIEnv *env, jclass cl, jlong p
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                  jdouble valueAtNull, jlong valueAtNullCount) {
+template<typename K>
+static jboolean kIntSumDoubleWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + 1];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -1054,7 +2157,7 @@ Java_io_questdb_std_Rosti_keyedIntSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1062,7 +2165,7 @@ Java_io_questdb_std_Rosti_keyedIntSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
         } else {
@@ -1073,57 +2176,21 @@ Java_io_questdb_std_Rosti_keyedIntSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-// KSUM double
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntKSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                             jlong count, jint valueOffset) {
-    return kIntKSumDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourKSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                              jlong count, jint valueOffset) {
-    return kIntKSumDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntDistinct(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count) {
-    return kIntDistinct(to_int, pRosti, pKeys, count);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourDistinct(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count) {
-    return kIntDistinct(int64_to_hour, pRosti, pKeys, count);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntCount(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count,
-                                        jint valueOffset) {
-    return kIntCount(to_int, pRosti, pKeys, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourCount(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count,
-                                         jint valueOffset) {
-    return kIntCount(int64_to_hour, pRosti, pKeys, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntCountMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                             jint valueOffset) {
-    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
-    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
-    const auto value_offset = map_b->value_offsets_[valueOffset];
-    const auto capacity = map_b->capacity_;
-    const auto ctrl = map_b->ctrl_;
-    const auto shift = map_b->slot_size_shift_;
-    const auto slots = map_b->slots_;
+template<typename K>
+static jboolean kIntCountMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
+    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
+    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
+    const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
+    const auto capacity = map_b->capacity_;
+    const auto ctrl = map_b->ctrl_;
+    const auto shift = map_b->slot_size_shift_;
+    const auto slots = map_b->slots_;
 
     for (size_t i = 0; i < capacity; i++) {
         if (ctrl[i] > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto count = *reinterpret_cast<jlong *>(src + value_offset);
             auto res = find(map_a, key);
             // maps must have identical structure to use "shift" from map B on map A
@@ -1132,7 +2199,7 @@ Java_io_questdb_std_Rosti_keyedIntCountMerge(JNIEnv *env, jclass cl, jlong pRost
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jlong *>(dest + value_offset) = count;
             } else {
                 (*reinterpret_cast<jlong *>(dest + value_offset)) += count;
@@ -1143,14 +2210,14 @@ Java_io_questdb_std_Rosti_keyedIntCountMerge(JNIEnv *env, jclass cl, jlong pRost
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntKSumDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                  jint valueOffset) {
+template<typename K>
+static jboolean kIntKSumDoubleMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
     const auto c_offset = map_b->value_offsets_[valueOffset + 1];
     const auto count_offset = map_b->value_offsets_[valueOffset + 2];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1159,7 +2226,7 @@ Java_io_questdb_std_Rosti_keyedIntKSumDoubleMerge(JNIEnv *env, jclass cl, jlong
     for (size_t i = 0; i < capacity; i++) {
         if (ctrl[i] > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto d = *reinterpret_cast<jdouble *>(src + value_offset);
             auto cc = *reinterpret_cast<jdouble *>(src + c_offset);
             auto count = *reinterpret_cast<jlong *>(src + count_offset);
@@ -1171,7 +2238,7 @@ Java_io_questdb_std_Rosti_keyedIntKSumDoubleMerge(JNIEnv *env, jclass cl, jlong
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jdouble *>(dest + value_offset) = d;
                 *reinterpret_cast<jdouble *>(dest + c_offset) = cc;
                 *reinterpret_cast<jlong *>(dest + count_offset) = count;
@@ -1189,13 +2256,13 @@ Java_io_questdb_std_Rosti_keyedIntKSumDoubleMerge(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntKSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                   jdouble valueAtNull, jlong valueAtNullCount) {
+template<typename K>
+static jboolean kIntKSumDoubleWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto c_offset = map->value_offsets_[valueOffset + 1];
     const auto count_offset = map->value_offsets_[valueOffset + 2];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -1203,7 +2270,7 @@ Java_io_questdb_std_Rosti_keyedIntKSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1211,7 +2278,7 @@ Java_io_questdb_std_Rosti_keyedIntKSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
         } else {
@@ -1237,28 +2304,164 @@ Java_io_questdb_std_Rosti_keyedIntKSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-// NSUM double
+// Welford's (mean, m2, count) state per key, non-finite values are skipped
+template<typename TO_KEY>
+static jboolean
+kIntVarianceDouble(TO_KEY to_key, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto *pd = reinterpret_cast<jdouble *>(pDouble);
+    const auto mean_offset = map->value_offsets_[valueOffset];
+    const auto m2_offset = map->value_offsets_[valueOffset + 1];
+    const auto count_offset = map->value_offsets_[valueOffset + 2];
+    key_batch<TO_KEY> batch(map, to_key, pKeys, count);
+    for (int i = 0; i < count; i++) {
+        batch.next(i);
+        MM_PREFETCH_T0(pd + i + 8);
+        const auto key = batch.key(i);
+        const jdouble d = pd[i];
+        auto res = batch.find(i);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(dest, key);
+            const bool finite = std::isfinite(d);
+            *reinterpret_cast<jdouble *>(dest + mean_offset) = finite ? d : 0;
+            *reinterpret_cast<jdouble *>(dest + m2_offset) = 0;
+            *reinterpret_cast<jlong *>(dest + count_offset) = finite ? 1 : 0;
+        } else if (PREDICT_TRUE(std::isfinite(d))) {
+            welford_add(
+                    *reinterpret_cast<jdouble *>(dest + mean_offset),
+                    *reinterpret_cast<jdouble *>(dest + m2_offset),
+                    *reinterpret_cast<int64_t *>(dest + count_offset),
+                    d
+            );
+        }
+    }
+    return JNI_TRUE;
+}
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntNSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                             jlong count, jint valueOffset) {
-    return kIntNSumDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+template<typename K>
+static jboolean kIntVarianceDoubleMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
+    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
+    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
+    const auto mean_offset = map_b->value_offsets_[valueOffset];
+    const auto m2_offset = map_b->value_offsets_[valueOffset + 1];
+    const auto count_offset = map_b->value_offsets_[valueOffset + 2];
+    complete_resize(map_b);
+    const auto capacity = map_b->capacity_;
+    const auto ctrl = map_b->ctrl_;
+    const auto shift = map_b->slot_size_shift_;
+    const auto slots = map_b->slots_;
+
+    for (size_t i = 0; i < capacity; i++) {
+        if (ctrl[i] > -1) {
+            auto src = slots + (i << shift);
+            auto key = slot_key<K>(map_b, src);
+            auto mean = *reinterpret_cast<jdouble *>(src + mean_offset);
+            auto m2 = *reinterpret_cast<jdouble *>(src + m2_offset);
+            auto count = *reinterpret_cast<jlong *>(src + count_offset);
+
+            auto res = find(map_a, key);
+            // maps must have identical structure to use "shift" from map B on map A
+            auto dest = map_a->slots_ + res.first;
+            if (PREDICT_FALSE(res.second)) {
+                if (PREDICT_FALSE(res.first == UL_MAX)) {
+                    return JNI_FALSE;
+                }
+                set_key(dest, key);
+                *reinterpret_cast<jdouble *>(dest + mean_offset) = mean;
+                *reinterpret_cast<jdouble *>(dest + m2_offset) = m2;
+                *reinterpret_cast<jlong *>(dest + count_offset) = count;
+            } else {
+                welford_merge(
+                        *reinterpret_cast<jdouble *>(dest + mean_offset),
+                        *reinterpret_cast<jdouble *>(dest + m2_offset),
+                        *reinterpret_cast<int64_t *>(dest + count_offset),
+                        mean,
+                        m2,
+                        count
+                );
+            }
+        }
+    }
+    return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourNSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                              jlong count, jint valueOffset) {
-    return kIntNSumDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+// Merges null key state and replaces the mean with the final value: m2 / count for population
+// or m2 / (count - 1) for sample variance, optionally followed by the square root for stddev.
+template<typename K>
+static jboolean kIntVarianceDoubleWrapUp(
+        jlong pRosti,
+        jint valueOffset,
+        jdouble meanAtNull,
+        jdouble m2AtNull,
+        jlong valueAtNullCount,
+        jboolean sample,
+        jboolean stddev
+) {
+    auto map = reinterpret_cast<rosti_t *>(pRosti);
+    const auto mean_offset = map->value_offsets_[valueOffset];
+    const auto m2_offset = map->value_offsets_[valueOffset + 1];
+    const auto count_offset = map->value_offsets_[valueOffset + 2];
+    complete_resize(map);
+    const auto capacity = map->capacity_;
+    const auto ctrl = map->ctrl_;
+    const auto shift = map->slot_size_shift_;
+    const auto slots = map->slots_;
+
+    // populate null value
+    if (valueAtNullCount > 0) {
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
+        auto res = find(map, nullKey);
+        auto dest = map->slots_ + res.first;
+        if (PREDICT_FALSE(res.second)) {
+            if (PREDICT_FALSE(res.first == UL_MAX)) {
+                return JNI_FALSE;
+            }
+            set_key(dest, nullKey);
+            *reinterpret_cast<jdouble *>(dest + mean_offset) = meanAtNull;
+            *reinterpret_cast<jdouble *>(dest + m2_offset) = m2AtNull;
+            *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
+        } else {
+            welford_merge(
+                    *reinterpret_cast<jdouble *>(dest + mean_offset),
+                    *reinterpret_cast<jdouble *>(dest + m2_offset),
+                    *reinterpret_cast<int64_t *>(dest + count_offset),
+                    meanAtNull,
+                    m2AtNull,
+                    valueAtNullCount
+            );
+        }
+    }
+
+    const jlong divisor_delta = sample ? 1 : 0;
+    for (size_t i = 0; i < capacity; i++) {
+        if (ctrl[i] > -1) {
+            const auto src = slots + (i << shift);
+            const auto divisor = *reinterpret_cast<jlong *>(src + count_offset) - divisor_delta;
+            jdouble value = D_NAN;
+            if (divisor > 0) {
+                value = *reinterpret_cast<jdouble *>(src + m2_offset) / divisor;
+                if (stddev) {
+                    value = std::sqrt(value);
+                }
+            }
+            *reinterpret_cast<jdouble *>(src + mean_offset) = value;
+        }
+    }
+    return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntNSumDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                  jint valueOffset) {
+template<typename K>
+static jboolean kIntNSumDoubleMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
     const auto c_offset = map_b->value_offsets_[valueOffset + 1];
     const auto count_offset = map_b->value_offsets_[valueOffset + 2];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1267,7 +2470,7 @@ Java_io_questdb_std_Rosti_keyedIntNSumDoubleMerge(JNIEnv *env, jclass cl, jlong
     for (size_t i = 0; i < capacity; i++) {
         if (ctrl[i] > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto d = *reinterpret_cast<jdouble *>(src + value_offset);
             auto count = *reinterpret_cast<jlong *>(src + count_offset);
 
@@ -1278,7 +2481,7 @@ Java_io_questdb_std_Rosti_keyedIntNSumDoubleMerge(JNIEnv *env, jclass cl, jlong
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jdouble *>(dest + value_offset) = d;
                 *reinterpret_cast<jdouble *>(dest + c_offset) = *reinterpret_cast<jdouble *>(src + c_offset);
                 *reinterpret_cast<jlong *>(dest + count_offset) = count;
@@ -1299,14 +2502,14 @@ Java_io_questdb_std_Rosti_keyedIntNSumDoubleMerge(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntNSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                   jdouble valueAtNull, jlong valueAtNullCount, jdouble valueAtNullC) {
+template<typename K>
+static jboolean kIntNSumDoubleWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount, jdouble valueAtNullC) {
 
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto c_offset = map->value_offsets_[valueOffset + 1];
     const auto count_offset = map->value_offsets_[valueOffset + 2];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -1327,7 +2530,7 @@ Java_io_questdb_std_Rosti_keyedIntNSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1335,7 +2538,7 @@ Java_io_questdb_std_Rosti_keyedIntNSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
             *reinterpret_cast<jdouble *>(dest + c_offset) = valueAtNullC;
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
@@ -1354,26 +2557,12 @@ Java_io_questdb_std_Rosti_keyedIntNSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-// MIN double
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                            jlong count, jint valueOffset) {
-    return kIntMinDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMinDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                             jlong count, jint valueOffset) {
-    return kIntMinDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                 jint valueOffset) {
+template<typename K>
+static jboolean kIntMinDoubleMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1383,7 +2572,7 @@ Java_io_questdb_std_Rosti_keyedIntMinDoubleMerge(JNIEnv *env, jclass cl, jlong p
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto d = *reinterpret_cast<jdouble *>(src + value_offset);
             auto res = find(map_a, key);
             // maps must have identical structure to use "shift" from map B on map A
@@ -1392,7 +2581,7 @@ Java_io_questdb_std_Rosti_keyedIntMinDoubleMerge(JNIEnv *env, jclass cl, jlong p
                     return JNI_FALSE;
                 }
                 auto dest = map_a->slots_ + res.first;
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jdouble *>((dest + value_offset)) = std::isnan(d) ? D_MAX : d;
             } else {
                 auto pVal = map_a->slots_ + res.first + value_offset;
@@ -1404,11 +2593,11 @@ Java_io_questdb_std_Rosti_keyedIntMinDoubleMerge(JNIEnv *env, jclass cl, jlong p
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                  jdouble valueAtNull) {
+template<typename K>
+static jboolean kIntMinDoubleWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -1416,7 +2605,7 @@ Java_io_questdb_std_Rosti_keyedIntMinDoubleWrapUp(JNIEnv *env, jclass cl, jlong
 
     // populate null value only if non-keyed aggregation did something useful
     if (valueAtNull < D_MAX) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1424,7 +2613,7 @@ Java_io_questdb_std_Rosti_keyedIntMinDoubleWrapUp(JNIEnv *env, jclass cl, jlong
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
         } else {
             *reinterpret_cast<jdouble *>(dest + value_offset) = MIN(valueAtNull,
@@ -1446,26 +2635,12 @@ Java_io_questdb_std_Rosti_keyedIntMinDoubleWrapUp(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-// MAX double
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                            jlong count, jint valueOffset) {
-    return kIntMaxDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMaxDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
-                                             jlong count, jint valueOffset) {
-    return kIntMaxDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                 jint valueOffset) {
+template<typename K>
+static jboolean kIntMaxDoubleMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1475,7 +2650,7 @@ Java_io_questdb_std_Rosti_keyedIntMaxDoubleMerge(JNIEnv *env, jclass cl, jlong p
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto d = *reinterpret_cast<jdouble *>(src + value_offset);
             auto res = find(map_a, key);
             // maps must have identical structure to use "shift" from map B on map A
@@ -1485,7 +2660,7 @@ Java_io_questdb_std_Rosti_keyedIntMaxDoubleMerge(JNIEnv *env, jclass cl, jlong p
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(pKey) = key;
+                set_key(pKey, key);
                 *reinterpret_cast<jdouble *>(pVal) = std::isnan(d) ? D_MIN : d;
             } else {
                 const jdouble old = *reinterpret_cast<jdouble *>(pVal);
@@ -1497,18 +2672,18 @@ Java_io_questdb_std_Rosti_keyedIntMaxDoubleMerge(JNIEnv *env, jclass cl, jlong p
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                  jdouble valueAtNull) {
+template<typename K>
+static jboolean kIntMaxDoubleWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
     const auto slots = map->slots_;
 
     if (valueAtNull > D_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1516,7 +2691,7 @@ Java_io_questdb_std_Rosti_keyedIntMaxDoubleWrapUp(JNIEnv *env, jclass cl, jlong
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
         } else {
             *reinterpret_cast<jdouble *>(dest + value_offset) = MAX(valueAtNull,
@@ -1539,14 +2714,12 @@ Java_io_questdb_std_Rosti_keyedIntMaxDoubleWrapUp(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-// avg double
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntAvgDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                  jdouble valueAtNull, jlong valueAtNullCount) {
+template<typename K>
+static jboolean kIntAvgDoubleWrapUp(jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
     const auto count_offset = map->value_offsets_[valueOffset + 1];
+    complete_resize(map);
     const auto capacity = map->capacity_;
     const auto ctrl = map->ctrl_;
     const auto shift = map->slot_size_shift_;
@@ -1554,7 +2727,7 @@ Java_io_questdb_std_Rosti_keyedIntAvgDoubleWrapUp(JNIEnv *env, jclass cl, jlong
 
     // populate null value
     if (valueAtNullCount > 0) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1562,7 +2735,7 @@ Java_io_questdb_std_Rosti_keyedIntAvgDoubleWrapUp(JNIEnv *env, jclass cl, jlong
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jdouble *>(dest + value_offset) = valueAtNull;
             *reinterpret_cast<jlong *>(dest + count_offset) = valueAtNullCount;
         } else {
@@ -1585,53 +2758,13 @@ Java_io_questdb_std_Rosti_keyedIntAvgDoubleWrapUp(JNIEnv *env, jclass cl, jlong
     return JNI_TRUE;
 }
 
-// avg int and long
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntAvgLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                jdouble valueAtNull, jlong valueAtNullCount) {
-    return kIntAvgLongWrapUp<jlong>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntAvgLongLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                    jdouble valueAtNull, jlong valueAtNullCount) {
-    return kIntAvgLongWrapUp<accumulator_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
-}
-
-//COUNT int
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntCountInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                           jlong count, jint valueOffset) {
-    return kIntCountInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourCountInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                            jlong count, jint valueOffset) {
-    return kIntCountInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-// SUM int
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                         jlong count, jint valueOffset) {
-    return kIntSumInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                          jlong count, jint valueOffset) {
-    return kIntSumInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumIntMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                              jint valueOffset) {
+template<typename K>
+static jboolean kIntSumIntMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
     const auto count_offset = map_b->value_offsets_[valueOffset + 1];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1641,7 +2774,7 @@ Java_io_questdb_std_Rosti_keyedIntSumIntMerge(JNIEnv *env, jclass cl, jlong pRos
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto val = *reinterpret_cast<jint *>(src + value_offset);
             auto count = *reinterpret_cast<jlong *>(src + count_offset);
 
@@ -1651,7 +2784,7 @@ Java_io_questdb_std_Rosti_keyedIntSumIntMerge(JNIEnv *env, jclass cl, jlong pRos
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
             }
 
             // when maps have non-null values, their count is >0 and val is not MIN
@@ -1669,26 +2802,12 @@ Java_io_questdb_std_Rosti_keyedIntSumIntMerge(JNIEnv *env, jclass cl, jlong pRos
     return JNI_TRUE;
 }
 
-// MIN int
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                         jlong count, jint valueOffset) {
-    return kIntMinInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMinInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                          jlong count, jint valueOffset) {
-    return kIntMinInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinIntMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                              jint valueOffset) {
+template<typename K>
+static jboolean kIntMinIntMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1698,7 +2817,7 @@ Java_io_questdb_std_Rosti_keyedIntMinIntMerge(JNIEnv *env, jclass cl, jlong pRos
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto val = *reinterpret_cast<jint *>(src + value_offset);
             auto res = find(map_a, key);
             // maps must have identical structure to use "shift" from map B on map A
@@ -1708,7 +2827,7 @@ Java_io_questdb_std_Rosti_keyedIntMinIntMerge(JNIEnv *env, jclass cl, jlong pRos
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jint *>(pVal) = val;
             } else {
                 if (val != I_MIN) {
@@ -1721,15 +2840,13 @@ Java_io_questdb_std_Rosti_keyedIntMinIntMerge(JNIEnv *env, jclass cl, jlong pRos
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinIntWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                               jint valueAtNull) {
+template<typename K>
+static jboolean kIntMinIntWrapUp(jlong pRosti, jint valueOffset, jint valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
-    const auto slots = map->slots_;
 
     if (valueAtNull > I_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -1737,7 +2854,7 @@ Java_io_questdb_std_Rosti_keyedIntMinIntWrapUp(JNIEnv *env, jclass cl, jlong pRo
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jint *>(dest + value_offset) = valueAtNull;
         } else {
             const jint old = *reinterpret_cast<jint *>(dest + value_offset);
@@ -1751,26 +2868,12 @@ Java_io_questdb_std_Rosti_keyedIntMinIntWrapUp(JNIEnv *env, jclass cl, jlong pRo
     return JNI_TRUE;
 }
 
-// MAX int
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                         jlong count, jint valueOffset) {
-    return kIntMaxInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMaxInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
-                                          jlong count, jint valueOffset) {
-    return kIntMaxInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxIntMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                              jint valueOffset) {
+template<typename K>
+static jboolean kIntMaxIntMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
     auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
     auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
     const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
     const auto capacity = map_b->capacity_;
     const auto ctrl = map_b->ctrl_;
     const auto shift = map_b->slot_size_shift_;
@@ -1780,7 +2883,7 @@ Java_io_questdb_std_Rosti_keyedIntMaxIntMerge(JNIEnv *env, jclass cl, jlong pRos
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto val = *reinterpret_cast<jint *>(src + value_offset);
             auto res = find(map_a, key);
             // maps must have identical structure to use "shift" from map B on map A
@@ -1790,7 +2893,7 @@ Java_io_questdb_std_Rosti_keyedIntMaxIntMerge(JNIEnv *env, jclass cl, jlong pRos
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jint *>(pVal) = val;
             } else {
                 const jint old = *reinterpret_cast<jint *>(pVal);
@@ -1801,182 +2904,22 @@ Java_io_questdb_std_Rosti_keyedIntMaxIntMerge(JNIEnv *env, jclass cl, jlong pRos
     return JNI_TRUE;
 }
 
-//COUNT long
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntCountLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                            jlong count, jint valueOffset) {
-    return kIntCountLong(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourCountLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                             jlong count, jint valueOffset) {
-    return kIntCountLong(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntCountWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                              jlong valueAtNull) {
-    return kIntCountWrapUp(pRosti, valueOffset, valueAtNull);
-}
-
-// SUM long
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                           jlong count, jint valueOffset) {
-    return kIntSumShort<jlong>(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-// SUM long
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                            jlong count, jint valueOffset) {
-    return kIntSumShort<jlong>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-// SUM long
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                          jlong count, jint valueOffset) {
-    return kIntSumLong<jlong>(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                           jlong count, jint valueOffset) {
-    return kIntSumLong<jlong>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLongLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                              jlong count, jint valueOffset) {
-    return kIntSumLong<accumulator_t>(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumShortLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                               jlong count, jint valueOffset) {
-    return kIntSumShort<accumulator_t>(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumShortLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                                jlong count, jint valueOffset) {
-    return kIntSumShort<accumulator_t>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumLongLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                               jlong count, jint valueOffset) {
-    return kIntSumLong<accumulator_t>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                               jint valueOffset) {
-    return kIntSumLongMerge<jlong>(pRostiA, pRostiB, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLongLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                   jint valueOffset) {
-    return kIntSumLongMerge<accumulator_t>(pRostiA, pRostiB, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                jlong valueAtNull, jlong valueAtNullCount) {
-    return kIntSumLongWrapUp<jlong>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLongLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                    jlong valueAtNull, jlong valueAtNullCount) {
-    return kIntSumLongWrapUp<accumulator_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
-}
-// sum long256
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourSumLong256(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                              jlong count, jint valueOffset) {
-    return kIntSumLong256(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLong256(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                             jlong count, jint valueOffset) {
-    return kIntSumLong256(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLong256Merge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                                  jint valueOffset) {
-    return kIntSumLong256Merge(pRostiA, pRostiB, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntSumLong256WrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                   jlong v0, jlong v1, jlong v2, jlong v3, jlong valueAtNullCount) {
-    return kIntSumLong256WrapUp(pRosti, valueOffset, v0, v1, v2, v3, valueAtNullCount);
-}
-
-// MAX short
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                           jlong count, jint valueOffset) {
-    return kIntMaxShort(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMaxShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                            jlong count, jint valueOffset) {
-    return kIntMaxShort(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-// MIN short
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                           jlong count, jint valueOffset) {
-    return kIntMinShort(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMinShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                            jlong count, jint valueOffset) {
-    return kIntMinShort(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-// MIN long
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                          jlong count, jint valueOffset) {
-    return kIntMinLong(to_int, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMinLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                           jlong count, jint valueOffset) {
-    return kIntMinLong(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
-}
-
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                               jint valueOffset) {
-    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
-    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
-    const auto value_offset = map_b->value_offsets_[valueOffset];
-    const auto capacity = map_b->capacity_;
-    const auto ctrl = map_b->ctrl_;
-    const auto shift = map_b->slot_size_shift_;
-    const auto slots = map_b->slots_;
+template<typename K>
+static jboolean kIntMinLongMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
+    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
+    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
+    const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
+    const auto capacity = map_b->capacity_;
+    const auto ctrl = map_b->ctrl_;
+    const auto shift = map_b->slot_size_shift_;
+    const auto slots = map_b->slots_;
 
     for (size_t i = 0; i < capacity; i++) {
         ctrl_t c = ctrl[i];
         if (c > -1) {
             auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
+            auto key = slot_key<K>(map_b, src);
             auto val = *reinterpret_cast<jlong *>(src + value_offset);
             auto res = find(map_a, key);
             // maps must have identical structure to use "shift" from map B on map A
@@ -1986,7 +2929,7 @@ Java_io_questdb_std_Rosti_keyedIntMinLongMerge(JNIEnv *env, jclass cl, jlong pRo
                 if (PREDICT_FALSE(res.first == UL_MAX)) {
                     return JNI_FALSE;
                 }
-                *reinterpret_cast<int32_t *>(dest) = key;
+                set_key(dest, key);
                 *reinterpret_cast<jlong *>(pVal) = val;
             } else {
                 if (val != L_MIN) {
@@ -1999,16 +2942,14 @@ Java_io_questdb_std_Rosti_keyedIntMinLongMerge(JNIEnv *env, jclass cl, jlong pRo
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                jlong valueAtNull) {
+template<typename K>
+static jboolean kIntMinLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
-    const auto slots = map->slots_;
 
     // populate null value
     if (valueAtNull > L_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -2016,7 +2957,7 @@ Java_io_questdb_std_Rosti_keyedIntMinLongWrapUp(JNIEnv *env, jclass cl, jlong pR
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jlong *>(dest + value_offset) = valueAtNull;
         } else {
             const jlong old = *reinterpret_cast<jlong *>(dest + value_offset);
@@ -2030,16 +2971,14 @@ Java_io_questdb_std_Rosti_keyedIntMinLongWrapUp(JNIEnv *env, jclass cl, jlong pR
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMinShortWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                                 jint accumulatedValue) {
+template<typename K>
+static jboolean kIntMinShortWrapUp(jlong pRosti, jint valueOffset, jint accumulatedValue) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
-    const auto slots = map->slots_;
 
     // populate null value
     if (accumulatedValue > I_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -2047,7 +2986,7 @@ Java_io_questdb_std_Rosti_keyedIntMinShortWrapUp(JNIEnv *env, jclass cl, jlong p
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
+            set_key(dest, nullKey);
             *reinterpret_cast<jlong *>(dest + value_offset) = accumulatedValue;
         } else {
             const jlong old = *reinterpret_cast<jlong *>(dest + value_offset);
@@ -2059,15 +2998,14 @@ Java_io_questdb_std_Rosti_keyedIntMinShortWrapUp(JNIEnv *env, jclass cl, jlong p
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxLongWrapUp(
-        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull) {
+template<typename K>
+static jboolean kIntMaxIntWrapUp(jlong pRosti, jint valueOffset, jint valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
 
     // populate null value
-    if (valueAtNull > L_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+    if (valueAtNull > I_MIN) {
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -2075,27 +3013,60 @@ Java_io_questdb_std_Rosti_keyedIntMaxLongWrapUp(
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
-            *reinterpret_cast<jlong *>(dest + value_offset) = valueAtNull;
+            set_key(dest, nullKey);
+            *reinterpret_cast<jint *>(dest + value_offset) = valueAtNull;
         } else {
-            *reinterpret_cast<jlong *>(dest + value_offset) = MAX(
-                    valueAtNull,
-                    *reinterpret_cast<jlong *>(dest + value_offset)
-            );
+            *reinterpret_cast<jint *>(dest + value_offset) = MAX(valueAtNull,
+                                                                 *reinterpret_cast<jint *>(dest + value_offset));
         }
     }
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxShortWrapUp(
-        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jint accumulatedValue) {
+template<typename K>
+static jboolean kIntMaxLongMerge(jlong pRostiA, jlong pRostiB, jint valueOffset) {
+    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
+    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
+    const auto value_offset = map_b->value_offsets_[valueOffset];
+    complete_resize(map_b);
+    const auto capacity = map_b->capacity_;
+    const auto ctrl = map_b->ctrl_;
+    const auto shift = map_b->slot_size_shift_;
+    const auto slots = map_b->slots_;
+
+    for (size_t i = 0; i < capacity; i++) {
+        ctrl_t c = ctrl[i];
+        if (c > -1) {
+            auto src = slots + (i << shift);
+            auto key = slot_key<K>(map_b, src);
+            auto val = *reinterpret_cast<jlong *>(src + value_offset);
+            auto res = find(map_a, key);
+            // maps must have identical structure to use "shift" from map B on map A
+            auto dest = map_a->slots_ + res.first;
+            auto pVal = dest + value_offset;
+            if (PREDICT_FALSE(res.second)) {
+                if (PREDICT_FALSE(res.first == UL_MAX)) {
+                    return JNI_FALSE;
+                }
+                set_key(dest, key);
+                *reinterpret_cast<jlong *>(pVal) = val;
+            } else {
+                const jlong old = *reinterpret_cast<jlong *>(pVal);
+                *reinterpret_cast<jlong *>(pVal) = MAX(val, old);
+            }
+        }
+    }
+    return JNI_TRUE;
+}
+
+template<typename K>
+static jboolean kIntMaxLongWrapUp(jlong pRosti, jint valueOffset, jlong valueAtNull) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
 
     // populate null value
-    if (accumulatedValue > I_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+    if (valueAtNull > L_MIN) {
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -2103,27 +3074,26 @@ Java_io_questdb_std_Rosti_keyedIntMaxShortWrapUp(
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
-            *reinterpret_cast<jlong *>(dest + value_offset) = accumulatedValue;
+            set_key(dest, nullKey);
+            *reinterpret_cast<jlong *>(dest + value_offset) = valueAtNull;
         } else {
             *reinterpret_cast<jlong *>(dest + value_offset) = MAX(
-                    (jshort) accumulatedValue,
-                    *reinterpret_cast<jshort *>(dest + value_offset)
+                    valueAtNull,
+                    *reinterpret_cast<jlong *>(dest + value_offset)
             );
         }
     }
     return JNI_TRUE;
 }
 
-JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxIntWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
-                                               jint valueAtNull) {
+template<typename K>
+static jboolean kIntMaxShortWrapUp(jlong pRosti, jint valueOffset, jint accumulatedValue) {
     auto map = reinterpret_cast<rosti_t *>(pRosti);
     const auto value_offset = map->value_offsets_[valueOffset];
 
     // populate null value
-    if (valueAtNull > I_MIN) {
-        auto nullKey = reinterpret_cast<int32_t *>(map->slot_initial_values_)[0];
+    if (accumulatedValue > I_MIN) {
+        auto nullKey = slot_key<K>(map, map->slot_initial_values_);
         auto res = find(map, nullKey);
         // maps must have identical structure to use "shift" from map B on map A
         auto dest = map->slots_ + res.first;
@@ -2131,64 +3101,1544 @@ Java_io_questdb_std_Rosti_keyedIntMaxIntWrapUp(JNIEnv *env, jclass cl, jlong pRo
             if (PREDICT_FALSE(res.first == UL_MAX)) {
                 return JNI_FALSE;
             }
-            *reinterpret_cast<int32_t *>(dest) = nullKey;
-            *reinterpret_cast<jint *>(dest + value_offset) = valueAtNull;
+            set_key(dest, nullKey);
+            *reinterpret_cast<jlong *>(dest + value_offset) = accumulatedValue;
         } else {
-            *reinterpret_cast<jint *>(dest + value_offset) = MAX(valueAtNull,
-                                                                 *reinterpret_cast<jint *>(dest + value_offset));
+            *reinterpret_cast<jlong *>(dest + value_offset) = MAX(
+                    (jshort) accumulatedValue,
+                    *reinterpret_cast<jshort *>(dest + value_offset)
+            );
         }
     }
     return JNI_TRUE;
 }
 
-// MAX long
+// merge and wrap-up walk every slot of the map, performance counters record its size
+inline int64_t map_bytes(jlong pRosti) {
+    const auto map = reinterpret_cast<rosti_t *>(pRosti);
+    return (int64_t) (map->capacity_ << map->slot_size_shift_);
+}
+
+extern "C" {
+
+//COUNT double
 
 JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                          jlong count, jint valueOffset) {
-    return kIntMaxLong(to_int, pRosti, pKeys, pLong, count, valueOffset);
+Java_io_questdb_std_Rosti_keyedIntCountDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                              jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntCountDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
 }
 
 JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedHourMaxLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
-                                           jlong count, jint valueOffset) {
-    return kIntMaxLong(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+Java_io_questdb_std_Rosti_keyedHourCountDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                               jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntCountDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
 }
 
+// SUM double
+
 JNIEXPORT jboolean JNICALL
-Java_io_questdb_std_Rosti_keyedIntMaxLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
-                                               jint valueOffset) {
-    auto map_a = reinterpret_cast<rosti_t *>(pRostiA);
-    auto map_b = reinterpret_cast<rosti_t *>(pRostiB);
-    const auto value_offset = map_b->value_offsets_[valueOffset];
-    const auto capacity = map_b->capacity_;
-    const auto ctrl = map_b->ctrl_;
-    const auto shift = map_b->slot_size_shift_;
-    const auto slots = map_b->slots_;
+Java_io_questdb_std_Rosti_keyedIntSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
 
-    for (size_t i = 0; i < capacity; i++) {
-        ctrl_t c = ctrl[i];
-        if (c > -1) {
-            auto src = slots + (i << shift);
-            auto key = *reinterpret_cast<int32_t *>(src);
-            auto val = *reinterpret_cast<jlong *>(src + value_offset);
-            auto res = find(map_a, key);
-            // maps must have identical structure to use "shift" from map B on map A
-            auto dest = map_a->slots_ + res.first;
-            auto pVal = dest + value_offset;
-            if (PREDICT_FALSE(res.second)) {
-                if (PREDICT_FALSE(res.first == UL_MAX)) {
-                    return JNI_FALSE;
-                }
-                *reinterpret_cast<int32_t *>(dest) = key;
-                *reinterpret_cast<jlong *>(pVal) = val;
-            } else {
-                const jlong old = *reinterpret_cast<jlong *>(pVal);
-                *reinterpret_cast<jlong *>(pVal) = MAX(val, old);
-            }
-        }
-    }
-    return JNI_TRUE;
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
 }
 
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                 jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntSumDoubleMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                  jdouble valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntSumDoubleWrapUp<int32_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+
+// KSUM double
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntKSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntKSumDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourKSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                              jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntKSumDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntDistinct(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntDistinct(to_int, pRosti, pKeys, count);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourDistinct(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntDistinct(int64_to_hour, pRosti, pKeys, count);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCount(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count,
+                                        jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_COUNT, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntCount(to_int, pRosti, pKeys, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourCount(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count,
+                                         jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_COUNT, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntCount(int64_to_hour, pRosti, pKeys, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMultiAgg(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count,
+                                           jlong pAggs, jint aggCount) {
+    return measure_time(PERF_ROSTI_KEYED_MULTI_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMultiAgg(to_int, pRosti, pKeys, count, pAggs, aggCount);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMultiAgg(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count,
+                                            jlong pAggs, jint aggCount) {
+    return measure_time(PERF_ROSTI_KEYED_MULTI_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMultiAgg(int64_to_hour, pRosti, pKeys, count, pAggs, aggCount);
+    });
+}
+
+JNIEXPORT jlong JNICALL
+Java_io_questdb_std_Rosti_allocDense0(JNIEnv *env, jclass cl, jlong pRosti, jlong keyMin, jlong keyCount) {
+    return reinterpret_cast<jlong>(alloc_dense(reinterpret_cast<rosti_t *>(pRosti), keyMin, keyCount));
+}
+
+JNIEXPORT void JNICALL
+Java_io_questdb_std_Rosti_freeDense0(JNIEnv *env, jclass cl, jlong pDense) {
+    free_dense(reinterpret_cast<dense_rosti_t *>(pDense));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_exportDense(JNIEnv *env, jclass cl, jlong pDense) {
+    return export_dense(reinterpret_cast<dense_rosti_t *>(pDense));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntDenseCount(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong count,
+                                             jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntDenseCount(to_int, pDense, pKeys, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourDenseCount(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong count,
+                                              jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntDenseCount(int64_to_hour, pDense, pKeys, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntDenseMultiAgg(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong count,
+                                                jlong pAggs, jint aggCount) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_MULTI_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntDenseMultiAgg(to_int, pDense, pKeys, count, pAggs, aggCount);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourDenseMultiAgg(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong count,
+                                                 jlong pAggs, jint aggCount) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_MULTI_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntDenseMultiAgg(int64_to_hour, pDense, pKeys, count, pAggs, aggCount);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntDenseSumDouble(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong pDouble,
+                                                 jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntDenseSumDouble(to_int, pDense, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourDenseSumDouble(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong pDouble,
+                                                  jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntDenseSumDouble(int64_to_hour, pDense, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntDenseSumLong(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong pLong,
+                                               jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntDenseSumLong(to_int, pDense, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourDenseSumLong(JNIEnv *env, jclass cl, jlong pDense, jlong pKeys, jlong pLong,
+                                                jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_DENSE_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntDenseSumLong(int64_to_hour, pDense, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCountMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                             jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntCountMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntKSumDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                  jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntKSumDoubleMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntKSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                   jdouble valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntKSumDoubleWrapUp<int32_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+
+// NSUM double
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntNSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntNSumDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourNSumDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                              jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntNSumDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntNSumDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                  jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntNSumDoubleMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntNSumDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                   jdouble valueAtNull, jlong valueAtNullCount, jdouble valueAtNullC) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntNSumDoubleWrapUp<int32_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount, valueAtNullC);
+    });
+}
+
+// MIN double
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                 jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntMinDoubleMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                  jdouble valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMinDoubleWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+// MAX double
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                 jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntMaxDoubleMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                  jdouble valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMaxDoubleWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+// avg double
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntAvgDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                  jdouble valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntAvgDoubleWrapUp<int32_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+
+// variance and stddev double
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntVarianceDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                                 jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntVarianceDouble(to_int, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourVarianceDouble(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble,
+                                                  jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntVarianceDouble(int64_to_hour, pRosti, pKeys, pDouble, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntVarianceDoubleMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                      jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntVarianceDoubleMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntVarianceDoubleWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                       jdouble meanAtNull, jdouble m2AtNull, jlong valueAtNullCount,
+                                                       jboolean sample, jboolean stddev) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntVarianceDoubleWrapUp<int32_t>(
+                pRosti, valueOffset, meanAtNull, m2AtNull, valueAtNullCount, sample, stddev);
+    });
+}
+
+// avg int and long
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntAvgLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                jdouble valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntAvgLongWrapUp<int32_t, jlong>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntAvgLongLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                    jdouble valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntAvgLongWrapUp<int32_t, accumulator_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+
+//COUNT int
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCountInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntCountInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourCountInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntCountInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+// SUM int
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                         jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumIntMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                              jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntSumIntMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+// MIN int
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                         jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinIntMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                              jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntMinIntMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinIntWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                               jint valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMinIntWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+// MAX int
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                         jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxInt(to_int, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxInt(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxInt(int64_to_hour, pRosti, pKeys, pInt, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxIntMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                              jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntMaxIntMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+//COUNT long
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCountLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntCountLong(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourCountLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntCountLong(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCountWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                              jlong valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntCountWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+// SUM long
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumShort<jlong>(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+// SUM long
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumShort<jlong>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+// SUM long
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumLong<jlong>(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumLong<jlong>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLongLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                              jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumLong<accumulator_t>(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumShortLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                               jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumShort<accumulator_t>(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumShortLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                                jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumShort<accumulator_t>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumLongLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                               jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumLong<accumulator_t>(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                               jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntSumLongMerge<int32_t, jlong>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLongLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                   jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntSumLongMerge<int32_t, accumulator_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                jlong valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntSumLongWrapUp<int32_t, jlong>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLongLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                    jlong valueAtNull, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntSumLongWrapUp<int32_t, accumulator_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount);
+    });
+}
+// sum long256
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumLong256(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                              jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumLong256(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLong256(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumLong256(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLong256Merge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                                  jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntSumLong256Merge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumLong256WrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                   jlong v0, jlong v1, jlong v2, jlong v3, jlong valueAtNullCount) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntSumLong256WrapUp<int32_t>(pRosti, valueOffset, v0, v1, v2, v3, valueAtNullCount);
+    });
+}
+
+// MAX short
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxShort(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxShort(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+// MIN short
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinShort(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinShort(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinShort(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+// COUNT float
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCountFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                             jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntCountFloat(to_int, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourCountFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                              jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntCountFloat(int64_to_hour, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+// SUM float
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumFloat(to_int, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumFloat(int64_to_hour, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+// MIN float
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinFloat(to_int, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinFloat(int64_to_hour, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+// MAX float
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxFloat(to_int, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxFloat(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat,
+                                            jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxFloat(int64_to_hour, pRosti, pKeys, pFloat, count, valueOffset);
+    });
+}
+
+// SUM byte
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntSumByte(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntSumByte(to_int, pRosti, pKeys, pByte, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourSumByte(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntSumByte(int64_to_hour, pRosti, pKeys, pByte, count, valueOffset);
+    });
+}
+
+// MIN byte
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinByte(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinByte(to_int, pRosti, pKeys, pByte, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinByte(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinByte(int64_to_hour, pRosti, pKeys, pByte, count, valueOffset);
+    });
+}
+
+// MAX byte
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxByte(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxByte(to_int, pRosti, pKeys, pByte, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxByte(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxByte(int64_to_hour, pRosti, pKeys, pByte, count, valueOffset);
+    });
+}
+
+// MIN char
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinChar(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pChar,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinChar(to_int, pRosti, pKeys, pChar, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinChar(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pChar,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinChar(int64_to_hour, pRosti, pKeys, pChar, count, valueOffset);
+    });
+}
+
+// MAX char
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxChar(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pChar,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxChar(to_int, pRosti, pKeys, pChar, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxChar(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pChar,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxChar(int64_to_hour, pRosti, pKeys, pChar, count, valueOffset);
+    });
+}
+
+// COUNT long128
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntCountLong128(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong128,
+                                               jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntCountLong128(to_int, pRosti, pKeys, pLong128, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourCountLong128(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong128,
+                                                jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntCountLong128(int64_to_hour, pRosti, pKeys, pLong128, count, valueOffset);
+    });
+}
+
+// MIN long
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMinLong(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMinLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMinLong(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                               jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntMinLongMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinLongWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                jlong valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMinLongWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMinShortWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                                 jint accumulatedValue) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMinShortWrapUp<int32_t>(pRosti, valueOffset, accumulatedValue);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxLongWrapUp(
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMaxLongWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxShortWrapUp(
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jint accumulatedValue) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMaxShortWrapUp<int32_t>(pRosti, valueOffset, accumulatedValue);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxIntWrapUp(JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset,
+                                               jint valueAtNull) {
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() {
+        return kIntMaxIntWrapUp<int32_t>(pRosti, valueOffset, valueAtNull);
+    });
+}
+
+// MAX long
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                          jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int32_t), [=]() {
+        return kIntMaxLong(to_int, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedHourMaxLong(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong,
+                                           jlong count, jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) sizeof(int64_t), [=]() {
+        return kIntMaxLong(int64_to_hour, pRosti, pKeys, pLong, count, valueOffset);
+    });
+}
+
+JNIEXPORT jboolean JNICALL
+Java_io_questdb_std_Rosti_keyedIntMaxLongMerge(JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB,
+                                               jint valueOffset) {
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() {
+        return kIntMaxLongMerge<int32_t>(pRostiA, pRostiB, valueOffset);
+    });
+}
+
+// Keyed aggregation over key shapes other than a single INT or SYMBOL column. Each key kind
+// exposes the same kernels as "keyedInt*", e.g. Rosti.keyedLongSumDouble(), as well as merge
+// and wrap-up functions of its key width. KEY_BYTES is the size of the key of a row, as recorded
+// by the performance counters.
+
+#define KEYED_AGG_FUNCTIONS(KIND, TO_KEY, KEY_BYTES) \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## Count( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_COUNT, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntCount(TO_KEY, pRosti, pKeys, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntCountDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountFloat( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntCountFloat(TO_KEY, pRosti, pKeys, pFloat, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountInt( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntCountInt(TO_KEY, pRosti, pKeys, pInt, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountLong( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntCountLong(TO_KEY, pRosti, pKeys, pLong, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountLong128( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong128, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntCountLong128(TO_KEY, pRosti, pKeys, pLong128, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## Distinct( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntDistinct(TO_KEY, pRosti, pKeys, count); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## KSumDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntKSumDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxByte( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxByte(TO_KEY, pRosti, pKeys, pByte, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxChar( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pChar, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxChar(TO_KEY, pRosti, pKeys, pChar, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxFloat( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxFloat(TO_KEY, pRosti, pKeys, pFloat, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxInt( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxInt(TO_KEY, pRosti, pKeys, pInt, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxLong( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxLong(TO_KEY, pRosti, pKeys, pLong, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxShort( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pShort, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMaxShort(TO_KEY, pRosti, pKeys, pShort, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinByte( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinByte(TO_KEY, pRosti, pKeys, pByte, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinChar( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pChar, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinChar(TO_KEY, pRosti, pKeys, pChar, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinFloat( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinFloat(TO_KEY, pRosti, pKeys, pFloat, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinInt( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinInt(TO_KEY, pRosti, pKeys, pInt, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinLong( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinLong(TO_KEY, pRosti, pKeys, pLong, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinShort( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pShort, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMinShort(TO_KEY, pRosti, pKeys, pShort, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MultiAgg( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count, jlong pAggs, jint aggCount) { \
+    return measure_time(PERF_ROSTI_KEYED_MULTI_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntMultiAgg(TO_KEY, pRosti, pKeys, count, pAggs, aggCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## NSumDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntNSumDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumByte( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pByte, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumByte(TO_KEY, pRosti, pKeys, pByte, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumFloat( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pFloat, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumFloat(TO_KEY, pRosti, pKeys, pFloat, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumInt( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pInt, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumInt(TO_KEY, pRosti, pKeys, pInt, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLong( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumLong<jlong>(TO_KEY, pRosti, pKeys, pLong, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLong256( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumLong256(TO_KEY, pRosti, pKeys, pLong, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLongLong( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pLong, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumLong<accumulator_t>(TO_KEY, pRosti, pKeys, pLong, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumShort( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pShort, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumShort<jlong>(TO_KEY, pRosti, pKeys, pShort, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumShortLong( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pShort, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntSumShort<accumulator_t>(TO_KEY, pRosti, pKeys, pShort, count, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## VarianceDouble( \
+        JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong pDouble, jlong count, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_AGG, count * (int64_t) (KEY_BYTES), [=]() { \
+        return kIntVarianceDouble(TO_KEY, pRosti, pKeys, pDouble, count, valueOffset); \
+    }); \
+}
+
+#define KEYED_MERGE_FUNCTIONS(KIND, K) \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## AvgDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntAvgDoubleWrapUp<K>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## AvgLongLongWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntAvgLongWrapUp<K, accumulator_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## AvgLongWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntAvgLongWrapUp<K, jlong>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntCountMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## CountWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntCountWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## KSumDoubleMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntKSumDoubleMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## KSumDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntKSumDoubleWrapUp<K>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxDoubleMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntMaxDoubleMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMaxDoubleWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxIntMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntMaxIntMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxIntWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jint valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMaxIntWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxLongMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntMaxLongMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxLongWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMaxLongWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MaxShortWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jint accumulatedValue) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMaxShortWrapUp<K>(pRosti, valueOffset, accumulatedValue); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinDoubleMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntMinDoubleMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMinDoubleWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinIntMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntMinIntMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinIntWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jint valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMinIntWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinLongMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntMinLongMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinLongWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMinLongWrapUp<K>(pRosti, valueOffset, valueAtNull); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## MinShortWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jint accumulatedValue) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntMinShortWrapUp<K>(pRosti, valueOffset, accumulatedValue); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## NSumDoubleMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntNSumDoubleMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## NSumDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount, jdouble valueAtNullC) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntNSumDoubleWrapUp<K>(pRosti, valueOffset, valueAtNull, valueAtNullCount, valueAtNullC); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumDoubleMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntSumDoubleMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntSumDoubleWrapUp<K>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumIntMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntSumIntMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLong256Merge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntSumLong256Merge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLong256WrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong v0, jlong v1, jlong v2, jlong v3, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntSumLong256WrapUp<K>(pRosti, valueOffset, v0, v1, v2, v3, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLongLongMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntSumLongMerge<K, accumulator_t>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLongLongWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntSumLongWrapUp<K, accumulator_t>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLongMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntSumLongMerge<K, jlong>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## SumLongWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jlong valueAtNull, jlong valueAtNullCount) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntSumLongWrapUp<K, jlong>(pRosti, valueOffset, valueAtNull, valueAtNullCount); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## VarianceDoubleMerge( \
+        JNIEnv *env, jclass cl, jlong pRostiA, jlong pRostiB, jint valueOffset) { \
+    return measure_time(PERF_ROSTI_KEYED_MERGE, map_bytes(pRostiB), [=]() { \
+        return kIntVarianceDoubleMerge<K>(pRostiA, pRostiB, valueOffset); \
+    }); \
+} \
+\
+JNIEXPORT jboolean JNICALL \
+Java_io_questdb_std_Rosti_keyed ## KIND ## VarianceDoubleWrapUp( \
+        JNIEnv *env, jclass cl, jlong pRosti, jint valueOffset, jdouble meanAtNull, jdouble m2AtNull, \
+        jlong valueAtNullCount, jboolean sample, jboolean stddev) { \
+    return measure_time(PERF_ROSTI_KEYED_WRAP_UP, map_bytes(pRosti), [=]() { \
+        return kIntVarianceDoubleWrapUp<K>(pRosti, valueOffset, meanAtNull, m2AtNull, valueAtNullCount, sample, stddev); \
+    }); \
+}
+
+// LONG, DATE and TIMESTAMP keys
+KEYED_AGG_FUNCTIONS(Long, to_long, sizeof(int64_t))
+KEYED_MERGE_FUNCTIONS(Long, int64_t)
+
+// UUID and LONG128 keys
+KEYED_AGG_FUNCTIONS(Long128, to_long128, sizeof(key128_t))
+KEYED_MERGE_FUNCTIONS(Long128, key128_t)
+
+// pairs of INT or SYMBOL keys, slots keep the packed LONG key and are merged as LONG keys
+KEYED_AGG_FUNCTIONS(IntPair, to_int_pair, 2 * sizeof(int32_t))
+
+// STRING keys
+KEYED_AGG_FUNCTIONS(Str, to_str, sizeof(int64_t))
+KEYED_MERGE_FUNCTIONS(Str, str_key_t)
+
 }
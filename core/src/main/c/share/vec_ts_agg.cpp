@@ -22,43 +22,228 @@
  *
  ******************************************************************************/
 
-#include "vec_agg.h"
+#include "vec_ts_agg.h"
 
 #define MAX_VECTOR_SIZE 512
 
 #if INSTRSET >= 10
 
-//#define HOUR_COUNT F_AVX512(keyedHourCount)
+#define SAMPLE_BY_BUCKETS F_AVX512(sampleByBuckets)
+#define SAMPLE_BY_STATS_DOUBLE F_AVX512(sampleByStatsDouble)
+#define SAMPLE_BY_STATS_INT F_AVX512(sampleByStatsInt)
+#define SAMPLE_BY_STATS_LONG F_AVX512(sampleByStatsLong)
 
 #elif INSTRSET >= 8
 
-//#define HOUR_COUNT F_AVX2(keyedHourCount)
+#define SAMPLE_BY_BUCKETS F_AVX2(sampleByBuckets)
+#define SAMPLE_BY_STATS_DOUBLE F_AVX2(sampleByStatsDouble)
+#define SAMPLE_BY_STATS_INT F_AVX2(sampleByStatsInt)
+#define SAMPLE_BY_STATS_LONG F_AVX2(sampleByStatsLong)
 
 #elif INSTRSET >= 5
 
-//#define HOUR_COUNT F_SSE41(keyedHourCount)
+#define SAMPLE_BY_BUCKETS F_SSE41(sampleByBuckets)
+#define SAMPLE_BY_STATS_DOUBLE F_SSE41(sampleByStatsDouble)
+#define SAMPLE_BY_STATS_INT F_SSE41(sampleByStatsInt)
+#define SAMPLE_BY_STATS_LONG F_SSE41(sampleByStatsLong)
 
 #elif INSTRSET >= 2
 
-//#define HOUR_COUNT F_SSE2(keyedHourCount)
+#define SAMPLE_BY_BUCKETS F_SSE2(sampleByBuckets)
+#define SAMPLE_BY_STATS_DOUBLE F_SSE2(sampleByStatsDouble)
+#define SAMPLE_BY_STATS_INT F_SSE2(sampleByStatsInt)
+#define SAMPLE_BY_STATS_LONG F_SSE2(sampleByStatsLong)
 
 #else
 
 #endif
 
+#ifdef SAMPLE_BY_BUCKETS
+
+// Splits sorted timestamps into buckets of a fixed stride, the way row-by-row SAMPLE BY does: a bucket
+// takes rows below its timestamp plus stride, the next bucket is the rounded timestamp of its first row.
+// Writes timestamp and exclusive row end of each bucket to buckets and returns the number of buckets.
+int64_t SAMPLE_BY_BUCKETS(
+        const int64_t *ts,
+        int64_t count,
+        int64_t start,
+        int64_t stride,
+        int64_t bucket_ts,
+        int64_t *buckets,
+        int64_t max_buckets
+) {
+    const int step = 8;
+    int64_t bucket_count = 0;
+    int64_t i = 0;
+    while (i < count && bucket_count < max_buckets) {
+        // wraps around as in Java
+        const int64_t hi = (int64_t) ((uint64_t) bucket_ts + (uint64_t) stride);
+        const Vec8q hiVec(hi);
+        // timestamps are sorted, rows of the bucket are the leading lanes below hi
+        for (; i < count - step + 1; i += step) {
+            _mm_prefetch(ts + i + 63 * step, _MM_HINT_T1);
+            const int64_t n = horizontal_count(Vec8q().load(ts + i) < hiVec);
+            if (n < step) {
+                i += n;
+                goto bucket_end;
+            }
+        }
+        while (i < count && ts[i] < hi) {
+            i++;
+        }
+
+        bucket_end:
+        buckets[2 * bucket_count] = bucket_ts;
+        buckets[2 * bucket_count + 1] = i;
+        bucket_count++;
+        if (i < count) {
+            bucket_ts = start + ((ts[i] - start) / stride) * stride;
+        }
+    }
+    return bucket_count;
+}
 
-#if INSTRSET < 5
+// Lanes are reduced with scalar loops: VCL horizontal templates are emitted as weak symbols and may
+// resolve to the copy built for another instruction set.
+static inline void bucket_stats(const double *d, int64_t count, bucket_stats_t<double> *stats, double null) {
+    const int step = 8;
+    int64_t i = 0;
+    double sum = 0.;
+    double minValue = D_MAX;
+    double maxValue = D_MIN;
+    int64_t nonNullCount = 0;
+    int64_t sumCount = 0;
+    if (count >= step) {
+        Vec8d vecSum = 0.;
+        Vec8d vecMin = D_MAX;
+        Vec8d vecMax = D_MIN;
+        Vec8q vecCount = 0;
+        Vec8q vecSumCount = 0;
+        for (; i < count - step + 1; i += step) {
+            _mm_prefetch(d + i + 63 * step, _MM_HINT_T1);
+            const Vec8d vec = Vec8d().load(d + i);
+            const Vec8db notNull = !is_nan(vec);
+            const Vec8db finite = is_finite(vec);
+            vecSum = if_add(finite, vecSum, vec);
+            vecSumCount = if_add(finite, vecSumCount, 1);
+            vecCount = if_add(notNull, vecCount, 1);
+            vecMin = select(notNull, min(vecMin, vec), vecMin);
+            vecMax = select(notNull, max(vecMax, vec), vecMax);
+        }
+        for (int j = 0; j < step; j++) {
+            sum += vecSum[j];
+            sumCount += vecSumCount[j];
+            nonNullCount += vecCount[j];
+            minValue = std::min(minValue, (double) vecMin[j]);
+            maxValue = std::max(maxValue, (double) vecMax[j]);
+        }
+    }
+
+    for (; i < count; i++) {
+        const double x = d[i];
+        if (PREDICT_TRUE(!std::isnan(x))) {
+            nonNullCount++;
+            if (std::isfinite(x)) {
+                sum += x;
+                sumCount++;
+            }
+            minValue = std::min(minValue, x);
+            maxValue = std::max(maxValue, x);
+        }
+    }
+
+    stats->count = nonNullCount;
+    stats->sum_count = sumCount;
+    stats->sum = sum;
+    stats->min = nonNullCount > 0 ? minValue : null;
+    stats->max = nonNullCount > 0 ? maxValue : null;
+}
 
-// Dispatchers
-//ROSTI_DISPATCHER(keyedHourCount)
+static inline Vec8q load_q(const int64_t *p) {
+    return Vec8q().load(p);
+}
 
-#define HOUR_MICROS  3600000000L
-#define DAY_HOURS  24
+// ints are sign extended, so that null stays the smallest value and sums do not overflow
+static inline Vec8q load_q(const int32_t *p) {
+    const Vec8i vec = Vec8i().load(p);
+    return Vec8q(extend_low(vec), extend_high(vec));
+}
 
-extern "C" {
+template<typename T>
+static inline void bucket_stats(const T *p, int64_t count, bucket_stats_t<int64_t> *stats, int64_t null) {
+    const int step = 8;
+    int64_t i = 0;
+    int64_t sum = 0;
+    int64_t minValue = std::numeric_limits<int64_t>::max();
+    // null is the smallest value, plain max skips it
+    int64_t maxValue = null;
+    int64_t nonNullCount = 0;
+    if (count >= step) {
+        const Vec8q nullVec(null);
+        Vec8q vecSum = 0;
+        Vec8q vecMin = std::numeric_limits<int64_t>::max();
+        Vec8q vecMax = nullVec;
+        Vec8q vecCount = 0;
+        for (; i < count - step + 1; i += step) {
+            _mm_prefetch(p + i + 63 * step, _MM_HINT_T1);
+            const Vec8q vec = load_q(p + i);
+            const Vec8qb notNull = vec != nullVec;
+            vecSum = if_add(notNull, vecSum, vec);
+            vecCount = if_add(notNull, vecCount, 1);
+            vecMin = select(notNull, min(vecMin, vec), vecMin);
+            vecMax = max(vecMax, vec);
+        }
+        for (int j = 0; j < step; j++) {
+            sum += vecSum[j];
+            nonNullCount += vecCount[j];
+            minValue = std::min(minValue, (int64_t) vecMin[j]);
+            maxValue = std::max(maxValue, (int64_t) vecMax[j]);
+        }
+    }
+
+    for (; i < count; i++) {
+        const int64_t x = p[i];
+        if (x != null) {
+            nonNullCount++;
+            sum += x;
+            minValue = std::min(minValue, x);
+            maxValue = std::max(maxValue, x);
+        }
+    }
+
+    stats->count = nonNullCount;
+    stats->sum_count = nonNullCount;
+    stats->sum = sum;
+    stats->min = nonNullCount > 0 ? minValue : null;
+    stats->max = maxValue;
+}
 
+void SAMPLE_BY_STATS_DOUBLE(const double *d, const int64_t *buckets, int64_t bucket_count, bucket_stats_t<double> *stats) {
+    sample_by_stats(d, buckets, bucket_count, stats, D_NAN, [](const double *p, int64_t count, bucket_stats_t<double> *s) {
+        bucket_stats(p, count, s, D_NAN);
+    });
+}
 
+void SAMPLE_BY_STATS_INT(const int32_t *pi, const int64_t *buckets, int64_t bucket_count, bucket_stats_t<int64_t> *stats) {
+    sample_by_stats(pi, buckets, bucket_count, stats, (int64_t) I_MIN, [](const int32_t *p, int64_t count, bucket_stats_t<int64_t> *s) {
+        bucket_stats(p, count, s, I_MIN);
+    });
+}
 
+void SAMPLE_BY_STATS_LONG(const int64_t *pl, const int64_t *buckets, int64_t bucket_count, bucket_stats_t<int64_t> *stats) {
+    sample_by_stats(pl, buckets, bucket_count, stats, (int64_t) L_MIN, [](const int64_t *p, int64_t count, bucket_stats_t<int64_t> *s) {
+        bucket_stats(p, count, s, L_MIN);
+    });
 }
 
 #endif
+
+#if INSTRSET < 5
+
+// Dispatchers
+SAMPLE_BY_BUCKETS_DISPATCHER(sampleByBuckets)
+SAMPLE_BY_STATS_DISPATCHER(sampleByStatsDouble, double, double)
+SAMPLE_BY_STATS_DISPATCHER(sampleByStatsInt, int32_t, int64_t)
+SAMPLE_BY_STATS_DISPATCHER(sampleByStatsLong, int64_t, int64_t)
+
+#endif
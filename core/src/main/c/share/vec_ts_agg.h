@@ -5,18 +5,18 @@
 #ifndef VEC_TS_AGG_H
 #define VEC_TS_AGG_H
 
-#include "vec_dispatch.h"
-#include "rosti.h"
+#include "vec_agg.h"
+#include "util.h"
 
-typedef void RostiCount(rosti_t *map, int64_t *p_micros, int64_t count, int32_t valueOffset);
+typedef int64_t SampleByBucketsFuncType(const int64_t *, int64_t, int64_t, int64_t, int64_t, int64_t *, int64_t);
 
-#define ROSTI_DISPATCHER(func) \
+#define SAMPLE_BY_BUCKETS_DISPATCHER(func) \
 \
-RostiCount F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+SampleByBucketsFuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
 \
-RostiCount *POINTER_NAME(func) = &func ## _dispatch; \
+SampleByBucketsFuncType *POINTER_NAME(func) = &func ## _dispatch; \
 \
-void F_DISPATCH(func) (rosti_t *map, int64_t *p_micros, int64_t count, int32_t valueOffset) { \
+int64_t F_DISPATCH(func) (const int64_t *ts, int64_t count, int64_t start, int64_t stride, int64_t bucket_ts, int64_t *buckets, int64_t max_buckets) { \
     const int iset = instrset_detect();  \
     if (iset >= 10) { \
         POINTER_NAME(func) = &F_AVX512(func); \
@@ -24,20 +24,58 @@ void F_DISPATCH(func) (rosti_t *map, int64_t *p_micros, int64_t count, int32_t v
         POINTER_NAME(func) = &F_AVX2(func); \
     } else if (iset >= 5) { \
         POINTER_NAME(func) = &F_SSE41(func); \
-    } else {\
+    } else { \
         POINTER_NAME(func) = &F_SSE2(func); \
     }\
-    (*POINTER_NAME(func))(map, p_micros, count, valueOffset); \
+    return (*POINTER_NAME(func))(ts, count, start, stride, bucket_ts, buckets, max_buckets); \
 } \
 \
-void func(rosti_t *map, int64_t *p_micros, int64_t count, int32_t valueOffset) { \
-    (*POINTER_NAME(func))(map, p_micros, count, valueOffset); \
+inline int64_t func(const int64_t *ts, int64_t count, int64_t start, int64_t stride, int64_t bucket_ts, int64_t *buckets, int64_t max_buckets) { \
+    return (*POINTER_NAME(func))(ts, count, start, stride, bucket_ts, buckets, max_buckets); \
 }\
+\
+extern "C" { \
+JNIEXPORT jlong JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pTimestamps, jlong count, jlong start, jlong stride, jlong bucketTimestamp, jlong pBuckets, jlong maxBuckets) { \
+    return measure_time(PERF_VEC_AGG_LONG, count * (int64_t) sizeof(int64_t), [=]() { \
+        return func((const int64_t *) pTimestamps, count, start, stride, bucketTimestamp, (int64_t *) pBuckets, maxBuckets); \
+    }); \
+}\
+\
+}
+
+#define SAMPLE_BY_STATS_DISPATCHER(func, T, S) \
+\
+typedef void func ## _FuncType(const T *, const int64_t *, int64_t, bucket_stats_t<S> *); \
+\
+func ## _FuncType F_SSE2(func), F_SSE41(func), F_AVX2(func), F_AVX512(func), F_DISPATCH(func); \
+\
+func ## _FuncType *POINTER_NAME(func) = &func ## _dispatch; \
+\
+void F_DISPATCH(func) (const T *p, const int64_t *buckets, int64_t bucket_count, bucket_stats_t<S> *stats) { \
+    const int iset = instrset_detect();  \
+    if (iset >= 10) { \
+        POINTER_NAME(func) = &F_AVX512(func); \
+    } else if (iset >= 8) { \
+        POINTER_NAME(func) = &F_AVX2(func); \
+    } else if (iset >= 5) { \
+        POINTER_NAME(func) = &F_SSE41(func); \
+    } else { \
+        POINTER_NAME(func) = &F_SSE2(func); \
+    }\
+    (*POINTER_NAME(func))(p, buckets, bucket_count, stats); \
+} \
+\
+inline void func(const T *p, const int64_t *buckets, int64_t bucket_count, bucket_stats_t<S> *stats) { \
+    (*POINTER_NAME(func))(p, buckets, bucket_count, stats); \
+}\
+\
 extern "C" { \
-JNIEXPORT void JNICALL Java_io_questdb_std_Rosti_ ## func(JNIEnv *env, jclass cl, jlong pRosti, jlong pKeys, jlong count, jint valueOffset) { \
-    auto map = reinterpret_cast<rosti_t *>(pRosti); \
-    auto *p_micros = reinterpret_cast<int64_t *>(pKeys); \
-    func(map, p_micros, count, valueOffset); \
+JNIEXPORT void JNICALL Java_io_questdb_std_Vect_ ## func(JNIEnv *env, jclass cl, jlong pData, jlong pBuckets, jlong bucketCount, jlong pStats) { \
+    const auto *buckets = (const int64_t *) pBuckets; \
+    const int64_t rows = bucketCount > 0 ? buckets[2 * bucketCount - 1] : 0; \
+    measure_time(perf_vec_agg_counter<T>(), rows * (int64_t) sizeof(T), [=]() { \
+        func((const T *) pData, buckets, bucketCount, (bucket_stats_t<S> *) pStats); \
+    }); \
 }\
 \
 }
@@ -204,6 +204,8 @@ public class Bootstrap {
         // metrics
         if (config.getMetricsConfiguration().isEnabled()) {
             metrics = Metrics.enabled();
+            // native kernel counters are cheap enough to record whenever metrics are on
+            Vect.setPerformanceCountersEnabled(true);
         } else {
             metrics = Metrics.disabled();
             log.advisoryW().$("Metrics are disabled, health check endpoint will not consider unhandled errors").$();
@@ -43,6 +43,7 @@ public class Metrics implements Scrapable {
     private final JsonQueryMetrics jsonQuery;
     private final LineMetrics line;
     private final MetricsRegistry metricsRegistry;
+    private final NativeKernelMetrics nativeKernelMetrics;
     private final PGWireMetrics pgWire;
     private final Runtime runtime = Runtime.getRuntime();
     private final VirtualLongGauge.StatProvider jvmFreeMemRef = runtime::freeMemory;
@@ -55,6 +56,7 @@ public class Metrics implements Scrapable {
     public Metrics(boolean enabled, MetricsRegistry metricsRegistry) {
         this.enabled = enabled;
         this.gcMetrics = new GCMetrics();
+        this.nativeKernelMetrics = new NativeKernelMetrics();
         this.jsonQuery = new JsonQueryMetrics(metricsRegistry);
         this.pgWire = new PGWireMetrics(metricsRegistry);
         this.line = new LineMetrics(metricsRegistry);
@@ -103,6 +105,7 @@ public class Metrics implements Scrapable {
         metricsRegistry.scrapeIntoPrometheus(sink);
         if (enabled) {
             gcMetrics.scrapeIntoPrometheus(sink);
+            nativeKernelMetrics.scrapeIntoPrometheus(sink);
         }
     }
 
@@ -211,6 +211,7 @@ public class PropServerConfiguration implements ServerConfiguration {
     private final long o3MaxLag;
     private final long o3MinLagUs;
     private final int o3OpenColumnQueueCapacity;
+    private final long o3ParallelSortMinRows;
     private final int o3PartitionPurgeListCapacity;
     private final int o3PartitionQueueCapacity;
     private final long o3PartitionSplitMinSize;
@@ -268,8 +269,14 @@ public class PropServerConfiguration implements ServerConfiguration {
     private final int sqlFloatToStrCastScale;
     private final long sqlGroupByAllocatorChunkSize;
     private final long sqlGroupByAllocatorMaxChunkSize;
+    private final boolean sqlGroupByDenseKeysEnabled;
+    private final boolean sqlGroupByFusedAggregatesEnabled;
+    private final boolean sqlGroupByLongKeysEnabled;
     private final int sqlGroupByMapCapacity;
     private final int sqlGroupByPoolCapacity;
+    private final String sqlGroupBySpillRoot;
+    private final long sqlGroupBySpillThreshold;
+    private final boolean sqlGroupByStrKeysEnabled;
     private final int sqlHashJoinLightValueMaxPages;
     private final int sqlHashJoinLightValuePageSize;
     private final int sqlHashJoinValueMaxPages;
@@ -377,6 +384,7 @@ public class PropServerConfiguration implements ServerConfiguration {
     private final long writerMiscAppendPageSize;
     private final boolean writerMixedIOEnabled;
     private final int writerTickRowsCountMod;
+    private final int zoneMapBlockRows;
     protected HttpMinServerConfiguration httpMinServerConfiguration = new PropHttpMinServerConfiguration();
     protected HttpServerConfiguration httpServerConfiguration = new PropHttpServerConfiguration();
     protected JsonQueryProcessorConfiguration jsonQueryProcessorConfiguration = new PropJsonQueryProcessorConfiguration();
@@ -969,6 +977,12 @@ public class PropServerConfiguration implements ServerConfiguration {
             this.sqlGroupByAllocatorChunkSize = getLongSize(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_ALLOCATOR_DEFAULT_CHUNK_SIZE, 128 * 1024);
             this.sqlGroupByAllocatorMaxChunkSize = getLongSize(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_ALLOCATOR_MAX_CHUNK_SIZE, 4 * Numbers.SIZE_1GB);
             this.sqlGroupByPoolCapacity = getInt(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_POOL_CAPACITY, 1024);
+            this.sqlGroupBySpillRoot = getString(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_SPILL_ROOT, tmpRoot);
+            this.sqlGroupBySpillThreshold = getLongSize(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_SPILL_THRESHOLD, 0);
+            this.sqlGroupByDenseKeysEnabled = getBoolean(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_DENSE_KEYS_ENABLED, true);
+            this.sqlGroupByFusedAggregatesEnabled = getBoolean(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_FUSED_AGGREGATES_ENABLED, true);
+            this.sqlGroupByLongKeysEnabled = getBoolean(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_LONG_KEYS_ENABLED, false);
+            this.sqlGroupByStrKeysEnabled = getBoolean(properties, env, PropertyKey.CAIRO_SQL_GROUPBY_STR_KEYS_ENABLED, false);
             this.sqlMaxSymbolNotEqualsCount = getInt(properties, env, PropertyKey.CAIRO_SQL_MAX_SYMBOL_NOT_EQUALS_COUNT, 100);
             this.sqlBindVariablePoolSize = getInt(properties, env, PropertyKey.CAIRO_SQL_BIND_VARIABLE_POOL_SIZE, 8);
             this.sqlQueryRegistryPoolSize = getInt(properties, env, PropertyKey.CAIRO_SQL_QUERY_REGISTRY_POOL_SIZE, 32);
@@ -1072,6 +1086,7 @@ public class PropServerConfiguration implements ServerConfiguration {
             this.o3MaxLag = getLong(properties, env, PropertyKey.CAIRO_O3_MAX_LAG, o3MaxLag) * 1_000;
 
             this.o3QuickSortEnabled = getBoolean(properties, env, PropertyKey.CAIRO_O3_QUICKSORT_ENABLED, false);
+            this.o3ParallelSortMinRows = getLong(properties, env, PropertyKey.CAIRO_O3_PARALLEL_SORT_MIN_ROWS, 1_000_000);
             this.rndFunctionMemoryPageSize = Numbers.ceilPow2(getIntSize(properties, env, PropertyKey.CAIRO_RND_MEMORY_PAGE_SIZE, 8192));
             this.rndFunctionMemoryMaxPages = Numbers.ceilPow2(getInt(properties, env, PropertyKey.CAIRO_RND_MEMORY_MAX_PAGES, 128));
             this.sqlStrFunctionBufferMaxSize = Numbers.ceilPow2(getInt(properties, env, PropertyKey.CAIRO_SQL_STR_FUNCTION_BUFFER_MAX_SIZE, Numbers.SIZE_1MB));
@@ -1247,6 +1262,8 @@ public class PropServerConfiguration implements ServerConfiguration {
             this.writerAsyncCommandBusyWaitTimeout = getLong(properties, env, PropertyKey.CAIRO_WRITER_ALTER_BUSY_WAIT_TIMEOUT, 500);
             this.writerAsyncCommandMaxWaitTimeout = getLong(properties, env, PropertyKey.CAIRO_WRITER_ALTER_MAX_WAIT_TIMEOUT, 30_000);
             this.writerTickRowsCountMod = Numbers.ceilPow2(getInt(properties, env, PropertyKey.CAIRO_WRITER_TICK_ROWS_COUNT, 1024)) - 1;
+            final int zoneMapBlockRows = getInt(properties, env, PropertyKey.CAIRO_ZONE_MAP_BLOCK_ROWS, 0);
+            this.zoneMapBlockRows = zoneMapBlockRows > 0 ? Numbers.ceilPow2(zoneMapBlockRows) : 0;
             this.writerAsyncCommandQueueCapacity = Numbers.ceilPow2(getInt(properties, env, PropertyKey.CAIRO_WRITER_COMMAND_QUEUE_CAPACITY, 32));
             this.writerAsyncCommandQueueSlotSize = Numbers.ceilPow2(getLongSize(properties, env, PropertyKey.CAIRO_WRITER_COMMAND_QUEUE_SLOT_SIZE, 2048));
 
@@ -2113,6 +2130,16 @@ public class PropServerConfiguration implements ServerConfiguration {
             return sqlGroupByPoolCapacity;
         }
 
+        @Override
+        public CharSequence getGroupBySpillRoot() {
+            return sqlGroupBySpillRoot;
+        }
+
+        @Override
+        public long getGroupBySpillThreshold() {
+            return sqlGroupBySpillThreshold;
+        }
+
         @Override
         public int getGroupByShardingThreshold() {
             return cairoGroupByShardingThreshold;
@@ -2253,6 +2280,11 @@ public class PropServerConfiguration implements ServerConfiguration {
             return o3OpenColumnQueueCapacity;
         }
 
+        @Override
+        public long getO3ParallelSortMinRows() {
+            return o3ParallelSortMinRows;
+        }
+
         @Override
         public int getO3PartitionQueueCapacity() {
             return o3PartitionQueueCapacity;
@@ -2822,6 +2854,31 @@ public class PropServerConfiguration implements ServerConfiguration {
             return writerTickRowsCountMod;
         }
 
+        @Override
+        public int getZoneMapBlockRows() {
+            return zoneMapBlockRows;
+        }
+
+        @Override
+        public boolean isGroupByDenseKeysEnabled() {
+            return sqlGroupByDenseKeysEnabled;
+        }
+
+        @Override
+        public boolean isGroupByFusedAggregatesEnabled() {
+            return sqlGroupByFusedAggregatesEnabled;
+        }
+
+        @Override
+        public boolean isGroupByLongKeysEnabled() {
+            return sqlGroupByLongKeysEnabled;
+        }
+
+        @Override
+        public boolean isGroupByStrKeysEnabled() {
+            return sqlGroupByStrKeysEnabled;
+        }
+
         @Override
         public boolean isIOURingEnabled() {
             return ioURingEnabled;
@@ -118,8 +118,14 @@ public enum PropertyKey implements ConfigPropertyKey {
     CAIRO_SQL_SAMPLEBY_PAGE_SIZE("cairo.sql.sampleby.page.size"),
     CAIRO_SQL_DOUBLE_CAST_SCALE("cairo.sql.double.cast.scale"),
     CAIRO_SQL_FLOAT_CAST_SCALE("cairo.sql.float.cast.scale"),
+    CAIRO_SQL_GROUPBY_DENSE_KEYS_ENABLED("cairo.sql.groupby.dense.keys.enabled"),
+    CAIRO_SQL_GROUPBY_FUSED_AGGREGATES_ENABLED("cairo.sql.groupby.fused.aggregates.enabled"),
+    CAIRO_SQL_GROUPBY_LONG_KEYS_ENABLED("cairo.sql.groupby.long.keys.enabled"),
     CAIRO_SQL_GROUPBY_MAP_CAPACITY("cairo.sql.groupby.map.capacity"),
     CAIRO_SQL_GROUPBY_POOL_CAPACITY("cairo.sql.groupby.pool.capacity"),
+    CAIRO_SQL_GROUPBY_SPILL_ROOT("cairo.sql.groupby.spill.root"),
+    CAIRO_SQL_GROUPBY_SPILL_THRESHOLD("cairo.sql.groupby.spill.threshold"),
+    CAIRO_SQL_GROUPBY_STR_KEYS_ENABLED("cairo.sql.groupby.str.keys.enabled"),
     CAIRO_SQL_GROUPBY_ALLOCATOR_DEFAULT_CHUNK_SIZE("cairo.sql.groupby.allocator.default.chunk.size"),
     CAIRO_SQL_GROUPBY_ALLOCATOR_MAX_CHUNK_SIZE("cairo.sql.groupby.allocator.max.chunk.size"),
     CAIRO_SQL_MAX_SYMBOL_NOT_EQUALS_COUNT("cairo.sql.max.symbol.not.equals.count"),
@@ -173,6 +179,7 @@ public enum PropertyKey implements ConfigPropertyKey {
     CAIRO_COMMIT_LAG("cairo.commit.lag"),
     CAIRO_O3_MAX_LAG("cairo.o3.max.lag"),
     CAIRO_O3_QUICKSORT_ENABLED("cairo.o3.quicksort.enabled"),
+    CAIRO_O3_PARALLEL_SORT_MIN_ROWS("cairo.o3.parallel.sort.min.rows"),
     CAIRO_RND_MEMORY_PAGE_SIZE("cairo.rnd.memory.page.size"),
     CAIRO_RND_MEMORY_MAX_PAGES("cairo.rnd.memory.max.pages"),
     CAIRO_REPLACE_BUFFER_MAX_SIZE("cairo.replace.buffer.max.size"),
@@ -440,6 +447,7 @@ public enum PropertyKey implements ConfigPropertyKey {
     CAIRO_WAL_APPLY_LOOK_AHEAD_TXN_COUNT("cairo.wal.apply.look.ahead.txn.count"),
     CAIRO_WAL_TEMP_PENDING_RENAME_TABLE_PREFIX("cairo.wal.temp.pending.rename.table.prefix"),
     CAIRO_WAL_WRITER_POOL_MAX_SEGMENTS("cairo.wal.writer.pool.max.segments"),
+    CAIRO_ZONE_MAP_BLOCK_ROWS("cairo.zone.map.block.rows"),
     READ_ONLY_INSTANCE("readonly"),
     CAIRO_TABLE_REGISTRY_AUTO_RELOAD_FREQUENCY("cairo.table.registry.auto.reload.frequency"),
     CAIRO_TABLE_REGISTRY_COMPACTION_THRESHOLD("cairo.table.registry.compaction.threshold"),
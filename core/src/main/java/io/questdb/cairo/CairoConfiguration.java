@@ -178,6 +178,11 @@ public interface CairoConfiguration {
 
     int getGroupByPoolCapacity();
 
+    CharSequence getGroupBySpillRoot();
+
+    // native keyed aggregation spills maps to disk once they take more memory than this, 0 disables spilling
+    long getGroupBySpillThreshold();
+
     int getGroupByShardingThreshold();
 
     @NotNull
@@ -266,6 +271,9 @@ public interface CairoConfiguration {
 
     int getO3OpenColumnQueueCapacity();
 
+    // O3 batches of at least this many rows are sorted by the O3 worker pool in parallel
+    long getO3ParallelSortMinRows();
+
     int getO3PartitionQueueCapacity();
 
     int getO3PurgeDiscoveryQueueCapacity();
@@ -556,6 +564,21 @@ public interface CairoConfiguration {
 
     int getWriterTickRowsCountMod();
 
+    // rows per zone map block, a power of 2; 0 disables zone maps of column files
+    int getZoneMapBlockRows();
+
+    // keyed vector aggregates of small key ranges, such as hour(ts) or symbol keys, use flat array instead of the map
+    boolean isGroupByDenseKeysEnabled();
+
+    // keyed vector aggregates of the same column are computed in a single pass over the keys
+    boolean isGroupByFusedAggregatesEnabled();
+
+    // keyed vector aggregates accept a single LONG, DATE, TIMESTAMP or UUID key
+    boolean isGroupByLongKeysEnabled();
+
+    // keyed vector aggregates accept a single STRING key, chars of the keys are copied to the map
+    boolean isGroupByStrKeysEnabled();
+
     boolean isIOURingEnabled();
 
     boolean isMultiKeyDedupEnabled();
@@ -295,6 +295,16 @@ public class CairoConfigurationWrapper implements CairoConfiguration {
         return getDelegate().getGroupByPoolCapacity();
     }
 
+    @Override
+    public CharSequence getGroupBySpillRoot() {
+        return getDelegate().getGroupBySpillRoot();
+    }
+
+    @Override
+    public long getGroupBySpillThreshold() {
+        return getDelegate().getGroupBySpillThreshold();
+    }
+
     @Override
     public int getGroupByShardingThreshold() {
         return getDelegate().getGroupByShardingThreshold();
@@ -440,6 +450,11 @@ public class CairoConfigurationWrapper implements CairoConfiguration {
         return getDelegate().getO3OpenColumnQueueCapacity();
     }
 
+    @Override
+    public long getO3ParallelSortMinRows() {
+        return getDelegate().getO3ParallelSortMinRows();
+    }
+
     @Override
     public int getO3PartitionQueueCapacity() {
         return getDelegate().getO3PartitionQueueCapacity();
@@ -1010,6 +1025,31 @@ public class CairoConfigurationWrapper implements CairoConfiguration {
         return getDelegate().getWriterTickRowsCountMod();
     }
 
+    @Override
+    public int getZoneMapBlockRows() {
+        return getDelegate().getZoneMapBlockRows();
+    }
+
+    @Override
+    public boolean isGroupByDenseKeysEnabled() {
+        return getDelegate().isGroupByDenseKeysEnabled();
+    }
+
+    @Override
+    public boolean isGroupByFusedAggregatesEnabled() {
+        return getDelegate().isGroupByFusedAggregatesEnabled();
+    }
+
+    @Override
+    public boolean isGroupByLongKeysEnabled() {
+        return getDelegate().isGroupByLongKeysEnabled();
+    }
+
+    @Override
+    public boolean isGroupByStrKeysEnabled() {
+        return getDelegate().isGroupByStrKeysEnabled();
+    }
+
     @Override
     public boolean isIOURingEnabled() {
         return getDelegate().isIOURingEnabled();
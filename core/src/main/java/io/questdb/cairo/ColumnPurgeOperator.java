@@ -295,6 +295,18 @@ public class ColumnPurgeOperator implements Closeable {
 
                 LOG.info().$("purging [path=").$(path).I$();
 
+                if (ZoneMapUtils.isSupported(columnType)) {
+                    // zone map goes first, the column version counts as purged once the data file is gone
+                    path.trimTo(pathTrimToPartition);
+                    ZoneMapUtils.zoneMapFile(path, columnName, columnVersion);
+                    if (couldNotRemove(ff, path)) {
+                        allDone = false;
+                        continue;
+                    }
+                    path.trimTo(pathTrimToPartition);
+                    TableUtils.dFile(path, columnName, columnVersion);
+                }
+
                 // No readers looking at the column version, files can be deleted
                 if (couldNotRemove(ff, path)) {
                     allDone = false;
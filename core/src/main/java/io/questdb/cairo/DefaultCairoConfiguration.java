@@ -303,6 +303,16 @@ public class DefaultCairoConfiguration implements CairoConfiguration {
         return 1024;
     }
 
+    @Override
+    public CharSequence getGroupBySpillRoot() {
+        return getRoot();
+    }
+
+    @Override
+    public long getGroupBySpillThreshold() {
+        return 0;
+    }
+
     @Override
     public int getGroupByShardingThreshold() {
         return 1000;
@@ -439,6 +449,11 @@ public class DefaultCairoConfiguration implements CairoConfiguration {
         return 1024;
     }
 
+    @Override
+    public long getO3ParallelSortMinRows() {
+        return 1_000_000;
+    }
+
     @Override
     public int getO3PartitionQueueCapacity() {
         return 1024;
@@ -1010,6 +1025,31 @@ public class DefaultCairoConfiguration implements CairoConfiguration {
         return 1024 - 1;
     }
 
+    @Override
+    public int getZoneMapBlockRows() {
+        return 0;
+    }
+
+    @Override
+    public boolean isGroupByDenseKeysEnabled() {
+        return true;
+    }
+
+    @Override
+    public boolean isGroupByFusedAggregatesEnabled() {
+        return true;
+    }
+
+    @Override
+    public boolean isGroupByLongKeysEnabled() {
+        return false;
+    }
+
+    @Override
+    public boolean isGroupByStrKeysEnabled() {
+        return false;
+    }
+
     @Override
     public boolean isIOURingEnabled() {
         return true;
@@ -84,6 +84,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             long dstIndexOffset,
             long dstIndexAdjust,
             int indexBlockCapacity,
@@ -204,6 +205,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
         copyTail(
                 columnCounter,
                 partCounter,
+                columnType,
                 timestampMergeIndexAddr,
                 timestampMergeIndexSize,
                 srcDataFixFd,
@@ -222,6 +224,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
                 dstVarSize,
                 dstKFd,
                 dstVFd,
+                dstZoneMapFd,
                 dstIndexOffset,
                 dstIndexAdjust,
                 indexBlockCapacity,
@@ -278,6 +281,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
         final long dstVarSize = task.getDstVarSize();
         final int dstKFd = task.getDstKFd();
         final int dskVFd = task.getDstVFd();
+        final int dstZoneMapFd = task.getDstZoneMapFd();
         final long dstIndexOffset = task.getDstIndexOffset();
         final long dstIndexAdjust = task.getDstIndexAdjust();
         final int indexBlockCapacity = task.getIndexBlockCapacity();
@@ -334,6 +338,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
                 dstVarSize,
                 dstKFd,
                 dskVFd,
+                dstZoneMapFd,
                 dstIndexOffset,
                 dstIndexAdjust,
                 indexBlockCapacity,
@@ -429,6 +434,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
     private static void copyTail(
             AtomicInteger columnCounter,
             @Nullable AtomicInteger partCounter,
+            int columnType,
             long timestampMergeIndexAddr,
             long timestampMergeIndexSize,
             int srcDataFixFd,
@@ -447,6 +453,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             long dstIndexOffset,
             long dstIndexAdjust,
             int indexBlockCapacity,
@@ -463,6 +470,10 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
     ) {
         if (partCounter == null || partCounter.decrementAndGet() == 0) {
             final FilesFacade ff = tableWriter.getFilesFacade();
+            if (dstZoneMapFd > 0) {
+                updateZoneMap(ff, columnType, dstFixAddr, Math.abs(dstFixSize), dstZoneMapFd, tableWriter);
+            }
+
             if (indexBlockCapacity > -1) {
                 updateIndex(
                         columnCounter,
@@ -746,6 +757,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
                     dstVarSize,
                     0,
                     0,
+                    0,
                     tableWriter
             );
             throw e;
@@ -821,6 +833,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
                     dstVarSize,
                     0,
                     0,
+                    0,
                     tableWriter
             );
             throw e;
@@ -878,6 +891,35 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
         }
     }
 
+    // closes dstZoneMapFd, dstFixAddr maps the column file from its first row
+    private static void updateZoneMap(
+            FilesFacade ff,
+            int columnType,
+            long dstFixAddr,
+            long dstFixSize,
+            int dstZoneMapFd,
+            TableWriter tableWriter
+    ) {
+        try {
+            ZoneMapWriter.updateO3(
+                    ff,
+                    dstZoneMapFd,
+                    Numbers.msb(tableWriter.getConfiguration().getZoneMapBlockRows()),
+                    Math.abs(columnType),
+                    dstFixAddr,
+                    dstFixSize
+            );
+        } catch (CairoException e) {
+            // the map lags behind the column file until the commit brings it up to date
+            LOG.error().$("could not update zone map [table=").utf8(tableWriter.getTableToken().getTableName())
+                    .$(", msg=").$(e.getFlyweightMessage())
+                    .$(", errno=").$(e.getErrno())
+                    .I$();
+        } finally {
+            O3Utils.close(ff, dstZoneMapFd);
+        }
+    }
+
     static void closeColumnIdle(
             AtomicInteger columnCounter,
             long timestampMergeIndexAddr,
@@ -947,6 +989,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
             long srcTimestampSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             TableWriter tableWriter
     ) {
         if (partCounter == null || partCounter.decrementAndGet() == 0) {
@@ -972,6 +1015,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
                     dstVarSize,
                     dstKFd,
                     dstVFd,
+                    dstZoneMapFd,
                     tableWriter
             );
         }
@@ -998,6 +1042,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             TableWriter tableWriter
     ) {
         try {
@@ -1008,6 +1053,7 @@ public class O3CopyJob extends AbstractQueueConsumerJob<O3CopyTask> {
             O3Utils.unmapAndClose(ff, dstVarFd, dstVarAddr, dstVarSize);
             O3Utils.close(ff, dstKFd);
             O3Utils.close(ff, dstVFd);
+            O3Utils.close(ff, dstZoneMapFd);
         } finally {
             closeColumnIdle(
                     columnCounter,
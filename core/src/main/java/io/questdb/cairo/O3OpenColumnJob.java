@@ -630,6 +630,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 0,
                 dstKFd,
                 dstVFd,
+                0,
                 dstIndexOffset,
                 dstIndexAdjust,
                 indexBlockCapacity,
@@ -880,6 +881,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
         long dstVarSize = 0;
         int dstKFd = 0;
         int dstVFd = 0;
+        int dstZoneMapFd = 0;
         final FilesFacade ff = tableWriter.getFilesFacade();
 
         try {
@@ -898,6 +900,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 dstFixFd = openRW(ff, pathToNewPartition, LOG, tableWriter.getConfiguration().getWriterFileOpenOpts());
                 dstFixSize = (srcOooHi - srcOooLo + 1) << ColumnType.pow2SizeOf(Math.abs(columnType));
                 dstFixAddr = mapRW(ff, dstFixFd, dstFixSize, MemoryTag.MMAP_O3);
+                dstZoneMapFd = openZoneMapFd(pathToNewPartition, pNewLen, columnName, columnNameTxn, columnType, tableWriter);
                 if (indexBlockCapacity > -1) {
                     BitmapIndexUtils.keyFileName(pathToNewPartition.trimTo(pNewLen), columnName, columnNameTxn);
                     dstKFd = openRW(ff, pathToNewPartition, LOG, tableWriter.getConfiguration().getWriterFileOpenOpts());
@@ -915,6 +918,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             O3Utils.unmapAndClose(ff1, dstVarFd, dstVarAddr, dstVarSize);
             O3Utils.close(ff1, dstKFd);
             O3Utils.close(ff1, dstVFd);
+            O3Utils.close(ff1, dstZoneMapFd);
             if (columnCounter.decrementAndGet() == 0) {
                 tableWriter.o3ClockDownPartitionUpdateCount();
                 tableWriter.o3CountDownDoneLatch();
@@ -963,6 +967,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 dstVarSize,
                 dstKFd,
                 dstVFd,
+                dstZoneMapFd,
                 0,
                 0,
                 indexBlockCapacity,
@@ -1081,6 +1086,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 0,
                 0,
                 0,
+                0,
                 indexBlockCapacity,
                 srcTimestampFd,
                 srcTimestampAddr,
@@ -1223,6 +1229,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 0,
                 0,
                 0,
+                0,
                 indexBlockCapacity,
                 srcTimestampFd,
                 srcTimestampAddr,
@@ -1320,6 +1327,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
         long dstFixSize = 0;
         int dstKFd = 0;
         int dstVFd = 0;
+        int dstZoneMapFd = 0;
         final int srcFixFd = Math.abs(srcDataFixFd);
         final int shl = ColumnType.pow2SizeOf(Math.abs(columnType));
         final FilesFacade ff = tableWriter.getFilesFacade();
@@ -1375,6 +1383,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             if (!mixedIOFlag) {
                 ff.madvise(dstFixAddr, dstFixSize, Files.POSIX_MADV_RANDOM);
             }
+            dstZoneMapFd = openZoneMapFd(pathToNewPartition, pNewLen, columnName, columnNameTxn, columnType, tableWriter);
 
             // when prefix is "data" we need to reduce it by "srcDataTop"
             if (prefixType == O3_BLOCK_DATA) {
@@ -1426,6 +1435,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             O3Utils.unmapAndClose(ff, dstFixFd, dstFixAddr, dstFixSize);
             O3Utils.close(ff, dstKFd);
             O3Utils.close(ff, dstVFd);
+            O3Utils.close(ff, dstZoneMapFd);
             tableWriter.o3BumpErrorCount();
             if (columnCounter.decrementAndGet() == 0) {
                 O3Utils.unmap(ff, srcTimestampAddr, srcTimestampSize);
@@ -1484,6 +1494,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 0,
                 dstKFd,
                 dstVFd,
+                dstZoneMapFd,
                 indexBlockCapacity,
                 srcTimestampFd,
                 srcTimestampAddr,
@@ -2161,6 +2172,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                     dstVarSize,
                     0,
                     0,
+                    0,
                     tableWriter
             );
             throw e;
@@ -2213,6 +2225,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 dstVarAppendOffset2,
                 0,
                 0,
+                0,
                 indexBlockCapacity,
                 srcTimestampFd,
                 srcTimestampAddr,
@@ -2227,6 +2240,27 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
         );
     }
 
+    // zone map of a column file written anew is computed by the copy job while the file is mapped
+    private static int openZoneMapFd(
+            Path pathToNewPartition,
+            int pNewLen,
+            CharSequence columnName,
+            long columnNameTxn,
+            int columnType,
+            TableWriter tableWriter
+    ) {
+        // designated timestamp type is negative
+        if (tableWriter.getConfiguration().getZoneMapBlockRows() > 0 && ZoneMapUtils.isSupported(Math.abs(columnType))) {
+            return openRW(
+                    tableWriter.getFilesFacade(),
+                    ZoneMapUtils.zoneMapFile(pathToNewPartition.trimTo(pNewLen), columnName, columnNameTxn),
+                    LOG,
+                    tableWriter.getConfiguration().getWriterFileOpenOpts()
+            );
+        }
+        return 0;
+    }
+
     private static void publishCopyTask(
             AtomicInteger columnCounter,
             @Nullable AtomicInteger partCounter,
@@ -2267,6 +2301,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             long dstIndexOffset,
             long dstIndexAdjust,
             int indexBlockCapacity,
@@ -2323,6 +2358,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                     dstVarSize,
                     dstKFd,
                     dstVFd,
+                    dstZoneMapFd,
                     dstIndexOffset,
                     dstIndexAdjust,
                     indexBlockCapacity,
@@ -2380,6 +2416,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                     dstVarSize,
                     dstKFd,
                     dstVFd,
+                    dstZoneMapFd,
                     dstIndexOffset,
                     dstIndexAdjust,
                     indexBlockCapacity,
@@ -2438,6 +2475,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             long dstIndexOffset,
             long dstIndexAdjust,
             int indexBlockCapacity,
@@ -2497,6 +2535,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                     dstVarSize,
                     dstKFd,
                     dstVFd,
+                    dstZoneMapFd,
                     dstIndexOffset,
                     dstIndexAdjust,
                     indexBlockCapacity,
@@ -2552,6 +2591,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                     dstVarSize,
                     dstKFd,
                     dstVFd,
+                    dstZoneMapFd,
                     dstIndexOffset,
                     dstIndexAdjust,
                     indexBlockCapacity,
@@ -2610,6 +2650,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             long dstIndexOffset,
             long dstIndexAdjust,
             int indexBlockCapacity,
@@ -2666,6 +2707,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                 dstVarSize,
                 dstKFd,
                 dstVFd,
+                dstZoneMapFd,
                 dstIndexOffset,
                 dstIndexAdjust,
                 indexBlockCapacity,
@@ -2729,6 +2771,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
             long dstVarAppendOffset2,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             int indexBlockCapacity,
             int srcTimestampFd,
             long srcTimestampAddr,
@@ -2784,6 +2827,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
@@ -2840,6 +2884,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
@@ -2901,6 +2946,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
@@ -2957,6 +3003,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
@@ -3013,6 +3060,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
@@ -3074,6 +3122,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
@@ -3130,6 +3179,7 @@ public class O3OpenColumnJob extends AbstractQueueConsumerJob<O3OpenColumnTask>
                         dstVarSize,
                         dstKFd,
                         dstVFd,
+                        dstZoneMapFd,
                         0,
                         dstIndexAdjust,
                         indexBlockCapacity,
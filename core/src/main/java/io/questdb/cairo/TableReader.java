@@ -68,6 +68,9 @@ public class TableReader implements Closeable, SymbolTableSource {
     private final MemoryMR todoMem = Vm.getMRInstance();
     private final TxReader txFile;
     private final TxnScoreboard txnScoreboard;
+    private final int zoneMapBlockRowsShift;
+    // zone map readers by column base + column index, a reader is reopened once its partition or column changes
+    private final ObjList<ZoneMapReader> zoneMaps = new ObjList<>();
     private ObjList<BitmapIndexReader> bitmapIndexes;
     private int columnCount;
     private int columnCountShl;
@@ -96,6 +99,7 @@ public class TableReader implements Closeable, SymbolTableSource {
         this.configuration = configuration;
         this.clock = configuration.getMillisecondClock();
         this.maxOpenPartitions = configuration.getInactiveReaderMaxOpenPartitions();
+        this.zoneMapBlockRowsShift = configuration.getZoneMapBlockRows() > 0 ? Numbers.msb(configuration.getZoneMapBlockRows()) : -1;
         this.ff = configuration.getFilesFacade();
         this.tableToken = tableToken;
         this.messageBus = messageBus;
@@ -172,6 +176,7 @@ public class TableReader implements Closeable, SymbolTableSource {
             goPassive();
             freeSymbolMapReaders();
             freeBitmapIndexCache();
+            Misc.freeObjList(zoneMaps);
             Misc.free(metadata);
             Misc.free(txFile);
             Misc.free(todoMem);
@@ -331,6 +336,64 @@ public class TableReader implements Closeable, SymbolTableSource {
         return txnScoreboard;
     }
 
+    /**
+     * Zone map of a fixed-size column in an open partition.
+     *
+     * @param partitionIndex partition index
+     * @param columnIndex    column index
+     * @return zone map reader or null when zone maps are disabled, not supported for the column type or
+     * there are no summarised blocks of the column in the partition
+     */
+    @Nullable
+    public ZoneMapReader getZoneMap(int partitionIndex, int columnIndex) {
+        if (zoneMapBlockRowsShift < 0) {
+            return null;
+        }
+        final int columnType = metadata.getColumnType(columnIndex);
+        if (!ZoneMapUtils.isSupported(columnType)) {
+            return null;
+        }
+        final int columnBase = getColumnBase(partitionIndex);
+        final long partitionRowCount = getPartitionRowCount(partitionIndex);
+        final long columnTop = getColumnTop(columnBase, columnIndex);
+        final long columnRowCount = partitionRowCount - columnTop;
+        if ((columnRowCount >> zoneMapBlockRowsShift) < 1) {
+            return null;
+        }
+        final int offset = partitionIndex * PARTITIONS_SLOT_SIZE;
+        final long partitionTimestamp = openPartitionInfo.getQuick(offset);
+        final long partitionNameTxn = openPartitionInfo.getQuick(offset + PARTITIONS_SLOT_OFFSET_NAME_TXN);
+        final long columnNameTxn = columnVersionReader.getColumnNameTxn(partitionTimestamp, metadata.getWriterIndex(columnIndex));
+
+        final int index = columnBase + columnIndex;
+        ZoneMapReader reader = zoneMaps.getQuiet(index);
+        if (reader == null) {
+            reader = new ZoneMapReader();
+            zoneMaps.extendAndSet(index, reader);
+        }
+        if (!reader.isOpenFor(partitionTimestamp, partitionNameTxn, columnNameTxn, columnTop, columnRowCount, txTruncateVersion)) {
+            final Path path = pathGenPartitioned(partitionIndex);
+            try {
+                reader.of(
+                        ff,
+                        path,
+                        partitionTimestamp,
+                        partitionNameTxn,
+                        metadata.getColumnName(columnIndex),
+                        columnNameTxn,
+                        columnType,
+                        columnTop,
+                        columnRowCount,
+                        txTruncateVersion,
+                        zoneMapBlockRowsShift
+                );
+            } finally {
+                path.trimTo(rootLen);
+            }
+        }
+        return reader.getBlockCount() > 0 ? reader : null;
+    }
+
     public void goActive() {
         reload();
     }
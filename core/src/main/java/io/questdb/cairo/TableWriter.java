@@ -100,6 +100,17 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
     };
     private static final Row NOOP_ROW = new NoOpRow();
     private static final int O3_ERRNO_FATAL = Integer.MAX_VALUE - 1;
+    // rows times columns shuffled by a task of the fused lag merge
+    private static final long O3_MERGE_SHUFFLE_TASK_CELLS = 1024 * 1024;
+    private static final int O3_MERGE_SHUFFLE_MAX_TASKS = 64;
+    private static final long O3_PARALLEL_SORT_CHUNK_ROWS = 256 * 1024;
+    private static final int O3_PARALLEL_SORT_MAX_CHUNKS = 64;
+    private static final int O3_SORT_PHASE_BUCKET = 3;
+    private static final int O3_SORT_PHASE_COUNT = 1;
+    private static final int O3_SORT_PHASE_SAMPLE = 0;
+    private static final int O3_SORT_PHASE_SCATTER = 2;
+    private static final int O3_SORT_VAR_COLUMN_MAX_TASKS = 16;
+    private static final long O3_SORT_VAR_COLUMN_TASK_ROWS = 256 * 1024;
     private static final int ROW_ACTION_NO_PARTITION = 1;
     private static final int ROW_ACTION_NO_TIMESTAMP = 2;
     private static final int ROW_ACTION_O3 = 3;
@@ -148,6 +159,10 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
     private final SOUnboundedCountDownLatch o3DoneLatch = new SOUnboundedCountDownLatch();
     private final AtomicInteger o3ErrorCount = new AtomicInteger();
     private final long[] o3LastTimestampSpreads;
+    private final DirectLongList o3MergeShuffleColumns = new DirectLongList(16 * Vect.MERGE_SHUFFLE_COLUMN_LONGS, MemoryTag.NATIVE_O3);
+    // address, offset and size of mapped lag buffers of the fused lag merge
+    private final LongList o3MergeShuffleLagBuffers = new LongList();
+    private final long o3ParallelSortMinRows;
     private final AtomicLong o3PartitionUpdRemaining = new AtomicLong();
     private final boolean o3QuickSortEnabled;
     private final Path other;
@@ -178,6 +193,9 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
     private final WeakClosableObjectPool<IntList> walFdCacheListPool = new WeakClosableObjectPool<>(IntList::new, 5, true);
     private final LongObjHashMap.LongObjConsumer<IntList> walFdCloseCachedFdAction;
     private final ObjList<MemoryCMOR> walMappedColumns = new ObjList<>();
+    // timestamps of partitions that got rows in the current transaction, other than the last partition
+    private final LongList zoneMapPartitions = new LongList();
+    private final ZoneMapWriter zoneMapWriter;
     private ObjList<? extends MemoryA> activeColumns;
     private ObjList<Runnable> activeNullSetters;
     private ColumnVersionReader attachColumnVersionReader;
@@ -229,12 +247,15 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
     private int rowAction = ROW_ACTION_OPEN_PARTITION;
     private TableToken tableToken;
     private final O3ColumnUpdateMethod o3MoveWalFromFilesToLastPartitionRef = this::o3MoveWalFromFilesToLastPartition;
+    private final O3ColumnUpdateMethod o3RadixSortTaskRef = this::o3RadixSortTask;
     private final O3ColumnUpdateMethod o3SortFixColumnRef = this::o3SortFixColumn;
     private final O3ColumnUpdateMethod o3SortVarColumnRef = this::o3SortVarColumn;
+    private final O3ColumnUpdateMethod o3SortVarColumnDataRef = this::o3SortVarColumnData;
+    private final O3ColumnUpdateMethod o3SortVarColumnOffsetsRef = this::o3SortVarColumnOffsets;
     private final O3ColumnUpdateMethod o3MergeVarColumnLagRef = this::o3MergeVarColumnLag;
     private final O3ColumnUpdateMethod o3MoveUncommittedRef = this::o3MoveUncommitted0;
     private final O3ColumnUpdateMethod o3MoveLagRef = this::o3MoveLag0;
-    private final O3ColumnUpdateMethod o3MergeFixColumnLagRef = this::o3MergeFixColumnLag;
+    private final O3ColumnUpdateMethod o3MergeShuffleFixColumnsRef = this::o3MergeShuffleFixColumns;
     private long tempMem16b = Unsafe.malloc(16, MemoryTag.NATIVE_TABLE_WRITER);
     private LongConsumer timestampSetter;
     private long todoTxn;
@@ -274,6 +295,8 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         this.fileOperationRetryCount = configuration.getFileOperationRetryCount();
         this.tableToken = tableToken;
         this.o3QuickSortEnabled = configuration.isO3QuickSortEnabled();
+        this.o3ParallelSortMinRows = configuration.getO3ParallelSortMinRows();
+        this.zoneMapWriter = configuration.getZoneMapBlockRows() > 0 ? new ZoneMapWriter(configuration) : null;
         if (tableToken.isSystem()) {
             this.o3ColumnMemorySize = configuration.getSystemO3ColumnMemorySize();
             this.dataAppendPageSize = configuration.getSystemDataAppendPageSize();
@@ -1000,6 +1023,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
             txWriter.commit(denseSymbolMapWriters);
 
             squashSplitPartitions(minSplitPartitionTimestamp, txWriter.maxTimestamp, configuration.getO3LastPartitionMaxSplits());
+            updateZoneMaps();
 
             // Bookmark masterRef to track how many rows is in uncommitted state
             committedMasterRef = masterRef;
@@ -1744,7 +1768,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
 
                         final long tsLagBufferAddr = mapAppendColumnBuffer(timestampColumn, tsLagOffset, tsLagSize, false);
                         try {
-                            Vect.radixSortABLongIndexAsc(
+                            o3RadixSort(
                                     Math.abs(tsLagBufferAddr),
                                     walLagRowCount,
                                     mappedTimestampIndexAddr,
@@ -2097,6 +2121,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
             try {
                 LOG.info().$("tx rollback [name=").utf8(tableToken.getTableName()).I$();
                 partitionRemoveCandidates.clear();
+                zoneMapPartitions.clear();
                 o3CommitBatchTimestampMin = Long.MAX_VALUE;
                 if ((masterRef & 1) != 0) {
                     masterRef++;
@@ -3160,6 +3185,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
 
             // Check if partitions are split into too many pieces and merge few of them back.
             squashSplitPartitions(minSplitPartitionTimestamp, txWriter.getMaxTimestamp(), configuration.getO3LastPartitionMaxSplits());
+            updateZoneMaps();
 
             // Bookmark masterRef to track how many rows is in uncommitted state
             this.committedMasterRef = masterRef;
@@ -3559,9 +3585,11 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         Misc.free(attachIndexBuilder);
         Misc.free(columnVersionWriter);
         Misc.free(o3PartitionUpdateSink);
+        Misc.free(o3MergeShuffleColumns);
         Misc.free(slaveTxReader);
         Misc.free(commandQueue);
         Misc.free(dedupColumnCommitAddresses);
+        Misc.free(zoneMapWriter);
         closeWalFiles();
         updateOperatorImpl = Misc.free(updateOperatorImpl);
         dropIndexOperator = null;
@@ -3962,6 +3990,8 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         } else if (ColumnType.isSymbol(columnType) && metadata.isColumnIndexed(columnIndex)) {
             linkFile(ff, keyFileName(path.trimTo(plen), columnName, columnNameTxn), keyFileName(other.trimTo(plen), newName, newColumnNameTxn));
             linkFile(ff, valueFileName(path.trimTo(plen), columnName, columnNameTxn), valueFileName(other.trimTo(plen), newName, newColumnNameTxn));
+        } else if (ZoneMapUtils.isSupported(columnType)) {
+            linkFile(ff, ZoneMapUtils.zoneMapFile(path.trimTo(plen), columnName, columnNameTxn), ZoneMapUtils.zoneMapFile(other.trimTo(plen), newName, newColumnNameTxn));
         }
         path.trimTo(rootLen);
         other.trimTo(rootLen);
@@ -4086,6 +4116,12 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         }
     }
 
+    private void markZoneMapPartition(long partitionTimestamp) {
+        if (zoneMapWriter != null) {
+            zoneMapPartitions.add(partitionTimestamp);
+        }
+    }
+
     private void mmapWalColumns(@Transient Path walPath, long walSegmentId, int timestampIndex, long rowLo, long rowHi) {
         walMappedColumns.clear();
         int walPathLen = walPath.size();
@@ -4220,7 +4256,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
             assert o3TimestampMem.getAppendOffset() == o3RowCount * TIMESTAMP_MERGE_ENTRY_BYTES;
             if (o3RowCount > 600 || !o3QuickSortEnabled) {
                 o3TimestampMemCpy.jumpTo(o3TimestampMem.getAppendOffset());
-                Vect.radixSortLongIndexAscInPlace(sortedTimestampsAddr, o3RowCount, o3TimestampMemCpy.addressOf(0));
+                o3RadixSort(0, 0, sortedTimestampsAddr, o3RowCount, sortedTimestampsAddr, o3TimestampMemCpy.addressOf(0));
             } else {
                 Vect.quickSortLongIndexAscInPlace(sortedTimestampsAddr, o3RowCount);
             }
@@ -4479,6 +4515,11 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
                     partitionIndexRaw = txWriter.findAttachedPartitionRawIndexByLoTimestamp(partitionTimestamp);
                 }
 
+                markZoneMapPartition(partitionTimestamp);
+                if (newPartitionTimestamp != partitionTimestamp) {
+                    markZoneMapPartition(newPartitionTimestamp);
+                }
+
                 if (partitionTimestamp == lastPartitionTimestamp && newPartitionTimestamp == partitionTimestamp) {
                     if (partitionMutates) {
                         // Last partition is rewritten.
@@ -4636,6 +4677,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
                             copyTask.getSrcTimestampSize(),
                             copyTask.getDstKFd(),
                             copyTask.getDstVFd(),
+                            copyTask.getDstZoneMapFd(),
                             this
                     );
                     copySubSeq.done(cursor);
@@ -4667,86 +4709,52 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         }
     }
 
-    private void o3MergeFixColumnLag(int columnIndex, int columnType, long mergeIndex, long mergeCount, long lagRows, long mappedRowLo, long mappedRowHi) {
-        if (o3ErrorCount.get() > 0) {
-            return;
-        }
-        try {
-            final int primaryColumnIndex = getPrimaryColumnIndex(columnIndex);
-            final MemoryMA lagMem = columns.getQuick(primaryColumnIndex);
-            final MemoryCR mappedMem = o3Columns.getQuick(primaryColumnIndex);
-            final MemoryCARW destMem = o3MemColumns2.getQuick(primaryColumnIndex);
+    // Maps lag rows of the column and adds the column to the fused lag merge, see o3MergeShuffleFixColumns()
+    private void o3MergeFixColumnLagPrepare(int columnIndex, int columnType, long mergeCount, long lagRows, long mappedRowLo) {
+        final int primaryColumnIndex = getPrimaryColumnIndex(columnIndex);
+        final MemoryMA lagMem = columns.getQuick(primaryColumnIndex);
+        final MemoryCR mappedMem = o3Columns.getQuick(primaryColumnIndex);
+        final MemoryCARW destMem = o3MemColumns2.getQuick(primaryColumnIndex);
 
-            final int shl = ColumnType.pow2SizeOf(columnType);
-            destMem.jumpTo(mergeCount << shl);
-            final long srcMapped = mappedMem.addressOf(mappedRowLo << shl) - (mappedRowLo << shl);
-            long lagMemOffset = (txWriter.getTransientRowCount() - getColumnTop(columnIndex)) << shl;
-            long lagAddr = mapAppendColumnBuffer(lagMem, lagMemOffset, lagRows << shl, false);
-            try {
-                long srcLag = Math.abs(lagAddr);
-                destMem.shiftAddressRight(0);
-                final long dest = destMem.addressOf(0);
-                if (srcLag == 0 && lagRows != 0) {
-                    throw CairoException.critical(0)
-                            .put("cannot sort WAL data, lag rows are missing [table").put(tableToken.getTableName())
-                            .put(", columnName=").put(metadata.getColumnName(columnIndex))
-                            .put(", type=").put(ColumnType.nameOf(columnType))
-                            .put(", lagRows=").put(lagRows)
-                            .put(']');
-                }
-                if (srcMapped == 0) {
-                    throw CairoException.critical(0)
-                            .put("cannot sort WAL data, rows are missing [table").put(tableToken.getTableName())
-                            .put(", columnName=").put(metadata.getColumnName(columnIndex))
-                            .put(", type=").put(ColumnType.nameOf(columnType))
-                            .put(']');
-                }
-                if (dest == 0) {
-                    throw CairoException.critical(0)
-                            .put("cannot sort WAL data, destination buffer is empty [table").put(tableToken.getTableName())
-                            .put(", columnName=").put(metadata.getColumnName(columnIndex))
-                            .put(", type=").put(ColumnType.nameOf(columnType))
-                            .put(']');
-                }
+        final int shl = ColumnType.pow2SizeOf(columnType);
+        destMem.jumpTo(mergeCount << shl);
+        final long srcMapped = mappedMem.addressOf(mappedRowLo << shl) - (mappedRowLo << shl);
+        final long lagMemOffset = (txWriter.getTransientRowCount() - getColumnTop(columnIndex)) << shl;
+        final long lagAddr = mapAppendColumnBuffer(lagMem, lagMemOffset, lagRows << shl, false);
+        o3MergeShuffleLagBuffers.add(lagAddr, lagMemOffset);
+        o3MergeShuffleLagBuffers.add(lagRows << shl);
 
-                switch (shl) {
-                    case 0:
-                        Vect.mergeShuffle8Bit(srcLag, srcMapped, dest, mergeIndex, mergeCount);
-                        break;
-                    case 1:
-                        Vect.mergeShuffle16Bit(srcLag, srcMapped, dest, mergeIndex, mergeCount);
-                        break;
-                    case 2:
-                        Vect.mergeShuffle32Bit(srcLag, srcMapped, dest, mergeIndex, mergeCount);
-                        break;
-                    case 3:
-                        Vect.mergeShuffle64Bit(srcLag, srcMapped, dest, mergeIndex, mergeCount);
-                        break;
-                    case 4:
-                        Vect.mergeShuffle128Bit(srcLag, srcMapped, dest, mergeIndex, mergeCount);
-                        break;
-                    case 5:
-                        Vect.mergeShuffle256Bit(srcLag, srcMapped, dest, mergeIndex, mergeCount);
-                        break;
-                    default:
-                        assert false : "col type is unsupported";
-                        break;
-                }
-            } finally {
-                mapAppendColumnBufferRelease(lagAddr, lagMemOffset, lagRows << shl);
-            }
-        } catch (Throwable e) {
-            handleWorkStealingException(
-                    "cannot merge fix column into lag",
-                    columnIndex,
-                    columnType,
-                    mergeIndex,
-                    lagRows,
-                    mappedRowLo,
-                    mappedRowHi,
-                    e
-            );
+        final long srcLag = Math.abs(lagAddr);
+        destMem.shiftAddressRight(0);
+        final long dest = destMem.addressOf(0);
+        if (srcLag == 0 && lagRows != 0) {
+            throw CairoException.critical(0)
+                    .put("cannot sort WAL data, lag rows are missing [table").put(tableToken.getTableName())
+                    .put(", columnName=").put(metadata.getColumnName(columnIndex))
+                    .put(", type=").put(ColumnType.nameOf(columnType))
+                    .put(", lagRows=").put(lagRows)
+                    .put(']');
         }
+        if (srcMapped == 0) {
+            throw CairoException.critical(0)
+                    .put("cannot sort WAL data, rows are missing [table").put(tableToken.getTableName())
+                    .put(", columnName=").put(metadata.getColumnName(columnIndex))
+                    .put(", type=").put(ColumnType.nameOf(columnType))
+                    .put(']');
+        }
+        if (dest == 0) {
+            throw CairoException.critical(0)
+                    .put("cannot sort WAL data, destination buffer is empty [table").put(tableToken.getTableName())
+                    .put(", columnName=").put(metadata.getColumnName(columnIndex))
+                    .put(", type=").put(ColumnType.nameOf(columnType))
+                    .put(']');
+        }
+        assert shl <= 5 : "col type is unsupported";
+
+        o3MergeShuffleColumns.add(srcLag);
+        o3MergeShuffleColumns.add(srcMapped);
+        o3MergeShuffleColumns.add(dest);
+        o3MergeShuffleColumns.add(shl);
     }
 
     private void o3MergeIntoLag(long mergedTimestamps, long mergeCount, long countInLag, long mappedRowLo, long mappedRoHi, int timestampIndex) {
@@ -4755,42 +4763,96 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
 
         o3DoneLatch.reset();
         o3ErrorCount.set(0);
+        o3MergeShuffleColumns.clear();
+        o3MergeShuffleLagBuffers.clear();
 
-        int queuedCount = 0;
-        for (int i = 0; i < columnCount; i++) {
-            final int type = metadata.getColumnType(i);
-            if (timestampIndex != i && type > 0) {
-                long cursor = pubSeq.next();
-                if (cursor > -1) {
-                    final O3CallbackTask task = queue.get(cursor);
-                    task.of(
-                            o3DoneLatch,
-                            i,
-                            type,
-                            mergedTimestamps,
-                            mergeCount,
-                            countInLag,
-                            mappedRowLo,
-                            mappedRoHi,
-                            ColumnType.isVariableLength(type) ? o3MergeVarColumnLagRef : o3MergeFixColumnLagRef
-                    );
-                    queuedCount++;
-                    pubSeq.done(cursor);
-                } else {
-                    o3MergeIntoLagColumn(mergedTimestamps, mergeCount, i, type, countInLag, mappedRowLo, mappedRoHi);
+        try {
+            // Fixed size columns are shuffled together, each task reads a range of the merge index once
+            // and writes it to all the columns. Buffers are prepared before any task is published.
+            for (int i = 0; i < columnCount; i++) {
+                final int type = metadata.getColumnType(i);
+                if (timestampIndex != i && type > 0 && !ColumnType.isVariableLength(type)) {
+                    o3MergeFixColumnLagPrepare(i, type, mergeCount, countInLag, mappedRowLo);
                 }
             }
-        }
 
-        dispatchO3CallbackQueue(queue, queuedCount);
+            int queuedCount = 0;
+            for (int i = 0; i < columnCount; i++) {
+                final int type = metadata.getColumnType(i);
+                if (timestampIndex != i && type > 0 && ColumnType.isVariableLength(type)) {
+                    long cursor = pubSeq.next();
+                    if (cursor > -1) {
+                        final O3CallbackTask task = queue.get(cursor);
+                        task.of(
+                                o3DoneLatch,
+                                i,
+                                type,
+                                mergedTimestamps,
+                                mergeCount,
+                                countInLag,
+                                mappedRowLo,
+                                mappedRoHi,
+                                o3MergeVarColumnLagRef
+                        );
+                        queuedCount++;
+                        pubSeq.done(cursor);
+                    } else {
+                        o3MergeVarColumnLag(i, type, mergedTimestamps, mergeCount, countInLag, mappedRowLo, mappedRoHi);
+                    }
+                }
+            }
+
+            final long fixColumnCount = o3MergeShuffleColumns.size() / Vect.MERGE_SHUFFLE_COLUMN_LONGS;
+            if (fixColumnCount > 0) {
+                final int taskCount = (int) Math.max(1, Math.min(O3_MERGE_SHUFFLE_MAX_TASKS, mergeCount * fixColumnCount / O3_MERGE_SHUFFLE_TASK_CELLS));
+                final long taskRows = (mergeCount + taskCount - 1) / taskCount;
+                for (int t = 0; t < taskCount; t++) {
+                    final long rowLo = t * taskRows;
+                    final long rowHi = Math.min(mergeCount, rowLo + taskRows);
+                    long cursor = pubSeq.next();
+                    if (cursor > -1) {
+                        final O3CallbackTask task = queue.get(cursor);
+                        task.of(
+                                o3DoneLatch,
+                                t,
+                                (int) fixColumnCount,
+                                mergedTimestamps,
+                                rowLo,
+                                rowHi,
+                                IGNORE,
+                                IGNORE,
+                                o3MergeShuffleFixColumnsRef
+                        );
+                        queuedCount++;
+                        pubSeq.done(cursor);
+                    } else {
+                        o3MergeShuffleFixColumns(t, (int) fixColumnCount, mergedTimestamps, rowLo, rowHi, IGNORE, IGNORE);
+                    }
+                }
+            }
+
+            dispatchO3CallbackQueue(queue, queuedCount);
+        } finally {
+            for (int i = 0, n = o3MergeShuffleLagBuffers.size(); i < n; i += 3) {
+                mapAppendColumnBufferRelease(
+                        o3MergeShuffleLagBuffers.getQuick(i),
+                        o3MergeShuffleLagBuffers.getQuick(i + 1),
+                        o3MergeShuffleLagBuffers.getQuick(i + 2)
+                );
+            }
+            o3MergeShuffleLagBuffers.clear();
+        }
         swapO3ColumnsExcept(timestampIndex);
     }
 
-    private void o3MergeIntoLagColumn(long mergedTimestampAddress, long mergeCount, int columnIndex, int type, long lagRows, long mappedRowLo, long mappedRowHi) {
-        if (ColumnType.isVariableLength(type)) {
-            o3MergeVarColumnLag(columnIndex, type, mergedTimestampAddress, mergeCount, lagRows, mappedRowLo, mappedRowHi);
-        } else {
-            o3MergeFixColumnLag(columnIndex, type, mergedTimestampAddress, mergeCount, lagRows, mappedRowLo, mappedRowHi);
+    private void o3MergeShuffleFixColumns(int task, int fixColumnCount, long mergeIndex, long rowLo, long rowHi, long ignore1, long ignore2) {
+        if (o3ErrorCount.get() > 0) {
+            return;
+        }
+        try {
+            Vect.mergeShuffleFixedColumns(o3MergeShuffleColumns.getAddress(), fixColumnCount, mergeIndex, rowLo, rowHi);
+        } catch (Throwable th) {
+            handleWorkStealingException("cannot merge fix columns into lag", task, fixColumnCount, mergeIndex, rowLo, rowHi, IGNORE, th);
         }
     }
 
@@ -5302,6 +5364,102 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         }
     }
 
+    // Sorts timestamp index of A and B rows, see Vect.radixSortABLongIndexAsc(). Large batches are sorted in phases,
+    // tasks of each phase are run by O3 callback workers and this thread. Sorting in place is done with pDataA = 0
+    // and pDataDest = pDataB.
+    private void o3RadixSort(long pDataA, long countA, long pDataB, long countB, long pDataDest, long pDataCpy) {
+        final long rowCount = countA + countB;
+        if (rowCount >= o3ParallelSortMinRows) {
+            final int chunkCount = (int) Math.min(O3_PARALLEL_SORT_MAX_CHUNKS, Math.max(2, rowCount / O3_PARALLEL_SORT_CHUNK_ROWS));
+            final long pState = Vect.radixSortParallelCreate(pDataA, countA, pDataB, countB, pDataDest, pDataCpy, chunkCount);
+            if (pState != 0) {
+                o3ErrorCount.set(0);
+                lastErrno = 0;
+                try {
+                    final int chunks = Vect.radixSortParallelChunkCount(pState);
+                    o3RadixSortPhase(pState, O3_SORT_PHASE_SAMPLE, chunks);
+                    Vect.radixSortParallelPlan(pState);
+                    o3RadixSortPhase(pState, O3_SORT_PHASE_COUNT, chunks);
+                    Vect.radixSortParallelOffsets(pState);
+                    o3RadixSortPhase(pState, O3_SORT_PHASE_SCATTER, chunks);
+                    o3RadixSortPhase(pState, O3_SORT_PHASE_BUCKET, Vect.RADIX_SORT_PARALLEL_BUCKETS);
+                } finally {
+                    Vect.radixSortParallelFree(pState);
+                }
+                LOG.debug().$("parallel sort [table=").utf8(tableToken.getTableName())
+                        .$(", rows=").$(rowCount)
+                        .$(", chunks=").$(chunkCount)
+                        .I$();
+                return;
+            }
+            LOG.info().$("could not allocate parallel sort state, sorting on single thread [table=").utf8(tableToken.getTableName())
+                    .$(", rows=").$(rowCount)
+                    .I$();
+        }
+
+        if (pDataA == 0 && pDataDest == pDataB) {
+            Vect.radixSortLongIndexAscInPlace(pDataB, countB, pDataCpy);
+        } else {
+            Vect.radixSortABLongIndexAsc(pDataA, countA, pDataB, countB, pDataDest, pDataCpy);
+        }
+    }
+
+    private void o3RadixSortPhase(long pState, int phase, int taskCount) {
+        final Sequence pubSeq = this.messageBus.getO3CallbackPubSeq();
+        final RingQueue<O3CallbackTask> queue = this.messageBus.getO3CallbackQueue();
+        o3DoneLatch.reset();
+        int queuedCount = 0;
+        for (int task = 0; task < taskCount; task++) {
+            long cursor = pubSeq.next();
+            if (cursor > -1) {
+                try {
+                    queue.get(cursor).of(
+                            o3DoneLatch,
+                            task,
+                            phase,
+                            pState,
+                            IGNORE,
+                            IGNORE,
+                            IGNORE,
+                            IGNORE,
+                            o3RadixSortTaskRef
+                    );
+                } finally {
+                    queuedCount++;
+                    pubSeq.done(cursor);
+                }
+            } else {
+                o3RadixSortTask(task, phase, pState, IGNORE, IGNORE, IGNORE, IGNORE);
+            }
+        }
+        // the next phase reads what all tasks of this phase wrote
+        dispatchO3CallbackQueue(queue, queuedCount);
+    }
+
+    private void o3RadixSortTask(int task, final int phase, long pState, long ignore1, long ignore2, long ignore3, long ignore4) {
+        if (o3ErrorCount.get() > 0) {
+            return;
+        }
+        try {
+            switch (phase) {
+                case O3_SORT_PHASE_SAMPLE:
+                    Vect.radixSortParallelSample(pState, task);
+                    break;
+                case O3_SORT_PHASE_COUNT:
+                    Vect.radixSortParallelCount(pState, task);
+                    break;
+                case O3_SORT_PHASE_SCATTER:
+                    Vect.radixSortParallelScatter(pState, task);
+                    break;
+                default:
+                    Vect.radixSortParallelBucket(pState, task);
+                    break;
+            }
+        } catch (Throwable th) {
+            handleWorkStealingException("parallel sort failed", task, phase, pState, IGNORE, IGNORE, IGNORE, th);
+        }
+    }
+
     private long o3ScheduleMoveUncommitted0(int timestampIndex, long transientRowsAdded, long committedTransientRowCount) {
         if (transientRowsAdded > 0) {
             final Sequence pubSeq = this.messageBus.getO3CallbackPubSeq();
@@ -5433,9 +5591,14 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         o3DoneLatch.reset();
         o3ErrorCount.set(0);
         int queuedCount = 0;
+        // Large var columns are sorted in two passes. The first pass computes offsets of the sorted values,
+        // and the values are then copied in disjoint row ranges by several tasks.
+        final int varColumnTaskCount = (int) Math.min(O3_SORT_VAR_COLUMN_MAX_TASKS, rowCount / O3_SORT_VAR_COLUMN_TASK_ROWS);
+        final O3ColumnUpdateMethod sortVarColumnRef = varColumnTaskCount > 1 ? o3SortVarColumnOffsetsRef : o3SortVarColumnRef;
         for (int i = 0; i < columnCount; i++) {
             final int type = metadata.getColumnType(i);
             if (timestampIndex != i && type > 0) {
+                final O3ColumnUpdateMethod sortColumnRef = ColumnType.isVariableLength(type) ? sortVarColumnRef : o3SortFixColumnRef;
                 long cursor = pubSeq.next();
                 if (cursor > -1) {
                     try {
@@ -5449,28 +5612,23 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
                                 rowCount,
                                 IGNORE,
                                 IGNORE,
-                                ColumnType.isVariableLength(type) ? o3SortVarColumnRef : o3SortFixColumnRef
+                                sortColumnRef
                         );
                     } finally {
                         queuedCount++;
                         pubSeq.done(cursor);
                     }
                 } else {
-                    o3SortColumn(mergedTimestamps, mergeCount, i, type, rowCount);
+                    sortColumnRef.run(i, type, mergedTimestamps, mergeCount, rowCount, IGNORE, IGNORE);
                 }
             }
         }
 
         dispatchO3CallbackQueue(queue, queuedCount);
-        swapO3ColumnsExcept(timestampIndex);
-    }
-
-    private void o3SortColumn(long mergedTimestamps, long mergeCount, int i, int type, long rowCount) {
-        if (ColumnType.isVariableLength(type)) {
-            o3SortVarColumn(i, type, mergedTimestamps, mergeCount, rowCount, IGNORE, IGNORE);
-        } else {
-            o3SortFixColumn(i, type, mergedTimestamps, mergeCount, rowCount, IGNORE, IGNORE);
+        if (varColumnTaskCount > 1) {
+            o3SortVarColumnsData(mergedTimestamps, timestampIndex, mergeCount, rowCount, varColumnTaskCount);
         }
+        swapO3ColumnsExcept(timestampIndex);
     }
 
     private void o3SortFixColumn(
@@ -5569,6 +5727,112 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         }
     }
 
+    private void o3SortVarColumnData(
+            int columnIndex,
+            int columnType,
+            long mergedTimestampsAddr,
+            long mergeCount,
+            long valueCount,
+            long rowLo,
+            long rowHi
+    ) {
+        if (o3ErrorCount.get() > 0) {
+            return;
+        }
+        try {
+            final int primaryIndex = getPrimaryColumnIndex(columnIndex);
+            final int secondaryIndex = primaryIndex + 1;
+            Vect.sortVarColumnData(
+                    mergedTimestampsAddr,
+                    rowLo,
+                    rowHi,
+                    o3Columns.getQuick(primaryIndex).addressOf(0),
+                    o3Columns.getQuick(secondaryIndex).addressOf(0),
+                    o3MemColumns2.getQuick(primaryIndex).addressOf(0),
+                    o3MemColumns2.getQuick(secondaryIndex).addressOf(0)
+            );
+        } catch (Throwable th) {
+            handleWorkStealingException("sort variable size column failed", columnIndex, columnType, mergedTimestampsAddr, valueCount, rowLo, rowHi, th);
+        }
+    }
+
+    private void o3SortVarColumnOffsets(
+            int columnIndex,
+            int columnType,
+            long mergedTimestampsAddr,
+            long mergeCount,
+            long valueCount,
+            long ignore1,
+            long ignore2
+    ) {
+        if (o3ErrorCount.get() > 0) {
+            return;
+        }
+        try {
+            final int primaryIndex = getPrimaryColumnIndex(columnIndex);
+            final int secondaryIndex = primaryIndex + 1;
+            final MemoryCR dataMem = o3Columns.getQuick(primaryIndex);
+            final MemoryCR indexMem = o3Columns.getQuick(secondaryIndex);
+            final MemoryCARW dataMem2 = o3MemColumns2.getQuick(primaryIndex);
+            final MemoryCARW indexMem2 = o3MemColumns2.getQuick(secondaryIndex);
+            final long srcIndxAddr = indexMem.addressOf(0);
+            dataMem2.resize(dataMem.size());
+            final long tgtIndxAddr = indexMem2.resize(valueCount * Long.BYTES);
+
+            assert srcIndxAddr != 0;
+            assert tgtIndxAddr != 0;
+
+            final long offset = Vect.sortVarColumnOffsets(mergedTimestampsAddr, valueCount, srcIndxAddr, tgtIndxAddr);
+            dataMem2.jumpTo(offset);
+            indexMem2.jumpTo(valueCount * Long.BYTES);
+            indexMem2.putLong(offset);
+        } catch (Throwable th) {
+            handleWorkStealingException("sort variable size column failed", columnIndex, columnType, mergedTimestampsAddr, valueCount, ignore1, ignore2, th);
+        }
+    }
+
+    private void o3SortVarColumnsData(long mergedTimestamps, int timestampIndex, long mergeCount, long rowCount, int taskCount) {
+        final Sequence pubSeq = this.messageBus.getO3CallbackPubSeq();
+        final RingQueue<O3CallbackTask> queue = this.messageBus.getO3CallbackQueue();
+
+        o3DoneLatch.reset();
+        int queuedCount = 0;
+        final long taskRows = (rowCount + taskCount - 1) / taskCount;
+        for (int i = 0; i < columnCount; i++) {
+            final int type = metadata.getColumnType(i);
+            if (timestampIndex != i && type > 0 && ColumnType.isVariableLength(type)) {
+                for (int t = 0; t < taskCount; t++) {
+                    final long rowLo = t * taskRows;
+                    final long rowHi = Math.min(rowCount, rowLo + taskRows);
+                    long cursor = pubSeq.next();
+                    if (cursor > -1) {
+                        try {
+                            final O3CallbackTask task = queue.get(cursor);
+                            task.of(
+                                    o3DoneLatch,
+                                    i,
+                                    type,
+                                    mergedTimestamps,
+                                    mergeCount,
+                                    rowCount,
+                                    rowLo,
+                                    rowHi,
+                                    o3SortVarColumnDataRef
+                            );
+                        } finally {
+                            queuedCount++;
+                            pubSeq.done(cursor);
+                        }
+                    } else {
+                        o3SortVarColumnData(i, type, mergedTimestamps, mergeCount, rowCount, rowLo, rowHi);
+                    }
+                }
+            }
+        }
+
+        dispatchO3CallbackQueue(queue, queuedCount);
+    }
+
     private void o3TimestampSetter(long timestamp) {
         o3TimestampMem.putLong128(timestamp, getO3RowCount0());
         o3CommitBatchTimestampMin = Math.min(o3CommitBatchTimestampMin, timestamp);
@@ -6577,6 +6841,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
             removeFileOrLog(ff, iFile(path.trimTo(plen), columnName, columnNameTxn));
             removeFileOrLog(ff, keyFileName(path.trimTo(plen), columnName, columnNameTxn));
             removeFileOrLog(ff, valueFileName(path.trimTo(plen), columnName, columnNameTxn));
+            removeFileOrLog(ff, ZoneMapUtils.zoneMapFile(path.trimTo(plen), columnName, columnNameTxn));
             path.trimTo(rootLen);
         } else {
             LOG.critical()
@@ -7326,6 +7591,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
                     }
 
                     txWriter.updatePartitionSizeByTimestamp(targetPartition, targetFrame.getSize());
+                    markZoneMapPartition(targetPartition);
                     if (lastPartitionSquashed) {
                         // last partition is squashed, adjust fixed/transient row sizes
                         long newTransientRowCount = targetFrame.getSize() - txWriter.getLagRowCount();
@@ -7396,6 +7662,7 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         // added so far. Index writers will start point to different
         // files after switch.
         updateIndexes();
+        markZoneMapPartition(txWriter.getLastPartitionTimestamp());
         txWriter.switchPartitions(timestamp);
         openPartition(timestamp);
         setAppendPosition(0, false);
@@ -7482,19 +7749,30 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         }
         this.minSplitPartitionTimestamp = Long.MAX_VALUE;
         processPartitionRemoveCandidates();
+        if (zoneMapWriter != null) {
+            zoneMapWriter.clear();
+        }
 
         LOG.info().$("truncated [name=").utf8(tableToken.getTableName()).I$();
     }
 
     private void truncateColumns() {
+        final long partitionTimestamp = txWriter.getLastPartitionTimestamp();
         for (int i = 0; i < columnCount; i++) {
-            if (metadata.getColumnType(i) >= 0) {
+            final int columnType = metadata.getColumnType(i);
+            if (columnType >= 0) {
                 getPrimaryColumn(i).truncate();
                 MemoryMA mem = getSecondaryColumn(i);
                 if (mem != null && mem.isOpen()) {
                     mem.truncate();
                     mem.putLong(0);
                 }
+                if (ZoneMapUtils.isSupported(columnType)) {
+                    // zone map entries describe the removed rows
+                    setPathForPartition(path.trimTo(rootLen), partitionBy, partitionTimestamp, -1L);
+                    removeFileOrLog(ff, ZoneMapUtils.zoneMapFile(path, metadata.getColumnName(i), columnVersionWriter.getColumnNameTxn(partitionTimestamp, i)));
+                    path.trimTo(rootLen);
+                }
             }
         }
     }
@@ -7711,6 +7989,95 @@ public class TableWriter implements TableWriterAPI, MetadataService, Closeable {
         }
     }
 
+    private void updateZoneMaps() {
+        if (zoneMapWriter == null) {
+            return;
+        }
+        try {
+            final long lastPartitionTimestamp = txWriter.getLastPartitionTimestamp();
+            zoneMapPartitions.add(lastPartitionTimestamp);
+            zoneMapPartitions.sort();
+            final boolean partitioned = PartitionBy.isPartitioned(partitionBy);
+            for (int i = 0, n = zoneMapPartitions.size(); i < n; i++) {
+                final long partitionTimestamp = zoneMapPartitions.getQuick(i);
+                if (i > 0 && partitionTimestamp == zoneMapPartitions.getQuick(i - 1)) {
+                    continue;
+                }
+
+                final long partitionNameTxn;
+                final long partitionRowCount;
+                if (partitioned) {
+                    // partitions could have been squashed or dropped since they were written to
+                    final int partitionIndex = txWriter.getPartitionIndex(partitionTimestamp);
+                    if (partitionIndex < 0 || txWriter.getPartitionTimestampByIndex(partitionIndex) != partitionTimestamp
+                            || txWriter.isPartitionReadOnly(partitionIndex)) {
+                        continue;
+                    }
+                    partitionNameTxn = txWriter.getPartitionNameTxn(partitionIndex);
+                    partitionRowCount = partitionTimestamp == lastPartitionTimestamp
+                            ? txWriter.getTransientRowCount()
+                            : txWriter.getPartitionSize(partitionIndex);
+                } else {
+                    partitionNameTxn = -1L;
+                    partitionRowCount = txWriter.getTransientRowCount();
+                }
+
+                setPathForPartition(path.trimTo(rootLen), partitionBy, partitionTimestamp, partitionNameTxn);
+                for (int columnIndex = 0; columnIndex < columnCount; columnIndex++) {
+                    final int columnType = metadata.getColumnType(columnIndex);
+                    if (columnType > 0 && ZoneMapUtils.isSupported(columnType)) {
+                        final long columnTop = columnVersionWriter.getColumnTop(partitionTimestamp, columnIndex);
+                        if (columnTop > -1L) {
+                            long dataAddress = 0;
+                            long dataOffset = 0;
+                            long dataSize = 0;
+                            if (partitionTimestamp == lastPartitionTimestamp) {
+                                // the column page the rows were appended to is still mapped
+                                final MemoryMA mem = getPrimaryColumn(columnIndex);
+                                final long appendOffset = mem.getAppendOffset();
+                                if (appendOffset > 0 && mem instanceof MemoryMAR) {
+                                    final MemoryMAR mar = (MemoryMAR) mem;
+                                    dataOffset = (appendOffset - 1) - mar.offsetInPage(appendOffset - 1);
+                                    dataAddress = mar.getPageAddress(mar.pageIndex(appendOffset - 1));
+                                    dataSize = appendOffset - dataOffset;
+                                }
+                            }
+                            try {
+                                zoneMapWriter.update(
+                                        path,
+                                        partitionTimestamp,
+                                        partitionNameTxn,
+                                        metadata.getColumnName(columnIndex),
+                                        columnIndex,
+                                        columnVersionWriter.getColumnNameTxn(partitionTimestamp, columnIndex),
+                                        columnType,
+                                        columnTop,
+                                        partitionRowCount,
+                                        dataAddress,
+                                        dataOffset,
+                                        dataSize
+                                );
+                            } catch (CairoException e) {
+                                // zone maps only let queries skip data, the commit stands and the column is
+                                // scanned in full until its map is written again; maps of the other columns
+                                // and partitions are still brought up to date, e.g. cut down after a split
+                                LOG.error().$("could not update zone map [table=").utf8(tableToken.getTableName())
+                                        .$(", column=").utf8(metadata.getColumnName(columnIndex))
+                                        .$(", partition=").$ts(partitionTimestamp)
+                                        .$(", msg=").$(e.getFlyweightMessage())
+                                        .$(", errno=").$(e.getErrno())
+                                        .I$();
+                            }
+                        }
+                    }
+                }
+            }
+        } finally {
+            zoneMapPartitions.clear();
+            path.trimTo(rootLen);
+        }
+    }
+
     private void validateSwapMeta(CharSequence columnName) {
         try {
             try {
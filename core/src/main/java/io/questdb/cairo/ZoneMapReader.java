@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+
+package io.questdb.cairo;
+
+import io.questdb.cairo.vm.MemoryCMRImpl;
+import io.questdb.std.FilesFacade;
+import io.questdb.std.MemoryTag;
+import io.questdb.std.Misc;
+import io.questdb.std.str.Path;
+
+import java.io.Closeable;
+
+import static io.questdb.cairo.ZoneMapUtils.*;
+
+/**
+ * Read-only view of the zone map of a column in a partition, see {@link ZoneMapUtils}. Block numbers
+ * count rows of the column file, i.e. partition rows minus the column top.
+ */
+public class ZoneMapReader implements Closeable {
+    private final MemoryCMRImpl mem = new MemoryCMRImpl();
+    private long blockCount;
+    private int blockRowsShift;
+    private long columnNameTxn;
+    private long columnRowCount;
+    private long columnTop;
+    private long partitionNameTxn;
+    private long partitionTimestamp;
+    private long truncateVersion;
+
+    @Override
+    public void close() {
+        Misc.free(mem);
+        blockCount = 0;
+    }
+
+    public long getBlockCount() {
+        return blockCount;
+    }
+
+    public int getBlockRowsShift() {
+        return blockRowsShift;
+    }
+
+    public long getColumnTop() {
+        return columnTop;
+    }
+
+    public long getCount(long block) {
+        return mem.getLong(getEntryOffset(block) + ENTRY_COUNT_OFFSET);
+    }
+
+    public double getMaxDouble(long block) {
+        return mem.getDouble(getEntryOffset(block) + ENTRY_MAX_OFFSET);
+    }
+
+    public long getMaxLong(long block) {
+        return mem.getLong(getEntryOffset(block) + ENTRY_MAX_OFFSET);
+    }
+
+    public double getMinDouble(long block) {
+        return mem.getDouble(getEntryOffset(block) + ENTRY_MIN_OFFSET);
+    }
+
+    public long getMinLong(long block) {
+        return mem.getLong(getEntryOffset(block) + ENTRY_MIN_OFFSET);
+    }
+
+    /**
+     * @param block block number
+     * @return address of the block entry, the layout matches column stats of vector aggregate functions
+     */
+    public long getEntryAddress(long block) {
+        return mem.addressOf(getEntryOffset(block));
+    }
+
+    public boolean isOpenFor(long partitionTimestamp, long partitionNameTxn, long columnNameTxn, long columnTop, long columnRowCount, long truncateVersion) {
+        return this.partitionTimestamp == partitionTimestamp
+                && this.partitionNameTxn == partitionNameTxn
+                && this.columnNameTxn == columnNameTxn
+                && this.columnTop == columnTop
+                && this.columnRowCount == columnRowCount
+                && this.truncateVersion == truncateVersion;
+    }
+
+    /**
+     * Maps the zone map file of the column. Missing files and files of another block size or column type
+     * leave the reader with no blocks.
+     *
+     * @param path partition path, it is restored before the method returns
+     */
+    public void of(
+            FilesFacade ff,
+            Path path,
+            long partitionTimestamp,
+            long partitionNameTxn,
+            CharSequence columnName,
+            long columnNameTxn,
+            int columnType,
+            long columnTop,
+            long columnRowCount,
+            long truncateVersion,
+            int blockRowsShift
+    ) {
+        close();
+        this.partitionTimestamp = partitionTimestamp;
+        this.partitionNameTxn = partitionNameTxn;
+        this.columnNameTxn = columnNameTxn;
+        this.columnTop = columnTop;
+        this.columnRowCount = columnRowCount;
+        this.truncateVersion = truncateVersion;
+        this.blockRowsShift = blockRowsShift;
+
+        final long maxBlockCount = columnRowCount >> blockRowsShift;
+        if (maxBlockCount < 1) {
+            return;
+        }
+        final int plen = path.size();
+        try {
+            if (ff.exists(zoneMapFile(path, columnName, columnNameTxn))) {
+                mem.of(ff, path, ff.getPageSize(), -1, MemoryTag.MMAP_TABLE_READER, CairoConfiguration.O_NONE, -1);
+                if (mem.size() >= HEADER_SIZE
+                        && mem.getInt(HEADER_BLOCK_ROWS_SHIFT_OFFSET) == blockRowsShift
+                        && mem.getInt(HEADER_COLUMN_TYPE_OFFSET) == columnType) {
+                    final long count = Math.min(mem.getLong(HEADER_BLOCK_COUNT_OFFSET), (mem.size() - HEADER_SIZE) / ENTRY_SIZE);
+                    blockCount = Math.max(0, Math.min(count, maxBlockCount));
+                }
+                if (blockCount == 0) {
+                    Misc.free(mem);
+                }
+            }
+        } finally {
+            path.trimTo(plen);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+
+package io.questdb.cairo;
+
+import io.questdb.std.str.LPSZ;
+import io.questdb.std.str.Path;
+
+import static io.questdb.cairo.TableUtils.COLUMN_NAME_TXN_NONE;
+
+/**
+ * Zone map of a fixed-size column file, the ".zm" file next to the ".d" file. Each complete block of
+ * 1 &lt;&lt; blockRowsShift column values has an entry with count, null count, sum, min and max of the block,
+ * the layout of an entry is the layout of column_stats_t in native code. Rows of the column top are not
+ * part of the column file, so blocks are counted from the first row of the column file.
+ * <p>
+ * The header holds the number of committed entries, the block rows shift and the column type. Entries are
+ * appended by the table writer and are never changed once written, the entry count is updated last.
+ * A file that no longer matches the column file, e.g. after a partition split, is removed and written
+ * anew, so readers that mapped it keep consistent entries.
+ */
+public final class ZoneMapUtils {
+    public static final long ENTRY_COUNT_OFFSET = 0;
+    public static final long ENTRY_MAX_OFFSET = 32;
+    public static final long ENTRY_MIN_OFFSET = 24;
+    public static final long ENTRY_NULL_COUNT_OFFSET = 8;
+    public static final long ENTRY_SIZE = 40;
+    public static final long ENTRY_SUM_OFFSET = 16;
+    public static final String FILE_SUFFIX_ZM = ".zm";
+    public static final long HEADER_BLOCK_COUNT_OFFSET = 0;
+    public static final long HEADER_BLOCK_ROWS_SHIFT_OFFSET = 8;
+    public static final long HEADER_COLUMN_TYPE_OFFSET = 12;
+    public static final long HEADER_SIZE = 64;
+
+    private ZoneMapUtils() {
+    }
+
+    public static long getEntryOffset(long block) {
+        return HEADER_SIZE + block * ENTRY_SIZE;
+    }
+
+    public static boolean isSupported(int columnType) {
+        switch (ColumnType.tagOf(columnType)) {
+            case ColumnType.INT:
+            case ColumnType.LONG:
+            case ColumnType.DATE:
+            case ColumnType.TIMESTAMP:
+            case ColumnType.DOUBLE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    public static LPSZ zoneMapFile(Path path, CharSequence columnName, long columnNameTxn) {
+        path.concat(columnName).put(FILE_SUFFIX_ZM);
+        if (columnNameTxn > COLUMN_NAME_TXN_NONE) {
+            path.put('.').put(columnNameTxn);
+        }
+        return path.$();
+    }
+}
@@ -0,0 +1,313 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+
+package io.questdb.cairo;
+
+import io.questdb.log.Log;
+import io.questdb.log.LogFactory;
+import io.questdb.std.*;
+import io.questdb.std.str.Path;
+
+import java.io.Closeable;
+
+import static io.questdb.cairo.ZoneMapUtils.*;
+
+/**
+ * Appends zone map entries of the column blocks completed since the last update. Block counts of the
+ * columns of the most recently updated partition are cached, so commits that do not complete a block
+ * don't touch the file system. Entries are computed from the column data the caller still has in memory,
+ * the column file is mapped only for the blocks that are not.
+ * <p>
+ * Written entries are never changed. When the partition lost rows to a split, or the file was written
+ * with another block size or column type, the file is removed and written anew. A failed update removes
+ * the file too.
+ */
+public class ZoneMapWriter implements Closeable, Mutable {
+    private static final Log LOG = LogFactory.getLog(ZoneMapWriter.class);
+    // entries computed per write
+    private static final int SCRATCH_ENTRIES = 256;
+    private static final long SCRATCH_SIZE = SCRATCH_ENTRIES * ENTRY_SIZE;
+    private final int blockRowsShift;
+    // column name txn and block count pairs of the cached partition
+    private final LongList cachedBlockCounts = new LongList();
+    private final FilesFacade ff;
+    private final long fileOpenOpts;
+    private long cachedPartitionNameTxn;
+    private long cachedPartitionTimestamp = Long.MIN_VALUE;
+    private long scratch;
+
+    public ZoneMapWriter(CairoConfiguration configuration) {
+        assert configuration.getZoneMapBlockRows() > 0;
+        this.ff = configuration.getFilesFacade();
+        this.fileOpenOpts = configuration.getWriterFileOpenOpts();
+        this.blockRowsShift = Numbers.msb(configuration.getZoneMapBlockRows());
+        this.scratch = Unsafe.malloc(SCRATCH_SIZE, MemoryTag.NATIVE_TABLE_WRITER);
+    }
+
+    /**
+     * Writes zone map of a column file that an O3 copy job has written anew, while the file is still mapped.
+     * The commit then finds the map up to date and does not read the column file back.
+     *
+     * @param ff             files facade
+     * @param fd             zone map file descriptor, it is left open
+     * @param blockRowsShift block rows shift
+     * @param columnType     column type, must be supported by zone maps
+     * @param dataAddress    address of the first row of the column file
+     * @param dataSize       size of the column file data
+     */
+    public static void updateO3(FilesFacade ff, int fd, int blockRowsShift, int columnType, long dataAddress, long dataSize) {
+        final long blockCount = dataSize >> (blockRowsShift + ColumnType.pow2SizeOf(columnType));
+        if (blockCount < 1) {
+            return;
+        }
+
+        // the partition directory is not visible to readers yet, the file is written from the first block
+        if (!ff.truncate(fd, 0)) {
+            throw CairoException.critical(ff.errno()).put("could not truncate zone map [fd=").put(fd).put(']');
+        }
+        final long scratch = Unsafe.malloc(SCRATCH_SIZE, MemoryTag.NATIVE_O3);
+        try {
+            writeHeader(ff, fd, scratch, blockRowsShift, columnType);
+            writeEntries(ff, fd, scratch, blockRowsShift, columnType, dataAddress, 0, blockCount);
+            writeBlockCount(ff, fd, scratch, blockCount);
+        } catch (CairoException e) {
+            // the commit finds an empty map and writes it from the column file
+            ff.truncate(fd, 0);
+            throw e;
+        } finally {
+            Unsafe.free(scratch, SCRATCH_SIZE, MemoryTag.NATIVE_O3);
+        }
+    }
+
+    @Override
+    public void clear() {
+        cachedPartitionTimestamp = Long.MIN_VALUE;
+        cachedBlockCounts.clear();
+    }
+
+    @Override
+    public void close() {
+        clear();
+        if (scratch != 0) {
+            Unsafe.free(scratch, SCRATCH_SIZE, MemoryTag.NATIVE_TABLE_WRITER);
+            scratch = 0;
+        }
+    }
+
+    /**
+     * Brings zone map of the column up to date with the committed rows of the partition.
+     *
+     * @param path               partition path, it is restored before the method returns
+     * @param partitionTimestamp partition timestamp
+     * @param partitionNameTxn   partition name txn
+     * @param columnName         column name
+     * @param columnIndex        writer index of the column
+     * @param columnNameTxn      column name txn
+     * @param columnType         column type, must be supported by zone maps
+     * @param columnTop          column top in the partition
+     * @param partitionRowCount  committed row count of the partition
+     * @param dataAddress        address of column file data held in memory, 0 when there is none
+     * @param dataOffset         column file offset of the data at dataAddress
+     * @param dataSize           size of the data at dataAddress
+     */
+    public void update(
+            Path path,
+            long partitionTimestamp,
+            long partitionNameTxn,
+            CharSequence columnName,
+            int columnIndex,
+            long columnNameTxn,
+            int columnType,
+            long columnTop,
+            long partitionRowCount,
+            long dataAddress,
+            long dataOffset,
+            long dataSize
+    ) {
+        assert isSupported(columnType);
+        final long blockCount = (partitionRowCount - columnTop) >> blockRowsShift;
+        if (blockCount < 1) {
+            return;
+        }
+
+        if (partitionTimestamp != cachedPartitionTimestamp || partitionNameTxn != cachedPartitionNameTxn) {
+            cachedBlockCounts.clear();
+            cachedPartitionTimestamp = partitionTimestamp;
+            cachedPartitionNameTxn = partitionNameTxn;
+        }
+        final int cacheIndex = 2 * columnIndex;
+        if (cacheIndex + 1 < cachedBlockCounts.size()
+                && cachedBlockCounts.getQuick(cacheIndex) == columnNameTxn
+                && cachedBlockCounts.getQuick(cacheIndex + 1) == blockCount) {
+            return;
+        }
+
+        final int plen = path.size();
+        int fd = -1;
+        int dataFd = -1;
+        try {
+            fd = TableUtils.openRW(ff, zoneMapFile(path, columnName, columnNameTxn), LOG, fileOpenOpts);
+            final long fileLen = ff.length(fd);
+            long fileBlockCount = -1;
+            if (fileLen >= HEADER_SIZE
+                    && ff.readNonNegativeInt(fd, HEADER_BLOCK_ROWS_SHIFT_OFFSET) == blockRowsShift
+                    && ff.readNonNegativeInt(fd, HEADER_COLUMN_TYPE_OFFSET) == columnType) {
+                fileBlockCount = ff.readNonNegativeLong(fd, HEADER_BLOCK_COUNT_OFFSET);
+                if (fileBlockCount > blockCount) {
+                    // partition tail was moved out by a split, readers that map the file
+                    // from now on must not see entries of the moved rows
+                    writeBlockCount(ff, fd, scratch, blockCount);
+                    fileBlockCount = -1;
+                } else if (fileBlockCount > -1 && getEntryOffset(fileBlockCount) != fileLen) {
+                    // entries past the count are left by a failed update
+                    fileBlockCount = -1;
+                }
+            }
+
+            if (fileBlockCount < 0) {
+                if (fileLen > 0) {
+                    // entries are never rewritten in place: readers that mapped the file keep
+                    // the old copy and new readers see the file written from the first block
+                    final boolean removed = ff.closeRemove(fd, zoneMapFile(path.trimTo(plen), columnName, columnNameTxn));
+                    fd = -1;
+                    if (!removed) {
+                        throw CairoException.critical(ff.errno()).put("could not remove zone map [path=").put(path).put(']');
+                    }
+                    fd = TableUtils.openRW(ff, zoneMapFile(path.trimTo(plen), columnName, columnNameTxn), LOG, fileOpenOpts);
+                }
+                writeHeader(ff, fd, scratch, blockRowsShift, columnType);
+                fileBlockCount = 0;
+            }
+
+            if (fileBlockCount < blockCount) {
+                final int blockSizeShift = blockRowsShift + ColumnType.pow2SizeOf(columnType);
+                // blocks held in memory by the caller are not read back from the column file
+                long memoryBlockLo = blockCount;
+                if (dataAddress != 0 && blockCount << blockSizeShift <= dataOffset + dataSize) {
+                    memoryBlockLo = Math.min(blockCount, Math.max(fileBlockCount, (dataOffset + (1L << blockSizeShift) - 1) >> blockSizeShift));
+                }
+
+                if (fileBlockCount < memoryBlockLo) {
+                    final long mapOffset = fileBlockCount << blockSizeShift;
+                    final long mapSize = (memoryBlockLo - fileBlockCount) << blockSizeShift;
+                    dataFd = TableUtils.openRO(ff, TableUtils.dFile(path.trimTo(plen), columnName, columnNameTxn), LOG);
+                    final long mapAddress = TableUtils.mapAppendColumnBuffer(ff, dataFd, mapOffset, mapSize, false, MemoryTag.MMAP_TABLE_WRITER);
+                    try {
+                        writeEntries(ff, fd, scratch, blockRowsShift, columnType, mapAddress, fileBlockCount, memoryBlockLo);
+                    } finally {
+                        TableUtils.mapAppendColumnBufferRelease(ff, mapAddress, mapOffset, mapSize, MemoryTag.MMAP_TABLE_WRITER);
+                    }
+                }
+                if (memoryBlockLo < blockCount) {
+                    writeEntries(ff, fd, scratch, blockRowsShift, columnType, dataAddress + (memoryBlockLo << blockSizeShift) - dataOffset, memoryBlockLo, blockCount);
+                }
+                // readers use entries up to the count, it is written after the entries
+                writeBlockCount(ff, fd, scratch, blockCount);
+            }
+
+            final int cacheSize = cachedBlockCounts.size();
+            if (cacheSize < cacheIndex + 2) {
+                cachedBlockCounts.setPos(cacheIndex + 2);
+                cachedBlockCounts.fill(cacheSize, cacheIndex + 2, -1);
+            }
+            cachedBlockCounts.setQuick(cacheIndex, columnNameTxn);
+            cachedBlockCounts.setQuick(cacheIndex + 1, blockCount);
+        } catch (CairoException e) {
+            if (fd > -1) {
+                // zero count hides the entries from readers that open the file later, even if it cannot be removed
+                Unsafe.getUnsafe().putLong(scratch, 0);
+                ff.write(fd, scratch, Long.BYTES, HEADER_BLOCK_COUNT_OFFSET);
+                ff.close(fd);
+                fd = -1;
+            }
+            invalidate(path.trimTo(plen), columnName, columnNameTxn, cacheIndex);
+            throw e;
+        } finally {
+            ff.close(fd);
+            ff.close(dataFd);
+            path.trimTo(plen);
+        }
+    }
+
+    private static void write(FilesFacade ff, int fd, long address, long len, long offset) {
+        if (ff.write(fd, address, len, offset) != len) {
+            throw CairoException.critical(ff.errno()).put("could not write zone map [fd=").put(fd).put(", offset=").put(offset).put(']');
+        }
+    }
+
+    private static void writeBlockCount(FilesFacade ff, int fd, long scratch, long blockCount) {
+        Unsafe.getUnsafe().putLong(scratch, blockCount);
+        write(ff, fd, scratch, Long.BYTES, HEADER_BLOCK_COUNT_OFFSET);
+    }
+
+    // writes entries of blocks [blockLo, blockHi), address points at the first row of blockLo
+    private static void writeEntries(
+            FilesFacade ff,
+            int fd,
+            long scratch,
+            int blockRowsShift,
+            int columnType,
+            long address,
+            long blockLo,
+            long blockHi
+    ) {
+        final int blockSizeShift = blockRowsShift + ColumnType.pow2SizeOf(columnType);
+        for (long block = blockLo; block < blockHi; block += SCRATCH_ENTRIES) {
+            final long n = Math.min(SCRATCH_ENTRIES, blockHi - block);
+            final long blockAddress = address + ((block - blockLo) << blockSizeShift);
+            switch (ColumnType.tagOf(columnType)) {
+                case ColumnType.INT:
+                    Vect.zoneMapInt(blockAddress, n, blockRowsShift, scratch);
+                    break;
+                case ColumnType.DOUBLE:
+                    Vect.zoneMapDouble(blockAddress, n, blockRowsShift, scratch);
+                    break;
+                default:
+                    Vect.zoneMapLong(blockAddress, n, blockRowsShift, scratch);
+                    break;
+            }
+            write(ff, fd, scratch, n * ENTRY_SIZE, getEntryOffset(block));
+        }
+    }
+
+    private static void writeHeader(FilesFacade ff, int fd, long scratch, int blockRowsShift, int columnType) {
+        Unsafe.getUnsafe().putLong(scratch + HEADER_BLOCK_COUNT_OFFSET, 0);
+        Unsafe.getUnsafe().putInt(scratch + HEADER_BLOCK_ROWS_SHIFT_OFFSET, blockRowsShift);
+        Unsafe.getUnsafe().putInt(scratch + HEADER_COLUMN_TYPE_OFFSET, columnType);
+        Vect.memset(scratch + HEADER_COLUMN_TYPE_OFFSET + Integer.BYTES, HEADER_SIZE - HEADER_COLUMN_TYPE_OFFSET - Integer.BYTES, 0);
+        write(ff, fd, scratch, HEADER_SIZE, 0);
+    }
+
+    // Entries of a failed update may describe rows the column file no longer has, e.g. when the
+    // partition was split, so the map is removed and the next update writes it from the first block.
+    private void invalidate(Path path, CharSequence columnName, long columnNameTxn, int cacheIndex) {
+        if (cacheIndex + 1 < cachedBlockCounts.size()) {
+            cachedBlockCounts.setQuick(cacheIndex + 1, -1);
+        }
+        if (!ff.removeQuiet(zoneMapFile(path, columnName, columnNameTxn))) {
+            LOG.critical().$("could not remove zone map [path=").$(path).$(", errno=").$(ff.errno()).I$();
+        }
+    }
+}
@@ -25,6 +25,8 @@
 package io.questdb.cairo.sql;
 
 import io.questdb.cairo.BitmapIndexReader;
+import io.questdb.cairo.ZoneMapReader;
+import org.jetbrains.annotations.Nullable;
 
 public interface PageFrame {
 
@@ -68,4 +70,14 @@ public interface PageFrame {
     int getPartitionIndex();
 
     long getPartitionLo();
+
+    /**
+     * Zone map of the column in the partition of the page frame. Blocks of the zone map are counted
+     * from the first row of the column file, see {@link ZoneMapReader#getColumnTop()}.
+     *
+     * @param columnIndex index of column
+     * @return zone map or null if the column has none
+     */
+    @Nullable
+    ZoneMapReader getZoneMap(int columnIndex);
 }
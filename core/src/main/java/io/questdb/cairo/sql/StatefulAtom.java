@@ -58,4 +58,16 @@ public interface StatefulAtom extends QuietCloseable, Mutable {
      */
     default void initCursor() {
     }
+
+    /**
+     * Checks whether the given page frame can be skipped without dispatching it
+     * to the workers, e.g. when the frame's zone maps prove that no row matches.
+     * Called on the query owner thread while the frame sequence is being built.
+     *
+     * @param frame page frame to check
+     * @return true if none of the frame rows may match the atom's condition
+     */
+    default boolean skipFrame(PageFrame frame) {
+        return false;
+    }
 }
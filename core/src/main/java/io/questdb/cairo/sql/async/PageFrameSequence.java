@@ -413,6 +413,9 @@ public class PageFrameSequence<T extends StatefulAtom> implements Closeable {
     private void buildAddressCache() {
         PageFrame frame;
         while ((frame = pageFrameCursor.next()) != null) {
+            if (atom.skipFrame(frame)) {
+                continue;
+            }
             pageAddressCache.add(frameCount++, frame);
             frameRowCounts.add(frame.getPartitionHi() - frame.getPartitionLo());
         }
@@ -76,6 +76,14 @@ import static io.questdb.griffin.model.QueryModel.*;
 
 public class SqlCodeGenerator implements Mutable, Closeable {
     public static final int GKK_HOUR_INT = 1;
+    // two INT or SYMBOL keys packed into a LONG, first key in the high half
+    public static final int GKK_INT_PAIR = 5;
+    // single LONG, DATE or TIMESTAMP key
+    public static final int GKK_LONG = 3;
+    // single UUID key, rosti slots keep lo and hi of the key
+    public static final int GKK_LONG128 = 4;
+    // single STRING key, rosti slots keep hash and length of the key, chars are in the key heap of the map
+    public static final int GKK_STR = 2;
     public static final int GKK_VANILLA_INT = 0;
     private static final VectorAggregateFunctionConstructor COUNT_CONSTRUCTOR = (keyKind, columnIndex, workerCount) -> new CountVectorAggregateFunction(keyKind);
     private static final FullFatJoinGenerator CREATE_FULL_FAT_AS_OF_JOIN = SqlCodeGenerator::createFullFatAsOfJoin;
@@ -96,7 +104,11 @@ public class SqlCodeGenerator implements Mutable, Closeable {
     private static final IntObjHashMap<VectorAggregateFunctionConstructor> maxConstructors = new IntObjHashMap<>();
     private static final IntObjHashMap<VectorAggregateFunctionConstructor> minConstructors = new IntObjHashMap<>();
     private static final IntObjHashMap<VectorAggregateFunctionConstructor> nsumConstructors = new IntObjHashMap<>();
+    private static final IntObjHashMap<VectorAggregateFunctionConstructor> stdDevPopConstructors = new IntObjHashMap<>();
+    private static final IntObjHashMap<VectorAggregateFunctionConstructor> stdDevSampConstructors = new IntObjHashMap<>();
     private static final IntObjHashMap<VectorAggregateFunctionConstructor> sumConstructors = new IntObjHashMap<>();
+    private static final IntObjHashMap<VectorAggregateFunctionConstructor> varPopConstructors = new IntObjHashMap<>();
+    private static final IntObjHashMap<VectorAggregateFunctionConstructor> varSampConstructors = new IntObjHashMap<>();
     private final ArrayColumnTypes arrayColumnTypes = new ArrayColumnTypes();
     private final BytecodeAssembler asm = new BytecodeAssembler();
     private final CairoConfiguration configuration;
@@ -317,6 +329,18 @@ public class SqlCodeGenerator implements Mutable, Closeable {
         return model.getOrderByDirectionAdvice().getQuick(index);
     }
 
+    private static boolean isLongKeyType(int type) {
+        switch (ColumnType.tagOf(type)) {
+            case ColumnType.LONG:
+            case ColumnType.DATE:
+            case ColumnType.TIMESTAMP:
+            case ColumnType.UUID:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     private static boolean isSingleColumnFunction(ExpressionNode ast, CharSequence name) {
         return ast.type == FUNCTION && ast.paramCount == 1 && Chars.equalsIgnoreCase(ast.token, name) && ast.rhs.type == LITERAL;
     }
@@ -356,6 +380,22 @@ public class SqlCodeGenerator implements Mutable, Closeable {
             columnIndex = metadata.getColumnIndex(ast.rhs.token);
             tempVecConstructorArgIndexes.add(columnIndex);
             return maxConstructors.get(metadata.getColumnType(columnIndex));
+        } else if (isSingleColumnFunction(ast, "var_pop")) {
+            columnIndex = metadata.getColumnIndex(ast.rhs.token);
+            tempVecConstructorArgIndexes.add(columnIndex);
+            return varPopConstructors.get(metadata.getColumnType(columnIndex));
+        } else if (isSingleColumnFunction(ast, "var_samp") || isSingleColumnFunction(ast, "variance")) {
+            columnIndex = metadata.getColumnIndex(ast.rhs.token);
+            tempVecConstructorArgIndexes.add(columnIndex);
+            return varSampConstructors.get(metadata.getColumnType(columnIndex));
+        } else if (isSingleColumnFunction(ast, "stddev_pop")) {
+            columnIndex = metadata.getColumnIndex(ast.rhs.token);
+            tempVecConstructorArgIndexes.add(columnIndex);
+            return stdDevPopConstructors.get(metadata.getColumnType(columnIndex));
+        } else if (isSingleColumnFunction(ast, "stddev_samp") || isSingleColumnFunction(ast, "stddev")) {
+            columnIndex = metadata.getColumnIndex(ast.rhs.token);
+            tempVecConstructorArgIndexes.add(columnIndex);
+            return stdDevSampConstructors.get(metadata.getColumnType(columnIndex));
         }
         return null;
     }
@@ -390,6 +430,16 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                         tempSymbolSkewIndexes.extendAndSet(i, columnIndex);
                         arrayColumnTypes.add(ColumnType.SYMBOL);
                         tempKeyKinds.add(GKK_VANILLA_INT);
+                    } else if (isLongKeyType(type) && configuration.isGroupByLongKeysEnabled()) {
+                        tempKeyIndexesInBase.add(columnIndex);
+                        tempKeyIndex.add(i);
+                        arrayColumnTypes.add(ColumnType.tagOf(type));
+                        tempKeyKinds.add(ColumnType.tagOf(type) == ColumnType.UUID ? GKK_LONG128 : GKK_LONG);
+                    } else if (ColumnType.isString(type) && configuration.isGroupByStrKeysEnabled()) {
+                        tempKeyIndexesInBase.add(columnIndex);
+                        tempKeyIndex.add(i);
+                        arrayColumnTypes.add(ColumnType.STRING);
+                        tempKeyKinds.add(GKK_STR);
                     } else {
                         return false;
                     }
@@ -1507,7 +1557,8 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                             limitLoFunction,
                             limitLoPos,
                             preTouchColumns,
-                            executionContext.getSharedWorkerCount()
+                            executionContext.getSharedWorkerCount(),
+                            ZoneMapFilter.of(filterExpr, factory.getMetadata())
                     );
                 } catch (SqlException | LimitOverflowException ex) {
                     Misc.free(compiledFilter);
@@ -1547,7 +1598,8 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                     limitLoFunction,
                     limitLoPos,
                     preTouchColumns,
-                    executionContext.getSharedWorkerCount()
+                    executionContext.getSharedWorkerCount(),
+                    ZoneMapFilter.of(filterExpr, factory.getMetadata())
             );
         }
         return new FilteredRecordCursorFactory(factory, filter);
@@ -1912,7 +1964,8 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                                 null,
                                 0,
                                 false,
-                                executionContext.getSharedWorkerCount()
+                                executionContext.getSharedWorkerCount(),
+                                null
                         );
                     } else {
                         master = new FilteredRecordCursorFactory(
@@ -1963,7 +2016,8 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                                 null,
                                 0,
                                 false,
-                                executionContext.getSharedWorkerCount()
+                                executionContext.getSharedWorkerCount(),
+                                null
                         );
                     } else {
                         master = new FilteredRecordCursorFactory(master, filter);
@@ -2772,6 +2826,20 @@ public class SqlCodeGenerator implements Mutable, Closeable {
             if (isFillNone) {
                 if (keyTypes.getColumnCount() == 0) {
                     // this sample by is not keyed
+                    if (SampleByFillNoneNotKeyedVectorRecordCursorFactory.isSupported(factory, timestampSampler, timezoneNameFunc, groupByFunctions)) {
+                        return new SampleByFillNoneNotKeyedVectorRecordCursorFactory(
+                                factory,
+                                timestampSampler,
+                                groupByMetadata,
+                                groupByFunctions,
+                                recordFunctions,
+                                valueTypes.getColumnCount(),
+                                timestampIndex,
+                                timezoneNameFunc,
+                                offsetFunc,
+                                offsetFuncPos
+                        );
+                    }
                     return new SampleByFillNoneNotKeyedRecordCursorFactory(
                             asm,
                             configuration,
@@ -3298,13 +3366,20 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                     }
                 }
 
+                // Pair of INT or SYMBOL keys is aggregated as a single LONG key.
+                final boolean isIntPairKey = tempKeyKinds.size() == 2
+                        && tempKeyKinds.getQuick(0) == GKK_VANILLA_INT
+                        && tempKeyKinds.getQuick(1) == GKK_VANILLA_INT
+                        && configuration.isGroupByLongKeysEnabled();
+                final int keyKind = isIntPairKey ? GKK_INT_PAIR : (tempKeyKinds.size() == 0 ? 0 : tempKeyKinds.getQuick(0));
+
                 // Add the aggregate functions.
                 for (int i = 0, n = tempVecConstructors.size(); i < n; i++) {
                     VectorAggregateFunctionConstructor constructor = tempVecConstructors.getQuick(i);
                     int indexInBase = tempVecConstructorArgIndexes.getQuick(i);
                     int indexInThis = tempAggIndex.getQuick(i);
                     VectorAggregateFunction vaf = constructor.create(
-                            tempKeyKinds.size() == 0 ? 0 : tempKeyKinds.getQuick(0),
+                            keyKind,
                             indexInBase,
                             executionContext.getSharedWorkerCount()
                     );
@@ -3329,23 +3404,29 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                     );
                 }
 
-                if (tempKeyIndexesInBase.size() == 1) {
+                if (tempKeyIndexesInBase.size() == 1 || isIntPairKey) {
+                    if (isIntPairKey) {
+                        // map key is the packed pair, key types are in the metadata already
+                        arrayColumnTypes.clear();
+                        arrayColumnTypes.add(ColumnType.LONG);
+                    }
                     for (int i = 0, n = tempVaf.size(); i < n; i++) {
                         tempVaf.getQuick(i).pushValueTypes(arrayColumnTypes);
                     }
 
                     if (tempVaf.size() == 0) { // similar to DistinctKeyRecordCursorFactory, handles e.g. select id from tab group by id
-                        int keyKind = specialCaseKeys ? SqlCodeGenerator.GKK_HOUR_INT : SqlCodeGenerator.GKK_VANILLA_INT;
                         CountVectorAggregateFunction countFunction = new CountVectorAggregateFunction(keyKind);
                         countFunction.pushValueTypes(arrayColumnTypes);
                         tempVaf.add(countFunction);
 
-                        tempSymbolSkewIndexes.clear();
-                        tempSymbolSkewIndexes.add(0);
+                        if (!isIntPairKey) {
+                            tempSymbolSkewIndexes.clear();
+                            tempSymbolSkewIndexes.add(0);
+                        }
                     }
 
                     try {
-                        GroupByUtils.validateGroupByColumns(sqlNodeStack, model, 1);
+                        GroupByUtils.validateGroupByColumns(sqlNodeStack, model, tempKeyIndexesInBase.size());
                     } catch (Throwable e) {
                         Misc.freeObjList(tempVaf);
                         throw e;
@@ -3357,9 +3438,12 @@ public class SqlCodeGenerator implements Mutable, Closeable {
                             meta,
                             arrayColumnTypes,
                             executionContext.getSharedWorkerCount(),
+                            keyKind,
                             tempVaf,
                             tempKeyIndexesInBase.getQuick(0),
                             tempKeyIndex.getQuick(0),
+                            isIntPairKey ? tempKeyIndexesInBase.getQuick(1) : -1,
+                            isIntPairKey ? tempKeyIndex.getQuick(1) : -1,
                             tempSymbolSkewIndexes
                     );
                 }
@@ -5479,6 +5563,9 @@ public class SqlCodeGenerator implements Mutable, Closeable {
         countConstructors.put(ColumnType.LONG, CountLongVectorAggregateFunction::new);
         countConstructors.put(ColumnType.DATE, CountLongVectorAggregateFunction::new);
         countConstructors.put(ColumnType.TIMESTAMP, CountLongVectorAggregateFunction::new);
+        countConstructors.put(ColumnType.FLOAT, CountFloatVectorAggregateFunction::new);
+        // UUID has count() only, there is no row-based sum(), min() or max() of UUID the kernels would have to match
+        countConstructors.put(ColumnType.UUID, CountLong128VectorAggregateFunction::new);
 
         sumConstructors.put(ColumnType.DOUBLE, SumDoubleVectorAggregateFunction::new);
         sumConstructors.put(ColumnType.INT, SumIntVectorAggregateFunction::new);
@@ -5487,6 +5574,8 @@ public class SqlCodeGenerator implements Mutable, Closeable {
         sumConstructors.put(ColumnType.DATE, SumDateVectorAggregateFunction::new);
         sumConstructors.put(ColumnType.TIMESTAMP, SumTimestampVectorAggregateFunction::new);
         sumConstructors.put(ColumnType.SHORT, SumShortVectorAggregateFunction::new);
+        sumConstructors.put(ColumnType.BYTE, SumByteVectorAggregateFunction::new);
+        sumConstructors.put(ColumnType.FLOAT, SumFloatVectorAggregateFunction::new);
 
         ksumConstructors.put(ColumnType.DOUBLE, KSumDoubleVectorAggregateFunction::new);
         nsumConstructors.put(ColumnType.DOUBLE, NSumDoubleVectorAggregateFunction::new);
@@ -5504,6 +5593,9 @@ public class SqlCodeGenerator implements Mutable, Closeable {
         minConstructors.put(ColumnType.TIMESTAMP, MinTimestampVectorAggregateFunction::new);
         minConstructors.put(ColumnType.INT, MinIntVectorAggregateFunction::new);
         minConstructors.put(ColumnType.SHORT, MinShortVectorAggregateFunction::new);
+        minConstructors.put(ColumnType.BYTE, MinByteVectorAggregateFunction::new);
+        minConstructors.put(ColumnType.CHAR, MinCharVectorAggregateFunction::new);
+        minConstructors.put(ColumnType.FLOAT, MinFloatVectorAggregateFunction::new);
 
         maxConstructors.put(ColumnType.DOUBLE, MaxDoubleVectorAggregateFunction::new);
         maxConstructors.put(ColumnType.LONG, MaxLongVectorAggregateFunction::new);
@@ -5511,5 +5603,15 @@ public class SqlCodeGenerator implements Mutable, Closeable {
         maxConstructors.put(ColumnType.TIMESTAMP, MaxTimestampVectorAggregateFunction::new);
         maxConstructors.put(ColumnType.INT, MaxIntVectorAggregateFunction::new);
         maxConstructors.put(ColumnType.SHORT, MaxShortVectorAggregateFunction::new);
+        maxConstructors.put(ColumnType.BYTE, MaxByteVectorAggregateFunction::new);
+        maxConstructors.put(ColumnType.CHAR, MaxCharVectorAggregateFunction::new);
+        maxConstructors.put(ColumnType.FLOAT, MaxFloatVectorAggregateFunction::new);
+
+        // covar_pop(), covar_samp() and corr() are not vectorized and stay row-at-a-time: vector group by
+        // feeds each function a single column per page frame, while they need a pair of columns
+        varPopConstructors.put(ColumnType.DOUBLE, VarianceDoubleVectorAggregateFunction::newVarPop);
+        varSampConstructors.put(ColumnType.DOUBLE, VarianceDoubleVectorAggregateFunction::newVarSamp);
+        stdDevPopConstructors.put(ColumnType.DOUBLE, VarianceDoubleVectorAggregateFunction::newStdDevPop);
+        stdDevSampConstructors.put(ColumnType.DOUBLE, VarianceDoubleVectorAggregateFunction::newStdDevSamp);
     }
 }
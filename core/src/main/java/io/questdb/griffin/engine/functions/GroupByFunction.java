@@ -32,11 +32,50 @@ import io.questdb.griffin.engine.groupby.GroupByAllocator;
 import io.questdb.std.Mutable;
 
 public interface GroupByFunction extends Function, Mutable {
+    // offsets of SAMPLE BY bucket statistics, see Vect.sampleByStatsDouble()
+    long BUCKET_STATS_COUNT_OFFSET = 0;
+    long BUCKET_STATS_MAX_OFFSET = 32;
+    long BUCKET_STATS_MIN_OFFSET = 24;
+    long BUCKET_STATS_SIZE = 40;
+    long BUCKET_STATS_SUM_COUNT_OFFSET = 8;
+    long BUCKET_STATS_SUM_OFFSET = 16;
 
     @Override
     default void clear() {
     }
 
+    /**
+     * Aggregates column values at the given frame-local rows in one native call. Only called for
+     * non-keyed group by when {@link #getArgColumnIndex()} is non-negative. When
+     * {@code mapValue.isNew()} is true the batch replaces the value, as in {@link #computeFirst},
+     * otherwise it is accumulated, as in {@link #computeNext}.
+     *
+     * @param mapValue  value to aggregate into
+     * @param ptr       page frame address of the column returned by {@link #getArgColumnIndex()}
+     * @param pRows     address of the row index list
+     * @param rowCount  number of row indexes, always positive
+     * @param pScratch  8 bytes of native memory owned by the calling worker
+     */
+    default void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        throw new UnsupportedOperationException();
+    }
+
+    /**
+     * Aggregates a run of consecutive rows from their statistics, computed by a SAMPLE BY bucket
+     * kernel such as {@link io.questdb.std.Vect#sampleByStatsDouble}. Only called for non-keyed
+     * SAMPLE BY when {@link #isComputeBucketSupported()} is true. When {@code mapValue.isNew()}
+     * is true the run replaces the value, as in {@link #computeFirst}, otherwise it is accumulated,
+     * as in {@link #computeNext}.
+     *
+     * @param mapValue value to aggregate into
+     * @param rowCount number of rows in the run, always positive
+     * @param pStats   statistics of the column returned by {@link #getArgColumnIndex()},
+     *                 see BUCKET_STATS_* offsets, 0 when the function has no argument
+     */
+    default void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        throw new UnsupportedOperationException();
+    }
+
     void computeFirst(MapValue mapValue, Record record);
 
     void computeNext(MapValue mapValue, Record record);
@@ -46,6 +85,14 @@ public interface GroupByFunction extends Function, Mutable {
         return false;
     }
 
+    /**
+     * Returns page frame index of the column the function aggregates, or -1 when the argument
+     * is not a plain column.
+     */
+    default int getArgColumnIndex() {
+        return -1;
+    }
+
     int getValueIndex();
 
     default void interpolateBoundary(
@@ -71,6 +118,11 @@ public interface GroupByFunction extends Function, Mutable {
         return false;
     }
 
+    // functions of a plain column can aggregate bucket statistics of the column
+    default boolean isComputeBucketSupported() {
+        return getArgColumnIndex() > -1;
+    }
+
     default boolean isInterpolationSupported() {
         return false;
     }
@@ -47,6 +47,10 @@ public class DoubleColumn extends DoubleFunction implements ScalarFunction {
         return new DoubleColumn(columnIndex);
     }
 
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
     @Override
     public double getDouble(Record rec) {
         return rec.getDouble(columnIndex);
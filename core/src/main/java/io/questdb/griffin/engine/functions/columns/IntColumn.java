@@ -47,6 +47,10 @@ public class IntColumn extends IntFunction implements ScalarFunction {
         return new IntColumn(columnIndex);
     }
 
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
     @Override
     public int getInt(Record rec) {
         return rec.getInt(columnIndex);
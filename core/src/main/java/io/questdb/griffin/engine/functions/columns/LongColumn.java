@@ -47,6 +47,10 @@ public class LongColumn extends LongFunction implements ScalarFunction {
         return new LongColumn(columnIndex);
     }
 
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
     @Override
     public long getLong(Record rec) {
         return rec.getLong(columnIndex);
@@ -32,7 +32,10 @@ import io.questdb.cairo.sql.Record;
 import io.questdb.griffin.engine.functions.DoubleFunction;
 import io.questdb.griffin.engine.functions.GroupByFunction;
 import io.questdb.griffin.engine.functions.UnaryFunction;
+import io.questdb.griffin.engine.functions.columns.DoubleColumn;
 import io.questdb.std.Numbers;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class AvgDoubleGroupByFunction extends DoubleFunction implements GroupByFunction, UnaryFunction {
@@ -43,6 +46,32 @@ public class AvgDoubleGroupByFunction extends DoubleFunction implements GroupByF
         this.arg = arg;
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final double sum = Vect.sumDoubleFiltered(ptr, pRows, rowCount, pScratch);
+        final long count = Unsafe.getUnsafe().getLong(pScratch);
+        if (mapValue.isNew()) {
+            mapValue.putDouble(valueIndex, sum);
+            mapValue.putLong(valueIndex + 1, count);
+        } else {
+            mapValue.addDouble(valueIndex, sum);
+            mapValue.addLong(valueIndex + 1, count);
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final double sum = Unsafe.getUnsafe().getDouble(pStats + BUCKET_STATS_SUM_OFFSET);
+        final long count = Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_SUM_COUNT_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putDouble(valueIndex, sum);
+            mapValue.putLong(valueIndex + 1, count);
+        } else {
+            mapValue.addDouble(valueIndex, sum);
+            mapValue.addLong(valueIndex + 1, count);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         final double d = arg.getDouble(record);
@@ -69,6 +98,11 @@ public class AvgDoubleGroupByFunction extends DoubleFunction implements GroupByF
         return arg;
     }
 
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof DoubleColumn ? ((DoubleColumn) arg).getColumnIndex() : -1;
+    }
+
     @Override
     public double getDouble(Record rec) {
         return rec.getDouble(valueIndex) / rec.getLong(valueIndex + 1);
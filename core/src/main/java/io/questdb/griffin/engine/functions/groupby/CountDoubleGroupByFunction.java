@@ -27,6 +27,9 @@ package io.questdb.griffin.engine.functions.groupby;
 import io.questdb.cairo.map.MapValue;
 import io.questdb.cairo.sql.Function;
 import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.columns.DoubleColumn;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class CountDoubleGroupByFunction extends AbstractCountGroupByFunction {
@@ -35,6 +38,26 @@ public class CountDoubleGroupByFunction extends AbstractCountGroupByFunction {
         super(arg);
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final long count = Vect.countDoubleFiltered(ptr, pRows, rowCount);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, count);
+        } else {
+            mapValue.addLong(valueIndex, count);
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final long count = Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_COUNT_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, count);
+        } else {
+            mapValue.addLong(valueIndex, count);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         final double value = arg.getDouble(record);
@@ -52,4 +75,9 @@ public class CountDoubleGroupByFunction extends AbstractCountGroupByFunction {
             mapValue.addLong(valueIndex, 1);
         }
     }
+
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof DoubleColumn ? ((DoubleColumn) arg).getColumnIndex() : -1;
+    }
 }
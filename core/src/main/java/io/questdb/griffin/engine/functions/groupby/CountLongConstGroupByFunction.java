@@ -36,6 +36,15 @@ import io.questdb.std.Numbers;
 public class CountLongConstGroupByFunction extends LongFunction implements GroupByFunction {
     private int valueIndex;
 
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, rowCount);
+        } else {
+            mapValue.addLong(valueIndex, rowCount);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         mapValue.putLong(valueIndex, 1);
@@ -56,6 +65,11 @@ public class CountLongConstGroupByFunction extends LongFunction implements Group
         return valueIndex;
     }
 
+    @Override
+    public boolean isComputeBucketSupported() {
+        return true;
+    }
+
     @Override
     public boolean isParallelismSupported() {
         return true;
@@ -27,7 +27,10 @@ package io.questdb.griffin.engine.functions.groupby;
 import io.questdb.cairo.map.MapValue;
 import io.questdb.cairo.sql.Function;
 import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.columns.LongColumn;
 import io.questdb.std.Numbers;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class CountLongGroupByFunction extends AbstractCountGroupByFunction {
@@ -36,6 +39,26 @@ public class CountLongGroupByFunction extends AbstractCountGroupByFunction {
         super(arg);
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final long count = Vect.countLongFiltered(ptr, pRows, rowCount);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, count);
+        } else {
+            mapValue.addLong(valueIndex, count);
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final long count = Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_COUNT_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, count);
+        } else {
+            mapValue.addLong(valueIndex, count);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         final long value = arg.getLong(record);
@@ -53,4 +76,9 @@ public class CountLongGroupByFunction extends AbstractCountGroupByFunction {
             mapValue.addLong(valueIndex, 1);
         }
     }
+
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof LongColumn ? ((LongColumn) arg).getColumnIndex() : -1;
+    }
 }
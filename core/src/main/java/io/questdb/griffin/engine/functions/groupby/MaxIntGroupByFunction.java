@@ -32,7 +32,10 @@ import io.questdb.cairo.sql.Record;
 import io.questdb.griffin.engine.functions.GroupByFunction;
 import io.questdb.griffin.engine.functions.IntFunction;
 import io.questdb.griffin.engine.functions.UnaryFunction;
+import io.questdb.griffin.engine.functions.columns.IntColumn;
 import io.questdb.std.Numbers;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class MaxIntGroupByFunction extends IntFunction implements GroupByFunction, UnaryFunction {
@@ -43,6 +46,26 @@ public class MaxIntGroupByFunction extends IntFunction implements GroupByFunctio
         this.arg = arg;
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final int max = Vect.maxIntFiltered(ptr, pRows, rowCount);
+        if (mapValue.isNew()) {
+            mapValue.putInt(valueIndex, max);
+        } else {
+            mapValue.maxInt(valueIndex, max);
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final int max = (int) Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_MAX_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putInt(valueIndex, max);
+        } else {
+            mapValue.maxInt(valueIndex, max);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         mapValue.putInt(valueIndex, arg.getInt(record));
@@ -58,6 +81,11 @@ public class MaxIntGroupByFunction extends IntFunction implements GroupByFunctio
         return arg;
     }
 
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof IntColumn ? ((IntColumn) arg).getColumnIndex() : -1;
+    }
+
     @Override
     public int getInt(Record rec) {
         return rec.getInt(valueIndex);
@@ -32,6 +32,9 @@ import io.questdb.cairo.sql.Record;
 import io.questdb.griffin.engine.functions.DoubleFunction;
 import io.questdb.griffin.engine.functions.GroupByFunction;
 import io.questdb.griffin.engine.functions.UnaryFunction;
+import io.questdb.griffin.engine.functions.columns.DoubleColumn;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class MinDoubleGroupByFunction extends DoubleFunction implements GroupByFunction, UnaryFunction {
@@ -42,6 +45,32 @@ public class MinDoubleGroupByFunction extends DoubleFunction implements GroupByF
         this.arg = arg;
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final double min = Vect.minDoubleFiltered(ptr, pRows, rowCount);
+        if (mapValue.isNew()) {
+            mapValue.putDouble(valueIndex, min);
+        } else {
+            final double current = mapValue.getDouble(valueIndex);
+            if (min < current || Double.isNaN(current)) {
+                mapValue.putDouble(valueIndex, min);
+            }
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final double min = Unsafe.getUnsafe().getDouble(pStats + BUCKET_STATS_MIN_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putDouble(valueIndex, min);
+        } else {
+            final double current = mapValue.getDouble(valueIndex);
+            if (min < current || Double.isNaN(current)) {
+                mapValue.putDouble(valueIndex, min);
+            }
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         mapValue.putDouble(valueIndex, arg.getDouble(record));
@@ -61,6 +90,11 @@ public class MinDoubleGroupByFunction extends DoubleFunction implements GroupByF
         return arg;
     }
 
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof DoubleColumn ? ((DoubleColumn) arg).getColumnIndex() : -1;
+    }
+
     @Override
     public double getDouble(Record rec) {
         return rec.getDouble(valueIndex);
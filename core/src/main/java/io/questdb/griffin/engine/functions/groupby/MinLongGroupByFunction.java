@@ -32,7 +32,10 @@ import io.questdb.cairo.sql.Record;
 import io.questdb.griffin.engine.functions.GroupByFunction;
 import io.questdb.griffin.engine.functions.LongFunction;
 import io.questdb.griffin.engine.functions.UnaryFunction;
+import io.questdb.griffin.engine.functions.columns.LongColumn;
 import io.questdb.std.Numbers;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class MinLongGroupByFunction extends LongFunction implements GroupByFunction, UnaryFunction {
@@ -43,6 +46,26 @@ public class MinLongGroupByFunction extends LongFunction implements GroupByFunct
         this.arg = arg;
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final long min = Vect.minLongFiltered(ptr, pRows, rowCount);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, min);
+        } else {
+            mapValue.minLong(valueIndex, min);
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final long min = Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_MIN_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, min);
+        } else {
+            mapValue.minLong(valueIndex, min);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         mapValue.putLong(valueIndex, arg.getLong(record));
@@ -58,6 +81,11 @@ public class MinLongGroupByFunction extends LongFunction implements GroupByFunct
         return arg;
     }
 
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof LongColumn ? ((LongColumn) arg).getColumnIndex() : -1;
+    }
+
     @Override
     public long getLong(Record rec) {
         return rec.getLong(valueIndex);
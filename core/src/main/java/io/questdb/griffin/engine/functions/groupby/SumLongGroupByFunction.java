@@ -32,7 +32,10 @@ import io.questdb.cairo.sql.Record;
 import io.questdb.griffin.engine.functions.GroupByFunction;
 import io.questdb.griffin.engine.functions.LongFunction;
 import io.questdb.griffin.engine.functions.UnaryFunction;
+import io.questdb.griffin.engine.functions.columns.LongColumn;
 import io.questdb.std.Numbers;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import org.jetbrains.annotations.NotNull;
 
 public class SumLongGroupByFunction extends LongFunction implements GroupByFunction, UnaryFunction {
@@ -43,6 +46,32 @@ public class SumLongGroupByFunction extends LongFunction implements GroupByFunct
         this.arg = arg;
     }
 
+    @Override
+    public void computeBatch(MapValue mapValue, long ptr, long pRows, long rowCount, long pScratch) {
+        final long sum = Vect.sumLongFiltered(ptr, pRows, rowCount, pScratch);
+        final long count = Unsafe.getUnsafe().getLong(pScratch);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, sum);
+            mapValue.putLong(valueIndex + 1, count);
+        } else {
+            mapValue.addLong(valueIndex, sum);
+            mapValue.addLong(valueIndex + 1, count);
+        }
+    }
+
+    @Override
+    public void computeBucket(MapValue mapValue, long rowCount, long pStats) {
+        final long sum = Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_SUM_OFFSET);
+        final long count = Unsafe.getUnsafe().getLong(pStats + BUCKET_STATS_SUM_COUNT_OFFSET);
+        if (mapValue.isNew()) {
+            mapValue.putLong(valueIndex, sum);
+            mapValue.putLong(valueIndex + 1, count);
+        } else {
+            mapValue.addLong(valueIndex, sum);
+            mapValue.addLong(valueIndex + 1, count);
+        }
+    }
+
     @Override
     public void computeFirst(MapValue mapValue, Record record) {
         final long value = arg.getLong(record);
@@ -69,6 +98,11 @@ public class SumLongGroupByFunction extends LongFunction implements GroupByFunct
         return arg;
     }
 
+    @Override
+    public int getArgColumnIndex() {
+        return arg instanceof LongColumn ? ((LongColumn) arg).getColumnIndex() : -1;
+    }
+
     @Override
     public long getLong(Record rec) {
         return rec.getLong(valueIndex + 1) > 0 ? rec.getLong(valueIndex) : Numbers.LONG_NaN;
@@ -71,9 +71,12 @@ public class DistinctIntKeyRecordCursorFactory extends AbstractRecordCursorFacto
                 internalMeta,
                 columnTypes,
                 workerCount,
+                SqlCodeGenerator.GKK_VANILLA_INT,
                 vafList,
                 0,
                 0,
+                -1,
+                -1,
                 null
         );
     }
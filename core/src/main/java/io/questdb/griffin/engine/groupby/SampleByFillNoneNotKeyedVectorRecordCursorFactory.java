@@ -0,0 +1,406 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+
+package io.questdb.griffin.engine.groupby;
+
+import io.questdb.cairo.AbstractRecordCursorFactory;
+import io.questdb.cairo.ColumnType;
+import io.questdb.cairo.sql.*;
+import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.PlanSink;
+import io.questdb.griffin.SqlException;
+import io.questdb.griffin.SqlExecutionContext;
+import io.questdb.griffin.engine.functions.GroupByFunction;
+import io.questdb.griffin.engine.functions.SymbolFunction;
+import io.questdb.griffin.engine.functions.TimestampFunction;
+import io.questdb.std.*;
+import io.questdb.std.datetime.microtime.Timestamps;
+import org.jetbrains.annotations.NotNull;
+
+import static io.questdb.cairo.sql.DataFrameCursorFactory.ORDER_ASC;
+import static io.questdb.griffin.engine.functions.GroupByFunction.BUCKET_STATS_SIZE;
+
+/**
+ * Non-keyed SAMPLE BY with FILL(NONE) and a fixed stride, without a time zone. Timestamps of a page
+ * frame are split into buckets by a native kernel, the same way as row-by-row SAMPLE BY does, and
+ * functions aggregate per bucket statistics of their columns, see {@link GroupByFunction#computeBucket}.
+ * The last bucket of a frame is kept open, it goes on when the next frame starts with its rows.
+ */
+public class SampleByFillNoneNotKeyedVectorRecordCursorFactory extends AbstractRecordCursorFactory {
+    // buckets of one kernel call
+    private static final long MAX_BUCKETS = 1024;
+    private final RecordCursorFactory base;
+    private final SampleByFillNoneNotKeyedVectorRecordCursor cursor;
+    // stats slot of each function, -1 for functions without argument
+    private final IntList functionSlots = new IntList();
+    private final ObjList<GroupByFunction> groupByFunctions;
+    private final Function offsetFunc;
+    private final int offsetFuncPos;
+    private final ObjList<Function> recordFunctions;
+    // column and column type of each stats slot
+    private final IntList slotColumnIndexes = new IntList();
+    private final IntList slotColumnTypes = new IntList();
+    private final long stride;
+    private final int timestampIndex;
+    private final TimestampSampler timestampSampler;
+    private final Function timezoneNameFunc;
+    private long pBuckets;
+    private long pStats;
+
+    public SampleByFillNoneNotKeyedVectorRecordCursorFactory(
+            RecordCursorFactory base,
+            @NotNull TimestampSampler timestampSampler,
+            RecordMetadata groupByMetadata,
+            ObjList<GroupByFunction> groupByFunctions,
+            ObjList<Function> recordFunctions,
+            int valueCount,
+            int timestampIndex,
+            Function timezoneNameFunc,
+            Function offsetFunc,
+            int offsetFuncPos
+    ) {
+        super(groupByMetadata);
+        assert isSupported(base, timestampSampler, timezoneNameFunc, groupByFunctions);
+        this.base = base;
+        this.timestampSampler = timestampSampler;
+        this.stride = timestampSampler.getBucketSize();
+        this.groupByFunctions = groupByFunctions;
+        this.recordFunctions = recordFunctions;
+        this.timestampIndex = timestampIndex;
+        this.timezoneNameFunc = timezoneNameFunc;
+        this.offsetFunc = offsetFunc;
+        this.offsetFuncPos = offsetFuncPos;
+
+        final RecordMetadata baseMetadata = base.getMetadata();
+        for (int i = 0, n = groupByFunctions.size(); i < n; i++) {
+            final int columnIndex = groupByFunctions.getQuick(i).getArgColumnIndex();
+            int slot = -1;
+            if (columnIndex > -1) {
+                // functions of the same column share its stats
+                slot = slotColumnIndexes.indexOf(columnIndex, 0, slotColumnIndexes.size());
+                if (slot < 0) {
+                    slot = slotColumnIndexes.size();
+                    slotColumnIndexes.add(columnIndex);
+                    slotColumnTypes.add(baseMetadata.getColumnType(columnIndex));
+                }
+            }
+            functionSlots.add(slot);
+        }
+
+        this.cursor = new SampleByFillNoneNotKeyedVectorRecordCursor(new SimpleMapValue(valueCount));
+    }
+
+    /**
+     * Timestamps of fixed stride samplers are bucketed natively, calendar ones and time zones
+     * with daylight saving changes are left to row-by-row SAMPLE BY. Functions must aggregate
+     * bucket stats of INT, LONG or DOUBLE columns or need no argument at all.
+     */
+    public static boolean isSupported(
+            RecordCursorFactory base,
+            TimestampSampler timestampSampler,
+            Function timezoneNameFunc,
+            ObjList<GroupByFunction> groupByFunctions
+    ) {
+        if (!(timestampSampler instanceof MicroTimestampSampler)
+                || !timezoneNameFunc.isConstant()
+                || timezoneNameFunc.getStr(null) != null
+                || !base.supportsPageFrameCursor()) {
+            return false;
+        }
+
+        final RecordMetadata baseMetadata = base.getMetadata();
+        for (int i = 0, n = groupByFunctions.size(); i < n; i++) {
+            final GroupByFunction function = groupByFunctions.getQuick(i);
+            if (!function.isComputeBucketSupported()) {
+                return false;
+            }
+            final int columnIndex = function.getArgColumnIndex();
+            if (columnIndex > -1) {
+                switch (ColumnType.tagOf(baseMetadata.getColumnType(columnIndex))) {
+                    case ColumnType.DOUBLE:
+                    case ColumnType.INT:
+                    case ColumnType.LONG:
+                        break;
+                    default:
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    @Override
+    public RecordCursorFactory getBaseFactory() {
+        return base;
+    }
+
+    @Override
+    public RecordCursor getCursor(SqlExecutionContext executionContext) throws SqlException {
+        final PageFrameCursor pageFrameCursor = base.getPageFrameCursor(executionContext, ORDER_ASC);
+        try {
+            return cursor.of(pageFrameCursor, executionContext);
+        } catch (Throwable th) {
+            Misc.free(pageFrameCursor);
+            throw th;
+        }
+    }
+
+    @Override
+    public boolean recordCursorSupportsRandomAccess() {
+        return false;
+    }
+
+    @Override
+    public void toPlan(PlanSink sink) {
+        sink.type("SampleBy");
+        sink.meta("vectorized").val(true);
+        sink.optAttr("values", groupByFunctions, true);
+        sink.child(base);
+    }
+
+    @Override
+    public boolean usesCompiledFilter() {
+        return base.usesCompiledFilter();
+    }
+
+    @Override
+    public boolean usesIndex() {
+        return base.usesIndex();
+    }
+
+    @Override
+    protected void _close() {
+        Misc.freeObjList(recordFunctions);
+        Misc.free(timezoneNameFunc);
+        Misc.free(offsetFunc);
+        Misc.free(base);
+        pBuckets = Unsafe.free(pBuckets, 2 * Long.BYTES * MAX_BUCKETS, MemoryTag.NATIVE_GROUP_BY_FUNCTION);
+        pStats = Unsafe.free(pStats, slotColumnIndexes.size() * MAX_BUCKETS * BUCKET_STATS_SIZE, MemoryTag.NATIVE_GROUP_BY_FUNCTION);
+    }
+
+    private class SampleByFillNoneNotKeyedVectorRecordCursor implements NoRandomAccessRecordCursor {
+        private final VirtualRecord record;
+        private final SimpleMapValue value;
+        private long bucketCount;
+        private long bucketIndex;
+        // chunk row the current bucket starts at
+        private long bucketRowLo;
+        private SqlExecutionCircuitBreaker circuitBreaker;
+        private long fixedOffset;
+        private PageFrame frame;
+        private long frameRowCount;
+        // frame row the next chunk starts at
+        private long frameRowLo;
+        // the value holds the last bucket of the previous chunk, it is not complete yet
+        private boolean hasPending;
+        private boolean isStartSet;
+        private PageFrameCursor pageFrameCursor;
+        private long pendingTimestamp;
+        private long sampleTimestamp;
+        private long start;
+
+        public SampleByFillNoneNotKeyedVectorRecordCursor(SimpleMapValue value) {
+            this.value = value;
+            for (int i = 0, n = recordFunctions.size(); i < n; i++) {
+                if (recordFunctions.getQuick(i) == null) {
+                    recordFunctions.setQuick(i, new TimestampFunc());
+                }
+            }
+            this.record = new VirtualRecordNoRowid(recordFunctions);
+            this.record.of(value);
+        }
+
+        @Override
+        public void close() {
+            pageFrameCursor = Misc.free(pageFrameCursor);
+            Misc.clearObjList(groupByFunctions);
+            frame = null;
+            circuitBreaker = null;
+        }
+
+        @Override
+        public Record getRecord() {
+            return record;
+        }
+
+        @Override
+        public SymbolTable getSymbolTable(int columnIndex) {
+            return (SymbolTable) recordFunctions.getQuick(columnIndex);
+        }
+
+        @Override
+        public boolean hasNext() {
+            while (true) {
+                if (bucketIndex < bucketCount) {
+                    final long pBucket = pBuckets + 2 * Long.BYTES * bucketIndex;
+                    final long bucketTimestamp = Unsafe.getUnsafe().getLong(pBucket);
+                    if (hasPending && bucketTimestamp != pendingTimestamp) {
+                        hasPending = false;
+                        sampleTimestamp = pendingTimestamp;
+                        return true;
+                    }
+
+                    final long bucketRowHi = Unsafe.getUnsafe().getLong(pBucket + Long.BYTES);
+                    value.setNew(!hasPending);
+                    for (int i = 0, n = groupByFunctions.size(); i < n; i++) {
+                        final int slot = functionSlots.getQuick(i);
+                        final long pBucketStats = slot > -1 ? pStats + (slot * MAX_BUCKETS + bucketIndex) * BUCKET_STATS_SIZE : 0;
+                        groupByFunctions.getQuick(i).computeBucket(value, bucketRowHi - bucketRowLo, pBucketStats);
+                    }
+                    bucketRowLo = bucketRowHi;
+                    if (++bucketIndex < bucketCount) {
+                        hasPending = false;
+                        sampleTimestamp = bucketTimestamp;
+                        return true;
+                    }
+                    hasPending = true;
+                    pendingTimestamp = bucketTimestamp;
+                } else if (!nextChunk()) {
+                    if (hasPending) {
+                        hasPending = false;
+                        sampleTimestamp = pendingTimestamp;
+                        return true;
+                    }
+                    return false;
+                }
+            }
+        }
+
+        @Override
+        public SymbolTable newSymbolTable(int columnIndex) {
+            return ((SymbolFunction) recordFunctions.getQuick(columnIndex)).newSymbolTable();
+        }
+
+        public SampleByFillNoneNotKeyedVectorRecordCursor of(PageFrameCursor pageFrameCursor, SqlExecutionContext executionContext) throws SqlException {
+            this.pageFrameCursor = pageFrameCursor;
+            this.circuitBreaker = executionContext.getCircuitBreaker();
+            Function.init(recordFunctions, pageFrameCursor, executionContext);
+            offsetFunc.init(pageFrameCursor, executionContext);
+            final CharSequence offset = offsetFunc.getStr(null);
+            if (offset != null) {
+                final long val = Timestamps.parseOffset(offset);
+                if (val == Numbers.LONG_NaN) {
+                    // bad value for offset
+                    throw SqlException.$(offsetFuncPos, "invalid offset: ").put(offset);
+                }
+                fixedOffset = Numbers.decodeLowInt(val) * Timestamps.MINUTE_MICROS;
+            } else {
+                fixedOffset = Long.MIN_VALUE;
+            }
+            if (pBuckets == 0) {
+                pBuckets = Unsafe.malloc(2 * Long.BYTES * MAX_BUCKETS, MemoryTag.NATIVE_GROUP_BY_FUNCTION);
+            }
+            if (pStats == 0 && slotColumnIndexes.size() > 0) {
+                pStats = Unsafe.malloc(slotColumnIndexes.size() * MAX_BUCKETS * BUCKET_STATS_SIZE, MemoryTag.NATIVE_GROUP_BY_FUNCTION);
+            }
+            reset();
+            return this;
+        }
+
+        @Override
+        public long size() {
+            return -1;
+        }
+
+        @Override
+        public void toTop() {
+            GroupByUtils.toTop(recordFunctions);
+            pageFrameCursor.toTop();
+            reset();
+        }
+
+        // buckets of the next rows of the current frame or of the next frame, false when out of frames
+        private boolean nextChunk() {
+            while (frameRowLo == frameRowCount) {
+                frame = pageFrameCursor.next();
+                if (frame == null) {
+                    return false;
+                }
+                frameRowLo = 0;
+                frameRowCount = frame.getPartitionHi() - frame.getPartitionLo();
+            }
+            circuitBreaker.statefulThrowExceptionIfTripped();
+
+            final long pTimestamps = frame.getPageAddress(timestampIndex) + (frameRowLo << 3);
+            final long timestamp = Unsafe.getUnsafe().getLong(pTimestamps);
+            if (!isStartSet) {
+                // without an offset intervals are aligned to the first observation
+                start = fixedOffset != Long.MIN_VALUE ? fixedOffset : timestamp;
+                timestampSampler.setStart(start);
+                isStartSet = true;
+            }
+            final long bucketTimestamp = hasPending && timestamp < pendingTimestamp + stride ? pendingTimestamp : timestampSampler.round(timestamp);
+            bucketCount = Vect.sampleByBuckets(pTimestamps, frameRowCount - frameRowLo, start, stride, bucketTimestamp, pBuckets, MAX_BUCKETS);
+
+            for (int i = 0, n = slotColumnIndexes.size(); i < n; i++) {
+                final int columnIndex = slotColumnIndexes.getQuick(i);
+                final long pageAddress = frame.getPageAddress(columnIndex);
+                // column top, values are null
+                final long pColumn = pageAddress != 0 ? pageAddress + (frameRowLo << frame.getColumnShiftBits(columnIndex)) : 0;
+                final long pSlotStats = pStats + i * MAX_BUCKETS * BUCKET_STATS_SIZE;
+                switch (ColumnType.tagOf(slotColumnTypes.getQuick(i))) {
+                    case ColumnType.DOUBLE:
+                        Vect.sampleByStatsDouble(pColumn, pBuckets, bucketCount, pSlotStats);
+                        break;
+                    case ColumnType.INT:
+                        Vect.sampleByStatsInt(pColumn, pBuckets, bucketCount, pSlotStats);
+                        break;
+                    default:
+                        Vect.sampleByStatsLong(pColumn, pBuckets, bucketCount, pSlotStats);
+                        break;
+                }
+            }
+
+            frameRowLo += Unsafe.getUnsafe().getLong(pBuckets + 2 * Long.BYTES * bucketCount - Long.BYTES);
+            bucketIndex = 0;
+            bucketRowLo = 0;
+            return true;
+        }
+
+        private void reset() {
+            frame = null;
+            frameRowCount = 0;
+            frameRowLo = 0;
+            bucketCount = 0;
+            bucketIndex = 0;
+            bucketRowLo = 0;
+            hasPending = false;
+            isStartSet = false;
+        }
+
+        private class TimestampFunc extends TimestampFunction {
+
+            @Override
+            public long getTimestamp(Record rec) {
+                return sampleTimestamp;
+            }
+
+            @Override
+            public void toPlan(PlanSink sink) {
+                sink.val("Timestamp");
+            }
+        }
+    }
+}
@@ -34,17 +34,29 @@ import io.questdb.std.Unsafe;
 
 import java.util.concurrent.atomic.LongAdder;
 
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public abstract class AbstractCountVectorAggregateFunction extends LongFunction implements VectorAggregateFunction {
     protected final LongAdder aggCount = new LongAdder();//counts number of null key aggregations 
     protected final LongAdder count = new LongAdder();
     private final int columnIndex;
+    private final int keyKind;
     protected DistinctFunc distinctFunc;
     protected KeyValueFunc keyValueFunc;
     protected int valueOffset;
 
-    public AbstractCountVectorAggregateFunction(int columnIndex) {
+    public AbstractCountVectorAggregateFunction(int keyKind, int columnIndex) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
+    }
+
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        count.add(Unsafe.getUnsafe().getLong(pStats + STATS_COUNT_OFFSET));
+        aggCount.increment();
     }
 
     @Override
@@ -75,7 +87,17 @@ public abstract class AbstractCountVectorAggregateFunction extends LongFunction
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntCountMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongCountMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128CountMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrCountMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntCountMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -84,6 +106,11 @@ public abstract class AbstractCountVectorAggregateFunction extends LongFunction
         types.add(ColumnType.LONG);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public void toPlan(PlanSink sink) {
         sink.val("count(").putBaseColumnName(columnIndex).val(')');
@@ -91,6 +118,16 @@ public abstract class AbstractCountVectorAggregateFunction extends LongFunction
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntCountWrapUp(pRosti, valueOffset, aggCount.sum() > 0 ? count.sum() : Long.MIN_VALUE);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongCountWrapUp(pRosti, valueOffset, aggCount.sum() > 0 ? count.sum() : Long.MIN_VALUE);
+            case GKK_LONG128:
+                return Rosti.keyedLong128CountWrapUp(pRosti, valueOffset, aggCount.sum() > 0 ? count.sum() : Long.MIN_VALUE);
+            case GKK_STR:
+                return Rosti.keyedStrCountWrapUp(pRosti, valueOffset, aggCount.sum() > 0 ? count.sum() : Long.MIN_VALUE);
+            default:
+                return Rosti.keyedIntCountWrapUp(pRosti, valueOffset, aggCount.sum() > 0 ? count.sum() : Long.MIN_VALUE);
+        }
     }
 }
@@ -34,12 +34,17 @@ import java.util.concurrent.atomic.DoubleAdder;
 import java.util.concurrent.atomic.LongAdder;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class AvgDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
 
     private final int columnIndex;
     private final LongAdder count = new LongAdder();
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final DoubleAdder sum = new DoubleAdder();
     private final int workerCount;
@@ -48,9 +53,22 @@ public class AvgDoubleVectorAggregateFunction extends DoubleFunction implements
 
     public AvgDoubleVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumDouble;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumDouble;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumDouble;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumDouble;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumDouble;
@@ -102,6 +120,11 @@ public class AvgDoubleVectorAggregateFunction extends DoubleFunction implements
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_DOUBLE;
+    }
+
     @Override
     public double getDouble(Record rec) {
         final long count = this.count.sum();
@@ -136,7 +159,17 @@ public class AvgDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -148,6 +181,16 @@ public class AvgDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntAvgDoubleWrapUp(pRosti, valueOffset, this.sum.sum(), this.count.sum());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongAvgDoubleWrapUp(pRosti, valueOffset, this.sum.sum(), this.count.sum());
+            case GKK_LONG128:
+                return Rosti.keyedLong128AvgDoubleWrapUp(pRosti, valueOffset, this.sum.sum(), this.count.sum());
+            case GKK_STR:
+                return Rosti.keyedStrAvgDoubleWrapUp(pRosti, valueOffset, this.sum.sum(), this.count.sum());
+            default:
+                return Rosti.keyedIntAvgDoubleWrapUp(pRosti, valueOffset, this.sum.sum(), this.count.sum());
+        }
     }
 }
@@ -35,12 +35,17 @@ import java.util.concurrent.atomic.DoubleAdder;
 import java.util.concurrent.atomic.LongAdder;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class AvgIntVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction, Closeable {
 
     private final int columnIndex;
     private final LongAdder count = new LongAdder();
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final DoubleAdder sum = new DoubleAdder();
     private final int workerCount;
@@ -49,9 +54,22 @@ public class AvgIntVectorAggregateFunction extends DoubleFunction implements Vec
 
     public AvgIntVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumInt;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumInt;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumInt;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumInt;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumInt;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumInt;
@@ -104,6 +122,11 @@ public class AvgIntVectorAggregateFunction extends DoubleFunction implements Vec
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_INT;
+    }
+
     @Override
     public double getDouble(Record rec) {
         final long count = this.count.sum();
@@ -133,7 +156,17 @@ public class AvgIntVectorAggregateFunction extends DoubleFunction implements Vec
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumIntMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumIntMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumIntMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -145,6 +178,16 @@ public class AvgIntVectorAggregateFunction extends DoubleFunction implements Vec
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntAvgLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongAvgLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_LONG128:
+                return Rosti.keyedLong128AvgLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_STR:
+                return Rosti.keyedStrAvgLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            default:
+                return Rosti.keyedIntAvgLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        }
     }
 }
@@ -34,12 +34,17 @@ import java.util.concurrent.atomic.DoubleAdder;
 import java.util.concurrent.atomic.LongAdder;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class AvgLongVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
 
     private final int columnIndex;
     private final LongAdder count = new LongAdder();
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final DoubleAdder sum = new DoubleAdder();
     private final int workerCount;
@@ -48,9 +53,22 @@ public class AvgLongVectorAggregateFunction extends DoubleFunction implements Ve
 
     public AvgLongVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumLongLong;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumLongLong;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumLongLong;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumLongLong;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumLongLong;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumLongLong;
@@ -102,6 +120,11 @@ public class AvgLongVectorAggregateFunction extends DoubleFunction implements Ve
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_LONG_LONG;
+    }
+
     @Override
     public double getDouble(Record rec) {
         final long count = this.count.sum();
@@ -133,7 +156,17 @@ public class AvgLongVectorAggregateFunction extends DoubleFunction implements Ve
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumLongLongMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumLongLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumLongLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumLongLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumLongLongMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -146,6 +179,16 @@ public class AvgLongVectorAggregateFunction extends DoubleFunction implements Ve
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntAvgLongLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongAvgLongLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_LONG128:
+                return Rosti.keyedLong128AvgLongLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_STR:
+                return Rosti.keyedStrAvgLongLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            default:
+                return Rosti.keyedIntAvgLongLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        }
     }
 }
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.ColumnType;
+import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.LongFunction;
+import io.questdb.std.*;
+
+/**
+ * Non-keyed aggregation of several functions of the same column with a single scan of the column.
+ * Count, null count, sum, min and max of each page frame are computed by a fused native kernel and
+ * handed to the functions via {@link VectorAggregateFunction#aggregateStats(long, int)}. The function
+ * is not part of the output, it only replaces the member functions in the list of aggregation tasks.
+ */
+public class ColumnStatsVectorAggregateFunction extends LongFunction implements VectorAggregateFunction {
+    private final int columnIndex;
+    private final int columnTypeTag;
+    private final ObjList<VectorAggregateFunction> functions;
+    private final int workerCount;
+    private long stats;
+
+    public ColumnStatsVectorAggregateFunction(int columnType, int columnIndex, ObjList<VectorAggregateFunction> functions, int workerCount) {
+        assert isSupported(columnType);
+        this.columnTypeTag = ColumnType.tagOf(columnType);
+        this.columnIndex = columnIndex;
+        this.functions = functions;
+        this.workerCount = workerCount;
+        this.stats = Unsafe.malloc((long) workerCount * Misc.CACHE_LINE_SIZE, MemoryTag.NATIVE_FUNC_RSS);
+    }
+
+    public static boolean isSupported(int columnType) {
+        switch (ColumnType.tagOf(columnType)) {
+            case ColumnType.INT:
+            case ColumnType.LONG:
+            case ColumnType.DATE:
+            case ColumnType.TIMESTAMP:
+            case ColumnType.DOUBLE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    @Override
+    public void aggregate(long address, long addressSize, int columnSizeHint, int workerId) {
+        if (address != 0) {
+            final long pStats = stats + (long) workerId * Misc.CACHE_LINE_SIZE;
+            final long count = addressSize >>> columnSizeHint;
+            switch (columnTypeTag) {
+                case ColumnType.INT:
+                    Vect.statsInt(address, count, pStats);
+                    break;
+                case ColumnType.DOUBLE:
+                    Vect.statsDouble(address, count, pStats);
+                    break;
+                default:
+                    Vect.statsLong(address, count, pStats);
+                    break;
+            }
+            aggregateStats(pStats, workerId);
+        }
+    }
+
+    @Override
+    public boolean aggregate(long pRosti, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        for (int i = 0, n = functions.size(); i < n; i++) {
+            functions.getQuick(i).aggregateStats(pStats, workerId);
+        }
+    }
+
+    @Override
+    public void clear() {
+        // member functions are cleared by the owning factory
+    }
+
+    @Override
+    public void close() {
+        if (stats != 0) {
+            Unsafe.free(stats, (long) workerCount * Misc.CACHE_LINE_SIZE, MemoryTag.NATIVE_FUNC_RSS);
+            stats = 0;
+        }
+        super.close();
+    }
+
+    @Override
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
+    @Override
+    public long getLong(Record rec) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public String getName() {
+        return "stats";
+    }
+
+    @Override
+    public int getValueOffset() {
+        return -1;
+    }
+
+    @Override
+    public void initRosti(long pRosti) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean isReadThreadSafe() {
+        return false;
+    }
+
+    @Override
+    public boolean merge(long pRostiA, long pRostiB) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void pushValueTypes(ArrayColumnTypes types) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean supportsBlockStats() {
+        for (int i = 0, n = functions.size(); i < n; i++) {
+            if (!functions.getQuick(i).supportsBlockStats()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
+    @Override
+    public boolean wrapUp(long pRosti) {
+        throw new UnsupportedOperationException();
+    }
+}
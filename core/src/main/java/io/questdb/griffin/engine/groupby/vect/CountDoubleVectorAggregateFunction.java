@@ -28,14 +28,30 @@ import io.questdb.std.Rosti;
 import io.questdb.std.Vect;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class CountDoubleVectorAggregateFunction extends AbstractCountVectorAggregateFunction {
 
     public CountDoubleVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
-        super(columnIndex);
+        super(keyKind, columnIndex);
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourCountDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairCountDouble;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongCountDouble;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128CountDouble;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrCountDouble;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntCountDouble;
@@ -61,4 +77,9 @@ public class CountDoubleVectorAggregateFunction extends AbstractCountVectorAggre
             return keyValueFunc.run(pRosti, keyAddress, valueAddress, valueAddressSize / Double.BYTES, valueOffset);
         }
     }
+
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_COUNT_DOUBLE;
+    }
 }
@@ -28,14 +28,30 @@ import io.questdb.std.Rosti;
 import io.questdb.std.Vect;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class CountIntVectorAggregateFunction extends AbstractCountVectorAggregateFunction {
 
     public CountIntVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
-        super(columnIndex);
+        super(keyKind, columnIndex);
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourCountInt;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairCountInt;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongCountInt;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128CountInt;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrCountInt;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntCountInt;
@@ -59,4 +75,9 @@ public class CountIntVectorAggregateFunction extends AbstractCountVectorAggregat
             return keyValueFunc.run(pRosti, keyAddress, valueAddress, valueAddressSize / Integer.BYTES, valueOffset);
         }
     }
+
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_COUNT_INT;
+    }
 }
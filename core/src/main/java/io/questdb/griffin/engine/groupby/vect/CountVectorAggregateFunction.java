@@ -38,10 +38,24 @@ import java.util.concurrent.atomic.LongAdder;
 public class CountVectorAggregateFunction extends LongFunction implements VectorAggregateFunction {
     private final LongAdder count = new LongAdder();
     private final CountFunc countFunc;
+    private final int keyKind;
     private int valueOffset;
 
     public CountVectorAggregateFunction(int keyKind) {
-        countFunc = keyKind == SqlCodeGenerator.GKK_HOUR_INT ? Rosti::keyedHourCount : Rosti::keyedIntCount;
+        this.keyKind = keyKind;
+        if (keyKind == SqlCodeGenerator.GKK_HOUR_INT) {
+            countFunc = Rosti::keyedHourCount;
+        } else if (keyKind == SqlCodeGenerator.GKK_INT_PAIR) {
+            countFunc = Rosti::keyedIntPairCount;
+        } else if (keyKind == SqlCodeGenerator.GKK_LONG) {
+            countFunc = Rosti::keyedLongCount;
+        } else if (keyKind == SqlCodeGenerator.GKK_LONG128) {
+            countFunc = Rosti::keyedLong128Count;
+        } else if (keyKind == SqlCodeGenerator.GKK_STR) {
+            countFunc = Rosti::keyedStrCount;
+        } else {
+            countFunc = Rosti::keyedIntCount;
+        }
     }
 
     @Override
@@ -64,6 +78,11 @@ public class CountVectorAggregateFunction extends LongFunction implements Vector
         return -1;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_COUNT;
+    }
+
     @Override
     public long getLong(Record rec) {
         return count.sum();
@@ -81,7 +100,17 @@ public class CountVectorAggregateFunction extends LongFunction implements Vector
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntCountMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case SqlCodeGenerator.GKK_INT_PAIR:
+            case SqlCodeGenerator.GKK_LONG:
+                return Rosti.keyedLongCountMerge(pRostiA, pRostiB, valueOffset);
+            case SqlCodeGenerator.GKK_LONG128:
+                return Rosti.keyedLong128CountMerge(pRostiA, pRostiB, valueOffset);
+            case SqlCodeGenerator.GKK_STR:
+                return Rosti.keyedStrCountMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntCountMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -97,7 +126,17 @@ public class CountVectorAggregateFunction extends LongFunction implements Vector
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntCountWrapUp(pRosti, valueOffset, count.sum() > 0 ? count.sum() : -1);
+        switch (keyKind) {
+            case SqlCodeGenerator.GKK_INT_PAIR:
+            case SqlCodeGenerator.GKK_LONG:
+                return Rosti.keyedLongCountWrapUp(pRosti, valueOffset, count.sum() > 0 ? count.sum() : -1);
+            case SqlCodeGenerator.GKK_LONG128:
+                return Rosti.keyedLong128CountWrapUp(pRosti, valueOffset, count.sum() > 0 ? count.sum() : -1);
+            case SqlCodeGenerator.GKK_STR:
+                return Rosti.keyedStrCountWrapUp(pRosti, valueOffset, count.sum() > 0 ? count.sum() : -1);
+            default:
+                return Rosti.keyedIntCountWrapUp(pRosti, valueOffset, count.sum() > 0 ? count.sum() : -1);
+        }
     }
 
     @FunctionalInterface
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.LongFunction;
+import io.questdb.std.*;
+
+import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
+
+/**
+ * Keyed aggregation of several functions of the same column with a single pass over the keys.
+ * Each page frame is aggregated by Rosti.keyed*MultiAgg() with one descriptor per member function,
+ * see {@link VectorAggregateFunction#getKeyedAggOp()}. The function is not part of the output, it only
+ * replaces the member functions in the list of aggregation tasks. Merge and wrap up are done by the members.
+ * <p>
+ * When the worker slot has a dense accumulator, see Rosti.allocDense(), keys of its range are aggregated
+ * by Rosti.keyed*DenseMultiAgg() instead. The accumulator is exported to the map by the owning factory.
+ */
+public class FusedVectorAggregateFunction extends LongFunction implements VectorAggregateFunction {
+    private final int columnIndex;
+    // dense accumulators per worker slot, owned by the factory, null when keys cannot be dense
+    private final long[] denseAccumulators;
+    private final ObjList<VectorAggregateFunction> functions;
+    private final boolean hourKeys;
+    private final int keyKind;
+    private final int workerCount;
+    private long aggs;
+
+    public FusedVectorAggregateFunction(
+            int keyKind,
+            int columnIndex,
+            ObjList<VectorAggregateFunction> functions,
+            int workerCount,
+            long[] denseAccumulators
+    ) {
+        this.hourKeys = keyKind == GKK_HOUR_INT;
+        this.keyKind = keyKind;
+        this.columnIndex = columnIndex;
+        this.functions = functions;
+        this.denseAccumulators = denseAccumulators;
+        this.workerCount = workerCount;
+        this.aggs = Unsafe.malloc(getAggsSize(), MemoryTag.NATIVE_FUNC_RSS);
+    }
+
+    @Override
+    public void aggregate(long address, long addressSize, int columnSizeHint, int workerId) {
+        for (int i = 0, n = functions.size(); i < n; i++) {
+            functions.getQuick(i).aggregate(address, addressSize, columnSizeHint, workerId);
+        }
+    }
+
+    @Override
+    public boolean aggregate(long pRosti, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId) {
+        final long pDense = denseAccumulators != null ? denseAccumulators[workerId] : 0;
+        if (pDense != 0) {
+            return aggregateDense(pDense, keyAddress, valueAddress, valueAddressSize, columnSizeShr, workerId);
+        }
+
+        final int n = functions.size();
+        if (valueAddress == 0) {
+            // column top, members only register keys
+            boolean ok = true;
+            for (int i = 0; i < n; i++) {
+                ok &= functions.getQuick(i).aggregate(pRosti, keyAddress, 0, valueAddressSize, columnSizeShr, workerId);
+            }
+            return ok;
+        }
+
+        // descriptors are per worker slot, the slot is locked by the caller
+        final long pAggs = aggs + (long) workerId * n * Rosti.AGG_DESCRIPTOR_SIZE;
+        for (int i = 0; i < n; i++) {
+            final VectorAggregateFunction vaf = functions.getQuick(i);
+            Rosti.putAggDescriptor(pAggs, i, valueAddress, vaf.getKeyedAggOp(), vaf.getValueOffset());
+        }
+        final long count = valueAddressSize >>> columnSizeShr;
+        switch (keyKind) {
+            case GKK_HOUR_INT:
+                return Rosti.keyedHourMultiAgg(pRosti, keyAddress, count, pAggs, n);
+            case GKK_INT_PAIR:
+                return Rosti.keyedIntPairMultiAgg(pRosti, keyAddress, count, pAggs, n);
+            case GKK_LONG:
+                return Rosti.keyedLongMultiAgg(pRosti, keyAddress, count, pAggs, n);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MultiAgg(pRosti, keyAddress, count, pAggs, n);
+            case GKK_STR:
+                return Rosti.keyedStrMultiAgg(pRosti, keyAddress, count, pAggs, n);
+            default:
+                return Rosti.keyedIntMultiAgg(pRosti, keyAddress, count, pAggs, n);
+        }
+    }
+
+    @Override
+    public void clear() {
+        // member functions are cleared by the owning factory
+    }
+
+    @Override
+    public void close() {
+        if (aggs != 0) {
+            Unsafe.free(aggs, getAggsSize(), MemoryTag.NATIVE_FUNC_RSS);
+            aggs = 0;
+        }
+        super.close();
+    }
+
+    @Override
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
+    @Override
+    public long getLong(Record rec) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public String getName() {
+        return "fused";
+    }
+
+    @Override
+    public int getValueOffset() {
+        return -1;
+    }
+
+    @Override
+    public void initRosti(long pRosti) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean isReadThreadSafe() {
+        return false;
+    }
+
+    @Override
+    public boolean merge(long pRostiA, long pRostiB) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public void pushValueTypes(ArrayColumnTypes types) {
+        throw new UnsupportedOperationException();
+    }
+
+    @Override
+    public boolean wrapUp(long pRosti) {
+        throw new UnsupportedOperationException();
+    }
+
+    private boolean aggregateDense(long pDense, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId) {
+        // same as in the map, rows of column tops only register their keys, count() doesn't need values
+        final long pAggs = aggs + (long) workerId * functions.size() * Rosti.AGG_DESCRIPTOR_SIZE;
+        int aggCount = 0;
+        for (int i = 0, n = functions.size(); i < n; i++) {
+            final VectorAggregateFunction vaf = functions.getQuick(i);
+            final int op = vaf.getKeyedAggOp();
+            if (valueAddress != 0 || op == Rosti.AGG_COUNT) {
+                Rosti.putAggDescriptor(pAggs, aggCount++, valueAddress, op, vaf.getValueOffset());
+            }
+        }
+        final long count = valueAddressSize >>> columnSizeShr;
+        if (hourKeys) {
+            return Rosti.keyedHourDenseMultiAgg(pDense, keyAddress, count, pAggs, aggCount);
+        }
+        return Rosti.keyedIntDenseMultiAgg(pDense, keyAddress, count, pAggs, aggCount);
+    }
+
+    private long getAggsSize() {
+        return (long) workerCount * functions.size() * Rosti.AGG_DESCRIPTOR_SIZE;
+    }
+}
@@ -28,6 +28,7 @@ import io.questdb.MessageBus;
 import io.questdb.cairo.AbstractRecordCursorFactory;
 import io.questdb.cairo.CairoConfiguration;
 import io.questdb.cairo.DataUnavailableException;
+import io.questdb.cairo.ZoneMapReader;
 import io.questdb.cairo.sql.Record;
 import io.questdb.cairo.sql.*;
 import io.questdb.griffin.PlanSink;
@@ -51,6 +52,8 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
     private final ObjectPool<VectorAggregateEntry> entryPool;
     private final PerWorkerLocks perWorkerLocks; // used to protect VAF's internal slots
     private final AtomicBooleanCircuitBreaker sharedCircuitBreaker;
+    // functions run per page frame, member functions of a column scanned once are replaced with ColumnStatsVectorAggregateFunction
+    private final ObjList<VectorAggregateFunction> taskList;
     private final ObjList<VectorAggregateFunction> vafList;
     private final int workerCount;
 
@@ -66,6 +69,8 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
         this.base = base;
         this.vafList = new ObjList<>(vafList.size());
         this.vafList.addAll(vafList);
+        this.taskList = new ObjList<>(vafList.size());
+        fuseColumnScans(base.getMetadata(), this.vafList, this.taskList, workerCount);
         this.cursor = new GroupByNotKeyedVectorRecordCursor(this.vafList);
         this.perWorkerLocks = new PerWorkerLocks(configuration, workerCount);
         this.sharedCircuitBreaker = new AtomicBooleanCircuitBreaker();
@@ -137,8 +142,63 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
         return reclaimed;
     }
 
+    // Functions such as min(x), max(x), sum(x) and count(x) of the same column share a single scan of the column,
+    // see ColumnStatsVectorAggregateFunction. Functions that cannot be computed from column statistics run on their own.
+    private static void fuseColumnScans(
+            RecordMetadata baseMetadata,
+            ObjList<VectorAggregateFunction> vafList,
+            ObjList<VectorAggregateFunction> taskList,
+            int workerCount
+    ) {
+        for (int i = 0, n = vafList.size(); i < n; i++) {
+            final VectorAggregateFunction vaf = vafList.getQuick(i);
+            final int columnIndex = vaf.getColumnIndex();
+            if (columnIndex < 0 || !vaf.supportsStats() || !ColumnStatsVectorAggregateFunction.isSupported(baseMetadata.getColumnType(columnIndex))) {
+                taskList.add(vaf);
+                continue;
+            }
+
+            boolean fused = false;
+            for (int j = 0; j < i; j++) {
+                final VectorAggregateFunction other = vafList.getQuick(j);
+                if (other.getColumnIndex() == columnIndex && other.supportsStats()) {
+                    // already a member of the scan of this column
+                    fused = true;
+                    break;
+                }
+            }
+            if (fused) {
+                continue;
+            }
+
+            ObjList<VectorAggregateFunction> members = null;
+            for (int j = i + 1; j < n; j++) {
+                final VectorAggregateFunction other = vafList.getQuick(j);
+                if (other.getColumnIndex() == columnIndex && other.supportsStats()) {
+                    if (members == null) {
+                        members = new ObjList<>();
+                        members.add(vaf);
+                    }
+                    members.add(other);
+                }
+            }
+
+            if (members == null) {
+                taskList.add(vaf);
+            } else {
+                taskList.add(new ColumnStatsVectorAggregateFunction(baseMetadata.getColumnType(columnIndex), columnIndex, members, workerCount));
+            }
+        }
+    }
+
     @Override
     protected void _close() {
+        for (int i = 0, n = taskList.size(); i < n; i++) {
+            final VectorAggregateFunction task = taskList.getQuick(i);
+            if (task instanceof ColumnStatsVectorAggregateFunction) {
+                task.close();
+            }
+        }
         Misc.freeObjList(vafList);
         Misc.free(base);
     }
@@ -149,7 +209,11 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
         private MessageBus bus;
         private SqlExecutionCircuitBreaker circuitBreaker;
         private int countDown = 1;
+        private int ownCount;
         private PageFrameCursor pageFrameCursor;
+        private Sequence pubSeq;
+        private RingQueue<VectorAggregateTask> queue;
+        private int queuedCount;
 
         public GroupByNotKeyedVectorRecordCursor(ObjList<? extends Function> functions) {
             this.recordA = new VirtualRecordNoRowid(functions);
@@ -201,15 +265,87 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
             countDown = 1;
         }
 
+        private void aggregate(VectorAggregateFunction vaf, long pageAddress, long pageSize, int colSizeShr, int workerId) {
+            long seq = pubSeq.next();
+            if (seq < 0) {
+                circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                // acquire the slot and DIY the func
+                // vaf need to know which column it is hitting in the frame and will need to
+                // aggregate between frames until done
+                final int slot = perWorkerLocks.acquireSlot(workerId, circuitBreaker);
+                try {
+                    vaf.aggregate(pageAddress, pageSize, colSizeShr, slot);
+                    ownCount++;
+                } finally {
+                    perWorkerLocks.releaseSlot(slot);
+                }
+            } else {
+                final VectorAggregateEntry entry = entryPool.next();
+                // null pRosti means that we do not need keyed aggregation
+                queuedCount++;
+                entry.of(
+                        vaf,
+                        null,
+                        0,
+                        pageAddress,
+                        pageSize,
+                        colSizeShr,
+                        doneLatch,
+                        null,
+                        null,
+                        null,
+                        perWorkerLocks,
+                        sharedCircuitBreaker
+                );
+                queue.get(seq).entry = entry;
+                pubSeq.done(seq);
+            }
+        }
+
+        // Rows of complete blocks summarised by the zone map are aggregated from the block statistics,
+        // only the rows before the first and after the last of these blocks are scanned.
+        private void aggregate(VectorAggregateFunction vaf, PageFrame frame, ZoneMapReader zoneMap, long pageAddress, int colSizeShr, int workerId) {
+            final int shift = zoneMap.getBlockRowsShift();
+            final long rowLo = frame.getPartitionLo() - zoneMap.getColumnTop();
+            final long rowHi = frame.getPartitionHi() - zoneMap.getColumnTop();
+            final long blockLo = (rowLo + (1L << shift) - 1) >> shift;
+            final long blockHi = Math.min(rowHi >> shift, zoneMap.getBlockCount());
+            if (rowLo < 0 || blockLo >= blockHi) {
+                aggregate(vaf, pageAddress, (rowHi - rowLo) << colSizeShr, colSizeShr, workerId);
+                return;
+            }
+
+            final long headHi = blockLo << shift;
+            if (headHi > rowLo) {
+                aggregate(vaf, pageAddress, (headHi - rowLo) << colSizeShr, colSizeShr, workerId);
+            }
+
+            circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+            final int slot = perWorkerLocks.acquireSlot(workerId, circuitBreaker);
+            try {
+                for (long block = blockLo; block < blockHi; block++) {
+                    vaf.aggregateStats(zoneMap.getEntryAddress(block), slot);
+                }
+                ownCount++;
+            } finally {
+                perWorkerLocks.releaseSlot(slot);
+            }
+
+            final long tailLo = blockHi << shift;
+            if (rowHi > tailLo) {
+                aggregate(vaf, pageAddress + ((tailLo - rowLo) << colSizeShr), (rowHi - tailLo) << colSizeShr, colSizeShr, workerId);
+            }
+        }
+
         private void buildFunctions() {
-            final int vafCount = vafList.size();
-            final RingQueue<VectorAggregateTask> queue = bus.getVectorAggregateQueue();
-            final Sequence pubSeq = bus.getVectorAggregatePubSeq();
+            final int taskCount = taskList.size();
+            queue = bus.getVectorAggregateQueue();
+            pubSeq = bus.getVectorAggregatePubSeq();
 
             sharedCircuitBreaker.reset();
             entryPool.clear();
-            int queuedCount = 0;
-            int ownCount = 0;
+            queuedCount = 0;
+            ownCount = 0;
             int reclaimed = 0;
             int total = 0;
 
@@ -228,8 +364,8 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
             try {
                 PageFrame frame;
                 while ((frame = pageFrameCursor.next()) != null) {
-                    for (int i = 0; i < vafCount; i++) {
-                        final VectorAggregateFunction vaf = vafList.getQuick(i);
+                    for (int i = 0; i < taskCount; i++) {
+                        final VectorAggregateFunction vaf = taskList.getQuick(i);
                         final int columnIndex = vaf.getColumnIndex();
                         // for functions like `count()`, that do not have arguments we are required to provide
                         // count of rows in table in a form of "pageSize >> shr". Since `vaf` doesn't provide column
@@ -243,38 +379,11 @@ public class GroupByNotKeyedVectorRecordCursorFactory extends AbstractRecordCurs
                         final long pageAddress = columnIndex > -1 ? frame.getPageAddress(columnIndex) : 0;
                         final long pageSize = columnIndex > -1 ? frame.getPageSize(columnIndex) : frame.getPageSize(0);
                         final int colSizeShr = columnIndex > -1 ? frame.getColumnShiftBits(columnIndex) : frame.getColumnShiftBits(0);
-                        long seq = pubSeq.next();
-                        if (seq < 0) {
-                            circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
-                            // acquire the slot and DIY the func
-                            // vaf need to know which column it is hitting in the frame and will need to
-                            // aggregate between frames until done
-                            final int slot = perWorkerLocks.acquireSlot(workerId, circuitBreaker);
-                            try {
-                                vaf.aggregate(pageAddress, pageSize, colSizeShr, slot);
-                                ownCount++;
-                            } finally {
-                                perWorkerLocks.releaseSlot(slot);
-                            }
+                        final ZoneMapReader zoneMap = pageAddress != 0 && vaf.supportsBlockStats() ? frame.getZoneMap(columnIndex) : null;
+                        if (zoneMap == null) {
+                            aggregate(vaf, pageAddress, pageSize, colSizeShr, workerId);
                         } else {
-                            final VectorAggregateEntry entry = entryPool.next();
-                            // null pRosti means that we do not need keyed aggregation
-                            queuedCount++;
-                            entry.of(
-                                    vaf,
-                                    null,
-                                    0,
-                                    pageAddress,
-                                    pageSize,
-                                    colSizeShr,
-                                    doneLatch,
-                                    null,
-                                    null,
-                                    perWorkerLocks,
-                                    sharedCircuitBreaker
-                            );
-                            queue.get(seq).entry = entry;
-                            pubSeq.done(seq);
+                            aggregate(vaf, frame, zoneMap, pageAddress, colSizeShr, workerId);
                         }
                         total++;
                     }
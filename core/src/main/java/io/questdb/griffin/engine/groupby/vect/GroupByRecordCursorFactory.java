@@ -28,7 +28,9 @@ import io.questdb.MessageBus;
 import io.questdb.cairo.*;
 import io.questdb.cairo.sql.Record;
 import io.questdb.cairo.sql.*;
+import io.questdb.cairo.vm.api.MemoryCR;
 import io.questdb.griffin.PlanSink;
+import io.questdb.griffin.SqlCodeGenerator;
 import io.questdb.griffin.SqlException;
 import io.questdb.griffin.SqlExecutionContext;
 import io.questdb.griffin.engine.PerWorkerLocks;
@@ -50,21 +52,48 @@ import static io.questdb.cairo.sql.DataFrameCursorFactory.ORDER_ASC;
 
 public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
 
+    // packed key of INT pair when both keys are null
+    private final static long INT_PAIR_NULL = ((long) Numbers.INT_NaN << 32) | (Numbers.INT_NaN & 0xffffffffL);
     private final static Log LOG = LogFactory.getLog(GroupByRecordCursorFactory.class);
-
+    // maps are merged on the worker pool once those merged into the biggest one hold at least that many keys
+    private final static long PARTITION_MERGE_MIN_SIZE = 64 * 1024;
+    private final static int PARTITION_MERGE_MAX_PARTITIONS = 64;
+    private final static int PARTITION_MERGE_TASKS_PER_WORKER = 4;
     private final static int ROSTI_MINIMIZED_SIZE = 16; // 16 is the minimum size usable on arm
+    private final static int SPILL_PARTITION_BITS = 4;
+    private final static int SPILL_PARTITION_COUNT = 1 << SPILL_PARTITION_BITS;
+    // partitions take 32 bits of the key hash, each level of split partitions takes SPILL_PARTITION_BITS of them
+    private final static int SPILL_SPLIT_LEVELS = 32 / SPILL_PARTITION_BITS - 1;
     private final RecordCursorFactory base;
     private final RostiRecordCursor cursor;
+    // dense accumulators per map, null when key range cannot be known, see allocDenseAccumulators()
+    private final long[] denseAccumulators;
     private final SOUnboundedCountDownLatch doneLatch = new SOUnboundedCountDownLatch();
     private final ObjectPool<VectorAggregateEntry> entryPool;
+    // pages the key is read from, addresses of data and index pages of STRING key or of both keys
+    // of INT pair, one pair per page frame, null for other keys, see keyAddress()
+    private final LongList keyAddresses;
     private final int keyColumnIndex;
+    // second key of INT pair, -1 for single key
+    private final int keyColumnIndex2;
+    private final int keyKind;
     private final AtomicInteger oomCounter = new AtomicInteger();
     private final long[] pRosti;
+    // null for single worker
+    private final RostiPartitionMerge partitionMerge;
     private final PerWorkerLocks perWorkerLocks; // used to protect pRosti and VAF's internal slots
     private final RostiAllocFacade raf;
     private final AtomicBooleanCircuitBreaker sharedCircuitBreaker; // used to signal cancellation to workers
+    private final RostiSpill spillResult; // aggregated partitions of spilled maps
+    private final long spillThreshold;
+    private final RostiSpill[] spills; // one per map, null when spilling is disabled
+    // one per level of partitions split further at merge, null when spilling is disabled
+    private final RostiSpill[] splitSpills;
+    // functions run per page frame, member functions of a column aggregated in one pass are replaced with FusedVectorAggregateFunction
+    private final ObjList<VectorAggregateFunction> taskList;
     private final ObjList<VectorAggregateFunction> vafList;
     private final int workerCount;
+    private long denseKeyCount;
 
     public GroupByRecordCursorFactory(
             CairoConfiguration configuration,
@@ -72,16 +101,19 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
             RecordMetadata metadata,
             @Transient ColumnTypes columnTypes,
             int workerCount,
+            int keyKind,
             @Transient ObjList<VectorAggregateFunction> vafList,
             int keyColumnIndexInBase,
             int keyColumnIndexInThisCursor,
+            int keyColumnIndex2InBase,
+            int keyColumnIndex2InThisCursor,
             @Transient @Nullable IntList symbolTableSkewIndex
     ) {
         super(metadata);
         this.workerCount = workerCount;
         entryPool = new ObjectPool<>(VectorAggregateEntry::new, configuration.getGroupByPoolCapacity());
         // columnTypes and functions must align in the following way:
-        // columnTypes[0] is the type of key, for now single key is supported
+        // columnTypes[0] is the type of key, pair of INT keys is a single LONG key
         // functions.size = columnTypes.size - 1, functions do not have instance for key, only for values
         // functions[0].type == columnTypes[1]
         // ...
@@ -90,7 +122,7 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         perWorkerLocks = new PerWorkerLocks(configuration, workerCount);
         sharedCircuitBreaker = new AtomicBooleanCircuitBreaker();
         this.base = base;
-        // first column is INT or SYMBOL
+        // first column is INT, SYMBOL, LONG, DATE, TIMESTAMP, UUID, STRING or LONG of packed INT pair
         pRosti = new long[workerCount];
         final int vafCount = vafList.size();
         this.vafList = new ObjList<>(vafCount);
@@ -105,7 +137,6 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
             }
             pRosti[i] = ptr;
 
-            // remember, single key for now
             switch (ColumnType.tagOf(columnTypes.getColumnType(0))) {
                 case ColumnType.INT:
                     Unsafe.getUnsafe().putInt(Rosti.getInitialValueSlot(pRosti[i], 0), Numbers.INT_NaN);
@@ -113,6 +144,21 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                 case ColumnType.SYMBOL:
                     Unsafe.getUnsafe().putInt(Rosti.getInitialValueSlot(pRosti[i], 0), SymbolTable.VALUE_IS_NULL);
                     break;
+                case ColumnType.LONG:
+                case ColumnType.DATE:
+                case ColumnType.TIMESTAMP:
+                    Unsafe.getUnsafe().putLong(
+                            Rosti.getInitialValueSlot(pRosti[i], 0),
+                            keyKind == SqlCodeGenerator.GKK_INT_PAIR ? INT_PAIR_NULL : Numbers.LONG_NaN
+                    );
+                    break;
+                case ColumnType.UUID:
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti[i], 0), Numbers.LONG_NaN);
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti[i], 0) + Long.BYTES, Numbers.LONG_NaN);
+                    break;
+                case ColumnType.STRING:
+                    // null key is set by the map
+                    break;
                 default:
             }
 
@@ -126,25 +172,75 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
             }
         }
 
+        // slots of STRING keys refer to the key heap of the map, such maps are neither split nor spilled
+        final boolean isStrKey = ColumnType.isString(columnTypes.getColumnType(0));
+        if (workerCount > 1 && !isStrKey) {
+            partitionMerge = new RostiPartitionMerge(
+                    raf,
+                    columnTypes,
+                    Math.min(Numbers.ceilPow2(workerCount) * PARTITION_MERGE_TASKS_PER_WORKER, PARTITION_MERGE_MAX_PARTITIONS),
+                    workerCount
+            );
+        } else {
+            partitionMerge = null;
+        }
+
+        spillThreshold = configuration.getGroupBySpillThreshold();
+        if (spillThreshold > 0 && !isStrKey) {
+            spills = new RostiSpill[workerCount];
+            for (int i = 0; i < workerCount; i++) {
+                spills[i] = new RostiSpill(configuration, SPILL_PARTITION_COUNT, 0);
+            }
+            splitSpills = new RostiSpill[SPILL_SPLIT_LEVELS];
+            for (int i = 0; i < SPILL_SPLIT_LEVELS; i++) {
+                splitSpills[i] = new RostiSpill(configuration, SPILL_PARTITION_COUNT, (i + 1) * SPILL_PARTITION_BITS);
+            }
+            spillResult = new RostiSpill(configuration, 1, 0);
+        } else {
+            spills = null;
+            splitSpills = null;
+            spillResult = null;
+        }
+
         // all maps are the same at this point
         // check where our keys are and pull them to front
         final long pRosti = this.pRosti[0];
         final long columnOffsets = Rosti.getValueOffsets(pRosti);
 
-        // skew logic assumes single key, for multiple keys skew would be different
-
+        // keys are in the middle, aggregates take the remaining columns in order
         final IntList columnSkewIndex = new IntList();
-        // key is in the middle, shift aggregates before the key one position left
-        addOffsets(columnSkewIndex, vafList, 0, keyColumnIndexInThisCursor, columnOffsets);
-
-        // this is offset of the key column
-        columnSkewIndex.add(0);
-
-        // add remaining aggregate columns as is
-        addOffsets(columnSkewIndex, vafList, keyColumnIndexInThisCursor, vafCount, columnOffsets);
+        for (int i = 0, k = 0, n = vafCount + (keyColumnIndex2InThisCursor > -1 ? 2 : 1); i < n; i++) {
+            if (i == keyColumnIndexInThisCursor) {
+                // first key of INT pair is the high half of the packed key
+                columnSkewIndex.add(keyColumnIndex2InThisCursor > -1 ? Integer.BYTES : 0);
+            } else if (i == keyColumnIndex2InThisCursor) {
+                columnSkewIndex.add(0);
+            } else {
+                columnSkewIndex.add(Unsafe.getUnsafe().getInt(columnOffsets + vafList.getQuick(k++).getValueOffset() * 4L));
+            }
+        }
 
         this.vafList.addAll(vafList);
+        this.keyKind = keyKind;
+        // keys of hour(ts) and symbol columns have a known range, dense accumulator serves fusable functions only
+        if (
+                configuration.isGroupByDenseKeysEnabled()
+                        && (keyKind == SqlCodeGenerator.GKK_HOUR_INT || ColumnType.isSymbol(columnTypes.getColumnType(0)))
+                        && isFusable(vafList)
+        ) {
+            denseAccumulators = new long[workerCount];
+        } else {
+            denseAccumulators = null;
+        }
+        taskList = new ObjList<>(vafCount);
+        if (configuration.isGroupByFusedAggregatesEnabled() || denseAccumulators != null) {
+            fuseKeyedAggregates(keyKind, this.vafList, taskList, workerCount, configuration.isGroupByFusedAggregatesEnabled(), denseAccumulators);
+        } else {
+            taskList.addAll(vafList);
+        }
         keyColumnIndex = keyColumnIndexInBase;
+        keyColumnIndex2 = keyColumnIndex2InBase;
+        keyAddresses = isStrKey || keyColumnIndex2 > -1 ? new LongList() : null;
         if (symbolTableSkewIndex != null && symbolTableSkewIndex.size() > 0) {
             final IntList symbolSkew = new IntList(symbolTableSkewIndex.size());
             symbolSkew.addAll(symbolTableSkewIndex);
@@ -166,6 +262,8 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         for (int i = 0, n = pRosti.length; i < n; i++) {
             raf.clear(pRosti[i]);
         }
+        clearPartitionMerge();
+        clearSpills();
         // clear state of aggregate functions
         for (int i = 0, n = vafList.size(); i < n; i++) {
             vafList.getQuick(i).clear();
@@ -184,7 +282,11 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         sink.type("GroupBy");
         sink.meta("vectorized").val(true);
         sink.meta("workers").val(workerCount);
-        sink.attr("keys").val("[").putBaseColumnNameNoRemap(keyColumnIndex).val("]");
+        sink.attr("keys").val("[").putBaseColumnNameNoRemap(keyColumnIndex);
+        if (keyColumnIndex2 > -1) {
+            sink.val(",").putBaseColumnNameNoRemap(keyColumnIndex2);
+        }
+        sink.val("]");
         sink.optAttr("values", vafList, true);
         sink.child(base);
     }
@@ -199,19 +301,172 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         return base.usesIndex();
     }
 
-    private static void addOffsets(
-            IntList columnSkewIndex,
-            @Transient ObjList<VectorAggregateFunction> vafList,
-            int start,
-            int end,
-            long columnOffsets
+    // Functions such as min(x), max(x), sum(x) and count(x) of the same column are aggregated
+    // in a single pass over the keys, see FusedVectorAggregateFunction. When keys are dense,
+    // all functions run fused, so that no key of the dense range reaches the map before export.
+    private static void fuseKeyedAggregates(
+            int keyKind,
+            ObjList<VectorAggregateFunction> vafList,
+            ObjList<VectorAggregateFunction> taskList,
+            int workerCount,
+            boolean fuseColumns,
+            long[] denseAccumulators
     ) {
-        for (int i = start; i < end; i++) {
-            columnSkewIndex.add(Unsafe.getUnsafe().getInt(columnOffsets + vafList.getQuick(i).getValueOffset() * 4L));
+        for (int i = 0, n = vafList.size(); i < n; i++) {
+            final VectorAggregateFunction vaf = vafList.getQuick(i);
+            final int columnIndex = vaf.getColumnIndex();
+            if (vaf.getKeyedAggOp() < 0) {
+                taskList.add(vaf);
+                continue;
+            }
+
+            ObjList<VectorAggregateFunction> members = null;
+            if (fuseColumns && columnIndex > -1) {
+                boolean fused = false;
+                for (int j = 0; j < i; j++) {
+                    final VectorAggregateFunction other = vafList.getQuick(j);
+                    if (other.getColumnIndex() == columnIndex && other.getKeyedAggOp() > -1) {
+                        // already a member of the pass over this column
+                        fused = true;
+                        break;
+                    }
+                }
+                if (fused) {
+                    continue;
+                }
+
+                for (int j = i + 1; j < n; j++) {
+                    final VectorAggregateFunction other = vafList.getQuick(j);
+                    if (other.getColumnIndex() == columnIndex && other.getKeyedAggOp() > -1) {
+                        if (members == null) {
+                            members = new ObjList<>();
+                            members.add(vaf);
+                        }
+                        members.add(other);
+                    }
+                }
+            }
+
+            if (members == null && denseAccumulators != null) {
+                members = new ObjList<>();
+                members.add(vaf);
+            }
+
+            if (members == null) {
+                taskList.add(vaf);
+            } else {
+                taskList.add(new FusedVectorAggregateFunction(keyKind, columnIndex, members, workerCount, denseAccumulators));
+            }
         }
     }
 
+    private static boolean isFusable(ObjList<VectorAggregateFunction> vafList) {
+        for (int i = 0, n = vafList.size(); i < n; i++) {
+            if (vafList.getQuick(i).getKeyedAggOp() < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Dense accumulators are used only when maps are empty, e.g. not after the build resumed on
+    // DataUnavailableException, since exported keys must not be in the map.
+    private void allocDenseAccumulators(PageFrameCursor pageFrameCursor) {
+        if (denseAccumulators == null || hasSpilledMaps()) {
+            return;
+        }
+        for (int i = 0, n = pRosti.length; i < n; i++) {
+            if (raf.getSize(pRosti[i]) > 0) {
+                return;
+            }
+        }
+
+        if (keyKind == SqlCodeGenerator.GKK_HOUR_INT) {
+            denseKeyCount = 24;
+        } else {
+            final SymbolTable symbolTable = pageFrameCursor.getSymbolTable(keyColumnIndex);
+            denseKeyCount = symbolTable instanceof StaticSymbolTable ? ((StaticSymbolTable) symbolTable).getSymbolCount() : 0;
+        }
+        if (denseKeyCount < 1 || denseKeyCount > Rosti.DENSE_MAX_KEY_COUNT) {
+            return;
+        }
+
+        for (int i = 0, n = pRosti.length; i < n; i++) {
+            final long pDense = Rosti.allocDense(pRosti[i], 0, denseKeyCount);
+            if (pDense == 0) {
+                // not enough memory, keys go to the map
+                freeDenseAccumulators();
+                return;
+            }
+            denseAccumulators[i] = pDense;
+        }
+    }
+
+    private void clearSpills() {
+        if (spills != null) {
+            for (int i = 0, n = spills.length; i < n; i++) {
+                spills[i].clear();
+            }
+            for (int i = 0, n = splitSpills.length; i < n; i++) {
+                splitSpills[i].clear();
+            }
+            spillResult.clear();
+        }
+    }
+
+    // memory of a map holding keyCount keys, map grows once it is 7/8 full
+    private static long estimateMapMemory(long keyCount, long slotSize) {
+        return Numbers.ceilPow2(keyCount + (keyCount >> 3) + 1) * (slotSize + 1);
+    }
+
+    // keys of dense accumulators go to the maps before the maps are merged
+    private boolean exportDenseAccumulators() {
+        boolean ok = true;
+        if (denseAccumulators != null) {
+            for (int i = 0, n = denseAccumulators.length; i < n; i++) {
+                final long pDense = denseAccumulators[i];
+                if (pDense != 0) {
+                    final long oldSize = Rosti.getAllocMemory(pRosti[i]);
+                    ok &= Rosti.exportDense(pDense);
+                    raf.updateMemoryUsage(pRosti[i], oldSize);
+                }
+            }
+            freeDenseAccumulators();
+        }
+        return ok;
+    }
+
+    private void freeDenseAccumulators() {
+        if (denseAccumulators != null) {
+            for (int i = 0, n = denseAccumulators.length; i < n; i++) {
+                if (denseAccumulators[i] != 0) {
+                    Rosti.freeDense(pRosti[i], denseAccumulators[i], denseKeyCount);
+                    denseAccumulators[i] = 0;
+                }
+            }
+        }
+    }
+
+    private void clearPartitionMerge() {
+        if (partitionMerge != null) {
+            partitionMerge.clear();
+        }
+    }
+
+    private boolean hasSpilledMaps() {
+        if (spills != null) {
+            for (int i = 0, n = spills.length; i < n; i++) {
+                if (!spills[i].isEmpty()) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     private void resetRostiMemorySize() {
+        clearPartitionMerge();
+        clearSpills();
         for (int i = 0, n = pRosti.length; i < n; i++) {
             if (!raf.reset(pRosti[i], ROSTI_MINIMIZED_SIZE)) {
                 LOG.debug().$("Couldn't minimize rosti memory [i=").$(i).$(",current_size=").$(Rosti.getSize(pRosti[i])).I$();
@@ -219,13 +474,53 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         }
     }
 
+    // STRING key and INT pair keys are passed to the map as an address of two page addresses of the frame,
+    // data and index pages of STRING or pages of both INT keys. Tasks of earlier frames can still be queued,
+    // so every frame of the cursor gets its own pair
+    private long keyAddress(PageFrame frame, int frameIndex) {
+        final long address0 = frame.getPageAddress(keyColumnIndex);
+        final long address1 = keyColumnIndex2 > -1 ? frame.getPageAddress(keyColumnIndex2) : frame.getIndexPageAddress(keyColumnIndex);
+        if (address0 == 0 && (keyColumnIndex2 < 0 || address1 == 0)) {
+            // column top, keys are null
+            return 0;
+        }
+        final long pair;
+        if (frameIndex < keyAddresses.size()) {
+            pair = keyAddresses.getQuick(frameIndex);
+        } else {
+            pair = Unsafe.malloc(2 * Long.BYTES, MemoryTag.NATIVE_FUNC_RSS);
+            keyAddresses.add(pair);
+        }
+        Unsafe.getUnsafe().putLong(pair, address0);
+        Unsafe.getUnsafe().putLong(pair + Long.BYTES, address1);
+        return pair;
+    }
+
     @Override
     protected void _close() {
         Misc.free(base);
+        freeDenseAccumulators();
+        for (int i = 0, n = taskList.size(); i < n; i++) {
+            final VectorAggregateFunction task = taskList.getQuick(i);
+            if (task instanceof FusedVectorAggregateFunction) {
+                task.close();
+            }
+        }
         Misc.freeObjList(vafList);
+        Misc.free(partitionMerge);
+        // spill runs refer to map structure, they go first
+        Misc.free(spills);
+        Misc.free(splitSpills);
+        Misc.free(spillResult);
         for (int i = 0, n = pRosti.length; i < n; i++) {
             raf.free(pRosti[i]);
         }
+        if (keyAddresses != null) {
+            for (int i = 0, n = keyAddresses.size(); i < n; i++) {
+                Unsafe.free(keyAddresses.getQuick(i), 2 * Long.BYTES, MemoryTag.NATIVE_FUNC_RSS);
+            }
+            keyAddresses.clear();
+        }
     }
 
     private class RostiRecordCursor implements RecordCursor {
@@ -237,9 +532,15 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         private long count;
         private long ctrl;
         private long ctrlStart;
+        private boolean isPartitioned;
         private boolean isRostiBuilt;
+        private boolean isSpilled;
+        private long keyHeap;
         private long pRostiBig;
         private PageFrameCursor pageFrameCursor;
+        private int partitionIndex;
+        // keys left in the map of the current partition, or in the only map when not partitioned
+        private long partitionRemaining;
         private RostiRecord recordB;
         private long shift;
         private long size;
@@ -268,6 +569,16 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
         @Override
         public void close() {
             Misc.free(pageFrameCursor);
+            if (isPartitioned) {
+                clearPartitionMerge();
+                isPartitioned = false;
+            }
+            if (isSpilled) {
+                // pRostiBig is a run of spilled result
+                clearSpills();
+                pRostiBig = pRosti[0];
+                isSpilled = false;
+            }
             raf.reset(pRostiBig, ROSTI_MINIMIZED_SIZE);
         }
 
@@ -296,12 +607,17 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                 isRostiBuilt = true;
             }
             while (count < size) {
+                if (partitionRemaining == 0) {
+                    openPartition(++partitionIndex);
+                    continue;
+                }
                 byte b = Unsafe.getUnsafe().getByte(ctrl);
                 if ((b & 0x80) != 0) {
                     ctrl++;
                     continue;
                 }
                 count++;
+                partitionRemaining--;
                 record.of(slots + ((ctrl - ctrlStart) << shift));
                 ctrl++;
                 return true;
@@ -319,6 +635,13 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
             this.bus = bus;
             this.circuitBreaker = circuitBreaker;
             isRostiBuilt = false;
+            // partition maps were cleared by getCursor()
+            isPartitioned = false;
+            if (isSpilled) {
+                // cursor is reopened without close(), run of the spilled result went with the spills
+                pRostiBig = pRosti[0];
+                isSpilled = false;
+            }
             return this;
         }
 
@@ -334,15 +657,27 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
 
         @Override
         public void toTop() {
-            ctrl = ctrlStart = Rosti.getCtrl(pRostiBig);
-            slots = Rosti.getSlots(pRostiBig);
-            size = raf.getSize(pRostiBig);
-            shift = Rosti.getSlotShift(pRostiBig);
+            if (isPartitioned) {
+                size = 0;
+                for (int i = 0, n = partitionMerge.getPartitionCount(); i < n; i++) {
+                    size += raf.getSize(partitionMerge.getPartition(i));
+                }
+                openPartition(partitionIndex = 0);
+            } else {
+                ctrl = ctrlStart = Rosti.getCtrl(pRostiBig);
+                slots = Rosti.getSlots(pRostiBig);
+                size = raf.getSize(pRostiBig);
+                shift = Rosti.getSlotShift(pRostiBig);
+                // heap of STRING keys doesn't move once the map is built
+                keyHeap = keyKind == SqlCodeGenerator.GKK_STR ? Rosti.getKeyHeap(pRostiBig) : 0;
+                partitionRemaining = size;
+            }
             count = 0;
         }
 
         private void buildRosti() {
             final int vafCount = vafList.size();
+            final int taskCount = taskList.size();
             final RingQueue<VectorAggregateTask> queue = bus.getVectorAggregateQueue();
             final MPSequence pubSeq = bus.getVectorAggregatePubSeq();
 
@@ -354,6 +689,7 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
             int total = 0;
 
             doneLatch.reset();
+            allocDenseAccumulators(pageFrameCursor);
 
             final Thread thread = Thread.currentThread();
             final int workerId;
@@ -367,26 +703,31 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
 
             try {
                 PageFrame frame;
+                int frameIndex = 0;
                 while ((frame = pageFrameCursor.next()) != null) {
-                    final long keyAddress = frame.getPageAddress(keyColumnIndex);
-                    for (int i = 0; i < vafCount; i++) {
-                        final VectorAggregateFunction vaf = vafList.getQuick(i);
+                    final long keyAddress = keyAddresses != null ? keyAddress(frame, frameIndex++) : frame.getPageAddress(keyColumnIndex);
+                    for (int i = 0; i < taskCount; i++) {
+                        final VectorAggregateFunction vaf = taskList.getQuick(i);
                         // when column index = -1 we assume that vector function does not have value
                         // argument, and it can only derive count via memory size
                         final int columnIndex = vaf.getColumnIndex();
                         // for functions like `count()`, that do not have arguments we are required to provide
                         // count of rows in table in a form of "pageSize >> shr". Since `vaf` doesn't provide column
-                        // this code used column 0. Assumption here that column 0 is fixed size.
-                        // This assumption only holds because our aggressive algorithm for "top down columns", e.g.
-                        // the algorithm that forces page frame to provide only columns required by the select. At the time
-                        // of writing this code there is no way to return variable length column out of non-keyed aggregation
-                        // query. This might change if we introduce something like `first(string)`. When this happens we will
-                        // need to rethink our way of computing size for the count. This would be either type checking column
-                        // 0 and working out size differently or finding any fixed-size column and using that.
+                        // this code used column 0. "Top down columns" make page frame provide only columns required by
+                        // the select, so column 0 is either a value column or the key. The only variable length column
+                        // here is STRING key, for that the count is derived from row count of the frame.
                         final long valueAddress = columnIndex > -1 ? frame.getPageAddress(columnIndex) : 0;
                         final int pageColIndex = columnIndex > -1 ? columnIndex : 0;
-                        final int columnSizeShr = frame.getColumnShiftBits(pageColIndex);
-                        final long valueAddressSize = frame.getPageSize(pageColIndex);
+                        final int columnSizeShr;
+                        final long valueAddressSize;
+                        if (frame.getColumnShiftBits(pageColIndex) > -1) {
+                            columnSizeShr = frame.getColumnShiftBits(pageColIndex);
+                            valueAddressSize = frame.getPageSize(pageColIndex);
+                        } else {
+                            // column 0 is STRING key, count of rows is taken from the frame
+                            columnSizeShr = 3;
+                            valueAddressSize = (frame.getPartitionHi() - frame.getPartitionLo()) << columnSizeShr;
+                        }
 
                         long cursor = pubSeq.next();
                         if (cursor < 0) {
@@ -402,6 +743,9 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                                         oomCounter.incrementAndGet();
                                     }
                                     raf.updateMemoryUsage(pRosti[slot], oldSize);
+                                    if (spills != null) {
+                                        spills[slot].spillIfOverThreshold(pRosti[slot], raf);
+                                    }
                                 }
                                 ownCount++;
                             } finally {
@@ -421,6 +765,7 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                                         doneLatch,
                                         oomCounter,
                                         null,
+                                        null,
                                         perWorkerLocks,
                                         sharedCircuitBreaker
                                 );
@@ -435,6 +780,7 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                                         doneLatch,
                                         oomCounter,
                                         raf,
+                                        spills,
                                         perWorkerLocks,
                                         sharedCircuitBreaker
                                 );
@@ -470,6 +816,9 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                         circuitBreaker,
                         sharedCircuitBreaker
                 );
+                if (!exportDenseAccumulators()) {
+                    oomCounter.incrementAndGet();
+                }
                 // we can't reallocate rosti until tasks are complete because some other thread could be using it
                 if (sharedCircuitBreaker.checkIfTripped()) {
                     resetRostiMemorySize();
@@ -481,85 +830,264 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                 throw new OutOfMemoryError();
             }
 
-            // merge maps only when cursor was fetched successfully
-            // otherwise assume error and save CPU cycles
-            pRostiBig = pRosti[0];
-            try {
-                if (pRosti.length > 1) {
-                    LOG.debug().$("merging").$();
-
-                    // due to uneven load distribution some rostis could be much bigger and some empty
-                    long size = raf.getSize(pRostiBig);
-                    for (int i = 1, n = pRosti.length; i < n; i++) {
-                        long curSize = raf.getSize(pRosti[i]);
-                        if (curSize > size) {
-                            size = curSize;
-                            pRostiBig = pRosti[i];
+            if (hasSpilledMaps()) {
+                mergeSpilled(vafCount);
+            } else {
+                // merge maps only when cursor was fetched successfully
+                // otherwise assume error and save CPU cycles
+                pRostiBig = pRosti[0];
+                try {
+                    if (pRosti.length > 1) {
+                        LOG.debug().$("merging").$();
+
+                        // due to uneven load distribution some rostis could be much bigger and some empty
+                        long size = raf.getSize(pRostiBig);
+                        long totalSize = size;
+                        for (int i = 1, n = pRosti.length; i < n; i++) {
+                            long curSize = raf.getSize(pRosti[i]);
+                            totalSize += curSize;
+                            if (curSize > size) {
+                                size = curSize;
+                                pRostiBig = pRosti[i];
+                            }
                         }
-                    }
 
-                    for (int j = 0; j < vafCount; j++) {
-                        final VectorAggregateFunction vaf = vafList.getQuick(j);
-                        for (int i = 0, n = pRosti.length; i < n; i++) {
-                            if (pRostiBig == pRosti[i] || raf.getSize(pRosti[i]) < 1) {
-                                continue;
+                        if (partitionMerge != null && totalSize - size >= PARTITION_MERGE_MIN_SIZE) {
+                            LOG.debug().$("merging partitions [keys=").$(totalSize).I$();
+                            mergePartitioned(queue, pubSeq, workerId);
+                        } else {
+                            for (int j = 0; j < vafCount; j++) {
+                                final VectorAggregateFunction vaf = vafList.getQuick(j);
+                                for (int i = 0, n = pRosti.length; i < n; i++) {
+                                    if (pRostiBig == pRosti[i] || raf.getSize(pRosti[i]) < 1) {
+                                        continue;
+                                    }
+                                    circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                                    long oldSize = Rosti.getAllocMemory(pRostiBig);
+                                    if (!vaf.merge(pRostiBig, pRosti[i])) {
+                                        resetRostiMemorySize();
+                                        throw new OutOfMemoryError();
+                                    }
+                                    raf.updateMemoryUsage(pRostiBig, oldSize);
+                                }
+
+                                circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+
+                                // some wrapUp() methods can increase rosti size
+                                long oldSize = Rosti.getAllocMemory(pRostiBig);
+                                if (!vaf.wrapUp(pRostiBig)) {
+                                    resetRostiMemorySize();
+                                    throw new OutOfMemoryError();
+                                }
+                                raf.updateMemoryUsage(pRostiBig, oldSize);
                             }
                             circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
-                            long oldSize = Rosti.getAllocMemory(pRostiBig);
-                            if (!vaf.merge(pRostiBig, pRosti[i])) {
+                            for (int i = 0, n = pRosti.length; i < n; i++) {
+                                if (pRostiBig == pRosti[i]) {
+                                    continue;
+                                }
+
+                                if (!raf.reset(pRosti[i], ROSTI_MINIMIZED_SIZE)) {
+                                    LOG.debug().$("couldn't minimize rosti memory [i=").$(i).$(",currentSize=").$(Rosti.getSize(pRosti[i])).I$();
+                                }
+                            }
+                        }
+                    } else {
+                        circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                        for (int j = 0; j < vafCount; j++) {
+                            if (!vafList.getQuick(j).wrapUp(pRostiBig)) {
                                 resetRostiMemorySize();
                                 throw new OutOfMemoryError();
                             }
-                            raf.updateMemoryUsage(pRostiBig, oldSize);
                         }
+                    }
+                } catch (Throwable t) {
+                    resetRostiMemorySize();
+                    isPartitioned = false;
+                    throw t;
+                }
 
-                        circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                // cursor walks map slots directly, they must all be in one arena
+                Rosti.completeResize(pRostiBig);
+            }
+            toTop();
 
-                        // some wrapUp() methods can increase rosti size
-                        long oldSize = Rosti.getAllocMemory(pRostiBig);
-                        if (!vaf.wrapUp(pRostiBig)) {
-                            resetRostiMemorySize();
-                            throw new OutOfMemoryError();
-                        }
-                        raf.updateMemoryUsage(pRostiBig, oldSize);
-                    }
-                    circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
-                    for (int i = 0, n = pRosti.length; i < n; i++) {
-                        if (pRostiBig == pRosti[i]) {
-                            continue;
-                        }
+            LOG.info().$("done [total=").$(total)
+                    .$(", ownCount=").$(ownCount)
+                    .$(", reclaimed=").$(reclaimed)
+                    .$(", queuedCount=").$(queuedCount).I$();
+        }
+
+        // Maps are split by key partition, a task per map, then partitions are merged and wrapped up, a task
+        // per partition, see RostiPartitionMerge. Cursor iterates partition maps in place of the biggest map.
+        private void mergePartitioned(RingQueue<VectorAggregateTask> queue, MPSequence pubSeq, int workerId) {
+            isPartitioned = true;
+            partitionMerge.of(pRosti, vafList);
+            runPartitionMergeTasks(queue, pubSeq, workerId);
+            partitionMerge.startMerge();
+            runPartitionMergeTasks(queue, pubSeq, workerId);
+        }
+
+        private void openPartition(int partitionIndex) {
+            final long pPartition = partitionMerge.getPartition(partitionIndex);
+            ctrl = ctrlStart = Rosti.getCtrl(pPartition);
+            slots = Rosti.getSlots(pPartition);
+            shift = Rosti.getSlotShift(pPartition);
+            partitionRemaining = raf.getSize(pPartition);
+        }
 
-                        if (!raf.reset(pRosti[i], ROSTI_MINIMIZED_SIZE)) {
-                            LOG.debug().$("couldn't minimize rosti memory [i=").$(i).$(",currentSize=").$(Rosti.getSize(pRosti[i])).I$();
+        // Tasks of the current phase of partition merge go to the queue, those that do not fit run on this thread.
+        private void runPartitionMergeTasks(RingQueue<VectorAggregateTask> queue, MPSequence pubSeq, int workerId) {
+            entryPool.clear();
+            doneLatch.reset();
+            int queuedCount = 0;
+            try {
+                for (int i = 0, n = partitionMerge.getTaskCount(); i < n; i++) {
+                    final long cursor = pubSeq.next();
+                    if (cursor < 0) {
+                        circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                        if (!partitionMerge.run(i)) {
+                            oomCounter.incrementAndGet();
                         }
+                    } else {
+                        final VectorAggregateEntry entry = entryPool.next();
+                        entry.of(partitionMerge, i, doneLatch, oomCounter, sharedCircuitBreaker);
+                        queue.get(cursor).entry = entry;
+                        pubSeq.done(cursor);
+                        queuedCount++;
                     }
-                } else {
-                    circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
-                    for (int j = 0; j < vafCount; j++) {
-                        if (!vafList.getQuick(j).wrapUp(pRostiBig)) {
-                            resetRostiMemorySize();
-                            throw new OutOfMemoryError();
-                        }
+                }
+            } catch (Throwable e) {
+                sharedCircuitBreaker.cancel();
+                throw e;
+            } finally {
+                // maps cannot be reset while tasks are in flight
+                GroupByNotKeyedVectorRecordCursorFactory.getRunWhatsLeft(
+                        bus.getVectorAggregateSubSeq(),
+                        queue,
+                        queuedCount,
+                        0,
+                        workerId,
+                        doneLatch,
+                        circuitBreaker,
+                        sharedCircuitBreaker
+                );
+            }
+
+            if (oomCounter.get() > 0) {
+                throw new OutOfMemoryError();
+            }
+            circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+        }
+
+        private void mergeSpilled(int vafCount) {
+            isSpilled = true;
+            final long pRostiMerge = pRosti[0];
+            try {
+                // the rest of the keys is spilled too, so that every partition is aggregated from disk alone
+                for (int i = 0, n = pRosti.length; i < n; i++) {
+                    spills[i].spill(pRosti[i], false);
+                    if (!raf.reset(pRosti[i], ROSTI_MINIMIZED_SIZE)) {
+                        raf.clear(pRosti[i]);
                     }
                 }
+
+                LOG.debug().$("merging spilled maps").$();
+                mergePartitions(spills, 0, spills.length, 0, true, Long.MAX_VALUE, vafCount);
+
+                for (int i = 0, n = spills.length; i < n; i++) {
+                    spills[i].clear();
+                }
+                if (!raf.reset(pRostiMerge, ROSTI_MINIMIZED_SIZE)) {
+                    raf.clear(pRostiMerge);
+                }
+                final long pRun = spillResult.openRun(0, pRostiMerge);
+                // empty result is served by the empty map
+                pRostiBig = pRun != 0 ? pRun : pRostiMerge;
             } catch (Throwable t) {
                 resetRostiMemorySize();
+                isSpilled = false;
+                pRostiBig = pRostiMerge;
                 throw t;
             }
+        }
 
-            toTop();
+        // Merges partitions of sources[lo, hi) one at a time and appends them to the result spill. Partition
+        // whose slots could hold more keys than fit in the spill threshold is split by the next hash bits
+        // and its parts are merged the same way, unless the previous split left all of its slots together,
+        // as duplicates of few keys do. Null key values are added to every partition on wrap up, they are
+        // kept only in the partition the null key hashes to.
+        private void mergePartitions(RostiSpill[] sources, int lo, int hi, int level, boolean ownsNullKey, long parentSlotCount, int vafCount) {
+            final long pRostiMerge = pRosti[0];
+            final long slotSize = Rosti.getSlotSize(pRostiMerge);
+            final int nullKeyPartition = sources[lo].getNullKeyPartition(pRostiMerge);
+            for (int p = 0; p < SPILL_PARTITION_COUNT; p++) {
+                long slotCount = 0;
+                for (int i = lo; i < hi; i++) {
+                    slotCount += sources[i].getPartitionSize(p) / slotSize;
+                }
+                final boolean partitionOwnsNullKey = ownsNullKey && p == nullKeyPartition;
+
+                if (level < SPILL_SPLIT_LEVELS
+                        && slotCount > 1
+                        && slotCount < parentSlotCount
+                        && estimateMapMemory(slotCount, slotSize) > spillThreshold) {
+                    final RostiSpill split = splitSpills[level];
+                    for (int i = lo; i < hi; i++) {
+                        circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                        final long pRun = sources[i].openRun(p, pRostiMerge);
+                        if (pRun != 0) {
+                            split.spill(pRun, false);
+                            sources[i].closeRun();
+                        }
+                    }
+                    LOG.debug().$("split spilled partition [level=").$(level).$(", partition=").$(p).$(", slots=").$(slotCount).I$();
+                    mergePartitions(splitSpills, level, level + 1, level + 1, partitionOwnsNullKey, slotCount, vafCount);
+                    split.clear();
+                    continue;
+                }
 
-            LOG.info().$("done [total=").$(total)
-                    .$(", ownCount=").$(ownCount)
-                    .$(", reclaimed=").$(reclaimed)
-                    .$(", queuedCount=").$(queuedCount).I$();
+                raf.clear(pRostiMerge);
+                for (int i = lo; i < hi; i++) {
+                    final long pRun = sources[i].openRun(p, pRostiMerge);
+                    if (pRun == 0) {
+                        continue;
+                    }
+                    for (int j = 0; j < vafCount; j++) {
+                        circuitBreaker.statefulThrowExceptionIfTrippedNoThrottle();
+                        long oldSize = Rosti.getAllocMemory(pRostiMerge);
+                        if (!vafList.getQuick(j).merge(pRostiMerge, pRun)) {
+                            throw new OutOfMemoryError();
+                        }
+                        raf.updateMemoryUsage(pRostiMerge, oldSize);
+                    }
+                    sources[i].closeRun();
+                }
+
+                for (int j = 0; j < vafCount; j++) {
+                    long oldSize = Rosti.getAllocMemory(pRostiMerge);
+                    if (!vafList.getQuick(j).wrapUp(pRostiMerge)) {
+                        throw new OutOfMemoryError();
+                    }
+                    raf.updateMemoryUsage(pRostiMerge, oldSize);
+                }
+                spillResult.spill(pRostiMerge, !partitionOwnsNullKey);
+            }
         }
 
         private class RostiRecord implements Record {
             private final Long256Impl long256A = new Long256Impl();
             private final Long256Impl long256B = new Long256Impl();
+            private final MemoryCR.CharSequenceView strViewA = new MemoryCR.CharSequenceView();
+            private final MemoryCR.CharSequenceView strViewB = new MemoryCR.CharSequenceView();
             private long pRow;
 
+            @Override
+            public char getChar(int col) {
+                // char aggregates keep long slots, null (0) is in the low bits of LONG_NaN too
+                return (char) Unsafe.getUnsafe().getInt(getValueOffset(col));
+            }
+
             @Override
             public long getDate(int col) {
                 return getLong(col);
@@ -572,7 +1100,8 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
 
             @Override
             public float getFloat(int col) {
-                return 0;
+                // float aggregates keep double slots
+                return (float) getDouble(col);
             }
 
             @Override
@@ -610,6 +1139,16 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                 return Unsafe.getUnsafe().getLong(getValueOffset(col));
             }
 
+            @Override
+            public long getLong128Hi(int col) {
+                return Unsafe.getUnsafe().getLong(getValueOffset(col) + Long.BYTES);
+            }
+
+            @Override
+            public long getLong128Lo(int col) {
+                return Unsafe.getUnsafe().getLong(getValueOffset(col));
+            }
+
             @Override
             public void getLong256(int col, CharSink<?> sink) {
                 Long256Impl v = (Long256Impl) getLong256A(col);
@@ -648,21 +1187,23 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
 
             @Override
             public CharSequence getStr(int col) {
-                return null;
+                return getStr(col, strViewA);
             }
 
             @Override
             public void getStr(int col, Utf16Sink sink) {
+                sink.put(getStr(col, strViewA));
             }
 
             @Override
             public CharSequence getStrB(int col) {
-                return null;
+                return getStr(col, strViewB);
             }
 
             @Override
             public int getStrLen(int col) {
-                return 0;
+                // STRING key slot is hash (long), length in chars (int) and offset of the chars in the key heap (int)
+                return Unsafe.getUnsafe().getInt(getValueOffset(col) + Long.BYTES);
             }
 
             @Override
@@ -684,6 +1225,16 @@ public class GroupByRecordCursorFactory extends AbstractRecordCursorFactory {
                 this.pRow = pRow;
             }
 
+            private CharSequence getStr(int col, MemoryCR.CharSequenceView view) {
+                final int len = getStrLen(col);
+                if (len < 0) {
+                    return null;
+                }
+                // offset is in 4-byte words
+                final long offset = Integer.toUnsignedLong(Unsafe.getUnsafe().getInt(getValueOffset(col) + Long.BYTES + Integer.BYTES)) << 2;
+                return view.of(keyHeap + offset, len);
+            }
+
             private long getValueOffset(int column) {
                 return pRow + columnSkewIndex.getQuick(column);
             }
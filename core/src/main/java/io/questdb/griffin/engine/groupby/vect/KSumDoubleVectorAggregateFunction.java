@@ -36,6 +36,10 @@ import io.questdb.std.Vect;
 import java.util.Arrays;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class KSumDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
     private static final int COUNT_PADDING = Misc.CACHE_LINE_SIZE / Long.BYTES;
@@ -44,6 +48,7 @@ public class KSumDoubleVectorAggregateFunction extends DoubleFunction implements
     private final int columnIndex;
     private final long[] count;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final double[] sum;
     private final int workerCount;
@@ -54,9 +59,22 @@ public class KSumDoubleVectorAggregateFunction extends DoubleFunction implements
         this.sum = new double[workerCount * SUM_PADDING];
         this.count = new long[workerCount * COUNT_PADDING];
         this.workerCount = workerCount;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourKSumDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.keyValueFunc = Rosti::keyedIntPairKSumDouble;
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+        } else if (keyKind == GKK_LONG) {
+            this.keyValueFunc = Rosti::keyedLongKSumDouble;
+            this.distinctFunc = Rosti::keyedLongDistinct;
+        } else if (keyKind == GKK_LONG128) {
+            this.keyValueFunc = Rosti::keyedLong128KSumDouble;
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+        } else if (keyKind == GKK_STR) {
+            this.keyValueFunc = Rosti::keyedStrKSumDouble;
+            this.distinctFunc = Rosti::keyedStrDistinct;
         } else {
             this.keyValueFunc = Rosti::keyedIntKSumDouble;
             this.distinctFunc = Rosti::keyedIntDistinct;
@@ -100,6 +118,11 @@ public class KSumDoubleVectorAggregateFunction extends DoubleFunction implements
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_KSUM_DOUBLE;
+    }
+
     @Override
     public double getDouble(Record rec) {
         double sum = 0;
@@ -134,7 +157,17 @@ public class KSumDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntKSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongKSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128KSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrKSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntKSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -157,6 +190,16 @@ public class KSumDoubleVectorAggregateFunction extends DoubleFunction implements
             sum = t;
             count += this.count[i * COUNT_PADDING];
         }
-        return Rosti.keyedIntKSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongKSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+            case GKK_LONG128:
+                return Rosti.keyedLong128KSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+            case GKK_STR:
+                return Rosti.keyedStrKSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+            default:
+                return Rosti.keyedIntKSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+        }
     }
 }
@@ -36,12 +36,17 @@ import java.util.concurrent.atomic.DoubleAccumulator;
 import java.util.function.DoubleBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MaxDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
 
     public static final DoubleBinaryOperator MAX = Math::max;
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final DoubleAccumulator max = new DoubleAccumulator(
             MAX, Double.NEGATIVE_INFINITY
@@ -50,9 +55,22 @@ public class MaxDoubleVectorAggregateFunction extends DoubleFunction implements
 
     public MaxDoubleVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMaxDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMaxDouble;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMaxDouble;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MaxDouble;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMaxDouble;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMaxDouble;
@@ -78,6 +96,14 @@ public class MaxDoubleVectorAggregateFunction extends DoubleFunction implements
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final double value = Unsafe.getUnsafe().getDouble(pStats + STATS_MAX_OFFSET);
+        if (value == value) {
+            max.accumulate(value);
+        }
+    }
+
     @Override
     public void clear() {
         max.reset();
@@ -88,6 +114,11 @@ public class MaxDoubleVectorAggregateFunction extends DoubleFunction implements
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MAX_DOUBLE;
+    }
+
     @Override
     public double getDouble(Record rec) {
         final double value = max.get();
@@ -111,7 +142,17 @@ public class MaxDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -120,8 +161,23 @@ public class MaxDoubleVectorAggregateFunction extends DoubleFunction implements
         types.add(ColumnType.DOUBLE);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxDoubleWrapUp(pRosti, valueOffset, max.get());
+            case GKK_STR:
+                return Rosti.keyedStrMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+            default:
+                return Rosti.keyedIntMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+        }
     }
 }
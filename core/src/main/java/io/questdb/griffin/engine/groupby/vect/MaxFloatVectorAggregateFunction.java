@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.ColumnType;
+import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.FloatFunction;
+import io.questdb.std.Rosti;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
+
+import java.util.concurrent.atomic.DoubleAccumulator;
+import java.util.function.DoubleBinaryOperator;
+
+import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
+
+public class MaxFloatVectorAggregateFunction extends FloatFunction implements VectorAggregateFunction {
+
+    public static final DoubleBinaryOperator MAX = Math::max;
+    private final int columnIndex;
+    private final DistinctFunc distinctFunc;
+    private final int keyKind;
+    private final KeyValueFunc keyValueFunc;
+    private final DoubleAccumulator max = new DoubleAccumulator(
+            MAX, Double.NEGATIVE_INFINITY
+    );
+    private int valueOffset;
+
+    public MaxFloatVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
+        this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
+        if (keyKind == GKK_HOUR_INT) {
+            this.distinctFunc = Rosti::keyedHourDistinct;
+            this.keyValueFunc = Rosti::keyedHourMaxFloat;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMaxFloat;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMaxFloat;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MaxFloat;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMaxFloat;
+        } else {
+            this.distinctFunc = Rosti::keyedIntDistinct;
+            this.keyValueFunc = Rosti::keyedIntMaxFloat;
+        }
+    }
+
+    @Override
+    public void aggregate(long address, long addressSize, int columnSizeHint, int workerId) {
+        if (address != 0) {
+            final float value = Vect.maxFloat(address, addressSize / Float.BYTES);
+            if (value == value) {
+                max.accumulate(value);
+            }
+        }
+    }
+
+    @Override
+    public boolean aggregate(long pRosti, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId) {
+        if (valueAddress == 0) {
+            return distinctFunc.run(pRosti, keyAddress, valueAddressSize / Float.BYTES);
+        } else {
+            return keyValueFunc.run(pRosti, keyAddress, valueAddress, valueAddressSize / Float.BYTES, valueOffset);
+        }
+    }
+
+    @Override
+    public void clear() {
+        max.reset();
+    }
+
+    @Override
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
+    @Override
+    public float getFloat(Record rec) {
+        final double value = max.get();
+        return Double.isInfinite(value) ? Float.NaN : (float) value;
+    }
+
+    @Override
+    public String getName() {
+        return "max";
+    }
+
+    @Override
+    public int getValueOffset() {
+        return valueOffset;
+    }
+
+    @Override
+    public void initRosti(long pRosti) {
+        Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, this.valueOffset), Double.NEGATIVE_INFINITY);
+    }
+
+    @Override
+    public boolean merge(long pRostiA, long pRostiB) {
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMaxDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
+    }
+
+    @Override
+    public void pushValueTypes(ArrayColumnTypes types) {
+        this.valueOffset = types.getColumnCount();
+        types.add(ColumnType.DOUBLE);
+    }
+
+    @Override
+    public boolean wrapUp(long pRosti) {
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxDoubleWrapUp(pRosti, valueOffset, max.get());
+            case GKK_STR:
+                return Rosti.keyedStrMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+            default:
+                return Rosti.keyedIntMaxDoubleWrapUp(pRosti, valueOffset, max.get());
+        }
+    }
+}
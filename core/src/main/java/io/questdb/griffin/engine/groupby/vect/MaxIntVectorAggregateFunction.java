@@ -36,12 +36,17 @@ import java.util.concurrent.atomic.LongAccumulator;
 import java.util.function.LongBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MaxIntVectorAggregateFunction extends IntFunction implements VectorAggregateFunction {
 
     public static final LongBinaryOperator MAX = Math::max;
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final LongAccumulator max = new LongAccumulator(
             MAX, Integer.MIN_VALUE
@@ -51,9 +56,22 @@ public class MaxIntVectorAggregateFunction extends IntFunction implements Vector
     public MaxIntVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         super();
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMaxInt;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMaxInt;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMaxInt;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MaxInt;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMaxInt;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMaxInt;
@@ -76,6 +94,11 @@ public class MaxIntVectorAggregateFunction extends IntFunction implements Vector
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        max.accumulate((int) Unsafe.getUnsafe().getLong(pStats + STATS_MAX_OFFSET));
+    }
+
     @Override
     public void clear() {
         max.reset();
@@ -86,6 +109,11 @@ public class MaxIntVectorAggregateFunction extends IntFunction implements Vector
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MAX_INT;
+    }
+
     @Override
     public int getInt(Record rec) {
         return max.intValue();
@@ -108,7 +136,17 @@ public class MaxIntVectorAggregateFunction extends IntFunction implements Vector
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMaxIntMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMaxIntMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMaxIntMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -117,8 +155,23 @@ public class MaxIntVectorAggregateFunction extends IntFunction implements Vector
         types.add(ColumnType.INT);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMaxIntWrapUp(pRosti, valueOffset, max.intValue());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxIntWrapUp(pRosti, valueOffset, max.intValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxIntWrapUp(pRosti, valueOffset, max.intValue());
+            case GKK_STR:
+                return Rosti.keyedStrMaxIntWrapUp(pRosti, valueOffset, max.intValue());
+            default:
+                return Rosti.keyedIntMaxIntWrapUp(pRosti, valueOffset, max.intValue());
+        }
     }
 }
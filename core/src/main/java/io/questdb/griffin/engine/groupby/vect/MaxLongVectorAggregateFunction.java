@@ -36,12 +36,17 @@ import java.util.concurrent.atomic.LongAccumulator;
 import java.util.function.LongBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MaxLongVectorAggregateFunction extends LongFunction implements VectorAggregateFunction {
 
     public static final LongBinaryOperator MAX = Math::max;
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final LongAccumulator max = new LongAccumulator(
             MAX, Long.MIN_VALUE
@@ -50,9 +55,22 @@ public class MaxLongVectorAggregateFunction extends LongFunction implements Vect
 
     public MaxLongVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMaxLong;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMaxLong;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMaxLong;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MaxLong;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMaxLong;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMaxLong;
@@ -75,6 +93,11 @@ public class MaxLongVectorAggregateFunction extends LongFunction implements Vect
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        max.accumulate(Unsafe.getUnsafe().getLong(pStats + STATS_MAX_OFFSET));
+    }
+
     @Override
     public void clear() {
         max.reset();
@@ -85,6 +108,11 @@ public class MaxLongVectorAggregateFunction extends LongFunction implements Vect
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MAX_LONG;
+    }
+
     @Override
     public long getLong(Record rec) {
         return max.longValue();
@@ -107,7 +135,17 @@ public class MaxLongVectorAggregateFunction extends LongFunction implements Vect
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMaxLongMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMaxLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMaxLongMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -116,8 +154,23 @@ public class MaxLongVectorAggregateFunction extends LongFunction implements Vect
         types.add(ColumnType.LONG);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMaxLongWrapUp(pRosti, valueOffset, max.longValue());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxLongWrapUp(pRosti, valueOffset, max.longValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxLongWrapUp(pRosti, valueOffset, max.longValue());
+            case GKK_STR:
+                return Rosti.keyedStrMaxLongWrapUp(pRosti, valueOffset, max.longValue());
+            default:
+                return Rosti.keyedIntMaxLongWrapUp(pRosti, valueOffset, max.longValue());
+        }
     }
 }
@@ -37,12 +37,17 @@ import java.util.concurrent.atomic.LongAccumulator;
 import java.util.function.LongBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MaxShortVectorAggregateFunction extends IntFunction implements VectorAggregateFunction {
 
     public static final LongBinaryOperator MAX = Math::max;
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final LongAccumulator accumulator = new LongAccumulator(
             MAX, Numbers.INT_NaN
@@ -52,9 +57,22 @@ public class MaxShortVectorAggregateFunction extends IntFunction implements Vect
     @SuppressWarnings("unused")
     public MaxShortVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMaxShort;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMaxShort;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMaxShort;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MaxShort;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMaxShort;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMaxShort;
@@ -90,6 +108,11 @@ public class MaxShortVectorAggregateFunction extends IntFunction implements Vect
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MAX_SHORT;
+    }
+
     @Override
     public int getInt(Record rec) {
         return accumulator.intValue();
@@ -112,7 +135,17 @@ public class MaxShortVectorAggregateFunction extends IntFunction implements Vect
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMaxLongMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMaxLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMaxLongMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -123,6 +156,16 @@ public class MaxShortVectorAggregateFunction extends IntFunction implements Vect
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMaxShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMaxShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MaxShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_STR:
+                return Rosti.keyedStrMaxShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            default:
+                return Rosti.keyedIntMaxShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+        }
     }
 }
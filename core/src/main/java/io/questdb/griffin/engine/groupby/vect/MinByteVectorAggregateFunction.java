@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.ColumnType;
+import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.IntFunction;
+import io.questdb.std.Numbers;
+import io.questdb.std.Rosti;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
+
+import java.util.concurrent.atomic.LongAccumulator;
+import java.util.function.LongBinaryOperator;
+
+import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
+
+public class MinByteVectorAggregateFunction extends IntFunction implements VectorAggregateFunction {
+
+    public static final LongBinaryOperator MIN = (long l1, long l2) -> {
+        if (l1 == Numbers.INT_NaN) {
+            return l2;
+        }
+        if (l2 == Numbers.INT_NaN) {
+            return l1;
+        }
+        return Math.min(l1, l2);
+    };
+    private final LongAccumulator accumulator = new LongAccumulator(
+            MIN, Numbers.INT_NaN
+    );
+    private final int columnIndex;
+    private final DistinctFunc distinctFunc;
+    private final int keyKind;
+    private final KeyValueFunc keyValueFunc;
+    private int valueOffset;
+
+    @SuppressWarnings("unused")
+    public MinByteVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
+        this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
+        if (keyKind == GKK_HOUR_INT) {
+            this.distinctFunc = Rosti::keyedHourDistinct;
+            this.keyValueFunc = Rosti::keyedHourMinByte;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMinByte;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMinByte;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MinByte;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMinByte;
+        } else {
+            this.distinctFunc = Rosti::keyedIntDistinct;
+            this.keyValueFunc = Rosti::keyedIntMinByte;
+        }
+    }
+
+    @Override
+    public void aggregate(long address, long addressSize, int columnSizeHint, int workerId) {
+        if (address != 0) {
+            final long value = Vect.minByte(address, addressSize / Byte.BYTES);
+            if (value != Numbers.INT_NaN) {
+                accumulator.accumulate(value);
+            }
+        }
+    }
+
+    @Override
+    public boolean aggregate(long pRosti, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId) {
+        if (valueAddress == 0) {
+            return distinctFunc.run(pRosti, keyAddress, valueAddressSize / Byte.BYTES);
+        } else {
+            return keyValueFunc.run(pRosti, keyAddress, valueAddress, valueAddressSize / Byte.BYTES, valueOffset);
+        }
+    }
+
+    @Override
+    public void clear() {
+        accumulator.reset();
+    }
+
+    @Override
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
+    @Override
+    public int getInt(Record rec) {
+        return accumulator.intValue();
+    }
+
+    @Override
+    public String getName() {
+        return "min";
+    }
+
+    @Override
+    public int getValueOffset() {
+        return valueOffset;
+    }
+
+    @Override
+    public void initRosti(long pRosti) {
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, valueOffset), Numbers.LONG_NaN);
+    }
+
+    @Override
+    public boolean merge(long pRostiA, long pRostiB) {
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMinLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, valueOffset);
+        }
+    }
+
+    @Override
+    public void pushValueTypes(ArrayColumnTypes types) {
+        this.valueOffset = types.getColumnCount();
+        types.add(ColumnType.LONG);
+    }
+
+    @Override
+    public boolean wrapUp(long pRosti) {
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_STR:
+                return Rosti.keyedStrMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            default:
+                return Rosti.keyedIntMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+        }
+    }
+}
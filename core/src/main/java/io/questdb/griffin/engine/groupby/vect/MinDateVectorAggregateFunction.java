@@ -37,6 +37,10 @@ import java.util.concurrent.atomic.LongAccumulator;
 import java.util.function.LongBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MinDateVectorAggregateFunction extends DateFunction implements VectorAggregateFunction {
 
@@ -54,14 +58,28 @@ public class MinDateVectorAggregateFunction extends DateFunction implements Vect
     );
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private int valueOffset;
 
     public MinDateVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMinLong;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMinLong;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMinLong;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MinLong;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMinLong;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMinLong;
@@ -87,6 +105,14 @@ public class MinDateVectorAggregateFunction extends DateFunction implements Vect
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final long value = Unsafe.getUnsafe().getLong(pStats + STATS_MIN_OFFSET);
+        if (value != Numbers.LONG_NaN) {
+            accumulator.accumulate(value);
+        }
+    }
+
     @Override
     public void clear() {
         accumulator.reset();
@@ -97,6 +123,11 @@ public class MinDateVectorAggregateFunction extends DateFunction implements Vect
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MIN_LONG;
+    }
+
     @Override
     public long getDate(Record rec) {
         return accumulator.longValue();
@@ -119,7 +150,17 @@ public class MinDateVectorAggregateFunction extends DateFunction implements Vect
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMinLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -128,8 +169,23 @@ public class MinDateVectorAggregateFunction extends DateFunction implements Vect
         types.add(ColumnType.LONG);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMinLongWrapUp(pRosti, valueOffset, accumulator.longValue());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinLongWrapUp(pRosti, valueOffset, accumulator.longValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinLongWrapUp(pRosti, valueOffset, accumulator.longValue());
+            case GKK_STR:
+                return Rosti.keyedStrMinLongWrapUp(pRosti, valueOffset, accumulator.longValue());
+            default:
+                return Rosti.keyedIntMinLongWrapUp(pRosti, valueOffset, accumulator.longValue());
+        }
     }
 }
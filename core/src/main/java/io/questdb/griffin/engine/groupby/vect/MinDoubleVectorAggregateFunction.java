@@ -36,12 +36,17 @@ import java.util.concurrent.atomic.DoubleAccumulator;
 import java.util.function.DoubleBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MinDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
 
     public static final DoubleBinaryOperator MIN = Math::min;
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final DoubleAccumulator min = new DoubleAccumulator(
             MIN, Double.POSITIVE_INFINITY
@@ -50,9 +55,22 @@ public class MinDoubleVectorAggregateFunction extends DoubleFunction implements
 
     public MinDoubleVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMinDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMinDouble;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMinDouble;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MinDouble;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMinDouble;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMinDouble;
@@ -80,6 +98,14 @@ public class MinDoubleVectorAggregateFunction extends DoubleFunction implements
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final double value = Unsafe.getUnsafe().getDouble(pStats + STATS_MIN_OFFSET);
+        if (value == value) {
+            min.accumulate(value);
+        }
+    }
+
     @Override
     public void clear() {
         min.reset();
@@ -90,6 +116,11 @@ public class MinDoubleVectorAggregateFunction extends DoubleFunction implements
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MIN_DOUBLE;
+    }
+
     @Override
     public double getDouble(Record rec) {
         final double min = this.min.get();
@@ -116,7 +147,17 @@ public class MinDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMinDoubleMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMinDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMinDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -125,8 +166,23 @@ public class MinDoubleVectorAggregateFunction extends DoubleFunction implements
         types.add(ColumnType.DOUBLE);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMinDoubleWrapUp(pRosti, valueOffset, this.min.get());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinDoubleWrapUp(pRosti, valueOffset, this.min.get());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinDoubleWrapUp(pRosti, valueOffset, this.min.get());
+            case GKK_STR:
+                return Rosti.keyedStrMinDoubleWrapUp(pRosti, valueOffset, this.min.get());
+            default:
+                return Rosti.keyedIntMinDoubleWrapUp(pRosti, valueOffset, this.min.get());
+        }
     }
 }
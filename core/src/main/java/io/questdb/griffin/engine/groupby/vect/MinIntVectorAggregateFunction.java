@@ -37,6 +37,10 @@ import java.util.concurrent.atomic.LongAccumulator;
 import java.util.function.LongBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MinIntVectorAggregateFunction extends IntFunction implements VectorAggregateFunction {
 
@@ -54,14 +58,28 @@ public class MinIntVectorAggregateFunction extends IntFunction implements Vector
     );
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private int valueOffset;
 
     public MinIntVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMinInt;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMinInt;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMinInt;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MinInt;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMinInt;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMinInt;
@@ -87,6 +105,14 @@ public class MinIntVectorAggregateFunction extends IntFunction implements Vector
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final int value = (int) Unsafe.getUnsafe().getLong(pStats + STATS_MIN_OFFSET);
+        if (value != Numbers.INT_NaN) {
+            accumulator.accumulate(value);
+        }
+    }
+
     @Override
     public void clear() {
         accumulator.reset();
@@ -97,6 +123,11 @@ public class MinIntVectorAggregateFunction extends IntFunction implements Vector
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MIN_INT;
+    }
+
     @Override
     public int getInt(Record rec) {
         return accumulator.intValue();
@@ -119,7 +150,17 @@ public class MinIntVectorAggregateFunction extends IntFunction implements Vector
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMinIntMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMinIntMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMinIntMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -128,8 +169,23 @@ public class MinIntVectorAggregateFunction extends IntFunction implements Vector
         types.add(ColumnType.INT);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMinIntWrapUp(pRosti, valueOffset, accumulator.intValue());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinIntWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinIntWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_STR:
+                return Rosti.keyedStrMinIntWrapUp(pRosti, valueOffset, accumulator.intValue());
+            default:
+                return Rosti.keyedIntMinIntWrapUp(pRosti, valueOffset, accumulator.intValue());
+        }
     }
 }
@@ -37,6 +37,10 @@ import java.util.concurrent.atomic.LongAccumulator;
 import java.util.function.LongBinaryOperator;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class MinShortVectorAggregateFunction extends IntFunction implements VectorAggregateFunction {
 
@@ -54,15 +58,29 @@ public class MinShortVectorAggregateFunction extends IntFunction implements Vect
     );
     private final int columnIndex;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private int valueOffset;
 
     @SuppressWarnings("unused")
     public MinShortVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourMinShort;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairMinShort;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongMinShort;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128MinShort;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrMinShort;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntMinShort;
@@ -98,6 +116,11 @@ public class MinShortVectorAggregateFunction extends IntFunction implements Vect
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_MIN_SHORT;
+    }
+
     @Override
     public int getInt(Record rec) {
         return accumulator.intValue();
@@ -120,7 +143,17 @@ public class MinShortVectorAggregateFunction extends IntFunction implements Vect
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrMinLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -131,6 +164,16 @@ public class MinShortVectorAggregateFunction extends IntFunction implements Vect
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_LONG128:
+                return Rosti.keyedLong128MinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            case GKK_STR:
+                return Rosti.keyedStrMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+            default:
+                return Rosti.keyedIntMinShortWrapUp(pRosti, valueOffset, accumulator.intValue());
+        }
     }
 }
@@ -36,6 +36,10 @@ import io.questdb.std.Vect;
 import java.util.Arrays;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class NSumDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
     private static final int COUNT_PADDING = Misc.CACHE_LINE_SIZE / Long.BYTES;
@@ -44,6 +48,7 @@ public class NSumDoubleVectorAggregateFunction extends DoubleFunction implements
     private final int columnIndex;
     private final long[] count;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final double[] sum;
     private final int workerCount;
@@ -57,9 +62,22 @@ public class NSumDoubleVectorAggregateFunction extends DoubleFunction implements
         this.sum = new double[workerCount * SUM_PADDING];
         this.count = new long[workerCount * COUNT_PADDING];
         this.workerCount = workerCount;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             this.distinctFunc = Rosti::keyedHourDistinct;
             this.keyValueFunc = Rosti::keyedHourNSumDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            this.distinctFunc = Rosti::keyedIntPairDistinct;
+            this.keyValueFunc = Rosti::keyedIntPairNSumDouble;
+        } else if (keyKind == GKK_LONG) {
+            this.distinctFunc = Rosti::keyedLongDistinct;
+            this.keyValueFunc = Rosti::keyedLongNSumDouble;
+        } else if (keyKind == GKK_LONG128) {
+            this.distinctFunc = Rosti::keyedLong128Distinct;
+            this.keyValueFunc = Rosti::keyedLong128NSumDouble;
+        } else if (keyKind == GKK_STR) {
+            this.distinctFunc = Rosti::keyedStrDistinct;
+            this.keyValueFunc = Rosti::keyedStrNSumDouble;
         } else {
             this.distinctFunc = Rosti::keyedIntDistinct;
             this.keyValueFunc = Rosti::keyedIntNSumDouble;
@@ -108,6 +126,11 @@ public class NSumDoubleVectorAggregateFunction extends DoubleFunction implements
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_NSUM_DOUBLE;
+    }
+
     @Override
     public double getDouble(Record rec) {
         computeSum();
@@ -133,7 +156,17 @@ public class NSumDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntNSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongNSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128NSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrNSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntNSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -147,7 +180,17 @@ public class NSumDoubleVectorAggregateFunction extends DoubleFunction implements
     @Override
     public boolean wrapUp(long pRosti) {
         computeSum();
-        return Rosti.keyedIntNSumDoubleWrapUp(pRosti, valueOffset, transientSum, transientCount, transientC);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongNSumDoubleWrapUp(pRosti, valueOffset, transientSum, transientCount, transientC);
+            case GKK_LONG128:
+                return Rosti.keyedLong128NSumDoubleWrapUp(pRosti, valueOffset, transientSum, transientCount, transientC);
+            case GKK_STR:
+                return Rosti.keyedStrNSumDoubleWrapUp(pRosti, valueOffset, transientSum, transientCount, transientC);
+            default:
+                return Rosti.keyedIntNSumDoubleWrapUp(pRosti, valueOffset, transientSum, transientCount, transientC);
+        }
     }
 
     private void computeSum() {
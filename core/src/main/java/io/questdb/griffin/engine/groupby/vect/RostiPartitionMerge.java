@@ -0,0 +1,219 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.ColumnTypes;
+import io.questdb.std.*;
+
+/**
+ * Merges per worker maps on the worker pool, in two phases of tasks.
+ * <p>
+ * Split task copies slots of one worker map to maps of their key partitions, see
+ * {@link Rosti#split(long, long, int)}. Merge task merges maps of one partition, one per worker map,
+ * into the first of them and wraps it up. Tasks of the same phase touch disjoint maps, so that they
+ * run in any order and on any thread. A key lands in exactly one partition and the cursor iterates
+ * partition maps one after another.
+ * <p>
+ * Null key values are added to every partition map on wrap up, they are kept only in the
+ * partition the null key belongs to.
+ */
+public class RostiPartitionMerge implements QuietCloseable {
+    private static final int ROSTI_MINIMIZED_SIZE = 16;
+    private final ArrayColumnTypes columnTypes = new ArrayColumnTypes();
+    // memory of partition maps before split, see RostiAllocFacade.updateMemoryUsage()
+    private final long[] allocSizes;
+    private final int partitionCount;
+    // partitionCount maps per source, allocated on first merge
+    private final long[] partitions;
+    private final RostiAllocFacade raf;
+    private final int sourceCount;
+    private boolean isSplit;
+    private int nullKeyPartition;
+    // addresses of partition maps, as passed to split()
+    private long pPartitions;
+    private long[] sources;
+    private ObjList<VectorAggregateFunction> vafList;
+
+    /**
+     * @param partitionCount power of 2
+     * @param sourceCount    number of maps to merge
+     */
+    public RostiPartitionMerge(RostiAllocFacade raf, ColumnTypes columnTypes, int partitionCount, int sourceCount) {
+        assert Numbers.isPow2(partitionCount);
+        this.raf = raf;
+        this.partitionCount = partitionCount;
+        this.sourceCount = sourceCount;
+        this.partitions = new long[partitionCount * sourceCount];
+        this.allocSizes = new long[partitionCount * sourceCount];
+        for (int i = 0, n = columnTypes.getColumnCount(); i < n; i++) {
+            this.columnTypes.add(columnTypes.getColumnType(i));
+        }
+        pPartitions = Unsafe.malloc((long) Long.BYTES * partitions.length, MemoryTag.NATIVE_ROSTI);
+    }
+
+    /**
+     * Shrinks partition maps.
+     */
+    public void clear() {
+        for (int i = 0, n = partitions.length; i < n; i++) {
+            if (partitions[i] != 0 && !raf.reset(partitions[i], ROSTI_MINIMIZED_SIZE)) {
+                raf.clear(partitions[i]);
+            }
+        }
+        isSplit = false;
+        sources = null;
+        vafList = null;
+    }
+
+    @Override
+    public void close() {
+        for (int i = 0, n = partitions.length; i < n; i++) {
+            if (partitions[i] != 0) {
+                raf.free(partitions[i]);
+                partitions[i] = 0;
+            }
+        }
+        pPartitions = Unsafe.free(pPartitions, (long) Long.BYTES * partitions.length, MemoryTag.NATIVE_ROSTI);
+    }
+
+    // map of the partition, wrapped up once its merge task is done
+    public long getPartition(int partitionIndex) {
+        return partitions[partitionIndex];
+    }
+
+    public int getPartitionCount() {
+        return partitionCount;
+    }
+
+    // tasks of the current phase, one per source map to split or one per partition to merge
+    public int getTaskCount() {
+        return isSplit ? partitionCount : sourceCount;
+    }
+
+    /**
+     * Prepares split of the maps. Partition maps take initial values of the first map.
+     *
+     * @param sources maps of sourceCount workers, built and not to be touched by anything but tasks of the merge
+     */
+    public void of(long[] sources, ObjList<VectorAggregateFunction> vafList) {
+        assert sources.length == sourceCount;
+        this.sources = sources;
+        this.vafList = vafList;
+        this.isSplit = false;
+        final long slotSize = Rosti.getSlotSize(sources[0]);
+        for (int i = 0, n = partitions.length; i < n; i++) {
+            if (partitions[i] == 0) {
+                final long ptr = raf.alloc(columnTypes, ROSTI_MINIMIZED_SIZE);
+                if (ptr == 0) {
+                    throw new OutOfMemoryError();
+                }
+                partitions[i] = ptr;
+                Unsafe.getUnsafe().putLong(pPartitions + (long) i * Long.BYTES, ptr);
+            }
+            raf.clear(partitions[i]);
+            Vect.memcpy(Rosti.getInitialValuesSlot(partitions[i]), Rosti.getInitialValuesSlot(sources[0]), slotSize);
+        }
+        nullKeyPartition = Rosti.getNullKeyPartition(partitions[0], partitionCount);
+    }
+
+    /**
+     * Runs task of the current phase, safe to call concurrently for different tasks.
+     *
+     * @return false when out of memory
+     */
+    public boolean run(int taskIndex) {
+        return isSplit ? merge(taskIndex) : split(taskIndex);
+    }
+
+    // to be called once all split tasks are done
+    public void startMerge() {
+        isSplit = true;
+    }
+
+    private boolean merge(int partitionIndex) {
+        final long pMerge = partitions[partitionIndex];
+        final int vafCount = vafList.size();
+        for (int j = 0; j < vafCount; j++) {
+            final VectorAggregateFunction vaf = vafList.getQuick(j);
+            for (int i = 1; i < sourceCount; i++) {
+                final long pPartition = partitions[i * partitionCount + partitionIndex];
+                if (raf.getSize(pPartition) < 1) {
+                    continue;
+                }
+                final long oldSize = Rosti.getAllocMemory(pMerge);
+                if (!vaf.merge(pMerge, pPartition)) {
+                    return false;
+                }
+                raf.updateMemoryUsage(pMerge, oldSize);
+            }
+
+            final long oldSize = Rosti.getAllocMemory(pMerge);
+            if (!vaf.wrapUp(pMerge)) {
+                return false;
+            }
+            raf.updateMemoryUsage(pMerge, oldSize);
+        }
+        if (partitionIndex != nullKeyPartition) {
+            Rosti.removeNullKey(pMerge);
+        }
+        // cursor walks map slots directly, they must all be in one arena
+        Rosti.completeResize(pMerge);
+
+        for (int i = 1; i < sourceCount; i++) {
+            final long pPartition = partitions[i * partitionCount + partitionIndex];
+            if (!raf.reset(pPartition, ROSTI_MINIMIZED_SIZE)) {
+                raf.clear(pPartition);
+            }
+        }
+        return true;
+    }
+
+    private boolean split(int sourceIndex) {
+        final long pSource = sources[sourceIndex];
+        if (raf.getSize(pSource) < 1) {
+            return true;
+        }
+
+        final int lo = sourceIndex * partitionCount;
+        final int hi = lo + partitionCount;
+        for (int i = lo; i < hi; i++) {
+            allocSizes[i] = Rosti.getAllocMemory(partitions[i]);
+        }
+        final boolean success = Rosti.split(pSource, pPartitions + (long) lo * Long.BYTES, partitionCount);
+        for (int i = lo; i < hi; i++) {
+            raf.updateMemoryUsage(partitions[i], allocSizes[i]);
+        }
+        if (!success) {
+            return false;
+        }
+
+        // the map is not needed once its slots are copied
+        if (!raf.reset(pSource, ROSTI_MINIMIZED_SIZE)) {
+            raf.clear(pSource);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.CairoConfiguration;
+import io.questdb.cairo.CairoException;
+import io.questdb.cairo.TableUtils;
+import io.questdb.log.Log;
+import io.questdb.log.LogFactory;
+import io.questdb.std.*;
+import io.questdb.std.str.Path;
+
+import java.util.concurrent.atomic.AtomicLong;
+
+/**
+ * Rosti slots written to disk when keyed aggregation goes over its memory budget.
+ * <p>
+ * Slots are hash-partitioned by key, each partition is a file that spilled maps are appended to.
+ * A key can occur in the file as many times as it was spilled, merge functions add such slots up,
+ * so that a partition is aggregated by merging its whole file into an empty map. Partition files
+ * are mapped one at a time, as a run that merge functions and cursors iterate like a map.
+ * A run whose keys may not fit in memory is spilled again, to a spill that partitions it by the
+ * hash bits that follow those of the run's own partition.
+ * <p>
+ * Not thread-safe, each map spills to its own instance. Maps with STRING keys cannot be spilled,
+ * their slots refer to chars in the key heap of the map.
+ */
+public class RostiSpill implements QuietCloseable {
+    private static final Log LOG = LogFactory.getLog(RostiSpill.class);
+    private static final int ROSTI_MINIMIZED_SIZE = 16;
+    private static final AtomicLong SPILL_ID = new AtomicLong();
+    private final long[] dests;
+    private final int[] fds;
+    private final FilesFacade ff;
+    private final long id = SPILL_ID.incrementAndGet();
+    private final int mkDirMode;
+    private final int partitionCount;
+    private final int partitionShift;
+    private final Path path;
+    private final int rootLen;
+    private final long[] sizes;
+    private final long threshold;
+    private long pCounts;
+    private long pDests;
+    private long pRun;
+    private long runAddress;
+    private long runSize;
+
+    /**
+     * @param partitionCount power of 2
+     * @param partitionShift hash bits already taken by partitions of spills the runs come from, 0 for maps
+     */
+    public RostiSpill(CairoConfiguration configuration, int partitionCount, int partitionShift) {
+        assert Numbers.isPow2(partitionCount);
+        this.ff = configuration.getFilesFacade();
+        this.mkDirMode = configuration.getMkDirMode();
+        this.partitionCount = partitionCount;
+        this.partitionShift = partitionShift;
+        this.fds = new int[partitionCount];
+        this.sizes = new long[partitionCount];
+        this.dests = new long[partitionCount];
+        this.threshold = configuration.getGroupBySpillThreshold();
+        this.path = new Path().of(configuration.getGroupBySpillRoot());
+        this.rootLen = path.size();
+        for (int i = 0; i < partitionCount; i++) {
+            fds[i] = -1;
+        }
+        try {
+            pCounts = Unsafe.malloc((long) Long.BYTES * partitionCount, MemoryTag.NATIVE_ROSTI);
+            pDests = Unsafe.malloc((long) Long.BYTES * partitionCount, MemoryTag.NATIVE_ROSTI);
+        } catch (Throwable th) {
+            close();
+            throw th;
+        }
+    }
+
+    /**
+     * Removes partition files.
+     */
+    public void clear() {
+        closeRun();
+        for (int i = 0; i < partitionCount; i++) {
+            if (fds[i] != -1) {
+                ff.close(fds[i]);
+                fds[i] = -1;
+                if (!ff.removeQuiet(partitionPath(i))) {
+                    LOG.error().$("could not remove spill file [path=").$(path).$(", errno=").$(ff.errno()).I$();
+                }
+            }
+            sizes[i] = 0;
+        }
+    }
+
+    @Override
+    public void close() {
+        clear();
+        pCounts = Unsafe.free(pCounts, (long) Long.BYTES * partitionCount, MemoryTag.NATIVE_ROSTI);
+        pDests = Unsafe.free(pDests, (long) Long.BYTES * partitionCount, MemoryTag.NATIVE_ROSTI);
+        Misc.free(path);
+    }
+
+    public void closeRun() {
+        if (pRun != 0) {
+            Rosti.freeRun(pRun);
+            pRun = 0;
+        }
+        if (runAddress != 0) {
+            ff.munmap(runAddress, runSize, MemoryTag.MMAP_DEFAULT);
+            runAddress = 0;
+            runSize = 0;
+        }
+    }
+
+    // partition the null key of the map is spilled to
+    public int getNullKeyPartition(long pRosti) {
+        return Rosti.spillNullKeyPartition(pRosti, partitionCount, partitionShift);
+    }
+
+    // bytes spilled to the partition
+    public long getPartitionSize(int partitionIndex) {
+        return sizes[partitionIndex];
+    }
+
+    public boolean isEmpty() {
+        for (int i = 0; i < partitionCount; i++) {
+            if (sizes[i] > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Maps partition file as a run of the given map structure. Run stays valid until
+     * closeRun(), clear() or another openRun() call.
+     *
+     * @return address of the run or 0 when nothing was spilled to the partition
+     */
+    public long openRun(int partitionIndex, long pRosti) {
+        closeRun();
+        final long size = sizes[partitionIndex];
+        if (size == 0) {
+            return 0;
+        }
+        runAddress = TableUtils.mapRO(ff, fds[partitionIndex], size, MemoryTag.MMAP_DEFAULT);
+        runSize = size;
+        pRun = Rosti.allocRun(pRosti, runAddress, size / Rosti.getSlotSize(pRosti));
+        if (pRun == 0) {
+            closeRun();
+            throw new OutOfMemoryError();
+        }
+        return pRun;
+    }
+
+    /**
+     * Appends slots of a map or a run to partition files. The map is left intact, it is up to the caller to clear it.
+     *
+     * @param skipNullKey when true, slot of the null key is not written
+     */
+    public void spill(long pRosti, boolean skipNullKey) {
+        if (!Rosti.isSpillable(pRosti)) {
+            throw CairoException.nonCritical().put("map cannot be spilled, it has STRING keys");
+        }
+        if (Rosti.spillCounts(pRosti, partitionCount, partitionShift, pCounts, skipNullKey) == 0) {
+            return;
+        }
+        final long slotSize = Rosti.getSlotSize(pRosti);
+        boolean copied = false;
+        try {
+            for (int i = 0; i < partitionCount; i++) {
+                final long len = Unsafe.getUnsafe().getLong(pCounts + (long) i * Long.BYTES) * slotSize;
+                if (len > 0) {
+                    if (fds[i] == -1) {
+                        fds[i] = openPartition(i);
+                    }
+                    TableUtils.allocateDiskSpace(ff, fds[i], sizes[i] + len);
+                    dests[i] = TableUtils.mapAppendColumnBuffer(ff, fds[i], sizes[i], len, true, MemoryTag.MMAP_DEFAULT);
+                }
+                Unsafe.getUnsafe().putLong(pDests + (long) i * Long.BYTES, dests[i]);
+            }
+            Rosti.spillCopy(pRosti, partitionCount, partitionShift, pDests, skipNullKey);
+            copied = true;
+        } finally {
+            // sizes are not advanced when spill fails, appended slots are overwritten by the next spill
+            for (int i = 0; i < partitionCount; i++) {
+                if (dests[i] != 0) {
+                    final long len = Unsafe.getUnsafe().getLong(pCounts + (long) i * Long.BYTES) * slotSize;
+                    TableUtils.mapAppendColumnBufferRelease(ff, dests[i], sizes[i], len, MemoryTag.MMAP_DEFAULT);
+                    dests[i] = 0;
+                    if (copied) {
+                        sizes[i] += len;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Spills and shrinks the map once it takes more memory than the configured threshold.
+     * Spill failure leaves the map as it was, aggregation carries on in memory. Maps with STRING
+     * keys are never spilled.
+     */
+    public void spillIfOverThreshold(long pRosti, RostiAllocFacade raf) {
+        if (Rosti.getAllocMemory(pRosti) <= threshold || !Rosti.isSpillable(pRosti)) {
+            return;
+        }
+        try {
+            spill(pRosti, false);
+        } catch (CairoException e) {
+            LOG.error().$("could not spill map [error=").$(e.getFlyweightMessage()).$(", errno=").$(e.getErrno()).I$();
+            return;
+        }
+        if (!raf.reset(pRosti, ROSTI_MINIMIZED_SIZE)) {
+            raf.clear(pRosti);
+        }
+    }
+
+    private int openPartition(int partitionIndex) {
+        path.trimTo(rootLen).slash$();
+        if (!ff.exists(path) && ff.mkdirs(path, mkDirMode) != 0) {
+            throw CairoException.critical(ff.errno()).put("could not create spill directory [path=").put(path).put(']');
+        }
+        return TableUtils.openRW(ff, partitionPath(partitionIndex), LOG, CairoConfiguration.O_NONE);
+    }
+
+    private Path partitionPath(int partitionIndex) {
+        return path.trimTo(rootLen).concat("groupby_spill_").put(id).putAscii('_').put(partitionIndex).putAscii(".d").$();
+    }
+}
@@ -36,20 +36,38 @@ import io.questdb.std.Vect;
 import java.util.concurrent.atomic.LongAdder;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class SumDateVectorAggregateFunction extends DateFunction implements VectorAggregateFunction {
     private final int columnIndex;
     private final LongAdder count = new LongAdder();
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final LongAdder sum = new LongAdder();
     private int valueOffset;
 
     public SumDateVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumLong;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumLong;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumLong;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumLong;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumLong;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumLong;
@@ -76,6 +94,15 @@ public class SumDateVectorAggregateFunction extends DateFunction implements Vect
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final long value = Unsafe.getUnsafe().getLong(pStats + STATS_SUM_OFFSET);
+        if (value != Numbers.LONG_NaN) {
+            sum.add(value);
+            this.count.increment();
+        }
+    }
+
     @Override
     public void clear() {
         sum.reset();
@@ -87,6 +114,11 @@ public class SumDateVectorAggregateFunction extends DateFunction implements Vect
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_LONG;
+    }
+
     @Override
     public long getDate(Record rec) {
         if (count.sum() > 0) {
@@ -113,7 +145,17 @@ public class SumDateVectorAggregateFunction extends DateFunction implements Vect
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumLongMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumLongMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumLongMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumLongMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -123,8 +165,23 @@ public class SumDateVectorAggregateFunction extends DateFunction implements Vect
         types.add(ColumnType.LONG);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_STR:
+                return Rosti.keyedStrSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            default:
+                return Rosti.keyedIntSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        }
     }
 }
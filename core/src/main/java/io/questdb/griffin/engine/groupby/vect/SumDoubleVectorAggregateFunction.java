@@ -37,6 +37,10 @@ import org.jetbrains.annotations.Nullable;
 import java.util.Arrays;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class SumDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
     private static final int COUNT_PADDING = Misc.CACHE_LINE_SIZE / Long.BYTES;
@@ -44,6 +48,7 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
     private final int columnIndex;
     private final long[] count;
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final double[] sum;
     private final int workerCount;
@@ -55,9 +60,23 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
         this.count = new long[workerCount * COUNT_PADDING];
         this.workerCount = workerCount;
 
+        this.keyKind = keyKind;
+
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumDouble;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumDouble;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumDouble;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumDouble;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumDouble;
@@ -86,6 +105,15 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final double value = Unsafe.getUnsafe().getDouble(pStats + STATS_SUM_OFFSET);
+        if (value == value) {
+            this.sum[workerId * SUM_PADDING] += value;
+            this.count[workerId * COUNT_PADDING]++;
+        }
+    }
+
     @Override
     public void clear() {
         Arrays.fill(sum, 0);
@@ -97,6 +125,11 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_DOUBLE;
+    }
+
     @Override
     public double getDouble(@Nullable Record rec) {
         double sum = 0;
@@ -126,7 +159,17 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -136,6 +179,17 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
         types.add(ColumnType.LONG);
     }
 
+    @Override
+    public boolean supportsBlockStats() {
+        // sum of block sums differs from the sum of the rows in the last bits
+        return false;
+    }
+
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
         double sum = 0;
@@ -144,6 +198,16 @@ public class SumDoubleVectorAggregateFunction extends DoubleFunction implements
             sum += this.sum[i * SUM_PADDING];
             count += this.count[i * COUNT_PADDING];
         }
-        return Rosti.keyedIntSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumDoubleWrapUp(pRosti, valueOffset, sum, count);
+            case GKK_STR:
+                return Rosti.keyedStrSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+            default:
+                return Rosti.keyedIntSumDoubleWrapUp(pRosti, valueOffset, sum, count);
+        }
     }
 }
@@ -36,19 +36,37 @@ import io.questdb.std.Vect;
 import java.util.concurrent.atomic.LongAdder;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class SumIntVectorAggregateFunction extends LongFunction implements VectorAggregateFunction {
     private final int columnIndex;
     private final LongAdder count = new LongAdder();
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final LongAdder sum = new LongAdder();
     private int valueOffset;
 
     public SumIntVectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumInt;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumInt;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumInt;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumInt;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumInt;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumInt;
@@ -76,6 +94,15 @@ public class SumIntVectorAggregateFunction extends LongFunction implements Vecto
         }
     }
 
+    @Override
+    public void aggregateStats(long pStats, int workerId) {
+        final long value = Unsafe.getUnsafe().getLong(pStats + STATS_SUM_OFFSET);
+        if (value != Numbers.LONG_NaN) {
+            sum.add(value);
+            this.count.increment();
+        }
+    }
+
     @Override
     public void clear() {
         this.sum.reset();
@@ -87,6 +114,11 @@ public class SumIntVectorAggregateFunction extends LongFunction implements Vecto
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_INT;
+    }
+
     @Override
     public long getLong(Record rec) {
         return this.count.sum() > 0 ? this.sum.sum() : Numbers.LONG_NaN;
@@ -110,7 +142,17 @@ public class SumIntVectorAggregateFunction extends LongFunction implements Vecto
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumIntMerge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumIntMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumIntMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumIntMerge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -120,8 +162,23 @@ public class SumIntVectorAggregateFunction extends LongFunction implements Vecto
         types.add(ColumnType.LONG);
     }
 
+    @Override
+    public boolean supportsStats() {
+        return true;
+    }
+
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            case GKK_STR:
+                return Rosti.keyedStrSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+            default:
+                return Rosti.keyedIntSumLongWrapUp(pRosti, valueOffset, sum.sum(), count.sum());
+        }
     }
 }
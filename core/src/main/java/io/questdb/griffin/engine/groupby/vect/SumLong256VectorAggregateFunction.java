@@ -36,12 +36,17 @@ import io.questdb.std.str.CharSink;
 import java.util.concurrent.atomic.LongAdder;
 
 import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
 
 public class SumLong256VectorAggregateFunction extends Long256Function implements VectorAggregateFunction {
     private static final ThreadLocal<Long256Impl> partialSums = new ThreadLocal<>(Long256Impl::new);
     private final int columnIndex;
     private final LongAdder count = new LongAdder();
     private final DistinctFunc distinctFunc;
+    private final int keyKind;
     private final KeyValueFunc keyValueFunc;
     private final SimpleSpinLock lock = new SimpleSpinLock();
     private final Long256Impl sumA = new Long256Impl();
@@ -50,9 +55,22 @@ public class SumLong256VectorAggregateFunction extends Long256Function implement
 
     public SumLong256VectorAggregateFunction(int keyKind, int columnIndex, int workerCount) {
         this.columnIndex = columnIndex;
+        this.keyKind = keyKind;
         if (keyKind == GKK_HOUR_INT) {
             distinctFunc = Rosti::keyedHourDistinct;
             keyValueFunc = Rosti::keyedHourSumLong256;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairSumLong256;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongSumLong256;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128SumLong256;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrSumLong256;
         } else {
             distinctFunc = Rosti::keyedIntDistinct;
             keyValueFunc = Rosti::keyedIntSumLong256;
@@ -97,6 +115,11 @@ public class SumLong256VectorAggregateFunction extends Long256Function implement
         return columnIndex;
     }
 
+    @Override
+    public int getKeyedAggOp() {
+        return Rosti.AGG_SUM_LONG256;
+    }
+
     @Override
     public void getLong256(Record rec, CharSink<?> sink) {
         Long256Impl v = (Long256Impl) getLong256A(rec);
@@ -141,7 +164,17 @@ public class SumLong256VectorAggregateFunction extends Long256Function implement
 
     @Override
     public boolean merge(long pRostiA, long pRostiB) {
-        return Rosti.keyedIntSumLong256Merge(pRostiA, pRostiB, valueOffset);
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumLong256Merge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumLong256Merge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrSumLong256Merge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntSumLong256Merge(pRostiA, pRostiB, valueOffset);
+        }
     }
 
     @Override
@@ -153,7 +186,17 @@ public class SumLong256VectorAggregateFunction extends Long256Function implement
 
     @Override
     public boolean wrapUp(long pRosti) {
-        return Rosti.keyedIntSumLong256WrapUp(pRosti, valueOffset, sumA.getLong0(), sumA.getLong1(), sumA.getLong2(), sumA.getLong3(), count.sum());
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongSumLong256WrapUp(pRosti, valueOffset, sumA.getLong0(), sumA.getLong1(), sumA.getLong2(), sumA.getLong3(), count.sum());
+            case GKK_LONG128:
+                return Rosti.keyedLong128SumLong256WrapUp(pRosti, valueOffset, sumA.getLong0(), sumA.getLong1(), sumA.getLong2(), sumA.getLong3(), count.sum());
+            case GKK_STR:
+                return Rosti.keyedStrSumLong256WrapUp(pRosti, valueOffset, sumA.getLong0(), sumA.getLong1(), sumA.getLong2(), sumA.getLong3(), count.sum());
+            default:
+                return Rosti.keyedIntSumLong256WrapUp(pRosti, valueOffset, sumA.getLong0(), sumA.getLong1(), sumA.getLong2(), sumA.getLong3(), count.sum());
+        }
     }
 
     private Long256Impl sumLong256(Long256Impl sum, long address, long count) {
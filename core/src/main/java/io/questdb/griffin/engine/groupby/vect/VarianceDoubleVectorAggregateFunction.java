@@ -0,0 +1,243 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.groupby.vect;
+
+import io.questdb.cairo.ArrayColumnTypes;
+import io.questdb.cairo.ColumnType;
+import io.questdb.cairo.sql.Record;
+import io.questdb.griffin.engine.functions.DoubleFunction;
+import io.questdb.std.*;
+
+import static io.questdb.griffin.SqlCodeGenerator.GKK_HOUR_INT;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_INT_PAIR;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_LONG128;
+import static io.questdb.griffin.SqlCodeGenerator.GKK_STR;
+
+/**
+ * var_pop, var_samp, stddev_pop and stddev_samp of a double column. Values are accumulated with
+ * Welford's algorithm as (mean, m2, count) of finite values, per worker states and map slots are
+ * combined with the pairwise update of Chan et al. Two-column covar_pop, covar_samp and corr have no
+ * vector counterpart.
+ */
+public class VarianceDoubleVectorAggregateFunction extends DoubleFunction implements VectorAggregateFunction {
+    private static final long COUNT_OFFSET = 2 * Double.BYTES;
+    private static final long M2_OFFSET = Double.BYTES;
+    private final int columnIndex;
+    private final DistinctFunc distinctFunc;
+    private final int keyKind;
+    private final KeyValueFunc keyValueFunc;
+    private final String name;
+    private final boolean sample;
+    private final boolean stddev;
+    private final int workerCount;
+    private long count;
+    private double m2;
+    private double mean;
+    private long states;
+    private int valueOffset;
+
+    public VarianceDoubleVectorAggregateFunction(
+            int keyKind,
+            int columnIndex,
+            int workerCount,
+            String name,
+            boolean sample,
+            boolean stddev
+    ) {
+        this.columnIndex = columnIndex;
+        this.name = name;
+        this.sample = sample;
+        this.stddev = stddev;
+        this.keyKind = keyKind;
+        if (keyKind == GKK_HOUR_INT) {
+            distinctFunc = Rosti::keyedHourDistinct;
+            keyValueFunc = Rosti::keyedHourVarianceDouble;
+        } else if (keyKind == GKK_INT_PAIR) {
+            distinctFunc = Rosti::keyedIntPairDistinct;
+            keyValueFunc = Rosti::keyedIntPairVarianceDouble;
+        } else if (keyKind == GKK_LONG) {
+            distinctFunc = Rosti::keyedLongDistinct;
+            keyValueFunc = Rosti::keyedLongVarianceDouble;
+        } else if (keyKind == GKK_LONG128) {
+            distinctFunc = Rosti::keyedLong128Distinct;
+            keyValueFunc = Rosti::keyedLong128VarianceDouble;
+        } else if (keyKind == GKK_STR) {
+            distinctFunc = Rosti::keyedStrDistinct;
+            keyValueFunc = Rosti::keyedStrVarianceDouble;
+        } else {
+            distinctFunc = Rosti::keyedIntDistinct;
+            keyValueFunc = Rosti::keyedIntVarianceDouble;
+        }
+        states = Unsafe.malloc((long) workerCount * Misc.CACHE_LINE_SIZE, MemoryTag.NATIVE_FUNC_RSS);
+        this.workerCount = workerCount;
+        clear();
+    }
+
+    public static VarianceDoubleVectorAggregateFunction newStdDevPop(int keyKind, int columnIndex, int workerCount) {
+        return new VarianceDoubleVectorAggregateFunction(keyKind, columnIndex, workerCount, "stddev_pop", false, true);
+    }
+
+    public static VarianceDoubleVectorAggregateFunction newStdDevSamp(int keyKind, int columnIndex, int workerCount) {
+        return new VarianceDoubleVectorAggregateFunction(keyKind, columnIndex, workerCount, "stddev_samp", true, true);
+    }
+
+    public static VarianceDoubleVectorAggregateFunction newVarPop(int keyKind, int columnIndex, int workerCount) {
+        return new VarianceDoubleVectorAggregateFunction(keyKind, columnIndex, workerCount, "var_pop", false, false);
+    }
+
+    public static VarianceDoubleVectorAggregateFunction newVarSamp(int keyKind, int columnIndex, int workerCount) {
+        return new VarianceDoubleVectorAggregateFunction(keyKind, columnIndex, workerCount, "var_samp", true, false);
+    }
+
+    @Override
+    public void aggregate(long address, long addressSize, int columnSizeHint, int workerId) {
+        if (address != 0) {
+            Vect.varianceDouble(address, addressSize / Double.BYTES, states + (long) workerId * Misc.CACHE_LINE_SIZE);
+        }
+    }
+
+    @Override
+    public boolean aggregate(long pRosti, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId) {
+        if (valueAddress == 0) {
+            return distinctFunc.run(pRosti, keyAddress, valueAddressSize / Double.BYTES);
+        } else {
+            return keyValueFunc.run(pRosti, keyAddress, valueAddress, valueAddressSize / Double.BYTES, valueOffset);
+        }
+    }
+
+    @Override
+    public void clear() {
+        Vect.memset(states, (long) workerCount * Misc.CACHE_LINE_SIZE, 0);
+    }
+
+    @Override
+    public void close() {
+        if (states != 0) {
+            Unsafe.free(states, (long) workerCount * Misc.CACHE_LINE_SIZE, MemoryTag.NATIVE_FUNC_RSS);
+            states = 0;
+        }
+        super.close();
+    }
+
+    @Override
+    public int getColumnIndex() {
+        return columnIndex;
+    }
+
+    @Override
+    public double getDouble(Record rec) {
+        mergeStates();
+        final long divisor = sample ? count - 1 : count;
+        if (divisor > 0) {
+            final double variance = m2 / divisor;
+            return stddev ? Math.sqrt(variance) : variance;
+        }
+        return Double.NaN;
+    }
+
+    @Override
+    public String getName() {
+        return name;
+    }
+
+    @Override
+    public int getValueOffset() {
+        return valueOffset;
+    }
+
+    @Override
+    public void initRosti(long pRosti) {
+        Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, valueOffset), 0.0);
+        Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, valueOffset + 1), 0.0);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, valueOffset + 2), 0);
+    }
+
+    @Override
+    public boolean isReadThreadSafe() {
+        return false;
+    }
+
+    @Override
+    public boolean merge(long pRostiA, long pRostiB) {
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongVarianceDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_LONG128:
+                return Rosti.keyedLong128VarianceDoubleMerge(pRostiA, pRostiB, valueOffset);
+            case GKK_STR:
+                return Rosti.keyedStrVarianceDoubleMerge(pRostiA, pRostiB, valueOffset);
+            default:
+                return Rosti.keyedIntVarianceDoubleMerge(pRostiA, pRostiB, valueOffset);
+        }
+    }
+
+    @Override
+    public void pushValueTypes(ArrayColumnTypes types) {
+        this.valueOffset = types.getColumnCount();
+        types.add(ColumnType.DOUBLE); // mean
+        types.add(ColumnType.DOUBLE); // m2
+        types.add(ColumnType.LONG); // count
+    }
+
+    @Override
+    public boolean wrapUp(long pRosti) {
+        mergeStates();
+        switch (keyKind) {
+            case GKK_INT_PAIR:
+            case GKK_LONG:
+                return Rosti.keyedLongVarianceDoubleWrapUp(pRosti, valueOffset, mean, m2, count, sample, stddev);
+            case GKK_LONG128:
+                return Rosti.keyedLong128VarianceDoubleWrapUp(pRosti, valueOffset, mean, m2, count, sample, stddev);
+            case GKK_STR:
+                return Rosti.keyedStrVarianceDoubleWrapUp(pRosti, valueOffset, mean, m2, count, sample, stddev);
+            default:
+                return Rosti.keyedIntVarianceDoubleWrapUp(pRosti, valueOffset, mean, m2, count, sample, stddev);
+        }
+    }
+
+    // merged in locals, partition maps are wrapped up concurrently and must not see partial state
+    private void mergeStates() {
+        double mean = 0;
+        double m2 = 0;
+        long count = 0;
+        for (int i = 0; i < workerCount; i++) {
+            final long p = states + (long) i * Misc.CACHE_LINE_SIZE;
+            final long countB = Unsafe.getUnsafe().getLong(p + COUNT_OFFSET);
+            if (countB > 0) {
+                final double meanB = Unsafe.getUnsafe().getDouble(p);
+                final long n = count + countB;
+                final double delta = meanB - mean;
+                mean += delta * countB / n;
+                m2 += Unsafe.getUnsafe().getDouble(p + M2_OFFSET) + delta * delta * count * countB / n;
+                count = n;
+            }
+        }
+        this.mean = mean;
+        this.m2 = m2;
+        this.count = count;
+    }
+}
@@ -43,8 +43,12 @@ public class VectorAggregateEntry implements Mutable {
     private long keyAddress;
     private AtomicInteger oomCounter;
     private long[] pRosti;
+    // not null for a task of the partitioned merge of maps
+    private RostiPartitionMerge partitionMerge;
+    private int partitionTaskIndex;
     private PerWorkerLocks perWorkerLocks;
     private RostiAllocFacade raf;
+    private RostiSpill[] spills;
     private long valueAddress;
     private long valueCount;
 
@@ -53,9 +57,21 @@ public class VectorAggregateEntry implements Mutable {
         this.valueAddress = 0;
         this.valueCount = 0;
         this.func = null;
+        this.partitionMerge = null;
     }
 
     public void run(int workerId, Sequence seq, long cursor) {
+        if (partitionMerge != null) {
+            final RostiPartitionMerge partitionMerge = this.partitionMerge;
+            final int partitionTaskIndex = this.partitionTaskIndex;
+            final AtomicInteger oomCounter = this.oomCounter;
+            final ExecutionCircuitBreaker circuitBreaker = this.circuitBreaker;
+            final CountDownLatchSPI doneLatch = this.doneLatch;
+            seq.done(cursor);
+            run(partitionMerge, partitionTaskIndex, oomCounter, circuitBreaker, doneLatch);
+            return;
+        }
+
         long keyAddress = this.keyAddress;
         long valueAddress = this.valueAddress;
         long valueCount = this.valueCount;
@@ -67,9 +83,10 @@ public class VectorAggregateEntry implements Mutable {
         ExecutionCircuitBreaker circuitBreaker = this.circuitBreaker;
         CountDownLatchSPI doneLatch = this.doneLatch;
         PerWorkerLocks perWorkerLocks = this.perWorkerLocks;
+        RostiSpill[] spills = this.spills;
 
         seq.done(cursor);
-        run(workerId, keyAddress, valueAddress, valueCount, columnSizeShr, oomCounter, pRosti, raf, func, perWorkerLocks, circuitBreaker, doneLatch);
+        run(workerId, keyAddress, valueAddress, valueCount, columnSizeShr, oomCounter, pRosti, raf, spills, func, perWorkerLocks, circuitBreaker, doneLatch);
     }
 
     private static void run(
@@ -81,6 +98,7 @@ public class VectorAggregateEntry implements Mutable {
             AtomicInteger oomCounter,
             long[] pRosti,
             RostiAllocFacade raf,
+            @Nullable RostiSpill[] spills,
             VectorAggregateFunction func,
             PerWorkerLocks perWorkerLocks,
             ExecutionCircuitBreaker circuitBreaker,
@@ -101,6 +119,9 @@ public class VectorAggregateEntry implements Mutable {
                     }
                 }
                 raf.updateMemoryUsage(pRosti[slot], oldSize);
+                if (spills != null) {
+                    spills[slot].spillIfOverThreshold(pRosti[slot], raf);
+                }
             } else {
                 func.aggregate(valueAddress, valueCount, columnSizeShr, slot);
             }
@@ -110,6 +131,36 @@ public class VectorAggregateEntry implements Mutable {
         }
     }
 
+    private static void run(
+            RostiPartitionMerge partitionMerge,
+            int taskIndex,
+            AtomicInteger oomCounter,
+            ExecutionCircuitBreaker circuitBreaker,
+            CountDownLatchSPI doneLatch
+    ) {
+        try {
+            if (!circuitBreaker.checkIfTripped() && oomCounter.get() == 0 && !partitionMerge.run(taskIndex)) {
+                oomCounter.incrementAndGet();
+            }
+        } finally {
+            doneLatch.countDown();
+        }
+    }
+
+    void of(
+            RostiPartitionMerge partitionMerge,
+            int taskIndex,
+            CountDownLatchSPI doneLatch,
+            AtomicInteger oomCounter,
+            ExecutionCircuitBreaker circuitBreaker
+    ) {
+        this.partitionMerge = partitionMerge;
+        this.partitionTaskIndex = taskIndex;
+        this.doneLatch = doneLatch;
+        this.oomCounter = oomCounter;
+        this.circuitBreaker = circuitBreaker;
+    }
+
     void of(
             VectorAggregateFunction vaf,
             long[] pRosti,
@@ -121,10 +172,13 @@ public class VectorAggregateEntry implements Mutable {
             // oom is not possible when aggregation is not keyed
             @Nullable AtomicInteger oomCounter,
             RostiAllocFacade raf,
+            // null when maps are not to be spilled to disk
+            @Nullable RostiSpill[] spills,
             PerWorkerLocks perWorkerLocks,
             ExecutionCircuitBreaker circuitBreaker
     ) {
         this.pRosti = pRosti;
+        this.partitionMerge = null;
         this.keyAddress = keyPageAddress;
         this.valueAddress = valuePageAddress;
         this.valueCount = valuePageCount;
@@ -133,6 +187,7 @@ public class VectorAggregateEntry implements Mutable {
         this.doneLatch = doneLatch;
         this.oomCounter = oomCounter;
         this.raf = raf;
+        this.spills = spills;
         this.perWorkerLocks = perWorkerLocks;
         this.circuitBreaker = circuitBreaker;
     }
@@ -30,6 +30,12 @@ import io.questdb.griffin.PlanSink;
 import io.questdb.std.Mutable;
 
 public interface VectorAggregateFunction extends Function, Mutable {
+    // offsets of page frame column statistics, see ColumnStatsVectorAggregateFunction
+    long STATS_COUNT_OFFSET = 0;
+    long STATS_MAX_OFFSET = 32;
+    long STATS_MIN_OFFSET = 24;
+    long STATS_NULL_COUNT_OFFSET = 8;
+    long STATS_SUM_OFFSET = 16;
 
     /**
      * Non-keyed aggregation that doesn't use rosti.
@@ -58,8 +64,31 @@ public interface VectorAggregateFunction extends Function, Mutable {
      */
     boolean aggregate(long pRosti, long keyAddress, long valueAddress, long valueAddressSize, int columnSizeShr, int workerId);
 
+    /**
+     * Non-keyed aggregation of a page frame from statistics of the column computed in a single pass,
+     * see {@link ColumnStatsVectorAggregateFunction}. It must have the same effect as aggregate() of the page frame.
+     * Called only when {@link #supportsStats()} returns true.
+     *
+     * @param pStats   address of column statistics, values are at STATS_*_OFFSET
+     * @param workerId worker id
+     */
+    default void aggregateStats(long pStats, int workerId) {
+        throw new UnsupportedOperationException();
+    }
+
     int getColumnIndex();
 
+    /**
+     * Aggregate op of Rosti.keyed*MultiAgg() that has the same effect as the keyed aggregate() of this
+     * function, so that functions of the same column can be computed in a single pass over the keys,
+     * see {@link FusedVectorAggregateFunction}.
+     *
+     * @return one of Rosti.AGG_* constants or -1 when function cannot be fused
+     */
+    default int getKeyedAggOp() {
+        return -1;
+    }
+
     // value offset in map
     int getValueOffset();
 
@@ -81,6 +110,25 @@ public interface VectorAggregateFunction extends Function, Mutable {
 
     void pushValueTypes(ArrayColumnTypes types);
 
+    /**
+     * @return true when the function can be computed from page frame column statistics, so that it
+     * can share a single column scan with other functions of the same column
+     */
+    default boolean supportsStats() {
+        return false;
+    }
+
+    /**
+     * Zone map blocks are aggregated from their statistics in a different order than the rows of a scan,
+     * so the function must have a result that does not depend on the order, e.g. count, min, max or an
+     * integer sum.
+     *
+     * @return true when the function can be computed from zone map block statistics instead of the rows
+     */
+    default boolean supportsBlockStats() {
+        return supportsStats();
+    }
+
     @Override
     default void toPlan(PlanSink sink) {
         sink.val(getName()).val('(').putColumnName(getColumnIndex()).val(')');
@@ -47,13 +47,15 @@ public class AsyncFilterAtom implements StatefulAtom, Closeable, Plannable {
     private final ObjList<Function> perWorkerFilters;
     private final PerWorkerLocks perWorkerLocks;
     private final IntList preTouchColumnTypes;
+    private final ZoneMapFilter zoneMapFilter;
     private boolean preTouchEnabled;
 
     public AsyncFilterAtom(
             @NotNull CairoConfiguration configuration,
             @NotNull Function filter,
             @Nullable ObjList<Function> perWorkerFilters,
-            @Nullable IntList preTouchColumnTypes
+            @Nullable IntList preTouchColumnTypes,
+            @Nullable ZoneMapFilter zoneMapFilter
     ) {
         this.filter = filter;
         this.perWorkerFilters = perWorkerFilters;
@@ -63,6 +65,7 @@ public class AsyncFilterAtom implements StatefulAtom, Closeable, Plannable {
             perWorkerLocks = null;
         }
         this.preTouchColumnTypes = preTouchColumnTypes;
+        this.zoneMapFilter = zoneMapFilter;
     }
 
     public int acquireFilter(int workerId, boolean owner, SqlExecutionCircuitBreaker circuitBreaker) {
@@ -210,6 +213,11 @@ public class AsyncFilterAtom implements StatefulAtom, Closeable, Plannable {
         }
     }
 
+    @Override
+    public boolean skipFrame(PageFrame frame) {
+        return zoneMapFilter != null && zoneMapFilter.skipFrame(frame);
+    }
+
     @Override
     public void toPlan(PlanSink sink) {
         sink.val(filter);
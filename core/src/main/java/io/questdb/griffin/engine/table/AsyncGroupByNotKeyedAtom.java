@@ -38,10 +38,7 @@ import io.questdb.griffin.engine.PerWorkerLocks;
 import io.questdb.griffin.engine.functions.GroupByFunction;
 import io.questdb.griffin.engine.groupby.*;
 import io.questdb.jit.CompiledFilter;
-import io.questdb.std.BytecodeAssembler;
-import io.questdb.std.Misc;
-import io.questdb.std.ObjList;
-import io.questdb.std.Transient;
+import io.questdb.std.*;
 import org.jetbrains.annotations.NotNull;
 import org.jetbrains.annotations.Nullable;
 
@@ -51,17 +48,22 @@ import static io.questdb.griffin.engine.table.AsyncJitFilteredRecordCursorFactor
 
 public class AsyncGroupByNotKeyedAtom implements StatefulAtom, Closeable, Plannable {
 
+    private final boolean batchComputable;
+    private final long batchScratchSize;
     private final ObjList<Function> bindVarFunctions;
     private final MemoryCARW bindVarMemory;
     private final CompiledFilter compiledFilter;
     private final Function filter;
     private final GroupByFunctionsUpdater functionUpdater;
+    private final ObjList<GroupByFunction> groupByFunctions;
     private final SimpleMapValue mapValue;
     private final ObjList<Function> perWorkerFilters;
     private final ObjList<GroupByFunctionsUpdater> perWorkerFunctionUpdaters;
     private final ObjList<ObjList<GroupByFunction>> perWorkerGroupByFunctions;
     private final PerWorkerLocks perWorkerLocks;
     private final ObjList<SimpleMapValue> perWorkerMapValues;
+    // per-slot native scratch for batch aggregation, the owner thread uses the last slot
+    private long batchScratch;
 
     public AsyncGroupByNotKeyedAtom(
             @Transient @NotNull BytecodeAssembler asm,
@@ -84,6 +86,7 @@ public class AsyncGroupByNotKeyedAtom implements StatefulAtom, Closeable, Planna
             this.bindVarFunctions = bindVarFunctions;
             this.filter = filter;
             this.perWorkerFilters = perWorkerFilters;
+            this.groupByFunctions = groupByFunctions;
             this.perWorkerGroupByFunctions = perWorkerGroupByFunctions;
 
             functionUpdater = GroupByFunctionsUpdaterFactory.getInstance(asm, groupByFunctions);
@@ -102,6 +105,18 @@ public class AsyncGroupByNotKeyedAtom implements StatefulAtom, Closeable, Planna
             for (int i = 0; i < workerCount; i++) {
                 perWorkerMapValues.extendAndSet(i, new SimpleMapValue(valueCount));
             }
+
+            boolean batchComputable = filter != null;
+            for (int i = 0, n = groupByFunctions.size(); i < n && batchComputable; i++) {
+                batchComputable = groupByFunctions.getQuick(i).getArgColumnIndex() > -1;
+            }
+            this.batchComputable = batchComputable;
+            if (batchComputable) {
+                batchScratchSize = (long) (workerCount + 1) * Misc.CACHE_LINE_SIZE;
+                batchScratch = Unsafe.malloc(batchScratchSize, MemoryTag.NATIVE_FUNC_RSS);
+            } else {
+                batchScratchSize = 0;
+            }
             clear();
         } catch (Throwable e) {
             close();
@@ -145,6 +160,14 @@ public class AsyncGroupByNotKeyedAtom implements StatefulAtom, Closeable, Planna
                 Misc.freeObjList(perWorkerGroupByFunctions.getQuick(i));
             }
         }
+        if (batchScratch != 0) {
+            batchScratch = Unsafe.free(batchScratch, batchScratchSize, MemoryTag.NATIVE_FUNC_RSS);
+        }
+    }
+
+    public long getBatchScratch(int slotId) {
+        final int index = slotId == -1 ? perWorkerMapValues.size() : slotId;
+        return batchScratch + (long) index * Misc.CACHE_LINE_SIZE;
     }
 
     public ObjList<Function> getBindVarFunctions() {
@@ -173,6 +196,13 @@ public class AsyncGroupByNotKeyedAtom implements StatefulAtom, Closeable, Planna
         return perWorkerFunctionUpdaters.getQuick(slotId);
     }
 
+    public ObjList<GroupByFunction> getGroupByFunctions(int slotId) {
+        if (slotId == -1 || perWorkerGroupByFunctions == null) {
+            return groupByFunctions;
+        }
+        return perWorkerGroupByFunctions.getQuick(slotId);
+    }
+
     public SimpleMapValue getMapValue(int slotId) {
         if (slotId == -1) {
             return mapValue;
@@ -236,6 +266,14 @@ public class AsyncGroupByNotKeyedAtom implements StatefulAtom, Closeable, Planna
         }
     }
 
+    /**
+     * Returns true when the query has a filter and every group-by function aggregates a plain
+     * INT, LONG or DOUBLE column, so that filtered rows can be aggregated with native kernels.
+     */
+    public boolean isBatchComputable() {
+        return batchComputable;
+    }
+
     public void release(int slotId) {
         perWorkerLocks.releaseSlot(slotId);
     }
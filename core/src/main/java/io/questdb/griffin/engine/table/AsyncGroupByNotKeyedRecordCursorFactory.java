@@ -202,6 +202,26 @@ public class AsyncGroupByNotKeyedRecordCursorFactory extends AbstractRecordCurso
         }
     }
 
+    private static void aggregateFilteredBatch(
+            PageAddressCache pageAddressCache,
+            int frameIndex,
+            DirectLongList rows,
+            SimpleMapValue value,
+            ObjList<GroupByFunction> groupByFunctions,
+            long pScratch
+    ) {
+        final long rowCount = rows.size();
+        if (rowCount == 0) {
+            return;
+        }
+        for (int i = 0, n = groupByFunctions.size(); i < n; i++) {
+            final GroupByFunction function = groupByFunctions.getQuick(i);
+            final long ptr = pageAddressCache.getPageAddress(frameIndex, function.getArgColumnIndex());
+            function.computeBatch(value, ptr, rows.getAddress(), rowCount, pScratch);
+        }
+        value.setNew(false);
+    }
+
     private static void filterAndAggregate(
             int workerId,
             @NotNull PageAddressCacheRecord record,
@@ -223,14 +243,27 @@ public class AsyncGroupByNotKeyedRecordCursorFactory extends AbstractRecordCurso
         final CompiledFilter compiledFilter = atom.getCompiledFilter();
         final Function filter = atom.getFilter(slotId);
         try {
-            if (compiledFilter == null || pageAddressCache.hasColumnTops(task.getFrameIndex())) {
+            final boolean hasColumnTops = pageAddressCache.hasColumnTops(task.getFrameIndex());
+            if (compiledFilter == null || hasColumnTops) {
                 // Use Java-based filter when there is no compiled filter or in case of a page frame with column tops.
                 applyFilter(filter, rows, record, task.getFrameRowCount());
             } else {
                 applyCompiledFilter(compiledFilter, atom.getBindVarMemory(), atom.getBindVarFunctions(), task);
             }
 
-            aggregateFiltered(record, rows, value, functionUpdater);
+            if (atom.isBatchComputable() && !hasColumnTops) {
+                // All functions read plain columns, so aggregate the selected rows straight from the page frame.
+                aggregateFilteredBatch(
+                        pageAddressCache,
+                        task.getFrameIndex(),
+                        rows,
+                        value,
+                        atom.getGroupByFunctions(slotId),
+                        atom.getBatchScratch(slotId)
+                );
+            } else {
+                aggregateFiltered(record, rows, value, functionUpdater);
+            }
         } finally {
             atom.release(slotId);
         }
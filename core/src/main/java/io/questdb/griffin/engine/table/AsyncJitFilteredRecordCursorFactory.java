@@ -79,7 +79,8 @@ public class AsyncJitFilteredRecordCursorFactory extends AbstractRecordCursorFac
             @Nullable Function limitLoFunction,
             int limitLoPos,
             boolean preTouchColumns,
-            int workerCount
+            int workerCount,
+            @Nullable ZoneMapFilter zoneMapFilter
     ) {
         super(base.getMetadata());
         assert !(base instanceof FilteredRecordCursorFactory);
@@ -110,7 +111,8 @@ public class AsyncJitFilteredRecordCursorFactory extends AbstractRecordCursorFac
                 compiledFilter,
                 bindVarMemory,
                 bindVarFunctions,
-                preTouchColumnTypes
+                preTouchColumnTypes,
+                zoneMapFilter
         );
         this.frameSequence = new PageFrameSequence<>(configuration, messageBus, atom, REDUCER, reduceTaskFactory, PageFrameReduceTask.TYPE_FILTER);
         this.limitLoFunction = limitLoFunction;
@@ -414,9 +416,10 @@ public class AsyncJitFilteredRecordCursorFactory extends AbstractRecordCursorFac
                 CompiledFilter compiledFilter,
                 MemoryCARW bindVarMemory,
                 ObjList<Function> bindVarFunctions,
-                @Nullable IntList preTouchColumnTypes
+                @Nullable IntList preTouchColumnTypes,
+                @Nullable ZoneMapFilter zoneMapFilter
         ) {
-            super(configuration, filter, perWorkerFilters, preTouchColumnTypes);
+            super(configuration, filter, perWorkerFilters, preTouchColumnTypes, zoneMapFilter);
             this.compiledFilter = compiledFilter;
             this.bindVarMemory = bindVarMemory;
             this.bindVarFunctions = bindVarFunctions;
@@ -26,6 +26,7 @@ package io.questdb.griffin.engine.table;
 
 import io.questdb.cairo.BitmapIndexReader;
 import io.questdb.cairo.TableReader;
+import io.questdb.cairo.ZoneMapReader;
 import io.questdb.cairo.sql.*;
 import io.questdb.cairo.vm.NullMemoryMR;
 import io.questdb.cairo.vm.api.MemoryR;
@@ -247,5 +248,10 @@ public class FwdTableReaderPageFrameCursor implements PageFrameCursor {
         public long getPartitionLo() {
             return partitionLo;
         }
+
+        @Override
+        public @Nullable ZoneMapReader getZoneMap(int columnIndex) {
+            return reader.getZoneMap(partitionIndex, columnIndexes.getQuick(columnIndex));
+        }
     }
 }
@@ -27,6 +27,7 @@ package io.questdb.griffin.engine.table;
 import io.questdb.cairo.AbstractRecordCursorFactory;
 import io.questdb.cairo.BitmapIndexReader;
 import io.questdb.cairo.TableToken;
+import io.questdb.cairo.ZoneMapReader;
 import io.questdb.cairo.sql.*;
 import io.questdb.griffin.PlanSink;
 import io.questdb.griffin.SqlException;
@@ -175,6 +176,11 @@ public class SelectedRecordCursorFactory extends AbstractRecordCursorFactory {
             return baseFrame.getPartitionLo();
         }
 
+        @Override
+        public @Nullable ZoneMapReader getZoneMap(int columnIndex) {
+            return baseFrame.getZoneMap(columnCrossIndex.getQuick(columnIndex));
+        }
+
         public SelectedPageFrame of(PageFrame basePageFrame) {
             this.baseFrame = basePageFrame;
             return this;
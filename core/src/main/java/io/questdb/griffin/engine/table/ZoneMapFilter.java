@@ -0,0 +1,270 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.griffin.engine.table;
+
+import io.questdb.cairo.ColumnType;
+import io.questdb.cairo.ZoneMapReader;
+import io.questdb.cairo.sql.PageFrame;
+import io.questdb.cairo.sql.RecordMetadata;
+import io.questdb.griffin.SqlKeywords;
+import io.questdb.griffin.model.ExpressionNode;
+import io.questdb.std.*;
+import org.jetbrains.annotations.Nullable;
+
+/**
+ * Conjunction of "column op constant" predicates of a filter, where op is one of =, &lt;, &lt;=, &gt;, &gt;=,
+ * checked against zone maps of page frame columns. A frame can be skipped when one of the predicates
+ * cannot match any row of the frame. The rest of the filter is ignored, so the filter itself still has
+ * to be applied to the frames that are not skipped.
+ * <p>
+ * Null values never match these predicates, hence blocks with no values and frames of column tops
+ * are skipped too.
+ */
+public class ZoneMapFilter {
+    // absolute tolerance of double comparisons, it is looser than the one of double equality
+    // to never skip a frame with a matching value
+    private static final double EPSILON = 1e-9;
+    private static final int OP_EQ = 0;
+    private static final int OP_GE = 4;
+    private static final int OP_GT = 3;
+    private static final int OP_LE = 2;
+    private static final int OP_LT = 1;
+    private final IntList columnIndexes = new IntList();
+    private final IntList columnTypes = new IntList();
+    private final BoolList doubleComparisons = new BoolList();
+    private final DoubleList doubleValues = new DoubleList();
+    private final LongList longValues = new LongList();
+    private final IntList ops = new IntList();
+
+    private ZoneMapFilter() {
+    }
+
+    /**
+     * @param filterExpr filter expression
+     * @param metadata   metadata of the filtered page frames
+     * @return zone map filter or null when the filter has no predicates that zone maps can answer
+     */
+    @Nullable
+    public static ZoneMapFilter of(@Nullable ExpressionNode filterExpr, RecordMetadata metadata) {
+        if (filterExpr == null) {
+            return null;
+        }
+        final ZoneMapFilter zoneMapFilter = new ZoneMapFilter();
+        zoneMapFilter.addConjuncts(filterExpr, metadata);
+        return zoneMapFilter.ops.size() > 0 ? zoneMapFilter : null;
+    }
+
+    public boolean skipFrame(PageFrame frame) {
+        for (int i = 0, n = ops.size(); i < n; i++) {
+            if (!mayMatch(frame, i)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private static int flip(int op) {
+        switch (op) {
+            case OP_LT:
+                return OP_GT;
+            case OP_LE:
+                return OP_GE;
+            case OP_GT:
+                return OP_LT;
+            case OP_GE:
+                return OP_LE;
+            default:
+                return op;
+        }
+    }
+
+    private static boolean isConstant(ExpressionNode node) {
+        if (node.type == ExpressionNode.CONSTANT) {
+            return true;
+        }
+        // unary minus
+        return node.type == ExpressionNode.OPERATION
+                && node.paramCount == 1
+                && Chars.equals(node.token, '-')
+                && node.rhs != null
+                && node.rhs.type == ExpressionNode.CONSTANT;
+    }
+
+    private static int opOf(CharSequence token) {
+        if (Chars.equals(token, '=')) {
+            return OP_EQ;
+        }
+        if (Chars.equals(token, '<')) {
+            return OP_LT;
+        }
+        if (Chars.equals(token, "<=")) {
+            return OP_LE;
+        }
+        if (Chars.equals(token, '>')) {
+            return OP_GT;
+        }
+        if (Chars.equals(token, ">=")) {
+            return OP_GE;
+        }
+        return -1;
+    }
+
+    private void addConjuncts(ExpressionNode node, RecordMetadata metadata) {
+        if (node.type != ExpressionNode.OPERATION || node.paramCount != 2 || node.lhs == null || node.rhs == null) {
+            return;
+        }
+        if (SqlKeywords.isAndKeyword(node.token)) {
+            addConjuncts(node.lhs, metadata);
+            addConjuncts(node.rhs, metadata);
+            return;
+        }
+        int op = opOf(node.token);
+        if (op == -1) {
+            return;
+        }
+        if (node.lhs.type == ExpressionNode.LITERAL && isConstant(node.rhs)) {
+            addPredicate(node.lhs, op, node.rhs, metadata);
+        } else if (node.rhs.type == ExpressionNode.LITERAL && isConstant(node.lhs)) {
+            addPredicate(node.rhs, flip(op), node.lhs, metadata);
+        }
+    }
+
+    private void addPredicate(ExpressionNode column, int op, ExpressionNode constant, RecordMetadata metadata) {
+        final int columnIndex = metadata.getColumnIndexQuiet(column.token);
+        if (columnIndex < 0) {
+            return;
+        }
+        final int columnType = metadata.getColumnType(columnIndex);
+        switch (ColumnType.tagOf(columnType)) {
+            case ColumnType.INT:
+            case ColumnType.LONG:
+            case ColumnType.TIMESTAMP:
+            case ColumnType.DOUBLE:
+                break;
+            default:
+                return;
+        }
+
+        final boolean negative = constant.type == ExpressionNode.OPERATION;
+        final CharSequence token = negative ? constant.rhs.token : constant.token;
+        long longValue = 0;
+        double doubleValue;
+        boolean doubleComparison = ColumnType.isDouble(columnType);
+        try {
+            longValue = Numbers.parseLong(token);
+            if (negative) {
+                longValue = -longValue;
+            }
+            doubleValue = longValue;
+            // null sentinels compare equal to nulls in some of the functions
+            if (longValue == Numbers.LONG_NaN || longValue == Numbers.INT_NaN) {
+                return;
+            }
+        } catch (NumericException e) {
+            try {
+                doubleValue = Numbers.parseDouble(token);
+            } catch (NumericException e2) {
+                return;
+            }
+            if (negative) {
+                doubleValue = -doubleValue;
+            }
+            doubleComparison = true;
+        }
+        if (!Double.isFinite(doubleValue)) {
+            return;
+        }
+
+        columnIndexes.add(columnIndex);
+        columnTypes.add(columnType);
+        ops.add(op);
+        longValues.add(longValue);
+        doubleValues.add(doubleValue);
+        doubleComparisons.add(doubleComparison);
+    }
+
+    private boolean mayMatch(PageFrame frame, int predicate) {
+        final int columnIndex = columnIndexes.getQuick(predicate);
+        if (frame.getPageAddress(columnIndex) == 0) {
+            // the frame is a column top, all values are null
+            return false;
+        }
+        final ZoneMapReader zoneMap = frame.getZoneMap(columnIndex);
+        if (zoneMap == null) {
+            return true;
+        }
+        final long columnTop = zoneMap.getColumnTop();
+        final int shift = zoneMap.getBlockRowsShift();
+        final long blockLo = (frame.getPartitionLo() - columnTop) >> shift;
+        final long blockHi = (frame.getPartitionHi() - columnTop - 1) >> shift;
+        if (blockLo < 0 || blockHi >= zoneMap.getBlockCount()) {
+            // some of the frame rows are not summarised
+            return true;
+        }
+        for (long block = blockLo; block <= blockHi; block++) {
+            if (mayMatch(zoneMap, block, predicate)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private boolean mayMatch(ZoneMapReader zoneMap, long block, int predicate) {
+        if (zoneMap.getCount(block) == 0) {
+            return false;
+        }
+        final int op = ops.getQuick(predicate);
+        if (doubleComparisons.get(predicate)) {
+            final boolean doubleColumn = ColumnType.isDouble(columnTypes.getQuick(predicate));
+            final double min = doubleColumn ? zoneMap.getMinDouble(block) : zoneMap.getMinLong(block);
+            final double max = doubleColumn ? zoneMap.getMaxDouble(block) : zoneMap.getMaxLong(block);
+            final double value = doubleValues.getQuick(predicate);
+            switch (op) {
+                case OP_EQ:
+                    return min - EPSILON <= value && value <= max + EPSILON;
+                case OP_LT:
+                case OP_LE:
+                    return min - EPSILON <= value;
+                default:
+                    return max + EPSILON >= value;
+            }
+        }
+        final long min = zoneMap.getMinLong(block);
+        final long max = zoneMap.getMaxLong(block);
+        final long value = longValues.getQuick(predicate);
+        switch (op) {
+            case OP_EQ:
+                return min <= value && value <= max;
+            case OP_LT:
+                return min < value;
+            case OP_LE:
+                return min <= value;
+            case OP_GT:
+                return max > value;
+            default:
+                return max >= value;
+        }
+    }
+}
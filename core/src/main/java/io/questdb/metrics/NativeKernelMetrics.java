@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.metrics;
+
+import io.questdb.std.Vect;
+import io.questdb.std.str.BorrowableUtf8Sink;
+import io.questdb.std.str.CharSink;
+import org.jetbrains.annotations.NotNull;
+
+/**
+ * Calls, processed bytes and latency histograms of the native kernels (O3, dedup, Rosti,
+ * vectorized aggregates and JIT filters). Counters are read from the native side on scrape
+ * and are written only while they are enabled, see {@link Vect#setPerformanceCountersEnabled(boolean)}.
+ */
+public class NativeKernelMetrics implements Scrapable {
+    private static final String BYTES = "native_kernel_bytes";
+    private static final String CALLS = "native_kernel_calls";
+    private static final String DURATION = "native_kernel_duration_seconds";
+    private static final String KERNEL_LABEL = "kernel";
+    private static final double NANOS_PER_SECOND = 1_000_000_000d;
+    // indexes of the native counters, unused counters have no name
+    private static final String[] names = new String[Vect.PERFORMANCE_COUNTER_COUNT];
+
+    @Override
+    public void scrapeIntoPrometheus(@NotNull BorrowableUtf8Sink sink) {
+        if (!Vect.isPerformanceCountersEnabled()) {
+            return;
+        }
+        final double ticksPerSecond = Vect.getPerformanceTicksPerSecond();
+        if (ticksPerSecond <= 0) {
+            return;
+        }
+
+        PrometheusFormatUtils.appendCounterType(CALLS, sink);
+        for (int i = 0; i < names.length; i++) {
+            final long calls = Vect.getPerformanceCounterCalls(i);
+            if (names[i] != null && calls > 0) {
+                appendSample(sink, CALLS, "_total", names[i], calls);
+            }
+        }
+        PrometheusFormatUtils.appendNewLine(sink);
+
+        PrometheusFormatUtils.appendCounterType(BYTES, sink);
+        for (int i = 0; i < names.length; i++) {
+            if (names[i] != null && Vect.getPerformanceCounterCalls(i) > 0) {
+                appendSample(sink, BYTES, "_total", names[i], Vect.getPerformanceCounterBytes(i));
+            }
+        }
+        PrometheusFormatUtils.appendNewLine(sink);
+
+        sink.putAscii(PrometheusFormatUtils.TYPE_PREFIX);
+        sink.putAscii(DURATION);
+        sink.putAscii(" histogram\n");
+        final int bucketCount = Vect.getPerformanceCounterBucketCount();
+        for (int i = 0; i < names.length; i++) {
+            final long calls = Vect.getPerformanceCounterCalls(i);
+            if (names[i] == null || calls == 0) {
+                continue;
+            }
+            long cumulativeCount = 0;
+            for (int b = 0; b < bucketCount - 1; b++) {
+                cumulativeCount += Vect.getPerformanceCounterBucket(i, b);
+                appendBucket(sink, names[i], (1L << (12 + 2 * b)) / ticksPerSecond, cumulativeCount);
+            }
+            // buckets and calls are read at different times, +Inf must not be less than the finite buckets
+            cumulativeCount += Vect.getPerformanceCounterBucket(i, bucketCount - 1);
+            appendBucket(sink, names[i], Double.POSITIVE_INFINITY, Math.max(calls, cumulativeCount));
+            appendSample(sink, DURATION, "_sum", names[i], Vect.getPerformanceCounter(i) / NANOS_PER_SECOND);
+            appendSample(sink, DURATION, "_count", names[i], Math.max(calls, cumulativeCount));
+        }
+        PrometheusFormatUtils.appendNewLine(sink);
+    }
+
+    private static void appendBucket(CharSink<?> sink, String kernel, double le, long value) {
+        appendName(sink, DURATION, "_bucket", kernel);
+        sink.putAscii(",le=\"");
+        if (le == Double.POSITIVE_INFINITY) {
+            sink.putAscii("+Inf");
+        } else {
+            sink.put(le);
+        }
+        sink.putAscii("\"}");
+        PrometheusFormatUtils.appendSampleLineSuffix(sink, value);
+    }
+
+    private static void appendName(CharSink<?> sink, String name, String suffix, String kernel) {
+        sink.putAscii(PrometheusFormatUtils.METRIC_NAME_PREFIX);
+        sink.putAscii(name);
+        sink.putAscii(suffix);
+        sink.putAscii('{');
+        PrometheusFormatUtils.appendLabel(sink, KERNEL_LABEL, kernel);
+    }
+
+    private static void appendSample(CharSink<?> sink, String name, String suffix, String kernel, long value) {
+        appendName(sink, name, suffix, kernel);
+        sink.putAscii('}');
+        PrometheusFormatUtils.appendSampleLineSuffix(sink, value);
+    }
+
+    private static void appendSample(CharSink<?> sink, String name, String suffix, String kernel, double value) {
+        appendName(sink, name, suffix, kernel);
+        sink.putAscii('}');
+        PrometheusFormatUtils.appendSampleLineSuffix(sink, value);
+    }
+
+    static {
+        // must match measure_time() call sites of ooo.cpp and counters of perf_counters.h
+        names[0] = "o3_merge_copy_str_column";
+        names[1] = "o3_sort_var_column_offsets";
+        names[2] = "o3_sort_var_column_data";
+        names[3] = "o3_merge_copy_bin_column";
+        names[4] = "o3_sort_long_index";
+        names[5] = "o3_index_reshuffle_32bit";
+        names[6] = "o3_index_reshuffle_64bit";
+        names[7] = "o3_index_reshuffle_16bit";
+        names[8] = "o3_index_reshuffle_8bit";
+        names[9] = "o3_merge_shuffle_8bit";
+        names[10] = "o3_merge_shuffle_16bit";
+        names[11] = "o3_merge_shuffle_32bit";
+        names[12] = "o3_merge_shuffle_64bit";
+        names[13] = "o3_merge_shuffle_fixed_columns";
+        names[14] = "o3_index_reshuffle_128bit";
+        names[15] = "o3_merge_shuffle_256bit";
+        names[17] = "o3_flatten_index";
+        names[18] = "o3_make_timestamp_index";
+        names[19] = "o3_set_memory_long";
+        names[20] = "o3_set_memory_int";
+        names[21] = "o3_set_memory_double";
+        names[22] = "o3_set_memory_float";
+        names[23] = "o3_set_memory_short";
+        names[24] = "o3_set_var_refs_32bit";
+        names[25] = "o3_set_var_refs_64bit";
+        names[26] = "o3_copy_index";
+        names[27] = "o3_shift_copy_fixed_column";
+        names[28] = "o3_copy_from_timestamp_index";
+        names[29] = "o3_merge_shuffle_128bit";
+        names[30] = "o3_index_reshuffle_256bit";
+        names[31] = "o3_shift_timestamp_index";
+        names[32] = "dedup_merge_timestamp";
+        names[33] = "dedup_merge_timestamp_keys";
+        names[34] = "dedup_sorted_timestamp_index";
+        names[35] = "dedup_merge_var_column_len";
+        names[36] = "rosti_keyed_count";
+        names[37] = "rosti_keyed_multi_agg";
+        names[38] = "rosti_keyed_dense_multi_agg";
+        names[39] = "rosti_complete_resize";
+        names[40] = "vec_agg_double";
+        names[41] = "vec_agg_float";
+        names[42] = "vec_agg_short";
+        names[43] = "vec_agg_byte";
+        names[44] = "vec_agg_char";
+        names[45] = "vec_agg_int";
+        names[46] = "vec_agg_long";
+        names[47] = "jit_compile";
+        names[48] = "jit_call";
+        names[49] = "vec_agg_long128";
+        names[50] = "rosti_keyed_agg";
+        names[51] = "rosti_keyed_dense_agg";
+        names[52] = "rosti_keyed_merge";
+        names[53] = "rosti_keyed_wrap_up";
+    }
+}
@@ -30,6 +30,31 @@ import org.jetbrains.annotations.TestOnly;
 import static io.questdb.std.Numbers.hexDigits;
 
 public final class Rosti {
+    // aggregate ops of keyed*MultiAgg(), slot layout of each op is that of the matching single aggregate function
+    public static final int AGG_COUNT = 0;
+    public static final int AGG_COUNT_DOUBLE = 1;
+    public static final int AGG_COUNT_INT = 2;
+    public static final int AGG_COUNT_LONG = 3;
+    public static final int AGG_DESCRIPTOR_SIZE = 16;
+    public static final int AGG_KSUM_DOUBLE = 5;
+    public static final int AGG_MAX_DOUBLE = 8;
+    public static final int AGG_MAX_INT = 11;
+    public static final int AGG_MAX_LONG = 15;
+    public static final int AGG_MAX_SHORT = 20;
+    public static final int AGG_MIN_DOUBLE = 7;
+    public static final int AGG_MIN_INT = 10;
+    public static final int AGG_MIN_LONG = 14;
+    public static final int AGG_MIN_SHORT = 19;
+    public static final int AGG_NSUM_DOUBLE = 6;
+    public static final int AGG_SUM_DOUBLE = 4;
+    public static final int AGG_SUM_INT = 9;
+    public static final int AGG_SUM_LONG = 12;
+    public static final int AGG_SUM_LONG256 = 16;
+    public static final int AGG_SUM_LONG_LONG = 13;
+    public static final int AGG_SUM_SHORT = 17;
+    public static final int AGG_SUM_SHORT_LONG = 18;
+    // largest key range served by the dense accumulator, see allocDense()
+    public static final long DENSE_MAX_KEY_COUNT = 64 * 1024;
 
     public static long alloc(ColumnTypes types, long capacity) {
         // min capacity that works on all platforms is 16  
@@ -55,7 +80,60 @@ public final class Rosti {
         }
     }
 
-    public static native void clear(long pRosti);
+    /**
+     * Wraps slots spilled by spillCopy() into a read-only map that merge and wrap up functions,
+     * as well as cursors, can iterate. Every slot of the run is full, run cannot be searched or
+     * inserted into. Slots memory is not owned by the run and must outlive it. Initial values are
+     * copied off the map, the map can grow while the run is open.
+     *
+     * @param pRosti map of the same structure as the one slots were spilled from
+     * @param pSlots address of the spilled slots
+     * @param count  number of slots
+     * @return address of the run or 0 when memory could not be allocated
+     */
+    public static long allocRun(long pRosti, long pSlots, long count) {
+        final long pRun = allocRun0(pRosti, pSlots, count);
+        if (pRun != 0) {
+            Unsafe.recordMemAlloc(getRunAllocMemory(pRun), MemoryTag.NATIVE_ROSTI);
+        }
+        return pRun;
+    }
+
+    /**
+     * Allocates dense accumulator for keys in [keyMin, keyMin + keyCount) range, such as hours of the day
+     * or symbol keys of a low cardinality column. Keys outside the range, null included, are aggregated
+     * in the map. Dense slots have the same layout as map slots and are copied to the map by exportDense(),
+     * which has to be called before map is merged or wrapped up.
+     *
+     * @param pRosti   map that defines slot layout and receives exported keys
+     * @param keyMin   smallest key of the range
+     * @param keyCount number of keys in the range, up to DENSE_MAX_KEY_COUNT
+     * @return address of the accumulator or 0 when memory could not be allocated
+     */
+    public static long allocDense(long pRosti, long keyMin, long keyCount) {
+        assert keyCount > 0 && keyCount <= DENSE_MAX_KEY_COUNT;
+        final long pDense = allocDense0(pRosti, keyMin, keyCount);
+        if (pDense != 0) {
+            Unsafe.recordMemAlloc(getDenseAllocMemory(pRosti, keyCount), MemoryTag.NATIVE_ROSTI);
+        }
+        return pDense;
+    }
+
+    public static void clear(long pRosti) {
+        long oldSize = getAllocMemory(pRosti);
+        clear0(pRosti);
+        updateMemoryUsage(pRosti, oldSize);
+    }
+
+    /**
+     * Migrates slots that incremental resize left in the old arena and frees it.
+     * Must be called before map slots are iterated outside native code.
+     */
+    public static void completeResize(long pRosti) {
+        long oldSize = getAllocMemory(pRosti);
+        completeResize0(pRosti);
+        updateMemoryUsage(pRosti, oldSize);
+    }
 
     //turns on normal allocation inside rosti
     @TestOnly
@@ -71,6 +149,19 @@ public final class Rosti {
         Unsafe.recordMemAlloc(-size, MemoryTag.NATIVE_ROSTI);
     }
 
+    public static native boolean exportDense(long pDense);
+
+    public static void freeDense(long pRosti, long pDense, long keyCount) {
+        freeDense0(pDense);
+        Unsafe.recordMemAlloc(-getDenseAllocMemory(pRosti, keyCount), MemoryTag.NATIVE_ROSTI);
+    }
+
+    public static void freeRun(long pRun) {
+        final long size = getRunAllocMemory(pRun);
+        freeRun0(pRun);
+        Unsafe.recordMemAlloc(-size, MemoryTag.NATIVE_ROSTI);
+    }
+
     public static native long getAllocMemory(long pRosti);
 
     public static long getCapacity(long pRosti) {
@@ -89,6 +180,12 @@ public final class Rosti {
         return Unsafe.getUnsafe().getLong(pRosti + 8 * Long.BYTES);
     }
 
+    // chars of STRING keys, slot key is the hash (long), length in chars (int) and offset of the chars in 4-byte words (int)
+    public static native long getKeyHeap(long pRosti);
+
+    // partition the null key, as set in the initial values slot, is split to, see split()
+    public static native int getNullKeyPartition(long pRosti, int partitionCount);
+
     public static long getSize(long pRosti) {
         return Unsafe.getUnsafe().getLong(pRosti + 2 * Long.BYTES);
     }
@@ -109,6 +206,9 @@ public final class Rosti {
         return Unsafe.getUnsafe().getLong(pRosti + 7 * Long.BYTES);
     }
 
+    // false for maps with STRING keys, runs are spilled again to split their partition further
+    public static native boolean isSpillable(long pRosti);
+
     //returns true if rosti is set to trigger OOM on  allocation
     public static native boolean keyedHourCount(long pRosti, long pKeys, long count, int valueOffset);
 
@@ -233,6 +333,28 @@ public final class Rosti {
 
     public static native boolean keyedIntMinShortWrapUp(long pRosti, int valueOffset, long accumulatedValue);
 
+    // dense accumulator, see allocDense()
+    public static native boolean keyedHourDenseCount(long pDense, long pKeys, long count, int valueOffset);
+
+    public static native boolean keyedHourDenseMultiAgg(long pDense, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedHourDenseSumDouble(long pDense, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedHourDenseSumLong(long pDense, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntDenseCount(long pDense, long pKeys, long count, int valueOffset);
+
+    public static native boolean keyedIntDenseMultiAgg(long pDense, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedIntDenseSumDouble(long pDense, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntDenseSumLong(long pDense, long pKeys, long pLong, long count, int valueOffset);
+
+    // fused aggregates, see putAggDescriptor()
+    public static native boolean keyedHourMultiAgg(long pRosti, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedIntMultiAgg(long pRosti, long pKeys, long count, long pAggs, int aggCount);
+
     // nsum double
     public static native boolean keyedIntNSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
 
@@ -276,6 +398,561 @@ public final class Rosti {
 
     public static native boolean keyedIntSumLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
 
+    // variance and standard deviation of double, slots are mean, m2 (double) and count (long),
+    // wrap up replaces the mean with var_pop, var_samp, stddev_pop or stddev_samp
+    public static native boolean keyedIntVarianceDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedHourVarianceDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntVarianceDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedIntVarianceDoubleWrapUp(long pRosti, int valueOffset, double meanAtNull, double m2AtNull, long valueAtNullCount, boolean sample, boolean stddev);
+
+    // count float and count long128, merge and wrap up via keyedIntCount*
+    public static native boolean keyedIntCountFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedHourCountFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedIntCountLong128(long pRosti, long pKeys, long pLong128, long count, int valueOffset);
+
+    public static native boolean keyedHourCountLong128(long pRosti, long pKeys, long pLong128, long count, int valueOffset);
+
+    // sum float, slots are sum (double) and count (long), merge and wrap up via keyedIntSumDouble*
+    public static native boolean keyedIntSumFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedHourSumFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    // min and max float are kept in double slots, merge and wrap up via keyedIntMinDouble* and keyedIntMaxDouble*
+    public static native boolean keyedIntMinFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedHourMinFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedIntMaxFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedHourMaxFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    // sum byte, merge and wrap up via keyedIntSumLong*
+    public static native boolean keyedIntSumByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedHourSumByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    // min and max byte, merge and wrap up as short
+    public static native boolean keyedIntMinByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedHourMinByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedIntMaxByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedHourMaxByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    // min and max char, slot is a long, null char (0) does not take part in min
+    public static native boolean keyedIntMinChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedHourMinChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedIntMaxChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedHourMaxChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    // pairs of INT or SYMBOL keys, pKeys is the address of the two column addresses, first key goes to the
+    // high half of the LONG slot key. Merge and wrap up via keyedLong*
+    public static native boolean keyedIntPairCount(long pRosti, long pKeys, long count, int valueOffset);
+
+    public static native boolean keyedIntPairCountDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntPairCountFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedIntPairCountInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedIntPairCountLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntPairCountLong128(long pRosti, long pKeys, long pLong128, long count, int valueOffset);
+
+    public static native boolean keyedIntPairDistinct(long pRosti, long pKeys, long count);
+
+    public static native boolean keyedIntPairKSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMaxShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMinShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedIntPairMultiAgg(long pRosti, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedIntPairNSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumLong256(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumLongLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedIntPairSumShortLong(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedIntPairVarianceDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    // LONG, DATE and TIMESTAMP keys
+    public static native boolean keyedLongCount(long pRosti, long pKeys, long count, int valueOffset);
+
+    public static native boolean keyedLongCountDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongCountFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLongCountInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLongCountLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLongCountLong128(long pRosti, long pKeys, long pLong128, long count, int valueOffset);
+
+    public static native boolean keyedLongDistinct(long pRosti, long pKeys, long count);
+
+    public static native boolean keyedLongKSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLongMaxShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLongMinByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedLongMinChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedLongMinDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongMinFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLongMinInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLongMinLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLongMinShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLongMultiAgg(long pRosti, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedLongNSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongSumByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedLongSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongSumFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLongSumInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLongSumLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLongSumLong256(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLongSumLongLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLongSumShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLongSumShortLong(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLongVarianceDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLongAvgDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongAvgLongLongWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongAvgLongWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongCountMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongCountWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedLongKSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongKSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongMaxDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongMaxDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull);
+
+    public static native boolean keyedLongMaxIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongMaxIntWrapUp(long pRosti, int valueOffset, int valueAtNull);
+
+    public static native boolean keyedLongMaxLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongMaxLongWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedLongMaxShortWrapUp(long pRosti, int valueOffset, int accumulatedValue);
+
+    public static native boolean keyedLongMinDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongMinDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull);
+
+    public static native boolean keyedLongMinIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongMinIntWrapUp(long pRosti, int valueOffset, int valueAtNull);
+
+    public static native boolean keyedLongMinLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongMinLongWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedLongMinShortWrapUp(long pRosti, int valueOffset, int accumulatedValue);
+
+    public static native boolean keyedLongNSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongNSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount, double valueAtNullC);
+
+    public static native boolean keyedLongSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongSumIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongSumLong256Merge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongSumLong256WrapUp(long pRosti, int valueOffset, long v0, long v1, long v2, long v3, long valueAtNullCount);
+
+    public static native boolean keyedLongSumLongLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongSumLongLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongSumLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongSumLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLongVarianceDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLongVarianceDoubleWrapUp(long pRosti, int valueOffset, double meanAtNull, double m2AtNull, long valueAtNullCount, boolean sample, boolean stddev);
+
+    // UUID and LONG128 keys, pKeys points at 16-byte values
+    public static native boolean keyedLong128Count(long pRosti, long pKeys, long count, int valueOffset);
+
+    public static native boolean keyedLong128CountDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128CountFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLong128CountInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLong128CountLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLong128CountLong128(long pRosti, long pKeys, long pLong128, long count, int valueOffset);
+
+    public static native boolean keyedLong128Distinct(long pRosti, long pKeys, long count);
+
+    public static native boolean keyedLong128KSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLong128MaxShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLong128MinShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLong128MultiAgg(long pRosti, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedLong128NSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumLong256(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumLongLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLong128SumShortLong(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedLong128VarianceDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedLong128AvgDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128AvgLongLongWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128AvgLongWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128CountMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128CountWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedLong128KSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128KSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128MaxDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128MaxDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull);
+
+    public static native boolean keyedLong128MaxIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128MaxIntWrapUp(long pRosti, int valueOffset, int valueAtNull);
+
+    public static native boolean keyedLong128MaxLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128MaxLongWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedLong128MaxShortWrapUp(long pRosti, int valueOffset, int accumulatedValue);
+
+    public static native boolean keyedLong128MinDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128MinDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull);
+
+    public static native boolean keyedLong128MinIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128MinIntWrapUp(long pRosti, int valueOffset, int valueAtNull);
+
+    public static native boolean keyedLong128MinLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128MinLongWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedLong128MinShortWrapUp(long pRosti, int valueOffset, int accumulatedValue);
+
+    public static native boolean keyedLong128NSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128NSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount, double valueAtNullC);
+
+    public static native boolean keyedLong128SumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128SumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128SumIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128SumLong256Merge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128SumLong256WrapUp(long pRosti, int valueOffset, long v0, long v1, long v2, long v3, long valueAtNullCount);
+
+    public static native boolean keyedLong128SumLongLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128SumLongLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128SumLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128SumLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedLong128VarianceDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedLong128VarianceDoubleWrapUp(long pRosti, int valueOffset, double meanAtNull, double m2AtNull, long valueAtNullCount, boolean sample, boolean stddev);
+
+    // STRING keys, pKeys is the address of data and index column addresses. Chars of the keys are
+    // copied to the key heap of the map, see getKeyHeap(). Maps with STRING keys cannot be spilled.
+    public static native boolean keyedStrCount(long pRosti, long pKeys, long count, int valueOffset);
+
+    public static native boolean keyedStrCountDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrCountFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedStrCountInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedStrCountLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedStrCountLong128(long pRosti, long pKeys, long pLong128, long count, int valueOffset);
+
+    public static native boolean keyedStrDistinct(long pRosti, long pKeys, long count);
+
+    public static native boolean keyedStrKSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedStrMaxShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedStrMinByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedStrMinChar(long pRosti, long pKeys, long pChar, long count, int valueOffset);
+
+    public static native boolean keyedStrMinDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrMinFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedStrMinInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedStrMinLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedStrMinShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedStrMultiAgg(long pRosti, long pKeys, long count, long pAggs, int aggCount);
+
+    public static native boolean keyedStrNSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrSumByte(long pRosti, long pKeys, long pByte, long count, int valueOffset);
+
+    public static native boolean keyedStrSumDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrSumFloat(long pRosti, long pKeys, long pFloat, long count, int valueOffset);
+
+    public static native boolean keyedStrSumInt(long pRosti, long pKeys, long pInt, long count, int valueOffset);
+
+    public static native boolean keyedStrSumLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedStrSumLong256(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedStrSumLongLong(long pRosti, long pKeys, long pLong, long count, int valueOffset);
+
+    public static native boolean keyedStrSumShort(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedStrSumShortLong(long pRosti, long pKeys, long pShort, long count, int valueOffset);
+
+    public static native boolean keyedStrVarianceDouble(long pRosti, long pKeys, long pDouble, long count, int valueOffset);
+
+    public static native boolean keyedStrAvgDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrAvgLongLongWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrAvgLongWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrCountMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrCountWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedStrKSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrKSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrMaxDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrMaxDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull);
+
+    public static native boolean keyedStrMaxIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrMaxIntWrapUp(long pRosti, int valueOffset, int valueAtNull);
+
+    public static native boolean keyedStrMaxLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrMaxLongWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedStrMaxShortWrapUp(long pRosti, int valueOffset, int accumulatedValue);
+
+    public static native boolean keyedStrMinDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrMinDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull);
+
+    public static native boolean keyedStrMinIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrMinIntWrapUp(long pRosti, int valueOffset, int valueAtNull);
+
+    public static native boolean keyedStrMinLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrMinLongWrapUp(long pRosti, int valueOffset, long valueAtNull);
+
+    public static native boolean keyedStrMinShortWrapUp(long pRosti, int valueOffset, int accumulatedValue);
+
+    public static native boolean keyedStrNSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrNSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount, double valueAtNullC);
+
+    public static native boolean keyedStrSumDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrSumDoubleWrapUp(long pRosti, int valueOffset, double valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrSumIntMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrSumLong256Merge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrSumLong256WrapUp(long pRosti, int valueOffset, long v0, long v1, long v2, long v3, long valueAtNullCount);
+
+    public static native boolean keyedStrSumLongLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrSumLongLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrSumLongMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrSumLongWrapUp(long pRosti, int valueOffset, long valueAtNull, long valueAtNullCount);
+
+    public static native boolean keyedStrVarianceDoubleMerge(long pRostiA, long pRostiB, int valueOffset);
+
+    public static native boolean keyedStrVarianceDoubleWrapUp(long pRosti, int valueOffset, double meanAtNull, double m2AtNull, long valueAtNullCount, boolean sample, boolean stddev);
+
+
+    /**
+     * Writes aggregate descriptor consumed by keyed*MultiAgg() functions.
+     *
+     * @param pAggs      address of descriptor array, AGG_DESCRIPTOR_SIZE bytes per aggregate
+     * @param index      index of the aggregate
+     * @param pValues    address of value column, ignored by AGG_COUNT
+     * @param op         one of AGG_* constants
+     * @param valueIndex index of the first slot column of the aggregate, same as "valueOffset" of single aggregate functions
+     */
+    public static void putAggDescriptor(long pAggs, int index, long pValues, int op, int valueIndex) {
+        final long p = pAggs + (long) index * AGG_DESCRIPTOR_SIZE;
+        Unsafe.getUnsafe().putLong(p, pValues);
+        Unsafe.getUnsafe().putInt(p + Long.BYTES, op);
+        Unsafe.getUnsafe().putInt(p + Long.BYTES + Integer.BYTES, valueIndex);
+    }
+
     public static void printRosti(long pRosti) {
         final long slots = getSlots(pRosti);
         final long shift = getSlotShift(pRosti);
@@ -320,6 +997,14 @@ public final class Rosti {
         }
     }
 
+    /**
+     * Deletes slot of the null key, as set in the initial values slot.
+     * Map must not be a run and must not have STRING keys.
+     *
+     * @return true when the map had the null key
+     */
+    public static native boolean removeNullKey(long pRosti);
+
     public static boolean reset(long pRosti, int size) {
         long oldSize = Rosti.getAllocMemory(pRosti);
         boolean success = reset0(pRosti, Numbers.ceilPow2(size) - 1);
@@ -327,15 +1012,69 @@ public final class Rosti {
         return success;
     }
 
+    /**
+     * Counts slots of the map per spill partition. Slots of the same key end up in the same partition
+     * for every map of the same structure.
+     *
+     * @param pRosti         map or run to spill
+     * @param partitionCount power of 2
+     * @param partitionShift hash bits to skip, those that partitioned the run being split further
+     * @param pCounts        receives partitionCount longs
+     * @param skipNullKey    when true, slot of the null key is not counted
+     * @return total number of slots to spill
+     */
+    public static native long spillCounts(long pRosti, int partitionCount, int partitionShift, long pCounts, boolean skipNullKey);
+
+    /**
+     * Copies map slots to their partitions. Destination memory must be sized after spillCounts().
+     *
+     * @param pDests partitionCount addresses, each is advanced past the slots copied to it
+     */
+    public static native void spillCopy(long pRosti, int partitionCount, int partitionShift, long pDests, boolean skipNullKey);
+
+    // partition the null key, as set in the initial values slot, is spilled to
+    public static native int spillNullKeyPartition(long pRosti, int partitionCount, int partitionShift);
+
+    /**
+     * Copies slots of the map to the maps of their key partitions. Slots of the same key go to the same
+     * partition for every map of the same structure. Memory usage of the partition maps is not updated.
+     *
+     * @param pPartitions    addresses of partitionCount maps of the same structure as the map
+     * @param partitionCount power of 2
+     * @return false when out of memory
+     */
+    public static native boolean split(long pRosti, long pPartitions, int partitionCount);
+
     public static void updateMemoryUsage(long pRosti, long oldSize) {
         long newSize = Rosti.getAllocMemory(pRosti);
         Unsafe.recordMemAlloc(newSize - oldSize, MemoryTag.NATIVE_ROSTI);
     }
 
+    private static long getDenseAllocMemory(long pRosti, long keyCount) {
+        return keyCount * (1 + getSlotSize(pRosti));
+    }
+
+    // initial values and control bytes of the run, slots are mapped from the spill file
+    private static long getRunAllocMemory(long pRun) {
+        return getSlotSize(pRun) + getCapacity(pRun) + 1;
+    }
+
     private static native long alloc(long pKeyTypes, int keyTypeCount, long capacity);
 
+    private static native long allocDense0(long pRosti, long keyMin, long keyCount);
+
+    private static native long allocRun0(long pRosti, long pSlots, long count);
+
+    private static native void clear0(long pRosti);
+
+    private static native void completeResize0(long pRosti);
+
+    private static native void freeDense0(long pDense);
+
     private static native void free0(long pRosti);
 
+    private static native void freeRun0(long pRun);
+
     //clears and shrinks to given size
     private static native boolean reset0(long pRosti, int size);
 }
@@ -25,8 +25,15 @@
 package io.questdb.std;
 
 import io.questdb.cairo.BinarySearch;
+import io.questdb.cairo.CairoException;
 
 public final class Vect {
+    // number of longs describing a column of mergeShuffleFixedColumns()
+    public static final int MERGE_SHUFFLE_COLUMN_LONGS = 4;
+    // number of native kernel counters, PERF_COUNTER_COUNT of perf_counters.h
+    public static final int PERFORMANCE_COUNTER_COUNT = 64;
+    // number of buckets of the parallel radix sort, see radixSortParallelBucket()
+    public static final int RADIX_SORT_PARALLEL_BUCKETS = 256;
 
     public static native double avgDoubleAcc(long pInt, long count, long pCount);
 
@@ -68,10 +75,23 @@ public final class Vect {
 
     public static native long countDouble(long pDouble, long count);
 
+    // Filtered kernels aggregate values at frame-local row indexes, e.g. written by a compiled filter,
+    // with null handling of the matching group-by functions: sum skips non-finite doubles and stores
+    // the number of summed values at pCount, min and max return null when all values are null.
+    public static native long countDoubleFiltered(long pDouble, long pRows, long rowCount);
+
+    public static native long countFloat(long pFloat, long count);
+
     public static native long countInt(long pLong, long count);
 
+    public static native long countIntFiltered(long pInt, long pRows, long rowCount);
+
     public static native long countLong(long pLong, long count);
 
+    public static native long countLong128(long pLong128, long count);
+
+    public static native long countLongFiltered(long pLong, long pRows, long rowCount);
+
     public static native long dedupMergeVarColumnLen(long mergeIndexAddr, long mergeIndexSize, long srcDataFixAddr, long srcOooFixAddr);
 
     public static native long dedupSortedTimestampIndex(
@@ -105,16 +125,40 @@ public final class Vect {
 
     public static native void flattenIndex(long pIndex, long count);
 
+    // Native kernel counters are always compiled in and record only while enabled. Returns
+    // nanoseconds spent in the calls of the counter.
     public static native long getPerformanceCounter(int index);
 
+    // number of calls of the counter shorter than 2^(12 + 2 * bucket) ticks, the last bucket counts the rest
+    public static native long getPerformanceCounterBucket(int index, int bucket);
+
+    public static native int getPerformanceCounterBucketCount();
+
+    public static native long getPerformanceCounterBytes(int index);
+
+    public static native long getPerformanceCounterCalls(int index);
+
+    // 0 when the counters are disabled, PERFORMANCE_COUNTER_COUNT otherwise
     public static native int getPerformanceCountersCount();
 
+    public static native long getPerformanceTicksPerSecond();
+
     public static native int getSupportedInstructionSet();
 
     public static String getSupportedInstructionSetName() {
         int inst = getSupportedInstructionSet();
         String base;
-        if (inst >= 10) {
+        if (Os.type == Os.LINUX_ARM64 || Os.type == Os.OSX_ARM64) {
+            if (inst >= 3) {
+                base = "SVE2";
+            } else if (inst >= 2) {
+                base = "SVE";
+            } else if (inst >= 1) {
+                base = "NEON";
+            } else {
+                base = "Vanilla";
+            }
+        } else if (inst >= 10) {
             base = "AVX512";
         } else if (inst >= 8) {
             base = "AVX2";
@@ -125,7 +169,7 @@ public final class Vect {
         } else {
             base = "Vanilla";
         }
-        return " [" + base + "," + Vect.getSupportedInstructionSet() + "]";
+        return " [" + base + "," + inst + "]";
     }
 
     public static native void indexReshuffle128Bit(long pSrc, long pDest, long pIndex, long count);
@@ -140,12 +184,26 @@ public final class Vect {
 
     public static native void indexReshuffle8Bit(long pSrc, long pDest, long pIndex, long count);
 
+    public static native boolean isPerformanceCountersEnabled();
+
+    public static native int maxByte(long pByte, long count);
+
+    public static native int maxChar(long pChar, long count);
+
     public static native double maxDouble(long pDouble, long count);
 
+    public static native double maxDoubleFiltered(long pDouble, long pRows, long rowCount);
+
+    public static native float maxFloat(long pFloat, long count);
+
     public static native int maxInt(long pInt, long count);
 
+    public static native int maxIntFiltered(long pInt, long pRows, long rowCount);
+
     public static native long maxLong(long pLong, long count);
 
+    public static native long maxLongFiltered(long pLong, long pRows, long rowCount);
+
     public static native int maxShort(long pLong, long count);
 
     public static void memcpy(long dst, long src, long len) {
@@ -200,7 +258,9 @@ public final class Vect {
             throw new IllegalArgumentException("Count of indexes to merge should at least be 2.");
         }
 
-        mergeLongIndexesAscInner(pIndexStructArray, count, mergedIndexAddr);
+        if (!mergeLongIndexesAscInner(pIndexStructArray, count, mergedIndexAddr)) {
+            throw CairoException.critical(0).put("could not allocate index merge state [count=").put(count).put(']');
+        }
     }
 
     public static native void mergeShuffle128Bit(long pSrc1, long pSrc2, long pDest, long pIndex, long count);
@@ -215,14 +275,30 @@ public final class Vect {
 
     public static native void mergeShuffle8Bit(long pSrc1, long pSrc2, long pDest, long pIndex, long count);
 
+    // Shuffles merge index rows [indexLo, indexHi) into a group of fixed size columns in one pass over the index.
+    // pColumns is an array of MERGE_SHUFFLE_COLUMN_LONGS longs per column: src1, src2, dest and pow2 of the value size.
+    public static native void mergeShuffleFixedColumns(long pColumns, long columnCount, long pIndex, long indexLo, long indexHi);
+
     public static native long mergeTwoLongIndexesAsc(long pTs, long tsIndexLo, long tsCount, long pIndex2, long index2Count, long pIndexDest);
 
+    public static native int minByte(long pByte, long count);
+
+    public static native int minChar(long pChar, long count);
+
     public static native double minDouble(long pDouble, long count);
 
+    public static native double minDoubleFiltered(long pDouble, long pRows, long rowCount);
+
+    public static native float minFloat(long pFloat, long count);
+
     public static native int minInt(long pInt, long count);
 
+    public static native int minIntFiltered(long pInt, long pRows, long rowCount);
+
     public static native long minLong(long pLong, long count);
 
+    public static native long minLongFiltered(long pLong, long pRows, long rowCount);
+
     public static native int minShort(long pLong, long count);
 
     public static native void oooCopyIndex(long mergeIndexAddr, long mergeIndexSize, long dstAddr);
@@ -258,8 +334,48 @@ public final class Vect {
     // This is not In Place sort, to be renamed later
     public static native void radixSortLongIndexAscInPlace(long pLongData, long count, long pCpy);
 
+    // Parallel variant of radixSortABLongIndexAsc(), the caller runs the phases in this order, phases
+    // taking a chunk or a bucket can run concurrently on any threads:
+    // radixSortParallelSample() for each chunk, radixSortParallelPlan(), radixSortParallelCount() for each chunk,
+    // radixSortParallelOffsets(), radixSortParallelScatter() for each chunk, radixSortParallelBucket() for each
+    // of RADIX_SORT_PARALLEL_BUCKETS buckets. Sorting in place is done with pDataA = 0 and pDataDest = pDataB.
+    // radixSortParallelCreate() returns 0 when the sort state cannot be allocated.
+    public static native void radixSortParallelBucket(long pState, int bucket);
+
+    // number of rows scattered to the bucket, valid after radixSortParallelOffsets()
+    public static native long radixSortParallelBucketSize(long pState, int bucket);
+
+    public static native int radixSortParallelChunkCount(long pState);
+
+    public static native void radixSortParallelCount(long pState, int chunk);
+
+    public static native long radixSortParallelCreate(long pDataA, long countA, long pDataB, long countB, long pDataDest, long pDataCpy, int chunkCount);
+
+    public static native void radixSortParallelFree(long pState);
+
+    public static native void radixSortParallelOffsets(long pState);
+
+    public static native void radixSortParallelPlan(long pState);
+
+    public static native void radixSortParallelSample(long pState, int chunk);
+
+    public static native void radixSortParallelScatter(long pState, int chunk);
+
     public static native void resetPerformanceCounters();
 
+    // Splits sorted timestamps into SAMPLE BY buckets of a fixed stride, the first one at bucketTimestamp.
+    // Writes timestamp and exclusive row end of each bucket, 16 bytes per bucket, to pBuckets and returns
+    // the number of buckets, at most maxBuckets.
+    public static native long sampleByBuckets(long pTimestamps, long count, long start, long stride, long bucketTimestamp, long pBuckets, long maxBuckets);
+
+    // stats of the rows of buckets written by sampleByBuckets(), 40 bytes per bucket, see GroupByFunction.computeBucket();
+    // zero page address stands for a column top, i.e. null values
+    public static native void sampleByStatsDouble(long pDouble, long pBuckets, long bucketCount, long pStats);
+
+    public static native void sampleByStatsInt(long pInt, long pBuckets, long bucketCount, long pStats);
+
+    public static native void sampleByStatsLong(long pLong, long pBuckets, long bucketCount, long pStats);
+
     public static native void setMemoryDouble(long pData, double value, long count);
 
     public static native void setMemoryFloat(long pData, float value, long count);
@@ -270,6 +386,8 @@ public final class Vect {
 
     public static native void setMemoryShort(long pData, short value, long count);
 
+    public static native void setPerformanceCountersEnabled(boolean enabled);
+
     public static native void setVarColumnRefs32Bit(long address, long initialOffset, long count);
 
     public static native void setVarColumnRefs64Bit(long address, long initialOffset, long count);
@@ -302,18 +420,73 @@ public final class Vect {
             long tgtIndxAdd
     );
 
+    /**
+     * Second pass of {@link #sortVarColumn(long, long, long, long, long, long)}, copies values of rows
+     * [rowLo, rowHi) of the merged timestamps to the offsets written to the target index by
+     * {@link #sortVarColumnOffsets(long, long, long, long)}. Disjoint row ranges can be copied concurrently.
+     */
+    public static native void sortVarColumnData(
+            long mergedTimestampsAddr,
+            long rowLo,
+            long rowHi,
+            long srcDataAddr,
+            long srcIndxAddr,
+            long tgtDataAddr,
+            long tgtIndxAddr
+    );
+
+    /**
+     * First pass of {@link #sortVarColumn(long, long, long, long, long, long)}, writes offsets of the sorted
+     * values to the target index.
+     *
+     * @return size of the sorted var data
+     */
+    public static native long sortVarColumnOffsets(
+            long mergedTimestampsAddr,
+            long valueCount,
+            long srcIndxAddr,
+            long tgtIndxAddr
+    );
+
+    // count, null count, sum, min and max of a page in a single pass, pStats is 40 bytes, see column_stats_t
+    public static native void statsDouble(long pDouble, long count, long pStats);
+
+    public static native void statsInt(long pInt, long count, long pStats);
+
+    public static native void statsLong(long pLong, long count, long pStats);
+
+    public static native long sumByte(long pByte, long count);
+
     public static native double sumDouble(long pDouble, long count);
 
+    public static native double sumDoubleFiltered(long pDouble, long pRows, long rowCount, long pCount);
+
     public static native double sumDoubleKahan(long pDouble, long count);
 
     public static native double sumDoubleNeumaier(long pDouble, long count);
 
+    public static native double sumFloat(long pFloat, long count);
+
     public static native long sumInt(long pInt, long count);
 
+    public static native long sumIntFiltered(long pInt, long pRows, long rowCount, long pCount);
+
     public static native long sumLong(long pLong, long count);
 
+    public static native long sumLongFiltered(long pLong, long pRows, long rowCount, long pCount);
+
     public static native long sumShort(long pLong, long count);
 
+    // pState is mean, m2 (double) and count (long) of finite values, the batch is merged into it
+    public static native void varianceDouble(long pDouble, long count, long pState);
+
+    // zone map of blockCount complete blocks of 1 << blockRowsShift values, one 40-byte column_stats_t entry per block
+    public static native void zoneMapDouble(long pDouble, long blockCount, int blockRowsShift, long pZoneMap);
+
+    public static native void zoneMapInt(long pInt, long blockCount, int blockRowsShift, long pZoneMap);
+
+    public static native void zoneMapLong(long pLong, long blockCount, int blockRowsShift, long pZoneMap);
+
     private static native int memcmp(long src, long dst, long len);
 
     private static native void memcpy0(long src, long dst, long len);
@@ -339,8 +512,8 @@ public final class Vect {
         return true;
     }
 
-    // accept externally allocated memory for merged index of proper size
-    private static native void mergeLongIndexesAscInner(long pIndexStructArray, int count, long mergedIndexAddr);
+    // accept externally allocated memory for merged index of proper size, false when native memory runs out
+    private static native boolean mergeLongIndexesAscInner(long pIndexStructArray, int count, long mergedIndexAddr);
 
     static {
         Os.init();
@@ -47,6 +47,7 @@ public class O3CopyTask {
     private int dstVarFd;
     private long dstVarOffset;
     private long dstVarSize;
+    private int dstZoneMapFd;
     private int indexBlockCapacity;
     private BitmapIndexWriter indexWriter;
     private long o3SplitPartitionSize;
@@ -151,6 +152,10 @@ public class O3CopyTask {
         return dstVarSize;
     }
 
+    public int getDstZoneMapFd() {
+        return dstZoneMapFd;
+    }
+
     public int getIndexBlockCapacity() {
         return indexBlockCapacity;
     }
@@ -331,6 +336,7 @@ public class O3CopyTask {
             long dstVarSize,
             int dstKFd,
             int dstVFd,
+            int dstZoneMapFd,
             long dstIndexOffset,
             long dstIndexAdjust,
             int indexBlockCapacity,
@@ -384,6 +390,7 @@ public class O3CopyTask {
         this.dstVarSize = dstVarSize;
         this.dstKFd = dstKFd;
         this.dstVFd = dstVFd;
+        this.dstZoneMapFd = dstZoneMapFd;
         this.dstIndexOffset = dstIndexOffset;
         this.dstIndexAdjust = dstIndexAdjust;
         this.indexBlockCapacity = indexBlockCapacity;
@@ -27,6 +27,8 @@ package io.questdb.test;
 import io.questdb.Metrics;
 import io.questdb.metrics.*;
 import io.questdb.std.MemoryTag;
+import io.questdb.std.Unsafe;
+import io.questdb.std.Vect;
 import io.questdb.std.str.BorrowableUtf8Sink;
 import io.questdb.std.str.DirectUtf8Sink;
 import io.questdb.test.tools.TestUtils;
@@ -111,6 +113,36 @@ public class MetricsTest {
         TestUtils.assertContains(encoded, "jvm_unknown_gc_time");
     }
 
+    @Test
+    public void testMetricNamesContainNativeKernelMetrics() {
+        final Metrics metrics = Metrics.enabled();
+        final long size = 1024 * Long.BYTES;
+        final long mem = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        // index of the o3_set_memory_long counter, counters are global and other tests may bump them too
+        final int counter = 19;
+        Vect.setPerformanceCountersEnabled(true);
+        try (DirectUtf8Sink sink = new DirectUtf8Sink(32)) {
+            Assert.assertEquals(Vect.PERFORMANCE_COUNTER_COUNT, Vect.getPerformanceCountersCount());
+            final long calls = Vect.getPerformanceCounterCalls(counter);
+            final long bytes = Vect.getPerformanceCounterBytes(counter);
+            Vect.setMemoryLong(mem, 42, 1024);
+            Assert.assertTrue(Vect.getPerformanceCounterCalls(counter) >= calls + 1);
+            Assert.assertTrue(Vect.getPerformanceCounterBytes(counter) >= bytes + size);
+
+            metrics.scrapeIntoPrometheus(sink);
+
+            final String encoded = sink.toString();
+            TestUtils.assertContains(encoded, "questdb_native_kernel_calls_total{kernel=\"o3_set_memory_long\"} ");
+            TestUtils.assertContains(encoded, "questdb_native_kernel_bytes_total{kernel=\"o3_set_memory_long\"} ");
+            TestUtils.assertContains(encoded, "questdb_native_kernel_duration_seconds_bucket{kernel=\"o3_set_memory_long\",le=\"+Inf\"} ");
+            TestUtils.assertContains(encoded, "questdb_native_kernel_duration_seconds_sum{kernel=\"o3_set_memory_long\"} ");
+            TestUtils.assertContains(encoded, "questdb_native_kernel_duration_seconds_count{kernel=\"o3_set_memory_long\"} ");
+        } finally {
+            Vect.setPerformanceCountersEnabled(false);
+            Unsafe.free(mem, size, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
     @Test
     public void testMetricUniqueness() {
         SpyingMetricsRegistry metricsRegistry = new SpyingMetricsRegistry();
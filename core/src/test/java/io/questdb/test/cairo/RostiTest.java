@@ -24,14 +24,516 @@
 
 package io.questdb.test.cairo;
 
+import io.questdb.cairo.ArrayColumnTypes;
 import io.questdb.cairo.ColumnType;
 import io.questdb.cairo.SingleColumnType;
+import io.questdb.std.MemoryTag;
+import io.questdb.std.Numbers;
+import io.questdb.std.Rnd;
 import io.questdb.std.Rosti;
+import io.questdb.std.Unsafe;
+import io.questdb.std.str.StringSink;
 import io.questdb.test.AbstractCairoTest;
+import org.junit.Assert;
 import org.junit.Test;
 
+import java.util.HashMap;
 
 public class RostiTest extends AbstractCairoTest {
+    private static final int KIND_INT = 0;
+    private static final int KIND_LONG = 1;
+    private static final int KIND_LONG128 = 2;
+    private static final int ROW_COUNT = 10_000;
+    // count(), sum(double), max(double), min(long) and sum(long), see initValues()
+    private static final int VALUE_COLUMN_COUNT = 7;
+
+    @Test
+    public void testControlBytesAtGroupBoundary() throws Exception {
+        assertMemoryLeak(() -> {
+            // smallest map is a single group of 15 slots and the sentinel, it takes 14 keys before it grows
+            assertControlBytes(14, 15);
+            assertControlBytes(15, 31);
+            assertControlBytes(ROW_COUNT, 16 * 1024 - 1);
+        });
+    }
+
+    @Test
+    public void testDenseKeysMatchMap() throws Exception {
+        assertMemoryLeak(() -> {
+            // keys at both edges of the dense range, just outside of it and null
+            final int keyMin = 100;
+            final int keyCount = 16;
+            final Rnd rnd = new Rnd();
+            final long keys = Unsafe.malloc(4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long doubles = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long longs = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long aggs = Unsafe.malloc(5L * Rosti.AGG_DESCRIPTOR_SIZE, MemoryTag.NATIVE_DEFAULT);
+            final long pMap = allocMap(KIND_INT, 64);
+            final long pMulti = allocMap(KIND_INT, 64);
+            final long pSingle = allocMap(KIND_INT, 64);
+            final long pDenseMulti = Rosti.allocDense(pMulti, keyMin, keyCount);
+            final long pDenseSingle = Rosti.allocDense(pSingle, keyMin, keyCount);
+            try {
+                Assert.assertNotEquals(0, pDenseMulti);
+                Assert.assertNotEquals(0, pDenseSingle);
+                for (int i = 0; i < ROW_COUNT; i++) {
+                    final int key = rnd.nextInt(10) == 0 ? Numbers.INT_NaN : keyMin - 2 + rnd.nextInt(keyCount + 4);
+                    Unsafe.getUnsafe().putInt(keys + 4L * i, key);
+                    // halves sum up exactly in any order, dense sums are accumulated in lanes
+                    Unsafe.getUnsafe().putDouble(doubles + 8L * i, rnd.nextInt(8) == 0 ? Double.NaN : rnd.nextInt(200) / 2.0);
+                    Unsafe.getUnsafe().putLong(longs + 8L * i, rnd.nextInt(8) == 0 ? Numbers.LONG_NaN : rnd.nextInt(1000) - 500);
+                }
+
+                // two frames, so that slots are both initialised and updated, and a column top frame
+                final int half = ROW_COUNT / 2;
+                final int top = 100;
+                aggregate(KIND_INT, pMap, keys, doubles, longs, half, 1);
+                aggregate(KIND_INT, pMap, keys + 4L * half, doubles + 8L * half, longs + 8L * half, ROW_COUNT - half - top, 1);
+                Assert.assertTrue(Rosti.keyedIntDistinct(pMap, keys + 4L * (ROW_COUNT - top), top));
+
+                Rosti.putAggDescriptor(aggs, 0, 0, Rosti.AGG_COUNT, 1);
+                Rosti.putAggDescriptor(aggs, 1, doubles, Rosti.AGG_SUM_DOUBLE, 2);
+                Rosti.putAggDescriptor(aggs, 2, doubles, Rosti.AGG_MAX_DOUBLE, 4);
+                Rosti.putAggDescriptor(aggs, 3, longs, Rosti.AGG_MIN_LONG, 5);
+                Rosti.putAggDescriptor(aggs, 4, longs, Rosti.AGG_SUM_LONG, 6);
+                Assert.assertTrue(Rosti.keyedIntDenseMultiAgg(pDenseMulti, keys, half, aggs, 5));
+                Rosti.putAggDescriptor(aggs, 0, 0, Rosti.AGG_COUNT, 1);
+                Rosti.putAggDescriptor(aggs, 1, doubles + 8L * half, Rosti.AGG_SUM_DOUBLE, 2);
+                Rosti.putAggDescriptor(aggs, 2, doubles + 8L * half, Rosti.AGG_MAX_DOUBLE, 4);
+                Rosti.putAggDescriptor(aggs, 3, longs + 8L * half, Rosti.AGG_MIN_LONG, 5);
+                Rosti.putAggDescriptor(aggs, 4, longs + 8L * half, Rosti.AGG_SUM_LONG, 6);
+                Assert.assertTrue(Rosti.keyedIntDenseMultiAgg(pDenseMulti, keys + 4L * half, ROW_COUNT - half - top, aggs, 5));
+                Assert.assertTrue(Rosti.keyedIntDenseMultiAgg(pDenseMulti, keys + 4L * (ROW_COUNT - top), top, aggs, 0));
+
+                for (int f = 0; f < 2; f++) {
+                    final long lo = f == 0 ? 0 : half;
+                    final long count = f == 0 ? half : ROW_COUNT - half - top;
+                    Assert.assertTrue(Rosti.keyedIntDenseCount(pDenseSingle, keys + 4L * lo, count, 1));
+                    Assert.assertTrue(Rosti.keyedIntDenseSumDouble(pDenseSingle, keys + 4L * lo, doubles + 8L * lo, count, 2));
+                    Rosti.putAggDescriptor(aggs, 0, doubles + 8L * lo, Rosti.AGG_MAX_DOUBLE, 4);
+                    Rosti.putAggDescriptor(aggs, 1, longs + 8L * lo, Rosti.AGG_MIN_LONG, 5);
+                    Assert.assertTrue(Rosti.keyedIntDenseMultiAgg(pDenseSingle, keys + 4L * lo, count, aggs, 2));
+                    Assert.assertTrue(Rosti.keyedIntDenseSumLong(pDenseSingle, keys + 4L * lo, longs + 8L * lo, count, 6));
+                }
+                Assert.assertTrue(Rosti.keyedIntDenseMultiAgg(pDenseSingle, keys + 4L * (ROW_COUNT - top), top, aggs, 0));
+
+                Assert.assertTrue(Rosti.exportDense(pDenseMulti));
+                Assert.assertTrue(Rosti.exportDense(pDenseSingle));
+                wrapUp(KIND_INT, pMap, 1);
+                wrapUp(KIND_INT, pMulti, 1);
+                wrapUp(KIND_INT, pSingle, 1);
+
+                final HashMap<Long, String> expected = collect(pMap, KIND_INT, 1);
+                Assert.assertEquals(keyCount + 5, expected.size());
+                Assert.assertTrue(expected.containsKey((long) keyMin - 1));
+                Assert.assertTrue(expected.containsKey((long) keyMin));
+                Assert.assertTrue(expected.containsKey((long) keyMin + keyCount - 1));
+                Assert.assertTrue(expected.containsKey((long) keyMin + keyCount));
+                Assert.assertTrue(expected.containsKey(Numbers.LONG_NaN));
+                Assert.assertEquals(expected, collect(pMulti, KIND_INT, 1));
+                Assert.assertEquals(expected, collect(pSingle, KIND_INT, 1));
+            } finally {
+                Rosti.freeDense(pMulti, pDenseMulti, keyCount);
+                Rosti.freeDense(pSingle, pDenseSingle, keyCount);
+                Rosti.free(pMap);
+                Rosti.free(pMulti);
+                Rosti.free(pSingle);
+                Unsafe.free(keys, 4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(doubles, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(longs, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(aggs, 5L * Rosti.AGG_DESCRIPTOR_SIZE, MemoryTag.NATIVE_DEFAULT);
+            }
+        });
+    }
+
+    @Test
+    public void testIncrementalResize() throws Exception {
+        assertMemoryLeak(() -> {
+            // map at incremental resize capacity grows past it a bit, so that old arena is still being migrated
+            final int keyCount = 930_000;
+            final int lookupCount = 10_000;
+            final int newKeyCount = 1_000;
+            final long capacity = 1024 * 1024;
+            final long keys = Unsafe.malloc(4L * keyCount, MemoryTag.NATIVE_DEFAULT);
+            final ArrayColumnTypes types = new ArrayColumnTypes();
+            types.add(ColumnType.INT);
+            types.add(ColumnType.LONG);
+            final long pRosti = Rosti.alloc(types, capacity);
+            try {
+                Assert.assertNotEquals(0, pRosti);
+                Unsafe.getUnsafe().putInt(Rosti.getInitialValueSlot(pRosti, 0), Numbers.INT_NaN);
+                Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 1), 0);
+                for (int i = 0; i < keyCount; i++) {
+                    Unsafe.getUnsafe().putInt(keys + 4L * i, i);
+                }
+                Assert.assertTrue(Rosti.keyedIntCount(pRosti, keys, keyCount, 1));
+                Assert.assertEquals(2 * capacity - 1, Rosti.getCapacity(pRosti));
+
+                // lookups of keys in both arenas and inserts of new keys while slots are migrated
+                final long allocBeforeLookups = Rosti.getAllocMemory(pRosti);
+                for (int i = 0; i < newKeyCount; i++) {
+                    Unsafe.getUnsafe().putInt(keys + 4L * (lookupCount + i), keyCount + i);
+                }
+                Assert.assertTrue(Rosti.keyedIntCount(pRosti, keys, lookupCount + newKeyCount, 1));
+                Assert.assertEquals(keyCount + newKeyCount, Rosti.getSize(pRosti));
+                Assert.assertEquals(allocBeforeLookups, Rosti.getAllocMemory(pRosti));
+
+                // memory size counts both arenas until the old one is freed, slot is 16 bytes
+                Rosti.completeResize(pRosti);
+                Assert.assertTrue(allocBeforeLookups - Rosti.getAllocMemory(pRosti) >= 16 * (capacity - 1));
+                Assert.assertEquals(2 * capacity - 1, Rosti.getCapacity(pRosti));
+                final long allocAfterResize = Rosti.getAllocMemory(pRosti);
+                Rosti.completeResize(pRosti);
+                Assert.assertEquals(allocAfterResize, Rosti.getAllocMemory(pRosti));
+
+                final long ctrl = Rosti.getCtrl(pRosti);
+                final long slots = Rosti.getSlots(pRosti);
+                final long shift = Rosti.getSlotShift(pRosti);
+                final long valueOffset = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRosti) + 4);
+                final boolean[] seen = new boolean[keyCount + newKeyCount];
+                long size = 0;
+                for (long i = 0, n = Rosti.getCapacity(pRosti); i < n; i++) {
+                    if (Unsafe.getUnsafe().getByte(ctrl + i) > -1) {
+                        final long slot = slots + (i << shift);
+                        final int key = Unsafe.getUnsafe().getInt(slot);
+                        Assert.assertFalse(seen[key]);
+                        seen[key] = true;
+                        Assert.assertEquals(key < lookupCount ? 2 : 1, Unsafe.getUnsafe().getLong(slot + valueOffset));
+                        size++;
+                    }
+                }
+                Assert.assertEquals(keyCount + newKeyCount, size);
+            } finally {
+                Rosti.free(pRosti);
+                Unsafe.free(keys, 4L * keyCount, MemoryTag.NATIVE_DEFAULT);
+            }
+        });
+    }
+
+    @Test
+    public void testKeyBatchDuplicateKeys() throws Exception {
+        // every block of rows repeats the same few keys, later rows of a block find keys inserted by earlier ones
+        assertKeyBatch(100, 3);
+    }
+
+    @Test
+    public void testKeyBatchFewerRowsThanBatch() throws Exception {
+        for (int count = 1; count < 16; count++) {
+            assertKeyBatch(count, 1024);
+        }
+    }
+
+    @Test
+    public void testKeyBatchOddTail() throws Exception {
+        assertKeyBatch(17, 1024);
+        assertKeyBatch(31, 1024);
+        assertKeyBatch(33, 1024);
+        assertKeyBatch(1013, 256);
+    }
+
+    @Test
+    public void testKeyBatchPipelinedResize() throws Exception {
+        assertMemoryLeak(() -> {
+            // map grows in the middle of a call, prefetches made before the resize are stale
+            Assert.assertTrue(assertKeyBatchMatchesRowByRow(KIND_INT, 64 * 1024, 70_000, 10_000_000) > 64 * 1024);
+        });
+    }
+
+    @Test
+    public void testKeyedNarrowTypesWithNulls() throws Exception {
+        assertMemoryLeak(() -> {
+            // count(float), sum(float), min(float), max(float), sum(byte), min(byte), max(byte), min(char),
+            // max(char) and count(uuid), slots are widened as in the vector aggregate functions
+            final int valueCount = 12;
+            final int dataKeyCount = 40;
+            final int keyCount = 50;
+            final int frame1 = 4999;
+            final int top = 101;
+            final int frame2 = ROW_COUNT - frame1 - top;
+            final Rnd rnd = new Rnd();
+            final long keys = Unsafe.malloc(4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long floats = Unsafe.malloc(4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long bytes = Unsafe.malloc(ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long chars = Unsafe.malloc(2L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long uuids = Unsafe.malloc(16L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final ArrayColumnTypes types = new ArrayColumnTypes();
+            types.add(ColumnType.INT);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.DOUBLE);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.DOUBLE);
+            types.add(ColumnType.DOUBLE);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.LONG);
+            types.add(ColumnType.LONG);
+            final long pRostiA = Rosti.alloc(types, 64);
+            final long pRostiB = Rosti.alloc(types, 64);
+            try {
+                Assert.assertNotEquals(0, pRostiA);
+                Assert.assertNotEquals(0, pRostiB);
+                for (long pRosti : new long[]{pRostiA, pRostiB}) {
+                    Unsafe.getUnsafe().putInt(Rosti.getInitialValueSlot(pRosti, 0), Numbers.INT_NaN);
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 1), 0);
+                    Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, 2), 0);
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 3), 0);
+                    Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, 4), Double.POSITIVE_INFINITY);
+                    Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, 5), Double.NEGATIVE_INFINITY);
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 6), 0);
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 7), 0);
+                    for (int i = 8; i <= valueCount; i++) {
+                        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, i), i < valueCount ? Numbers.LONG_NaN : 0);
+                    }
+                }
+
+                final long[] floatCount = new long[keyCount];
+                final double[] floatSum = new double[keyCount];
+                final double[] floatMin = new double[keyCount];
+                final double[] floatMax = new double[keyCount];
+                final long[] rowCount = new long[keyCount];
+                final long[] byteSum = new long[keyCount];
+                final long[] byteMin = new long[keyCount];
+                final long[] byteMax = new long[keyCount];
+                final long[] charMin = new long[keyCount];
+                final long[] charMax = new long[keyCount];
+                final long[] uuidCount = new long[keyCount];
+                for (int i = 0; i < ROW_COUNT; i++) {
+                    // keys of the column top frame go past data keys, so that some keys have no values
+                    final int key = i < frame1 + frame2 ? rnd.nextInt(dataKeyCount) : i % keyCount;
+                    final float f = rnd.nextInt(8) == 0 ? Float.NaN : (rnd.nextInt(2001) - 1000) / 4.0f;
+                    // max of negative bytes must not be mistaken for the slot of a column top key
+                    final byte b = key == 0 ? (byte) -(1 + rnd.nextInt(128)) : rnd.nextByte();
+                    final char c = rnd.nextInt(8) == 0 ? 0 : (char) (1 + rnd.nextInt(60_000));
+                    final boolean uuidNull = rnd.nextInt(8) == 0;
+                    Unsafe.getUnsafe().putInt(keys + 4L * i, key);
+                    Unsafe.getUnsafe().putFloat(floats + 4L * i, f);
+                    Unsafe.getUnsafe().putByte(bytes + i, b);
+                    Unsafe.getUnsafe().putChar(chars + 2L * i, c);
+                    Unsafe.getUnsafe().putLong(uuids + 16L * i, uuidNull ? Numbers.LONG_NaN : rnd.nextLong());
+                    Unsafe.getUnsafe().putLong(uuids + 16L * i + 8, uuidNull || rnd.nextBoolean() ? Numbers.LONG_NaN : rnd.nextLong());
+                    if (i >= frame1 + frame2) {
+                        continue;
+                    }
+                    if (f == f) {
+                        floatMin[key] = floatCount[key] == 0 ? f : Math.min(floatMin[key], f);
+                        floatMax[key] = floatCount[key] == 0 ? f : Math.max(floatMax[key], f);
+                        floatCount[key]++;
+                        floatSum[key] += f;
+                    }
+                    byteMin[key] = rowCount[key] == 0 ? b : Math.min(byteMin[key], b);
+                    byteMax[key] = rowCount[key] == 0 ? b : Math.max(byteMax[key], b);
+                    byteSum[key] += b;
+                    charMax[key] = rowCount[key] == 0 ? c : Math.max(charMax[key], c);
+                    if (c != 0) {
+                        charMin[key] = charMin[key] == 0 ? c : Math.min(charMin[key], c);
+                    }
+                    uuidCount[key] += uuidNull ? 0 : 1;
+                    rowCount[key]++;
+                }
+
+                // map B sees the column top frame first, so its keys start with initial values
+                aggregateNarrowTypes(pRostiA, keys, floats, bytes, chars, uuids, frame1);
+                final long lo = frame1 + frame2;
+                Assert.assertTrue(Rosti.keyedIntDistinct(pRostiB, keys + 4L * lo, top));
+                aggregateNarrowTypes(pRostiB, keys + 4L * frame1, floats + 4L * frame1, bytes + frame1, chars + 2L * frame1, uuids + 16L * frame1, frame2);
+
+                Assert.assertTrue(Rosti.keyedIntCountMerge(pRostiA, pRostiB, 1));
+                Assert.assertTrue(Rosti.keyedIntSumDoubleMerge(pRostiA, pRostiB, 2));
+                Assert.assertTrue(Rosti.keyedIntMinDoubleMerge(pRostiA, pRostiB, 4));
+                Assert.assertTrue(Rosti.keyedIntMaxDoubleMerge(pRostiA, pRostiB, 5));
+                Assert.assertTrue(Rosti.keyedIntSumLongMerge(pRostiA, pRostiB, 6));
+                Assert.assertTrue(Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, 8));
+                Assert.assertTrue(Rosti.keyedIntMaxLongMerge(pRostiA, pRostiB, 9));
+                Assert.assertTrue(Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, 10));
+                Assert.assertTrue(Rosti.keyedIntMaxLongMerge(pRostiA, pRostiB, 11));
+                Assert.assertTrue(Rosti.keyedIntCountMerge(pRostiA, pRostiB, 12));
+
+                final long ctrl = Rosti.getCtrl(pRostiA);
+                final long slots = Rosti.getSlots(pRostiA);
+                final long shift = Rosti.getSlotShift(pRostiA);
+                final long[] offsets = new long[valueCount + 1];
+                for (int i = 1; i <= valueCount; i++) {
+                    offsets[i] = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRostiA) + 4L * i);
+                }
+                int size = 0;
+                for (long i = 0, n = Rosti.getCapacity(pRostiA); i < n; i++) {
+                    if (Unsafe.getUnsafe().getByte(ctrl + i) > -1) {
+                        final long slot = slots + (i << shift);
+                        final int key = Unsafe.getUnsafe().getInt(slot);
+                        final String msg = "key: " + key;
+                        Assert.assertEquals(msg, floatCount[key], Unsafe.getUnsafe().getLong(slot + offsets[1]));
+                        Assert.assertEquals(msg, floatSum[key], Unsafe.getUnsafe().getDouble(slot + offsets[2]), 0.0);
+                        Assert.assertEquals(msg, floatCount[key], Unsafe.getUnsafe().getLong(slot + offsets[3]));
+                        if (floatCount[key] > 0) {
+                            Assert.assertEquals(msg, floatMin[key], Unsafe.getUnsafe().getDouble(slot + offsets[4]), 0.0);
+                            Assert.assertEquals(msg, floatMax[key], Unsafe.getUnsafe().getDouble(slot + offsets[5]), 0.0);
+                        } else {
+                            // wrap up turns infinity into null
+                            Assert.assertEquals(msg, Double.POSITIVE_INFINITY, Unsafe.getUnsafe().getDouble(slot + offsets[4]), 0.0);
+                            Assert.assertEquals(msg, Double.NEGATIVE_INFINITY, Unsafe.getUnsafe().getDouble(slot + offsets[5]), 0.0);
+                        }
+                        Assert.assertEquals(msg, byteSum[key], Unsafe.getUnsafe().getLong(slot + offsets[6]));
+                        Assert.assertEquals(msg, rowCount[key], Unsafe.getUnsafe().getLong(slot + offsets[7]));
+                        Assert.assertEquals(msg, rowCount[key] > 0 ? byteMin[key] : Numbers.LONG_NaN, Unsafe.getUnsafe().getLong(slot + offsets[8]));
+                        Assert.assertEquals(msg, rowCount[key] > 0 ? byteMax[key] : Numbers.LONG_NaN, Unsafe.getUnsafe().getLong(slot + offsets[9]));
+                        Assert.assertEquals(msg, charMin[key] > 0 ? charMin[key] : Numbers.LONG_NaN, Unsafe.getUnsafe().getLong(slot + offsets[10]));
+                        Assert.assertEquals(msg, rowCount[key] > 0 ? charMax[key] : Numbers.LONG_NaN, Unsafe.getUnsafe().getLong(slot + offsets[11]));
+                        Assert.assertEquals(msg, uuidCount[key], Unsafe.getUnsafe().getLong(slot + offsets[12]));
+                        size++;
+                    }
+                }
+                Assert.assertEquals(keyCount, size);
+            } finally {
+                Rosti.free(pRostiA);
+                Rosti.free(pRostiB);
+                Unsafe.free(keys, 4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(floats, 4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(bytes, ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(chars, 2L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(uuids, 16L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            }
+        });
+    }
+
+    @Test
+    public void testKeyedVarianceDoubleWithNulls() throws Exception {
+        assertMemoryLeak(() -> {
+            final int dataKeyCount = 40;
+            final int keyCount = 50;
+            final int frame1 = 4999;
+            final int top = 101;
+            final int frame2 = ROW_COUNT - frame1 - top;
+            final Rnd rnd = new Rnd();
+            final long keys = Unsafe.malloc(4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long doubles = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final ArrayColumnTypes types = new ArrayColumnTypes();
+            types.add(ColumnType.INT);
+            types.add(ColumnType.DOUBLE);
+            types.add(ColumnType.DOUBLE);
+            types.add(ColumnType.LONG);
+            final long pRostiA = Rosti.alloc(types, 64);
+            final long pRostiB = Rosti.alloc(types, 64);
+            try {
+                Assert.assertNotEquals(0, pRostiA);
+                Assert.assertNotEquals(0, pRostiB);
+                for (long pRosti : new long[]{pRostiA, pRostiB}) {
+                    Unsafe.getUnsafe().putInt(Rosti.getInitialValueSlot(pRosti, 0), Numbers.INT_NaN);
+                    Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, 1), 0);
+                    Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, 2), 0);
+                    Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 3), 0);
+                }
+
+                final long[] count = new long[keyCount];
+                final double[] sum = new double[keyCount];
+                for (int i = 0; i < ROW_COUNT; i++) {
+                    final int key = i < frame1 + frame2 ? rnd.nextInt(dataKeyCount) : i % keyCount;
+                    // non-finite values are skipped
+                    final double d = rnd.nextInt(8) == 0 ? (rnd.nextBoolean() ? Double.NaN : Double.NEGATIVE_INFINITY) : (rnd.nextInt(2001) - 1000) / 8.0;
+                    Unsafe.getUnsafe().putInt(keys + 4L * i, key);
+                    Unsafe.getUnsafe().putDouble(doubles + 8L * i, d);
+                    if (i < frame1 + frame2 && Numbers.isFinite(d)) {
+                        count[key]++;
+                        sum[key] += d;
+                    }
+                }
+                final double[] m2 = new double[keyCount];
+                for (int i = 0; i < frame1 + frame2; i++) {
+                    final int key = Unsafe.getUnsafe().getInt(keys + 4L * i);
+                    final double d = Unsafe.getUnsafe().getDouble(doubles + 8L * i);
+                    if (Numbers.isFinite(d)) {
+                        final double delta = d - sum[key] / count[key];
+                        m2[key] += delta * delta;
+                    }
+                }
+
+                Assert.assertTrue(Rosti.keyedIntVarianceDouble(pRostiA, keys, doubles, frame1, 1));
+                Assert.assertTrue(Rosti.keyedIntDistinct(pRostiB, keys + 4L * (frame1 + frame2), top));
+                Assert.assertTrue(Rosti.keyedIntVarianceDouble(pRostiB, keys + 4L * frame1, doubles + 8L * frame1, frame2, 1));
+                Assert.assertTrue(Rosti.keyedIntVarianceDoubleMerge(pRostiA, pRostiB, 1));
+
+                final long ctrl = Rosti.getCtrl(pRostiA);
+                final long slots = Rosti.getSlots(pRostiA);
+                final long shift = Rosti.getSlotShift(pRostiA);
+                final long meanOffset = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRostiA) + 4);
+                final long m2Offset = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRostiA) + 8);
+                final long countOffset = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRostiA) + 12);
+                int size = 0;
+                for (long i = 0, n = Rosti.getCapacity(pRostiA); i < n; i++) {
+                    if (Unsafe.getUnsafe().getByte(ctrl + i) > -1) {
+                        final long slot = slots + (i << shift);
+                        final int key = Unsafe.getUnsafe().getInt(slot);
+                        final String msg = "key: " + key;
+                        Assert.assertEquals(msg, count[key], Unsafe.getUnsafe().getLong(slot + countOffset));
+                        if (count[key] > 0) {
+                            Assert.assertEquals(msg, sum[key] / count[key], Unsafe.getUnsafe().getDouble(slot + meanOffset), 1e-9);
+                            Assert.assertEquals(msg, m2[key], Unsafe.getUnsafe().getDouble(slot + m2Offset), 1e-6 * (1 + m2[key]));
+                        }
+                        size++;
+                    }
+                }
+                Assert.assertEquals(keyCount, size);
+
+                // wrap up replaces the mean with stddev_samp, keys without values get null
+                Assert.assertTrue(Rosti.keyedIntVarianceDoubleWrapUp(pRostiA, 1, 0, 0, 0, true, true));
+                for (long i = 0, n = Rosti.getCapacity(pRostiA); i < n; i++) {
+                    if (Unsafe.getUnsafe().getByte(ctrl + i) > -1) {
+                        final long slot = slots + (i << shift);
+                        final int key = Unsafe.getUnsafe().getInt(slot);
+                        final double expected = count[key] > 1 ? Math.sqrt(m2[key] / (count[key] - 1)) : Double.NaN;
+                        Assert.assertEquals("key: " + key, expected, Unsafe.getUnsafe().getDouble(slot + meanOffset), 1e-9);
+                    }
+                }
+            } finally {
+                Rosti.free(pRostiA);
+                Rosti.free(pRostiB);
+                Unsafe.free(keys, 4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(doubles, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            }
+        });
+    }
+
+    @Test
+    public void testLong128KeysMatchIntKeys() throws Exception {
+        assertKeyKindMatchesInt(KIND_LONG128);
+    }
+
+    @Test
+    public void testLongKeysClustered() throws Exception {
+        assertMemoryLeak(() -> {
+            // keys that differ only in high bits or share low bits must still spread over groups
+            final long[] keys = new long[ROW_COUNT];
+            for (int i = 0; i < ROW_COUNT; i++) {
+                keys[i] = i % 2 == 0 ? (long) (i / 2) << 32 : ((long) (i / 2) << 20) | 1;
+            }
+            assertLongKeyCounts(keys, 16 * 1024 - 1);
+        });
+    }
+
+    @Test
+    public void testLongKeysMatchIntKeys() throws Exception {
+        assertKeyKindMatchesInt(KIND_LONG);
+    }
+
+    @Test
+    public void testLongKeysSequential() throws Exception {
+        assertMemoryLeak(() -> {
+            final long[] keys = new long[ROW_COUNT];
+            for (int i = 0; i < ROW_COUNT; i++) {
+                keys[i] = i;
+            }
+            assertLongKeyCounts(keys, 16 * 1024 - 1);
+        });
+    }
+
+    @Test
+    public void testPartitionMergeMatchesMerge() throws Exception {
+        assertPartitionMergeMatchesMerge(KIND_INT);
+        assertPartitionMergeMatchesMerge(KIND_LONG);
+        assertPartitionMergeMatchesMerge(KIND_LONG128);
+    }
 
     @Test
     public void testPrintRosti() {
@@ -42,4 +544,447 @@ public class RostiTest extends AbstractCairoTest {
             Rosti.free(pRosti);
         }
     }
+
+    private static void aggregate(int keyKind, long pRosti, long pKeys, long pDoubles, long pLongs, long count, int base) {
+        switch (keyKind) {
+            case KIND_INT:
+                Assert.assertTrue(Rosti.keyedIntCount(pRosti, pKeys, count, base));
+                Assert.assertTrue(Rosti.keyedIntSumDouble(pRosti, pKeys, pDoubles, count, base + 1));
+                Assert.assertTrue(Rosti.keyedIntMaxDouble(pRosti, pKeys, pDoubles, count, base + 3));
+                Assert.assertTrue(Rosti.keyedIntMinLong(pRosti, pKeys, pLongs, count, base + 4));
+                Assert.assertTrue(Rosti.keyedIntSumLong(pRosti, pKeys, pLongs, count, base + 5));
+                break;
+            case KIND_LONG:
+                Assert.assertTrue(Rosti.keyedLongCount(pRosti, pKeys, count, base));
+                Assert.assertTrue(Rosti.keyedLongSumDouble(pRosti, pKeys, pDoubles, count, base + 1));
+                Assert.assertTrue(Rosti.keyedLongMaxDouble(pRosti, pKeys, pDoubles, count, base + 3));
+                Assert.assertTrue(Rosti.keyedLongMinLong(pRosti, pKeys, pLongs, count, base + 4));
+                Assert.assertTrue(Rosti.keyedLongSumLong(pRosti, pKeys, pLongs, count, base + 5));
+                break;
+            default:
+                Assert.assertTrue(Rosti.keyedLong128Count(pRosti, pKeys, count, base));
+                Assert.assertTrue(Rosti.keyedLong128SumDouble(pRosti, pKeys, pDoubles, count, base + 1));
+                Assert.assertTrue(Rosti.keyedLong128MaxDouble(pRosti, pKeys, pDoubles, count, base + 3));
+                Assert.assertTrue(Rosti.keyedLong128MinLong(pRosti, pKeys, pLongs, count, base + 4));
+                Assert.assertTrue(Rosti.keyedLong128SumLong(pRosti, pKeys, pLongs, count, base + 5));
+                break;
+        }
+    }
+
+    private static void aggregateNarrowTypes(long pRosti, long pKeys, long pFloats, long pBytes, long pChars, long pUuids, long count) {
+        Assert.assertTrue(Rosti.keyedIntCountFloat(pRosti, pKeys, pFloats, count, 1));
+        Assert.assertTrue(Rosti.keyedIntSumFloat(pRosti, pKeys, pFloats, count, 2));
+        Assert.assertTrue(Rosti.keyedIntMinFloat(pRosti, pKeys, pFloats, count, 4));
+        Assert.assertTrue(Rosti.keyedIntMaxFloat(pRosti, pKeys, pFloats, count, 5));
+        Assert.assertTrue(Rosti.keyedIntSumByte(pRosti, pKeys, pBytes, count, 6));
+        Assert.assertTrue(Rosti.keyedIntMinByte(pRosti, pKeys, pBytes, count, 8));
+        Assert.assertTrue(Rosti.keyedIntMaxByte(pRosti, pKeys, pBytes, count, 9));
+        Assert.assertTrue(Rosti.keyedIntMinChar(pRosti, pKeys, pChars, count, 10));
+        Assert.assertTrue(Rosti.keyedIntMaxChar(pRosti, pKeys, pChars, count, 11));
+        Assert.assertTrue(Rosti.keyedIntCountLong128(pRosti, pKeys, pUuids, count, 12));
+    }
+
+    private static long allocMap(int keyKind, long capacity) {
+        final long pRosti = Rosti.alloc(mapTypes(keyKind), capacity);
+        Assert.assertNotEquals(0, pRosti);
+        initValues(pRosti, keyKind, 1);
+        return pRosti;
+    }
+
+    // inserts keys from 0 to keyCount - 1 and checks control bytes 16-wide group probes rely on
+    private static void assertControlBytes(int keyCount, long expectedCapacity) {
+        final long pKeys = Unsafe.malloc(8L * keyCount, MemoryTag.NATIVE_DEFAULT);
+        final long pRosti = Rosti.alloc(new ArrayColumnTypes().add(ColumnType.LONG).add(ColumnType.LONG), 16);
+        try {
+            Assert.assertNotEquals(0, pRosti);
+            Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 0), Numbers.LONG_NaN);
+            Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 1), 0);
+            for (int i = 0; i < keyCount; i++) {
+                Unsafe.getUnsafe().putLong(pKeys + 8L * i, i);
+            }
+            Assert.assertTrue(Rosti.keyedLongCount(pRosti, pKeys, keyCount, 1));
+            Assert.assertEquals(keyCount, Rosti.getSize(pRosti));
+
+            final long capacity = Rosti.getCapacity(pRosti);
+            Assert.assertEquals(expectedCapacity, capacity);
+            final long ctrl = Rosti.getCtrl(pRosti);
+            // control bytes of the slots, the sentinel and a clone of the first group,
+            // rounded up to a cache line, slots follow them
+            Assert.assertEquals((capacity + 1 + 16 + 63) & ~63L, Rosti.getSlots(pRosti) - ctrl);
+            Assert.assertEquals(-1, Unsafe.getUnsafe().getByte(ctrl + capacity));
+            long full = 0;
+            for (long i = 0; i < capacity; i++) {
+                final byte b = Unsafe.getUnsafe().getByte(ctrl + i);
+                // nothing is deleted, every slot is either empty or full
+                Assert.assertTrue(b == -128 || b > -1);
+                if (b > -1) {
+                    full++;
+                }
+            }
+            Assert.assertEquals(keyCount, full);
+            // probe of a group that starts in the last 15 slots reads the clone past the sentinel
+            for (int i = 0; i < 15; i++) {
+                Assert.assertEquals(Unsafe.getUnsafe().getByte(ctrl + i), Unsafe.getUnsafe().getByte(ctrl + capacity + 1 + i));
+            }
+        } finally {
+            Rosti.free(pRosti);
+            Unsafe.free(pKeys, 8L * keyCount, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    private static void assertKeyBatch(int count, int keyRange) throws Exception {
+        assertMemoryLeak(() -> {
+            for (int keyKind = KIND_INT; keyKind <= KIND_LONG; keyKind++) {
+                // small map looks keys up as they are read, map of 512KB and more takes the prefetch pipeline
+                assertKeyBatchMatchesRowByRow(keyKind, 16, count, keyRange);
+                assertKeyBatchMatchesRowByRow(keyKind, 64 * 1024, count, keyRange);
+            }
+        });
+    }
+
+    // aggregates rows in a single call and then row by row into another map, returns capacity of the first map
+    private static long assertKeyBatchMatchesRowByRow(int keyKind, long capacity, int count, int keyRange) {
+        final Rnd rnd = new Rnd();
+        final long keySize = keyKind == KIND_INT ? 4 : 8;
+        final long keys = Unsafe.malloc(keySize * count, MemoryTag.NATIVE_DEFAULT);
+        final long doubles = Unsafe.malloc(8L * count, MemoryTag.NATIVE_DEFAULT);
+        final long longs = Unsafe.malloc(8L * count, MemoryTag.NATIVE_DEFAULT);
+        final long pBatch = allocMap(keyKind, capacity);
+        final long pRows = allocMap(keyKind, 16);
+        try {
+            for (int i = 0; i < count; i++) {
+                final int key = rnd.nextInt(10) == 0 ? Numbers.INT_NaN : rnd.nextInt(keyRange);
+                if (keyKind == KIND_INT) {
+                    Unsafe.getUnsafe().putInt(keys + 4L * i, key);
+                } else {
+                    Unsafe.getUnsafe().putLong(keys + 8L * i, toLongKey(key));
+                }
+                Unsafe.getUnsafe().putDouble(doubles + 8L * i, rnd.nextInt(8) == 0 ? Double.NaN : rnd.nextDouble() * 100);
+                Unsafe.getUnsafe().putLong(longs + 8L * i, rnd.nextInt(8) == 0 ? Numbers.LONG_NaN : rnd.nextInt(1000) - 500);
+            }
+
+            aggregate(keyKind, pBatch, keys, doubles, longs, count, 1);
+            for (int i = 0; i < count; i++) {
+                aggregate(keyKind, pRows, keys + keySize * i, doubles + 8L * i, longs + 8L * i, 1, 1);
+            }
+            Assert.assertEquals(collect(pRows, keyKind, 1), collect(pBatch, keyKind, 1));
+            return Rosti.getCapacity(pBatch);
+        } finally {
+            Rosti.free(pBatch);
+            Rosti.free(pRows);
+            Unsafe.free(keys, keySize * count, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(doubles, 8L * count, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(longs, 8L * count, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    private static void assertKeyKindMatchesInt(int keyKind) throws Exception {
+        assertMemoryLeak(() -> {
+            final Rnd rnd = new Rnd();
+            final long intKeys = Unsafe.malloc(4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long longKeys = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long long128Keys = Unsafe.malloc(16L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long doubles = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long longs = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long pIntA = allocMap(KIND_INT, 64);
+            final long pIntB = allocMap(KIND_INT, 64);
+            final long pA = allocMap(keyKind, 64);
+            final long pB = allocMap(keyKind, 64);
+            try {
+                for (int i = 0; i < ROW_COUNT; i++) {
+                    final int key = rnd.nextInt(10) == 0 ? Numbers.INT_NaN : rnd.nextInt(512) - 256;
+                    final long longKey = toLongKey(key);
+                    Unsafe.getUnsafe().putInt(intKeys + 4L * i, key);
+                    Unsafe.getUnsafe().putLong(longKeys + 8L * i, longKey);
+                    Unsafe.getUnsafe().putLong(long128Keys + 16L * i, longKey);
+                    Unsafe.getUnsafe().putLong(long128Keys + 16L * i + 8, longKey);
+                    Unsafe.getUnsafe().putDouble(doubles + 8L * i, rnd.nextInt(8) == 0 ? Double.NaN : rnd.nextDouble() * 100);
+                    Unsafe.getUnsafe().putLong(longs + 8L * i, rnd.nextInt(8) == 0 ? Numbers.LONG_NaN : rnd.nextInt(1000) - 500);
+                }
+
+                final long pKeys = keyKind == KIND_LONG ? longKeys : long128Keys;
+                final long keySize = keyKind == KIND_LONG ? 8 : 16;
+
+                // split rows between two maps to exercise merge
+                final int half = ROW_COUNT / 2;
+                aggregate(KIND_INT, pIntA, intKeys, doubles, longs, half, 1);
+                aggregate(KIND_INT, pIntB, intKeys + 4L * half, doubles + 8L * half, longs + 8L * half, ROW_COUNT - half, 1);
+                aggregate(keyKind, pA, pKeys, doubles, longs, half, 1);
+                aggregate(keyKind, pB, pKeys + keySize * half, doubles + 8L * half, longs + 8L * half, ROW_COUNT - half, 1);
+
+                mergeAndWrapUp(KIND_INT, pIntA, pIntB, 1);
+                mergeAndWrapUp(keyKind, pA, pB, 1);
+
+                final HashMap<Long, String> expected = collect(pIntA, KIND_INT, 1);
+                Assert.assertTrue(expected.size() > 500);
+                Assert.assertEquals(expected, collect(pA, keyKind, 1));
+            } finally {
+                Rosti.free(pIntA);
+                Rosti.free(pIntB);
+                Rosti.free(pA);
+                Rosti.free(pB);
+                Unsafe.free(intKeys, 4L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(longKeys, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(long128Keys, 16L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(doubles, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(longs, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            }
+        });
+    }
+
+    // maps split by key partition, merged and wrapped up partition by partition, hold the groups of the merged maps
+    private static void assertPartitionMergeMatchesMerge(int keyKind) throws Exception {
+        assertMemoryLeak(() -> {
+            final int partitionCount = 4;
+            final Rnd rnd = new Rnd();
+            final long keySize = keyKind == KIND_INT ? 4 : keyKind == KIND_LONG ? 8 : 16;
+            final long keys = Unsafe.malloc(keySize * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long doubles = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long longs = Unsafe.malloc(8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+            final long pPartitions = Unsafe.malloc(16L * partitionCount, MemoryTag.NATIVE_DEFAULT);
+            final long[] maps = new long[4 + 2 * partitionCount];
+            try {
+                for (int i = 0; i < maps.length; i++) {
+                    maps[i] = allocMap(keyKind, 16);
+                    if (i >= 4) {
+                        Unsafe.getUnsafe().putLong(pPartitions + 8L * (i - 4), maps[i]);
+                    }
+                }
+                for (int i = 0; i < ROW_COUNT; i++) {
+                    final int key = rnd.nextInt(10) == 0 ? Numbers.INT_NaN : rnd.nextInt(4096) - 2048;
+                    final long longKey = toLongKey(key);
+                    switch (keyKind) {
+                        case KIND_INT:
+                            Unsafe.getUnsafe().putInt(keys + 4L * i, key);
+                            break;
+                        case KIND_LONG:
+                            Unsafe.getUnsafe().putLong(keys + 8L * i, longKey);
+                            break;
+                        default:
+                            Unsafe.getUnsafe().putLong(keys + 16L * i, longKey);
+                            Unsafe.getUnsafe().putLong(keys + 16L * i + 8, longKey);
+                            break;
+                    }
+                    Unsafe.getUnsafe().putDouble(doubles + 8L * i, rnd.nextInt(8) == 0 ? Double.NaN : rnd.nextDouble() * 100);
+                    Unsafe.getUnsafe().putLong(longs + 8L * i, rnd.nextInt(8) == 0 ? Numbers.LONG_NaN : rnd.nextInt(1000) - 500);
+                }
+
+                // maps 0 and 1 are merged, maps 2 and 3 hold the same rows and are split
+                final int half = ROW_COUNT / 2;
+                for (int i = 0; i < 4; i += 2) {
+                    aggregate(keyKind, maps[i], keys, doubles, longs, half, 1);
+                    aggregate(keyKind, maps[i + 1], keys + keySize * half, doubles + 8L * half, longs + 8L * half, ROW_COUNT - half, 1);
+                }
+                mergeAndWrapUp(keyKind, maps[0], maps[1], 1);
+
+                Assert.assertTrue(Rosti.split(maps[2], pPartitions, partitionCount));
+                Assert.assertTrue(Rosti.split(maps[3], pPartitions + 8L * partitionCount, partitionCount));
+                final int nullKeyPartition = Rosti.getNullKeyPartition(maps[4], partitionCount);
+                final HashMap<Long, String> actual = new HashMap<>();
+                for (int i = 0; i < partitionCount; i++) {
+                    final long pPartition = maps[4 + i];
+                    mergeAndWrapUp(keyKind, pPartition, maps[4 + partitionCount + i], 1);
+                    if (i != nullKeyPartition) {
+                        // wrap up adds values at null key to every partition
+                        Assert.assertTrue(Rosti.removeNullKey(pPartition));
+                    }
+                    final HashMap<Long, String> groups = collect(pPartition, keyKind, 1);
+                    Assert.assertTrue(groups.size() > 0);
+                    for (Long key : groups.keySet()) {
+                        Assert.assertNull(actual.put(key, groups.get(key)));
+                    }
+                }
+                Assert.assertEquals(collect(maps[0], keyKind, 1), actual);
+            } finally {
+                for (int i = 0; i < maps.length; i++) {
+                    if (maps[i] != 0) {
+                        Rosti.free(maps[i]);
+                    }
+                }
+                Unsafe.free(keys, keySize * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(doubles, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(longs, 8L * ROW_COUNT, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(pPartitions, 16L * partitionCount, MemoryTag.NATIVE_DEFAULT);
+            }
+        });
+    }
+
+    // counts every key twice, keys must be distinct, each of them must end up in a slot of its own
+    private static void assertLongKeyCounts(long[] keys, long expectedCapacity) {
+        final int keyCount = keys.length;
+        final long pKeys = Unsafe.malloc(8L * keyCount, MemoryTag.NATIVE_DEFAULT);
+        final long pRosti = Rosti.alloc(new ArrayColumnTypes().add(ColumnType.LONG).add(ColumnType.LONG), 16);
+        try {
+            Assert.assertNotEquals(0, pRosti);
+            Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 0), Numbers.LONG_NaN);
+            Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 1), 0);
+            for (int i = 0; i < keyCount; i++) {
+                Unsafe.getUnsafe().putLong(pKeys + 8L * i, keys[i]);
+            }
+            Assert.assertTrue(Rosti.keyedLongCount(pRosti, pKeys, keyCount, 1));
+            Assert.assertTrue(Rosti.keyedLongCount(pRosti, pKeys, keyCount, 1));
+            Assert.assertEquals(keyCount, Rosti.getSize(pRosti));
+            Assert.assertEquals(expectedCapacity, Rosti.getCapacity(pRosti));
+
+            final HashMap<Long, Long> counts = new HashMap<>();
+            final long ctrl = Rosti.getCtrl(pRosti);
+            final long slots = Rosti.getSlots(pRosti);
+            final long shift = Rosti.getSlotShift(pRosti);
+            final long valueOffset = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRosti) + 4);
+            for (long i = 0, n = Rosti.getCapacity(pRosti); i < n; i++) {
+                if (Unsafe.getUnsafe().getByte(ctrl + i) > -1) {
+                    final long slot = slots + (i << shift);
+                    Assert.assertNull(counts.put(Unsafe.getUnsafe().getLong(slot), Unsafe.getUnsafe().getLong(slot + valueOffset)));
+                }
+            }
+            Assert.assertEquals(keyCount, counts.size());
+            for (int i = 0; i < keyCount; i++) {
+                Assert.assertEquals(Long.valueOf(2), counts.get(keys[i]));
+            }
+        } finally {
+            Rosti.free(pRosti);
+            Unsafe.free(pKeys, 8L * keyCount, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    // groups of the map by key, key of every kind is reduced to the LONG key its rows were generated from
+    private static HashMap<Long, String> collect(long pRosti, int keyKind, int base) {
+        final HashMap<Long, String> groups = new HashMap<>();
+        final StringSink sink = new StringSink();
+        final long ctrl = Rosti.getCtrl(pRosti);
+        final long slots = Rosti.getSlots(pRosti);
+        final long shift = Rosti.getSlotShift(pRosti);
+        final long capacity = Rosti.getCapacity(pRosti);
+        for (long i = 0; i < capacity; i++) {
+            if (Unsafe.getUnsafe().getByte(ctrl + i) > -1) {
+                final long slot = slots + (i << shift);
+                final long key = keyKind == KIND_INT
+                        ? toLongKey(Unsafe.getUnsafe().getInt(slot))
+                        : Unsafe.getUnsafe().getLong(slot);
+                sink.clear();
+                for (int j = 0; j < VALUE_COLUMN_COUNT; j++) {
+                    final long offset = Unsafe.getUnsafe().getInt(Rosti.getValueOffsets(pRosti) + (base + j) * 4L);
+                    sink.put(Unsafe.getUnsafe().getLong(slot + offset)).put(',');
+                }
+                Assert.assertNull(groups.put(key, sink.toString()));
+            }
+        }
+        Assert.assertEquals(Rosti.getSize(pRosti), groups.size());
+        return groups;
+    }
+
+    private static void initValues(long pRosti, int keyKind, int base) {
+        // null key, wrap up adds values at null to the slot of this key
+        switch (keyKind) {
+            case KIND_INT:
+                Unsafe.getUnsafe().putInt(Rosti.getInitialValueSlot(pRosti, 0), Numbers.INT_NaN);
+                break;
+            case KIND_LONG:
+                Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 0), Numbers.LONG_NaN);
+                break;
+            default:
+                Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 0), Numbers.LONG_NaN);
+                Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, 0) + Long.BYTES, Numbers.LONG_NaN);
+                break;
+        }
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, base), 0);
+        Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, base + 1), 0);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, base + 2), 0);
+        Unsafe.getUnsafe().putDouble(Rosti.getInitialValueSlot(pRosti, base + 3), Double.NEGATIVE_INFINITY);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, base + 4), Numbers.LONG_NaN);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, base + 5), 0);
+        Unsafe.getUnsafe().putLong(Rosti.getInitialValueSlot(pRosti, base + 6), 0);
+    }
+
+    private static ArrayColumnTypes mapTypes(int keyKind) {
+        final ArrayColumnTypes types = new ArrayColumnTypes();
+        switch (keyKind) {
+            case KIND_INT:
+                types.add(ColumnType.INT);
+                break;
+            case KIND_LONG:
+                types.add(ColumnType.LONG);
+                break;
+            default:
+                types.add(ColumnType.LONG128);
+                break;
+        }
+        types.add(ColumnType.LONG);
+        types.add(ColumnType.DOUBLE);
+        types.add(ColumnType.LONG);
+        types.add(ColumnType.DOUBLE);
+        types.add(ColumnType.LONG);
+        types.add(ColumnType.LONG);
+        types.add(ColumnType.LONG);
+        return types;
+    }
+
+    // merges B into A, B must be of the same key kind
+    private static void merge(int keyKind, long pRostiA, long pRostiB, int base) {
+        switch (keyKind) {
+            case KIND_INT:
+                Assert.assertTrue(Rosti.keyedIntCountMerge(pRostiA, pRostiB, base));
+                Assert.assertTrue(Rosti.keyedIntSumDoubleMerge(pRostiA, pRostiB, base + 1));
+                Assert.assertTrue(Rosti.keyedIntMaxDoubleMerge(pRostiA, pRostiB, base + 3));
+                Assert.assertTrue(Rosti.keyedIntMinLongMerge(pRostiA, pRostiB, base + 4));
+                Assert.assertTrue(Rosti.keyedIntSumLongMerge(pRostiA, pRostiB, base + 5));
+                break;
+            case KIND_LONG:
+                Assert.assertTrue(Rosti.keyedLongCountMerge(pRostiA, pRostiB, base));
+                Assert.assertTrue(Rosti.keyedLongSumDoubleMerge(pRostiA, pRostiB, base + 1));
+                Assert.assertTrue(Rosti.keyedLongMaxDoubleMerge(pRostiA, pRostiB, base + 3));
+                Assert.assertTrue(Rosti.keyedLongMinLongMerge(pRostiA, pRostiB, base + 4));
+                Assert.assertTrue(Rosti.keyedLongSumLongMerge(pRostiA, pRostiB, base + 5));
+                break;
+            default:
+                Assert.assertTrue(Rosti.keyedLong128CountMerge(pRostiA, pRostiB, base));
+                Assert.assertTrue(Rosti.keyedLong128SumDoubleMerge(pRostiA, pRostiB, base + 1));
+                Assert.assertTrue(Rosti.keyedLong128MaxDoubleMerge(pRostiA, pRostiB, base + 3));
+                Assert.assertTrue(Rosti.keyedLong128MinLongMerge(pRostiA, pRostiB, base + 4));
+                Assert.assertTrue(Rosti.keyedLong128SumLongMerge(pRostiA, pRostiB, base + 5));
+                break;
+        }
+    }
+
+    private static void mergeAndWrapUp(int keyKind, long pRostiA, long pRostiB, int base) {
+        merge(keyKind, pRostiA, pRostiB, base);
+        wrapUp(keyKind, pRostiA, base);
+    }
+
+    private static long toLongKey(int key) {
+        return key == Numbers.INT_NaN ? Numbers.LONG_NaN : key;
+    }
+
+    // adds values aggregated at null key outside the map, as if null key frames had been seen
+    private static void wrapUp(int keyKind, long pRosti, int base) {
+        final long countAtNull = 3;
+        final double sumAtNull = 1.5;
+        final long sumAtNullCount = 2;
+        final double maxAtNull = 1000.0;
+        final long minAtNull = -1000;
+        final long longSumAtNull = 11;
+        switch (keyKind) {
+            case KIND_INT:
+                Assert.assertTrue(Rosti.keyedIntCountWrapUp(pRosti, base, countAtNull));
+                Assert.assertTrue(Rosti.keyedIntSumDoubleWrapUp(pRosti, base + 1, sumAtNull, sumAtNullCount));
+                Assert.assertTrue(Rosti.keyedIntMaxDoubleWrapUp(pRosti, base + 3, maxAtNull));
+                Assert.assertTrue(Rosti.keyedIntMinLongWrapUp(pRosti, base + 4, minAtNull));
+                Assert.assertTrue(Rosti.keyedIntSumLongWrapUp(pRosti, base + 5, longSumAtNull, sumAtNullCount));
+                break;
+            case KIND_LONG:
+                Assert.assertTrue(Rosti.keyedLongCountWrapUp(pRosti, base, countAtNull));
+                Assert.assertTrue(Rosti.keyedLongSumDoubleWrapUp(pRosti, base + 1, sumAtNull, sumAtNullCount));
+                Assert.assertTrue(Rosti.keyedLongMaxDoubleWrapUp(pRosti, base + 3, maxAtNull));
+                Assert.assertTrue(Rosti.keyedLongMinLongWrapUp(pRosti, base + 4, minAtNull));
+                Assert.assertTrue(Rosti.keyedLongSumLongWrapUp(pRosti, base + 5, longSumAtNull, sumAtNullCount));
+                break;
+            default:
+                Assert.assertTrue(Rosti.keyedLong128CountWrapUp(pRosti, base, countAtNull));
+                Assert.assertTrue(Rosti.keyedLong128SumDoubleWrapUp(pRosti, base + 1, sumAtNull, sumAtNullCount));
+                Assert.assertTrue(Rosti.keyedLong128MaxDoubleWrapUp(pRosti, base + 3, maxAtNull));
+                Assert.assertTrue(Rosti.keyedLong128MinLongWrapUp(pRosti, base + 4, minAtNull));
+                Assert.assertTrue(Rosti.keyedLong128SumLongWrapUp(pRosti, base + 5, longSumAtNull, sumAtNullCount));
+                break;
+        }
+    }
 }
@@ -61,6 +61,7 @@ public class AbstractO3Test extends AbstractTest {
     protected static boolean mixedIOEnabled;
     protected static boolean mixedIOEnabledFFDefault;
     protected static int o3MemMaxPages = -1;
+    protected static long o3ParallelSortMinRows = -1;
     protected static long partitionO3SplitThreshold = -1;
 
     @Rule
@@ -92,6 +93,7 @@ public class AbstractO3Test extends AbstractTest {
         mixedIOEnabled = mixedIOEnabledFFDefault;
         dataAppendPageSize = -1;
         o3MemMaxPages = -1;
+        o3ParallelSortMinRows = -1;
         partitionO3SplitThreshold = -1;
         super.tearDown();
     }
@@ -329,6 +331,11 @@ public class AbstractO3Test extends AbstractTest {
                         return o3MemMaxPages > 0 ? o3MemMaxPages : super.getO3MemMaxPages();
                     }
 
+                    @Override
+                    public long getO3ParallelSortMinRows() {
+                        return o3ParallelSortMinRows > -1 ? o3ParallelSortMinRows : super.getO3ParallelSortMinRows();
+                    }
+
                     @Override
                     public long getPartitionO3SplitMinSize() {
                         return partitionO3SplitThreshold > -1 ? partitionO3SplitThreshold : super.getPartitionO3SplitMinSize();
@@ -390,6 +397,11 @@ public class AbstractO3Test extends AbstractTest {
                         return 0;
                     }
 
+                    @Override
+                    public long getO3ParallelSortMinRows() {
+                        return o3ParallelSortMinRows > -1 ? o3ParallelSortMinRows : super.getO3ParallelSortMinRows();
+                    }
+
                     @Override
                     public int getO3PartitionQueueCapacity() {
                         return 0;
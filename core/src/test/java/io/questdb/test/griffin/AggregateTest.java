@@ -51,6 +51,7 @@ import org.junit.Test;
 import org.junit.runner.RunWith;
 import org.junit.runners.Parameterized;
 
+import java.io.File;
 import java.util.Arrays;
 import java.util.Collection;
 import java.util.concurrent.atomic.AtomicInteger;
@@ -255,6 +256,300 @@ public class AggregateTest extends AbstractCairoTest {
         testAggregations(aggregateFunctions, aggregateColTypes);
     }
 
+    @Test
+    public void testFusedKeyedAggregatesMatchUnfused() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(
+                    "create table tab as (select" +
+                            " rnd_symbol('a','b','c',null) s," +
+                            " rnd_int(-1000, 1000, 2) i," +
+                            " rnd_long(-1000, 1000, 2) l," +
+                            " rnd_double(2) d," +
+                            " rnd_short() sh," +
+                            " rnd_date(to_date('2015', 'yyyy'), to_date('2016', 'yyyy'), 2) dt," +
+                            " rnd_long256() l256," +
+                            " timestamp_sequence(0, 360000000) ts" +
+                            " from long_sequence(1000)) timestamp(ts) partition by day"
+            );
+            // column tops in the last partitions
+            ddl("alter table tab add column d2 double");
+            ddl("alter table tab add column i2 int");
+            ddl(
+                    "insert into tab select" +
+                            " rnd_symbol('a','b','c',null)," +
+                            " rnd_int(-1000, 1000, 2)," +
+                            " rnd_long(-1000, 1000, 2)," +
+                            " rnd_double(2)," +
+                            " rnd_short()," +
+                            " rnd_date(to_date('2015', 'yyyy'), to_date('2016', 'yyyy'), 2)," +
+                            " rnd_long256()," +
+                            " timestamp_sequence(360000000000, 360000000)," +
+                            " rnd_double(2)," +
+                            " rnd_int(-1000, 1000, 2)" +
+                            " from long_sequence(1000)"
+            );
+
+            final String[] queries = {
+                    "select s, count(i), sum(i), min(i), max(i), avg(i) from tab order by s",
+                    "select s, count(l), sum(l), min(l), max(l), avg(l) from tab order by s",
+                    "select s, count(d), sum(d), ksum(d), nsum(d), min(d), max(d), avg(d) from tab order by s",
+                    "select s, sum(sh), min(sh), max(sh), avg(sh) from tab order by s",
+                    "select s, sum(dt), min(dt), max(dt) from tab order by s",
+                    "select s, sum(l256), count(), sum(i), sum(d) from tab order by s",
+                    "select s, sum(d2), min(d2), max(d2), count(d2), sum(i2), min(i2), max(i2) from tab order by s",
+                    "select hour(ts) h, count(i), sum(i), min(i), max(i), sum(d), min(d), max(d) from tab order by h",
+                    "select hour(ts) h, sum(d2), min(d2), max(d2), avg(i2), count(i2) from tab order by h"
+            };
+
+            final String[] expected = new String[queries.length];
+            for (int i = 0; i < queries.length; i++) {
+                printSql(queries[i]);
+                expected[i] = sink.toString();
+            }
+
+            node1.setProperty(PropertyKey.CAIRO_SQL_GROUPBY_FUSED_AGGREGATES_ENABLED, false);
+            for (int i = 0; i < queries.length; i++) {
+                assertSql(expected[i], queries[i]);
+            }
+        });
+    }
+
+    @Test
+    public void testGroupByDenseKeysMatchMap() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(
+                    "create table tab as (select" +
+                            " rnd_symbol('a','b','c',null) s," +
+                            " rnd_int(-1000, 1000, 2) i," +
+                            " rnd_double(2) d," +
+                            " timestamp_sequence(0, 360000000) ts" +
+                            " from long_sequence(1000)) timestamp(ts) partition by day"
+            );
+            // key and value column tops
+            ddl("alter table tab add column s2 symbol");
+            ddl("alter table tab add column l long");
+            ddl(
+                    "insert into tab select" +
+                            " rnd_symbol('a','b','c',null)," +
+                            " rnd_int(-1000, 1000, 2)," +
+                            " rnd_double(2)," +
+                            " timestamp_sequence(360000000000, 360000000)," +
+                            " rnd_symbol('x','y','z',null)," +
+                            " rnd_long(-1000, 1000, 2)" +
+                            " from long_sequence(1000)"
+            );
+
+            final String[] queries = {
+                    "select s, count(), count(i), sum(i), min(i), max(i), avg(d), ksum(d) from tab order by s",
+                    "select s, sum(l), min(l), max(l), count(l) from tab order by s",
+                    "select s2, count(), sum(i), min(d), max(d), sum(l) from tab order by s2",
+                    "select hour(ts) h, count(), sum(i), min(i), max(d), sum(l) from tab order by h",
+                    // not every function can be dense, keys go to the map
+                    "select s, sum(i), var_pop(d) from tab order by s"
+            };
+
+            final String[] expected = new String[queries.length];
+            for (int i = 0; i < queries.length; i++) {
+                printSql(queries[i]);
+                expected[i] = sink.toString();
+            }
+
+            node1.setProperty(PropertyKey.CAIRO_SQL_GROUPBY_DENSE_KEYS_ENABLED, false);
+            for (int i = 0; i < queries.length; i++) {
+                assertSql(expected[i], queries[i]);
+            }
+        });
+    }
+
+    @Test
+    public void testGroupByIntPairKeysMatchMap() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(
+                    "create table tab as (select" +
+                            " rnd_symbol('a', 'b', 'c', null) s1," +
+                            " rnd_symbol('x', 'y', null) s2," +
+                            " rnd_int(-5, 5, 2) i," +
+                            " rnd_long(-1000, 1000, 2) l," +
+                            " rnd_double(2) d," +
+                            " timestamp_sequence(0, 360000000) ts" +
+                            " from long_sequence(1000)) timestamp(ts) partition by day"
+            );
+            // key and value column tops
+            ddl("alter table tab add column s3 symbol");
+            ddl("alter table tab add column i2 int");
+            ddl(
+                    "insert into tab select" +
+                            " rnd_symbol('a', 'b', 'd', null)," +
+                            " rnd_symbol('x', 'z', null)," +
+                            " rnd_int(-5, 5, 2)," +
+                            " rnd_long(-1000, 1000, 2)," +
+                            " rnd_double(2)," +
+                            " timestamp_sequence(360000000000, 360000000)," +
+                            " rnd_symbol('p', 'q', null)," +
+                            " rnd_int(-1000, 1000, 2)" +
+                            " from long_sequence(1000)"
+            );
+
+            // floating point sums depend on the order of rows, only exact aggregates are compared
+            final String[] queries = {
+                    "select s1, s2, count(), count(i), sum(i), min(l), max(l), avg(i), min(d), max(d) from tab order by s1, s2",
+                    "select i, s1, count(), sum(l), min(i2), max(i2), count(i2) from tab order by i, s1",
+                    "select s2, i, sum(l), sum(i2) from tab order by s2, i",
+                    "select s3, s1, count(), sum(i), max(d) from tab order by s3, s1",
+                    "select i2, s3, count(), sum(l) from tab order by i2, s3",
+                    "select s1, s3 from tab group by s1, s3 order by s1, s3"
+            };
+
+            // expected results come from the map based GROUP BY
+            node1.setProperty(PropertyKey.CAIRO_SQL_GROUPBY_LONG_KEYS_ENABLED, false);
+            final String[] expected = new String[queries.length];
+            for (int i = 0; i < queries.length; i++) {
+                printSql(queries[i]);
+                expected[i] = sink.toString();
+            }
+
+            node1.setProperty(PropertyKey.CAIRO_SQL_GROUPBY_LONG_KEYS_ENABLED, true);
+            assertPlan(
+                    "select s1, s2, count() from tab",
+                    "GroupBy vectorized: true workers: 1\n" +
+                            "  keys: [s1,s2]\n" +
+                            "  values: [count(*)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: tab\n"
+            );
+            for (int i = 0; i < queries.length; i++) {
+                assertSql(expected[i], queries[i]);
+            }
+        });
+    }
+
+    @Test
+    public void testGroupByLongKeysMatchMap() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(
+                    "create table tab as (select" +
+                            " rnd_long(-100, 100, 2) l," +
+                            " cast(rnd_long(0, 50, 2) * 1000000 as timestamp) t," +
+                            " cast(rnd_str('11111111-1111-1111-1111-111111111111', '22222222-2222-2222-2222-222222222222', '33333333-3333-3333-3333-333333333333', null) as uuid) u," +
+                            " rnd_int(-1000, 1000, 2) i," +
+                            " rnd_double(2) d," +
+                            " timestamp_sequence(0, 360000000) ts" +
+                            " from long_sequence(1000)) timestamp(ts) partition by day"
+            );
+            // key and value column tops
+            ddl("alter table tab add column l2 long");
+            ddl("alter table tab add column u2 uuid");
+            ddl(
+                    "insert into tab select" +
+                            " rnd_long(-100, 100, 2)," +
+                            " cast(rnd_long(0, 50, 2) * 1000000 as timestamp)," +
+                            " cast(rnd_str('11111111-1111-1111-1111-111111111111', '22222222-2222-2222-2222-222222222222', null) as uuid)," +
+                            " rnd_int(-1000, 1000, 2)," +
+                            " rnd_double(2)," +
+                            " timestamp_sequence(360000000000, 360000000)," +
+                            " rnd_long(0, 10, 2)," +
+                            " cast(rnd_str('44444444-4444-4444-4444-444444444444', null) as uuid)" +
+                            " from long_sequence(1000)"
+            );
+
+            // floating point sums depend on the order of rows, only exact aggregates are compared
+            final String[] queries = {
+                    "select l, count(), count(i), sum(i), min(i), max(i), avg(i), min(d), max(d), count(d) from tab order by l",
+                    "select t, sum(l), min(l), max(l), count(l), sum(l2) from tab order by t",
+                    "select u, count(), sum(i), min(d), max(d), sum(l) from tab order by u",
+                    "select l2, count(), sum(i), min(d), max(d) from tab order by l2",
+                    "select u2, count(), sum(i), max(l) from tab order by u2",
+                    "select distinct l2 from tab order by l2",
+                    "select distinct u2 from tab order by u2"
+            };
+
+            final String[] expected = new String[queries.length];
+            for (int i = 0; i < queries.length; i++) {
+                printSql(queries[i]);
+                expected[i] = sink.toString();
+            }
+
+            node1.setProperty(PropertyKey.CAIRO_SQL_GROUPBY_LONG_KEYS_ENABLED, true);
+            assertPlan(
+                    "select l, count() from tab",
+                    "GroupBy vectorized: true workers: 1\n" +
+                            "  keys: [l]\n" +
+                            "  values: [count(*)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: tab\n"
+            );
+            assertPlan(
+                    "select u, count() from tab",
+                    "GroupBy vectorized: true workers: 1\n" +
+                            "  keys: [u]\n" +
+                            "  values: [count(*)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: tab\n"
+            );
+            for (int i = 0; i < queries.length; i++) {
+                assertSql(expected[i], queries[i]);
+            }
+        });
+    }
+
+    @Test
+    public void testGroupByStrKeysMatchMap() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(
+                    "create table tab as (select" +
+                            " rnd_str(50, 1, 40, 5) s," +
+                            " rnd_int(-1000, 1000, 2) i," +
+                            " rnd_double(2) d," +
+                            " timestamp_sequence(0, 360000000) ts" +
+                            " from long_sequence(1000)) timestamp(ts) partition by day"
+            );
+            // key and value column tops
+            ddl("alter table tab add column s2 string");
+            ddl("alter table tab add column l long");
+            ddl(
+                    "insert into tab select" +
+                            " rnd_str(50, 1, 40, 5)," +
+                            " rnd_int(-1000, 1000, 2)," +
+                            " rnd_double(2)," +
+                            " timestamp_sequence(360000000000, 360000000)," +
+                            " rnd_str('', 'x', 'yyyyyyyyyyyyyyyyyyyy', null)," +
+                            " rnd_long(-1000, 1000, 2)" +
+                            " from long_sequence(1000)"
+            );
+
+            // floating point sums depend on the order of rows, only exact aggregates are compared
+            final String[] queries = {
+                    "select s, count(), count(i), sum(i), min(i), max(i), avg(i), min(d), max(d), count(d) from tab order by s",
+                    "select s, sum(l), min(l), max(l), count(l) from tab order by s",
+                    "select s2, count(), sum(i), min(d), max(d), sum(l) from tab order by s2",
+                    "select distinct s2 from tab order by s2"
+            };
+
+            final String[] expected = new String[queries.length];
+            for (int i = 0; i < queries.length; i++) {
+                printSql(queries[i]);
+                expected[i] = sink.toString();
+            }
+
+            node1.setProperty(PropertyKey.CAIRO_SQL_GROUPBY_STR_KEYS_ENABLED, true);
+            assertPlan(
+                    "select s, count() from tab",
+                    "GroupBy vectorized: true workers: 1\n" +
+                            "  keys: [s]\n" +
+                            "  values: [count(*)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: tab\n"
+            );
+            for (int i = 0; i < queries.length; i++) {
+                assertSql(expected[i], queries[i]);
+            }
+        });
+    }
+
     @Test
     public void testGroupByWithIndexedSymbolKey() throws Exception {
         assertMemoryLeak(() -> {
@@ -364,30 +659,18 @@ public class AggregateTest extends AbstractCairoTest {
                     "    and ts < '2023-02-02' " +
                     "order by 1 asc";
 
-            final String plan;
-            if (enableParallelGroupBy) {
-                plan = "Sort light\n" +
-                        "  keys: [org_uuid]\n" +
-                        "    Async Group By workers: 1\n" +
-                        "      keys: [org_uuid,account_uuid]\n" +
-                        "      values: [sum(price)]\n" +
-                        "      filter: null\n" +
-                        "        DataFrame\n" +
-                        "            Row forward scan\n" +
-                        "            Interval forward scan on: records\n" +
-                        "              intervals: [(\"2023-02-01T00:00:00.000001Z\",\"2023-02-01T23:59:59.999999Z\")]\n";
-            } else {
-                plan = "Sort light\n" +
-                        "  keys: [org_uuid]\n" +
-                        "    GroupBy vectorized: false\n" +
-                        "      keys: [org_uuid,account_uuid]\n" +
-                        "      values: [sum(price)]\n" +
-                        "        DataFrame\n" +
-                        "            Row forward scan\n" +
-                        "            Interval forward scan on: records\n" +
-                        "              intervals: [(\"2023-02-01T00:00:00.000001Z\",\"2023-02-01T23:59:59.999999Z\")]\n";
-            }
-            assertPlan(query, plan);
+            assertPlan(
+                    query,
+                    "Sort light\n" +
+                            "  keys: [org_uuid]\n" +
+                            "    GroupBy vectorized: true workers: 1\n" +
+                            "      keys: [org_uuid,account_uuid]\n" +
+                            "      values: [sum(price)]\n" +
+                            "        DataFrame\n" +
+                            "            Row forward scan\n" +
+                            "            Interval forward scan on: records\n" +
+                            "              intervals: [(\"2023-02-01T00:00:00.000001Z\",\"2023-02-01T23:59:59.999999Z\")]\n"
+            );
 
             assertQuery(
                     "org_uuid\taccount_uuid\ttotal_price\n" +
@@ -1530,6 +1813,43 @@ public class AggregateTest extends AbstractCairoTest {
         });
     }
 
+    @Test
+    public void testRostiPartitionMergeManyWorkers() throws Exception {
+        // maps hold too many keys to be merged into the biggest one by a single thread
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 1000);
+        final AtomicInteger allocCount = new AtomicInteger();
+        final RostiAllocFacade raf = new RostiAllocFacadeImpl() {
+            @Override
+            public long alloc(ColumnTypes types, long capacity) {
+                allocCount.incrementAndGet();
+                return super.alloc(types, capacity);
+            }
+        };
+
+        executeWithPool(4, 32, raf, (CairoEngine engine, SqlCompiler compiler, SqlExecutionContext sqlExecutionContext) -> {
+            engine.ddl(
+                    "create table tab as (select timestamp_sequence(0, 10000) ts, x from long_sequence(400000)) timestamp(ts) partition by hour",
+                    sqlExecutionContext
+            );
+            // null key comes from key column tops as well as from null values
+            engine.ddl("alter table tab add column k int", sqlExecutionContext);
+            engine.insert(
+                    "insert into tab select timestamp_sequence(4000000000, 10000), x, case when x % 7 = 0 then null else cast(x % 200000 as int) end from long_sequence(400000)",
+                    sqlExecutionContext
+            );
+            // filter forces non-vector group by
+            TestUtils.assertSqlCursors(
+                    compiler,
+                    sqlExecutionContext,
+                    "select k, count() c, sum(x) s, min(x) mn, max(x) mx, avg(x) a from tab where now() > '1000-01-01' order by k",
+                    "select k, count() c, sum(x) s, min(x) mn, max(x) mx, avg(x) a from tab order by k",
+                    LOG
+            );
+            // maps of partitions are allocated on the first partitioned merge
+            Assert.assertTrue(allocCount.get() > 4);
+        });
+    }
+
     @Test
     public void testRostiReallocation() throws Exception {
         configOverrideRostiAllocFacade(
@@ -1554,6 +1874,126 @@ public class AggregateTest extends AbstractCairoTest {
         });
     }
 
+    @Test
+    public void testRostiSpill() throws Exception {
+        // every map is over the threshold, so it is spilled to disk after each page frame
+        setProperty(PropertyKey.CAIRO_SQL_GROUPBY_SPILL_THRESHOLD, 1);
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 1000);
+        assertMemoryLeak(() -> {
+            ddl("create table tab as (select case when x % 10 = 0 then null else cast(x % 100 as int) end k, x from long_sequence(10000))");
+            assertSql(
+                    "count\tsum\tsum1\tmin\tmax\n" +
+                            "91\t10000\t50005000\t4951.0\t5049.0\n",
+                    "select count(), sum(c), sum(s), min(a), max(a) from (select k, count() c, sum(x) s, avg(x) a from tab)"
+            );
+            assertSql(
+                    "k\tc\ts\n" +
+                            "\t1000\t5005000\n",
+                    "select * from (select k, count() c, sum(x) s from tab) where k = null"
+            );
+        });
+    }
+
+    @Test
+    public void testRostiSpillManyWorkers() throws Exception {
+        // maps of all workers spill to their own files at the same time
+        setProperty(PropertyKey.CAIRO_SQL_GROUPBY_SPILL_THRESHOLD, 1);
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 1000);
+        executeWithPool(4, 32, (CairoEngine engine, SqlCompiler compiler, SqlExecutionContext sqlExecutionContext) -> {
+            engine.ddl(
+                    "create table tab as (select case when x % 10 = 0 then null else cast(x % 1000 as int) end k, x, rnd_double(2) d from long_sequence(100000))",
+                    sqlExecutionContext
+            );
+            // filter forces non-vector group by
+            TestUtils.assertSqlCursors(
+                    compiler,
+                    sqlExecutionContext,
+                    "select k, count() c, sum(x) s, min(x) mn, max(d) mx from tab where now() > '1000-01-01' order by k",
+                    "select k, count() c, sum(x) s, min(x) mn, max(d) mx from tab order by k",
+                    LOG
+            );
+        });
+    }
+
+    @Test
+    public void testRostiSpillNullKeyPartition() throws Exception {
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 1000);
+        assertMemoryLeak(() -> {
+            ddl("create table tab as (select x, timestamp_sequence(0, 1000000) ts from long_sequence(5000)) timestamp(ts) partition by hour");
+            // null key comes from key column tops as well as from null values
+            ddl("alter table tab add column k int");
+            ddl("insert into tab select x, timestamp_sequence(5000000000, 1000000), case when x % 7 = 0 then null else cast(x % 50 as int) end from long_sequence(5000)");
+            final String query = "select k, count() c, sum(x) s, min(x) mn, max(x) mx from tab order by k";
+            printSql(query);
+            final String expected = sink.toString();
+
+            setProperty(PropertyKey.CAIRO_SQL_GROUPBY_SPILL_THRESHOLD, 1);
+            assertSql(expected, query);
+            assertSql(
+                    "k\tc\ts\n" +
+                            "\t5714\t14289285\n",
+                    "select * from (select k, count() c, sum(x) s from tab) where k = null"
+            );
+        });
+    }
+
+    @Test
+    public void testRostiSpillResultClearedOnReopen() throws Exception {
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 1000);
+        assertMemoryLeak(() -> {
+            ddl("create table tab as (select case when x % 10 = 0 then null else cast(x % 100 as int) end k, x from long_sequence(10000))");
+            final String query = "select * from (select k, count() c, sum(x) s from tab) order by k";
+            printSql(query);
+            final String expected = sink.toString();
+
+            setProperty(PropertyKey.CAIRO_SQL_GROUPBY_SPILL_THRESHOLD, 1);
+            try (RecordCursorFactory factory = select(query)) {
+                for (int i = 0; i < 3; i++) {
+                    try (RecordCursor cursor = factory.getCursor(sqlExecutionContext)) {
+                        TestUtils.assertCursor(expected, cursor, factory.getMetadata(), true, sink);
+                        // result is served from the spilled result file
+                        Assert.assertTrue(countSpillFiles() > 0);
+                    }
+                    Assert.assertEquals(0, countSpillFiles());
+                }
+            }
+        });
+    }
+
+    @Test
+    public void testRostiSpillSplitsOversizedPartition() throws Exception {
+        // keys of each spill partition take about 1MB, partitions are split further at merge to fit the threshold
+        final long threshold = 256 * 1024;
+        final long[] peak = {0};
+        configOverrideRostiAllocFacade(
+                new RostiAllocFacadeImpl() {
+                    @Override
+                    public void updateMemoryUsage(long pRosti, long oldSize) {
+                        super.updateMemoryUsage(pRosti, oldSize);
+                        peak[0] = Math.max(peak[0], Rosti.getAllocMemory(pRosti));
+                    }
+                }
+        );
+        setProperty(PropertyKey.CAIRO_SQL_GROUPBY_SPILL_THRESHOLD, threshold);
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 1000);
+        assertMemoryLeak(() -> {
+            ddl("create table tab as (select case when x % 10 = 0 then null else cast(x as int) end k, x from long_sequence(500000))");
+            assertSql(
+                    "count\tsum\tsum1\n" +
+                            "450001\t500000\t125000250000\n",
+                    "select count(), sum(c), sum(s) from (select k, count() c, sum(x) s from tab)"
+            );
+            assertSql(
+                    "k\tc\ts\n" +
+                            "\t50000\t12500250000\n",
+                    "select * from (select k, count() c, sum(x) s from tab) where k = null"
+            );
+            // maps are spilled once they grow past the threshold, merged partitions stay below it too
+            Assert.assertTrue(peak[0] > 0);
+            Assert.assertTrue(peak[0] < 2 * threshold);
+        });
+    }
+
     @Test
     public void testRostiWithColTopsAndIdleWorkers() throws Exception {
         executeWithPool(4, 16, AggregateTest::runCountTestWithColTops);
@@ -1718,6 +2158,12 @@ public class AggregateTest extends AbstractCairoTest {
         });
     }
 
+    // files of spilled maps and of spilled results in the spill root
+    private static int countSpillFiles() {
+        final String[] files = new File(configuration.getGroupBySpillRoot().toString()).list((dir, name) -> name.startsWith("groupby_spill_"));
+        return files != null ? files.length : 0;
+    }
+
     private static String getColumnName(int type) {
         String typeStr = ColumnType.nameOf(type);
         return "c" + typeStr.replace("(", "").replace(")", "");
@@ -2043,6 +2489,11 @@ public class AggregateTest extends AbstractCairoTest {
                         return rostiAllocFacade;
                     }
 
+                    @Override
+                    public long getGroupBySpillThreshold() {
+                        return configuration.getGroupBySpillThreshold();
+                    }
+
                     @Override
                     public int getSqlPageFrameMaxRows() {
                         return configuration.getSqlPageFrameMaxRows();
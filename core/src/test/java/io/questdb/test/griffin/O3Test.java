@@ -534,6 +534,18 @@ public class O3Test extends AbstractO3Test {
         executeWithPool(0, O3Test::testO3EdgeBug);
     }
 
+    @Test
+    public void testO3ParallelSortContended() throws Exception {
+        o3ParallelSortMinRows = 1000;
+        executeWithPool(0, O3Test::testO3ParallelSort0);
+    }
+
+    @Test
+    public void testO3ParallelSortParallel() throws Exception {
+        o3ParallelSortMinRows = 1000;
+        executeWithPool(4, O3Test::testO3ParallelSort0);
+    }
+
     @Test
     public void testOOOFollowedByAnotherOOOParallel() throws Exception {
         executeWithPool(4, O3Test::testOooFollowedByAnotherOOO0);
@@ -4599,6 +4611,54 @@ public class O3Test extends AbstractO3Test {
         );
     }
 
+    private static void testO3ParallelSort0(
+            CairoEngine engine,
+            SqlCompiler compiler,
+            SqlExecutionContext sqlExecutionContext
+    ) throws SqlException {
+        compiler.compile(
+                "create table x (" +
+                        "seq long, " +
+                        "ts timestamp" +
+                        ") timestamp (ts) partition by DAY",
+                sqlExecutionContext
+        );
+
+        final Rnd rnd = TestUtils.generateRandom(LOG);
+        try (TableWriter w = TestUtils.getWriter(engine, "x")) {
+            long seq = 0;
+            for (int i = 0; i < 1000; i++) {
+                TableWriter.Row r = w.newRow(i * 10_000_000L);
+                r.putLong(0, seq++);
+                r.append();
+            }
+            w.commit();
+
+            // O3 rows do not collide with the rows above, but often collide with each other,
+            // they span several partitions and are sorted in parallel on commit
+            for (int i = 0; i < 200_000; i++) {
+                TableWriter.Row r = w.newRow(rnd.nextInt(50_000) * 10_000_000L + 1 + rnd.nextInt(3));
+                r.putLong(0, seq++);
+                r.append();
+            }
+            w.commit();
+        }
+
+        // the sort is stable, rows of the same timestamp keep the order they were inserted in
+        TestUtils.assertEquals(
+                compiler,
+                sqlExecutionContext,
+                "select * from x order by ts, seq",
+                "x"
+        );
+        TestUtils.assertEquals(
+                compiler,
+                sqlExecutionContext,
+                "select count() from long_sequence(201000)",
+                "select count() from x"
+        );
+    }
+
     private static void testOOOTouchesNotLastPartition0(
             CairoEngine engine,
             SqlCompiler compiler,
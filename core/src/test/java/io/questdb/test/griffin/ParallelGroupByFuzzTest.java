@@ -949,6 +949,85 @@ public class ParallelGroupByFuzzTest extends AbstractCairoTest {
         );
     }
 
+    @Test
+    public void testParallelNonKeyedGroupByBatchAllNulls() throws Exception {
+        // all selected rows are null, but page frames have no column tops, so they are aggregated in batches
+        testParallelNonKeyedGroupByBatch(
+                "SELECT count(i) ci, sum(i) si, min(i) mi, max(i) xi," +
+                        " count(l) cl, sum(l) sl, min(l) ml, max(l) xl," +
+                        " count(d) cd, sum(d) sd, avg(d) ad, min(d) md, max(d) xd" +
+                        " FROM tab WHERE k > 4000",
+                "ci\tsi\tmi\txi\tcl\tsl\tml\txl\tcd\tsd\tad\tmd\txd\n" +
+                        "0\tNaN\tNaN\tNaN\t0\tNaN\tNaN\tNaN\t0\tNaN\tNaN\tNaN\tNaN\n"
+        );
+    }
+
+    @Test
+    public void testParallelNonKeyedGroupByBatchFunctions() throws Exception {
+        // Page frames of the first partitions have column tops and are aggregated row by row,
+        // the rest are aggregated in batches. Adding zero makes the function args expressions,
+        // so that the second query is aggregated row by row and must give the same result.
+        final String expected = "ci\tsi\tmi\txi\tcl\tsl\tml\txl\tcd\tsd\tad\tmd\txd\n" +
+                "942\t47100\t-499\t599\t880\t924000000000000\t501000000000\t1599000000000\t732\t9150.0\t12.5\t-124.5\t149.5\n";
+        testParallelNonKeyedGroupByBatch(
+                "SELECT count(i) ci, sum(i) si, min(i) mi, max(i) xi," +
+                        " count(l) cl, sum(l) sl, min(l) ml, max(l) xl," +
+                        " count(d) cd, sum(d) sd, avg(d) ad, min(d) md, max(d) xd" +
+                        " FROM tab WHERE k < 1000 OR (k > 2500 AND k < 3600)",
+                expected,
+                "SELECT count(i + 0) ci, sum(i + 0) si, min(i + 0) mi, max(i + 0) xi," +
+                        " count(l + 0) cl, sum(l + 0) sl, min(l + 0) ml, max(l + 0) xl," +
+                        " count(d + 0) cd, sum(d + 0) sd, avg(d + 0) ad, min(d + 0) md, max(d + 0) xd" +
+                        " FROM tab WHERE k < 1000 OR (k > 2500 AND k < 3600)",
+                expected
+        );
+    }
+
+    @Test
+    public void testParallelNonKeyedGroupByBatchSingleFunction() throws Exception {
+        testParallelNonKeyedGroupByBatch(
+                "SELECT count(i) FROM tab WHERE k > 2500 AND k < 3600",
+                "count\n" +
+                        "942\n",
+                "SELECT sum(i) FROM tab WHERE k > 2500 AND k < 3600",
+                "sum\n" +
+                        "47100\n",
+                "SELECT min(i) FROM tab WHERE k > 2500 AND k < 3600",
+                "min\n" +
+                        "-499\n",
+                "SELECT max(i) FROM tab WHERE k > 2500 AND k < 3600",
+                "max\n" +
+                        "599\n",
+                "SELECT count(l) FROM tab WHERE k > 2500 AND k < 3600",
+                "count\n" +
+                        "880\n",
+                "SELECT sum(l) FROM tab WHERE k > 2500 AND k < 3600",
+                "sum\n" +
+                        "924000000000000\n",
+                "SELECT min(l) FROM tab WHERE k > 2500 AND k < 3600",
+                "min\n" +
+                        "501000000000\n",
+                "SELECT max(l) FROM tab WHERE k > 2500 AND k < 3600",
+                "max\n" +
+                        "1599000000000\n",
+                "SELECT count(d) FROM tab WHERE k > 2500 AND k < 3600",
+                "count\n" +
+                        "732\n",
+                "SELECT sum(d) FROM tab WHERE k > 2500 AND k < 3600",
+                "sum\n" +
+                        "9150.0\n",
+                "SELECT avg(d) FROM tab WHERE k > 2500 AND k < 3600",
+                "avg\n" +
+                        "12.5\n",
+                "SELECT min(d) FROM tab WHERE k > 2500 AND k < 3600",
+                "min\n" +
+                        "-124.5\n",
+                "SELECT max(d) FROM tab WHERE k > 2500 AND k < 3600",
+                "max\n" +
+                        "149.5\n"
+        );
+    }
+
     @Test
     public void testParallelNonKeyedGroupByConcurrent() throws Exception {
         // This query doesn't use filter, so we don't care about JIT.
@@ -2355,6 +2434,47 @@ public class ParallelGroupByFuzzTest extends AbstractCairoTest {
         });
     }
 
+    // k goes from 1 to 5000, i, l and d have column tops up to k = 2000 and are null for k > 4000
+    private void testParallelNonKeyedGroupByBatch(String... queriesAndExpectedResults) throws Exception {
+        assertMemoryLeak(() -> {
+            final WorkerPool pool = new WorkerPool((() -> 4));
+            TestUtils.execute(
+                    pool,
+                    (engine, compiler, sqlExecutionContext) -> {
+                        sqlExecutionContext.setJitMode(enableJitCompiler ? SqlJitMode.JIT_MODE_ENABLED : SqlJitMode.JIT_MODE_DISABLED);
+
+                        ddl(
+                                compiler,
+                                "CREATE TABLE tab AS (SELECT x k, timestamp_sequence(0, 100000000) ts FROM long_sequence(2000))" +
+                                        " TIMESTAMP(ts) PARTITION BY DAY",
+                                sqlExecutionContext
+                        );
+                        ddl(compiler, "ALTER TABLE tab ADD COLUMN i INT", sqlExecutionContext);
+                        ddl(compiler, "ALTER TABLE tab ADD COLUMN l LONG", sqlExecutionContext);
+                        ddl(compiler, "ALTER TABLE tab ADD COLUMN d DOUBLE", sqlExecutionContext);
+                        insert(
+                                compiler,
+                                "INSERT INTO tab SELECT 2000 + x, ((1999 + x) * 100000000)::timestamp," +
+                                        " CASE WHEN x % 7 = 0 THEN NULL ELSE cast(x - 1000 AS INT) END," +
+                                        " CASE WHEN x % 5 = 0 THEN NULL ELSE x * 1000000000 END," +
+                                        " CASE WHEN x % 3 = 0 THEN NULL ELSE (x - 1000) / 4.0 END" +
+                                        " FROM long_sequence(2000)",
+                                sqlExecutionContext
+                        );
+                        insert(
+                                compiler,
+                                "INSERT INTO tab SELECT 4000 + x, ((3999 + x) * 100000000)::timestamp, NULL, NULL, NULL" +
+                                        " FROM long_sequence(1000)",
+                                sqlExecutionContext
+                        );
+                        assertQueries(engine, sqlExecutionContext, queriesAndExpectedResults);
+                    },
+                    configuration,
+                    LOG
+            );
+        });
+    }
+
     private void testParallelStringKeyGroupBy(String... queriesAndExpectedResults) throws Exception {
         assertMemoryLeak(() -> {
             final WorkerPool pool = new WorkerPool((() -> 4));
@@ -0,0 +1,382 @@
+/*******************************************************************************
+ *     ___                  _   ____  ____
+ *    / _ \ _   _  ___  ___| |_|  _ \| __ )
+ *   | | | | | | |/ _ \/ __| __| | | |  _ \
+ *   | |_| | |_| |  __/\__ \ |_| |_| | |_) |
+ *    \__\_\\__,_|\___||___/\__|____/|____/
+ *
+ *  Copyright (c) 2014-2019 Appsicle
+ *  Copyright (c) 2019-2023 QuestDB
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ******************************************************************************/
+
+package io.questdb.test.griffin;
+
+import io.questdb.PropertyKey;
+import io.questdb.cairo.SqlJitMode;
+import io.questdb.cairo.sql.RecordCursorFactory;
+import io.questdb.cairo.sql.async.PageFrameSequence;
+import io.questdb.griffin.SqlException;
+import io.questdb.griffin.engine.table.AsyncFilteredRecordCursorFactory;
+import io.questdb.griffin.engine.table.AsyncJitFilteredRecordCursorFactory;
+import io.questdb.mp.SCSequence;
+import io.questdb.std.Files;
+import io.questdb.std.FilesFacade;
+import io.questdb.std.Misc;
+import io.questdb.std.str.LPSZ;
+import io.questdb.std.str.Utf8s;
+import io.questdb.test.AbstractCairoTest;
+import io.questdb.test.std.TestFilesFacadeImpl;
+import org.junit.Assert;
+import org.junit.Before;
+import org.junit.Test;
+import org.junit.runner.RunWith;
+import org.junit.runners.Parameterized;
+
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import static io.questdb.cairo.sql.DataFrameCursorFactory.ORDER_ANY;
+
+/**
+ * Filters that skip page frames by zone maps. Blocks and page frames are both 64 rows and a DAY
+ * partition holds 240 rows, so each full partition has 3 summarised frames and a 48-row tail frame
+ * that is never skipped. Expected results come from the same filter over "column + 0", which zone
+ * maps cannot answer.
+ */
+@RunWith(Parameterized.class)
+public class ZoneMapTest extends AbstractCairoTest {
+    private static final int BLOCK_ROWS = 64;
+    // 1000 rows make 4 full partitions and a 40-row last partition, i.e. 17 frames and 12 summarised ones
+    private static final String CREATE_TABLE = "create table x as (" +
+            "select" +
+            " case when x % 7 = 0 then null else cast(x as int) end i," +
+            " case when x % 5 = 0 then null else x * 10 end l," +
+            " case when x % 3 = 0 then null else cast(x * 1000 as timestamp) end t," +
+            " case when x % 11 = 0 then null else x / 4.0 end d," +
+            " case when x <= 480 then null else cast(x as int) end n," +
+            " timestamp_sequence(0, 360000000) ts" +
+            " from long_sequence(%d)" +
+            ") timestamp(ts) partition by DAY";
+    private final boolean enableJitCompiler;
+
+    public ZoneMapTest(boolean enableJitCompiler) {
+        this.enableJitCompiler = enableJitCompiler;
+    }
+
+    @Parameterized.Parameters(name = "JIT={0}")
+    public static Collection<Object[]> data() {
+        return Arrays.asList(new Object[][]{
+                {true},
+                {false},
+        });
+    }
+
+    @Override
+    @Before
+    public void setUp() {
+        setProperty(PropertyKey.CAIRO_ZONE_MAP_BLOCK_ROWS, BLOCK_ROWS);
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MIN_ROWS, BLOCK_ROWS);
+        setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, BLOCK_ROWS);
+        super.setUp();
+        node1.setProperty(PropertyKey.CAIRO_SQL_PARALLEL_FILTER_ENABLED, true);
+        node1.setProperty(
+                PropertyKey.CAIRO_SQL_JIT_MODE,
+                SqlJitMode.toString(enableJitCompiler ? SqlJitMode.JIT_MODE_ENABLED : SqlJitMode.JIT_MODE_DISABLED)
+        );
+    }
+
+    @Test
+    public void testColumnTops() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            ddl("alter table x add column j long");
+            // the last partition gets a column top of 40 rows, earlier partitions have no j values at all
+            insert("insert into x select" +
+                    " cast(x + 1000 as int)," +
+                    " (x + 1000) * 10," +
+                    " cast((x + 1000) * 1000 as timestamp)," +
+                    " (x + 1000) / 4.0," +
+                    " cast(x + 1000 as int)," +
+                    " timestamp_sequence(360000000000, 360000000)," +
+                    " case when x % 13 = 0 then null else x end" +
+                    " from long_sequence(1000)");
+
+            assertFilter("j", "=", "100", -1);
+            assertFilter("j", "<", "50", -1);
+            assertFilter("j", "<=", "64", -1);
+            assertFilter("j", ">", "900", -1);
+            assertFilter("j", ">=", "700", -1);
+            assertFilter("i", "=", "1500", -1);
+            assertFilter("i", "<", "100", -1);
+        });
+    }
+
+    @Test
+    public void testDouble() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            assertFilter("d", "=", "25.0", 6);
+            assertFilter("d", "<", "12.5", 6);
+            assertFilter("d", "<=", "16.0", 6);
+            assertFilter("d", ">", "225.0", 6);
+            assertFilter("d", ">=", "175.0", 8);
+            // long constant compared with double values
+            assertFilter("d", "=", "25", 6);
+        });
+    }
+
+    @Test
+    public void testFailedUpdateRemovesZoneMap() throws Exception {
+        node1.setProperty(PropertyKey.CAIRO_O3_PARTITION_SPLIT_MIN_SIZE, 100);
+        final AtomicBoolean failZoneMapOpen = new AtomicBoolean();
+        final AtomicInteger failedOpens = new AtomicInteger();
+        final FilesFacade ff = new TestFilesFacadeImpl() {
+            @Override
+            public int openRW(LPSZ name, long opts) {
+                // zone map of the last partition, as opposed to the maps of split parts under names with txn suffix
+                if (failZoneMapOpen.get() && Utf8s.containsAscii(name, Files.SEPARATOR + "1970-01-05" + Files.SEPARATOR + "i.zm")) {
+                    failedOpens.incrementAndGet();
+                    return -1;
+                }
+                return super.openRW(name, opts);
+            }
+        };
+        assertMemoryLeak(ff, () -> {
+            // the last partition has 200 rows, i.e. 3 summarised blocks
+            ddl(String.format(CREATE_TABLE, 1160));
+            assertFilter("i", ">=", "5000", -1);
+
+            // splits the partition and leaves 2 blocks in the prefix, the commit cannot cut the map down
+            failZoneMapOpen.set(true);
+            insert("insert into x select" +
+                    " cast(x + 5000 as int)," +
+                    " (x + 5000) * 10," +
+                    " cast((x + 5000) * 1000 as timestamp)," +
+                    " (x + 5000) / 4.0," +
+                    " cast(x + 5000 as int)," +
+                    " timestamp_sequence((960 + 190) * 360000000L + 1000000, 1000000)" +
+                    " from long_sequence(5)");
+            failZoneMapOpen.set(false);
+            Assert.assertTrue(failedOpens.get() > 0);
+            assertFilter("i", ">=", "5000", -1);
+
+            // squashes split parts back, the third block of the prefix holds new rows now and
+            // must not be answered by the entry of the failed update
+            insert("insert into x select" +
+                    " cast(x + 2000 as int)," +
+                    " (x + 2000) * 10," +
+                    " cast((x + 2000) * 1000 as timestamp)," +
+                    " (x + 2000) / 4.0," +
+                    " cast(x + 2000 as int)," +
+                    " timestamp_sequence(1200 * 360000000L, 360000000)" +
+                    " from long_sequence(300)");
+
+            assertFilter("i", ">=", "5000", -1);
+            assertFilter("i", "=", "1155", -1);
+            assertFilter("i", ">", "2200", -1);
+        });
+    }
+
+    @Test
+    public void testInt() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            assertFilter("i", "=", "100", 6);
+            assertFilter("i", "<", "50", 6);
+            assertFilter("i", "<=", "64", 6);
+            assertFilter("i", ">", "900", 6);
+            assertFilter("i", ">=", "700", 8);
+        });
+    }
+
+    @Test
+    public void testLong() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            assertFilter("l", "=", "3010", 6);
+            assertFilter("l", "<", "1500", 8);
+            assertFilter("l", "<=", "640", 6);
+            assertFilter("l", ">", "9000", 6);
+            assertFilter("l", ">=", "7000", 8);
+        });
+    }
+
+    @Test
+    public void testNullBlocks() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            // n is null in the first two partitions, their summarised frames never match
+            assertFilter("n", ">", "0", 11);
+            assertFilter("n", "<", "0", 5);
+            assertFilter("n", "=", "100", 5);
+            assertFilter("n", "<=", "500", 6);
+            assertFilter("n", ">=", "-1", 11);
+        });
+    }
+
+    @Test
+    public void testO3Merge() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            assertFilter("i", ">=", "5000", 5);
+
+            // rewrites the second partition, its blocks must be summarised again to find the new values
+            insert("insert into x select" +
+                    " cast(x + 5000 as int)," +
+                    " (x + 5000) * 10," +
+                    " cast((x + 5000) * 1000 as timestamp)," +
+                    " (x + 5000) / 4.0," +
+                    " cast(x + 5000 as int)," +
+                    " timestamp_sequence(86400000000 + 1000000, 7200000000)" +
+                    " from long_sequence(10)");
+
+            assertFilter("i", "=", "5003", -1);
+            assertFilter("i", ">=", "5000", -1);
+            assertFilter("l", ">", "50000", -1);
+            assertFilter("t", ">=", "5000000", -1);
+            assertFilter("d", ">", "1250.0", -1);
+            assertFilter("i", "<", "100", -1);
+        });
+    }
+
+    @Test
+    public void testO3MergeDoesNotReadColumnBack() throws Exception {
+        final AtomicInteger mergedColumnReads = new AtomicInteger();
+        final FilesFacade ff = new TestFilesFacadeImpl() {
+            @Override
+            public int openRO(LPSZ name) {
+                // the merge writes the second partition anew, under a name with txn suffix
+                if (Utf8s.containsAscii(name, "1970-01-02.") && Utf8s.endsWithAscii(name, Files.SEPARATOR + "i.d")) {
+                    mergedColumnReads.incrementAndGet();
+                }
+                return super.openRO(name);
+            }
+        };
+        assertMemoryLeak(ff, () -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            final int readsBeforeMerge = mergedColumnReads.get();
+
+            insert("insert into x select" +
+                    " cast(x + 5000 as int)," +
+                    " (x + 5000) * 10," +
+                    " cast((x + 5000) * 1000 as timestamp)," +
+                    " (x + 5000) / 4.0," +
+                    " cast(x + 5000 as int)," +
+                    " timestamp_sequence(86400000000 + 1000000, 7200000000)" +
+                    " from long_sequence(10)");
+
+            // the copy job summarised the merged column while it was mapped
+            Assert.assertEquals(readsBeforeMerge, mergedColumnReads.get());
+            assertFilter("i", ">=", "5000", -1);
+        });
+    }
+
+    @Test
+    public void testPartitionSplit() throws Exception {
+        node1.setProperty(PropertyKey.CAIRO_O3_PARTITION_SPLIT_MIN_SIZE, 100);
+        assertMemoryLeak(() -> {
+            // the last partition has 200 rows, i.e. 3 summarised blocks
+            ddl(String.format(CREATE_TABLE, 1160));
+            assertFilter("i", ">=", "5000", -1);
+
+            // lands after the 191st row of the last partition, which splits the partition and
+            // leaves 2 summarised blocks in the prefix, the zone map must not keep the third one
+            insert("insert into x select" +
+                    " cast(x + 5000 as int)," +
+                    " (x + 5000) * 10," +
+                    " cast((x + 5000) * 1000 as timestamp)," +
+                    " (x + 5000) / 4.0," +
+                    " cast(x + 5000 as int)," +
+                    " timestamp_sequence((960 + 190) * 360000000L + 1000000, 1000000)" +
+                    " from long_sequence(5)");
+
+            assertFilter("i", ">=", "5000", -1);
+            assertFilter("i", ">", "1100", -1);
+            assertFilter("l", "<", "11000", -1);
+            assertFilter("t", "<=", "1150000", -1);
+            assertFilter("d", ">", "280.0", -1);
+
+            // next partition, split parts of the previous one can be squashed back
+            insert("insert into x select" +
+                    " cast(x + 2000 as int)," +
+                    " (x + 2000) * 10," +
+                    " cast((x + 2000) * 1000 as timestamp)," +
+                    " (x + 2000) / 4.0," +
+                    " cast(x + 2000 as int)," +
+                    " timestamp_sequence(1200 * 360000000L, 360000000)" +
+                    " from long_sequence(300)");
+
+            assertFilter("i", ">=", "5000", -1);
+            assertFilter("i", "=", "1155", -1);
+            assertFilter("i", ">", "2200", -1);
+            assertFilter("n", "<", "1000", -1);
+        });
+    }
+
+    @Test
+    public void testTimestamp() throws Exception {
+        assertMemoryLeak(() -> {
+            ddl(String.format(CREATE_TABLE, 1000));
+            assertFilter("t", "=", "200000", 5);
+            assertFilter("t", "<", "50000", 6);
+            assertFilter("t", "<=", "64000", 6);
+            assertFilter("t", ">", "900000", 6);
+            assertFilter("t", ">=", "700000", 8);
+        });
+    }
+
+    private static void assertFilter(String column, String op, String constant, int expectedFrameCount) throws SqlException {
+        final String sql = "select * from x where " + column + ' ' + op + ' ' + constant;
+        final String referenceSql = "select * from x where " + column + " + 0 " + op + ' ' + constant;
+        assertSqlCursors(referenceSql, sql);
+        final int frameCount = countFrames(sql);
+        final int referenceFrameCount = countFrames(referenceSql);
+        if (expectedFrameCount > -1) {
+            Assert.assertEquals(sql, expectedFrameCount, frameCount);
+        }
+        Assert.assertTrue(sql + ", frames: " + frameCount + ", all frames: " + referenceFrameCount, frameCount < referenceFrameCount);
+    }
+
+    private static int countFrames(String sql) throws SqlException {
+        try (RecordCursorFactory factory = select(sql)) {
+            final RecordCursorFactory base = factory.getBaseFactory();
+            Assert.assertTrue(
+                    sql,
+                    base instanceof AsyncFilteredRecordCursorFactory || base instanceof AsyncJitFilteredRecordCursorFactory
+            );
+            final PageFrameSequence<?> frameSequence = base.execute(sqlExecutionContext, new SCSequence(), ORDER_ANY);
+            try {
+                frameSequence.prepareForDispatch();
+                final int frameCount = frameSequence.getFrameCount();
+                int collected = 0;
+                while (collected < frameCount) {
+                    final long cursor = frameSequence.next();
+                    if (cursor > -1) {
+                        frameSequence.collect(cursor, false);
+                        collected++;
+                    }
+                }
+                frameSequence.await();
+                return frameCount;
+            } finally {
+                Misc.freeIfCloseable(frameSequence.getSymbolTableSource());
+                frameSequence.clear();
+            }
+        }
+    }
+}
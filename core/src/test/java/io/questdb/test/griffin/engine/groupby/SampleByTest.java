@@ -3698,6 +3698,98 @@ public class SampleByTest extends AbstractCairoTest {
         );
     }
 
+    @Test
+    public void testSampleByVectorizedColumnTop() throws Exception {
+        node1.setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 100);
+        assertMemoryLeak(() -> {
+            compile("create table x as (" +
+                    "select x * 3 l, timestamp_sequence('2024-01-01', 7 * 60 * 1000000L + 13) ts " +
+                    "from long_sequence(1000)) timestamp(ts) partition by hour");
+            compile("alter table x add column i int");
+            compile("alter table x add column d double");
+            compile("insert into x select x * 3 l, timestamp_sequence('2024-01-06', 7 * 60 * 1000000L + 13) ts, " +
+                    "case when x % 7 = 0 then null else (x % 1000)::int end i, " +
+                    "case when x % 5 = 0 then null else (x % 100) / 4.0 end d " +
+                    "from long_sequence(1000)");
+
+            final String query = "select ts, count(), count(i), sum(i), min(i), max(i), count(d), sum(d), avg(d), min(d), max(d) from x ";
+            assertSqlCursors(
+                    query + "sample by 3h align to calendar time zone 'UTC'",
+                    query + "sample by 3h align to calendar"
+            );
+            assertSqlCursors(
+                    query + "where l > 0 or l = null sample by 30m",
+                    query + "sample by 30m"
+            );
+        });
+    }
+
+    @Test
+    public void testSampleByVectorizedMatchesRowByRow() throws Exception {
+        node1.setProperty(PropertyKey.CAIRO_SQL_PAGE_FRAME_MAX_ROWS, 100);
+        assertMemoryLeak(() -> {
+            compile("create table x as (" +
+                    "select case when x % 5 = 0 then null else (x % 100) / 4.0 end d, " +
+                    "case when x % 7 = 0 then null else (x % 1000)::int end i, " +
+                    "case when x % 11 = 0 then null else x * 3 end l, " +
+                    "timestamp_sequence('2024-01-01', 7 * 60 * 1000000L + 13) ts " +
+                    "from long_sequence(5000)) timestamp(ts) partition by hour");
+
+            final String query = "select ts, count(), count(d), sum(d), avg(d), min(d), max(d), " +
+                    "count(i), sum(i), min(i), max(i), count(l), sum(l), min(l), max(l) from x ";
+            // buckets within page frames, straddling frames and partitions, more buckets than a kernel call takes
+            final String[] strides = {"10m", "1h", "5h", "1d", "1s"};
+            for (String stride : strides) {
+                assertSqlCursors(
+                        query + "sample by " + stride + " align to calendar time zone 'UTC'",
+                        query + "sample by " + stride + " align to calendar"
+                );
+                assertSqlCursors(
+                        query + "sample by " + stride + " align to calendar time zone 'UTC' with offset '00:10'",
+                        query + "sample by " + stride + " align to calendar with offset '00:10'"
+                );
+                // filtered row-by-row sample by aligned to the first observation
+                assertSqlCursors(
+                        query + "where l > 0 or l = null sample by " + stride,
+                        query + "sample by " + stride
+                );
+            }
+        });
+    }
+
+    @Test
+    public void testSampleByVectorizedPlan() throws Exception {
+        assertMemoryLeak(() -> {
+            compile("create table x (d double, i int, s symbol, ts timestamp) timestamp(ts) partition by day");
+
+            assertPlan(
+                    "select ts, count(), sum(d), max(i) from x sample by 1h align to calendar with offset '00:30'",
+                    "SampleBy vectorized: true\n" +
+                            "  values: [count(*),sum(d),max(i)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: x\n"
+            );
+            // time zones and functions without bucket stats stay row-by-row
+            assertPlan(
+                    "select ts, count(), sum(d) from x sample by 1h align to calendar time zone 'Europe/London'",
+                    "SampleBy\n" +
+                            "  values: [count(*),sum(d)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: x\n"
+            );
+            assertPlan(
+                    "select ts, count(), first(s) from x sample by 1h",
+                    "SampleBy\n" +
+                            "  values: [count(*),first(s)]\n" +
+                            "    DataFrame\n" +
+                            "        Row forward scan\n" +
+                            "        Frame forward scan on: x\n"
+            );
+        });
+    }
+
     @Test
     public void testSampleByWithEmptyCursor() throws Exception {
         assertQuery("to_timezone\ts\tlat\tlon\n",
@@ -34,6 +34,9 @@ import org.junit.Assert;
 import org.junit.Before;
 import org.junit.Test;
 
+import java.util.Arrays;
+import java.util.Comparator;
+
 import static io.questdb.cairo.AbstractIntervalDataFrameCursor.SCAN_UP;
 import static io.questdb.cairo.BinarySearch.SCAN_DOWN;
 
@@ -142,6 +145,76 @@ public class VectTest {
         }
     }
 
+    @Test
+    public void testAggregateNarrowTypesWithNulls() {
+        // lengths that are not a multiple of the vector width leave a scalar tail
+        final int nMax = 300;
+        final long pFloat = Unsafe.malloc((long) nMax * Float.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long pByte = Unsafe.malloc(nMax, MemoryTag.NATIVE_DEFAULT);
+        final long pChar = Unsafe.malloc((long) nMax * Character.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long pLong128 = Unsafe.malloc((long) nMax * 2 * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        try {
+            for (int nullPercent = 0; nullPercent <= 100; nullPercent += 50) {
+                for (int n = 0; n < nMax; n++) {
+                    long floatCount = 0;
+                    double floatSum = 0;
+                    float floatMin = Float.NaN;
+                    float floatMax = Float.NaN;
+                    long byteSum = 0;
+                    int byteMin = Numbers.INT_NaN;
+                    int byteMax = Numbers.INT_NaN;
+                    int charMin = 0;
+                    int charMax = 0;
+                    long long128Count = 0;
+                    for (int i = 0; i < n; i++) {
+                        final boolean isNull = rnd.nextInt(100) < nullPercent;
+                        final float f = isNull ? Float.NaN : (rnd.nextInt(2001) - 1000) / 4.0f;
+                        final byte b = rnd.nextByte();
+                        final char c = isNull ? 0 : (char) (1 + rnd.nextInt(60_000));
+                        // one null half is not a null UUID
+                        final long hi = isNull ? Numbers.LONG_NaN : rnd.nextLong();
+                        final long lo = isNull || rnd.nextInt(5) == 0 ? Numbers.LONG_NaN : rnd.nextLong();
+                        Unsafe.getUnsafe().putFloat(pFloat + (long) i * Float.BYTES, f);
+                        Unsafe.getUnsafe().putByte(pByte + i, b);
+                        Unsafe.getUnsafe().putChar(pChar + (long) i * Character.BYTES, c);
+                        Unsafe.getUnsafe().putLong(pLong128 + i * 2L * Long.BYTES, lo);
+                        Unsafe.getUnsafe().putLong(pLong128 + i * 2L * Long.BYTES + Long.BYTES, hi);
+
+                        if (!isNull) {
+                            floatCount++;
+                            floatSum += f;
+                            floatMin = floatCount == 1 ? f : Math.min(floatMin, f);
+                            floatMax = floatCount == 1 ? f : Math.max(floatMax, f);
+                            charMin = charMin == 0 ? c : Math.min(charMin, c);
+                            charMax = Math.max(charMax, c);
+                            long128Count++;
+                        }
+                        byteSum += b;
+                        byteMin = i == 0 ? b : Math.min(byteMin, b);
+                        byteMax = i == 0 ? b : Math.max(byteMax, b);
+                    }
+
+                    final String msg = "count: " + n + ", null %: " + nullPercent;
+                    Assert.assertEquals(msg, floatCount, Vect.countFloat(pFloat, n));
+                    Assert.assertEquals(msg, floatCount > 0 ? floatSum : Double.NaN, Vect.sumFloat(pFloat, n), 0.0);
+                    Assert.assertEquals(msg, floatMin, Vect.minFloat(pFloat, n), 0.0f);
+                    Assert.assertEquals(msg, floatMax, Vect.maxFloat(pFloat, n), 0.0f);
+                    Assert.assertEquals(msg, n > 0 ? byteSum : Numbers.LONG_NaN, Vect.sumByte(pByte, n));
+                    Assert.assertEquals(msg, byteMin, Vect.minByte(pByte, n));
+                    Assert.assertEquals(msg, byteMax, Vect.maxByte(pByte, n));
+                    Assert.assertEquals(msg, charMin, Vect.minChar(pChar, n));
+                    Assert.assertEquals(msg, charMax, Vect.maxChar(pChar, n));
+                    Assert.assertEquals(msg, long128Count, Vect.countLong128(pLong128, n));
+                }
+            }
+        } finally {
+            Unsafe.free(pFloat, (long) nMax * Float.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pByte, nMax, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pChar, (long) nMax * Character.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pLong128, (long) nMax * 2 * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
     @Test
     public void testBinarySearchIndexT() {
         int count = 1000;
@@ -399,6 +472,22 @@ public class VectTest {
         }
     }
 
+    @Test
+    public void testMergeCopyVarColumn() {
+        rnd = TestUtils.generateRandom(null);
+        for (int i = 0; i < 2; i++) {
+            final boolean bin = i == 1;
+            testMergeCopyVarColumn(bin, 0, 0, 10, 0);
+            testMergeCopyVarColumn(bin, 1, 0, 10, 0);
+            testMergeCopyVarColumn(bin, 0, 1, 10, 13);
+            // short runs of short values, empty and null values included
+            testMergeCopyVarColumn(bin, 1_000, 700, 3, 0);
+            testMergeCopyVarColumn(bin, 1_000, 700, 40, 13);
+            // large enough to be written with streaming stores
+            testMergeCopyVarColumn(bin, 60, 40, bin ? 2_000_000 : 1_000_000, 7);
+        }
+    }
+
     @Test
     public void testMergeDedupIndex() {
         int srcLen = 10;
@@ -674,6 +763,46 @@ public class VectTest {
         });
     }
 
+    @Test
+    public void testMergeManyPairwiseOverlapping() {
+        // chunks overlap in pairs with equal timestamps, the pairs are disjoint and listed in descending order
+        final int chunkCount = 300;
+        final int rowCount = 1000;
+        final long chunkSize = rowCount * 2L * Long.BYTES;
+        final long chunks = Unsafe.malloc(chunkCount * chunkSize, MemoryTag.NATIVE_DEFAULT);
+        final long struct = Unsafe.malloc(chunkCount * 2L * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long targetSize = chunkCount * chunkSize;
+        final long targetAddr = Unsafe.malloc(targetSize, MemoryTag.NATIVE_DEFAULT);
+        try {
+            for (int c = 0; c < chunkCount; c++) {
+                final long chunk = chunks + c * chunkSize;
+                final long pair = (chunkCount - 1 - c) / 2;
+                for (int i = 0; i < rowCount; i++) {
+                    Unsafe.getUnsafe().putLong(chunk + i * 2L * Long.BYTES, pair * rowCount + i);
+                    Unsafe.getUnsafe().putLong(chunk + i * 2L * Long.BYTES + Long.BYTES, (long) c * rowCount + i);
+                }
+                Unsafe.getUnsafe().putLong(struct + c * 2L * Long.BYTES, chunk);
+                Unsafe.getUnsafe().putLong(struct + c * 2L * Long.BYTES + Long.BYTES, rowCount);
+            }
+
+            Vect.mergeLongIndexesAsc(struct, chunkCount, targetAddr);
+
+            // equal timestamps keep the order of the chunks
+            for (int i = 0; i < chunkCount * rowCount; i++) {
+                final long ts = Unsafe.getUnsafe().getLong(targetAddr + i * 2L * Long.BYTES);
+                final long id = Unsafe.getUnsafe().getLong(targetAddr + i * 2L * Long.BYTES + Long.BYTES);
+                final long pair = ts / rowCount;
+                final long c = chunkCount - 2 - 2 * pair + (i & 1);
+                Assert.assertEquals(i / 2, ts);
+                Assert.assertEquals(c * rowCount + ts % rowCount, id);
+            }
+        } finally {
+            Unsafe.free(chunks, chunkCount * chunkSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(struct, chunkCount * 2L * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(targetAddr, targetSize, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
     @Test
     public void testMergeOne() {
         long indexPtr = seedAndSort(150);
@@ -684,6 +813,74 @@ public class VectTest {
         }
     }
 
+    @Test
+    public void testMergeShuffleFixedColumns() {
+        rnd = TestUtils.generateRandom(null);
+        // the rows span several tiles of the index, the last tile is partial
+        final int count = 5_000;
+        final int srcCount = 3_000;
+        final int lo = 100;
+        final int hi = count - 7;
+        // value sizes of 1 to 32 bytes
+        final int columnCount = 6;
+        final long indexSize = count * 2L * Long.BYTES;
+        final long columnsSize = (long) columnCount * Vect.MERGE_SHUFFLE_COLUMN_LONGS * Long.BYTES;
+        final long index = Unsafe.malloc(indexSize, MemoryTag.NATIVE_DEFAULT);
+        final long columns = Unsafe.malloc(columnsSize, MemoryTag.NATIVE_DEFAULT);
+        final long[] src1 = new long[columnCount];
+        final long[] src2 = new long[columnCount];
+        final long[] dest = new long[columnCount];
+        final long[] expected = new long[columnCount];
+        try {
+            seedMergeIndex(count, srcCount, index);
+            for (int c = 0; c < columnCount; c++) {
+                src1[c] = seedMemLongs((long) srcCount << c);
+                src2[c] = seedMemLongs((long) srcCount << c);
+                dest[c] = Unsafe.calloc((long) count << c, MemoryTag.NATIVE_DEFAULT);
+                expected[c] = Unsafe.calloc((long) count << c, MemoryTag.NATIVE_DEFAULT);
+                final long column = columns + (long) c * Vect.MERGE_SHUFFLE_COLUMN_LONGS * Long.BYTES;
+                Unsafe.getUnsafe().putLong(column, src1[c]);
+                Unsafe.getUnsafe().putLong(column + Long.BYTES, src2[c]);
+                Unsafe.getUnsafe().putLong(column + 2 * Long.BYTES, dest[c]);
+                Unsafe.getUnsafe().putLong(column + 3 * Long.BYTES, c);
+            }
+
+            Vect.mergeShuffleFixedColumns(columns, columnCount, index, lo, hi);
+
+            for (int c = 0; c < columnCount; c++) {
+                mergeShuffle(c, src1[c], src2[c], expected[c] + ((long) lo << c), index + lo * 2L * Long.BYTES, hi - lo);
+                assertEqualLongs(expected[c], dest[c], (count << c) / Long.BYTES);
+            }
+        } finally {
+            Unsafe.free(index, indexSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(columns, columnsSize, MemoryTag.NATIVE_DEFAULT);
+            for (int c = 0; c < columnCount; c++) {
+                Unsafe.free(src1[c], (long) srcCount << c, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(src2[c], (long) srcCount << c, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(dest[c], (long) count << c, MemoryTag.NATIVE_DEFAULT);
+                Unsafe.free(expected[c], (long) count << c, MemoryTag.NATIVE_DEFAULT);
+            }
+        }
+    }
+
+    @Test
+    public void testMergeShuffleNarrowTypes() {
+        rnd = TestUtils.generateRandom(null);
+        for (int shl = 0; shl < 3; shl++) {
+            // vector blocks with all tail lengths
+            for (int count = 0; count < 70; count++) {
+                testMergeShuffle(shl, count, 0, 0);
+                testMergeShuffle(shl, count, 0, 1);
+            }
+            testMergeShuffle(shl, 100_000, 0, 0);
+            testMergeShuffle(shl, 100_003, 0, 3);
+            if (shl > 0) {
+                // values misaligned to their size are not gathered
+                testMergeShuffle(shl, 1_000, 1, 0);
+            }
+        }
+    }
+
     @Test
     public void testMergeThreeDifferentSizes() {
         final int count1 = 1_000_000;
@@ -812,6 +1009,69 @@ public class VectTest {
         testQuickSort(1_000_000);
     }
 
+    @Test
+    public void testRadixSortDigitPlans() {
+        rnd = TestUtils.generateRandom(null);
+        // 8-bit digits, even and odd number of passes
+        testRadixSort(1_000, 0, 0xFFFFL);
+        testRadixSort(1_000, 0, 0xFFFFFFL);
+        // 11-bit digits
+        testRadixSort(1 << 15, 0, (1L << 22) - 1);
+        testRadixSort(1 << 15, 0, (1L << 33) - 1);
+        // 16-bit digits
+        testRadixSort(1 << 20, 0, 0xFFFFL);
+        testRadixSort(1 << 20, 0, 0xFFFFFFFFL);
+        // digits that are the same in all keys are skipped
+        testRadixSort(1_000, 0, 0xFF00FF00FFL);
+        testRadixSort(1 << 15, 0, 0x7FF00000007FFL);
+        // keys are rebased to the minimum
+        testRadixSort(1_000, 1L << 50, 0xFFFL);
+        testRadixSort(1 << 15, (1L << 50) + 12345, 0xFF00FF00FFL);
+        // all keys are equal, nothing to shuffle
+        testRadixSort(1_000, 12345, 0);
+    }
+
+    @Test
+    public void testRadixSortParallel() {
+        rnd = TestUtils.generateRandom(null);
+        testRadixSortParallel(0, 100_000, -1L, 7);
+        testRadixSortParallel(30_000, 70_000, -1L, 7);
+        testRadixSortParallel(30_000, 70_000, 0xFFFFFL, 64);
+        // fewer distinct keys than buckets
+        testRadixSortParallel(999, 1_001, 0x7FL, 3);
+        // all keys in one bucket
+        testRadixSortParallel(500, 500, 0, 5);
+        // more chunks than rows
+        testRadixSortParallel(3, 2, -1L, 8);
+    }
+
+    @Test
+    public void testRadixSortParallelOneOutlier() {
+        rnd = TestUtils.generateRandom(null);
+        final int count = 100_000;
+        final long size = count * 2L * Long.BYTES;
+        final long bAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        final long cpyAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        final long expectedAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        final long actualAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        try {
+            // timestamps of a few minutes and one far in the future stretch the key range
+            seedRadixKeys(count, bAddr, 1_700_000_000_000_000L, 0xFFFFFFFL);
+            Unsafe.getUnsafe().putLong(bAddr + (count / 2) * 2L * Long.BYTES, Long.MAX_VALUE);
+
+            Vect.radixSortABLongIndexAsc(0, 0, bAddr, count, expectedAddr, cpyAddr);
+            final long maxBucketSize = radixSortParallel(0, 0, bAddr, count, actualAddr, cpyAddr, 4);
+            assertEqualLongs(expectedAddr, actualAddr, count * 2);
+            // buckets stay close to the even share of rows instead of taking all but the outlier
+            Assert.assertTrue(maxBucketSize <= 4L * count / Vect.RADIX_SORT_PARALLEL_BUCKETS);
+        } finally {
+            Unsafe.free(bAddr, size, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(cpyAddr, size, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(expectedAddr, size, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(actualAddr, size, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
     @Test
     public void testReshuffleInt64() {
         int[] sizes = new int[]{0, 1, 3, 4, 5, 1024 * 1024 + 2};
@@ -1028,11 +1288,224 @@ public class VectTest {
         }
     }
 
+    @Test
+    public void testSortVarColumnInRanges() {
+        final int count = 10_000;
+        final int rangeRows = 999;
+        final long indexSize = count * 2L * Long.BYTES;
+        final long fixSize = (count + 1L) * Long.BYTES;
+        final long index = Unsafe.malloc(indexSize, MemoryTag.NATIVE_DEFAULT);
+        final long srcFix = Unsafe.malloc(fixSize, MemoryTag.NATIVE_DEFAULT);
+        final long tgtFix1 = Unsafe.malloc(fixSize, MemoryTag.NATIVE_DEFAULT);
+        final long tgtFix2 = Unsafe.malloc(fixSize, MemoryTag.NATIVE_DEFAULT);
+        long varSize = 0;
+        for (int i = 0; i < count; i++) {
+            Unsafe.getUnsafe().putLong(srcFix + i * Long.BYTES, varSize);
+            varSize += i % 7;
+        }
+        Unsafe.getUnsafe().putLong(srcFix + count * Long.BYTES, varSize);
+        final long srcVar = Unsafe.malloc(varSize, MemoryTag.NATIVE_DEFAULT);
+        final long tgtVar1 = Unsafe.malloc(varSize, MemoryTag.NATIVE_DEFAULT);
+        final long tgtVar2 = Unsafe.malloc(varSize, MemoryTag.NATIVE_DEFAULT);
+        try {
+            for (int i = 0; i < count; i++) {
+                final long lo = Unsafe.getUnsafe().getLong(srcFix + i * Long.BYTES);
+                for (int j = 0; j < i % 7; j++) {
+                    Unsafe.getUnsafe().putByte(srcVar + lo + j, (byte) i);
+                }
+                // runs of consecutive rows, every third run is swapped with the next one
+                final int run = i / 10;
+                final int row = run % 3 == 0 && i + 10 < count ? i + 10 : run % 3 == 1 ? i - 10 : i;
+                Unsafe.getUnsafe().putLong(index + i * 2L * Long.BYTES + Long.BYTES, row);
+            }
+
+            Assert.assertEquals(varSize, Vect.sortVarColumn(index, count, srcVar, srcFix, tgtVar1, tgtFix1));
+            Assert.assertEquals(varSize, Vect.sortVarColumnOffsets(index, count, srcFix, tgtFix2));
+            for (int lo = 0; lo < count; lo += rangeRows) {
+                Vect.sortVarColumnData(index, lo, Math.min(count, lo + rangeRows), srcVar, srcFix, tgtVar2, tgtFix2);
+            }
+
+            long offset = 0;
+            for (int i = 0; i < count; i++) {
+                final long row = Unsafe.getUnsafe().getLong(index + i * 2L * Long.BYTES + Long.BYTES);
+                Assert.assertEquals(offset, Unsafe.getUnsafe().getLong(tgtFix1 + i * Long.BYTES));
+                Assert.assertEquals(offset, Unsafe.getUnsafe().getLong(tgtFix2 + i * Long.BYTES));
+                for (int j = 0; j < row % 7; j++) {
+                    Assert.assertEquals((byte) row, Unsafe.getUnsafe().getByte(tgtVar1 + offset + j));
+                    Assert.assertEquals((byte) row, Unsafe.getUnsafe().getByte(tgtVar2 + offset + j));
+                }
+                offset += row % 7;
+            }
+            Assert.assertEquals(varSize, offset);
+        } finally {
+            Unsafe.free(index, indexSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(srcFix, fixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(tgtFix1, fixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(tgtFix2, fixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(srcVar, varSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(tgtVar1, varSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(tgtVar2, varSize, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    @Test
+    public void testSortWideKeys() {
+        rnd = TestUtils.generateRandom(null);
+        final int[] counts = {0, 1, 5, 31, 32, 33, 1_000, 100_000};
+        for (int longs = 2; longs < 4; longs++) {
+            for (int count : counts) {
+                for (int order = 0; order < 5; order++) {
+                    testSortWideKeys(longs, count, order);
+                }
+            }
+        }
+    }
+
+    @Test
+    public void testStatsMatchSeparateKernels() {
+        // stats layout is count, null count, sum, min and max, see column_stats_t
+        final int nMax = 300;
+        final long pDouble = Unsafe.malloc((long) nMax * Double.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long pInt = Unsafe.malloc((long) nMax * Integer.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long pLong = Unsafe.malloc((long) nMax * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long pStats = Unsafe.malloc(40, MemoryTag.NATIVE_DEFAULT);
+        try {
+            for (int nullPercent = 0; nullPercent <= 100; nullPercent += 50) {
+                for (int n = 0; n < nMax; n++) {
+                    long nulls = 0;
+                    for (int i = 0; i < n; i++) {
+                        final boolean isNull = rnd.nextInt(100) < nullPercent;
+                        nulls += isNull ? 1 : 0;
+                        Unsafe.getUnsafe().putDouble(pDouble + (long) i * Double.BYTES, isNull ? Double.NaN : (rnd.nextInt(2001) - 1000) / 8.0);
+                        Unsafe.getUnsafe().putInt(pInt + (long) i * Integer.BYTES, isNull ? Numbers.INT_NaN : rnd.nextInt(2001) - 1000);
+                        Unsafe.getUnsafe().putLong(pLong + (long) i * Long.BYTES, isNull ? Numbers.LONG_NaN : rnd.nextInt(2_000_001) - 1_000_000);
+                    }
+
+                    final String msg = "count: " + n + ", null %: " + nullPercent;
+                    Vect.statsDouble(pDouble, n, pStats);
+                    Assert.assertEquals(msg, Vect.countDouble(pDouble, n), Unsafe.getUnsafe().getLong(pStats));
+                    Assert.assertEquals(msg, nulls, Unsafe.getUnsafe().getLong(pStats + 8));
+                    Assert.assertEquals(msg, Vect.sumDouble(pDouble, n), Unsafe.getUnsafe().getDouble(pStats + 16), 0.0);
+                    Assert.assertEquals(msg, Vect.minDouble(pDouble, n), Unsafe.getUnsafe().getDouble(pStats + 24), 0.0);
+                    Assert.assertEquals(msg, Vect.maxDouble(pDouble, n), Unsafe.getUnsafe().getDouble(pStats + 32), 0.0);
+
+                    // int min and max are widened to long, null stays int null
+                    Vect.statsInt(pInt, n, pStats);
+                    Assert.assertEquals(msg, Vect.countInt(pInt, n), Unsafe.getUnsafe().getLong(pStats));
+                    Assert.assertEquals(msg, nulls, Unsafe.getUnsafe().getLong(pStats + 8));
+                    Assert.assertEquals(msg, Vect.sumInt(pInt, n), Unsafe.getUnsafe().getLong(pStats + 16));
+                    Assert.assertEquals(msg, Vect.minInt(pInt, n), (int) Unsafe.getUnsafe().getLong(pStats + 24));
+                    Assert.assertEquals(msg, Vect.maxInt(pInt, n), (int) Unsafe.getUnsafe().getLong(pStats + 32));
+
+                    Vect.statsLong(pLong, n, pStats);
+                    Assert.assertEquals(msg, Vect.countLong(pLong, n), Unsafe.getUnsafe().getLong(pStats));
+                    Assert.assertEquals(msg, nulls, Unsafe.getUnsafe().getLong(pStats + 8));
+                    Assert.assertEquals(msg, Vect.sumLong(pLong, n), Unsafe.getUnsafe().getLong(pStats + 16));
+                    Assert.assertEquals(msg, Vect.minLong(pLong, n), Unsafe.getUnsafe().getLong(pStats + 24));
+                    Assert.assertEquals(msg, Vect.maxLong(pLong, n), Unsafe.getUnsafe().getLong(pStats + 32));
+                }
+            }
+        } finally {
+            Unsafe.free(pDouble, (long) nMax * Double.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pInt, (long) nMax * Integer.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pLong, (long) nMax * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pStats, 40, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    @Test
+    public void testVarianceDouble() {
+        // state is mean, m2 and count, see welford_t
+        final int nMax = 300;
+        final long pDouble = Unsafe.malloc((long) nMax * Double.BYTES, MemoryTag.NATIVE_DEFAULT);
+        final long pState = Unsafe.malloc(24, MemoryTag.NATIVE_DEFAULT);
+        final double[] values = new double[nMax + 2];
+        try {
+            for (int nullPercent = 0; nullPercent <= 100; nullPercent += 50) {
+                for (int n = 0; n < nMax; n++) {
+                    // the batch is merged into a state that already holds 1.5 and 2.5
+                    Unsafe.getUnsafe().putDouble(pState, 2.0);
+                    Unsafe.getUnsafe().putDouble(pState + 8, 0.5);
+                    Unsafe.getUnsafe().putLong(pState + 16, 2);
+                    values[0] = 1.5;
+                    values[1] = 2.5;
+                    int count = 2;
+                    for (int i = 0; i < n; i++) {
+                        final double d;
+                        if (rnd.nextInt(100) < nullPercent) {
+                            // non-finite values are skipped
+                            d = rnd.nextBoolean() ? Double.NaN : Double.POSITIVE_INFINITY;
+                        } else {
+                            d = (rnd.nextInt(2001) - 1000) / 8.0;
+                            values[count++] = d;
+                        }
+                        Unsafe.getUnsafe().putDouble(pDouble + (long) i * Double.BYTES, d);
+                    }
+                    Vect.varianceDouble(pDouble, n, pState);
+
+                    double mean = 0;
+                    for (int i = 0; i < count; i++) {
+                        mean += values[i];
+                    }
+                    mean /= count;
+                    double m2 = 0;
+                    for (int i = 0; i < count; i++) {
+                        m2 += (values[i] - mean) * (values[i] - mean);
+                    }
+
+                    final String msg = "count: " + n + ", null %: " + nullPercent;
+                    Assert.assertEquals(msg, count, Unsafe.getUnsafe().getLong(pState + 16));
+                    Assert.assertEquals(msg, mean, Unsafe.getUnsafe().getDouble(pState), 1e-9);
+                    Assert.assertEquals(msg, m2, Unsafe.getUnsafe().getDouble(pState + 8), 1e-6 * (1 + m2));
+                }
+            }
+        } finally {
+            Unsafe.free(pDouble, (long) nMax * Double.BYTES, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(pState, 24, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    // 128-bit keys are signed with the high word second, words of 3x64-bit keys compare as unsigned
+    private static int compareWideKeys(long[] a, long[] b) {
+        if (a.length == 2) {
+            return a[1] != b[1] ? Long.compare(a[1], b[1]) : Long.compareUnsigned(a[0], b[0]);
+        }
+        for (int w = 0; w < a.length; w++) {
+            if (a[w] != b[w]) {
+                return Long.compareUnsigned(a[w], b[w]);
+            }
+        }
+        return 0;
+    }
+
     private static long getIndexChecked(DirectLongList keyList, long p) {
         Assert.assertTrue("key index not in expected range", p >= 0 && p < keyList.size());
         return keyList.get(p);
     }
 
+    private static void mergeShuffle(int shl, long pSrc1, long pSrc2, long pDest, long pIndex, long count) {
+        switch (shl) {
+            case 0:
+                Vect.mergeShuffle8Bit(pSrc1, pSrc2, pDest, pIndex, count);
+                break;
+            case 1:
+                Vect.mergeShuffle16Bit(pSrc1, pSrc2, pDest, pIndex, count);
+                break;
+            case 2:
+                Vect.mergeShuffle32Bit(pSrc1, pSrc2, pDest, pIndex, count);
+                break;
+            case 3:
+                Vect.mergeShuffle64Bit(pSrc1, pSrc2, pDest, pIndex, count);
+                break;
+            case 4:
+                Vect.mergeShuffle128Bit(pSrc1, pSrc2, pDest, pIndex, count);
+                break;
+            default:
+                Vect.mergeShuffle256Bit(pSrc1, pSrc2, pDest, pIndex, count);
+                break;
+        }
+    }
+
     private static String printMergeIndex(DirectLongList dest) {
         StringSink sink = new StringSink();
         for (int i = 0; i < dest.size(); i += 2) {
@@ -1117,6 +1590,38 @@ public class VectTest {
         return sink.toString();
     }
 
+    // runs all phases of the parallel sort on this thread, returns size of the largest bucket
+    private long radixSortParallel(long pDataA, long countA, long pDataB, long countB, long pDataDest, long pDataCpy, int chunkCount) {
+        final long pState = Vect.radixSortParallelCreate(pDataA, countA, pDataB, countB, pDataDest, pDataCpy, chunkCount);
+        Assert.assertNotEquals(0, pState);
+        try {
+            final int chunks = Vect.radixSortParallelChunkCount(pState);
+            Assert.assertTrue(chunks > 0 && chunks <= chunkCount);
+            for (int c = 0; c < chunks; c++) {
+                Vect.radixSortParallelSample(pState, c);
+            }
+            Vect.radixSortParallelPlan(pState);
+            for (int c = 0; c < chunks; c++) {
+                Vect.radixSortParallelCount(pState, c);
+            }
+            Vect.radixSortParallelOffsets(pState);
+            long maxBucketSize = 0;
+            for (int b = 0; b < Vect.RADIX_SORT_PARALLEL_BUCKETS; b++) {
+                maxBucketSize = Math.max(maxBucketSize, Vect.radixSortParallelBucketSize(pState, b));
+            }
+            // chunks and buckets do not depend on each other, run them out of order
+            for (int c = chunks - 1; c > -1; c--) {
+                Vect.radixSortParallelScatter(pState, c);
+            }
+            for (int b = Vect.RADIX_SORT_PARALLEL_BUCKETS - 1; b > -1; b--) {
+                Vect.radixSortParallelBucket(pState, b);
+            }
+            return maxBucketSize;
+        } finally {
+            Vect.radixSortParallelFree(pState);
+        }
+    }
+
     private long seedAndSort(int count) {
         final long indexAddr = Unsafe.malloc(count * 2L * Long.BYTES, MemoryTag.NATIVE_DEFAULT);
         seedMem2Longs(count, indexAddr);
@@ -1139,6 +1644,181 @@ public class VectTest {
         }
     }
 
+    private long seedMemLongs(long size) {
+        final long p = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        for (long offset = 0; offset < size; offset += Long.BYTES) {
+            Unsafe.getUnsafe().putLong(p + offset, rnd.nextLong());
+        }
+        return p;
+    }
+
+    // rows of the merge index pick random values of either source, the top bit selects the first source
+    private void seedMergeIndex(int count, int srcCount, long p) {
+        for (int i = 0; i < count; i++) {
+            final long row = rnd.nextInt(srcCount);
+            Unsafe.getUnsafe().putLong(p + i * 2L * Long.BYTES, i);
+            Unsafe.getUnsafe().putLong(p + i * 2L * Long.BYTES + Long.BYTES, rnd.nextBoolean() ? row | Long.MIN_VALUE : row);
+        }
+    }
+
+    // the first key is the minimum, masked out bits are the same in all keys
+    private void seedRadixKeys(int count, long p, long minKey, long keyMask) {
+        for (int i = 0; i < count; i++) {
+            final long z = i == 0 ? minKey : minKey + (rnd.nextPositiveLong() & keyMask);
+            Unsafe.getUnsafe().putLong(p + i * 2L * Long.BYTES, z);
+            Unsafe.getUnsafe().putLong(p + i * 2L * Long.BYTES + 8, i);
+        }
+    }
+
+    // values are laid out one after another, each is the length header followed by random bytes
+    private void seedVarColumn(int[] lens, int headerSize, int mult, long fixAddr, long varAddr) {
+        long offset = 0;
+        for (int r = 0; r < lens.length; r++) {
+            Unsafe.getUnsafe().putLong(fixAddr + (long) r * Long.BYTES, offset);
+            if (headerSize == Long.BYTES) {
+                Unsafe.getUnsafe().putLong(varAddr + offset, lens[r]);
+            } else {
+                Unsafe.getUnsafe().putInt(varAddr + offset, lens[r]);
+            }
+            offset += headerSize;
+            for (long b = 0, n = (long) Math.max(0, lens[r]) * mult; b < n; b++) {
+                Unsafe.getUnsafe().putByte(varAddr + offset++, (byte) rnd.nextInt());
+            }
+        }
+        Unsafe.getUnsafe().putLong(fixAddr + (long) lens.length * Long.BYTES, offset);
+    }
+
+    // merges the rows of two var columns in runs of random length, runs skip rows from time to time,
+    // the result is compared with values copied one by one
+    private void testMergeCopyVarColumn(boolean bin, int dataCount, int oooCount, int maxLen, long dstVarOffset) {
+        final int headerSize = bin ? Long.BYTES : Integer.BYTES;
+        final int mult = bin ? 1 : 2;
+        final int[] dataLens = new int[dataCount];
+        final int[] oooLens = new int[oooCount];
+        long dataVarSize = 0;
+        for (int r = 0; r < dataCount; r++) {
+            dataLens[r] = rnd.nextInt(5) == 0 ? -1 : rnd.nextInt(maxLen + 1);
+            dataVarSize += headerSize + Math.max(0, dataLens[r]) * mult;
+        }
+        long oooVarSize = 0;
+        for (int r = 0; r < oooCount; r++) {
+            oooLens[r] = rnd.nextInt(5) == 0 ? -1 : rnd.nextInt(maxLen + 1);
+            oooVarSize += headerSize + Math.max(0, oooLens[r]) * mult;
+        }
+
+        // top bit of the index row selects the data column
+        final LongList rows = new LongList();
+        int dataRow = 0;
+        int oooRow = 0;
+        while (dataRow < dataCount || oooRow < oooCount) {
+            final boolean data = oooRow == oooCount || (dataRow < dataCount && rnd.nextBoolean());
+            final int runLength = 1 + rnd.nextInt(8);
+            for (int n = 0; n < runLength; n++) {
+                if (data && dataRow < dataCount) {
+                    rows.add(dataRow++ | Long.MIN_VALUE);
+                } else if (!data && oooRow < oooCount) {
+                    rows.add(oooRow++);
+                }
+                if (rnd.nextInt(10) == 0) {
+                    // the next row of the run is not adjacent
+                    if (data) {
+                        dataRow = Math.min(dataRow + 1, dataCount);
+                    } else {
+                        oooRow = Math.min(oooRow + 1, oooCount);
+                    }
+                }
+            }
+        }
+
+        final int indexCount = rows.size();
+        final long indexSize = indexCount * 2L * Long.BYTES;
+        final long dataFixSize = (dataCount + 1L) * Long.BYTES;
+        final long oooFixSize = (oooCount + 1L) * Long.BYTES;
+        final long dstFixSize = (indexCount + 1L) * Long.BYTES;
+        final long dstVarSize = dstVarOffset + dataVarSize + oooVarSize;
+        final long index = Unsafe.malloc(indexSize, MemoryTag.NATIVE_DEFAULT);
+        final long dataFix = Unsafe.malloc(dataFixSize, MemoryTag.NATIVE_DEFAULT);
+        final long dataVar = Unsafe.malloc(dataVarSize, MemoryTag.NATIVE_DEFAULT);
+        final long oooFix = Unsafe.malloc(oooFixSize, MemoryTag.NATIVE_DEFAULT);
+        final long oooVar = Unsafe.malloc(oooVarSize, MemoryTag.NATIVE_DEFAULT);
+        final long dstFix = Unsafe.malloc(dstFixSize, MemoryTag.NATIVE_DEFAULT);
+        final long dstVar = Unsafe.calloc(dstVarSize, MemoryTag.NATIVE_DEFAULT);
+        final long expectedFix = Unsafe.malloc(dstFixSize, MemoryTag.NATIVE_DEFAULT);
+        final long expectedVar = Unsafe.calloc(dstVarSize, MemoryTag.NATIVE_DEFAULT);
+        try {
+            seedVarColumn(dataLens, headerSize, mult, dataFix, dataVar);
+            seedVarColumn(oooLens, headerSize, mult, oooFix, oooVar);
+            long offset = dstVarOffset;
+            for (int l = 0; l < indexCount; l++) {
+                final long row = rows.getQuick(l);
+                Unsafe.getUnsafe().putLong(index + l * 2L * Long.BYTES, l);
+                Unsafe.getUnsafe().putLong(index + l * 2L * Long.BYTES + Long.BYTES, row);
+                final long fixAddr = row < 0 ? dataFix : oooFix;
+                final long varAddr = row < 0 ? dataVar : oooVar;
+                final int len = row < 0 ? dataLens[(int) (row & Long.MAX_VALUE)] : oooLens[(int) row];
+                final long size = headerSize + (long) Math.max(0, len) * mult;
+                Unsafe.getUnsafe().putLong(expectedFix + (long) l * Long.BYTES, offset);
+                Vect.memcpy(expectedVar + offset, varAddr + Unsafe.getUnsafe().getLong(fixAddr + (row & Long.MAX_VALUE) * Long.BYTES), size);
+                offset += size;
+            }
+            Unsafe.getUnsafe().putLong(expectedFix + (long) indexCount * Long.BYTES, offset);
+
+            if (bin) {
+                Vect.oooMergeCopyBinColumn(index, indexCount, dataFix, dataVar, oooFix, oooVar, dstFix, dstVar, dstVarOffset);
+            } else {
+                Vect.oooMergeCopyStrColumn(index, indexCount, dataFix, dataVar, oooFix, oooVar, dstFix, dstVar, dstVarOffset);
+            }
+
+            if (indexCount > 0) {
+                assertEqualLongs(expectedFix, dstFix, indexCount + 1);
+            }
+            for (long b = 0; b < dstVarSize; b++) {
+                if (Unsafe.getUnsafe().getByte(expectedVar + b) != Unsafe.getUnsafe().getByte(dstVar + b)) {
+                    Assert.assertEquals("var byte at " + b, Unsafe.getUnsafe().getByte(expectedVar + b), Unsafe.getUnsafe().getByte(dstVar + b));
+                }
+            }
+        } finally {
+            Unsafe.free(index, indexSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(dataFix, dataFixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(dataVar, dataVarSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(oooFix, oooFixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(oooVar, oooVarSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(dstFix, dstFixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(dstVar, dstVarSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(expectedFix, dstFixSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(expectedVar, dstVarSize, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    // compares the shuffle with values picked one by one, the source offset is in bytes, the destination one in values
+    private void testMergeShuffle(int shl, int count, int srcByteOffset, int destOffset) {
+        final int srcCount = 1_000;
+        final long srcSize = ((long) srcCount << shl) + Long.BYTES;
+        final long indexSize = count * 2L * Long.BYTES;
+        final long destSize = (long) (count + destOffset) << shl;
+        final long src1 = seedMemLongs(srcSize);
+        final long src2 = seedMemLongs(srcSize);
+        final long index = Unsafe.malloc(indexSize, MemoryTag.NATIVE_DEFAULT);
+        final long dest = Unsafe.malloc(destSize, MemoryTag.NATIVE_DEFAULT);
+        try {
+            seedMergeIndex(count, srcCount, index);
+            final long pDest = dest + ((long) destOffset << shl);
+            mergeShuffle(shl, src1 + srcByteOffset, src2 + srcByteOffset, pDest, index, count);
+            for (int i = 0; i < count; i++) {
+                final long r = Unsafe.getUnsafe().getLong(index + i * 2L * Long.BYTES + Long.BYTES);
+                final long src = (r < 0 ? src1 : src2) + srcByteOffset + ((r & Long.MAX_VALUE) << shl);
+                for (int b = 0; b < 1 << shl; b++) {
+                    Assert.assertEquals(Unsafe.getUnsafe().getByte(src + b), Unsafe.getUnsafe().getByte(pDest + ((long) i << shl) + b));
+                }
+            }
+        } finally {
+            Unsafe.free(src1, srcSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(src2, srcSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(index, indexSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(dest, destSize, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
     private void testQuickSort(int count) {
         final int size = count * 2 * Long.BYTES;
         final long indexAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
@@ -1151,6 +1831,126 @@ public class VectTest {
         }
     }
 
+    private void testRadixSort(int count, long minKey, long keyMask) {
+        testRadixSortInPlace(count, minKey, keyMask);
+        final int split = rnd.nextInt(count);
+        testRadixSortAB(split, count - split, minKey, keyMask);
+    }
+
+    private void testRadixSortAB(int aCount, int bCount, long minKey, long keyMask) {
+        final long sizeA = aCount * 2L * Long.BYTES;
+        final long sizeB = bCount * 2L * Long.BYTES;
+        final long resultSize = sizeA + sizeB;
+        final long aAddr = Unsafe.malloc(resultSize, MemoryTag.NATIVE_DEFAULT);
+        final long bAddr = Unsafe.malloc(sizeB, MemoryTag.NATIVE_DEFAULT);
+        final long cpyAddr = Unsafe.malloc(resultSize, MemoryTag.NATIVE_DEFAULT);
+        final long aAddrCopy = Unsafe.malloc(sizeA, MemoryTag.NATIVE_DEFAULT);
+        final long bAddrCopy = Unsafe.malloc(sizeB, MemoryTag.NATIVE_DEFAULT);
+        final long expectedAddr = Unsafe.malloc(resultSize, MemoryTag.NATIVE_DEFAULT);
+        try {
+            seedRadixKeys(aCount, expectedAddr, minKey, keyMask);
+            for (int i = 0; i < aCount; i++) {
+                Unsafe.getUnsafe().putLong(aAddr + (long) i * Long.BYTES, Unsafe.getUnsafe().getLong(expectedAddr + i * 2L * Long.BYTES));
+            }
+            seedRadixKeys(bCount, bAddr, minKey, keyMask);
+            Vect.memcpy(expectedAddr + sizeA, bAddr, sizeB);
+            Vect.memcpy(aAddrCopy, aAddr, (long) aCount * Long.BYTES);
+            Vect.memcpy(bAddrCopy, bAddr, sizeB);
+
+            Vect.radixSortABLongIndexAsc(aAddr, aCount, bAddr, bCount, aAddr, cpyAddr);
+            Vect.quickSortLongIndexAscInPlace(expectedAddr, aCount + bCount);
+            assertIndexAsc(aCount + bCount, aAddr, aAddrCopy, bAddrCopy);
+            for (int i = 0; i < aCount + bCount; i++) {
+                Assert.assertEquals(
+                        Unsafe.getUnsafe().getLong(expectedAddr + i * 2L * Long.BYTES),
+                        Unsafe.getUnsafe().getLong(aAddr + i * 2L * Long.BYTES)
+                );
+            }
+        } finally {
+            Unsafe.free(aAddr, resultSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(bAddr, sizeB, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(cpyAddr, resultSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(aAddrCopy, sizeA, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(bAddrCopy, sizeB, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(expectedAddr, resultSize, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    private void testRadixSortInPlace(int count, long minKey, long keyMask) {
+        final long size = count * 2L * Long.BYTES;
+        final long indexAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        final long cpyAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        final long expectedAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        final long bAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        try {
+            seedRadixKeys(count, indexAddr, minKey, keyMask);
+            final long[] keys = new long[count];
+            for (int i = 0; i < count; i++) {
+                keys[i] = Unsafe.getUnsafe().getLong(indexAddr + i * 2L * Long.BYTES);
+            }
+            Vect.memcpy(expectedAddr, indexAddr, size);
+            Vect.memcpy(bAddr, indexAddr, size);
+
+            Vect.radixSortLongIndexAscInPlace(indexAddr, count, cpyAddr);
+            Vect.quickSortLongIndexAscInPlace(expectedAddr, count);
+            long prevIdx = -1;
+            for (int i = 0; i < count; i++) {
+                final long ts = Unsafe.getUnsafe().getLong(indexAddr + i * 2L * Long.BYTES);
+                final long idx = Unsafe.getUnsafe().getLong(indexAddr + i * 2L * Long.BYTES + Long.BYTES);
+                Assert.assertEquals(Unsafe.getUnsafe().getLong(expectedAddr + i * 2L * Long.BYTES), ts);
+                Assert.assertEquals(keys[(int) idx], ts);
+                // the sort is stable, rows with equal keys keep their order
+                if (i > 0 && ts == Unsafe.getUnsafe().getLong(indexAddr + (i - 1) * 2L * Long.BYTES)) {
+                    Assert.assertTrue(idx > prevIdx);
+                }
+                prevIdx = idx;
+            }
+
+            // O3 sorts B rows in place, as stable as the sort of a single array
+            Vect.radixSortABLongIndexAsc(0, 0, bAddr, count, bAddr, cpyAddr);
+            assertEqualLongs(indexAddr, bAddr, count * 2);
+        } finally {
+            Unsafe.free(indexAddr, size, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(cpyAddr, size, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(expectedAddr, size, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(bAddr, size, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
+    private void testRadixSortParallel(int aCount, int bCount, long keyMask, int chunkCount) {
+        final long sizeA = (long) aCount * Long.BYTES;
+        final long sizeB = bCount * 2L * Long.BYTES;
+        final long resultSize = aCount * 2L * Long.BYTES + sizeB;
+        final long aAddr = Unsafe.malloc(sizeA, MemoryTag.NATIVE_DEFAULT);
+        final long bAddr = Unsafe.malloc(sizeB, MemoryTag.NATIVE_DEFAULT);
+        final long cpyAddr = Unsafe.malloc(resultSize, MemoryTag.NATIVE_DEFAULT);
+        final long expectedAddr = Unsafe.malloc(resultSize, MemoryTag.NATIVE_DEFAULT);
+        final long actualAddr = Unsafe.malloc(resultSize, MemoryTag.NATIVE_DEFAULT);
+        try {
+            for (int i = 0; i < aCount; i++) {
+                Unsafe.getUnsafe().putLong(aAddr + (long) i * Long.BYTES, rnd.nextPositiveLong() & keyMask);
+            }
+            seedRadixKeys(bCount, bAddr, 0, keyMask);
+
+            final long pDataA = aCount > 0 ? aAddr : 0;
+            Vect.radixSortABLongIndexAsc(pDataA, aCount, bAddr, bCount, expectedAddr, cpyAddr);
+            radixSortParallel(pDataA, aCount, bAddr, bCount, actualAddr, cpyAddr, chunkCount);
+            assertEqualLongs(expectedAddr, actualAddr, (aCount + bCount) * 2);
+
+            if (aCount == 0) {
+                // O3 sorts B rows in place
+                radixSortParallel(0, 0, bAddr, bCount, bAddr, cpyAddr, chunkCount);
+                assertEqualLongs(expectedAddr, bAddr, bCount * 2);
+            }
+        } finally {
+            Unsafe.free(aAddr, sizeA, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(bAddr, sizeB, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(cpyAddr, resultSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(expectedAddr, resultSize, MemoryTag.NATIVE_DEFAULT);
+            Unsafe.free(actualAddr, resultSize, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
     private void testSort(int count) {
         final int size = count * 2 * Long.BYTES;
         final long indexAddr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
@@ -1190,6 +1990,50 @@ public class VectTest {
         }
     }
 
+    // compares sort128BitAscInPlace() and sort3LongAscInPlace() with the sort of the same keys on heap,
+    // keys are random, sorted, reverse sorted, all equal or made of few distinct words
+    private void testSortWideKeys(int longs, int count, int order) {
+        final long[][] keys = new long[count][longs];
+        final long[] duplicate = new long[longs];
+        for (int w = 0; w < longs; w++) {
+            duplicate[w] = rnd.nextLong();
+        }
+        for (int i = 0; i < count; i++) {
+            for (int w = 0; w < longs; w++) {
+                keys[i][w] = order == 3 ? duplicate[w] : order == 4 ? rnd.nextInt(3) - 1 : rnd.nextLong();
+            }
+        }
+        final Comparator<long[]> comparator = VectTest::compareWideKeys;
+        if (order == 1) {
+            Arrays.sort(keys, comparator);
+        } else if (order == 2) {
+            Arrays.sort(keys, comparator.reversed());
+        }
+
+        final long size = (long) count * longs * Long.BYTES;
+        final long addr = Unsafe.malloc(size, MemoryTag.NATIVE_DEFAULT);
+        try {
+            for (int i = 0; i < count; i++) {
+                for (int w = 0; w < longs; w++) {
+                    Unsafe.getUnsafe().putLong(addr + ((long) i * longs + w) * Long.BYTES, keys[i][w]);
+                }
+            }
+            if (longs == 2) {
+                Vect.sort128BitAscInPlace(addr, count);
+            } else {
+                Vect.sort3LongAscInPlace(addr, count);
+            }
+            Arrays.sort(keys, comparator);
+            for (int i = 0; i < count; i++) {
+                for (int w = 0; w < longs; w++) {
+                    Assert.assertEquals(keys[i][w], Unsafe.getUnsafe().getLong(addr + ((long) i * longs + w) * Long.BYTES));
+                }
+            }
+        } finally {
+            Unsafe.free(addr, size, MemoryTag.NATIVE_DEFAULT);
+        }
+    }
+
 
     static {
         Os.init();